@@ -0,0 +1,113 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    renderspan.cpp
+
+    Draws a typical software-rendered frame one span at a time and reports
+    pixels per second: a 320x240 screen texture scaled up to fill the
+    target, then a full-target ARGB32 artwork overlay blended over it.
+    The span kernels are compared against their scalar versions at
+    640x480, 1920x1080 and 3840x2160.
+
+***************************************************************************/
+
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "renderspan.h"
+
+#include <vector>
+
+namespace {
+
+const UINT32 SCREEN_WIDTH = 320;
+const UINT32 SCREEN_HEIGHT = 240;
+const UINT32 ART_WIDTH = 1024;
+const UINT32 ART_HEIGHT = 768;
+
+// the scalar kernels
+struct scalar_spans
+{
+	static void copy(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		render_span::copy_scaled_scalar(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+	static void blend(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		render_span::blend_scaled_scalar(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+};
+
+
+// the kernels used by the software renderer
+struct simd_spans
+{
+	static void copy(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		render_span::copy_scaled(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+	static void blend(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		render_span::blend_scaled(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+};
+
+
+// fill a texture with noise; the artwork is mostly clear with a band of
+// partial alpha and an opaque frame, as a bezel would be
+std::vector<UINT32> build_texture(UINT32 width, UINT32 height, bool artwork)
+{
+	std::vector<UINT32> texture(width * height);
+	UINT32 seed = 12345;
+	for (UINT32 y = 0; y < height; y++)
+		for (UINT32 x = 0; x < width; x++)
+		{
+			seed = seed * 1664525 + 1013904223;
+			UINT32 alpha = 0xff;
+			if (artwork)
+			{
+				bool frame = (x < width / 16 || x >= width - width / 16 || y < height / 16 || y >= height - height / 16);
+				alpha = frame ? 0xff : (y < height / 4) ? (seed >> 24) : 0x00;
+			}
+			texture[y * width + x] = (alpha << 24) | (seed & 0x00ffffff);
+		}
+	return texture;
+}
+
+
+// draw one frame per iteration at the target size given by the arguments
+template<class _Spans>
+void run_frame(benchmark::State &state)
+{
+	const INT32 width = state.range_x();
+	const INT32 height = state.range_y();
+	std::vector<UINT32> screen = build_texture(SCREEN_WIDTH, SCREEN_HEIGHT, false);
+	std::vector<UINT32> artwork = build_texture(ART_WIDTH, ART_HEIGHT, true);
+	std::vector<UINT32> dest(width * height);
+
+	// 16.16 steps across each texture, starting in the middle of the first texel
+	const INT32 screen_dudx = (SCREEN_WIDTH << 16) / width;
+	const INT32 screen_dvdy = (SCREEN_HEIGHT << 16) / height;
+	const INT32 art_dudx = (ART_WIDTH << 16) / width;
+	const INT32 art_dvdy = (ART_HEIGHT << 16) / height;
+
+	while (state.KeepRunning())
+	{
+		for (INT32 y = 0; y < height; y++)
+			_Spans::copy(&dest[y * width], &screen[0], SCREEN_WIDTH, screen_dudx / 2, screen_dvdy / 2 + y * screen_dvdy, screen_dudx, 0, width);
+		for (INT32 y = 0; y < height; y++)
+			_Spans::blend(&dest[y * width], &artwork[0], ART_WIDTH, art_dudx / 2, art_dvdy / 2 + y * art_dvdy, art_dudx, 0, width);
+		benchmark::DoNotOptimize(dest[0]);
+	}
+	state.SetItemsProcessed(state.iterations() * width * height);
+}
+
+} // anonymous namespace
+
+
+static void BM_render_frame_scalar(benchmark::State& state) { run_frame<scalar_spans>(state); }
+static void BM_render_frame_simd(benchmark::State& state) { run_frame<simd_spans>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_render_frame_scalar)->ArgPair(640, 480)->ArgPair(1920, 1080)->ArgPair(3840, 2160);
+BENCHMARK(BM_render_frame_simd)->ArgPair(640, 480)->ArgPair(1920, 1080)->ArgPair(3840, 2160);
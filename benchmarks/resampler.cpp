@@ -0,0 +1,188 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    resampler.cpp
+
+    Runs a synthetic sound stream graph through the stream resampler and
+    reports samples per second: a set of chip streams at their native
+    rates feed a mixer at 48kHz, as in a typical FM-heavy system. The
+    block kernels are compared against the per-sample loops they replaced.
+
+***************************************************************************/
+
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "resampler.h"
+
+#include <vector>
+
+namespace {
+
+const UINT32 FRAC_BITS = stream_resampler::FRAC_BITS;
+const UINT32 FRAC_ONE = stream_resampler::FRAC_ONE;
+const UINT32 FRAC_MASK = stream_resampler::FRAC_MASK;
+const UINT32 OUTPUT_RATE = 48000;
+const UINT32 SAMPLES_PER_UPDATE = 800;
+
+// the previous implementation: scalar per-sample loops with the gain applied inline
+struct scalar_resampler
+{
+	static void resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+	{
+		if (step == FRAC_ONE)
+		{
+			while (numsamples--)
+			{
+				INT64 sample = *source++;
+				*dest++ = (sample * gain) >> 8;
+			}
+		}
+		else if (step < FRAC_ONE)
+		{
+			while (numsamples != 0)
+			{
+				int nextfrac;
+				while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+				{
+					*dest++ = (source[0] * gain) >> 8;
+					basefrac = nextfrac;
+				}
+				if (INT32(numsamples--) < 0)
+					break;
+				int startfrac = basefrac >> (FRAC_BITS - 12);
+				int endfrac = nextfrac >> (FRAC_BITS - 12);
+				INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+				*dest++ = (sample * gain) >> 8;
+				basefrac = nextfrac & FRAC_MASK;
+				source++;
+			}
+		}
+		else
+		{
+			int smallstep = step >> (FRAC_BITS - 8);
+			while (numsamples--)
+			{
+				INT64 remainder = smallstep;
+				int tpos = 0;
+				INT64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+				INT64 sample = (INT64) source[tpos++] * scale;
+				remainder -= scale;
+				while (remainder > 0x100)
+				{
+					sample += (INT64) source[tpos++] * (INT64) 0x100;
+					remainder -= 0x100;
+				}
+				sample += (INT64) source[tpos] * remainder;
+				sample /= smallstep;
+				*dest++ = (sample * gain) >> 8;
+				basefrac += step;
+				source += basefrac >> FRAC_BITS;
+				basefrac &= FRAC_MASK;
+			}
+		}
+	}
+};
+
+
+// the block kernels used by sound_stream
+struct block_resampler
+{
+	static void resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+	{
+		if (step == FRAC_ONE)
+			stream_resampler::resample_equal(dest, source, numsamples, gain);
+		else if (step < FRAC_ONE)
+			stream_resampler::resample_up(dest, source, numsamples, basefrac, step, gain);
+		else
+			stream_resampler::resample_down(dest, source, numsamples, basefrac, step, gain);
+	}
+};
+
+
+// one input of the mixer: a source stream at its own rate
+struct graph_input
+{
+	UINT32                          rate;
+	INT64                           gain;
+	std::vector<stream_sample_t>    buffer;
+};
+
+
+// build the graph: FM chips below the output rate, PCM at it, and a PSG and
+// a DAC-style stream well above it; gains mix unity and attenuated inputs
+std::vector<graph_input> build_graph()
+{
+	static const UINT32 rates[] = { 55930, 44100, 22050, 48000, 48000, 3579545 / 32, 1000000 / 8, 8000 };
+	static const INT64 gains[] = { 0x100, 0x100, 0xc0, 0x100, 0x80, 0x100, 0x40, 0x100 };
+
+	std::vector<graph_input> graph;
+	UINT32 seed = 12345;
+	for (int index = 0; index < ARRAY_LENGTH(rates); index++)
+	{
+		graph_input input;
+		input.rate = rates[index];
+		input.gain = gains[index];
+		input.buffer.resize(UINT64(SAMPLES_PER_UPDATE) * input.rate / OUTPUT_RATE + 64);
+		for (auto &sample : input.buffer)
+		{
+			seed = seed * 1664525 + 1013904223;
+			sample = INT32(seed) >> 12;
+		}
+		graph.push_back(std::move(input));
+	}
+	return graph;
+}
+
+
+// resample every input of the graph once per iteration, as one mixer update does
+template<class _Resampler>
+void run_graph(benchmark::State &state)
+{
+	std::vector<graph_input> graph = build_graph();
+	std::vector<stream_sample_t> dest(SAMPLES_PER_UPDATE + 64);
+	UINT32 basefrac = 0;
+
+	while (state.KeepRunning())
+	{
+		for (graph_input &input : graph)
+		{
+			UINT32 step = (UINT64(input.rate) << FRAC_BITS) / OUTPUT_RATE;
+			_Resampler::resample(&dest[0], &input.buffer[0], SAMPLES_PER_UPDATE, basefrac, step, input.gain);
+			benchmark::DoNotOptimize(dest[0]);
+		}
+		basefrac = (basefrac + 0x12345) & FRAC_MASK;
+	}
+	state.SetItemsProcessed(state.iterations() * graph.size() * SAMPLES_PER_UPDATE);
+}
+
+
+// one resampling path on its own, selected by input rate
+template<class _Resampler>
+void run_single(benchmark::State &state)
+{
+	std::vector<stream_sample_t> source(UINT64(SAMPLES_PER_UPDATE) * state.range_x() / OUTPUT_RATE + 64, 0x1234);
+	std::vector<stream_sample_t> dest(SAMPLES_PER_UPDATE + 64);
+	UINT32 step = (UINT64(state.range_x()) << FRAC_BITS) / OUTPUT_RATE;
+
+	while (state.KeepRunning())
+	{
+		_Resampler::resample(&dest[0], &source[0], SAMPLES_PER_UPDATE, 0, step, state.range_y());
+		benchmark::DoNotOptimize(dest[0]);
+	}
+	state.SetItemsProcessed(state.iterations() * SAMPLES_PER_UPDATE);
+}
+
+} // anonymous namespace
+
+
+static void BM_resample_graph_scalar(benchmark::State& state) { run_graph<scalar_resampler>(state); }
+static void BM_resample_graph_block(benchmark::State& state) { run_graph<block_resampler>(state); }
+static void BM_resample_scalar(benchmark::State& state) { run_single<scalar_resampler>(state); }
+static void BM_resample_block(benchmark::State& state) { run_single<block_resampler>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_resample_graph_scalar);
+BENCHMARK(BM_resample_graph_block);
+BENCHMARK(BM_resample_scalar)->ArgPair(48000, 0x100)->ArgPair(48000, 0xc0)->ArgPair(22050, 0xc0)->ArgPair(111860, 0xc0);
+BENCHMARK(BM_resample_block)->ArgPair(48000, 0x100)->ArgPair(48000, 0xc0)->ArgPair(22050, 0xc0)->ArgPair(111860, 0xc0);
@@ -0,0 +1,181 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    timerheap.cpp
+
+    Compares the scheduler's indexed timer heap against the sorted linked
+    list it replaced, with 10, 100 and 1000 live timers.
+
+***************************************************************************/
+
+#include "benchmark/benchmark_api.h"
+#include "emucore.h"
+#include "eminline.h"
+#include "attotime.h"
+#include "coretmpl.h"
+
+namespace {
+
+// minimal stand-in for emu_timer with the same ordering rules
+class bench_timer
+{
+	friend class indexed_heap<bench_timer>;
+
+public:
+	bench_timer() : m_next(nullptr), m_prev(nullptr), m_heapindex(-1), m_sequence(0) { }
+
+	bool heap_before(const bench_timer &other) const
+	{
+		if (m_expire != other.m_expire)
+			return m_expire < other.m_expire;
+		return m_sequence < other.m_sequence;
+	}
+
+	bench_timer *   m_next;
+	bench_timer *   m_prev;
+	int             m_heapindex;
+	UINT64          m_sequence;
+	attotime        m_expire;
+	attotime        m_period;
+};
+
+
+// the previous scheduler implementation: a linear insertion into a sorted list
+class sorted_timer_list
+{
+public:
+	sorted_timer_list() : m_head(nullptr) { }
+
+	bench_timer *first() const { return m_head; }
+
+	void insert(bench_timer &timer)
+	{
+		bench_timer *prevtimer = nullptr;
+		for (bench_timer *curtimer = m_head; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->m_next)
+			if (curtimer->m_expire > timer.m_expire)
+			{
+				timer.m_prev = curtimer->m_prev;
+				timer.m_next = curtimer;
+				if (curtimer->m_prev != nullptr)
+					curtimer->m_prev->m_next = &timer;
+				else
+					m_head = &timer;
+				curtimer->m_prev = &timer;
+				return;
+			}
+
+		if (prevtimer != nullptr)
+			prevtimer->m_next = &timer;
+		else
+			m_head = &timer;
+		timer.m_prev = prevtimer;
+		timer.m_next = nullptr;
+	}
+
+	void remove(bench_timer &timer)
+	{
+		if (timer.m_prev != nullptr)
+			timer.m_prev->m_next = timer.m_next;
+		else
+			m_head = timer.m_next;
+		if (timer.m_next != nullptr)
+			timer.m_next->m_prev = timer.m_prev;
+	}
+
+private:
+	bench_timer *   m_head;
+};
+
+
+// wrap the heap with the same interface, stamping sequence numbers like the scheduler does
+class heap_timer_list
+{
+public:
+	heap_timer_list() : m_sequence(0) { }
+
+	bench_timer *first() const { return m_heap.first(); }
+	void insert(bench_timer &timer) { timer.m_sequence = m_sequence++; m_heap.insert(timer); }
+	void remove(bench_timer &timer) { m_heap.remove(timer); }
+
+private:
+	indexed_heap<bench_timer>   m_heap;
+	UINT64                      m_sequence;
+};
+
+
+// simple deterministic generator so both variants see the same workload
+inline UINT32 next_random(UINT32 &seed)
+{
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+
+// set up a number of periodic timers with a spread of rates, like scanline, serial and sound timers
+template<class _ListType>
+void populate(_ListType &list, std::vector<bench_timer> &timers, UINT32 &seed)
+{
+	for (bench_timer &timer : timers)
+	{
+		timer.m_period = attotime(0, ATTOSECONDS_IN_USEC(1 + next_random(seed) % 20000));
+		timer.m_expire = timer.m_period;
+		list.insert(timer);
+	}
+}
+
+
+// adjust: re-arm a random live timer, as emu_timer::adjust does
+template<class _ListType>
+void run_adjust(benchmark::State &state)
+{
+	_ListType list;
+	std::vector<bench_timer> timers(state.range_x());
+	UINT32 seed = 12345;
+	populate(list, timers, seed);
+
+	attotime now(0, 0);
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = timers[next_random(seed) % timers.size()];
+		list.remove(timer);
+		timer.m_expire = now + attotime(0, ATTOSECONDS_IN_USEC(1 + next_random(seed) % 20000));
+		list.insert(timer);
+		now += attotime(0, ATTOSECONDS_IN_NSEC(100));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+
+// fire: expire the head timer and reschedule it by its period, as execute_timers does
+template<class _ListType>
+void run_fire(benchmark::State &state)
+{
+	_ListType list;
+	std::vector<bench_timer> timers(state.range_x());
+	UINT32 seed = 12345;
+	populate(list, timers, seed);
+
+	while (state.KeepRunning())
+	{
+		bench_timer &timer = *list.first();
+		list.remove(timer);
+		timer.m_expire += timer.m_period;
+		list.insert(timer);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // anonymous namespace
+
+
+static void BM_timer_list_adjust(benchmark::State& state) { run_adjust<sorted_timer_list>(state); }
+static void BM_timer_heap_adjust(benchmark::State& state) { run_adjust<heap_timer_list>(state); }
+static void BM_timer_list_fire(benchmark::State& state) { run_fire<sorted_timer_list>(state); }
+static void BM_timer_heap_fire(benchmark::State& state) { run_fire<heap_timer_list>(state); }
+
+// Register the functions as benchmarks
+BENCHMARK(BM_timer_list_adjust)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_heap_adjust)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_list_fire)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(BM_timer_heap_fire)->Arg(10)->Arg(100)->Arg(1000);
@@ -247,6 +247,11 @@ newoption {
 	description = "Force DRC C backend.",
 }
 
+newoption {
+	trigger = "ARM64_DRC",
+	description = "Build and use the ARM64 DRC backend on arm64 targets; it has never been run, so check it with -drc_validate first.",
+}
+
 newoption {
 	trigger = "NOWERROR",
 	description = "NOWERROR",
@@ -673,15 +678,23 @@ end
 
 if not _OPTIONS["FORCE_DRC_C_BACKEND"] then
 	if _OPTIONS["BIGENDIAN"]~="1" then
-		configuration { "x64" }
-			defines {
-				"NATIVE_DRC=drcbe_x64",
-			}
-		configuration { "x32" }
-			defines {
-				"NATIVE_DRC=drcbe_x86",
-			}
-		configuration {  }
+		if _OPTIONS["PLATFORM"]=="arm64" then
+			if _OPTIONS["ARM64_DRC"]=="1" then
+				defines {
+					"NATIVE_DRC=drcbe_arm64",
+				}
+			end
+		else
+			configuration { "x64" }
+				defines {
+					"NATIVE_DRC=drcbe_x64",
+				}
+			configuration { "x32" }
+				defines {
+					"NATIVE_DRC=drcbe_x86",
+				}
+			configuration {  }
+		end
 	end
 end
 
@@ -64,11 +64,17 @@ project("benchmarks")
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/lib/util",
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/timerheap.cpp",
+		MAME_DIR .. "benchmarks/resampler.cpp",
+		MAME_DIR .. "benchmarks/renderspan.cpp",
+		MAME_DIR .. "src/emu/attotime.cpp",
 	}
 
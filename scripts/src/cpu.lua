@@ -11,18 +11,23 @@
 
 --------------------------------------------------
 -- Dynamic recompiler objects
+--@src/devices/cpu/drcuml.h,CPUS["DRCUML"] = true
 --------------------------------------------------
 
-if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null) then
+if (CPUS["DRCUML"]~=null or CPUS["SH2"]~=null or CPUS["SH4"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RSP"]~=null or CPUS["ARM7"]~=null or CPUS["I386"]~=null or VIDEOS["VOODOO"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/drcbec.cpp",
 		MAME_DIR .. "src/devices/cpu/drcbec.h",
+		MAME_DIR .. "src/devices/cpu/drcbeval.cpp",
+		MAME_DIR .. "src/devices/cpu/drcbeval.h",
 		MAME_DIR .. "src/devices/cpu/drcbeut.cpp",
 		MAME_DIR .. "src/devices/cpu/drcbeut.h",
 		MAME_DIR .. "src/devices/cpu/drccache.cpp",
 		MAME_DIR .. "src/devices/cpu/drccache.h",
 		MAME_DIR .. "src/devices/cpu/drcfe.cpp",
 		MAME_DIR .. "src/devices/cpu/drcfe.h",
+		MAME_DIR .. "src/devices/cpu/drctrace.cpp",
+		MAME_DIR .. "src/devices/cpu/drctrace.h",
 		MAME_DIR .. "src/devices/cpu/drcuml.cpp",
 		MAME_DIR .. "src/devices/cpu/drcuml.h",
 		MAME_DIR .. "src/devices/cpu/uml.cpp",
@@ -37,6 +42,14 @@ if (CPUS["SH2"]~=null or CPUS["MIPS"]~=null or CPUS["POWERPC"]~=null or CPUS["RS
 		MAME_DIR .. "src/devices/cpu/drcumlsh.h",
 		MAME_DIR .. "src/devices/cpu/x86emit.h",
 	}
+	-- the ARM64 backend has never been run, so it is only built on request
+	if _OPTIONS["ARM64_DRC"]=="1" then
+		files {
+			MAME_DIR .. "src/devices/cpu/drcbearm64.cpp",
+			MAME_DIR .. "src/devices/cpu/drcbearm64.h",
+			MAME_DIR .. "src/devices/cpu/arm64emit.h",
+		}
+	end
 end
 
 --------------------------------------------------
@@ -123,6 +136,7 @@ end
 if (CPUS["ARM7"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/cpu/arm7/arm7.cpp",
+		MAME_DIR .. "src/devices/cpu/arm7/arm7fe.cpp",
 		MAME_DIR .. "src/devices/cpu/arm7/arm7.h",
 		MAME_DIR .. "src/devices/cpu/arm7/arm7thmb.cpp",
 		MAME_DIR .. "src/devices/cpu/arm7/arm7ops.cpp",
@@ -132,7 +146,6 @@ if (CPUS["ARM7"]~=null) then
 		MAME_DIR .. "src/devices/cpu/arm7/arm7core.inc",
 		MAME_DIR .. "src/devices/cpu/arm7/arm7drc.inc",
 		MAME_DIR .. "src/devices/cpu/arm7/arm7help.h",
-		MAME_DIR .. "src/devices/cpu/arm7/arm7tdrc.inc",
 	}
 end
 
@@ -665,6 +678,16 @@ if (CPUS["SH4"]~=null) then
 		MAME_DIR .. "src/devices/cpu/sh4/sh4dmac.cpp",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4dmac.h",
 		MAME_DIR .. "src/devices/cpu/sh4/sh4regs.h",
+		MAME_DIR .. "src/devices/cpu/sh4/sh4fe.cpp",
+		--MAME_DIR .. "src/devices/cpu/sh4/sh4drc.cpp",
+	}
+end
+
+-- the SH-4 recompiler shares the SH-2 front end
+if (CPUS["SH4"]~=null and CPUS["SH2"]==null) then
+	files {
+		MAME_DIR .. "src/devices/cpu/sh2/sh2.h",
+		MAME_DIR .. "src/devices/cpu/sh2/sh2fe.cpp",
 	}
 end
 
@@ -909,6 +932,8 @@ if (CPUS["I386"]~=null) then
 		MAME_DIR .. "src/devices/cpu/i386/i386.cpp",
 		MAME_DIR .. "src/devices/cpu/i386/i386.h",
 		MAME_DIR .. "src/devices/cpu/i386/cycles.h",
+		MAME_DIR .. "src/devices/cpu/i386/i386drc.inc",
+		MAME_DIR .. "src/devices/cpu/i386/i386fe.cpp",
 		MAME_DIR .. "src/devices/cpu/i386/i386op16.inc",
 		MAME_DIR .. "src/devices/cpu/i386/i386op32.inc",
 		MAME_DIR .. "src/devices/cpu/i386/i386ops.h",
@@ -1362,6 +1387,7 @@ if (CPUS["M680X0"]~=null) then
 		MAME_DIR .. "src/devices/cpu/m68000/m68kcpu.cpp",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kcpu.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kops.cpp",
+		MAME_DIR .. "src/devices/cpu/m68000/m68kops000.cpp",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kops.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68000.h",
 		MAME_DIR .. "src/devices/cpu/m68000/m68kfpu.inc",
@@ -61,6 +61,8 @@ files {
 	MAME_DIR .. "src/emu/attotime.h",
 	MAME_DIR .. "src/emu/audit.cpp",
 	MAME_DIR .. "src/emu/audit.h",
+	MAME_DIR .. "src/emu/benchrep.cpp",
+	MAME_DIR .. "src/emu/benchrep.h",
 	MAME_DIR .. "src/emu/bookkeeping.cpp",
 	MAME_DIR .. "src/emu/bookkeeping.h",
 	MAME_DIR .. "src/emu/cheat.cpp",
@@ -190,6 +192,7 @@ files {
 	MAME_DIR .. "src/emu/softlist.h",
 	MAME_DIR .. "src/emu/sound.cpp",
 	MAME_DIR .. "src/emu/sound.h",
+	MAME_DIR .. "src/emu/resampler.h",
 	MAME_DIR .. "src/emu/speaker.cpp",
 	MAME_DIR .. "src/emu/speaker.h",
 	MAME_DIR .. "src/emu/sprite.cpp",
@@ -286,6 +289,7 @@ files {
 	MAME_DIR .. "src/emu/video.cpp",
 	MAME_DIR .. "src/emu/video.h",
 	MAME_DIR .. "src/emu/rendersw.inc",
+	MAME_DIR .. "src/emu/renderspan.h",
 	MAME_DIR .. "src/emu/debug/debugcmd.cpp",
 	MAME_DIR .. "src/emu/debug/debugcmd.h",
 	MAME_DIR .. "src/emu/debug/debugcon.cpp",
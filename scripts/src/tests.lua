@@ -79,6 +79,9 @@ project("mametests")
 	files {
 		MAME_DIR .. "tests/main.cpp",
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
+		MAME_DIR .. "tests/lib/util/coretmpl.cpp",
 		MAME_DIR .. "tests/emu/attotime.cpp",
+		MAME_DIR .. "tests/emu/resampler.cpp",
+		MAME_DIR .. "tests/emu/renderspan.cpp",
 	}
 
@@ -816,6 +816,8 @@ if (VIDEOS["VOODOO"]~=null) then
 		MAME_DIR .. "src/devices/video/voodoo.cpp",
 		MAME_DIR .. "src/devices/video/voodoo.h",
 		MAME_DIR .. "src/devices/video/vooddefs.h",
+		MAME_DIR .. "src/devices/video/voodoo_jit.cpp",
+		MAME_DIR .. "src/devices/video/voodoo_jit.h",
 	}
 end
 
@@ -2723,6 +2723,7 @@ files {
 createMESSProjects(_target, _subtarget, "test")
 files {
 	MAME_DIR .. "src/mame/drivers/test_t400.cpp",
+	MAME_DIR .. "src/mame/drivers/testdrc.cpp",
 	MAME_DIR .. "src/mame/drivers/zexall.cpp",
 }
 
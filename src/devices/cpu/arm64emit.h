@@ -0,0 +1,717 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    arm64emit.h
+
+    Generic AArch64 (ARMv8-A, A64 instruction set) code emitters.
+
+****************************************************************************
+
+    Conventions:
+
+    Every instruction is a single 32-bit word. Emitters that can operate
+    on either 32-bit (Wn) or 64-bit (Xn) registers take an "sf" parameter
+    first, which is 0 for the 32-bit form and 1 for the 64-bit form.
+
+    Register number 31 means either the zero register (XZR/WZR) or the
+    stack pointer, depending on the instruction; the emitters do not try
+    to hide this, so callers must take care not to pass REG_ZR where the
+    encoding means SP and vice versa.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __ARM64EMIT_H__
+#define __ARM64EMIT_H__
+
+
+namespace arm64emit
+{
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// use arm64code * to reference generated code
+typedef UINT32 arm64code;
+
+// this structure tracks a branch whose target is resolved later
+struct branch_link
+{
+	arm64code *     source;
+};
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// integer registers
+const UINT8 REG_X0          = 0;
+const UINT8 REG_X1          = 1;
+const UINT8 REG_X2          = 2;
+const UINT8 REG_X3          = 3;
+const UINT8 REG_X4          = 4;
+const UINT8 REG_X5          = 5;
+const UINT8 REG_X6          = 6;
+const UINT8 REG_X7          = 7;
+const UINT8 REG_X8          = 8;
+const UINT8 REG_X9          = 9;
+const UINT8 REG_X10         = 10;
+const UINT8 REG_X11         = 11;
+const UINT8 REG_X12         = 12;
+const UINT8 REG_X13         = 13;
+const UINT8 REG_X14         = 14;
+const UINT8 REG_X15         = 15;
+const UINT8 REG_X16         = 16;
+const UINT8 REG_X17         = 17;
+const UINT8 REG_X18         = 18;
+const UINT8 REG_X19         = 19;
+const UINT8 REG_X20         = 20;
+const UINT8 REG_X21         = 21;
+const UINT8 REG_X22         = 22;
+const UINT8 REG_X23         = 23;
+const UINT8 REG_X24         = 24;
+const UINT8 REG_X25         = 25;
+const UINT8 REG_X26         = 26;
+const UINT8 REG_X27         = 27;
+const UINT8 REG_X28         = 28;
+const UINT8 REG_FP          = 29;
+const UINT8 REG_LR          = 30;
+const UINT8 REG_SP          = 31;
+const UINT8 REG_ZR          = 31;
+
+// floating-point registers
+const UINT8 REG_D0          = 0;
+const UINT8 REG_D1          = 1;
+const UINT8 REG_D2          = 2;
+const UINT8 REG_D3          = 3;
+const UINT8 REG_D8          = 8;
+const UINT8 REG_D9          = 9;
+const UINT8 REG_D10         = 10;
+const UINT8 REG_D11         = 11;
+const UINT8 REG_D12         = 12;
+const UINT8 REG_D13         = 13;
+const UINT8 REG_D14         = 14;
+const UINT8 REG_D15         = 15;
+
+// condition codes
+const UINT8 COND_EQ         = 0x0;
+const UINT8 COND_NE         = 0x1;
+const UINT8 COND_CS         = 0x2;
+const UINT8 COND_CC         = 0x3;
+const UINT8 COND_MI         = 0x4;
+const UINT8 COND_PL         = 0x5;
+const UINT8 COND_VS         = 0x6;
+const UINT8 COND_VC         = 0x7;
+const UINT8 COND_HI         = 0x8;
+const UINT8 COND_LS         = 0x9;
+const UINT8 COND_GE         = 0xa;
+const UINT8 COND_LT         = 0xb;
+const UINT8 COND_GT         = 0xc;
+const UINT8 COND_LE         = 0xd;
+const UINT8 COND_AL         = 0xe;
+
+// NZCV bits, as read by MRS and written by MSR
+const UINT32 NZCV_N         = 0x80000000;
+const UINT32 NZCV_Z         = 0x40000000;
+const UINT32 NZCV_C         = 0x20000000;
+const UINT32 NZCV_V         = 0x10000000;
+
+// shift types for shifted-register operands
+const UINT8 SHIFT_LSL       = 0;
+const UINT8 SHIFT_LSR       = 1;
+const UINT8 SHIFT_ASR       = 2;
+const UINT8 SHIFT_ROR       = 3;
+
+// extend types for extended-register operands
+const UINT8 EXTEND_UXTW     = 2;
+const UINT8 EXTEND_UXTX     = 3;
+const UINT8 EXTEND_SXTW     = 6;
+const UINT8 EXTEND_SXTX     = 7;
+
+// load/store opcodes, in unsigned scaled offset form; bits 31:30 give the log2 of the access size
+const UINT32 LDST_STRB      = 0x39000000;
+const UINT32 LDST_LDRB      = 0x39400000;
+const UINT32 LDST_LDRSB_X   = 0x39800000;
+const UINT32 LDST_LDRSB_W   = 0x39c00000;
+const UINT32 LDST_STRH      = 0x79000000;
+const UINT32 LDST_LDRH      = 0x79400000;
+const UINT32 LDST_LDRSH_X   = 0x79800000;
+const UINT32 LDST_LDRSH_W   = 0x79c00000;
+const UINT32 LDST_STR_W     = 0xb9000000;
+const UINT32 LDST_LDR_W     = 0xb9400000;
+const UINT32 LDST_LDRSW     = 0xb9800000;
+const UINT32 LDST_STR_X     = 0xf9000000;
+const UINT32 LDST_LDR_X     = 0xf9400000;
+const UINT32 LDST_STR_S     = 0xbd000000;
+const UINT32 LDST_LDR_S     = 0xbd400000;
+const UINT32 LDST_STR_D     = 0xfd000000;
+const UINT32 LDST_LDR_D     = 0xfd400000;
+
+// FPCR rounding mode field
+const UINT32 FPCR_RMODE_SHIFT = 22;
+const UINT32 FPCR_RMODE_MASK  = 3 << FPCR_RMODE_SHIFT;
+
+
+
+//**************************************************************************
+//  HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_op - emit a raw instruction word
+//-------------------------------------------------
+
+inline void emit_op(arm64code *&emitptr, UINT32 op)
+{
+	*emitptr++ = op;
+}
+
+
+//-------------------------------------------------
+//  is_valid_addsub_immediate - return true if the
+//  value can be encoded as an ADD/SUB immediate
+//-------------------------------------------------
+
+inline bool is_valid_addsub_immediate(UINT64 value)
+{
+	return (value < 0x1000) || ((value & 0xfff) == 0 && value < 0x1000000);
+}
+
+
+//-------------------------------------------------
+//  encode_logical_immediate - attempt to encode a
+//  value as a logical (bitmask) immediate; returns
+//  false if it can't be done
+//-------------------------------------------------
+
+inline bool encode_logical_immediate(int sf, UINT64 value, UINT32 &encoding)
+{
+	// 32-bit values are treated as a replicated 64-bit pattern
+	if (!sf)
+		value = (value & 0xffffffff) | (value << 32);
+	if (value == 0 || value == ~U64(0))
+		return false;
+
+	// find the size of the smallest repeating element
+	int size = 64;
+	while (size > 2)
+	{
+		int half = size / 2;
+		UINT64 halfmask = (U64(1) << half) - 1;
+		if ((value & halfmask) != ((value >> half) & halfmask))
+			break;
+		size = half;
+	}
+
+	// the element must be a rotated run of ones
+	UINT64 mask = (size == 64) ? ~U64(0) : ((U64(1) << size) - 1);
+	UINT64 elem = value & mask;
+	int ones = 0;
+	for (UINT64 temp = elem; temp != 0; temp &= temp - 1)
+		ones++;
+	UINT64 run = (U64(1) << ones) - 1;
+	for (int rot = 0; rot < size; rot++)
+	{
+		UINT64 rotated = (rot == 0) ? elem : (((elem >> rot) | (elem << (size - rot))) & mask);
+		if (rotated == run)
+		{
+			UINT32 immr = (size - rot) & (size - 1);
+			UINT32 imms = (((UINT32(0) - size) << 1) | (ones - 1)) & 0x3f;
+			encoding = ((size == 64) << 22) | (immr << 16) | (imms << 10);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  branch_in_range - return true if the distance
+//  between two code pointers fits in a signed
+//  field of the given number of bits (in words)
+//-------------------------------------------------
+
+inline bool branch_in_range(const arm64code *source, const void *target, int bits)
+{
+	INT64 delta = (const UINT8 *)target - (const UINT8 *)source;
+	return ((delta & 3) == 0 && (delta >> 2) >= -(INT64(1) << (bits - 1)) && (delta >> 2) < (INT64(1) << (bits - 1)));
+}
+
+
+
+//**************************************************************************
+//  INTEGER ARITHMETIC EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_add/sub_imm - add/subtract an immediate;
+//  register 31 means SP for rd (non-flag-setting
+//  forms) and for rn
+//-------------------------------------------------
+
+inline void emit_addsub_imm(arm64code *&emitptr, UINT32 op, int sf, UINT8 rd, UINT8 rn, UINT32 imm)
+{
+	assert(is_valid_addsub_immediate(imm));
+	if (imm >= 0x1000)
+		op |= (1 << 22) | ((imm >> 12) << 10);
+	else
+		op |= imm << 10;
+	emit_op(emitptr, op | (sf << 31) | (rn << 5) | rd);
+}
+
+inline void emit_add_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT32 imm)  { emit_addsub_imm(emitptr, 0x11000000, sf, rd, rn, imm); }
+inline void emit_adds_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT32 imm) { emit_addsub_imm(emitptr, 0x31000000, sf, rd, rn, imm); }
+inline void emit_sub_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT32 imm)  { emit_addsub_imm(emitptr, 0x51000000, sf, rd, rn, imm); }
+inline void emit_subs_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT32 imm) { emit_addsub_imm(emitptr, 0x71000000, sf, rd, rn, imm); }
+inline void emit_cmp_imm(arm64code *&emitptr, int sf, UINT8 rn, UINT32 imm)            { emit_subs_imm(emitptr, sf, REG_ZR, rn, imm); }
+inline void emit_mov_sp(arm64code *&emitptr, UINT8 rd, UINT8 rn)                        { emit_add_imm(emitptr, 1, rd, rn, 0); }
+
+
+//-------------------------------------------------
+//  emit_add/sub_reg - add/subtract a shifted
+//  register; register 31 means ZR
+//-------------------------------------------------
+
+inline void emit_addsub_reg(arm64code *&emitptr, UINT32 op, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift, UINT8 amount)
+{
+	emit_op(emitptr, op | (sf << 31) | (shift << 22) | (rm << 16) | (amount << 10) | (rn << 5) | rd);
+}
+
+inline void emit_add_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_addsub_reg(emitptr, 0x0b000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_adds_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_addsub_reg(emitptr, 0x2b000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_sub_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_addsub_reg(emitptr, 0x4b000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_subs_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_addsub_reg(emitptr, 0x6b000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_cmp_reg(arm64code *&emitptr, int sf, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)             { emit_subs_reg(emitptr, sf, REG_ZR, rn, rm, shift, amount); }
+inline void emit_neg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rm)                                                             { emit_sub_reg(emitptr, sf, rd, REG_ZR, rm); }
+
+
+//-------------------------------------------------
+//  emit_add_ext - add an extended register; the
+//  rd and rn registers are always 64-bit and 31
+//  means SP
+//-------------------------------------------------
+
+inline void emit_add_ext(arm64code *&emitptr, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 extend, UINT8 amount)
+{
+	assert(amount <= 4);
+	emit_op(emitptr, 0x8b200000 | (rm << 16) | (extend << 13) | (amount << 10) | (rn << 5) | rd);
+}
+
+
+//-------------------------------------------------
+//  emit_adc/sbc - add/subtract with carry
+//-------------------------------------------------
+
+inline void emit_adc(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm)  { emit_op(emitptr, 0x1a000000 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_adcs(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x3a000000 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_sbc(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm)  { emit_op(emitptr, 0x5a000000 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_sbcs(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x7a000000 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+
+
+//-------------------------------------------------
+//  emit_mul/div - multiply and divide
+//-------------------------------------------------
+
+inline void emit_madd(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 ra)  { emit_op(emitptr, 0x1b000000 | (sf << 31) | (rm << 16) | (ra << 10) | (rn << 5) | rd); }
+inline void emit_msub(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 ra)  { emit_op(emitptr, 0x1b008000 | (sf << 31) | (rm << 16) | (ra << 10) | (rn << 5) | rd); }
+inline void emit_mul(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm)             { emit_madd(emitptr, sf, rd, rn, rm, REG_ZR); }
+inline void emit_smull(arm64code *&emitptr, UINT8 rd, UINT8 rn, UINT8 rm)                   { emit_op(emitptr, 0x9b207c00 | (rm << 16) | (rn << 5) | rd); }
+inline void emit_umull(arm64code *&emitptr, UINT8 rd, UINT8 rn, UINT8 rm)                   { emit_op(emitptr, 0x9ba07c00 | (rm << 16) | (rn << 5) | rd); }
+inline void emit_smulh(arm64code *&emitptr, UINT8 rd, UINT8 rn, UINT8 rm)                   { emit_op(emitptr, 0x9b407c00 | (rm << 16) | (rn << 5) | rd); }
+inline void emit_umulh(arm64code *&emitptr, UINT8 rd, UINT8 rn, UINT8 rm)                   { emit_op(emitptr, 0x9bc07c00 | (rm << 16) | (rn << 5) | rd); }
+inline void emit_udiv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm)            { emit_op(emitptr, 0x1ac00800 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_sdiv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm)            { emit_op(emitptr, 0x1ac00c00 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+
+
+
+//**************************************************************************
+//  LOGICAL AND BITFIELD EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_and/orr/eor/... - logical operations on a
+//  shifted register; register 31 means ZR
+//-------------------------------------------------
+
+inline void emit_logical_reg(arm64code *&emitptr, UINT32 op, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift, UINT8 amount)
+{
+	emit_op(emitptr, op | (sf << 31) | (shift << 22) | (rm << 16) | (amount << 10) | (rn << 5) | rd);
+}
+
+inline void emit_and_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(emitptr, 0x0a000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_bic_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(emitptr, 0x0a200000, sf, rd, rn, rm, shift, amount); }
+inline void emit_orr_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(emitptr, 0x2a000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_orn_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(emitptr, 0x2a200000, sf, rd, rn, rm, shift, amount); }
+inline void emit_eor_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0)  { emit_logical_reg(emitptr, 0x4a000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_ands_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 shift = SHIFT_LSL, UINT8 amount = 0) { emit_logical_reg(emitptr, 0x6a000000, sf, rd, rn, rm, shift, amount); }
+inline void emit_mov_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rm)                                                        { emit_orr_reg(emitptr, sf, rd, REG_ZR, rm); }
+inline void emit_mvn_reg(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rm)                                                        { emit_orn_reg(emitptr, sf, rd, REG_ZR, rm); }
+
+
+//-------------------------------------------------
+//  emit_and/orr/eor_imm - logical operations on a
+//  bitmask immediate, which must be encodable
+//-------------------------------------------------
+
+inline void emit_logical_imm(arm64code *&emitptr, UINT32 op, int sf, UINT8 rd, UINT8 rn, UINT64 imm)
+{
+	UINT32 encoding = 0;
+	if (!encode_logical_immediate(sf, imm, encoding))
+		throw emu_fatalerror("arm64emit: unencodable logical immediate %08X%08X\n", UINT32(imm >> 32), UINT32(imm));
+	emit_op(emitptr, op | (sf << 31) | encoding | (rn << 5) | rd);
+}
+
+inline void emit_and_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(emitptr, 0x12000000, sf, rd, rn, imm); }
+inline void emit_orr_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(emitptr, 0x32000000, sf, rd, rn, imm); }
+inline void emit_eor_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT64 imm)  { emit_logical_imm(emitptr, 0x52000000, sf, rd, rn, imm); }
+inline void emit_ands_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT64 imm) { emit_logical_imm(emitptr, 0x72000000, sf, rd, rn, imm); }
+
+
+//-------------------------------------------------
+//  emit_movz/movn/movk - move wide immediates
+//-------------------------------------------------
+
+inline void emit_movz(arm64code *&emitptr, int sf, UINT8 rd, UINT16 imm, int hw) { emit_op(emitptr, 0x52800000 | (sf << 31) | (hw << 21) | (imm << 5) | rd); }
+inline void emit_movn(arm64code *&emitptr, int sf, UINT8 rd, UINT16 imm, int hw) { emit_op(emitptr, 0x12800000 | (sf << 31) | (hw << 21) | (imm << 5) | rd); }
+inline void emit_movk(arm64code *&emitptr, int sf, UINT8 rd, UINT16 imm, int hw) { emit_op(emitptr, 0x72800000 | (sf << 31) | (hw << 21) | (imm << 5) | rd); }
+
+
+//-------------------------------------------------
+//  emit_mov_imm - load an arbitrary immediate
+//  using the shortest sequence we know of
+//-------------------------------------------------
+
+inline void emit_mov_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT64 imm)
+{
+	int halves = sf ? 4 : 2;
+	if (!sf)
+		imm = UINT32(imm);
+
+	// count the halfwords that are all zeros or all ones
+	int zeros = 0, ones = 0;
+	for (int hw = 0; hw < halves; hw++)
+	{
+		UINT16 chunk = imm >> (hw * 16);
+		zeros += (chunk == 0x0000);
+		ones += (chunk == 0xffff);
+	}
+
+	// a single MOVZ or MOVN if possible, otherwise a bitmask immediate
+	UINT32 encoding;
+	if (zeros < halves - 1 && ones < halves - 1 && encode_logical_immediate(sf, imm, encoding))
+	{
+		emit_op(emitptr, 0x32000000 | (sf << 31) | encoding | (REG_ZR << 5) | rd);          // orr   rd,zr,#imm
+		return;
+	}
+
+	// start with MOVN if most of the halfwords are ones, MOVZ otherwise; fill in the rest with MOVK
+	bool inverted = (ones > zeros);
+	UINT16 skip = inverted ? 0xffff : 0x0000;
+	bool first = true;
+	for (int hw = 0; hw < halves; hw++)
+	{
+		UINT16 chunk = imm >> (hw * 16);
+		if (chunk == skip)
+			continue;
+		if (first)
+		{
+			if (inverted)
+				emit_movn(emitptr, sf, rd, ~chunk, hw);                                     // movn  rd,#~chunk,lsl #hw*16
+			else
+				emit_movz(emitptr, sf, rd, chunk, hw);                                      // movz  rd,#chunk,lsl #hw*16
+			first = false;
+		}
+		else
+			emit_movk(emitptr, sf, rd, chunk, hw);                                          // movk  rd,#chunk,lsl #hw*16
+	}
+
+	// every halfword matched the fill value
+	if (first)
+	{
+		if (inverted)
+			emit_movn(emitptr, sf, rd, 0, 0);                                               // movn  rd,#0
+		else
+			emit_movz(emitptr, sf, rd, 0, 0);                                               // movz  rd,#0
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_sbfm/bfm/ubfm - bitfield moves, along with
+//  the common aliases built on them
+//-------------------------------------------------
+
+inline void emit_sbfm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms) { emit_op(emitptr, 0x13000000 | (sf << 31) | (sf << 22) | (immr << 16) | (imms << 10) | (rn << 5) | rd); }
+inline void emit_bfm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms)  { emit_op(emitptr, 0x33000000 | (sf << 31) | (sf << 22) | (immr << 16) | (imms << 10) | (rn << 5) | rd); }
+inline void emit_ubfm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 immr, UINT8 imms) { emit_op(emitptr, 0x53000000 | (sf << 31) | (sf << 22) | (immr << 16) | (imms << 10) | (rn << 5) | rd); }
+
+inline void emit_lsl_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 shift) { int size = sf ? 64 : 32; emit_ubfm(emitptr, sf, rd, rn, (size - shift) & (size - 1), size - 1 - shift); }
+inline void emit_lsr_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 shift) { emit_ubfm(emitptr, sf, rd, rn, shift, sf ? 63 : 31); }
+inline void emit_asr_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 shift) { emit_sbfm(emitptr, sf, rd, rn, shift, sf ? 63 : 31); }
+inline void emit_sxtb(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn)                 { emit_sbfm(emitptr, sf, rd, rn, 0, 7); }
+inline void emit_sxth(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn)                 { emit_sbfm(emitptr, sf, rd, rn, 0, 15); }
+inline void emit_sxtw(arm64code *&emitptr, UINT8 rd, UINT8 rn)                         { emit_sbfm(emitptr, 1, rd, rn, 0, 31); }
+inline void emit_uxtb(arm64code *&emitptr, UINT8 rd, UINT8 rn)                         { emit_ubfm(emitptr, 0, rd, rn, 0, 7); }
+inline void emit_uxth(arm64code *&emitptr, UINT8 rd, UINT8 rn)                         { emit_ubfm(emitptr, 0, rd, rn, 0, 15); }
+inline void emit_bfi(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 lsb, UINT8 width)  { int size = sf ? 64 : 32; emit_bfm(emitptr, sf, rd, rn, (size - lsb) & (size - 1), width - 1); }
+inline void emit_ubfx(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 lsb, UINT8 width) { emit_ubfm(emitptr, sf, rd, rn, lsb, lsb + width - 1); }
+
+
+//-------------------------------------------------
+//  emit_extr/ror_imm - extract and rotate
+//-------------------------------------------------
+
+inline void emit_extr(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 lsb) { emit_op(emitptr, 0x13800000 | (sf << 31) | (sf << 22) | (rm << 16) | (lsb << 10) | (rn << 5) | rd); }
+inline void emit_ror_imm(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 shift)      { emit_extr(emitptr, sf, rd, rn, rn, shift); }
+
+
+//-------------------------------------------------
+//  emit_lslv/lsrv/asrv/rorv - variable shifts; the
+//  shift count is taken modulo the register size
+//-------------------------------------------------
+
+inline void emit_lslv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x1ac02000 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_lsrv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x1ac02400 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_asrv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x1ac02800 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+inline void emit_rorv(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm) { emit_op(emitptr, 0x1ac02c00 | (sf << 31) | (rm << 16) | (rn << 5) | rd); }
+
+
+//-------------------------------------------------
+//  emit_clz/rev - single-source operations
+//-------------------------------------------------
+
+inline void emit_clz(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn) { emit_op(emitptr, 0x5ac01000 | (sf << 31) | (rn << 5) | rd); }
+inline void emit_rev(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn) { emit_op(emitptr, (sf ? 0xdac00c00 : 0x5ac00800) | (rn << 5) | rd); }
+
+
+//-------------------------------------------------
+//  emit_csel/cset - conditional select
+//-------------------------------------------------
+
+inline void emit_csel(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 cond)  { emit_op(emitptr, 0x1a800000 | (sf << 31) | (rm << 16) | (cond << 12) | (rn << 5) | rd); }
+inline void emit_csinc(arm64code *&emitptr, int sf, UINT8 rd, UINT8 rn, UINT8 rm, UINT8 cond) { emit_op(emitptr, 0x1a800400 | (sf << 31) | (rm << 16) | (cond << 12) | (rn << 5) | rd); }
+inline void emit_cset(arm64code *&emitptr, int sf, UINT8 rd, UINT8 cond)                      { emit_csinc(emitptr, sf, rd, REG_ZR, REG_ZR, cond ^ 1); }
+
+
+
+//**************************************************************************
+//  SYSTEM REGISTER EMITTERS
+//**************************************************************************
+
+inline void emit_mrs_nzcv(arm64code *&emitptr, UINT8 rt) { emit_op(emitptr, 0xd53b4200 | rt); }
+inline void emit_msr_nzcv(arm64code *&emitptr, UINT8 rt) { emit_op(emitptr, 0xd51b4200 | rt); }
+inline void emit_mrs_fpcr(arm64code *&emitptr, UINT8 rt) { emit_op(emitptr, 0xd53b4400 | rt); }
+inline void emit_msr_fpcr(arm64code *&emitptr, UINT8 rt) { emit_op(emitptr, 0xd51b4400 | rt); }
+
+
+
+//**************************************************************************
+//  LOAD/STORE EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  ldst_size_shift - return the log2 of the access
+//  size of a load/store opcode
+//-------------------------------------------------
+
+inline int ldst_size_shift(UINT32 op)
+{
+	// vector/FP accesses of 128 bits are not used here, so the size field is sufficient
+	return op >> 30;
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_uimm - load/store with an unsigned,
+//  scaled 12-bit offset
+//-------------------------------------------------
+
+inline void emit_ldst_uimm(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rn, UINT32 offset)
+{
+	int shift = ldst_size_shift(op);
+	assert((offset & ((1 << shift) - 1)) == 0 && (offset >> shift) < 0x1000);
+	emit_op(emitptr, op | ((offset >> shift) << 10) | (rn << 5) | rt);
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_simm - load/store with a signed,
+//  unscaled 9-bit offset, optionally with pre- or
+//  post-indexed writeback
+//-------------------------------------------------
+
+inline void emit_ldst_simm(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rn, INT32 offset)     { assert(offset >= -256 && offset < 256); emit_op(emitptr, (op & ~0x01000000) | ((offset & 0x1ff) << 12) | (rn << 5) | rt); }
+inline void emit_ldst_preidx(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rn, INT32 offset)   { assert(offset >= -256 && offset < 256); emit_op(emitptr, (op & ~0x01000000) | ((offset & 0x1ff) << 12) | 0xc00 | (rn << 5) | rt); }
+inline void emit_ldst_postidx(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rn, INT32 offset)  { assert(offset >= -256 && offset < 256); emit_op(emitptr, (op & ~0x01000000) | ((offset & 0x1ff) << 12) | 0x400 | (rn << 5) | rt); }
+
+
+//-------------------------------------------------
+//  emit_ldst_reg - load/store with a register
+//  index, optionally scaled by the access size
+//-------------------------------------------------
+
+inline void emit_ldst_reg(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rn, UINT8 rm, UINT8 extend, bool scaled)
+{
+	emit_op(emitptr, (op & ~0x01000000) | 0x00200800 | (rm << 16) | (extend << 13) | (scaled << 12) | (rn << 5) | rt);
+}
+
+
+//-------------------------------------------------
+//  emit_ldp/stp - load/store a pair of 64-bit
+//  integer (X) or FP (D) registers
+//-------------------------------------------------
+
+inline void emit_ldstp(arm64code *&emitptr, UINT32 op, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)
+{
+	assert((offset & 7) == 0 && offset >= -512 && offset < 512);
+	emit_op(emitptr, op | (((offset >> 3) & 0x7f) << 15) | (rt2 << 10) | (rn << 5) | rt);
+}
+
+inline void emit_stp_x(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)         { emit_ldstp(emitptr, 0xa9000000, rt, rt2, rn, offset); }
+inline void emit_ldp_x(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)         { emit_ldstp(emitptr, 0xa9400000, rt, rt2, rn, offset); }
+inline void emit_stp_x_preidx(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)  { emit_ldstp(emitptr, 0xa9800000, rt, rt2, rn, offset); }
+inline void emit_ldp_x_postidx(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset) { emit_ldstp(emitptr, 0xa8c00000, rt, rt2, rn, offset); }
+inline void emit_stp_d(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)         { emit_ldstp(emitptr, 0x6d000000, rt, rt2, rn, offset); }
+inline void emit_ldp_d(arm64code *&emitptr, UINT8 rt, UINT8 rt2, UINT8 rn, INT32 offset)         { emit_ldstp(emitptr, 0x6d400000, rt, rt2, rn, offset); }
+
+
+//-------------------------------------------------
+//  emit_adr/adrp - PC-relative addresses
+//-------------------------------------------------
+
+inline void emit_adr(arm64code *&emitptr, UINT8 rd, const void *target)
+{
+	INT64 delta = (const UINT8 *)target - (const UINT8 *)emitptr;
+	assert(delta >= -(1 << 20) && delta < (1 << 20));
+	emit_op(emitptr, 0x10000000 | ((delta & 3) << 29) | (((delta >> 2) & 0x7ffff) << 5) | rd);
+}
+
+inline bool emit_adrp(arm64code *&emitptr, UINT8 rd, const void *target)
+{
+	INT64 delta = INT64(FPTR(target) >> 12) - INT64(FPTR(emitptr) >> 12);
+	if (delta < -(1 << 20) || delta >= (1 << 20))
+		return false;
+	emit_op(emitptr, 0x90000000 | ((delta & 3) << 29) | (((delta >> 2) & 0x7ffff) << 5) | rd);
+	return true;
+}
+
+
+
+//**************************************************************************
+//  BRANCH EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  resolve_link - point a previously emitted
+//  branch at the given target
+//-------------------------------------------------
+
+inline void resolve_link(const arm64code *target, const branch_link &link)
+{
+	arm64code *src = link.source;
+	INT64 delta = (target - src);
+	UINT32 op = *src;
+
+	// B/BL: 26-bit offset
+	if ((op & 0x7c000000) == 0x14000000)
+	{
+		if (!branch_in_range(src, target, 26))
+			throw emu_fatalerror("arm64emit: branch target out of range\n");
+		*src = (op & 0xfc000000) | (delta & 0x3ffffff);
+	}
+
+	// B.cond, CBZ/CBNZ: 19-bit offset
+	else if ((op & 0xff000010) == 0x54000000 || (op & 0x7e000000) == 0x34000000)
+	{
+		if (!branch_in_range(src, target, 19))
+			throw emu_fatalerror("arm64emit: conditional branch target out of range\n");
+		*src = (op & 0xff00001f) | ((delta & 0x7ffff) << 5);
+	}
+
+	// TBZ/TBNZ: 14-bit offset
+	else if ((op & 0x7e000000) == 0x36000000)
+	{
+		if (!branch_in_range(src, target, 14))
+			throw emu_fatalerror("arm64emit: test branch target out of range\n");
+		*src = (op & 0xfff8001f) | ((delta & 0x3fff) << 5);
+	}
+	else
+		throw emu_fatalerror("arm64emit: resolve_link called with invalid branch source\n");
+}
+
+
+//-------------------------------------------------
+//  emit_b/bl/b_cond/cbz/tbz - PC-relative
+//  branches, either to a known target or to a
+//  link resolved later
+//-------------------------------------------------
+
+inline void emit_b_link(arm64code *&emitptr, branch_link &link)                             { link.source = emitptr; emit_op(emitptr, 0x14000000); }
+inline void emit_bl_link(arm64code *&emitptr, branch_link &link)                            { link.source = emitptr; emit_op(emitptr, 0x94000000); }
+inline void emit_b_cond_link(arm64code *&emitptr, UINT8 cond, branch_link &link)            { link.source = emitptr; emit_op(emitptr, 0x54000000 | cond); }
+inline void emit_cbz_link(arm64code *&emitptr, int sf, UINT8 rt, branch_link &link)         { link.source = emitptr; emit_op(emitptr, 0x34000000 | (sf << 31) | rt); }
+inline void emit_cbnz_link(arm64code *&emitptr, int sf, UINT8 rt, branch_link &link)        { link.source = emitptr; emit_op(emitptr, 0x35000000 | (sf << 31) | rt); }
+inline void emit_tbz_link(arm64code *&emitptr, UINT8 rt, UINT8 bit, branch_link &link)      { link.source = emitptr; emit_op(emitptr, 0x36000000 | ((bit >> 5) << 31) | ((bit & 0x1f) << 19) | rt); }
+inline void emit_tbnz_link(arm64code *&emitptr, UINT8 rt, UINT8 bit, branch_link &link)     { link.source = emitptr; emit_op(emitptr, 0x37000000 | ((bit >> 5) << 31) | ((bit & 0x1f) << 19) | rt); }
+
+inline void emit_b(arm64code *&emitptr, const arm64code *target)                  { branch_link link; emit_b_link(emitptr, link); resolve_link(target, link); }
+inline void emit_bl(arm64code *&emitptr, const arm64code *target)                 { branch_link link; emit_bl_link(emitptr, link); resolve_link(target, link); }
+inline void emit_b_cond(arm64code *&emitptr, UINT8 cond, const arm64code *target) { branch_link link; emit_b_cond_link(emitptr, cond, link); resolve_link(target, link); }
+
+
+//-------------------------------------------------
+//  emit_br/blr/ret - register-indirect branches
+//-------------------------------------------------
+
+inline void emit_br(arm64code *&emitptr, UINT8 rn)  { emit_op(emitptr, 0xd61f0000 | (rn << 5)); }
+inline void emit_blr(arm64code *&emitptr, UINT8 rn) { emit_op(emitptr, 0xd63f0000 | (rn << 5)); }
+inline void emit_ret(arm64code *&emitptr)           { emit_op(emitptr, 0xd65f0000 | (REG_LR << 5)); }
+
+
+
+//**************************************************************************
+//  FLOATING-POINT EMITTERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  all FP emitters take an "ftype" parameter,
+//  which is 0 for single and 1 for double
+//  precision
+//-------------------------------------------------
+
+inline void emit_fp1(arm64code *&emitptr, UINT32 opcode, int ftype, UINT8 rd, UINT8 rn)             { emit_op(emitptr, 0x1e204000 | (ftype << 22) | (opcode << 15) | (rn << 5) | rd); }
+inline void emit_fmov(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                           { emit_fp1(emitptr, 0x00, ftype, rd, rn); }
+inline void emit_fabs(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                           { emit_fp1(emitptr, 0x01, ftype, rd, rn); }
+inline void emit_fneg(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                           { emit_fp1(emitptr, 0x02, ftype, rd, rn); }
+inline void emit_fsqrt(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                          { emit_fp1(emitptr, 0x03, ftype, rd, rn); }
+inline void emit_fcvt_to_single(arm64code *&emitptr, UINT8 rd, UINT8 rn)                            { emit_fp1(emitptr, 0x04, 1, rd, rn); }
+inline void emit_fcvt_to_double(arm64code *&emitptr, UINT8 rd, UINT8 rn)                            { emit_fp1(emitptr, 0x05, 0, rd, rn); }
+inline void emit_frinti(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                         { emit_fp1(emitptr, 0x0f, ftype, rd, rn); }
+
+inline void emit_fp2(arm64code *&emitptr, UINT32 opcode, int ftype, UINT8 rd, UINT8 rn, UINT8 rm)   { emit_op(emitptr, 0x1e200800 | (ftype << 22) | (rm << 16) | (opcode << 12) | (rn << 5) | rd); }
+inline void emit_fmul(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn, UINT8 rm)                 { emit_fp2(emitptr, 0x0, ftype, rd, rn, rm); }
+inline void emit_fdiv(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn, UINT8 rm)                 { emit_fp2(emitptr, 0x1, ftype, rd, rn, rm); }
+inline void emit_fadd(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn, UINT8 rm)                 { emit_fp2(emitptr, 0x2, ftype, rd, rn, rm); }
+inline void emit_fsub(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn, UINT8 rm)                 { emit_fp2(emitptr, 0x3, ftype, rd, rn, rm); }
+
+inline void emit_fcmp(arm64code *&emitptr, int ftype, UINT8 rn, UINT8 rm)                           { emit_op(emitptr, 0x1e202000 | (ftype << 22) | (rm << 16) | (rn << 5)); }
+inline void emit_fmov_one(arm64code *&emitptr, int ftype, UINT8 rd)                                 { emit_op(emitptr, 0x1e2e1000 | (ftype << 22) | rd); }
+
+// moves between integer and FP registers, without conversion
+inline void emit_fmov_to_gp(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                     { emit_op(emitptr, (ftype ? 0x9e660000 : 0x1e260000) | (rn << 5) | rd); }
+inline void emit_fmov_from_gp(arm64code *&emitptr, int ftype, UINT8 rd, UINT8 rn)                   { emit_op(emitptr, (ftype ? 0x9e670000 : 0x1e270000) | (rn << 5) | rd); }
+
+// conversions between integer and FP; sf gives the integer size
+inline void emit_scvtf(arm64code *&emitptr, int sf, int ftype, UINT8 rd, UINT8 rn)                  { emit_op(emitptr, 0x1e220000 | (sf << 31) | (ftype << 22) | (rn << 5) | rd); }
+inline void emit_fcvtzs(arm64code *&emitptr, int sf, int ftype, UINT8 rd, UINT8 rn)                 { emit_op(emitptr, 0x1e380000 | (sf << 31) | (ftype << 22) | (rn << 5) | rd); }
+inline void emit_fcvtns(arm64code *&emitptr, int sf, int ftype, UINT8 rd, UINT8 rn)                 { emit_op(emitptr, 0x1e200000 | (sf << 31) | (ftype << 22) | (rn << 5) | rd); }
+inline void emit_fcvtps(arm64code *&emitptr, int sf, int ftype, UINT8 rd, UINT8 rn)                 { emit_op(emitptr, 0x1e280000 | (sf << 31) | (ftype << 22) | (rn << 5) | rd); }
+inline void emit_fcvtms(arm64code *&emitptr, int sf, int ftype, UINT8 rd, UINT8 rn)                 { emit_op(emitptr, 0x1e300000 | (sf << 31) | (ftype << 22) | (rn << 5) | rd); }
+
+}
+
+#endif /* __ARM64EMIT_H__ */
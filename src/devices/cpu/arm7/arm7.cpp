@@ -26,25 +26,16 @@
 
 TODO:
 - Cleanups
-- Fix and finish the DRC code, or remove it entirely
 
 *****************************************************************************/
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "arm7.h"
 #include "arm7core.h"   //include arm7 core
 #include "arm7help.h"
 
 
-/* prototypes of coprocessor functions */
-void arm7_dt_r_callback(arm_state *arm, UINT32 insn, UINT32 *prn, UINT32 (*read32)(arm_state *arm, UINT32 addr));
-void arm7_dt_w_callback(arm_state *arm, UINT32 insn, UINT32 *prn, void (*write32)(arm_state *arm, UINT32 addr, UINT32 data));
-
-// holder for the co processor Data Transfer Read & Write Callback funcs
-void (*arm7_coproc_dt_r_callback)(arm_state *arm, UINT32 insn, UINT32 *prn, UINT32 (*read32)(arm_state *arm, UINT32 addr));
-void (*arm7_coproc_dt_w_callback)(arm_state *arm, UINT32 insn, UINT32 *prn, void (*write32)(arm_state *arm, UINT32 addr, UINT32 data));
-
-
 const device_type ARM7 = &device_creator<arm7_cpu_device>;
 const device_type ARM7_BE = &device_creator<arm7_be_cpu_device>;
 const device_type ARM7500 = &device_creator<arm7500_cpu_device>;
@@ -57,26 +48,30 @@ const device_type SA1110 = &device_creator<sa1110_cpu_device>;
 arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
 	: cpu_device(mconfig, ARM7, "ARM7", tag, owner, clock, "arm7", __FILE__)
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
+	, m_core(nullptr)
+	, m_r(nullptr)
 	, m_endian(ENDIANNESS_LITTLE)
 	, m_archRev(4)  // ARMv4
 	, m_archFlags(eARM_ARCHFLAGS_T)  // has Thumb
 	, m_copro_id(0x41 | (1 << 23) | (7 << 12))  // <-- where did this come from?
 	, m_pc(0)
 {
-	memset(m_r, 0x00, sizeof(m_r));
+	m_isdrc = allow_drc();
 }
 
 
 arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source, UINT8 archRev, UINT8 archFlags, endianness_t endianness)
 	: cpu_device(mconfig, type, name, tag, owner, clock, shortname, source)
 	, m_program_config("program", endianness, 32, 32, 0)
+	, m_core(nullptr)
+	, m_r(nullptr)
 	, m_endian(endianness)
 	, m_archRev(archRev)
 	, m_archFlags(archFlags)
 	, m_copro_id(0x41 | (1 << 23) | (7 << 12))  // <-- where did this come from?
 	, m_pc(0)
 {
-	memset(m_r, 0x00, sizeof(m_r));
+	m_isdrc = allow_drc();
 }
 
 
@@ -494,7 +489,14 @@ void arm7_cpu_device::device_start()
 	m_program = &space(AS_PROGRAM);
 	m_direct = &m_program->direct();
 
-	save_item(NAME(m_r));
+	/* the recompiler allocates the core state near its code cache */
+	if (m_isdrc)
+		arm7_drc_init();
+	else
+		m_core = auto_alloc_clear(machine(), <internal_arm7_state>());
+	m_r = m_core->r;
+
+	save_pointer(NAME(m_r), ARRAY_LENGTH(m_core->r));
 	save_item(NAME(m_pendingIrq));
 	save_item(NAME(m_pendingFiq));
 	save_item(NAME(m_pendingAbtD));
@@ -502,7 +504,7 @@ void arm7_cpu_device::device_start()
 	save_item(NAME(m_pendingUnd));
 	save_item(NAME(m_pendingSwi));
 
-	m_icountptr = &m_icount;
+	m_icountptr = &m_core->icount;
 
 	state_add( ARM7_PC,    "PC", m_pc).callexport().formatstr("%08X");
 	state_add(STATE_GENPC, "GENPC", m_pc).callexport().noshow();
@@ -553,6 +555,13 @@ void arm7_cpu_device::device_start()
 }
 
 
+void arm7_cpu_device::device_stop()
+{
+	if (m_isdrc)
+		arm7_drc_exit();
+}
+
+
 void arm7_cpu_device::state_export(const device_state_entry &entry)
 {
 	switch (entry.index())
@@ -585,7 +594,7 @@ void arm7_cpu_device::state_string_export(const device_state_entry &entry, std::
 
 void arm7_cpu_device::device_reset()
 {
-	memset(m_r, 0, sizeof(m_r));
+	memset(m_core->r, 0, sizeof(m_core->r));
 	m_pendingIrq = 0;
 	m_pendingFiq = 0;
 	m_pendingAbtD = 0;
@@ -609,14 +618,94 @@ void arm7_cpu_device::device_reset()
 }
 
 
+//-------------------------------------------------
+//  condition_passed - return true if an ARM
+//  condition code is satisfied by the CPSR
+//-------------------------------------------------
+
+inline bool arm7_cpu_device::condition_passed(UINT32 cond) const
+{
+	switch (cond)
+	{
+		case COND_EQ:
+			if (Z_IS_CLEAR(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_NE:
+			if (Z_IS_SET(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_CS:
+			if (C_IS_CLEAR(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_CC:
+			if (C_IS_SET(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_MI:
+			if (N_IS_CLEAR(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_PL:
+			if (N_IS_SET(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_VS:
+			if (V_IS_CLEAR(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_VC:
+			if (V_IS_SET(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_HI:
+			if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_LS:
+			if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
+				return false;
+			break;
+		case COND_GE:
+			if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
+				return false;
+			break;
+		case COND_LT:
+			if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
+				return false;
+			break;
+		case COND_GT:
+			if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
+				return false;
+			break;
+		case COND_LE:
+			if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
+				return false;
+			break;
+		case COND_NV:
+			return false;
+	}
+	return true;
+}
+
+
 #define UNEXECUTED() \
 	m_r[eR15] += 4; \
-	m_icount +=2; /* Any unexecuted instruction only takes 1 cycle (page 193) */
+	ARM7_ICOUNT +=2; /* Any unexecuted instruction only takes 1 cycle (page 193) */
 
 void arm7_cpu_device::execute_run()
 {
 	UINT32 insn;
 
+	/* run the recompiler for as long as it can; it hands back states it can't compile */
+	if (m_isdrc)
+	{
+		execute_run_drc();
+		if (ARM7_ICOUNT <= 0)
+			return;
+	}
+
 	do
 	{
 		UINT32 pc = GET_PC;
@@ -675,67 +764,9 @@ void arm7_cpu_device::execute_run()
 			insn = m_direct->read_dword(raddr);
 
 			/* process condition codes for this instruction */
-			switch (insn >> INSN_COND_SHIFT)
-			{
-				case COND_EQ:
-					if (Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NE:
-					if (Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CS:
-					if (C_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_CC:
-					if (C_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_MI:
-					if (N_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_PL:
-					if (N_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VS:
-					if (V_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_VC:
-					if (V_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_HI:
-					if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LS:
-					if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GE:
-					if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LT:
-					if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_GT:
-					if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_LE:
-					if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
-						{ UNEXECUTED();  goto skip_exec; }
-					break;
-				case COND_NV:
-					{ UNEXECUTED();  goto skip_exec; }
-			}
+			if (!condition_passed(insn >> INSN_COND_SHIFT))
+				{ UNEXECUTED();  goto skip_exec; }
+
 			/*******************************************************************/
 			/* If we got here - condition satisfied, so decode the instruction */
 			/*******************************************************************/
@@ -747,8 +778,8 @@ skip_exec:
 		arm7_check_irq_state();
 
 		/* All instructions remove 3 cycles.. Others taking less / more will have adjusted this # prior to here */
-		m_icount -= 3;
-	} while (m_icount > 0);
+		ARM7_ICOUNT -= 3;
+	} while (ARM7_ICOUNT > 0);
 }
 
 
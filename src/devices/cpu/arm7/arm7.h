@@ -46,8 +46,12 @@
  *  PUBLIC FUNCTIONS
  ***************************************************************************************************/
 
+class arm7_frontend;
+
 class arm7_cpu_device : public cpu_device
 {
+	friend class arm7_frontend;
+
 public:
 	// construction/destruction
 	arm7_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -57,6 +61,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 	// device_execute_interface overrides
 	virtual UINT32 execute_min_cycles() const override { return 3; }
@@ -80,14 +85,24 @@ protected:
 
 	address_space_config m_program_config;
 
-	UINT32 m_r[/*NUM_REGS*/37];
+	/* state the recompiled code addresses directly; it comes from the DRC cache's near memory when recompiling */
+	struct internal_arm7_state
+	{
+		UINT32              r[/*NUM_REGS*/37];          /* registers, banked by mode */
+		int                 icount;                     /* cycles left in the timeslice */
+		UINT32              mode;                       /* current global mode */
+		UINT32              arg0;                       /* opcode for cfunc_interpret */
+		UINT32              leave_block;                /* true if an interpreted instruction moved the PC or mode */
+	};
+
+	internal_arm7_state *m_core;
+	UINT32 *m_r;              /* m_core->r */
 	UINT32 m_pendingIrq;
 	UINT32 m_pendingFiq;
 	UINT32 m_pendingAbtD;
 	UINT32 m_pendingAbtP;
 	UINT32 m_pendingUnd;
 	UINT32 m_pendingSwi;
-	int m_icount;
 	endianness_t m_endian;
 	address_space *m_program;
 	direct_read_data *m_direct;
@@ -112,7 +127,10 @@ protected:
 	// For debugger
 	UINT32 m_pc;
 
+	bool m_isdrc;
+
 	INT64 saturate_qbit_overflow(INT64 res);
+	bool condition_passed(UINT32 cond) const;
 	void SwitchMode(UINT32 cpsr_mode_val);
 	UINT32 decodeShift(UINT32 insn, UINT32 *pCarry);
 	int loadInc(UINT32 pat, UINT32 rbv, UINT32 s, int mode);
@@ -290,6 +308,7 @@ protected:
 	struct compiler_state
 	{
 		UINT32              cycles;                     /* accumulated cycles */
+		UINT8               mode;                       /* hash mode the block is compiled for */
 		UINT8               checkints;                  /* need to check interrupts before next instruction */
 		UINT8               checksoftints;              /* need to check software interrupts before next instruction */
 		uml::code_label  labelnum;                   /* index for local labels */
@@ -301,29 +320,28 @@ protected:
 		/* core state */
 		drc_cache *         cache;                      /* pointer to the DRC code cache */
 		drcuml_state *      drcuml;                     /* DRC UML generator state */
-		//arm7_frontend *     drcfe;                      /* pointer to the DRC front-end state */
+		arm7_frontend *     drcfe;                      /* pointer to the DRC front-end state */
 		UINT32              drcoptions;                 /* configurable DRC options */
 
 		/* internal stuff */
 		UINT8               cache_dirty;                /* true if we need to flush the cache */
+		UINT8               validated;                  /* true once -drc_validate has run */
 		UINT32              jmpdest;                    /* destination jump target */
 
 		/* parameters for subroutines */
 		UINT64              numcycles;                  /* return value from gettotalcycles */
-		UINT32              mode;                       /* current global mode */
 		const char *        format;                     /* format string for print_debug */
-		UINT32              arg0;                       /* print_debug argument 1 */
 		UINT32              arg1;                       /* print_debug argument 2 */
 
-		/* register mappings */
-		uml::parameter   regmap[/*NUM_REGS*/37];               /* parameter to register mappings for all 16 integer registers */
+		/* CPSR flag lookups indexed by the UML C/V/Z/S flags */
+		UINT32              nzcv_add[16];               /* flags after an add (carry) */
+		UINT32              nzcv_sub[16];               /* flags after a subtract (not borrow) */
 
 		/* subroutines */
 		uml::code_handle *   entry;                      /* entry point */
 		uml::code_handle *   nocode;                     /* nocode exception handler */
 		uml::code_handle *   out_of_cycles;              /* out of cycles exception handler */
-		uml::code_handle *   tlb_translate;              /* tlb translation handler */
-		uml::code_handle *   detect_fault;               /* tlb fault detection handler */
+		uml::code_handle *   redispatch;                 /* redispatch after an interpreted instruction */
 		uml::code_handle *   check_irq;                  /* irq check handler */
 		uml::code_handle *   read8;                      /* read byte */
 		uml::code_handle *   write8;                     /* write byte */
@@ -341,146 +359,36 @@ protected:
 		hotspot_info        hotspot[ARM7_MAX_HOTSPOTS];
 	} m_impstate;
 
-	typedef void ( arm7_cpu_device::*arm7thumb_drcophandler)(drcuml_block*, compiler_state*, const opcode_desc*);
-	static const arm7thumb_drcophandler drcthumb_handler[0x40*0x10];
-
-	void drctg00_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Shift left */
-	void drctg00_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Shift right */
-	void drctg01_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg01_10(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg01_11(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, Rs, Rn */
-	void drctg01_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, Rs, #imm */
-	void drctg01_13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, Rs, #imm */
-	void drctg02_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg02_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg03_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, #Offset8 */
-	void drctg03_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* SUB Rd, #Offset8 */
-	void drctg04_00_00(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* AND Rd, Rs */
-	void drctg04_00_01(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* EOR Rd, Rs */
-	void drctg04_00_02(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* LSL Rd, Rs */
-	void drctg04_00_03(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* LSR Rd, Rs */
-	void drctg04_00_04(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ASR Rd, Rs */
-	void drctg04_00_05(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADC Rd, Rs */
-	void drctg04_00_06(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* SBC Rd, Rs */
-	void drctg04_00_07(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ROR Rd, Rs */
-	void drctg04_00_08(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* TST Rd, Rs */
-	void drctg04_00_09(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* NEG Rd, Rs */
-	void drctg04_00_0a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Rd, Rs */
-	void drctg04_00_0b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMN Rd, Rs - check flags, add dasm */
-	void drctg04_00_0c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ORR Rd, Rs */
-	void drctg04_00_0d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MUL Rd, Rs */
-	void drctg04_00_0e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* BIC Rd, Rs */
-	void drctg04_00_0f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MVN Rd, Rs */
-	void drctg04_01_00(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_01(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, HRs */
-	void drctg04_01_02(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD HRd, Rs */
-	void drctg04_01_03(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Add HRd, HRs */
-	void drctg04_01_10(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* CMP Rd, Rs */
-	void drctg04_01_11(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Rd, Hs */
-	void drctg04_01_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Hd, Rs */
-	void drctg04_01_13(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* CMP Hd, Hs */
-	void drctg04_01_20(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Rd, Rs (undefined) */
-	void drctg04_01_21(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Rd, Hs */
-	void drctg04_01_22(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Hd, Rs */
-	void drctg04_01_23(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* MOV Hd, Hs */
-	void drctg04_01_30(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_31(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_32(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_01_33(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg04_0203(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg05_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STR Rd, [Rn, Rm] */
-	void drctg05_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STRH Rd, [Rn, Rm] */
-	void drctg05_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* STRB Rd, [Rn, Rm] */
-	void drctg05_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDSB Rd, [Rn, Rm] todo, add dasm */
-	void drctg05_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDR Rd, [Rn, Rm] */
-	void drctg05_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDRH Rd, [Rn, Rm] */
-	void drctg05_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDRB Rd, [Rn, Rm] */
-	void drctg05_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* LDSH Rd, [Rn, Rm] */
-	void drctg06_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg06_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg07_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg07_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* Load */
-	void drctg08_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg08_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg09_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg09_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg0a_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);  /* ADD Rd, PC, #nn */
-	void drctg0a_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD Rd, SP, #nn */
-	void drctg0b_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* ADD SP, #imm */
-	void drctg0b_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* PUSH {Rlist} */
-	void drctg0b_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* PUSH {Rlist}{LR} */
-	void drctg0b_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_9(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* POP {Rlist} */
-	void drctg0b_d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* POP {Rlist}{PC} */
-	void drctg0b_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0b_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0c_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Store */
-	void drctg0c_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* Load */
-	void drctg0d_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_EQ:
-	void drctg0d_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_NE:
-	void drctg0d_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_CS:
-	void drctg0d_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_CC:
-	void drctg0d_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_MI:
-	void drctg0d_5(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_PL:
-	void drctg0d_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_VS:
-	void drctg0d_7(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_VC:
-	void drctg0d_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_HI:
-	void drctg0d_9(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LS:
-	void drctg0d_a(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_GE:
-	void drctg0d_b(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LT:
-	void drctg0d_c(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_GT:
-	void drctg0d_d(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_LE:
-	void drctg0d_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // COND_AL:
-	void drctg0d_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); // SWI (this is sort of a "hole" in the opcode encoding)
-	void drctg0e_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0e_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0f_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void drctg0f_1(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc); /* BL */
-
-	void load_fast_iregs(drcuml_block *block);
-	void save_fast_iregs(drcuml_block *block);
 	void arm7_drc_init();
 	void arm7_drc_exit();
 	void execute_run_drc();
+	UINT8 drc_mode() const;
+	bool drc_eligible() const;
 	void arm7drc_set_options(UINT32 options);
 	void arm7drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base);
 	void arm7drc_add_hotspot(offs_t pc, UINT32 opcode, UINT32 cycles);
 	void code_flush_cache();
 	void code_compile_block(UINT8 mode, offs_t pc);
-	void cfunc_get_cycles();
-	void cfunc_unimplemented();
 	void static_generate_entry_point();
-	void static_generate_check_irq();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
-	void static_generate_detect_fault(uml::code_handle **handleptr);
-	void static_generate_tlb_translate(uml::code_handle **handleptr);
-	void static_generate_memory_accessor(int size, bool istlb, bool iswrite, const char *name, uml::code_handle **handleptr);
-	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	void static_generate_redispatch();
+	uml::parameter drc_reg(const compiler_state *compiler, int reg);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, UINT32 cycles);
+	void generate_condition_skip(drcuml_block *block, UINT32 cond, uml::code_label skip);
 	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
-	void generate_delay_slot_and_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT8 linkreg);
-
-	typedef bool ( arm7_cpu_device::*drcarm7ops_ophandler)(drcuml_block*, compiler_state*, const opcode_desc*, UINT32);
-	static const drcarm7ops_ophandler drcops_handler[0x10];
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
+	bool generate_arm_alu(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
+	bool generate_thumb_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 op);
+	void generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	static bool validate_thumb_undefined(arm7thumb_ophandler handler);
+	void validate_setup(UINT8 mode, UINT32 &seed);
+	int validate_one(UINT32 op, UINT8 mode, UINT32 &seed, std::string *errors);
+	void validate_drc();
 
-	void saturate_qbit_overflow(drcuml_block *block);
-	bool drcarm7ops_0123(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_4567(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_89(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_ab(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_cd(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_e(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	bool drcarm7ops_f(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 op);
-	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+public:
+	void func_interpret();
 
 };
 
@@ -539,6 +447,33 @@ public:
 };
 
 
+class arm7_frontend : public drc_frontend
+{
+public:
+	arm7_frontend(arm7_cpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	void set_thumb(bool thumb) { m_thumb = thumb; }
+
+	// describe an opcode that isn't in memory, for -drc_validate
+	bool describe_test(opcode_desc &desc, offs_t pc, UINT32 opcode);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_arm(opcode_desc &desc, UINT32 op);
+	bool describe_thumb(opcode_desc &desc, UINT16 op);
+	void describe_pc_write(opcode_desc &desc, bool always);
+
+	UINT32 fetch(const opcode_desc &desc, bool thumb) const;
+
+	arm7_cpu_device *m_arm;
+	bool m_thumb;
+	bool m_testing;
+	UINT32 m_test_opcode;
+};
+
+
 extern const device_type ARM7;
 extern const device_type ARM7_BE;
 extern const device_type ARM7500;
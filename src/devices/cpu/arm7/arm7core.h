@@ -152,47 +152,6 @@ enum
 };
 
 
-//#define ARM7_USE_DRC
-
-/* forward declaration of implementation-specific state */
-#ifndef ARM7_USE_DRC
-struct arm7imp_state {};
-#else
-struct arm7imp_state;
-#endif
-
-/* CPU state struct */
-struct arm_state
-{
-	UINT32 m_r[NUM_REGS];
-	UINT32 m_pendingIrq;
-	UINT32 m_pendingFiq;
-	UINT32 m_pendingAbtD;
-	UINT32 m_pendingAbtP;
-	UINT32 m_pendingUnd;
-	UINT32 m_pendingSwi;
-	int m_icount;
-	endianness_t m_endian;
-	address_space *m_program;
-	direct_read_data *m_direct;
-
-	/* Coprocessor Registers */
-	UINT32 m_control;
-	UINT32 m_tlbBase;
-	UINT32 m_faultStatus[2];
-	UINT32 m_faultAddress;
-	UINT32 m_fcsePID;
-	UINT32 m_domainAccessControl;
-
-	UINT8 m_archRev;          // ARM architecture revision (3, 4, and 5 are valid)
-	UINT8 m_archFlags;        // architecture flags
-
-#if ARM7_MMU_ENABLE_HACK
-	UINT32 mmu_enable_addr; // workaround for "MMU is enabled when PA != VA" problem
-#endif
-	arm7imp_state m_impstate;
-};
-
 /****************************************************************************************************
  *  VARIOUS INTERNAL STRUCS/DEFINES/ETC..
  ***************************************************************************************************/
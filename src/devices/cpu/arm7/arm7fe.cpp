@@ -0,0 +1,298 @@
+// license:BSD-3-Clause
+// copyright-holders:Steve Ellenoff,R. Belmont,Ryan Holtz
+/***************************************************************************
+
+    arm7fe.cpp
+
+    Front end for the ARM7/ARM9 recompiler. The recompiler runs only
+    while the MMU is off and the core is in a 32-bit mode, so the
+    program counter is always a physical address here.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "arm7.h"
+#include "arm7core.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+arm7_frontend::arm7_frontend(arm7_cpu_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_arm(device)
+	, m_thumb(false)
+	, m_testing(false)
+	, m_test_opcode(0)
+{
+}
+
+
+/*-------------------------------------------------
+    fetch - read the instruction word at a
+    descriptor's address, or the opcode under
+    test
+-------------------------------------------------*/
+
+UINT32 arm7_frontend::fetch(const opcode_desc &desc, bool thumb) const
+{
+	if (m_testing)
+		return m_test_opcode;
+	if (thumb)
+		return m_arm->m_direct->read_word(desc.physpc & ~1);
+	return m_arm->m_direct->read_dword(desc.physpc & ~3);
+}
+
+
+/*-------------------------------------------------
+    describe_test - describe an opcode that isn't
+    in memory, the same way describe_code would
+-------------------------------------------------*/
+
+bool arm7_frontend::describe_test(opcode_desc &desc, offs_t pc, UINT32 opcode)
+{
+	desc.m_next = nullptr;
+	desc.branch = nullptr;
+	desc.delay.reset();
+	desc.pc = pc;
+	desc.physpc = pc;
+	desc.targetpc = BRANCH_TARGET_DYNAMIC;
+	memset(&desc.opptr, 0x00, sizeof(desc.opptr));
+	desc.length = 0;
+	desc.delayslots = 0;
+	desc.skipslots = 0;
+	desc.flags = 0;
+	desc.cycles = 0;
+	memset(desc.regin, 0x00, sizeof(desc.regin));
+	memset(desc.regout, 0x00, sizeof(desc.regout));
+	memset(desc.regreq, 0x00, sizeof(desc.regreq));
+
+	m_testing = true;
+	m_test_opcode = opcode;
+	bool result = describe(desc, nullptr);
+	m_testing = false;
+	return result;
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool arm7_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	/* keep the aligned word around for validating the block later */
+	desc.opptr.l[1] = fetch(desc, false);
+
+	if (m_thumb)
+	{
+		/* Thumb instructions are 2 bytes */
+		desc.length = 2;
+		desc.cycles = 1;
+		desc.opptr.w[0] = fetch(desc, true);
+		return describe_thumb(desc, desc.opptr.w[0]);
+	}
+
+	/* ARM instructions are 4 bytes */
+	desc.length = 4;
+	desc.cycles = 1;
+	desc.opptr.l[0] = desc.opptr.l[1];
+	return describe_arm(desc, desc.opptr.l[0]);
+}
+
+
+/*-------------------------------------------------
+    describe_pc_write - flag an instruction that
+    loads the PC with a value only known at run
+    time
+-------------------------------------------------*/
+
+void arm7_frontend::describe_pc_write(opcode_desc &desc, bool always)
+{
+	desc.targetpc = BRANCH_TARGET_DYNAMIC;
+	if (always)
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	else
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+}
+
+
+/*-------------------------------------------------
+    describe_arm - describe a 32-bit ARM
+    instruction
+-------------------------------------------------*/
+
+bool arm7_frontend::describe_arm(opcode_desc &desc, UINT32 op)
+{
+	UINT32 cond = op >> INSN_COND_SHIFT;
+	bool always = (cond == COND_AL);
+	UINT32 rd = (op & INSN_RD) >> INSN_RD_SHIFT;
+
+	/* the interpreter never executes the NV space; it just advances */
+	if (cond == COND_NV)
+		return true;
+
+	switch ((op >> 25) & 7)
+	{
+		case 0:
+		case 1:
+			/* BX */
+			if ((op & 0x0ffffff0) == 0x012fff10)
+			{
+				describe_pc_write(desc, always);
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			}
+
+			/* halfword transfers and swaps */
+			else if ((op & 0x0e000090) == 0x00000090 && (op & 0x60) != 0)
+			{
+				desc.flags |= (op & INSN_SDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY;
+				if ((op & INSN_SDT_L) && rd == 15)
+					describe_pc_write(desc, always);
+			}
+			/* the interpreter runs everything else with bit 24 set in this space as a swap */
+			else if ((op & 0x0e000090) == 0x00000090 && (op & 0x01000060) == 0x01000000)
+				desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+
+			/* MSR can change modes */
+			else if ((op & 0x0db00000) == 0x01200000)
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+
+			/* data processing into the PC; with S set it also restores the CPSR */
+			else if ((op & 0x0e000090) != 0x00000090 && rd == 15 && (((op & INSN_OPCODE) >> INSN_OPCODE_SHIFT) & 0xc) != 0x8)
+			{
+				describe_pc_write(desc, always);
+				if (op & INSN_S)
+					desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			}
+			return true;
+
+		case 2:
+		case 3:
+			/* single data transfer */
+			desc.flags |= (op & INSN_SDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY;
+			if ((op & INSN_SDT_L) && rd == 15)
+				describe_pc_write(desc, always);
+			return true;
+
+		case 4:
+			/* block data transfer */
+			desc.flags |= (op & INSN_BDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY;
+			if ((op & INSN_BDT_L) && (op & 0x8000))
+			{
+				describe_pc_write(desc, always);
+				if (op & INSN_BDT_S)
+					desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			}
+			return true;
+
+		case 5:
+		{
+			/* B/BL: the offset is relative to the instruction plus 8 */
+			UINT32 offs = (op & INSN_BRANCH) << 2;
+			if (offs & 0x2000000)
+				offs |= 0xfc000000;
+			desc.targetpc = desc.pc + 8 + offs;
+			if (always)
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			else
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+		}
+
+		case 6:
+			/* coprocessor data transfer */
+			desc.flags |= (op & INSN_SDT_L) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 7:
+			/* SWI enters supervisor mode */
+			if (op & 0x01000000)
+			{
+				describe_pc_write(desc, always);
+				desc.flags |= OPFLAG_CAN_TRIGGER_SW_INT | OPFLAG_CAN_CHANGE_MODES;
+			}
+
+			/* coprocessor register transfers can turn on the MMU */
+			else
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+			return true;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_thumb - describe a 16-bit Thumb
+    instruction
+-------------------------------------------------*/
+
+bool arm7_frontend::describe_thumb(opcode_desc &desc, UINT16 op)
+{
+	/* conditional branch and SWI */
+	if ((op & 0xf000) == 0xd000)
+	{
+		UINT32 cond = (op >> 8) & 0xf;
+		if (cond == 0xf)
+		{
+			describe_pc_write(desc, true);
+			desc.flags |= OPFLAG_CAN_TRIGGER_SW_INT | OPFLAG_CAN_CHANGE_MODES;
+		}
+		else if (cond != COND_AL)
+		{
+			desc.targetpc = desc.pc + 4 + ((INT8)(op & THUMB_INSN_IMM) << 1);
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+		}
+		return true;
+	}
+
+	/* unconditional branch */
+	if ((op & 0xf800) == 0xe000)
+	{
+		UINT32 offs = (op & THUMB_BRANCH_OFFS) << 1;
+		if (offs & 0x00000800)
+			offs |= 0xfffff800;
+		desc.targetpc = desc.pc + 4 + offs;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	/* second half of BL/BLX */
+	if ((op & 0xf800) == 0xe800 || (op & 0xf800) == 0xf800)
+	{
+		describe_pc_write(desc, true);
+		if ((op & 0xf800) == 0xe800)
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+		return true;
+	}
+
+	/* hi register operations and BX */
+	if ((op & 0xfc00) == 0x4400)
+	{
+		UINT32 hiop = (op >> 8) & 3;
+		if (hiop == 3)
+		{
+			describe_pc_write(desc, true);
+			desc.flags |= OPFLAG_CAN_CHANGE_MODES;
+		}
+		else if (hiop != 1 && ((op & 7) | ((op >> 4) & 8)) == 15)
+			describe_pc_write(desc, true);
+		return true;
+	}
+
+	/* POP with the PC */
+	if ((op & 0xff00) == 0xbd00)
+	{
+		desc.flags |= OPFLAG_READS_MEMORY;
+		describe_pc_write(desc, true);
+		return true;
+	}
+
+	/* memory accesses */
+	if ((op & 0xf800) == 0x4800 || (op & 0xf000) == 0x5000 || (op & 0xe000) == 0x6000 || (op & 0xe000) == 0x8000 || (op & 0xf000) == 0xc000 || (op & 0xf600) == 0xb400)
+		desc.flags |= ((op & 0x0800) || (op & 0xfe00) == 0x5600) ? OPFLAG_READS_MEMORY : OPFLAG_WRITES_MEMORY;
+
+	return true;
+}
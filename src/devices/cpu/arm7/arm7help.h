@@ -4,7 +4,7 @@
 
 /* Macros that need to be defined according to the cpu implementation specific need */
 #define ARM7REG(reg)        m_r[reg]
-#define ARM7_ICOUNT         m_icount
+#define ARM7_ICOUNT         m_core->icount
 
 
 #if 0
@@ -0,0 +1,3813 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbearm64.cpp
+
+    64-bit ARM (AArch64) back-end for the universal machine language.
+
+    UNVERIFIED: this back-end has never been run.  It has only been
+    compiled on x64 hosts, and has not been through -drc_validate on an
+    AArch64 host, so it is only built with ARM64_DRC=1 and arm64 builds
+    use the C back-end by default.
+
+****************************************************************************
+
+    Future improvements/changes:
+
+    * Track which mapped registers hold zero-extended 32-bit values to
+        avoid redundant extends on 64-bit accesses
+
+    * Fold immediate shifts into the shifted-register forms of the
+        arithmetic and logical operations
+
+    * Use CCMP to combine multi-part flag computations
+
+****************************************************************************
+
+    -------------------------
+    ABI/conventions (AAPCS64)
+    -------------------------
+
+    Registers:
+        X0-X7      - volatile, integer function parameters 1-8, X0 is the
+                     function return value
+        X8         - volatile, indirect result location
+        X9-X15     - volatile
+        X16-X17    - volatile, intra-procedure-call scratch (IP0/IP1)
+        X18        - platform register, must not be touched
+        X19-X28    - non-volatile
+        X29        - frame pointer
+        X30        - link register
+        SP         - stack pointer, must stay 16-byte aligned
+
+        D0-D7      - volatile, FP function parameters 1-8
+        D8-D15     - non-volatile (low 64 bits only)
+        D16-D31    - volatile
+
+
+    ---------------
+    Execution model
+    ---------------
+
+    Registers:
+        X0-X7      - scratch registers, also used for parameters
+        X16        - scratch register for address formation
+        X17        - scratch register for immediates that don't encode
+        X19-X26    - map to I0-I7; I8 and I9 live in memory
+        X27        - pointer to the near cache
+        X28        - UML flags, in host NZCV form (see below)
+        X30        - return address for handles
+
+        D0-D3      - scratch registers
+        D8-D15     - map to F0-F7; F8 and F9 live in memory
+
+    Flags:
+        The UML flags are kept in X28 in the format used by MRS/MSR NZCV,
+        with one twist: the carry is stored inverted, which is what the
+        host produces for subtraction and what the host conditions expect
+        for unsigned comparisons. Thus SUB, SUBB and CMP just copy NZCV
+        to X28, and ADD and ADDC flip the carry after doing so. Bit 27 is
+        set when the host V flag holds the UML U (unordered) flag rather
+        than V, which is only the case after FCMP.
+
+        The generator tracks whether the host NZCV still matches X28, so
+        a compare followed by a conditional branch doesn't need to reload
+        NZCV from X28.
+
+    Entry point:
+        Assumes 2 parameters passed: the pointer to the near cache, and
+        the codeptr of the code to execute once the environment is set up.
+
+    Exit point:
+        Assumes exit value is in W0.
+
+    Runtime stack:
+        [sp+0]     - saved x29
+        [sp+8]     - saved x30
+        [sp+16]    - saved x19-x28
+        [sp+96]    - saved d8-d15
+        [sp+160]   - caller's frame
+
+        Top-level code runs with SP equal to the value saved in the near
+        cache. A handle pushes its return address (in 16 bytes to keep
+        SP aligned) when it is entered, and pops it when it returns, so
+        [stacksave-16] holds the return address of the outermost call.
+
+***************************************************************************/
+
+#include <stddef.h>
+#include "emu.h"
+#include "debugger.h"
+#include "emuopts.h"
+#include "drcuml.h"
+#include "drcbearm64.h"
+
+using namespace uml;
+using namespace arm64emit;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const UINT32 PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
+const UINT32 PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
+const UINT32 PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
+const UINT32 PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+const UINT32 PTYPE_MR   = PTYPE_M | PTYPE_R;
+const UINT32 PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
+const UINT32 PTYPE_MF   = PTYPE_M | PTYPE_F;
+
+// fixed register assignments
+const UINT8 REG_BASE    = REG_X27;              // pointer to the near cache
+const UINT8 REG_FLAGS   = REG_X28;              // UML flags in host form
+const UINT8 REG_ADDR    = REG_X16;              // scratch for address formation
+const UINT8 REG_IMM     = REG_X17;              // scratch for immediates
+
+// size of the frame set up by the entry point
+const int FRAME_SIZE    = 160;
+
+// flags register bit marking V as the unordered flag
+const UINT32 FLAGS_U    = 0x08000000;
+
+// shift types for op_shift
+enum
+{
+	SHIFTOP_SHL,
+	SHIFTOP_SHR,
+	SHIFTOP_SAR,
+	SHIFTOP_ROL,
+	SHIFTOP_ROR
+};
+
+// logical opcodes, immediate and shifted register forms
+const UINT32 LOGICAL_AND_IMM    = 0x12000000;
+const UINT32 LOGICAL_AND_REG    = 0x0a000000;
+const UINT32 LOGICAL_ORR_IMM    = 0x32000000;
+const UINT32 LOGICAL_ORR_REG    = 0x2a000000;
+const UINT32 LOGICAL_EOR_IMM    = 0x52000000;
+const UINT32 LOGICAL_EOR_REG    = 0x4a000000;
+
+// FP 2-source opcodes
+const UINT32 FPOP_MUL   = 0x0;
+const UINT32 FPOP_DIV   = 0x1;
+const UINT32 FPOP_ADD   = 0x2;
+const UINT32 FPOP_SUB   = 0x3;
+
+// FP 1-source opcodes
+const UINT32 FPOP_ABS   = 0x01;
+const UINT32 FPOP_NEG   = 0x02;
+const UINT32 FPOP_SQRT  = 0x03;
+
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+#define ARM_CONDITION(condition)        (condition_map[condition - uml::COND_Z])
+#define ARM_NOT_CONDITION(condition)    (condition_map[condition - uml::COND_Z] ^ 1)
+
+#define assert_no_condition(inst)       assert((inst).condition() == uml::COND_ALWAYS)
+#define assert_any_condition(inst)      assert((inst).condition() == uml::COND_ALWAYS || ((inst).condition() >= uml::COND_Z && (inst).condition() < uml::COND_MAX))
+#define assert_no_flags(inst)           assert((inst).flags() == 0)
+#define assert_flags(inst, valid)       assert(((inst).flags() & ~(valid)) == 0)
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+drcbe_arm64::opcode_generate_func drcbe_arm64::s_opcode_table[OP_MAX];
+
+// register mapping tables
+static const UINT8 int_register_map[REG_I_COUNT] =
+{
+	REG_X19, REG_X20, REG_X21, REG_X22, REG_X23, REG_X24, REG_X25, REG_X26
+};
+
+static const UINT8 float_register_map[REG_F_COUNT] =
+{
+	REG_D8, REG_D9, REG_D10, REG_D11, REG_D12, REG_D13, REG_D14, REG_D15
+};
+
+// condition mapping table; note that the carry is stored inverted
+static const UINT8 condition_map[uml::COND_MAX - uml::COND_Z] =
+{
+	arm64emit::COND_EQ,     // COND_Z = 0x80,    requires Z
+	arm64emit::COND_NE,     // COND_NZ,          requires Z
+	arm64emit::COND_MI,     // COND_S,           requires S
+	arm64emit::COND_PL,     // COND_NS,          requires S
+	arm64emit::COND_CC,     // COND_C,           requires C
+	arm64emit::COND_CS,     // COND_NC,          requires C
+	arm64emit::COND_VS,     // COND_V,           requires V
+	arm64emit::COND_VC,     // COND_NV,          requires V
+	arm64emit::COND_VS,     // COND_U,           requires U
+	arm64emit::COND_VC,     // COND_NU,          requires U
+	arm64emit::COND_HI,     // COND_A,           requires CZ
+	arm64emit::COND_LS,     // COND_BE,          requires CZ
+	arm64emit::COND_GT,     // COND_G,           requires SVZ
+	arm64emit::COND_LE,     // COND_LE,          requires SVZ
+	arm64emit::COND_LT,     // COND_L,           requires SV
+	arm64emit::COND_GE,     // COND_GE,          requires SV
+};
+
+// load/store opcodes for each UML access size
+static const UINT32 load_op[4] = { LDST_LDRB, LDST_LDRH, LDST_LDR_W, LDST_LDR_X };
+static const UINT32 store_op[4] = { LDST_STRB, LDST_STRH, LDST_STR_W, LDST_STR_X };
+static const UINT32 load_signed_op[2][4] =
+{
+	{ LDST_LDRSB_W, LDST_LDRSH_W, LDST_LDR_W, LDST_LDR_X },
+	{ LDST_LDRSB_X, LDST_LDRSH_X, LDST_LDRSW, LDST_LDR_X }
+};
+
+
+
+//**************************************************************************
+//  TABLES
+//**************************************************************************
+
+const drcbe_arm64::opcode_table_entry drcbe_arm64::s_opcode_table_source[] =
+{
+	// Compile-time opcodes
+	{ uml::OP_HANDLE,  &drcbe_arm64::op_handle },   // HANDLE  handle
+	{ uml::OP_HASH,    &drcbe_arm64::op_hash },     // HASH    mode,pc
+	{ uml::OP_LABEL,   &drcbe_arm64::op_label },    // LABEL   imm
+	{ uml::OP_COMMENT, &drcbe_arm64::op_comment },  // COMMENT string
+	{ uml::OP_MAPVAR,  &drcbe_arm64::op_mapvar },   // MAPVAR  mapvar,value
+
+	// Control Flow Operations
+	{ uml::OP_NOP,     &drcbe_arm64::op_nop },      // NOP
+	{ uml::OP_DEBUG,   &drcbe_arm64::op_debug },    // DEBUG   pc
+	{ uml::OP_EXIT,    &drcbe_arm64::op_exit },     // EXIT    src1[,c]
+	{ uml::OP_HASHJMP, &drcbe_arm64::op_hashjmp },  // HASHJMP mode,pc,handle
+	{ uml::OP_JMP,     &drcbe_arm64::op_jmp },      // JMP     imm[,c]
+	{ uml::OP_EXH,     &drcbe_arm64::op_exh },      // EXH     handle,param[,c]
+	{ uml::OP_CALLH,   &drcbe_arm64::op_callh },    // CALLH   handle[,c]
+	{ uml::OP_RET,     &drcbe_arm64::op_ret },      // RET     [c]
+	{ uml::OP_CALLC,   &drcbe_arm64::op_callc },    // CALLC   func,ptr[,c]
+	{ uml::OP_RECOVER, &drcbe_arm64::op_recover },  // RECOVER dst,mapvar
+
+	// Internal Register Operations
+	{ uml::OP_SETFMOD, &drcbe_arm64::op_setfmod },  // SETFMOD src
+	{ uml::OP_GETFMOD, &drcbe_arm64::op_getfmod },  // GETFMOD dst
+	{ uml::OP_GETEXP,  &drcbe_arm64::op_getexp },   // GETEXP  dst
+	{ uml::OP_GETFLGS, &drcbe_arm64::op_getflgs },  // GETFLGS dst[,f]
+	{ uml::OP_SAVE,    &drcbe_arm64::op_save },     // SAVE    dst
+	{ uml::OP_RESTORE, &drcbe_arm64::op_restore },  // RESTORE dst
+
+	// Integer Operations
+	{ uml::OP_LOAD,    &drcbe_arm64::op_load },     // LOAD    dst,base,index,size
+	{ uml::OP_LOADS,   &drcbe_arm64::op_loads },    // LOADS   dst,base,index,size
+	{ uml::OP_STORE,   &drcbe_arm64::op_store },    // STORE   base,index,src,size
+	{ uml::OP_READ,    &drcbe_arm64::op_read },     // READ    dst,src1,spacesize
+	{ uml::OP_READM,   &drcbe_arm64::op_readm },    // READM   dst,src1,mask,spacesize
+	{ uml::OP_WRITE,   &drcbe_arm64::op_write },    // WRITE   dst,src1,spacesize
+	{ uml::OP_WRITEM,  &drcbe_arm64::op_writem },   // WRITEM  dst,src1,spacesize
+	{ uml::OP_CARRY,   &drcbe_arm64::op_carry },    // CARRY   src,bitnum
+	{ uml::OP_SET,     &drcbe_arm64::op_set },      // SET     dst,c
+	{ uml::OP_MOV,     &drcbe_arm64::op_mov },      // MOV     dst,src[,c]
+	{ uml::OP_SEXT,    &drcbe_arm64::op_sext },     // SEXT    dst,src
+	{ uml::OP_ROLAND,  &drcbe_arm64::op_roland },   // ROLAND  dst,src1,src2,src3
+	{ uml::OP_ROLINS,  &drcbe_arm64::op_rolins },   // ROLINS  dst,src1,src2,src3
+	{ uml::OP_ADD,     &drcbe_arm64::op_add },      // ADD     dst,src1,src2[,f]
+	{ uml::OP_ADDC,    &drcbe_arm64::op_addc },     // ADDC    dst,src1,src2[,f]
+	{ uml::OP_SUB,     &drcbe_arm64::op_sub },      // SUB     dst,src1,src2[,f]
+	{ uml::OP_SUBB,    &drcbe_arm64::op_subc },     // SUBB    dst,src1,src2[,f]
+	{ uml::OP_CMP,     &drcbe_arm64::op_cmp },      // CMP     src1,src2[,f]
+	{ uml::OP_MULU,    &drcbe_arm64::op_mulu },     // MULU    dst,edst,src1,src2[,f]
+	{ uml::OP_MULS,    &drcbe_arm64::op_muls },     // MULS    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVU,    &drcbe_arm64::op_divu },     // DIVU    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVS,    &drcbe_arm64::op_divs },     // DIVS    dst,edst,src1,src2[,f]
+	{ uml::OP_AND,     &drcbe_arm64::op_and },      // AND     dst,src1,src2[,f]
+	{ uml::OP_TEST,    &drcbe_arm64::op_test },     // TEST    src1,src2[,f]
+	{ uml::OP_OR,      &drcbe_arm64::op_or },       // OR      dst,src1,src2[,f]
+	{ uml::OP_XOR,     &drcbe_arm64::op_xor },      // XOR     dst,src1,src2[,f]
+	{ uml::OP_LZCNT,   &drcbe_arm64::op_lzcnt },    // LZCNT   dst,src[,f]
+	{ uml::OP_BSWAP,   &drcbe_arm64::op_bswap },    // BSWAP   dst,src
+	{ uml::OP_SHL,     &drcbe_arm64::op_shl },      // SHL     dst,src,count[,f]
+	{ uml::OP_SHR,     &drcbe_arm64::op_shr },      // SHR     dst,src,count[,f]
+	{ uml::OP_SAR,     &drcbe_arm64::op_sar },      // SAR     dst,src,count[,f]
+	{ uml::OP_ROL,     &drcbe_arm64::op_rol },      // ROL     dst,src,count[,f]
+	{ uml::OP_ROLC,    &drcbe_arm64::op_rolc },     // ROLC    dst,src,count[,f]
+	{ uml::OP_ROR,     &drcbe_arm64::op_ror },      // ROR     dst,src,count[,f]
+	{ uml::OP_RORC,    &drcbe_arm64::op_rorc },     // RORC    dst,src,count[,f]
+
+	// Floating Point Operations
+	{ uml::OP_FLOAD,   &drcbe_arm64::op_fload },    // FLOAD   dst,base,index
+	{ uml::OP_FSTORE,  &drcbe_arm64::op_fstore },   // FSTORE  base,index,src
+	{ uml::OP_FREAD,   &drcbe_arm64::op_fread },    // FREAD   dst,space,src1
+	{ uml::OP_FWRITE,  &drcbe_arm64::op_fwrite },   // FWRITE  space,dst,src1
+	{ uml::OP_FMOV,    &drcbe_arm64::op_fmov },     // FMOV    dst,src1[,c]
+	{ uml::OP_FTOINT,  &drcbe_arm64::op_ftoint },   // FTOINT  dst,src1,size,round
+	{ uml::OP_FFRINT,  &drcbe_arm64::op_ffrint },   // FFRINT  dst,src1,size
+	{ uml::OP_FFRFLT,  &drcbe_arm64::op_ffrflt },   // FFRFLT  dst,src1,size
+	{ uml::OP_FRNDS,   &drcbe_arm64::op_frnds },    // FRNDS   dst,src1
+	{ uml::OP_FADD,    &drcbe_arm64::op_fadd },     // FADD    dst,src1,src2
+	{ uml::OP_FSUB,    &drcbe_arm64::op_fsub },     // FSUB    dst,src1,src2
+	{ uml::OP_FCMP,    &drcbe_arm64::op_fcmp },     // FCMP    src1,src2
+	{ uml::OP_FMUL,    &drcbe_arm64::op_fmul },     // FMUL    dst,src1,src2
+	{ uml::OP_FDIV,    &drcbe_arm64::op_fdiv },     // FDIV    dst,src1,src2
+	{ uml::OP_FNEG,    &drcbe_arm64::op_fneg },     // FNEG    dst,src1
+	{ uml::OP_FABS,    &drcbe_arm64::op_fabs },     // FABS    dst,src1
+	{ uml::OP_FSQRT,   &drcbe_arm64::op_fsqrt },    // FSQRT   dst,src1
+	{ uml::OP_FRECIP,  &drcbe_arm64::op_frecip },   // FRECIP  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_arm64::op_frsqrt },   // FRSQRT  dst,src1
+	{ uml::OP_FCOPYI,  &drcbe_arm64::op_fcopyi },   // FCOPYI  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_arm64::op_icopyf }    // ICOPYF  dst,src
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  flush_icache - make newly written code visible
+//  to instruction fetch
+//-------------------------------------------------
+
+static inline void flush_icache(void *start, void *end)
+{
+#if defined(__GNUC__)
+	__builtin___clear_cache((char *)start, (char *)end);
+#endif
+}
+
+
+//-------------------------------------------------
+//  param_normalize - convert a full parameter
+//  into a reduced set
+//-------------------------------------------------
+
+drcbe_arm64::be_parameter::be_parameter(drcbe_arm64 &drcbe, const parameter &param, UINT32 allowed)
+{
+	int regnum;
+
+	switch (param.type())
+	{
+		// immediates pass through
+		case parameter::PTYPE_IMMEDIATE:
+			assert(allowed & PTYPE_I);
+			*this = param.immediate();
+			break;
+
+		// memory passes through
+		case parameter::PTYPE_MEMORY:
+			assert(allowed & PTYPE_M);
+			*this = make_memory(param.memory());
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_INT_REGISTER:
+			assert(allowed & PTYPE_R);
+			assert(allowed & PTYPE_M);
+			regnum = int_register_map[param.ireg() - REG_I0];
+			if (regnum != 0)
+				*this = make_ireg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.r[param.ireg() - REG_I0]);
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_FLOAT_REGISTER:
+			assert(allowed & PTYPE_F);
+			assert(allowed & PTYPE_M);
+			regnum = float_register_map[param.freg() - REG_F0];
+			if (regnum != 0)
+				*this = make_freg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
+			break;
+
+		// everything else is unexpected
+		default:
+			fatalerror("Unexpected parameter type\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  select_register - select a register to use,
+//  avoiding conflicts with the optional
+//  checkparam
+//-------------------------------------------------
+
+inline int drcbe_arm64::be_parameter::select_register(int defreg) const
+{
+	if (m_type == PTYPE_INT_REGISTER || m_type == PTYPE_FLOAT_REGISTER)
+		return m_value;
+	return defreg;
+}
+
+inline int drcbe_arm64::be_parameter::select_register(int defreg, const be_parameter &checkparam) const
+{
+	if (*this == checkparam)
+		return defreg;
+	return select_register(defreg);
+}
+
+
+//-------------------------------------------------
+//  normalize_commutative - move immediates and
+//  memory operands to the outer position
+//-------------------------------------------------
+
+inline void drcbe_arm64::normalize_commutative(be_parameter &inner, be_parameter &outer)
+{
+	// if the inner parameter is a memory operand, push it to the outer
+	if (inner.is_memory())
+	{
+		be_parameter temp = inner;
+		inner = outer;
+		outer = temp;
+	}
+
+	// if the inner parameter is an immediate, push it to the outer
+	if (inner.is_immediate())
+	{
+		be_parameter temp = inner;
+		inner = outer;
+		outer = temp;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_load_address - load the address of the
+//  target into a register, relative to the base
+//  register if possible
+//-------------------------------------------------
+
+void drcbe_arm64::emit_load_address(arm64code *&dst, UINT8 reg, const void *ptr)
+{
+	INT64 delta = (const UINT8 *)ptr - m_baseptr;
+
+	// near the base register
+	if (delta >= 0 && delta < 0x1000000)
+	{
+		if (delta >= 0x1000)
+			emit_add_imm(dst, 1, reg, REG_BASE, delta & ~0xfff);                         // add   reg,base,#delta & ~0xfff
+		if ((delta & 0xfff) != 0 || delta == 0)
+			emit_add_imm(dst, 1, reg, (delta >= 0x1000) ? reg : REG_BASE, delta & 0xfff); // add   reg,reg,#delta & 0xfff
+		return;
+	}
+
+	// within 4GB of the code
+	if (emit_adrp(dst, reg, ptr))                                                       // adrp  reg,ptr
+	{
+		if ((FPTR(ptr) & 0xfff) != 0)
+			emit_add_imm(dst, 1, reg, reg, FPTR(ptr) & 0xfff);                          // add   reg,reg,#ptr & 0xfff
+		return;
+	}
+
+	// anywhere
+	emit_mov_imm(dst, 1, reg, FPTR(ptr));                                               // mov   reg,ptr
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_ptr - load or store a register from
+//  or to an absolute address
+//-------------------------------------------------
+
+void drcbe_arm64::emit_ldst_ptr(arm64code *&dst, UINT32 op, UINT8 reg, const void *ptr)
+{
+	INT64 delta = (const UINT8 *)ptr - m_baseptr;
+	int shift = ldst_size_shift(op);
+	int alignmask = (1 << shift) - 1;
+
+	// scaled offset from the base register
+	if (delta >= 0 && (delta & alignmask) == 0 && (delta >> shift) < 0x1000)
+		emit_ldst_uimm(dst, op, reg, REG_BASE, delta);                                  // ldr   reg,[base,#delta]
+
+	// unscaled offset from the base register
+	else if (delta >= -256 && delta < 256)
+		emit_ldst_simm(dst, op, reg, REG_BASE, delta);                                  // ldur  reg,[base,#delta]
+
+	// larger offset from the base register
+	else if (delta >= 0 && delta < 0x1000000 && (delta & alignmask) == 0)
+	{
+		emit_add_imm(dst, 1, REG_ADDR, REG_BASE, delta & ~0xfff);                       // add   addr,base,#delta & ~0xfff
+		emit_ldst_uimm(dst, op, reg, REG_ADDR, delta & 0xfff);                          // ldr   reg,[addr,#delta & 0xfff]
+	}
+
+	// page-relative address
+	else if ((FPTR(ptr) & alignmask) == 0 && emit_adrp(dst, REG_ADDR, ptr))             // adrp  addr,ptr
+		emit_ldst_uimm(dst, op, reg, REG_ADDR, FPTR(ptr) & 0xfff);                      // ldr   reg,[addr,#ptr & 0xfff]
+
+	// anywhere
+	else
+	{
+		emit_load_address(dst, REG_ADDR, ptr);                                          // mov   addr,ptr
+		emit_ldst_uimm(dst, op, reg, REG_ADDR, 0);                                      // ldr   reg,[addr]
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_ldst_offset - load or store a register
+//  at an arbitrary offset from a base register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_ldst_offset(arm64code *&dst, UINT32 op, UINT8 reg, UINT8 basereg, UINT32 offset)
+{
+	int shift = ldst_size_shift(op);
+	if ((offset & ((1 << shift) - 1)) == 0 && (offset >> shift) < 0x1000)
+		emit_ldst_uimm(dst, op, reg, basereg, offset);                                  // ldr   reg,[basereg,#offset]
+	else
+	{
+		emit_mov_imm(dst, 1, REG_IMM, offset);                                          // mov   imm,offset
+		emit_ldst_reg(dst, op, reg, basereg, REG_IMM, EXTEND_UXTX, false);              // ldr   reg,[basereg,imm]
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_smart_call - generate a call either
+//  directly or via a register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_smart_call(arm64code *&dst, const void *target)
+{
+	if (branch_in_range(dst, target, 26))
+		emit_bl(dst, (const arm64code *)target);                                        // bl    target
+	else
+	{
+		emit_mov_imm(dst, 1, REG_ADDR, FPTR(target));                                   // mov   addr,target
+		emit_blr(dst, REG_ADDR);                                                        // blr   addr
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_smart_call_m64 - generate a call through
+//  a pointer, directly if the pointer is already
+//  set and in range
+//-------------------------------------------------
+
+void drcbe_arm64::emit_smart_call_m64(arm64code *&dst, void *const *target)
+{
+	if (*target != nullptr && branch_in_range(dst, *target, 26))
+		emit_bl(dst, (const arm64code *)*target);                                       // bl    *target
+	else
+	{
+		emit_ldst_ptr(dst, LDST_LDR_X, REG_ADDR, target);                               // ldr   addr,[target]
+		emit_blr(dst, REG_ADDR);                                                        // blr   addr
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_smart_jump - generate a jump either
+//  directly or via a register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_smart_jump(arm64code *&dst, const void *target)
+{
+	if (branch_in_range(dst, target, 26))
+		emit_b(dst, (const arm64code *)target);                                         // b     target
+	else
+	{
+		emit_mov_imm(dst, 1, REG_ADDR, FPTR(target));                                   // mov   addr,target
+		emit_br(dst, REG_ADDR);                                                         // br    addr
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_skip_unless - branch around the code for
+//  a conditional instruction if the condition
+//  fails
+//-------------------------------------------------
+
+void drcbe_arm64::emit_skip_unless(arm64code *&dst, const instruction &inst, branch_link &skip)
+{
+	if (inst.condition() != uml::COND_ALWAYS)
+	{
+		emit_restore_flags(dst);
+		emit_b_cond_link(dst, ARM_NOT_CONDITION(inst.condition()), skip);               // b.!cc skip
+	}
+}
+
+void drcbe_arm64::emit_resolve_skip(arm64code *&dst, const instruction &inst, const branch_link &skip)
+{
+	if (inst.condition() != uml::COND_ALWAYS)
+		resolve_link(dst, skip);                                                        // skip:
+}
+
+
+
+//**************************************************************************
+//  FLAGS HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_restore_flags - make sure the host NZCV
+//  matches the flags register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_restore_flags(arm64code *&dst)
+{
+	if (!m_nzcv_live)
+	{
+		emit_and_imm(dst, 1, REG_IMM, REG_FLAGS, 0xf0000000);                           // and   imm,flags,#0xf0000000
+		emit_msr_nzcv(dst, REG_IMM);                                                    // msr   nzcv,imm
+		m_nzcv_live = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_save_flags - capture the host NZCV into
+//  the flags register, inverting the carry for
+//  additions
+//-------------------------------------------------
+
+void drcbe_arm64::emit_save_flags(arm64code *&dst, bool invertcarry)
+{
+	emit_mrs_nzcv(dst, REG_FLAGS);                                                      // mrs   flags,nzcv
+	if (invertcarry)
+		emit_eor_imm(dst, 1, REG_FLAGS, REG_FLAGS, NZCV_C);                             // eor   flags,flags,#C
+	m_nzcv_live = m_nzcv_keep = !invertcarry;
+}
+
+
+//-------------------------------------------------
+//  emit_nz_flags - set the flags to reflect the
+//  sign and zero state of a result, with carry
+//  and overflow clear
+//-------------------------------------------------
+
+void drcbe_arm64::emit_nz_flags(arm64code *&dst, int sf, UINT8 reg)
+{
+	// comparing against zero never borrows, which leaves the host carry set (UML carry clear)
+	emit_cmp_imm(dst, sf, reg, 0);                                                      // cmp   reg,#0
+	emit_save_flags(dst, false);                                                        // mrs   flags,nzcv
+}
+
+
+//-------------------------------------------------
+//  emit_set_carry - set the UML carry flag from
+//  bit 0 of the given register, which is
+//  destroyed
+//-------------------------------------------------
+
+void drcbe_arm64::emit_set_carry(arm64code *&dst, UINT8 reg)
+{
+	emit_eor_imm(dst, 1, reg, reg, 1);                                                  // eor   reg,reg,#1
+	emit_bfi(dst, 1, REG_FLAGS, reg, 29, 1);                                            // bfi   flags,reg,#29,#1
+	m_nzcv_live = m_nzcv_keep = false;
+}
+
+
+//-------------------------------------------------
+//  emit_get_carry - fetch the UML carry flag as
+//  0 or 1 into the given register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_get_carry(arm64code *&dst, UINT8 reg)
+{
+	emit_ubfx(dst, 1, reg, REG_FLAGS, 29, 1);                                           // ubfx  reg,flags,#29,#1
+	emit_eor_imm(dst, 1, reg, reg, 1);                                                  // eor   reg,reg,#1
+}
+
+
+
+//**************************************************************************
+//  BACKEND CALLBACKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_arm64 - constructor
+//-------------------------------------------------
+
+drcbe_arm64::drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits)
+	: drcbe_interface(drcuml, cache, device),
+		m_hash(cache, modes, addrbits, ignorebits),
+		m_map(cache, 0),
+		m_labels(cache),
+		m_baseptr(cache.near()),
+		m_entry(nullptr),
+		m_exit(nullptr),
+		m_nocode(nullptr),
+		m_nzcv_live(false),
+		m_nzcv_keep(false),
+		m_fixup_label(FUNC(drcbe_arm64::fixup_label), this),
+		m_fixup_exception(FUNC(drcbe_arm64::fixup_exception), this),
+		m_near(*(near_state *)cache.alloc_near(sizeof(m_near)))
+{
+	// the FPCR rounding mode for each UML rounding mode
+	static const UINT32 fpcr_rmode[4] =
+	{
+		3,          // ROUND_TRUNC: round towards zero
+		0,          // ROUND_ROUND: round to nearest
+		1,          // ROUND_CEIL: round towards plus infinity
+		2           // ROUND_FLOOR: round towards minus infinity
+	};
+	for (int mode = 0; mode < 4; mode++)
+		m_near.fpcr[mode] = fpcr_rmode[mode] << FPCR_RMODE_SHIFT;
+
+	// get pointers to C functions we need to call
+	m_near.debug_cpu_instruction_hook = (void *)debugger_instruction_hook;
+	m_near.drcmap_get_value = (void *)&drc_map_variables::static_get_value;
+	m_near.stacksave = 0;
+	m_near.fpcrsave = 0;
+
+	// build the flags map; bits 0-3 of the index are NZCV, bit 4 says V is really U
+	for (int entry = 0; entry < ARRAY_LENGTH(m_near.flagsmap); entry++)
+	{
+		UINT8 flags = 0;
+		if (entry & 0x01) flags |= (entry & 0x10) ? FLAG_U : FLAG_V;
+		if (!(entry & 0x02)) flags |= FLAG_C;
+		if (entry & 0x04) flags |= FLAG_Z;
+		if (entry & 0x08) flags |= FLAG_S;
+		m_near.flagsmap[entry] = flags;
+	}
+	for (int entry = 0; entry < ARRAY_LENGTH(m_near.flagsunmap); entry++)
+	{
+		UINT32 flags = 0;
+		if (!(entry & FLAG_C)) flags |= NZCV_C;
+		if (entry & FLAG_V) flags |= NZCV_V;
+		else if (entry & FLAG_U) flags |= NZCV_V | FLAGS_U;
+		if (entry & FLAG_Z) flags |= NZCV_Z;
+		if (entry & FLAG_S) flags |= NZCV_N;
+		m_near.flagsunmap[entry] = flags;
+	}
+
+	// build the opcode table (static but it doesn't hurt to regenerate it)
+	for (auto & elem : s_opcode_table_source)
+		s_opcode_table[elem.opcode] = elem.func;
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_arm64 - destructor
+//-------------------------------------------------
+
+drcbe_arm64::~drcbe_arm64()
+{
+}
+
+
+//-------------------------------------------------
+//  reset - reset back-end specific state
+//-------------------------------------------------
+
+void drcbe_arm64::reset()
+{
+	// generate a little bit of glue code to set up the environment
+	drccodeptr *cachetop = m_cache.begin_codegen(500);
+	if (cachetop == nullptr)
+		fatalerror("Out of cache space after a reset!\n");
+
+	arm64code *dst = (arm64code *)(((FPTR)*cachetop + 3) & ~3);
+	arm64code *start = dst;
+
+	// generate an entry point
+	m_entry = (arm64_entry_point_func)dst;
+	emit_stp_x_preidx(dst, REG_FP, REG_LR, REG_SP, -FRAME_SIZE);                        // stp   x29,x30,[sp,#-FRAME_SIZE]!
+	emit_mov_sp(dst, REG_FP, REG_SP);                                                   // mov   x29,sp
+	emit_stp_x(dst, REG_X19, REG_X20, REG_SP, 16);                                      // stp   x19,x20,[sp,#16]
+	emit_stp_x(dst, REG_X21, REG_X22, REG_SP, 32);                                      // stp   x21,x22,[sp,#32]
+	emit_stp_x(dst, REG_X23, REG_X24, REG_SP, 48);                                      // stp   x23,x24,[sp,#48]
+	emit_stp_x(dst, REG_X25, REG_X26, REG_SP, 64);                                      // stp   x25,x26,[sp,#64]
+	emit_stp_x(dst, REG_X27, REG_X28, REG_SP, 80);                                      // stp   x27,x28,[sp,#80]
+	emit_stp_d(dst, REG_D8, REG_D9, REG_SP, 96);                                        // stp   d8,d9,[sp,#96]
+	emit_stp_d(dst, REG_D10, REG_D11, REG_SP, 112);                                     // stp   d10,d11,[sp,#112]
+	emit_stp_d(dst, REG_D12, REG_D13, REG_SP, 128);                                     // stp   d12,d13,[sp,#128]
+	emit_stp_d(dst, REG_D14, REG_D15, REG_SP, 144);                                     // stp   d14,d15,[sp,#144]
+	emit_mov_reg(dst, 1, REG_BASE, REG_X0);                                             // mov   base,x0
+	emit_mov_sp(dst, REG_ADDR, REG_SP);                                                 // mov   addr,sp
+	emit_ldst_ptr(dst, LDST_STR_X, REG_ADDR, &m_near.stacksave);                        // str   addr,[stacksave]
+	emit_mrs_fpcr(dst, REG_X2);                                                         // mrs   x2,fpcr
+	emit_ldst_ptr(dst, LDST_STR_X, REG_X2, &m_near.fpcrsave);                           // str   x2,[fpcrsave]
+	emit_ldst_ptr(dst, LDST_LDRB, REG_X3, &m_state.fmod);                               // ldrb  w3,[fmod]
+	emit_and_imm(dst, 0, REG_X3, REG_X3, 3);                                            // and   w3,w3,#3
+	emit_load_address(dst, REG_X4, &m_near.fpcr[0]);                                    // add   x4,base,#fpcr
+	emit_ldst_reg(dst, LDST_LDR_W, REG_X4, REG_X4, REG_X3, EXTEND_UXTX, true);          // ldr   w4,[x4,x3,lsl #2]
+	emit_and_imm(dst, 1, REG_X2, REG_X2, ~UINT64(FPCR_RMODE_MASK));                     // and   x2,x2,#~RMODE
+	emit_orr_reg(dst, 1, REG_X2, REG_X2, REG_X4);                                       // orr   x2,x2,x4
+	emit_msr_fpcr(dst, REG_X2);                                                         // msr   fpcr,x2
+	emit_mov_imm(dst, 1, REG_FLAGS, NZCV_C);                                            // mov   flags,#C
+	emit_br(dst, REG_X1);                                                               // br    x1
+
+	// generate an exit point
+	m_exit = dst;
+	emit_ldst_ptr(dst, LDST_LDR_X, REG_ADDR, &m_near.stacksave);                        // ldr   addr,[stacksave]
+	emit_mov_sp(dst, REG_SP, REG_ADDR);                                                 // mov   sp,addr
+	emit_ldst_ptr(dst, LDST_LDR_X, REG_X2, &m_near.fpcrsave);                           // ldr   x2,[fpcrsave]
+	emit_msr_fpcr(dst, REG_X2);                                                         // msr   fpcr,x2
+	emit_ldp_d(dst, REG_D14, REG_D15, REG_SP, 144);                                     // ldp   d14,d15,[sp,#144]
+	emit_ldp_d(dst, REG_D12, REG_D13, REG_SP, 128);                                     // ldp   d12,d13,[sp,#128]
+	emit_ldp_d(dst, REG_D10, REG_D11, REG_SP, 112);                                     // ldp   d10,d11,[sp,#112]
+	emit_ldp_d(dst, REG_D8, REG_D9, REG_SP, 96);                                        // ldp   d8,d9,[sp,#96]
+	emit_ldp_x(dst, REG_X27, REG_X28, REG_SP, 80);                                      // ldp   x27,x28,[sp,#80]
+	emit_ldp_x(dst, REG_X25, REG_X26, REG_SP, 64);                                      // ldp   x25,x26,[sp,#64]
+	emit_ldp_x(dst, REG_X23, REG_X24, REG_SP, 48);                                      // ldp   x23,x24,[sp,#48]
+	emit_ldp_x(dst, REG_X21, REG_X22, REG_SP, 32);                                      // ldp   x21,x22,[sp,#32]
+	emit_ldp_x(dst, REG_X19, REG_X20, REG_SP, 16);                                      // ldp   x19,x20,[sp,#16]
+	emit_ldp_x_postidx(dst, REG_FP, REG_LR, REG_SP, FRAME_SIZE);                        // ldp   x29,x30,[sp],#FRAME_SIZE
+	emit_ret(dst);                                                                      // ret
+
+	// generate a no code point
+	m_nocode = dst;
+	emit_ret(dst);                                                                      // ret
+
+	// finish up codegen
+	*cachetop = (drccodeptr)dst;
+	m_cache.end_codegen();
+	flush_icache(start, dst);
+
+	// reset our hash tables
+	m_hash.reset();
+	m_hash.set_default_codeptr((drccodeptr)m_nocode);
+}
+
+
+//-------------------------------------------------
+//  execute - execute a block of code referenced
+//  by the given handle
+//-------------------------------------------------
+
+int drcbe_arm64::execute(code_handle &entry)
+{
+	// call our entry point which will jump to the destination
+	return (*m_entry)(m_baseptr, (arm64code *)entry.codeptr());
+}
+
+
+//-------------------------------------------------
+//  generate - generate code
+//-------------------------------------------------
+
+void drcbe_arm64::generate(drcuml_block &block, const instruction *instlist, UINT32 numinst)
+{
+	// tell all of our utility objects that a block is beginning
+	m_hash.block_begin(block, instlist, numinst);
+	m_labels.block_begin(block);
+	m_map.block_begin(block);
+
+	// begin codegen; fail if we can't
+	drccodeptr *cachetop = m_cache.begin_codegen(numinst * 48 * 4);
+	if (cachetop == nullptr)
+		block.abort();
+
+	// compute the base by aligning the cache top to a cache line (assumed to be 64 bytes)
+	arm64code *base = (arm64code *)(((FPTR)*cachetop + 63) & ~63);
+	arm64code *dst = base;
+
+	// the host flags are unknown on entry to a block
+	m_nzcv_live = false;
+
+	// generate code
+	for (int inum = 0; inum < numinst; inum++)
+	{
+		const instruction &inst = instlist[inum];
+		assert(inst.opcode() < ARRAY_LENGTH(s_opcode_table));
+
+		// generate code, then note whether the host flags still match ours
+		m_nzcv_keep = false;
+		(this->*s_opcode_table[inst.opcode()])(dst, inst);
+		m_nzcv_live = m_nzcv_keep;
+	}
+
+	// complete codegen, including any out-of-band code, and make it visible to the instruction stream
+	*cachetop = (drccodeptr)dst;
+	m_cache.end_codegen();
+	flush_icache(base, m_cache.top());
+
+	// tell all of our utility objects that the block is finished
+	m_hash.block_end(block);
+	m_labels.block_end(block);
+	m_map.block_end(block);
+}
+
+
+//-------------------------------------------------
+//  hash_exists - return true if the given mode/pc
+//  exists in the hash table
+//-------------------------------------------------
+
+bool drcbe_arm64::hash_exists(UINT32 mode, UINT32 pc)
+{
+	return m_hash.code_exists(mode, pc);
+}
+
+
+//-------------------------------------------------
+//  get_info - return information about the
+//  back-end implementation
+//-------------------------------------------------
+
+void drcbe_arm64::get_info(drcbe_info &info)
+{
+	for (info.direct_iregs = 0; info.direct_iregs < REG_I_COUNT; info.direct_iregs++)
+		if (int_register_map[info.direct_iregs] == 0)
+			break;
+	for (info.direct_fregs = 0; info.direct_fregs < REG_F_COUNT; info.direct_fregs++)
+		if (float_register_map[info.direct_fregs] == 0)
+			break;
+}
+
+
+
+//-------------------------------------------------
+//  fixup_label - callback to fixup forward-
+//  referenced labels
+//-------------------------------------------------
+
+void drcbe_arm64::fixup_label(void *parameter, drccodeptr labelcodeptr)
+{
+	branch_link link;
+	link.source = (arm64code *)parameter;
+	resolve_link((arm64code *)labelcodeptr, link);
+}
+
+
+//-------------------------------------------------
+//  fixup_exception - callback to perform cleanup
+//  and jump to an exception handler
+//-------------------------------------------------
+
+void drcbe_arm64::fixup_exception(drccodeptr *codeptr, void *param1, void *param2)
+{
+	arm64code *src = (arm64code *)param1;
+	const instruction &inst = *(const instruction *)param2;
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+	be_parameter exp(*this, inst.param(1), PTYPE_MRI);
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// first fixup the branch to get us here
+	arm64code *dst = (arm64code *)*codeptr;
+	branch_link link;
+	link.source = src;
+	resolve_link(dst, link);
+
+	// store the exception parameter, and make the handle return to the instruction after the branch
+	emit_mov_r_p(dst, 0, REG_X0, exp);                                                  // mov   w0,exp
+	emit_ldst_ptr(dst, LDST_STR_W, REG_X0, &m_state.exp);                               // str   w0,[exp]
+	emit_adr(dst, REG_LR, src + 1);                                                     // adr   lr,src + 4
+
+	// jump to the target
+	if (*targetptr != nullptr)
+		emit_smart_jump(dst, *targetptr);                                               // b     *targetptr
+	else
+	{
+		emit_ldst_ptr(dst, LDST_LDR_X, REG_ADDR, targetptr);                            // ldr   addr,[targetptr]
+		emit_br(dst, REG_ADDR);                                                         // br    addr
+	}
+
+	*codeptr = (drccodeptr)dst;
+}
+
+
+
+//**************************************************************************
+//  EMITTERS FOR SPECIFIC PARAMETER TYPES
+//**************************************************************************
+
+//-------------------------------------------------
+//  emit_mov_r_p - move a 32 or 64-bit parameter
+//  into a register
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mov_r_p(arm64code *&dst, int sf, UINT8 reg, const be_parameter &param)
+{
+	if (param.is_immediate())
+		emit_mov_imm(dst, sf, reg, param.immediate());                                  // mov   reg,param
+	else if (param.is_memory())
+		emit_ldst_ptr(dst, sf ? LDST_LDR_X : LDST_LDR_W, reg, param.memory());          // ldr   reg,[param]
+	else if (param.is_int_register())
+	{
+		if (reg != param.ireg())
+			emit_mov_reg(dst, sf, reg, param.ireg());                                   // mov   reg,param
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_get_r_p - return a register holding a
+//  32 or 64-bit parameter, loading it into the
+//  temporary register only if it isn't already
+//  in one
+//-------------------------------------------------
+
+UINT8 drcbe_arm64::emit_get_r_p(arm64code *&dst, int sf, const be_parameter &param, UINT8 tempreg)
+{
+	if (param.is_int_register())
+		return param.ireg();
+	emit_mov_r_p(dst, sf, tempreg, param);
+	return tempreg;
+}
+
+
+//-------------------------------------------------
+//  emit_mov_p_r - move a register into a 32 or
+//  64-bit parameter
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mov_p_r(arm64code *&dst, int sf, const be_parameter &param, UINT8 reg)
+{
+	assert(!param.is_immediate());
+	if (param.is_memory())
+		emit_ldst_ptr(dst, sf ? LDST_STR_X : LDST_STR_W, reg, param.memory());          // str   reg,[param]
+	else if (param.is_int_register())
+	{
+		if (reg != param.ireg())
+			emit_mov_reg(dst, sf, param.ireg(), reg);                                   // mov   param,reg
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_logical_any - emit a logical operation
+//  with an immediate, falling back to a register
+//  if the immediate can't be encoded
+//-------------------------------------------------
+
+void drcbe_arm64::emit_logical_any(arm64code *&dst, UINT32 immop, UINT32 regop, int sf, UINT8 rd, UINT8 rn, UINT64 imm)
+{
+	UINT32 encoding;
+	if (encode_logical_immediate(sf, imm, encoding))
+		emit_op(dst, immop | (sf << 31) | encoding | (rn << 5) | rd);                   // op    rd,rn,#imm
+	else
+	{
+		emit_mov_imm(dst, sf, REG_IMM, imm);                                            // mov   imm,#imm
+		emit_op(dst, regop | (sf << 31) | (REG_IMM << 16) | (rn << 5) | rd);            // op    rd,rn,imm
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_get_f_p - return a register holding a
+//  floating point parameter
+//-------------------------------------------------
+
+UINT8 drcbe_arm64::emit_get_f_p(arm64code *&dst, int ftype, const be_parameter &param, UINT8 tempreg)
+{
+	assert(!param.is_immediate());
+	if (param.is_float_register())
+		return param.freg();
+	emit_ldst_ptr(dst, ftype ? LDST_LDR_D : LDST_LDR_S, tempreg, param.memory());       // ldr   temp,[param]
+	return tempreg;
+}
+
+
+//-------------------------------------------------
+//  emit_fmov_p_f - move a floating point register
+//  into a parameter
+//-------------------------------------------------
+
+void drcbe_arm64::emit_fmov_p_f(arm64code *&dst, int ftype, const be_parameter &param, UINT8 reg)
+{
+	assert(!param.is_immediate());
+	if (param.is_float_register())
+	{
+		if (reg != param.freg())
+			emit_fmov(dst, ftype, param.freg(), reg);                                   // fmov  param,reg
+	}
+	else
+		emit_ldst_ptr(dst, ftype ? LDST_STR_D : LDST_STR_S, reg, param.memory());       // str   reg,[param]
+}
+
+
+//-------------------------------------------------
+//  emit_index_address - load or store through a
+//  base pointer plus a scaled, signed 32-bit
+//  index
+//-------------------------------------------------
+
+void drcbe_arm64::emit_index_address(arm64code *&dst, UINT32 op, UINT8 reg, const be_parameter &basep, const be_parameter &indp, int scale)
+{
+	int size = ldst_size_shift(op);
+
+	// immediate indices fold into the address
+	if (indp.is_immediate())
+		emit_ldst_ptr(dst, op, reg, (UINT8 *)basep.memory() + (INT32(indp.immediate()) << scale));
+
+	// otherwise, use a register offset, scaling it separately if it doesn't match the access size
+	else
+	{
+		UINT8 indreg = emit_get_r_p(dst, 0, indp, REG_X1);
+		emit_load_address(dst, REG_ADDR, basep.memory());                              // mov   addr,base
+		if (scale == size || scale == 0)
+			emit_ldst_reg(dst, op, reg, REG_ADDR, indreg, EXTEND_SXTW, scale != 0);     // ldr   reg,[addr,ind,sxtw #scale]
+		else
+		{
+			emit_add_ext(dst, REG_ADDR, REG_ADDR, indreg, EXTEND_SXTW, scale);          // add   addr,addr,ind,sxtw #scale
+			emit_ldst_uimm(dst, op, reg, REG_ADDR, 0);                                  // ldr   reg,[addr]
+		}
+	}
+}
+
+
+
+//**************************************************************************
+//  COMPILE-TIME OPCODES
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_handle - process a HANDLE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_handle(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_handle());
+
+	// emit a jump around the stack adjust in case code falls through here
+	branch_link skip;
+	emit_b_link(dst, skip);                                                             // b     skip
+
+	// register the current pointer for the handle
+	inst.param(0).handle().set_codeptr(drccodeptr(dst));
+
+	// by default, the handle points to prolog code that saves the return address
+	emit_ldst_preidx(dst, LDST_STR_X, REG_LR, REG_SP, -16);                             // str   lr,[sp,#-16]!
+	resolve_link(dst, skip);                                                            // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hash - process a HASH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hash(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_immediate());
+	assert(inst.param(1).is_immediate());
+
+	// register the current pointer for the mode/PC
+	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), drccodeptr(dst));
+}
+
+
+//-------------------------------------------------
+//  op_label - process a LABEL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_label(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_label());
+
+	// register a label at the current location
+	m_labels.set_codeptr(inst.param(0).label(), drccodeptr(dst));
+}
+
+
+//-------------------------------------------------
+//  op_comment - process a COMMENT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_comment(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_string());
+
+	// do nothing
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_mapvar - process a MAPVAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mapvar(arm64code *&dst, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_mapvar());
+	assert(inst.param(1).is_immediate());
+
+	// set the value of the specified mapvar
+	m_map.set_value(drccodeptr(dst), inst.param(0).mapvar(), inst.param(1).immediate());
+	flags_kept();
+}
+
+
+
+//**************************************************************************
+//  CONTROL FLOW OPCODES
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_nop - process a NOP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_nop(arm64code *&dst, const instruction &inst)
+{
+	// nothing
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_debug - process a DEBUG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_debug(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// only generate code if we're debugging
+	if ((m_device.machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		// normalize parameters
+		be_parameter pcp(*this, inst.param(0), PTYPE_MRI);
+
+		// test and branch
+		branch_link skip;
+		emit_ldst_ptr(dst, LDST_LDR_W, REG_ADDR, &m_device.machine().debug_flags);      // ldr   addr,[debug_flags]
+		emit_tbz_link(dst, REG_ADDR, 1, skip);                                          // tbz   addr,#DEBUG_FLAG_CALL_HOOK,skip
+
+		// push the parameters
+		emit_mov_imm(dst, 1, REG_X0, (FPTR)&m_device);                                  // mov   x0,device
+		emit_mov_r_p(dst, 0, REG_X1, pcp);                                              // mov   w1,pcp
+		emit_smart_call_m64(dst, &m_near.debug_cpu_instruction_hook);                   // bl    debug_cpu_instruction_hook
+
+		resolve_link(dst, skip);                                                        // skip:
+	}
+	else
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_exit - process an EXIT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exit(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter retp(*this, inst.param(0), PTYPE_MRI);
+
+	// load the parameter into W0 and exit
+	branch_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cc skip
+	emit_mov_r_p(dst, 0, REG_X0, retp);                                                 // mov   w0,retp
+	emit_smart_jump(dst, m_exit);                                                       // b     exit
+	emit_resolve_skip(dst, inst, skip);                                                 // skip:
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_hashjmp - process a HASHJMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hashjmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter modep(*this, inst.param(0), PTYPE_MRI);
+	be_parameter pcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &exp = inst.param(2);
+	assert(exp.is_code_handle());
+
+	// reset the stack to the top level, so the return address of our call below is all that's on it
+	emit_ldst_ptr(dst, LDST_LDR_X, REG_ADDR, &m_near.stacksave);                        // ldr   addr,[stacksave]
+	emit_mov_sp(dst, REG_SP, REG_ADDR);                                                 // mov   sp,addr
+
+	// fixed mode cases
+	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
+	{
+		// a straight immediate jump is direct
+		if (pcp.is_immediate())
+		{
+			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			emit_ldst_ptr(dst, LDST_LDR_X, REG_ADDR, &m_hash.base()[modep.immediate()][l1val][l2val]); // ldr addr,[l1val][l2val]
+		}
+
+		// a fixed mode but variable PC
+		else
+		{
+			emit_mov_r_p(dst, 0, REG_X0, pcp);                                          // mov   w0,pcp
+			emit_lsr_imm(dst, 0, REG_X1, REG_X0, m_hash.l1shift());                     // lsr   w1,w0,#l1shift
+			emit_load_address(dst, REG_X2, &m_hash.base()[modep.immediate()][0]);       // mov   x2,[l1table]
+			emit_ldst_reg(dst, LDST_LDR_X, REG_X2, REG_X2, REG_X1, EXTEND_UXTW, true);   // ldr   x2,[x2,w1,uxtw #3]
+			emit_ubfx(dst, 0, REG_X0, REG_X0, m_hash.l2shift(), m_hash.l2bits());       // ubfx  w0,w0,#l2shift,#l2bits
+			emit_ldst_reg(dst, LDST_LDR_X, REG_ADDR, REG_X2, REG_X0, EXTEND_UXTW, true);// ldr   addr,[x2,w0,uxtw #3]
+		}
+	}
+	else
+	{
+		// variable mode
+		UINT8 modereg = emit_get_r_p(dst, 0, modep, REG_X1);
+		emit_load_address(dst, REG_X2, m_hash.base());                                  // mov   x2,base
+		emit_ldst_reg(dst, LDST_LDR_X, REG_X2, REG_X2, modereg, EXTEND_UXTW, true);     // ldr   x2,[x2,mode,uxtw #3]
+
+		// fixed PC
+		if (pcp.is_immediate())
+		{
+			UINT32 l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			UINT32 l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			emit_ldst_offset(dst, LDST_LDR_X, REG_X2, REG_X2, l1val * 8);               // ldr   x2,[x2,#l1val*8]
+			emit_ldst_offset(dst, LDST_LDR_X, REG_ADDR, REG_X2, l2val * 8);             // ldr   addr,[x2,#l2val*8]
+		}
+
+		// variable PC
+		else
+		{
+			emit_mov_r_p(dst, 0, REG_X0, pcp);                                          // mov   w0,pcp
+			emit_lsr_imm(dst, 0, REG_X1, REG_X0, m_hash.l1shift());                     // lsr   w1,w0,#l1shift
+			emit_ldst_reg(dst, LDST_LDR_X, REG_X2, REG_X2, REG_X1, EXTEND_UXTW, true);   // ldr   x2,[x2,w1,uxtw #3]
+			emit_ubfx(dst, 0, REG_X0, REG_X0, m_hash.l2shift(), m_hash.l2bits());       // ubfx  w0,w0,#l2shift,#l2bits
+			emit_ldst_reg(dst, LDST_LDR_X, REG_ADDR, REG_X2, REG_X0, EXTEND_UXTW, true);// ldr   addr,[x2,w0,uxtw #3]
+		}
+	}
+	emit_blr(dst, REG_ADDR);                                                            // blr   addr
+
+	// in all cases, if there is no code, we return here to generate the exception
+	emit_mov_r_p(dst, 0, REG_X0, pcp);                                                  // mov   w0,pcp
+	emit_ldst_ptr(dst, LDST_STR_W, REG_X0, &m_state.exp);                               // str   w0,[exp]
+	emit_smart_call_m64(dst, (void *const *)exp.handle().codeptr_addr());               // bl    [exp]
+}
+
+
+//-------------------------------------------------
+//  op_jmp - process a JMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_jmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &labelp = inst.param(0);
+	assert(labelp.is_code_label());
+
+	// conditional jumps need the flags in NZCV
+	if (inst.condition() != uml::COND_ALWAYS)
+		emit_restore_flags(dst);
+
+	// look up the jump target and jump there; unresolved targets are patched later
+	arm64code *jmptarget = (arm64code *)m_labels.get_codeptr(labelp.label(), m_fixup_label, dst);
+	branch_link link;
+	if (inst.condition() == uml::COND_ALWAYS)
+		emit_b_link(dst, link);                                                         // b     target
+	else
+		emit_b_cond_link(dst, ARM_CONDITION(inst.condition()), link);                   // b.cc  target
+	if (jmptarget != nullptr)
+		resolve_link(jmptarget, link);
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_exh - process an EXH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exh(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+	be_parameter exp(*this, inst.param(1), PTYPE_MRI);
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// perform the exception processing inline if unconditional
+	if (inst.condition() == uml::COND_ALWAYS)
+	{
+		emit_mov_r_p(dst, 0, REG_X0, exp);                                              // mov   w0,exp
+		emit_ldst_ptr(dst, LDST_STR_W, REG_X0, &m_state.exp);                           // str   w0,[exp]
+		emit_smart_call_m64(dst, (void *const *)targetptr);                             // bl    *targetptr
+	}
+
+	// otherwise, jump to an out-of-band handler
+	else
+	{
+		branch_link link;
+		emit_restore_flags(dst);
+		emit_b_cond_link(dst, ARM_CONDITION(inst.condition()), link);                   // b.cc  exception
+		m_cache.request_oob_codegen(m_fixup_exception, link.source, &const_cast<instruction &>(inst));
+	}
+}
+
+
+//-------------------------------------------------
+//  op_callh - process a CALLH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callh(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// skip if conditional
+	branch_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cc skip
+
+	// jump through the handle; directly if a normal jump
+	emit_smart_call_m64(dst, (void *const *)targetptr);                                 // bl    *targetptr
+
+	// resolve the conditional link
+	emit_resolve_skip(dst, inst, skip);                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ret - process a RET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ret(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 0);
+
+	// skip if conditional
+	branch_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cc skip
+
+	// return
+	emit_ldst_postidx(dst, LDST_LDR_X, REG_LR, REG_SP, 16);                             // ldr   lr,[sp],#16
+	emit_ret(dst);                                                                      // ret
+
+	// resolve the conditional link
+	emit_resolve_skip(dst, inst, skip);                                                 // skip:
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_callc - process a CALLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &funcp = inst.param(0);
+	assert(funcp.is_c_function());
+	be_parameter paramp(*this, inst.param(1), PTYPE_M);
+
+	// skip if conditional
+	branch_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cc skip
+
+	// perform the call
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)paramp.memory());                               // mov   x0,paramp
+	emit_smart_call(dst, (const void *)(FPTR)funcp.cfunc());                            // bl    funcp
+
+	// resolve the conditional link
+	emit_resolve_skip(dst, inst, skip);                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  op_recover - process a RECOVER opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_recover(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// call the recovery code with the return address of the outermost handle call
+	emit_ldst_ptr(dst, LDST_LDR_X, REG_X1, &m_near.stacksave);                          // ldr   x1,[stacksave]
+	emit_ldst_simm(dst, LDST_LDR_X, REG_X1, REG_X1, -16);                               // ldur  x1,[x1,#-16]
+	emit_sub_imm(dst, 1, REG_X1, REG_X1, 1);                                            // sub   x1,x1,#1
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)&m_map);                                         // mov   x0,m_map
+	emit_mov_imm(dst, 0, REG_X2, inst.param(1).mapvar());                               // mov   w2,param[1].value
+	emit_smart_call_m64(dst, &m_near.drcmap_get_value);                                 // bl    drcmap_get_value
+	emit_mov_p_r(dst, 0, dstp, REG_X0);                                                 // mov   dstp,w0
+}
+
+
+
+//**************************************************************************
+//  INTERNAL REGISTER OPCODES
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_setfmod - process a SETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_setfmod(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+
+	// immediate case
+	if (srcp.is_immediate())
+	{
+		int value = srcp.immediate() & 3;
+		emit_mov_imm(dst, 0, REG_X0, value);                                            // mov   w0,value
+		emit_ldst_ptr(dst, LDST_STRB, REG_X0, &m_state.fmod);                           // strb  w0,[fmod]
+		emit_ldst_ptr(dst, LDST_LDR_W, REG_X1, &m_near.fpcr[value]);                    // ldr   w1,[fpcr[value]]
+	}
+
+	// register/memory case
+	else
+	{
+		emit_mov_r_p(dst, 0, REG_X0, srcp);                                             // mov   w0,srcp
+		emit_and_imm(dst, 0, REG_X0, REG_X0, 3);                                        // and   w0,w0,#3
+		emit_ldst_ptr(dst, LDST_STRB, REG_X0, &m_state.fmod);                           // strb  w0,[fmod]
+		emit_load_address(dst, REG_X1, &m_near.fpcr[0]);                                // mov   x1,fpcr
+		emit_ldst_reg(dst, LDST_LDR_W, REG_X1, REG_X1, REG_X0, EXTEND_UXTX, true);      // ldr   w1,[x1,x0,lsl #2]
+	}
+
+	// merge the rounding mode into the FPCR
+	emit_mrs_fpcr(dst, REG_X2);                                                         // mrs   x2,fpcr
+	emit_and_imm(dst, 1, REG_X2, REG_X2, ~UINT64(FPCR_RMODE_MASK));                     // and   x2,x2,#~RMODE
+	emit_orr_reg(dst, 1, REG_X2, REG_X2, REG_X1);                                       // orr   x2,x2,x1
+	emit_msr_fpcr(dst, REG_X2);                                                         // msr   fpcr,x2
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_getfmod - process a GETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getfmod(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	int dstreg = dstp.select_register(REG_X0);
+
+	// fetch the current mode and store to the destination
+	emit_ldst_ptr(dst, LDST_LDRB, dstreg, &m_state.fmod);                               // ldrb  dstreg,[fmod]
+	emit_mov_p_r(dst, 0, dstp, dstreg);                                                 // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_getexp - process a GETEXP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getexp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	int dstreg = dstp.select_register(REG_X0);
+
+	// fetch the exception parameter and store to the destination
+	emit_ldst_ptr(dst, LDST_LDR_W, dstreg, &m_state.exp);                               // ldr   dstreg,[exp]
+	emit_mov_p_r(dst, 0, dstp, dstreg);                                                 // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_getflgs - process a GETFLGS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getflgs(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter maskp(*this, inst.param(1), PTYPE_I);
+	assert(maskp.is_immediate());
+	int dstreg = dstp.select_register(REG_X0);
+
+	// translate the flags register through the flags map, then mask
+	emit_ubfx(dst, 1, REG_X0, REG_FLAGS, 27, 5);                                        // ubfx  x0,flags,#27,#5
+	emit_load_address(dst, REG_X1, &m_near.flagsmap[0]);                                // mov   x1,flagsmap
+	emit_ldst_reg(dst, LDST_LDRB, dstreg, REG_X1, REG_X0, EXTEND_UXTX, false);          // ldrb  dstreg,[x1,x0]
+	emit_logical_any(dst, LOGICAL_AND_IMM, LOGICAL_AND_REG, 0, dstreg, dstreg, maskp.immediate());
+																						// and   dstreg,dstreg,maskp
+	emit_mov_p_r(dst, 0, dstp, dstreg);                                                 // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_save - process a SAVE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_save(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_M);
+	drcuml_machine_state *dststate = (drcuml_machine_state *)dstp.memory();
+
+	// point x2 at the destination state
+	emit_load_address(dst, REG_X2, dststate);                                           // mov   x2,dstp
+
+	// copy flags
+	emit_ubfx(dst, 1, REG_X0, REG_FLAGS, 27, 5);                                        // ubfx  x0,flags,#27,#5
+	emit_load_address(dst, REG_X1, &m_near.flagsmap[0]);                                // mov   x1,flagsmap
+	emit_ldst_reg(dst, LDST_LDRB, REG_X0, REG_X1, REG_X0, EXTEND_UXTX, false);          // ldrb  w0,[x1,x0]
+	emit_ldst_offset(dst, LDST_STRB, REG_X0, REG_X2, offsetof(drcuml_machine_state, flags));
+																						// strb  w0,[x2,flags]
+
+	// copy fmod and exp
+	emit_ldst_ptr(dst, LDST_LDRB, REG_X0, &m_state.fmod);                               // ldrb  w0,[fmod]
+	emit_ldst_offset(dst, LDST_STRB, REG_X0, REG_X2, offsetof(drcuml_machine_state, fmod));
+																						// strb  w0,[x2,fmod]
+	emit_ldst_ptr(dst, LDST_LDR_W, REG_X0, &m_state.exp);                               // ldr   w0,[exp]
+	emit_ldst_offset(dst, LDST_STR_W, REG_X0, REG_X2, offsetof(drcuml_machine_state, exp));
+																						// str   w0,[x2,exp]
+
+	// copy integer registers
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.r); regnum++)
+	{
+		UINT32 offset = offsetof(drcuml_machine_state, r) + regnum * sizeof(m_state.r[0]);
+		if (int_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_STR_X, int_register_map[regnum], REG_X2, offset);// str   reg,[x2,r[regnum]]
+		else
+		{
+			emit_ldst_ptr(dst, LDST_LDR_X, REG_X0, &m_state.r[regnum].d);               // ldr   x0,[r[regnum]]
+			emit_ldst_offset(dst, LDST_STR_X, REG_X0, REG_X2, offset);                  // str   x0,[x2,r[regnum]]
+		}
+	}
+
+	// copy FP registers
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.f); regnum++)
+	{
+		UINT32 offset = offsetof(drcuml_machine_state, f) + regnum * sizeof(m_state.f[0]);
+		if (float_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_STR_D, float_register_map[regnum], REG_X2, offset);// str   reg,[x2,f[regnum]]
+		else
+		{
+			emit_ldst_ptr(dst, LDST_LDR_X, REG_X0, &m_state.f[regnum].d);               // ldr   x0,[f[regnum]]
+			emit_ldst_offset(dst, LDST_STR_X, REG_X0, REG_X2, offset);                  // str   x0,[x2,f[regnum]]
+		}
+	}
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_restore - process a RESTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_restore(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_M);
+	drcuml_machine_state *srcstate = (drcuml_machine_state *)srcp.memory();
+
+	// point x2 at the source state
+	emit_load_address(dst, REG_X2, srcstate);                                           // mov   x2,srcp
+
+	// copy integer registers
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.r); regnum++)
+	{
+		UINT32 offset = offsetof(drcuml_machine_state, r) + regnum * sizeof(m_state.r[0]);
+		if (int_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_LDR_X, int_register_map[regnum], REG_X2, offset);// ldr   reg,[x2,r[regnum]]
+		else
+		{
+			emit_ldst_offset(dst, LDST_LDR_X, REG_X0, REG_X2, offset);                  // ldr   x0,[x2,r[regnum]]
+			emit_ldst_ptr(dst, LDST_STR_X, REG_X0, &m_state.r[regnum].d);               // str   x0,[r[regnum]]
+		}
+	}
+
+	// copy FP registers
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_state.f); regnum++)
+	{
+		UINT32 offset = offsetof(drcuml_machine_state, f) + regnum * sizeof(m_state.f[0]);
+		if (float_register_map[regnum] != 0)
+			emit_ldst_offset(dst, LDST_LDR_D, float_register_map[regnum], REG_X2, offset);// ldr   reg,[x2,f[regnum]]
+		else
+		{
+			emit_ldst_offset(dst, LDST_LDR_X, REG_X0, REG_X2, offset);                  // ldr   x0,[x2,f[regnum]]
+			emit_ldst_ptr(dst, LDST_STR_X, REG_X0, &m_state.f[regnum].d);               // str   x0,[f[regnum]]
+		}
+	}
+
+	// copy exp
+	emit_ldst_offset(dst, LDST_LDR_W, REG_X0, REG_X2, offsetof(drcuml_machine_state, exp));
+																						// ldr   w0,[x2,exp]
+	emit_ldst_ptr(dst, LDST_STR_W, REG_X0, &m_state.exp);                               // str   w0,[exp]
+
+	// copy fmod and update the FPCR to match
+	emit_ldst_offset(dst, LDST_LDRB, REG_X0, REG_X2, offsetof(drcuml_machine_state, fmod));
+																						// ldrb  w0,[x2,fmod]
+	emit_and_imm(dst, 0, REG_X0, REG_X0, 3);                                            // and   w0,w0,#3
+	emit_ldst_ptr(dst, LDST_STRB, REG_X0, &m_state.fmod);                               // strb  w0,[fmod]
+	emit_load_address(dst, REG_X1, &m_near.fpcr[0]);                                    // mov   x1,fpcr
+	emit_ldst_reg(dst, LDST_LDR_W, REG_X1, REG_X1, REG_X0, EXTEND_UXTX, true);          // ldr   w1,[x1,x0,lsl #2]
+	emit_mrs_fpcr(dst, REG_X3);                                                         // mrs   x3,fpcr
+	emit_and_imm(dst, 1, REG_X3, REG_X3, ~UINT64(FPCR_RMODE_MASK));                     // and   x3,x3,#~RMODE
+	emit_orr_reg(dst, 1, REG_X3, REG_X3, REG_X1);                                       // orr   x3,x3,x1
+	emit_msr_fpcr(dst, REG_X3);                                                         // msr   fpcr,x3
+
+	// copy flags, translating them through the flags unmapper
+	emit_ldst_offset(dst, LDST_LDRB, REG_X0, REG_X2, offsetof(drcuml_machine_state, flags));
+																						// ldrb  w0,[x2,flags]
+	emit_and_imm(dst, 0, REG_X0, REG_X0, 0x1f);                                         // and   w0,w0,#0x1f
+	emit_load_address(dst, REG_X1, &m_near.flagsunmap[0]);                              // mov   x1,flagsunmap
+	emit_ldst_reg(dst, LDST_LDR_W, REG_FLAGS, REG_X1, REG_X0, EXTEND_UXTX, true);       // ldr   flags,[x1,x0,lsl #2]
+	m_nzcv_live = false;
+}
+
+
+
+//**************************************************************************
+//  INTEGER OPERATIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_load - process a LOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_load(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// load, zero-extending, and store the result
+	emit_index_address(dst, load_op[size], dstreg, basep, indp, scale);                 // ldr   dstreg,[basep + indp << scale]
+	emit_mov_p_r(dst, inst.size() == 8, dstp, dstreg);                                  // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_loads - process a LOADS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_loads(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// load, sign-extending to the instruction size, and store the result
+	emit_index_address(dst, load_signed_op[inst.size() == 8][size], dstreg, basep, indp, scale);
+																						// ldrs  dstreg,[basep + indp << scale]
+	emit_mov_p_r(dst, inst.size() == 8, dstp, dstreg);                                  // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_store - process a STORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_store(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int scale = scalesizep.scale();
+	int size = scalesizep.size();
+
+	// zero can be stored straight from the zero register
+	UINT8 srcreg = srcp.is_immediate_value(0) ? REG_ZR : emit_get_r_p(dst, inst.size() == 8, srcp, REG_X0);
+	emit_index_address(dst, store_op[size], srcreg, basep, indp, scale);                // str   srcreg,[basep + indp << scale]
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_read - process a READ opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_read(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+	data_accessors &accessors = m_accessors[spacesizep.space()];
+
+	// set up a call to the read handler
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacesizep.space()]));                  // mov   x0,space
+	if (spacesizep.size() == SIZE_BYTE)
+	{
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_byte);                  // bl    read_byte
+		emit_uxtb(dst, REG_X0, REG_X0);                                                 // uxtb  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_WORD)
+	{
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_word);                  // bl    read_word
+		emit_uxth(dst, REG_X0, REG_X0);                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_dword);                 // bl    read_dword
+		if (inst.size() == 8)
+			emit_mov_reg(dst, 0, REG_X0, REG_X0);                                       // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_qword);                 // bl    read_qword
+
+	// store result
+	emit_mov_p_r(dst, inst.size() == 8, dstp, REG_X0);                                  // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_readm - process a READM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_readm(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+	data_accessors &accessors = m_accessors[spacesizep.space()];
+
+	// set up a call to the masked read handler
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_X2, maskp);                  // mov   x2,maskp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacesizep.space()]));                  // mov   x0,space
+	if (spacesizep.size() == SIZE_WORD)
+	{
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_word_masked);           // bl    read_word_masked
+		emit_uxth(dst, REG_X0, REG_X0);                                                 // uxth  w0,w0
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_dword_masked);          // bl    read_dword_masked
+		if (inst.size() == 8)
+			emit_mov_reg(dst, 0, REG_X0, REG_X0);                                       // mov   w0,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_qword_masked);          // bl    read_qword_masked
+
+	// store result
+	emit_mov_p_r(dst, inst.size() == 8, dstp, REG_X0);                                  // mov   dstp,x0
+}
+
+
+//-------------------------------------------------
+//  op_write - process a WRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_write(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+	data_accessors &accessors = m_accessors[spacesizep.space()];
+
+	// set up a call to the write handler
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_X2, srcp);                   // mov   x2,srcp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacesizep.space()]));                  // mov   x0,space
+	if (spacesizep.size() == SIZE_BYTE)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_byte);                 // bl    write_byte
+	else if (spacesizep.size() == SIZE_WORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_word);                 // bl    write_word
+	else if (spacesizep.size() == SIZE_DWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_dword);                // bl    write_dword
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_qword);                // bl    write_qword
+}
+
+
+//-------------------------------------------------
+//  op_writem - process a WRITEM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_writem(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+	data_accessors &accessors = m_accessors[spacesizep.space()];
+
+	// set up a call to the masked write handler
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_X2, srcp);                   // mov   x2,srcp
+	emit_mov_r_p(dst, spacesizep.size() == SIZE_QWORD, REG_X3, maskp);                  // mov   x3,maskp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacesizep.space()]));                  // mov   x0,space
+	if (spacesizep.size() == SIZE_WORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_word_masked);          // bl    write_word_masked
+	else if (spacesizep.size() == SIZE_DWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_dword_masked);         // bl    write_dword_masked
+	else if (spacesizep.size() == SIZE_QWORD)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_qword_masked);         // bl    write_qword_masked
+}
+
+
+//-------------------------------------------------
+//  op_carry - process a CARRY opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_carry(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter bitp(*this, inst.param(1), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+
+	// degenerate case: source is immediate
+	if (srcp.is_immediate() && bitp.is_immediate())
+		emit_mov_imm(dst, 0, REG_X1, (srcp.immediate() >> (bitp.immediate() & (inst.size() * 8 - 1))) & 1);
+																						// mov   w1,carry
+
+	// extract the bit into x1
+	else
+	{
+		UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+		if (bitp.is_immediate())
+			emit_ubfx(dst, sf, REG_X1, srcreg, bitp.immediate() & (inst.size() * 8 - 1), 1);
+																						// ubfx  x1,srcreg,#bitp,#1
+		else
+		{
+			UINT8 bitreg = emit_get_r_p(dst, 0, bitp, REG_X1);
+			emit_lsrv(dst, sf, REG_X1, srcreg, bitreg);                                 // lsr   x1,srcreg,bitreg
+		}
+	}
+
+	// set the carry from bit 0
+	emit_set_carry(dst, REG_X1);
+}
+
+
+//-------------------------------------------------
+//  op_set - process a SET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_set(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// set to 1 unconditionally, or to the condition
+	if (inst.condition() == uml::COND_ALWAYS)
+		emit_mov_imm(dst, sf, dstreg, 1);                                               // mov   dstreg,#1
+	else
+	{
+		emit_restore_flags(dst);
+		emit_cset(dst, sf, dstreg, ARM_CONDITION(inst.condition()));                    // cset  dstreg,cc
+	}
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_mov - process a MOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mov(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+
+	// conditional moves to a register use a select
+	if (inst.condition() != uml::COND_ALWAYS && dstp.is_int_register())
+	{
+		emit_restore_flags(dst);
+		UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+		emit_csel(dst, sf, dstp.ireg(), srcreg, dstp.ireg(), ARM_CONDITION(inst.condition()));
+																						// csel  dstp,srcreg,dstp,cc
+	}
+
+	// everything else branches around if conditional
+	else
+	{
+		branch_link skip;
+		emit_skip_unless(dst, inst, skip);                                              // b.!cc skip
+
+		// register destinations load directly
+		if (dstp.is_int_register())
+			emit_mov_r_p(dst, sf, dstp.ireg(), srcp);                                   // mov   dstp,srcp
+
+		// memory destinations go through a register, unless storing zero
+		else
+		{
+			UINT8 srcreg = srcp.is_immediate_value(0) ? REG_ZR : emit_get_r_p(dst, sf, srcp, REG_X0);
+			emit_mov_p_r(dst, sf, dstp, srcreg);                                        // str   srcreg,[dstp]
+		}
+
+		emit_resolve_skip(dst, inst, skip);                                             // skip:
+	}
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_sext - process a SEXT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sext(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// memory sources can use a sign-extending load
+	if (srcp.is_memory())
+		emit_ldst_ptr(dst, load_signed_op[sf][sizep.size()], dstreg, srcp.memory());    // ldrs  dstreg,[srcp]
+
+	// everything else is extended in registers
+	else
+	{
+		UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+		if (sizep.size() == SIZE_BYTE)
+			emit_sxtb(dst, sf, dstreg, srcreg);                                         // sxtb  dstreg,srcreg
+		else if (sizep.size() == SIZE_WORD)
+			emit_sxth(dst, sf, dstreg, srcreg);                                         // sxth  dstreg,srcreg
+		else if (sizep.size() == SIZE_DWORD && sf)
+			emit_sxtw(dst, dstreg, srcreg);                                             // sxtw  dstreg,srcreg
+		else if (dstreg != srcreg)
+			emit_mov_reg(dst, sf, dstreg, srcreg);                                      // mov   dstreg,srcreg
+	}
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, dstreg);                                                 // cmp   dstreg,#0
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_roland - process an ROLAND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_roland(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// rotate into x0; a left rotate is a right rotate by the negated count
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+	if (shiftp.is_immediate())
+		emit_ror_imm(dst, sf, REG_X0, srcreg, (bits - shiftp.immediate()) & (bits - 1));// ror   x0,srcreg,#-shiftp
+	else
+	{
+		UINT8 shiftreg = emit_get_r_p(dst, 0, shiftp, REG_X1);
+		emit_neg(dst, 0, REG_X1, shiftreg);                                             // neg   w1,shiftreg
+		emit_rorv(dst, sf, REG_X0, srcreg, REG_X1);                                     // ror   x0,srcreg,x1
+	}
+
+	// mask the result
+	if (maskp.is_immediate())
+		emit_logical_any(dst, LOGICAL_AND_IMM, LOGICAL_AND_REG, sf, REG_X0, REG_X0, maskp.immediate());
+																						// and   x0,x0,maskp
+	else
+	{
+		UINT8 maskreg = emit_get_r_p(dst, sf, maskp, REG_X2);
+		emit_and_reg(dst, sf, REG_X0, REG_X0, maskreg);                                 // and   x0,x0,maskreg
+	}
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, REG_X0);                                                 // cmp   x0,#0
+	emit_mov_p_r(dst, sf, dstp, REG_X0);                                                // mov   dstp,x0
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_rolins - process an ROLINS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolins(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	int bits = inst.size() * 8;
+	UINT64 sizemask = sf ? ~U64(0) : 0xffffffff;
+
+	// rotate into x0
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+	if (shiftp.is_immediate())
+		emit_ror_imm(dst, sf, REG_X0, srcreg, (bits - shiftp.immediate()) & (bits - 1));// ror   x0,srcreg,#-shiftp
+	else
+	{
+		UINT8 shiftreg = emit_get_r_p(dst, 0, shiftp, REG_X1);
+		emit_neg(dst, 0, REG_X1, shiftreg);                                             // neg   w1,shiftreg
+		emit_rorv(dst, sf, REG_X0, srcreg, REG_X1);                                     // ror   x0,srcreg,x1
+	}
+
+	// fetch the destination into x1
+	emit_mov_r_p(dst, sf, REG_X1, dstp);                                                // mov   x1,dstp
+
+	// merge under the mask
+	if (maskp.is_immediate())
+	{
+		emit_logical_any(dst, LOGICAL_AND_IMM, LOGICAL_AND_REG, sf, REG_X0, REG_X0, maskp.immediate() & sizemask);
+																						// and   x0,x0,maskp
+		emit_logical_any(dst, LOGICAL_AND_IMM, LOGICAL_AND_REG, sf, REG_X1, REG_X1, ~maskp.immediate() & sizemask);
+																						// and   x1,x1,~maskp
+	}
+	else
+	{
+		UINT8 maskreg = emit_get_r_p(dst, sf, maskp, REG_X2);
+		emit_and_reg(dst, sf, REG_X0, REG_X0, maskreg);                                 // and   x0,x0,maskreg
+		emit_bic_reg(dst, sf, REG_X1, REG_X1, maskreg);                                 // bic   x1,x1,maskreg
+	}
+	emit_orr_reg(dst, sf, REG_X1, REG_X1, REG_X0);                                      // orr   x1,x1,x0
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, REG_X1);                                                 // cmp   x1,#0
+	emit_mov_p_r(dst, sf, dstp, REG_X1);                                                // mov   dstp,x1
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_add - process a ADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_add(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	int sf = (inst.size() == 8);
+	UINT64 sizemask = sf ? ~U64(0) : 0xffffffff;
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+
+	// immediates that encode directly
+	if (src2p.is_immediate() && is_valid_addsub_immediate(src2p.immediate() & sizemask))
+	{
+		if (inst.flags() != 0)
+			emit_adds_imm(dst, sf, dstreg, src1reg, src2p.immediate() & sizemask);      // adds  dstreg,src1reg,#src2p
+		else
+			emit_add_imm(dst, sf, dstreg, src1reg, src2p.immediate() & sizemask);       // add   dstreg,src1reg,#src2p
+	}
+
+	// negative immediates can subtract if we don't care about the carry
+	else if (src2p.is_immediate() && inst.flags() == 0 && is_valid_addsub_immediate(-src2p.immediate() & sizemask))
+		emit_sub_imm(dst, sf, dstreg, src1reg, -src2p.immediate() & sizemask);          // sub   dstreg,src1reg,#-src2p
+
+	// general case
+	else
+	{
+		UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+		if (inst.flags() != 0)
+			emit_adds_reg(dst, sf, dstreg, src1reg, src2reg);                           // adds  dstreg,src1reg,src2reg
+		else
+			emit_add_reg(dst, sf, dstreg, src1reg, src2reg);                            // add   dstreg,src1reg,src2reg
+	}
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_save_flags(dst, true);                                                     // mrs   flags,nzcv
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_addc - process a ADDC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_addc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+
+	// load the host carry with the (uninverted) UML carry
+	emit_eor_imm(dst, 1, REG_IMM, REG_FLAGS, NZCV_C);                                   // eor   imm,flags,#C
+	emit_msr_nzcv(dst, REG_IMM);                                                        // msr   nzcv,imm
+	m_nzcv_live = false;
+
+	// add with carry
+	if (inst.flags() != 0)
+	{
+		emit_adcs(dst, sf, dstreg, src1reg, src2reg);                                   // adcs  dstreg,src1reg,src2reg
+		emit_save_flags(dst, true);                                                     // mrs   flags,nzcv
+	}
+	else
+		emit_adc(dst, sf, dstreg, src1reg, src2reg);                                    // adc   dstreg,src1reg,src2reg
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_sub - process a SUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sub(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	UINT64 sizemask = sf ? ~U64(0) : 0xffffffff;
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+
+	// immediates that encode directly
+	if (src2p.is_immediate() && is_valid_addsub_immediate(src2p.immediate() & sizemask))
+	{
+		if (inst.flags() != 0)
+			emit_subs_imm(dst, sf, dstreg, src1reg, src2p.immediate() & sizemask);      // subs  dstreg,src1reg,#src2p
+		else
+			emit_sub_imm(dst, sf, dstreg, src1reg, src2p.immediate() & sizemask);       // sub   dstreg,src1reg,#src2p
+	}
+
+	// negative immediates can add if we don't care about the carry
+	else if (src2p.is_immediate() && inst.flags() == 0 && is_valid_addsub_immediate(-src2p.immediate() & sizemask))
+		emit_add_imm(dst, sf, dstreg, src1reg, -src2p.immediate() & sizemask);          // add   dstreg,src1reg,#-src2p
+
+	// general case
+	else
+	{
+		UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+		if (inst.flags() != 0)
+			emit_subs_reg(dst, sf, dstreg, src1reg, src2reg);                           // subs  dstreg,src1reg,src2reg
+		else
+			emit_sub_reg(dst, sf, dstreg, src1reg, src2reg);                            // sub   dstreg,src1reg,src2reg
+	}
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_save_flags(dst, false);                                                    // mrs   flags,nzcv
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_subc - process a SUBC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_subc(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+
+	// the host carry is already the inverted borrow that SBC wants
+	emit_restore_flags(dst);
+	if (inst.flags() != 0)
+	{
+		emit_sbcs(dst, sf, dstreg, src1reg, src2reg);                                   // sbcs  dstreg,src1reg,src2reg
+		emit_save_flags(dst, false);                                                    // mrs   flags,nzcv
+	}
+	else
+		emit_sbc(dst, sf, dstreg, src1reg, src2reg);                                    // sbc   dstreg,src1reg,src2reg
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_cmp - process a CMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_cmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	UINT64 sizemask = sf ? ~U64(0) : 0xffffffff;
+
+	// compare, then capture the flags
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	if (src2p.is_immediate() && is_valid_addsub_immediate(src2p.immediate() & sizemask))
+		emit_cmp_imm(dst, sf, src1reg, src2p.immediate() & sizemask);                   // cmp   src1reg,#src2p
+	else
+	{
+		UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+		emit_cmp_reg(dst, sf, src1reg, src2reg);                                        // cmp   src1reg,src2reg
+	}
+	emit_save_flags(dst, false);                                                        // mrs   flags,nzcv
+}
+
+
+//-------------------------------------------------
+//  emit_mul_flags - compute the flags for a
+//  multiply; for 32-bit multiplies, the 64-bit
+//  product is in loreg and hireg is ignored;
+//  zero and sign come from the full product when
+//  both halves are kept, the low half otherwise
+//-------------------------------------------------
+
+void drcbe_arm64::emit_mul_flags(arm64code *&dst, int sf, bool is_signed, bool full, UINT8 loreg, UINT8 hireg)
+{
+	if (!sf)
+	{
+		// overflow if the product doesn't fit in 32 bits
+		if (is_signed)
+			emit_sxtw(dst, REG_X2, loreg);                                              // sxtw  x2,lo
+		else
+			emit_mov_reg(dst, 0, REG_X2, loreg);                                        // mov   w2,lo
+		emit_cmp_reg(dst, 1, loreg, REG_X2);                                            // cmp   lo,x2
+		emit_cset(dst, 0, REG_X3, arm64emit::COND_NE);                                  // cset  w3,ne
+
+		// sign and zero
+		emit_cmp_imm(dst, full ? 1 : 0, loreg, 0);                                      // cmp   lo,#0
+		emit_mrs_nzcv(dst, REG_FLAGS);                                                  // mrs   flags,nzcv
+	}
+	else
+	{
+		// overflow if the high half isn't just an extension of the low half
+		if (is_signed)
+			emit_cmp_reg(dst, 1, hireg, loreg, SHIFT_ASR, 63);                          // cmp   hi,lo,asr #63
+		else
+			emit_cmp_imm(dst, 1, hireg, 0);                                             // cmp   hi,#0
+		emit_cset(dst, 0, REG_X3, arm64emit::COND_NE);                                  // cset  w3,ne
+
+		if (full)
+		{
+			// zero if both halves are zero
+			emit_orr_reg(dst, 1, REG_X2, loreg, hireg);                                 // orr   x2,lo,hi
+			emit_cmp_imm(dst, 1, REG_X2, 0);                                            // cmp   x2,#0
+			emit_cset(dst, 0, REG_X2, arm64emit::COND_EQ);                              // cset  w2,eq
+
+			// sign comes from the high half
+			emit_cmp_imm(dst, 1, hireg, 0);                                             // cmp   hi,#0
+			emit_mrs_nzcv(dst, REG_FLAGS);                                              // mrs   flags,nzcv
+			emit_bfi(dst, 1, REG_FLAGS, REG_X2, 30, 1);                                 // bfi   flags,x2,#30,#1
+		}
+		else
+		{
+			emit_cmp_imm(dst, 1, loreg, 0);                                             // cmp   lo,#0
+			emit_mrs_nzcv(dst, REG_FLAGS);                                              // mrs   flags,nzcv
+		}
+	}
+	emit_bfi(dst, 1, REG_FLAGS, REG_X3, 28, 1);                                         // bfi   flags,x3,#28,#1
+	m_nzcv_live = m_nzcv_keep = false;
+}
+
+
+//-------------------------------------------------
+//  op_mulu - process a MULU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mulu(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	bool compute_hi = (dstp != edstp);
+	int sf = (inst.size() == 8);
+
+	// multiply into x0 (low) and x1 (high)
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+	if (!sf)
+	{
+		emit_umull(dst, REG_X0, src1reg, src2reg);                                      // umull x0,src1reg,src2reg
+		if (compute_hi)
+			emit_lsr_imm(dst, 1, REG_X1, REG_X0, 32);                                   // lsr   x1,x0,#32
+	}
+	else
+	{
+		emit_mul(dst, 1, REG_X0, src1reg, src2reg);                                     // mul   x0,src1reg,src2reg
+		if (compute_hi || inst.flags() != 0)
+			emit_umulh(dst, REG_X1, src1reg, src2reg);                                  // umulh x1,src1reg,src2reg
+	}
+
+	// compute flags and store the results, high half first
+	if (inst.flags() != 0)
+		emit_mul_flags(dst, sf, false, compute_hi, REG_X0, REG_X1);
+	if (compute_hi)
+		emit_mov_p_r(dst, sf, edstp, REG_X1);                                           // mov   edstp,x1
+	emit_mov_p_r(dst, sf, dstp, REG_X0);                                                // mov   dstp,x0
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_muls - process a MULS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_muls(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	bool compute_hi = (dstp != edstp);
+	int sf = (inst.size() == 8);
+
+	// multiply into x0 (low) and x1 (high)
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+	if (!sf)
+	{
+		emit_smull(dst, REG_X0, src1reg, src2reg);                                      // smull x0,src1reg,src2reg
+		if (compute_hi)
+			emit_asr_imm(dst, 1, REG_X1, REG_X0, 32);                                   // asr   x1,x0,#32
+	}
+	else
+	{
+		emit_mul(dst, 1, REG_X0, src1reg, src2reg);                                     // mul   x0,src1reg,src2reg
+		if (compute_hi || inst.flags() != 0)
+			emit_smulh(dst, REG_X1, src1reg, src2reg);                                  // smulh x1,src1reg,src2reg
+	}
+
+	// compute flags and store the results, high half first
+	if (inst.flags() != 0)
+		emit_mul_flags(dst, sf, true, compute_hi, REG_X0, REG_X1);
+	if (compute_hi)
+		emit_mov_p_r(dst, sf, edstp, REG_X1);                                           // mov   edstp,x1
+	emit_mov_p_r(dst, sf, dstp, REG_X0);                                                // mov   dstp,x0
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_divu - process a DIVU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divu(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool compute_rem = (dstp != edstp);
+	int sf = (inst.size() == 8);
+
+	// skip everything if dividing by zero
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+	branch_link skip;
+	emit_cbz_link(dst, sf, src2reg, skip);                                              // cbz   src2reg,skip
+
+	// divide, computing the remainder if needed, and store the results
+	emit_udiv(dst, sf, REG_X0, src1reg, src2reg);                                       // udiv  x0,src1reg,src2reg
+	if (compute_rem)
+	{
+		emit_msub(dst, sf, REG_X3, REG_X0, src2reg, src1reg);                           // msub  x3,x0,src2reg,src1reg
+		emit_mov_p_r(dst, sf, edstp, REG_X3);                                           // mov   edstp,x3
+	}
+	emit_mov_p_r(dst, sf, dstp, REG_X0);                                                // mov   dstp,x0
+
+	// flags are NZ of the quotient, or just V when dividing by zero
+	if (inst.flags() != 0)
+	{
+		branch_link done;
+		emit_nz_flags(dst, sf, REG_X0);                                                 // cmp   x0,#0
+		emit_b_link(dst, done);                                                         // b     done
+		resolve_link(dst, skip);                                                        // skip:
+		emit_mov_imm(dst, 1, REG_FLAGS, NZCV_C | NZCV_V);                               // mov   flags,#CV
+		resolve_link(dst, done);                                                        // done:
+		m_nzcv_live = m_nzcv_keep = false;
+	}
+	else
+	{
+		resolve_link(dst, skip);                                                        // skip:
+		flags_kept();
+	}
+}
+
+
+//-------------------------------------------------
+//  op_divs - process a DIVS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divs(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool compute_rem = (dstp != edstp);
+	int sf = (inst.size() == 8);
+
+	// skip everything if dividing by zero
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+	branch_link skip;
+	emit_cbz_link(dst, sf, src2reg, skip);                                              // cbz   src2reg,skip
+
+	// divide, computing the remainder if needed, and store the results
+	emit_sdiv(dst, sf, REG_X0, src1reg, src2reg);                                       // sdiv  x0,src1reg,src2reg
+	if (compute_rem)
+	{
+		emit_msub(dst, sf, REG_X3, REG_X0, src2reg, src1reg);                           // msub  x3,x0,src2reg,src1reg
+		emit_mov_p_r(dst, sf, edstp, REG_X3);                                           // mov   edstp,x3
+	}
+	emit_mov_p_r(dst, sf, dstp, REG_X0);                                                // mov   dstp,x0
+
+	// flags are NZ of the quotient, or just V when dividing by zero
+	if (inst.flags() != 0)
+	{
+		branch_link done;
+		emit_nz_flags(dst, sf, REG_X0);                                                 // cmp   x0,#0
+		emit_b_link(dst, done);                                                         // b     done
+		resolve_link(dst, skip);                                                        // skip:
+		emit_mov_imm(dst, 1, REG_FLAGS, NZCV_C | NZCV_V);                               // mov   flags,#CV
+		resolve_link(dst, done);                                                        // done:
+		m_nzcv_live = m_nzcv_keep = false;
+	}
+	else
+	{
+		resolve_link(dst, skip);                                                        // skip:
+		flags_kept();
+	}
+}
+
+
+//-------------------------------------------------
+//  op_logical - shared code for AND, OR and XOR
+//-------------------------------------------------
+
+void drcbe_arm64::op_logical(arm64code *&dst, const instruction &inst, UINT32 immop, UINT32 regop)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+
+	// immediate or register form
+	if (src2p.is_immediate())
+		emit_logical_any(dst, immop, regop, sf, dstreg, src1reg, src2p.immediate());    // op    dstreg,src1reg,#src2p
+	else
+	{
+		UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+		emit_op(dst, regop | (sf << 31) | (src2reg << 16) | (src1reg << 5) | dstreg);   // op    dstreg,src1reg,src2reg
+	}
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, dstreg);                                                 // cmp   dstreg,#0
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_and - process a AND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_and(arm64code *&dst, const instruction &inst)
+{
+	op_logical(dst, inst, LOGICAL_AND_IMM, LOGICAL_AND_REG);
+}
+
+
+//-------------------------------------------------
+//  op_test - process a TEST opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_test(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+	normalize_commutative(src1p, src2p);
+	int sf = (inst.size() == 8);
+
+	// and into a temporary, then set flags from it
+	UINT8 src1reg = emit_get_r_p(dst, sf, src1p, REG_X1);
+	if (src2p.is_immediate())
+		emit_logical_any(dst, LOGICAL_AND_IMM, LOGICAL_AND_REG, sf, REG_X0, src1reg, src2p.immediate());
+																						// and   x0,src1reg,#src2p
+	else
+	{
+		UINT8 src2reg = emit_get_r_p(dst, sf, src2p, REG_X2);
+		emit_and_reg(dst, sf, REG_X0, src1reg, src2reg);                                // and   x0,src1reg,src2reg
+	}
+	emit_nz_flags(dst, sf, REG_X0);                                                     // cmp   x0,#0
+}
+
+
+//-------------------------------------------------
+//  op_or - process a OR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_or(arm64code *&dst, const instruction &inst)
+{
+	op_logical(dst, inst, LOGICAL_ORR_IMM, LOGICAL_ORR_REG);
+}
+
+
+//-------------------------------------------------
+//  op_xor - process a XOR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_xor(arm64code *&dst, const instruction &inst)
+{
+	op_logical(dst, inst, LOGICAL_EOR_IMM, LOGICAL_EOR_REG);
+}
+
+
+//-------------------------------------------------
+//  op_lzcnt - process a LZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_lzcnt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// count the leading zeros
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X1);
+	emit_clz(dst, sf, dstreg, srcreg);                                                  // clz   dstreg,srcreg
+
+	// compute flags and store the result
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, dstreg);                                                 // cmp   dstreg,#0
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_bswap - process a BSWAP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_bswap(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// flags reflect the source, so compute them before it may be overwritten
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X1);
+	if (inst.flags() != 0)
+		emit_nz_flags(dst, sf, srcreg);                                                 // cmp   srcreg,#0
+	emit_rev(dst, sf, dstreg, srcreg);                                                  // rev   dstreg,srcreg
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_shift - shared code for SHL, SHR, SAR, ROL
+//  and ROR; a count of zero leaves the flags
+//  unchanged
+//-------------------------------------------------
+
+void drcbe_arm64::op_shift(arm64code *&dst, const instruction &inst, int type)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X1);
+
+	// immediate shift counts
+	if (shiftp.is_immediate())
+	{
+		int count = shiftp.immediate() & (bits - 1);
+
+		// a zero count is just a move
+		if (count == 0)
+		{
+			if (dstreg != srcreg)
+				emit_mov_reg(dst, sf, dstreg, srcreg);                                  // mov   dstreg,srcreg
+			emit_mov_p_r(dst, sf, dstp, dstreg);                                        // mov   dstp,dstreg
+			flags_kept();
+			return;
+		}
+
+		// capture the carry from the source before it may be overwritten
+		if (inst.flags() != 0 && type == SHIFTOP_SHL)
+			emit_ubfx(dst, sf, REG_X2, srcreg, bits - count, 1);                        // ubfx  x2,srcreg,#bits-count,#1
+		else if (inst.flags() != 0 && (type == SHIFTOP_SHR || type == SHIFTOP_SAR))
+			emit_ubfx(dst, sf, REG_X2, srcreg, count - 1, 1);                           // ubfx  x2,srcreg,#count-1,#1
+
+		// shift
+		switch (type)
+		{
+			case SHIFTOP_SHL:   emit_lsl_imm(dst, sf, dstreg, srcreg, count);           break;  // lsl   dstreg,srcreg,#count
+			case SHIFTOP_SHR:   emit_lsr_imm(dst, sf, dstreg, srcreg, count);           break;  // lsr   dstreg,srcreg,#count
+			case SHIFTOP_SAR:   emit_asr_imm(dst, sf, dstreg, srcreg, count);           break;  // asr   dstreg,srcreg,#count
+			case SHIFTOP_ROL:   emit_ror_imm(dst, sf, dstreg, srcreg, bits - count);    break;  // ror   dstreg,srcreg,#bits-count
+			case SHIFTOP_ROR:   emit_ror_imm(dst, sf, dstreg, srcreg, count);           break;  // ror   dstreg,srcreg,#count
+		}
+
+		// rotates take the carry from the result
+		if (inst.flags() != 0)
+		{
+			if (type == SHIFTOP_ROL)
+				emit_ubfx(dst, sf, REG_X2, dstreg, 0, 1);                               // ubfx  x2,dstreg,#0,#1
+			else if (type == SHIFTOP_ROR)
+				emit_ubfx(dst, sf, REG_X2, dstreg, bits - 1, 1);                        // ubfx  x2,dstreg,#bits-1,#1
+			emit_nz_flags(dst, sf, dstreg);                                             // cmp   dstreg,#0
+			emit_set_carry(dst, REG_X2);
+		}
+	}
+
+	// variable shift counts
+	else
+	{
+		// the hardware masks the count the same way, but we need it for the zero test and carry
+		UINT8 shiftreg = emit_get_r_p(dst, 0, shiftp, REG_X3);
+		emit_and_imm(dst, 0, REG_X3, shiftreg, bits - 1);                               // and   w3,shiftreg,#bits-1
+
+		// capture the carry from the source before it may be overwritten
+		if (inst.flags() != 0 && type == SHIFTOP_SHL)
+		{
+			emit_neg(dst, 0, REG_X4, REG_X3);                                           // neg   w4,w3
+			emit_lsrv(dst, sf, REG_X2, srcreg, REG_X4);                                 // lsr   x2,srcreg,x4
+		}
+		else if (inst.flags() != 0 && (type == SHIFTOP_SHR || type == SHIFTOP_SAR))
+		{
+			emit_sub_imm(dst, 0, REG_X4, REG_X3, 1);                                    // sub   w4,w3,#1
+			emit_lsrv(dst, sf, REG_X2, srcreg, REG_X4);                                 // lsr   x2,srcreg,x4
+		}
+
+		// shift
+		switch (type)
+		{
+			case SHIFTOP_SHL:   emit_lslv(dst, sf, dstreg, srcreg, REG_X3);             break;  // lsl   dstreg,srcreg,x3
+			case SHIFTOP_SHR:   emit_lsrv(dst, sf, dstreg, srcreg, REG_X3);             break;  // lsr   dstreg,srcreg,x3
+			case SHIFTOP_SAR:   emit_asrv(dst, sf, dstreg, srcreg, REG_X3);             break;  // asr   dstreg,srcreg,x3
+			case SHIFTOP_ROL:   emit_neg(dst, 0, REG_X4, REG_X3);                               // neg   w4,w3
+								emit_rorv(dst, sf, dstreg, srcreg, REG_X4);             break;  // ror   dstreg,srcreg,x4
+			case SHIFTOP_ROR:   emit_rorv(dst, sf, dstreg, srcreg, REG_X3);             break;  // ror   dstreg,srcreg,x3
+		}
+
+		// compute flags, unless the count was zero
+		if (inst.flags() != 0)
+		{
+			branch_link skip;
+			emit_cbz_link(dst, 0, REG_X3, skip);                                        // cbz   w3,skip
+			if (type == SHIFTOP_ROL)
+				emit_ubfx(dst, sf, REG_X2, dstreg, 0, 1);                               // ubfx  x2,dstreg,#0,#1
+			else if (type == SHIFTOP_ROR)
+				emit_ubfx(dst, sf, REG_X2, dstreg, bits - 1, 1);                        // ubfx  x2,dstreg,#bits-1,#1
+			emit_nz_flags(dst, sf, dstreg);                                             // cmp   dstreg,#0
+			emit_set_carry(dst, REG_X2);
+			resolve_link(dst, skip);                                                    // skip:
+		}
+	}
+
+	// store the result
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_rotate_carry - shared code for ROLC and
+//  RORC, which rotate through the carry
+//-------------------------------------------------
+
+void drcbe_arm64::op_rotate_carry(arm64code *&dst, const instruction &inst, bool left)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	int sf = (inst.size() == 8);
+	int bits = inst.size() * 8;
+
+	// fetch the source and the incoming carry; the result goes in x5
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X1);
+	emit_get_carry(dst, REG_X4);
+
+	// immediate rotate counts
+	if (shiftp.is_immediate())
+	{
+		int count = shiftp.immediate() & (bits - 1);
+
+		// a zero count is just a move
+		if (count == 0)
+		{
+			emit_mov_p_r(dst, sf, dstp, srcreg);                                        // mov   dstp,srcreg
+			flags_kept();
+			return;
+		}
+
+		if (left)
+		{
+			emit_lsl_imm(dst, sf, REG_X5, srcreg, count);                               // lsl   x5,srcreg,#count
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X4, SHIFT_LSL, count - 1);        // orr   x5,x5,x4,lsl #count-1
+			if (count > 1)
+				emit_orr_reg(dst, sf, REG_X5, REG_X5, srcreg, SHIFT_LSR, bits + 1 - count);
+																						// orr   x5,x5,srcreg,lsr #bits+1-count
+			if (inst.flags() != 0)
+				emit_ubfx(dst, sf, REG_X2, srcreg, bits - count, 1);                    // ubfx  x2,srcreg,#bits-count,#1
+		}
+		else
+		{
+			emit_lsr_imm(dst, sf, REG_X5, srcreg, count);                               // lsr   x5,srcreg,#count
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X4, SHIFT_LSL, bits - count);     // orr   x5,x5,x4,lsl #bits-count
+			if (count > 1)
+				emit_orr_reg(dst, sf, REG_X5, REG_X5, srcreg, SHIFT_LSL, bits + 1 - count);
+																						// orr   x5,x5,srcreg,lsl #bits+1-count
+			if (inst.flags() != 0)
+				emit_ubfx(dst, sf, REG_X2, srcreg, count - 1, 1);                       // ubfx  x2,srcreg,#count-1,#1
+		}
+
+		// compute flags
+		if (inst.flags() != 0)
+		{
+			emit_nz_flags(dst, sf, REG_X5);                                             // cmp   x5,#0
+			emit_set_carry(dst, REG_X2);
+		}
+	}
+
+	// variable rotate counts
+	else
+	{
+		// start with the unrotated value, and skip the rest for a zero count
+		UINT8 shiftreg = emit_get_r_p(dst, 0, shiftp, REG_X3);
+		emit_and_imm(dst, 0, REG_X3, shiftreg, bits - 1);                               // and   w3,shiftreg,#bits-1
+		emit_mov_reg(dst, sf, REG_X5, srcreg);                                          // mov   x5,srcreg
+		branch_link skip;
+		emit_cbz_link(dst, 0, REG_X3, skip);                                            // cbz   w3,skip
+
+		emit_neg(dst, 0, REG_X6, REG_X3);                                               // neg   w6,w3
+		if (left)
+		{
+			// (src << n) | (C << (n-1)) | ((src >> 1) >> (bits-n)); carry is bit bits-n
+			emit_lslv(dst, sf, REG_X5, srcreg, REG_X3);                                 // lsl   x5,srcreg,x3
+			emit_sub_imm(dst, 0, REG_X7, REG_X3, 1);                                    // sub   w7,w3,#1
+			emit_lslv(dst, sf, REG_X7, REG_X4, REG_X7);                                 // lsl   x7,x4,x7
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X7);                              // orr   x5,x5,x7
+			emit_lsr_imm(dst, sf, REG_X7, srcreg, 1);                                   // lsr   x7,srcreg,#1
+			emit_lsrv(dst, sf, REG_X7, REG_X7, REG_X6);                                 // lsr   x7,x7,x6
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X7);                              // orr   x5,x5,x7
+			if (inst.flags() != 0)
+				emit_lsrv(dst, sf, REG_X2, srcreg, REG_X6);                             // lsr   x2,srcreg,x6
+		}
+		else
+		{
+			// (src >> n) | (C << (bits-n)) | ((src << 1) << (bits-n)); carry is bit n-1
+			emit_lsrv(dst, sf, REG_X5, srcreg, REG_X3);                                 // lsr   x5,srcreg,x3
+			emit_lslv(dst, sf, REG_X7, REG_X4, REG_X6);                                 // lsl   x7,x4,x6
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X7);                              // orr   x5,x5,x7
+			emit_lsl_imm(dst, sf, REG_X7, srcreg, 1);                                   // lsl   x7,srcreg,#1
+			emit_lslv(dst, sf, REG_X7, REG_X7, REG_X6);                                 // lsl   x7,x7,x6
+			emit_orr_reg(dst, sf, REG_X5, REG_X5, REG_X7);                              // orr   x5,x5,x7
+			if (inst.flags() != 0)
+			{
+				emit_sub_imm(dst, 0, REG_X7, REG_X3, 1);                                // sub   w7,w3,#1
+				emit_lsrv(dst, sf, REG_X2, srcreg, REG_X7);                             // lsr   x2,srcreg,x7
+			}
+		}
+
+		// compute flags
+		if (inst.flags() != 0)
+		{
+			emit_nz_flags(dst, sf, REG_X5);                                             // cmp   x5,#0
+			emit_set_carry(dst, REG_X2);
+		}
+		resolve_link(dst, skip);                                                        // skip:
+	}
+
+	// store the result
+	emit_mov_p_r(dst, sf, dstp, REG_X5);                                                // mov   dstp,x5
+	if (inst.flags() == 0)
+		flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_shl - process a SHL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_shl(arm64code *&dst, const instruction &inst)
+{
+	op_shift(dst, inst, SHIFTOP_SHL);
+}
+
+
+//-------------------------------------------------
+//  op_shr - process a SHR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_shr(arm64code *&dst, const instruction &inst)
+{
+	op_shift(dst, inst, SHIFTOP_SHR);
+}
+
+
+//-------------------------------------------------
+//  op_sar - process a SAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sar(arm64code *&dst, const instruction &inst)
+{
+	op_shift(dst, inst, SHIFTOP_SAR);
+}
+
+
+//-------------------------------------------------
+//  op_rol - process a ROL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rol(arm64code *&dst, const instruction &inst)
+{
+	op_shift(dst, inst, SHIFTOP_ROL);
+}
+
+
+//-------------------------------------------------
+//  op_rolc - process a ROLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolc(arm64code *&dst, const instruction &inst)
+{
+	op_rotate_carry(dst, inst, true);
+}
+
+
+//-------------------------------------------------
+//  op_ror - process a ROR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ror(arm64code *&dst, const instruction &inst)
+{
+	op_shift(dst, inst, SHIFTOP_ROR);
+}
+
+
+//-------------------------------------------------
+//  op_rorc - process a RORC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rorc(arm64code *&dst, const instruction &inst)
+{
+	op_rotate_carry(dst, inst, false);
+}
+
+
+
+//**************************************************************************
+//  FLOATING POINT OPERATIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  op_fload - process a FLOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fload(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// load and store the result
+	emit_index_address(dst, ftype ? LDST_LDR_D : LDST_LDR_S, dstreg, basep, indp, ftype ? 3 : 2);
+																						// ldr   dstreg,[basep + indp << size]
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fstore - process a FSTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fstore(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// store from a register
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D0);
+	emit_index_address(dst, ftype ? LDST_STR_D : LDST_STR_S, srcreg, basep, indp, ftype ? 3 : 2);
+																						// str   srcreg,[basep + indp << size]
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fread - process a FREAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fread(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	data_accessors &accessors = m_accessors[spacep.space()];
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// set up a call to the read handler
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacep.space()]));                      // mov   x0,space
+	if (ftype)
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_qword);                 // bl    read_qword
+	else
+		emit_smart_call_m64(dst, (void *const *)&accessors.read_dword);                 // bl    read_dword
+
+	// move the bits into the floating point register and store the result
+	emit_fmov_from_gp(dst, ftype, dstreg, REG_X0);                                      // fmov  dstreg,x0
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fwrite - process a FWRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fwrite(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	data_accessors &accessors = m_accessors[spacep.space()];
+	int ftype = (inst.size() == 8);
+
+	// set up a call to the write handler, passing the raw bits
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D0);
+	emit_fmov_to_gp(dst, ftype, REG_X2, srcreg);                                        // fmov  x2,srcreg
+	emit_mov_r_p(dst, 0, REG_X1, addrp);                                                // mov   w1,addrp
+	emit_mov_imm(dst, 1, REG_X0, (FPTR)(m_space[spacep.space()]));                      // mov   x0,space
+	if (ftype)
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_qword);                // bl    write_qword
+	else
+		emit_smart_call_m64(dst, (void *const *)&accessors.write_dword);                // bl    write_dword
+}
+
+
+//-------------------------------------------------
+//  op_fmov - process a FMOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmov(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// branch around if conditional
+	branch_link skip;
+	emit_skip_unless(dst, inst, skip);                                                  // b.!cc skip
+
+	// move through a register
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D0);
+	emit_fmov_p_f(dst, ftype, dstp, srcreg);                                            // fmov  dstp,srcreg
+
+	emit_resolve_skip(dst, inst, skip);                                                 // skip:
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_ftoint - process a FTOINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ftoint(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const parameter &roundp = inst.param(3);
+	assert(roundp.is_rounding());
+	int ftype = (inst.size() == 8);
+	int sf = (sizep.size() == SIZE_QWORD);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// each explicit rounding mode has its own conversion; the default uses the FPCR mode
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D0);
+	switch (roundp.rounding())
+	{
+		case ROUND_TRUNC:   emit_fcvtzs(dst, sf, ftype, dstreg, srcreg);                break;  // fcvtzs dstreg,srcreg
+		case ROUND_ROUND:   emit_fcvtns(dst, sf, ftype, dstreg, srcreg);                break;  // fcvtns dstreg,srcreg
+		case ROUND_CEIL:    emit_fcvtps(dst, sf, ftype, dstreg, srcreg);                break;  // fcvtps dstreg,srcreg
+		case ROUND_FLOOR:   emit_fcvtms(dst, sf, ftype, dstreg, srcreg);                break;  // fcvtms dstreg,srcreg
+		case ROUND_DEFAULT: emit_frinti(dst, ftype, REG_D1, srcreg);                            // frinti d1,srcreg
+							emit_fcvtzs(dst, sf, ftype, dstreg, REG_D1);                break;  // fcvtzs dstreg,d1
+	}
+
+	// store the result
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_ffrint - process a FFRINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrint(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	int ftype = (inst.size() == 8);
+	int sf = (sizep.size() == SIZE_QWORD);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// convert and store the result
+	UINT8 srcreg = emit_get_r_p(dst, sf, srcp, REG_X0);
+	emit_scvtf(dst, sf, ftype, dstreg, srcreg);                                         // scvtf dstreg,srcreg
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_ffrflt - process a FFRFLT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrflt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	int ftype = (inst.size() == 8);
+	int srctype = (sizep.size() == SIZE_QWORD);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// convert between precisions and store the result
+	UINT8 srcreg = emit_get_f_p(dst, srctype, srcp, REG_D1);
+	if (ftype == srctype)
+		emit_fmov(dst, ftype, dstreg, srcreg);                                          // fmov  dstreg,srcreg
+	else if (ftype)
+		emit_fcvt_to_double(dst, dstreg, srcreg);                                       // fcvt  dstreg,srcreg
+	else
+		emit_fcvt_to_single(dst, dstreg, srcreg);                                       // fcvt  dstreg,srcreg
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_frnds - process a FRNDS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frnds(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// round through single precision and store the result
+	UINT8 srcreg = emit_get_f_p(dst, 1, srcp, REG_D1);
+	emit_fcvt_to_single(dst, REG_D1, srcreg);                                           // fcvt  s1,srcreg
+	emit_fcvt_to_double(dst, dstreg, REG_D1);                                           // fcvt  dstreg,s1
+	emit_fmov_p_f(dst, 1, dstp, dstreg);                                                // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fp_binary - shared code for FADD, FSUB,
+//  FMUL and FDIV
+//-------------------------------------------------
+
+void drcbe_arm64::op_fp_binary(arm64code *&dst, const instruction &inst, UINT32 opcode)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// operate and store the result
+	UINT8 src1reg = emit_get_f_p(dst, ftype, src1p, REG_D1);
+	UINT8 src2reg = emit_get_f_p(dst, ftype, src2p, REG_D2);
+	emit_fp2(dst, opcode, ftype, dstreg, src1reg, src2reg);                             // fop   dstreg,src1reg,src2reg
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fp_unary - shared code for FNEG, FABS and
+//  FSQRT
+//-------------------------------------------------
+
+void drcbe_arm64::op_fp_unary(arm64code *&dst, const instruction &inst, UINT32 opcode)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// operate and store the result
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D1);
+	emit_fp1(dst, opcode, ftype, dstreg, srcreg);                                       // fop   dstreg,srcreg
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fadd - process a FADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fadd(arm64code *&dst, const instruction &inst)
+{
+	op_fp_binary(dst, inst, FPOP_ADD);
+}
+
+
+//-------------------------------------------------
+//  op_fsub - process a FSUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fsub(arm64code *&dst, const instruction &inst)
+{
+	op_fp_binary(dst, inst, FPOP_SUB);
+}
+
+
+//-------------------------------------------------
+//  op_fcmp - process a FCMP opcode; unordered
+//  results set the host V flag, which the flags
+//  register then marks as U rather than V
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcmp(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_U);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// compare and capture the flags
+	UINT8 src1reg = emit_get_f_p(dst, ftype, src1p, REG_D0);
+	UINT8 src2reg = emit_get_f_p(dst, ftype, src2p, REG_D1);
+	emit_fcmp(dst, ftype, src1reg, src2reg);                                            // fcmp  src1reg,src2reg
+	emit_save_flags(dst, false);                                                        // mrs   flags,nzcv
+	emit_orr_imm(dst, 1, REG_FLAGS, REG_FLAGS, FLAGS_U);                                // orr   flags,flags,#U
+}
+
+
+//-------------------------------------------------
+//  op_fmul - process a FMUL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmul(arm64code *&dst, const instruction &inst)
+{
+	op_fp_binary(dst, inst, FPOP_MUL);
+}
+
+
+//-------------------------------------------------
+//  op_fdiv - process a FDIV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fdiv(arm64code *&dst, const instruction &inst)
+{
+	op_fp_binary(dst, inst, FPOP_DIV);
+}
+
+
+//-------------------------------------------------
+//  op_fneg - process a FNEG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fneg(arm64code *&dst, const instruction &inst)
+{
+	op_fp_unary(dst, inst, FPOP_NEG);
+}
+
+
+//-------------------------------------------------
+//  op_fabs - process a FABS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fabs(arm64code *&dst, const instruction &inst)
+{
+	op_fp_unary(dst, inst, FPOP_ABS);
+}
+
+
+//-------------------------------------------------
+//  op_fsqrt - process a FSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fsqrt(arm64code *&dst, const instruction &inst)
+{
+	op_fp_unary(dst, inst, FPOP_SQRT);
+}
+
+
+//-------------------------------------------------
+//  op_frecip - process a FRECIP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frecip(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// divide into one and store the result
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D1);
+	emit_fmov_one(dst, ftype, REG_D2);                                                  // fmov  d2,#1.0
+	emit_fdiv(dst, ftype, dstreg, REG_D2, srcreg);                                      // fdiv  dstreg,d2,srcreg
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_frsqrt - process a FRSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frsqrt(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// divide one by the square root and store the result
+	UINT8 srcreg = emit_get_f_p(dst, ftype, srcp, REG_D1);
+	emit_fsqrt(dst, ftype, REG_D1, srcreg);                                             // fsqrt d1,srcreg
+	emit_fmov_one(dst, ftype, REG_D2);                                                  // fmov  d2,#1.0
+	emit_fdiv(dst, ftype, dstreg, REG_D2, REG_D1);                                      // fdiv  dstreg,d2,d1
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_fcopyi - process a FCOPYI opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcopyi(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MR);
+	int ftype = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_D0);
+
+	// memory sources load straight into the floating point register
+	if (srcp.is_memory())
+		emit_ldst_ptr(dst, ftype ? LDST_LDR_D : LDST_LDR_S, dstreg, srcp.memory());     // ldr   dstreg,[srcp]
+	else
+		emit_fmov_from_gp(dst, ftype, dstreg, srcp.ireg());                             // fmov  dstreg,srcp
+	emit_fmov_p_f(dst, ftype, dstp, dstreg);                                            // fmov  dstp,dstreg
+	flags_kept();
+}
+
+
+//-------------------------------------------------
+//  op_icopyf - process a ICOPYF opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_icopyf(arm64code *&dst, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	int sf = (inst.size() == 8);
+
+	// pick a target register for the general case
+	int dstreg = dstp.select_register(REG_X0);
+
+	// memory sources load straight into the integer register
+	if (srcp.is_memory())
+		emit_ldst_ptr(dst, sf ? LDST_LDR_X : LDST_LDR_W, dstreg, srcp.memory());        // ldr   dstreg,[srcp]
+	else
+		emit_fmov_to_gp(dst, sf, dstreg, srcp.freg());                                  // fmov  dstreg,srcp
+	emit_mov_p_r(dst, sf, dstp, dstreg);                                                // mov   dstp,dstreg
+	flags_kept();
+}
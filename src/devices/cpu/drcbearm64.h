@@ -0,0 +1,273 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbearm64.h
+
+    64-bit ARM (AArch64) back-end for the universal machine language.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCBEARM64_H__
+#define __DRCBEARM64_H__
+
+#include "drcuml.h"
+#include "drcbeut.h"
+#include "arm64emit.h"
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+class drcbe_arm64 : public drcbe_interface
+{
+	typedef UINT32 (*arm64_entry_point_func)(UINT8 *baseptr, arm64emit::arm64code *entry);
+
+public:
+	// construction/destruction
+	drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits);
+	virtual ~drcbe_arm64();
+
+	// required overrides
+	virtual void reset() override;
+	virtual int execute(uml::code_handle &entry) override;
+	virtual void generate(drcuml_block &block, const uml::instruction *instlist, UINT32 numinst) override;
+	virtual bool hash_exists(UINT32 mode, UINT32 pc) override;
+	virtual void get_info(drcbe_info &info) override;
+
+private:
+	// a be_parameter is similar to a uml::parameter but maps to native registers/memory
+	class be_parameter
+	{
+	public:
+		// parameter types
+		enum be_parameter_type
+		{
+			PTYPE_NONE = 0,                     // invalid
+			PTYPE_IMMEDIATE,                    // immediate; value = sign-extended to 64 bits
+			PTYPE_INT_REGISTER,                 // integer register; value = 0-31
+			PTYPE_FLOAT_REGISTER,               // floating point register; value = 0-31
+			PTYPE_MEMORY,                       // memory; value = pointer to memory
+			PTYPE_MAX
+		};
+
+		// represents the value of a parameter
+		typedef UINT64 be_parameter_value;
+
+		// construction
+		be_parameter() : m_type(PTYPE_NONE), m_value(0) { }
+		be_parameter(const be_parameter &param) : m_type(param.m_type), m_value(param.m_value) { }
+		be_parameter(UINT64 val) : m_type(PTYPE_IMMEDIATE), m_value(val) { }
+		be_parameter(drcbe_arm64 &drcbe, const uml::parameter &param, UINT32 allowed);
+
+		// creators for types that don't safely default
+		static inline be_parameter make_ireg(int regnum) { assert(regnum >= 0 && regnum < 32); return be_parameter(PTYPE_INT_REGISTER, regnum); }
+		static inline be_parameter make_freg(int regnum) { assert(regnum >= 0 && regnum < 32); return be_parameter(PTYPE_FLOAT_REGISTER, regnum); }
+		static inline be_parameter make_memory(void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(base)); }
+		static inline be_parameter make_memory(const void *base) { return be_parameter(PTYPE_MEMORY, reinterpret_cast<be_parameter_value>(const_cast<void *>(base))); }
+
+		// operators
+		bool operator==(const be_parameter &rhs) const { return (m_type == rhs.m_type && m_value == rhs.m_value); }
+		bool operator!=(const be_parameter &rhs) const { return (m_type != rhs.m_type || m_value != rhs.m_value); }
+
+		// getters
+		be_parameter_type type() const { return m_type; }
+		UINT64 immediate() const { assert(m_type == PTYPE_IMMEDIATE); return m_value; }
+		int ireg() const { assert(m_type == PTYPE_INT_REGISTER); assert(m_value < 32); return m_value; }
+		int freg() const { assert(m_type == PTYPE_FLOAT_REGISTER); assert(m_value < 32); return m_value; }
+		void *memory() const { assert(m_type == PTYPE_MEMORY); return reinterpret_cast<void *>(m_value); }
+
+		// type queries
+		bool is_immediate() const { return (m_type == PTYPE_IMMEDIATE); }
+		bool is_int_register() const { return (m_type == PTYPE_INT_REGISTER); }
+		bool is_float_register() const { return (m_type == PTYPE_FLOAT_REGISTER); }
+		bool is_memory() const { return (m_type == PTYPE_MEMORY); }
+
+		// other queries
+		bool is_immediate_value(UINT64 value) const { return (m_type == PTYPE_IMMEDIATE && m_value == value); }
+
+		// helpers
+		int select_register(int defreg) const;
+		int select_register(int defreg, const be_parameter &checkparam) const;
+
+	private:
+		// private constructor
+		be_parameter(be_parameter_type type, be_parameter_value value) : m_type(type), m_value(value) { }
+
+		// internals
+		be_parameter_type   m_type;             // parameter type
+		be_parameter_value  m_value;            // parameter value
+	};
+
+	// helpers
+	void normalize_commutative(be_parameter &inner, be_parameter &outer);
+	void emit_load_address(arm64emit::arm64code *&dst, UINT8 reg, const void *ptr);
+	void emit_ldst_ptr(arm64emit::arm64code *&dst, UINT32 op, UINT8 reg, const void *ptr);
+	void emit_ldst_offset(arm64emit::arm64code *&dst, UINT32 op, UINT8 reg, UINT8 basereg, UINT32 offset);
+	void emit_smart_call(arm64emit::arm64code *&dst, const void *target);
+	void emit_smart_call_m64(arm64emit::arm64code *&dst, void *const *target);
+	void emit_smart_jump(arm64emit::arm64code *&dst, const void *target);
+	void emit_skip_unless(arm64emit::arm64code *&dst, const uml::instruction &inst, arm64emit::branch_link &skip);
+	void emit_resolve_skip(arm64emit::arm64code *&dst, const uml::instruction &inst, const arm64emit::branch_link &skip);
+
+	void fixup_label(void *parameter, drccodeptr labelcodeptr);
+	void fixup_exception(drccodeptr *codeptr, void *param1, void *param2);
+
+	// flags helpers
+	void emit_restore_flags(arm64emit::arm64code *&dst);
+	void emit_save_flags(arm64emit::arm64code *&dst, bool invertcarry);
+	void emit_nz_flags(arm64emit::arm64code *&dst, int sf, UINT8 reg);
+	void emit_set_carry(arm64emit::arm64code *&dst, UINT8 reg);
+	void emit_get_carry(arm64emit::arm64code *&dst, UINT8 reg);
+	void flags_kept() { m_nzcv_keep = m_nzcv_live; }
+
+	// code generators
+	void op_handle(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_hash(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_label(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_comment(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_mapvar(arm64emit::arm64code *&dst, const uml::instruction &inst);
+
+	void op_nop(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_debug(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_exit(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_hashjmp(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_jmp(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_exh(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_callh(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_ret(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_callc(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_recover(arm64emit::arm64code *&dst, const uml::instruction &inst);
+
+	void op_setfmod(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_getfmod(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_getexp(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_getflgs(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_save(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_restore(arm64emit::arm64code *&dst, const uml::instruction &inst);
+
+	void op_load(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_loads(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_store(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_read(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_readm(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_write(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_writem(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_carry(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_set(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_mov(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_sext(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_roland(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_rolins(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_add(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_addc(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_sub(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_subc(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_cmp(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_mulu(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_muls(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_divu(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_divs(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_and(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_test(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_or(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_xor(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_lzcnt(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_bswap(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_shl(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_shr(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_sar(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_ror(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_rol(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_rorc(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_rolc(arm64emit::arm64code *&dst, const uml::instruction &inst);
+
+	void op_fload(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fstore(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fread(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fwrite(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fmov(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_ftoint(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_ffrint(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_ffrflt(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_frnds(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fadd(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fsub(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fcmp(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fmul(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fdiv(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fneg(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fabs(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fsqrt(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_frecip(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_frsqrt(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_fcopyi(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	void op_icopyf(arm64emit::arm64code *&dst, const uml::instruction &inst);
+
+	// shared code generators
+	void op_logical(arm64emit::arm64code *&dst, const uml::instruction &inst, UINT32 immop, UINT32 regop);
+	void op_shift(arm64emit::arm64code *&dst, const uml::instruction &inst, int type);
+	void op_rotate_carry(arm64emit::arm64code *&dst, const uml::instruction &inst, bool left);
+	void op_fp_binary(arm64emit::arm64code *&dst, const uml::instruction &inst, UINT32 opcode);
+	void op_fp_unary(arm64emit::arm64code *&dst, const uml::instruction &inst, UINT32 opcode);
+	void emit_mul_flags(arm64emit::arm64code *&dst, int sf, bool is_signed, bool full, UINT8 loreg, UINT8 hireg);
+	void emit_index_address(arm64emit::arm64code *&dst, UINT32 op, UINT8 reg, const be_parameter &basep, const be_parameter &indp, int scale);
+
+	// integer code emission helpers
+	void emit_mov_r_p(arm64emit::arm64code *&dst, int sf, UINT8 reg, const be_parameter &param);
+	UINT8 emit_get_r_p(arm64emit::arm64code *&dst, int sf, const be_parameter &param, UINT8 tempreg);
+	void emit_mov_p_r(arm64emit::arm64code *&dst, int sf, const be_parameter &param, UINT8 reg);
+	void emit_logical_any(arm64emit::arm64code *&dst, UINT32 immop, UINT32 regop, int sf, UINT8 rd, UINT8 rn, UINT64 imm);
+
+	// floating-point code emission helpers
+	UINT8 emit_get_f_p(arm64emit::arm64code *&dst, int ftype, const be_parameter &param, UINT8 tempreg);
+	void emit_fmov_p_f(arm64emit::arm64code *&dst, int ftype, const be_parameter &param, UINT8 reg);
+
+	// internal state
+	drc_hash_table          m_hash;                 // hash table state
+	drc_map_variables       m_map;                  // code map
+	drc_label_list          m_labels;               // label list
+	UINT8 *                 m_baseptr;              // value of the base register (x27)
+
+	arm64_entry_point_func  m_entry;                // entry point
+	arm64emit::arm64code *  m_exit;                 // exit point
+	arm64emit::arm64code *  m_nocode;               // nocode handler
+
+	bool                    m_nzcv_live;            // true if the host NZCV currently matches the flags register
+	bool                    m_nzcv_keep;            // true if the current opcode left the host NZCV intact
+
+	drc_label_fixup_delegate m_fixup_label;         // precomputed delegate for fixups
+	drc_oob_delegate        m_fixup_exception;      // precomputed delegate for exception fixups
+
+	// state to live in the near cache
+	struct near_state
+	{
+		void *              debug_cpu_instruction_hook;// debugger callback
+		void *              drcmap_get_value;       // map lookup helper
+
+		UINT64              stacksave;              // saved stack pointer
+		UINT64              fpcrsave;               // saved host FPCR
+		UINT32              fpcr[4];                // FPCR value for each UML rounding mode
+
+		UINT8               flagsmap[0x20];         // flags map
+		UINT32              flagsunmap[0x20];       // flags unmapper
+	};
+	near_state &            m_near;
+
+	// globals
+	typedef void (drcbe_arm64::*opcode_generate_func)(arm64emit::arm64code *&dst, const uml::instruction &inst);
+	struct opcode_table_entry
+	{
+		uml::opcode_t           opcode;             // opcode in question
+		opcode_generate_func    func;               // function pointer to the work
+	};
+	static const opcode_table_entry s_opcode_table_source[];
+	static opcode_generate_func s_opcode_table[uml::OP_MAX];
+};
+
+
+#endif /* __DRCBEARM64_H__ */
@@ -386,10 +386,14 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, UINT32
 					psize[2] = 4;
 				if (opcode == OP_STORE || opcode == OP_FSTORE)
 					psize[1] = 4;
-				if (opcode == OP_READ || opcode == OP_READM || opcode == OP_FREAD)
+				if (opcode == OP_READ || opcode == OP_FREAD)
 					psize[1] = psize[2] = 4;
-				if (opcode == OP_WRITE || opcode == OP_WRITEM || opcode == OP_FWRITE)
+				if (opcode == OP_READM)
+					psize[1] = psize[3] = 4;
+				if (opcode == OP_WRITE || opcode == OP_FWRITE)
 					psize[0] = psize[2] = 4;
+				if (opcode == OP_WRITEM)
+					psize[0] = psize[3] = 4;
 				if (opcode == OP_SEXT && inst.param(2).size() != SIZE_QWORD)
 					psize[1] = 4;
 				if (opcode == OP_FTOINT)
@@ -825,6 +829,7 @@ int drcbe_c::execute(code_handle &entry)
 				m_space[PARAM3]->write_dword(PARAM0, PARAM1, PARAM2);
 				break;
 
+			case MAKE_OPCODE_SHORT(OP_CARRY, 4, 0):     // CARRY   src,bitnum
 			case MAKE_OPCODE_SHORT(OP_CARRY, 4, 1):     // CARRY   src,bitnum
 				flags = (flags & ~FLAG_C) | ((PARAM0 >> (PARAM1 & 31)) & FLAG_C);
 				break;
@@ -901,19 +906,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 1):
-				temp32 = PARAM1 + PARAM2 + (flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					if ((PARAM2 == 0xffffffff) && (flags & FLAG_C))
-					{
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-						flags |= FLAG_C;
-					}
-					else
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-				}
+				temp64 = (UINT64)PARAM1 + (UINT64)PARAM2 + (flags & FLAG_C);
+				temp32 = (UINT32)temp64;
+				flags = FLAGS32_NZ(temp32) | ((temp64 >> 32) & FLAG_C) | FLAGS32_V_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -932,17 +927,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 1):
-				temp32 = PARAM1 - PARAM2 - (flags & FLAG_C);
-				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (UINT64)(flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1 - (flags & FLAG_C), PARAM2);
-					flags &= ~(FLAG_C | FLAG_V);
-					flags |= ((temp64>>32) & 1) ? FLAG_C : 0;
-					flags |= (((PARAM1) ^ (PARAM2)) & ((PARAM1) ^ (temp64)) & 0x80000000) ? FLAG_V : 0;
-				}
+				temp64 = (UINT64)PARAM1 - (UINT64)PARAM2 - (flags & FLAG_C);
+				temp32 = (UINT32)temp64;
+				flags = FLAGS32_NZ(temp32) | ((temp64 >> 32) & FLAG_C) | FLAGS32_V_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
@@ -958,9 +945,9 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = (UINT32)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):
+			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):     // Z and S reflect the full product only if both halves are kept
 				temp64 = (UINT64)(UINT32)PARAM2 * (UINT64)(UINT32)PARAM3;
-				flags = FLAGS64_NZ(temp64);
+				flags = (inst[0].puint32 == inst[1].puint32) ? FLAGS32_NZ((UINT32)temp64) : FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (UINT32)temp64)
@@ -973,10 +960,9 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = (UINT32)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
+			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):     // Z and S reflect the full product only if both halves are kept
 				temp64 = (INT64)(INT32)PARAM2 * (INT64)(INT32)PARAM3;
-				temp32 = (INT32)temp64;
-				flags = FLAGS32_NZ(temp32);
+				flags = (inst[0].puint32 == inst[1].puint32) ? FLAGS32_NZ((UINT32)temp64) : FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (UINT32)temp64;
 				if (temp64 != (INT32)temp64)
@@ -1076,9 +1062,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
-				temp32 = PARAM1;
+				temp32 = FLIPENDIAN_INT32(PARAM1);
 				flags = FLAGS32_NZ(temp32);
-				PARAM0 = FLIPENDIAN_INT32(temp32);
+				PARAM0 = temp32;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
@@ -1148,6 +1134,8 @@ int drcbe_c::execute(code_handle &entry)
 					PARAM0 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 << shift) | (flags & FLAG_C);
+				else
+					PARAM0 = PARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 1):
@@ -1158,8 +1146,11 @@ int drcbe_c::execute(code_handle &entry)
 					temp32 = (PARAM1 << shift) | (flags & FLAG_C);
 				else
 					temp32 = PARAM1;
-				flags = FLAGS32_NZ(temp32);
-				if (shift != 0) flags |= ((PARAM1 << (shift - 1)) >> 31) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS32_NZ(temp32);
+					flags |= ((PARAM1 << (shift - 1)) >> 31) & FLAG_C;
+				}
 				PARAM0 = temp32;
 				break;
 
@@ -1171,29 +1162,37 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_ROR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (PARAM1 >> shift) | (PARAM1 << ((32 - shift) & 31));
-				flags = FLAGS32_NZ(temp32);
-				if (shift != 0) flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS32_NZ(temp32);
+					flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				PARAM0 = temp32;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					PARAM0 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
-					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
+					PARAM0 = (PARAM1 >> shift) | (((UINT32)flags & FLAG_C) << 31);
+				else
+					PARAM0 = PARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					temp32 = (PARAM1 >> shift) | ((((UINT32)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
-					temp32 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
+					temp32 = (PARAM1 >> shift) | (((UINT32)flags & FLAG_C) << 31);
 				else
 					temp32 = PARAM1;
-				flags = FLAGS32_NZ(temp32);
-				if (shift != 0) flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS32_NZ(temp32);
+					flags |= (PARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				PARAM0 = temp32;
 				break;
 
@@ -1417,7 +1416,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
-				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, PARAM2);
+				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, DPARAM2);
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
@@ -1449,6 +1448,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 1):     // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
 				break;
 
@@ -1535,10 +1535,10 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 1):
 				temp64 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
+				if (flags & FLAG_C)
+					flags = FLAGS64_NZ(temp64) | (temp64 <= DPARAM1) | FLAGS64_V_ADD(temp64, DPARAM1, DPARAM2);
 				else
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2);
+					flags = FLAGS64_NZ(temp64) | (temp64 < DPARAM1) | FLAGS64_V_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1558,10 +1558,10 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
+				if (flags & FLAG_C)
+					flags = FLAGS64_NZ(temp64) | (DPARAM1 <= DPARAM2) | FLAGS64_V_SUB(temp64, DPARAM1, DPARAM2);
 				else
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2);
+					flags = FLAGS64_NZ(temp64) | (DPARAM1 < DPARAM2) | FLAGS64_V_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
@@ -1639,7 +1639,7 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
-				temp64 = DPARAM1 & DPARAM2;
+				temp64 = DPARAM0 & DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				break;
 
@@ -1685,9 +1685,9 @@ int drcbe_c::execute(code_handle &entry)
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
-				temp64 = DPARAM1;
+				temp64 = FLIPENDIAN_INT64(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
-				DPARAM0 = FLIPENDIAN_INT64(temp64);
+				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
@@ -1697,8 +1697,11 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_SHL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 << shift;
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
@@ -1709,8 +1712,11 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_SHR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 >> shift;
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
@@ -1720,43 +1726,54 @@ int drcbe_c::execute(code_handle &entry)
 
 			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
-				temp64 = (INT32)DPARAM1 >> shift;
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				temp64 = (INT64)DPARAM1 >> shift;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
-				shift = DPARAM2 & 31;
+				shift = DPARAM2 & 63;
 				DPARAM0 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 << shift) | (DPARAM1 >> ((64 - shift) & 63));
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					DPARAM0 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
+				else
+					DPARAM0 = DPARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					temp64 = (DPARAM1 << shift) | (((UINT64)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					temp64 = (DPARAM1 << shift) | (flags & FLAG_C);
 				else
 					temp64 = DPARAM1;
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= ((DPARAM1 << (shift - 1)) >> 63) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
@@ -1768,8 +1785,11 @@ int drcbe_c::execute(code_handle &entry)
 			case MAKE_OPCODE_SHORT(OP_ROR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = (DPARAM1 >> shift) | (DPARAM1 << ((64 - shift) & 63));
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
@@ -1779,6 +1799,8 @@ int drcbe_c::execute(code_handle &entry)
 					DPARAM0 = (DPARAM1 >> shift) | ((((UINT64)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 >> shift) | (((UINT64)flags & FLAG_C) << 63);
+				else
+					DPARAM0 = DPARAM1;
 				break;
 
 			case MAKE_OPCODE_SHORT(OP_RORC, 8, 1):
@@ -1789,8 +1811,11 @@ int drcbe_c::execute(code_handle &entry)
 					temp64 = (DPARAM1 >> shift) | (((UINT64)flags & FLAG_C) << 63);
 				else
 					temp64 = DPARAM1;
-				flags = FLAGS64_NZ(temp64);
-				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				if (shift != 0)
+				{
+					flags = FLAGS64_NZ(temp64);
+					flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
+				}
 				DPARAM0 = temp64;
 				break;
 
@@ -2233,10 +2258,12 @@ int drcbe_c::dmulu(UINT64 &dstlo, UINT64 &dsthi, UINT64 src1, UINT64 src2, int f
 	lo += temp << 32;
 	hi += (temp >> 32) + (lo < prevlo);
 
-	// store the results
+	// store the results; Z and S reflect the full product only if both halves are kept
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != 0) << 1);
+	if (&dstlo == &dsthi)
+		return FLAGS64_NZ(lo) | ((hi != 0) << 1);
+	return ((hi >> 60) & FLAG_S) | ((hi != 0) << 1);
 }
 
 
@@ -2284,8 +2311,10 @@ int drcbe_c::dmuls(UINT64 &dstlo, UINT64 &dsthi, INT64 src1, INT64 src2, int fla
 		lo = ~lo + 1;
 	}
 
-	// store the results
+	// store the results; Z and S reflect the full product only if both halves are kept
 	dsthi = hi;
 	dstlo = lo;
-	return ((hi >> 60) & FLAG_S) | ((dsthi != ((INT64)lo >> 63)) << 1);
+	if (&dstlo == &dsthi)
+		return FLAGS64_NZ(lo) | ((hi != ((INT64)lo >> 63)) << 1);
+	return ((hi >> 60) & FLAG_S) | ((hi != ((INT64)lo >> 63)) << 1);
 }
@@ -45,6 +45,9 @@ drc_hash_table::drc_hash_table(drc_cache &cache, UINT32 modes, UINT8 addrbits, U
 		m_emptyl2(nullptr)
 {
 	reset();
+
+	// unlink any code that gets evicted from the cache
+	cache.add_evict_callback(drc_evict_delegate(FUNC(drc_hash_table::evict), this));
 }
 
 
@@ -56,7 +59,7 @@ drc_hash_table::drc_hash_table(drc_cache &cache, UINT32 modes, UINT8 addrbits, U
 bool drc_hash_table::reset()
 {
 	// allocate an empty l2 hash table
-	m_emptyl2 = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+	m_emptyl2 = (drccodeptr *)m_cache.alloc_pinned(sizeof(drccodeptr) << m_l2bits);
 	if (m_emptyl2 == nullptr)
 		return false;
 
@@ -65,7 +68,7 @@ bool drc_hash_table::reset()
 		m_emptyl2[entry] = m_nocodeptr;
 
 	// allocate an empty l1 hash table
-	m_emptyl1 = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+	m_emptyl1 = (drccodeptr **)m_cache.alloc_pinned(sizeof(drccodeptr *) << m_l1bits);
 	if (m_emptyl1 == nullptr)
 		return false;
 
@@ -163,7 +166,7 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 	assert(mode < m_modes);
 	if (m_base[mode] == m_emptyl1)
 	{
-		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_temporary(sizeof(drccodeptr *) << m_l1bits);
+		drccodeptr **newtable = (drccodeptr **)m_cache.alloc_pinned(sizeof(drccodeptr *) << m_l1bits);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl1, sizeof(drccodeptr *) << m_l1bits);
@@ -174,7 +177,7 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 	UINT32 l1 = (pc >> m_l1shift) & m_l1mask;
 	if (m_base[mode][l1] == m_emptyl2)
 	{
-		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_temporary(sizeof(drccodeptr) << m_l2bits);
+		drccodeptr *newtable = (drccodeptr *)m_cache.alloc_pinned(sizeof(drccodeptr) << m_l2bits);
 		if (newtable == nullptr)
 			return false;
 		memcpy(newtable, m_emptyl2, sizeof(drccodeptr) << m_l2bits);
@@ -188,6 +191,26 @@ bool drc_hash_table::set_codeptr(UINT32 mode, UINT32 pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  evict - point any entries for code in the
+//  given range back at the default codeptr
+//-------------------------------------------------
+
+void drc_hash_table::evict(drccodeptr start, drccodeptr end)
+{
+	for (int modenum = 0; modenum < m_modes; modenum++)
+		if (m_base[modenum] != m_emptyl1)
+			for (int l1entry = 0; l1entry < (1 << m_l1bits); l1entry++)
+				if (m_base[modenum][l1entry] != m_emptyl2)
+					for (int l2entry = 0; l2entry < (1 << m_l2bits); l2entry++)
+					{
+						drccodeptr code = m_base[modenum][l1entry][l2entry];
+						if (code >= start && code < end)
+							m_base[modenum][l1entry][l2entry] = m_nocodeptr;
+					}
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -243,8 +266,8 @@ void drc_map_variables::block_end(drcuml_block &block)
 	if (m_entry_list.first() == nullptr)
 		return;
 
-	// begin "code generation" aligned to an 8-byte boundary
-	drccodeptr *top = m_cache.begin_codegen(sizeof(UINT64) + sizeof(UINT32) + 2 * sizeof(UINT32) * m_entry_list.count());
+	// begin "code generation" aligned to an 8-byte boundary; this must directly follow the code
+	drccodeptr *top = m_cache.begin_codegen(sizeof(UINT64) + sizeof(UINT32) + 2 * sizeof(UINT32) * m_entry_list.count(), true);
 	if (top == nullptr)
 		block.abort();
 	UINT32 *dest = (UINT32 *)(((FPTR)*top + 7) & ~7);
@@ -356,7 +379,7 @@ UINT32 drc_map_variables::get_value(drccodeptr codebase, UINT32 mapvar) const
 
 	// get an aligned pointer to start scanning
 	UINT64 *curscan = (UINT64 *)(((FPTR)codebase | 7) + 1);
-	UINT64 *endscan = (UINT64 *)m_cache.top();
+	UINT64 *endscan = (UINT64 *)m_cache.region_top(codebase);
 
 	// look for the signature
 	while (curscan < endscan && *curscan++ != m_uniquevalue) {};
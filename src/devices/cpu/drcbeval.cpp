@@ -0,0 +1,1367 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbeval.cpp
+
+    Conformance tests and benchmarks for the UML back-ends.
+
+****************************************************************************
+
+    Every test compiles the same tiny block on the C back-end and on
+    the native back-end:
+
+        handle  entry
+        restore istate
+        <instruction under test>
+        getflgs [flags],<flags being checked>
+        save    fstate
+        exit    0
+
+    and compares the saved registers, the memory operands and the
+    captured flags. The tests are generated from the opcode table, so
+    every integer and floating point opcode is covered at each size it
+    allows, with each operand as an immediate, a low register, a high
+    register (which the native back-ends tend to keep in memory), a
+    memory location, or aliased to the first operand.
+
+    Memory space accesses use a small window of RAM found in the
+    device's program space; the window is filled before each test and
+    compared afterwards, and the original contents are put back when
+    the validator is done. Devices without plain RAM in their program
+    space skip those opcodes.
+
+    Where UML leaves a result undefined the comparison skips it: flags
+    that weren't requested, the upper half of a register written by a
+    32-bit operation, and the exact bits of a NaN.
+
+    The native back-end is whichever NATIVE_DRC names, so drcbe_x86 is
+    only checked by 32-bit x86 builds; it generates 32-bit code and
+    can't run in a 64-bit process.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcbeval.h"
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// size of the private cache given to each back-end
+const size_t VALIDATE_CACHE_SIZE = 8 * 1024 * 1024;
+
+// random initial values tried for each encoding
+const int VALUES_PER_ENCODING = 4;
+
+// failures described in the report for each opcode and size
+const UINT32 MAX_REPORTED_FAILURES = 4;
+
+// compilation benchmark size
+const int BENCHMARK_BLOCKS = 100;
+const int BENCHMARK_BLOCK_SIZE = 256;
+
+// execution benchmark size
+const UINT32 BENCHMARK_ITERATIONS = 1000000;
+const UINT32 BENCHMARK_LOOP_SIZE = 18;
+
+// marks a result that the known-results table doesn't check
+const UINT64 UNDEFINED = U64(0xcccccccccccccccc);
+
+
+
+//**************************************************************************
+//  KNOWN RESULTS
+//**************************************************************************
+
+// structure describing a test with a known answer
+struct bevalidate_test
+{
+	opcode_t                opcode;
+	UINT8                   size;
+	UINT8                   iflags;
+	UINT8                   flags;
+	UINT64                  param[4];
+};
+
+#define TEST_ENTRY_2(op, size, p1, p2, flags) { OP_##op, size, 0, flags, { p1, p2 } },
+#define TEST_ENTRY_2F(op, size, p1, p2, iflags, flags) { OP_##op, size, iflags, flags, { p1, p2 } },
+#define TEST_ENTRY_3(op, size, p1, p2, p3, flags) { OP_##op, size, 0, flags, { p1, p2, p3 } },
+#define TEST_ENTRY_3F(op, size, p1, p2, p3, iflags, flags) { OP_##op, size, iflags, flags, { p1, p2, p3 } },
+#define TEST_ENTRY_4(op, size, p1, p2, p3, p4, flags) { OP_##op, size, 0, flags, { p1, p2, p3, p4 } },
+#define TEST_ENTRY_4F(op, size, p1, p2, p3, p4, iflags, flags) { OP_##op, size, iflags, flags, { p1, p2, p3, p4 } },
+
+static const bevalidate_test bevalidate_test_list[] =
+{
+	TEST_ENTRY_3(ADD, 4, 0x7fffffff, 0x12345678, 0x6dcba987, 0)
+	TEST_ENTRY_3(ADD, 4, 0x80000000, 0x12345678, 0x6dcba988, FLAG_V | FLAG_S)
+	TEST_ENTRY_3(ADD, 4, 0xffffffff, 0x92345678, 0x6dcba987, FLAG_S)
+	TEST_ENTRY_3(ADD, 4, 0x00000000, 0x92345678, 0x6dcba988, FLAG_C | FLAG_Z)
+
+	TEST_ENTRY_3(ADD, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba9876543210, 0)
+	TEST_ENTRY_3(ADD, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543211, FLAG_V | FLAG_S)
+	TEST_ENTRY_3(ADD, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba9876543210, FLAG_S)
+	TEST_ENTRY_3(ADD, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543211, FLAG_C | FLAG_Z)
+
+	TEST_ENTRY_3F(ADDC, 4, 0x7fffffff, 0x12345678, 0x6dcba987, 0,      0)
+	TEST_ENTRY_3F(ADDC, 4, 0x7fffffff, 0x12345678, 0x6dcba986, FLAG_C, 0)
+	TEST_ENTRY_3F(ADDC, 4, 0x80000000, 0x12345678, 0x6dcba988, 0,      FLAG_V | FLAG_S)
+	TEST_ENTRY_3F(ADDC, 4, 0x80000000, 0x12345678, 0x6dcba987, FLAG_C, FLAG_V | FLAG_S)
+	TEST_ENTRY_3F(ADDC, 4, 0xffffffff, 0x92345678, 0x6dcba987, 0,      FLAG_S)
+	TEST_ENTRY_3F(ADDC, 4, 0xffffffff, 0x92345678, 0x6dcba986, FLAG_C, FLAG_S)
+	TEST_ENTRY_3F(ADDC, 4, 0x00000000, 0x92345678, 0x6dcba988, 0,      FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ADDC, 4, 0x00000000, 0x92345678, 0x6dcba987, FLAG_C, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ADDC, 4, 0x12345678, 0x12345678, 0xffffffff, FLAG_C, FLAG_C)
+
+	TEST_ENTRY_3F(ADDC, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba9876543210, 0,      0)
+	TEST_ENTRY_3F(ADDC, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba987654320f, FLAG_C, 0)
+	TEST_ENTRY_3F(ADDC, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543211, 0,      FLAG_V | FLAG_S)
+	TEST_ENTRY_3F(ADDC, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543210, FLAG_C, FLAG_V | FLAG_S)
+	TEST_ENTRY_3F(ADDC, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba9876543210, 0,      FLAG_S)
+	TEST_ENTRY_3F(ADDC, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba987654320f, FLAG_C, FLAG_S)
+	TEST_ENTRY_3F(ADDC, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543211, 0,      FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ADDC, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543210, FLAG_C, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ADDC, 8, 0x123456789abcdef0, 0x123456789abcdef0, 0xffffffffffffffff, FLAG_C, FLAG_C)
+
+	TEST_ENTRY_3(SUB, 4, 0x12345678, 0x7fffffff, 0x6dcba987, 0)
+	TEST_ENTRY_3(SUB, 4, 0x12345678, 0x80000000, 0x6dcba988, FLAG_V)
+	TEST_ENTRY_3(SUB, 4, 0x92345678, 0xffffffff, 0x6dcba987, FLAG_S)
+	TEST_ENTRY_3(SUB, 4, 0x92345678, 0x00000000, 0x6dcba988, FLAG_C | FLAG_S)
+	TEST_ENTRY_3(SUB, 4, 0x00000000, 0x12345678, 0x12345678, FLAG_Z)
+
+	TEST_ENTRY_3(SUB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba9876543210, 0)
+	TEST_ENTRY_3(SUB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543211, FLAG_V)
+	TEST_ENTRY_3(SUB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba9876543210, FLAG_S)
+	TEST_ENTRY_3(SUB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543211, FLAG_C | FLAG_S)
+	TEST_ENTRY_3(SUB, 8, 0x0000000000000000, 0x0123456789abcdef, 0x0123456789abcdef, FLAG_Z)
+
+	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x7fffffff, 0x6dcba987, 0,      0)
+	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x7fffffff, 0x6dcba986, FLAG_C, 0)
+	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x80000000, 0x6dcba988, 0,      FLAG_V)
+	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x80000000, 0x6dcba987, FLAG_C, FLAG_V)
+	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0xffffffff, 0x6dcba987, 0,      FLAG_S)
+	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0xffffffff, 0x6dcba986, FLAG_C, FLAG_S)
+	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0x00000000, 0x6dcba988, 0,      FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0x00000000, 0x6dcba987, FLAG_C, FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x12345678, 0xffffffff, FLAG_C, FLAG_C)
+	TEST_ENTRY_3F(SUBB, 4, 0x00000000, 0x12345678, 0x12345677, FLAG_C, FLAG_Z)
+
+	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba9876543210, 0,      0)
+	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba987654320f, FLAG_C, 0)
+	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543211, 0,      FLAG_V)
+	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543210, FLAG_C, FLAG_V)
+	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba9876543210, 0,      FLAG_S)
+	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba987654320f, FLAG_C, FLAG_S)
+	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543211, 0,      FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543210, FLAG_C, FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(SUBB, 8, 0x123456789abcdef0, 0x123456789abcdef0, 0xffffffffffffffff, FLAG_C, FLAG_C)
+	TEST_ENTRY_3F(SUBB, 8, 0x0000000000000000, 0x123456789abcdef0, 0x123456789abcdeef, FLAG_C, FLAG_Z)
+
+	TEST_ENTRY_2(CMP, 4, 0x7fffffff, 0x6dcba987, 0)
+	TEST_ENTRY_2(CMP, 4, 0x80000000, 0x6dcba988, FLAG_V)
+	TEST_ENTRY_2(CMP, 4, 0xffffffff, 0x6dcba987, FLAG_S)
+	TEST_ENTRY_2(CMP, 4, 0x00000000, 0x6dcba988, FLAG_C | FLAG_S)
+	TEST_ENTRY_2(CMP, 4, 0x12345678, 0x12345678, FLAG_Z)
+
+	TEST_ENTRY_2(CMP, 8, 0x7fffffffffffffff, 0x7edcba9876543210, 0)
+	TEST_ENTRY_2(CMP, 8, 0x8000000000000000, 0x7edcba9876543211, FLAG_V)
+	TEST_ENTRY_2(CMP, 8, 0xffffffffffffffff, 0x7edcba9876543210, FLAG_S)
+	TEST_ENTRY_2(CMP, 8, 0x0000000000000000, 0x7edcba9876543211, FLAG_C | FLAG_S)
+	TEST_ENTRY_2(CMP, 8, 0x0123456789abcdef, 0x0123456789abcdef, FLAG_Z)
+
+	TEST_ENTRY_4(MULU, 4, 0x77777777, 0x00000000, 0x11111111, 0x00000007, 0)
+	TEST_ENTRY_4(MULU, 4, 0xffffffff, 0x00000000, 0x11111111, 0x0000000f, 0)
+	TEST_ENTRY_4(MULU, 4, 0x00000000, 0x00000000, 0x11111111, 0x00000000, FLAG_Z)
+	TEST_ENTRY_4(MULU, 4, 0xea61d951, 0x37c048d0, 0x77777777, 0x77777777, FLAG_V)
+	TEST_ENTRY_4(MULU, 4, 0x32323233, 0xcdcdcdcc, 0xcdcdcdcd, 0xffffffff, FLAG_V | FLAG_S)
+
+	TEST_ENTRY_4(MULU, 8, 0x7777777777777777, 0x0000000000000000, 0x1111111111111111, 0x0000000000000007, 0)
+	TEST_ENTRY_4(MULU, 8, 0xffffffffffffffff, 0x0000000000000000, 0x1111111111111111, 0x000000000000000f, 0)
+	TEST_ENTRY_4(MULU, 8, 0x0000000000000000, 0x0000000000000000, 0x1111111111111111, 0x0000000000000000, FLAG_Z)
+	TEST_ENTRY_4(MULU, 8, 0x0c83fb72ea61d951, 0x37c048d159e26af3, 0x7777777777777777, 0x7777777777777777, FLAG_V)
+	TEST_ENTRY_4(MULU, 8, 0x3232323232323233, 0xcdcdcdcdcdcdcdcc, 0xcdcdcdcdcdcdcdcd, 0xffffffffffffffff, FLAG_V | FLAG_S)
+
+	TEST_ENTRY_4(MULS, 4, 0x77777777, 0x00000000, 0x11111111, 0x00000007, 0)
+	TEST_ENTRY_4(MULS, 4, 0xffffffff, 0x00000000, 0x11111111, 0x0000000f, FLAG_V)
+	TEST_ENTRY_4(MULS, 4, 0x00000000, 0x00000000, 0x11111111, 0x00000000, FLAG_Z)
+	TEST_ENTRY_4(MULS, 4, 0x9e26af38, 0xc83fb72e, 0x77777777, 0x88888888, FLAG_V | FLAG_S)
+	TEST_ENTRY_4(MULS, 4, 0x32323233, 0x00000000, 0xcdcdcdcd, 0xffffffff, 0)
+
+	TEST_ENTRY_4(MULS, 8, 0x7777777777777777, 0x0000000000000000, 0x1111111111111111, 0x0000000000000007, 0)
+	TEST_ENTRY_4(MULS, 8, 0xffffffffffffffff, 0x0000000000000000, 0x1111111111111111, 0x000000000000000f, FLAG_V)
+	TEST_ENTRY_4(MULS, 8, 0x0000000000000000, 0x0000000000000000, 0x1111111111111111, 0x0000000000000000, FLAG_Z)
+	TEST_ENTRY_4(MULS, 8, 0x7c048d159e26af38, 0xc83fb72ea61d950c, 0x7777777777777777, 0x8888888888888888, FLAG_V | FLAG_S)
+	TEST_ENTRY_4(MULS, 8, 0x3232323232323233, 0x0000000000000000, 0xcdcdcdcdcdcdcdcd, 0xffffffffffffffff, 0)
+
+	TEST_ENTRY_4(DIVU, 4, 0x02702702, 0x00000003, 0x11111111, 0x00000007, 0)
+	TEST_ENTRY_4(DIVU, 4, 0x00000000, 0x11111111, 0x11111111, 0x11111112, FLAG_Z)
+	TEST_ENTRY_4(DIVU, 4, 0x7fffffff, 0x00000000, 0xfffffffe, 0x00000002, 0)
+	TEST_ENTRY_4(DIVU, 4, 0xfffffffe, 0x00000000, 0xfffffffe, 0x00000001, FLAG_S)
+	TEST_ENTRY_4(DIVU, 4, UNDEFINED,  UNDEFINED,  0xffffffff, 0x00000000, FLAG_V)
+
+	TEST_ENTRY_4(DIVU, 8, 0x0270270270270270, 0x0000000000000001, 0x1111111111111111, 0x0000000000000007, 0)
+	TEST_ENTRY_4(DIVU, 8, 0x0000000000000000, 0x1111111111111111, 0x1111111111111111, 0x1111111111111112, FLAG_Z)
+	TEST_ENTRY_4(DIVU, 8, 0x7fffffffffffffff, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000002, 0)
+	TEST_ENTRY_4(DIVU, 8, 0xfffffffffffffffe, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000001, FLAG_S)
+	TEST_ENTRY_4(DIVU, 8, UNDEFINED,          UNDEFINED,          0xffffffffffffffff, 0x0000000000000000, FLAG_V)
+
+	TEST_ENTRY_4(DIVS, 4, 0x02702702, 0x00000003, 0x11111111, 0x00000007, 0)
+	TEST_ENTRY_4(DIVS, 4, 0x00000000, 0x11111111, 0x11111111, 0x11111112, FLAG_Z)
+	TEST_ENTRY_4(DIVS, 4, 0xffffffff, 0x00000000, 0xfffffffe, 0x00000002, FLAG_S)
+	TEST_ENTRY_4(DIVS, 4, UNDEFINED,  UNDEFINED,  0xffffffff, 0x00000000, FLAG_V)
+
+	TEST_ENTRY_4(DIVS, 8, 0x0270270270270270, 0x0000000000000001, 0x1111111111111111, 0x0000000000000007, 0)
+	TEST_ENTRY_4(DIVS, 8, 0x0000000000000000, 0x1111111111111111, 0x1111111111111111, 0x1111111111111112, FLAG_Z)
+	TEST_ENTRY_4(DIVS, 8, 0xffffffffffffffff, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000002, FLAG_S)
+	TEST_ENTRY_4(DIVS, 8, UNDEFINED,          UNDEFINED,          0xffffffffffffffff, 0x0000000000000000, FLAG_V)
+
+	// a shift or rotate count of zero, after masking to the size, changes no flags
+	TEST_ENTRY_3F(SHL, 4, 0x2468acf0, 0x12345678, 1,  FLAG_C | FLAG_Z, 0)
+	TEST_ENTRY_3F(SHL, 4, 0x12345678, 0x12345678, 0,  FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(SHL, 4, 0x12345678, 0x12345678, 32, FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(SHL, 8, 0x0123456789abcdef, 0x0123456789abcdef, 64, FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(SHR, 4, 0x12345678, 0x12345678, 0,  FLAG_S, FLAG_S)
+	TEST_ENTRY_3F(SHR, 8, 0x0123456789abcdef, 0x0123456789abcdef, 0, FLAG_C | FLAG_S, FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(SAR, 4, 0x81234567, 0x81234567, 32, FLAG_Z, FLAG_Z)
+	TEST_ENTRY_3F(SAR, 8, 0x8123456789abcdef, 0x8123456789abcdef, 0, FLAG_C, FLAG_C)
+	TEST_ENTRY_3F(ROL, 4, 0x12345678, 0x12345678, 32, FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ROL, 8, 0x0123456789abcdef, 0x0123456789abcdef, 0, FLAG_S, FLAG_S)
+	TEST_ENTRY_3F(ROR, 4, 0x81234567, 0x12345678, 4,  FLAG_Z, FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(ROR, 4, 0x12345678, 0x12345678, 0,  FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ROR, 8, 0x0123456789abcdef, 0x0123456789abcdef, 64, FLAG_Z, FLAG_Z)
+	TEST_ENTRY_3F(ROLC, 4, 0x2468acf1, 0x12345678, 1, FLAG_C | FLAG_Z, 0)
+	TEST_ENTRY_3F(ROLC, 4, 0x12345678, 0x12345678, 0, FLAG_C | FLAG_Z, FLAG_C | FLAG_Z)
+	TEST_ENTRY_3F(ROLC, 8, 0x0123456789abcdef, 0x0123456789abcdef, 64, FLAG_C, FLAG_C)
+	TEST_ENTRY_3F(RORC, 4, 0x12345678, 0x12345678, 32, FLAG_C | FLAG_S, FLAG_C | FLAG_S)
+	TEST_ENTRY_3F(RORC, 8, 0x0123456789abcdef, 0x0123456789abcdef, 0, FLAG_Z, FLAG_Z)
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  size_mask - return a mask covering a value of
+//  the given size in bytes
+//-------------------------------------------------
+
+static inline UINT64 size_mask(int size)
+{
+	return (size >= 8) ? ~U64(0) : ((U64(1) << (size * 8)) - 1);
+}
+
+
+//-------------------------------------------------
+//  is_nan - return true if the low bits of a
+//  value hold a single or double precision NaN
+//-------------------------------------------------
+
+static inline bool is_nan(UINT64 bits, int size)
+{
+	if (size == 4)
+		return ((bits >> 23) & 0xff) == 0xff && (bits & 0x7fffff) != 0;
+	if (size == 8)
+		return ((bits >> 52) & 0x7ff) == 0x7ff && (bits & U64(0xfffffffffffff)) != 0;
+	return false;
+}
+
+
+//-------------------------------------------------
+//  flags_string - describe a set of flags
+//-------------------------------------------------
+
+static std::string flags_string(UINT8 flags)
+{
+	return string_format("%c%c%c%c%c",
+		(flags & FLAG_U) ? 'U' : '.',
+		(flags & FLAG_S) ? 'S' : '.',
+		(flags & FLAG_Z) ? 'Z' : '.',
+		(flags & FLAG_V) ? 'V' : '.',
+		(flags & FLAG_C) ? 'C' : '.');
+}
+
+
+//-------------------------------------------------
+//  bytes_string - describe eight bytes of the
+//  RAM window
+//-------------------------------------------------
+
+static std::string bytes_string(const UINT8 *data)
+{
+	return string_format("%02X %02X %02X %02X %02X %02X %02X %02X",
+		data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7]);
+}
+
+
+//-------------------------------------------------
+//  opcode_name - return the name of an opcode at
+//  the given size, as the disassembler shows it
+//-------------------------------------------------
+
+static std::string opcode_name(const opcode_info &opinfo, UINT8 size)
+{
+	std::string name;
+	for (const char *src = opinfo.mnemonic; *src != 0; src++)
+		if (*src == '!')
+			name.append((size == 8) ? "d" : "");
+		else if (*src == '#')
+			name.append((size == 8) ? "d" : "s");
+		else
+			name.append(1, *src);
+	return name;
+}
+
+
+//-------------------------------------------------
+//  fixed_parameters - fill in the parameters
+//  that aren't operands for one variant of an
+//  opcode; returns false past the last variant
+//-------------------------------------------------
+
+static bool fixed_parameters(opcode_t opcode, UINT8 size, int variant, parameter *fixed)
+{
+	static const float_rounding_mode roundings[] = { ROUND_TRUNC, ROUND_ROUND, ROUND_CEIL, ROUND_FLOOR };
+
+	switch (opcode)
+	{
+		// each access size up to the operation size, at each scale; the
+		// base pointer is filled in per back-end
+		case OP_LOAD:
+		case OP_LOADS:
+		case OP_STORE:
+		{
+			int accsize = SIZE_BYTE + variant / 4;
+			if (accsize > ((size == 4) ? SIZE_DWORD : SIZE_QWORD))
+				return false;
+			fixed[(opcode == OP_STORE) ? 0 : 1] = mem(nullptr);
+			fixed[3] = parameter(operand_size(accsize), memory_scale(SCALE_x1 + variant % 4));
+			return true;
+		}
+
+		case OP_FLOAD:
+		case OP_FSTORE:
+			fixed[(opcode == OP_FSTORE) ? 0 : 1] = mem(nullptr);
+			return (variant == 0);
+
+		// each access size up to the operation size, in the program space;
+		// masked accesses start at words, as the back-ends have no byte form
+		case OP_READ:
+		case OP_WRITE:
+		case OP_READM:
+		case OP_WRITEM:
+		{
+			int accsize = ((opcode == OP_READM || opcode == OP_WRITEM) ? SIZE_WORD : SIZE_BYTE) + variant;
+			if (accsize > ((size == 4) ? SIZE_DWORD : SIZE_QWORD))
+				return false;
+			fixed[(opcode == OP_READM || opcode == OP_WRITEM) ? 3 : 2] = parameter(operand_size(accsize), SPACE_PROGRAM);
+			return true;
+		}
+
+		case OP_FREAD:
+		case OP_FWRITE:
+			fixed[2] = parameter((size == 4) ? SIZE_DWORD : SIZE_QWORD, SPACE_PROGRAM);
+			return (variant == 0);
+
+		// each source size
+		case OP_SEXT:
+			if (variant > ((size == 4) ? 1 : 2))
+				return false;
+			fixed[2] = parameter::make_size(operand_size(SIZE_BYTE + variant));
+			return true;
+
+		// each integer size, with each explicit rounding mode; the C
+		// back-end ignores ROUND_DEFAULT, so it can't be compared
+		case OP_FTOINT:
+			if (variant >= 2 * int(ARRAY_LENGTH(roundings)))
+				return false;
+			fixed[2] = parameter::make_size((variant & 1) ? SIZE_QWORD : SIZE_DWORD);
+			fixed[3] = parameter::make_rounding(roundings[variant / 2]);
+			return true;
+
+		case OP_FFRINT:
+			if (variant >= 2)
+				return false;
+			fixed[2] = parameter::make_size((variant & 1) ? SIZE_QWORD : SIZE_DWORD);
+			return true;
+
+		// the other floating point size
+		case OP_FFRFLT:
+			fixed[2] = parameter::make_size((size == 4) ? SIZE_QWORD : SIZE_DWORD);
+			return (variant == 0);
+
+		default:
+			return (variant == 0);
+	}
+}
+
+
+
+//**************************************************************************
+//  BACK-END STATE
+//**************************************************************************
+
+//-------------------------------------------------
+//  backend - constructor
+//-------------------------------------------------
+
+drcbe_validator::backend::backend(device_t &device, drcbe_type type, const char *bename)
+	: name(bename),
+		cache(VALIDATE_CACHE_SIZE),
+		drcuml(device, cache, 0, 1, 16, 0, type),
+		entry(drcuml.handle_alloc("validate_entry")),
+		istate((drcuml_machine_state *)cache.alloc_near(sizeof(*istate))),
+		fstate((drcuml_machine_state *)cache.alloc_near(sizeof(*fstate))),
+		memory((UINT64 *)cache.alloc_near(sizeof(*memory) * MEMORY_SLOTS)),
+		buffer((UINT64 *)cache.alloc_near(sizeof(*buffer) * BUFFER_ENTRIES)),
+		flags((UINT32 *)cache.alloc_near(sizeof(*flags)))
+{
+	memset(window, 0, sizeof(window));
+}
+
+
+
+//**************************************************************************
+//  BACK-END VALIDATOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_validator - constructor
+//-------------------------------------------------
+
+drcbe_validator::drcbe_validator(device_t &device)
+	: m_c(std::make_unique<backend>(device, DRCBE_C, "C")),
+		m_native(std::make_unique<backend>(device, DRCBE_NATIVE, "native")),
+		m_space(nullptr),
+		m_window(0),
+		m_seed(U64(0x9e3779b97f4a7c15)),
+		m_tests(0),
+		m_reported(0)
+{
+	find_window(device);
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_validator - destructor
+//-------------------------------------------------
+
+drcbe_validator::~drcbe_validator()
+{
+	// put back whatever the tests overwrote
+	if (m_space != nullptr)
+		fill_window(m_saved);
+}
+
+
+//-------------------------------------------------
+//  check_known_results - run the table of tests
+//  with known answers on each back-end
+//-------------------------------------------------
+
+int drcbe_validator::check_known_results()
+{
+	int failures = 0;
+	m_report.append("Checking known results...\n");
+	m_reported = 0;
+
+	for (const bevalidate_test &entry : bevalidate_test_list)
+	{
+		const opcode_info &opinfo = instruction::s_opcode_info_table[entry.opcode];
+
+		// every operand in a register, every flag requested
+		test_case test = test_case();
+		test.opcode = entry.opcode;
+		test.size = entry.size;
+		test.condition = COND_ALWAYS;
+		fixed_parameters(test.opcode, test.size, 0, test.fixed);
+		setup_operands(test);
+		for (int pnum = 0; pnum < test.numparams; pnum++)
+			test.operand[pnum].kind = KIND_REGISTER;
+		test.flags = test.checkflags = opinfo.outflags;
+
+		// start from a random state, then load the inputs from the table
+		choose_values(test);
+		test.state.flags = entry.iflags;
+		for (int pnum = 0; pnum < test.numparams; pnum++)
+			if (!test.operand[pnum].output)
+			{
+				test.operand[pnum].value = entry.param[pnum] & size_mask(test.operand[pnum].size);
+				store_value(test, pnum);
+			}
+
+		// each back-end must match the table
+		for (backend *be : { m_c.get(), m_native.get() })
+		{
+			execute(*be, test);
+			m_tests++;
+
+			std::string errors;
+			for (int pnum = 0; pnum < test.numparams; pnum++)
+				if (test.operand[pnum].output && entry.param[pnum] != UNDEFINED)
+				{
+					UINT64 mask = size_mask(test.operand[pnum].size);
+					UINT64 result = be->fstate->r[1 + pnum].d & mask;
+					if (result != (entry.param[pnum] & mask))
+						errors.append(string_format("  i%d: %016X, expected %016X\n", 1 + pnum, result, entry.param[pnum] & mask));
+				}
+			if (((*be->flags ^ entry.flags) & opinfo.outflags) != 0)
+				errors.append(string_format("  flags: %s, expected %s\n", flags_string(*be->flags & opinfo.outflags), flags_string(entry.flags)));
+
+			if (!errors.empty())
+			{
+				report_failure(*be, test, errors);
+				failures++;
+			}
+		}
+	}
+
+	m_report.append(string_format("%d known results, %d failures\n", int(ARRAY_LENGTH(bevalidate_test_list)), failures));
+	return failures;
+}
+
+
+//-------------------------------------------------
+//  check_conformance - compare the back-ends on
+//  every opcode, size and operand encoding
+//-------------------------------------------------
+
+int drcbe_validator::check_conformance()
+{
+	int failures = 0;
+	m_report.append("Comparing the C and native back-ends...\n");
+
+	for (int opnum = OP_LOAD; opnum <= OP_ICOPYF; opnum++)
+	{
+		opcode_t opcode = opcode_t(opnum);
+		if (!testable(opcode))
+			continue;
+		const opcode_info &opinfo = instruction::s_opcode_info_table[opcode];
+
+		for (UINT8 size = 4; size <= 8; size *= 2)
+		{
+			if ((opinfo.sizes & size) == 0)
+				continue;
+
+			UINT32 starttests = m_tests;
+			int opfailures = 0;
+			m_reported = 0;
+
+			for (int variant = 0; ; variant++)
+			{
+				test_case test = test_case();
+				test.opcode = opcode;
+				test.size = size;
+				test.condition = COND_ALWAYS;
+				if (!fixed_parameters(opcode, size, variant, test.fixed))
+					break;
+				setup_operands(test);
+
+				// every combination of encodings, with every flag combination
+				// tried when all the operands are in registers
+				int combos = 1;
+				for (int pnum = 0; pnum < test.numparams; pnum++)
+					if (test.operand[pnum].used)
+						combos *= KIND_COUNT;
+				for (int combo = 0; combo < combos; combo++)
+					if (assign_kinds(test, combo))
+					{
+						bool allregs = true;
+						for (int pnum = 0; pnum < test.numparams; pnum++)
+							if (test.operand[pnum].used && test.operand[pnum].kind != KIND_REGISTER)
+								allregs = false;
+						opfailures += run_encoding(test, allregs);
+					}
+			}
+
+			if (UINT32(opfailures) > MAX_REPORTED_FAILURES)
+				m_report.append(string_format("  ... and %d more\n", opfailures - MAX_REPORTED_FAILURES));
+			m_report.append(string_format("%-10s %5d tests, %d failures\n", opcode_name(opinfo, size), m_tests - starttests, opfailures));
+			failures += opfailures;
+		}
+	}
+
+	m_report.append(string_format("%u tests run, %d failures\n", m_tests, failures));
+	return failures;
+}
+
+
+//-------------------------------------------------
+//  benchmark - measure compilation speed and
+//  execution throughput of each back-end
+//-------------------------------------------------
+
+void drcbe_validator::benchmark()
+{
+	m_report.append("Benchmarking...\n");
+	for (backend *be : { m_c.get(), m_native.get() })
+	{
+		benchmark_compile(*be);
+		benchmark_execute(*be);
+	}
+}
+
+
+//-------------------------------------------------
+//  find_window - look for plain RAM in the
+//  device's program space to aim the memory
+//  space accesses at
+//-------------------------------------------------
+
+void drcbe_validator::find_window(device_t &device)
+{
+	device_memory_interface *memory;
+	if (!device.interface(memory) || !memory->has_space(AS_PROGRAM))
+		return;
+	address_space &space = memory->space(AS_PROGRAM);
+
+	for (address_map_entry &entry : space.map()->m_entrylist)
+		if (entry.m_read.m_type == AMH_RAM && entry.m_write.m_type == AMH_RAM)
+		{
+			offs_t start = (space.address_to_byte(entry.m_addrstart) + 7) & ~7;
+			offs_t end = space.address_to_byte_end(entry.m_addrend);
+			if (start > end || end - start < WINDOW_BYTES - 1)
+				continue;
+
+			m_space = &space;
+			m_window = start;
+			snapshot_window(m_saved);
+			m_report.append(string_format("Using %s space RAM at %X for memory accesses\n", space.name(), m_window));
+			return;
+		}
+	m_report.append("No program space RAM found; memory accesses won't be tested\n");
+}
+
+
+//-------------------------------------------------
+//  fill_window - write the RAM window
+//-------------------------------------------------
+
+void drcbe_validator::fill_window(const UINT8 *data)
+{
+	for (int offset = 0; offset < WINDOW_BYTES; offset++)
+		m_space->write_byte(m_window + offset, data[offset]);
+}
+
+
+//-------------------------------------------------
+//  snapshot_window - read back the RAM window
+//-------------------------------------------------
+
+void drcbe_validator::snapshot_window(UINT8 *data)
+{
+	for (int offset = 0; offset < WINDOW_BYTES; offset++)
+		data[offset] = m_space->read_byte(m_window + offset);
+}
+
+
+//-------------------------------------------------
+//  testable - return true if an opcode can be
+//  compared between back-ends
+//-------------------------------------------------
+
+bool drcbe_validator::testable(opcode_t opcode) const
+{
+	// memory space accesses need RAM to aim at
+	switch (opcode)
+	{
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+		case OP_FREAD:
+		case OP_FWRITE:
+			return (m_space != nullptr);
+
+		default:
+			return (opcode >= OP_LOAD && opcode <= OP_ICOPYF);
+	}
+}
+
+
+//-------------------------------------------------
+//  setup_operands - work out which parameters of
+//  a test are operands and how they may be
+//  encoded
+//-------------------------------------------------
+
+void drcbe_validator::setup_operands(test_case &test) const
+{
+	const opcode_info &opinfo = instruction::s_opcode_info_table[test.opcode];
+	const UINT16 regmask = (1 << parameter::PTYPE_INT_REGISTER) | (1 << parameter::PTYPE_FLOAT_REGISTER);
+
+	// anything that can be a register is an operand
+	test.numparams = 0;
+	test.first = -1;
+	for (int pnum = 0; pnum < int(ARRAY_LENGTH(opinfo.param)) && opinfo.param[pnum].typemask != 0; pnum++)
+	{
+		test_operand &op = test.operand[pnum];
+		op = test_operand();
+		op.used = (opinfo.param[pnum].typemask & regmask) != 0;
+		op.isfloat = (opinfo.param[pnum].typemask & (1 << parameter::PTYPE_FLOAT_REGISTER)) != 0;
+		if (op.used && test.first == -1)
+			test.first = pnum;
+		test.numparams = pnum + 1;
+	}
+
+	// let a placeholder instruction answer the rest
+	instruction probe;
+	build(nullptr, test, probe);
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+	{
+		test_operand &op = test.operand[pnum];
+		if (!op.used)
+			continue;
+
+		op.input = probe.param_is_input(pnum);
+		op.output = probe.param_is_output(pnum);
+
+		// FRNDS reads a double despite its size depending on a missing parameter
+		op.size = (test.opcode == OP_FRNDS && pnum == 1) ? 8 : probe.param_size(pnum);
+
+		op.typemask = 1 << (op.isfloat ? parameter::PTYPE_FLOAT_REGISTER : parameter::PTYPE_INT_REGISTER);
+		if (op.input && !op.output && probe.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+			op.typemask |= 1 << parameter::PTYPE_IMMEDIATE;
+		if (probe.param_allows(pnum, parameter::PTYPE_MEMORY))
+			op.typemask |= 1 << parameter::PTYPE_MEMORY;
+
+		// indexes, divisors and rotate-through-carry counts get special values
+		switch (test.opcode)
+		{
+			case OP_LOAD:
+			case OP_LOADS:
+			case OP_FLOAD:
+				op.constrained = (pnum == 2);
+				break;
+
+			case OP_STORE:
+			case OP_FSTORE:
+				op.constrained = (pnum == 1);
+				break;
+
+			case OP_DIVU:
+			case OP_DIVS:
+				op.constrained = (pnum == 3);
+				break;
+
+			case OP_SHL:
+			case OP_SHR:
+			case OP_SAR:
+			case OP_ROL:
+			case OP_ROR:
+			case OP_ROLC:
+			case OP_RORC:
+				op.constrained = (pnum == 2);
+				break;
+
+			case OP_READ:
+			case OP_READM:
+			case OP_FREAD:
+				op.constrained = (pnum == 1);
+				break;
+
+			case OP_WRITE:
+			case OP_WRITEM:
+			case OP_FWRITE:
+				op.constrained = (pnum == 0);
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  assign_kinds - decode a combination number
+//  into operand encodings; returns false if the
+//  combination isn't allowed
+//-------------------------------------------------
+
+bool drcbe_validator::assign_kinds(test_case &test, int combo) const
+{
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+	{
+		test_operand &op = test.operand[pnum];
+		if (!op.used)
+			continue;
+		op.kind = combo % KIND_COUNT;
+		combo /= KIND_COUNT;
+
+		switch (op.kind)
+		{
+			case KIND_IMMEDIATE:
+				if ((op.typemask & (1 << parameter::PTYPE_IMMEDIATE)) == 0)
+					return false;
+				break;
+
+			case KIND_MEMORY:
+				if ((op.typemask & (1 << parameter::PTYPE_MEMORY)) == 0)
+					return false;
+				break;
+
+			// aliasing the first operand needs a compatible location
+			case KIND_SAME_AS_FIRST:
+			{
+				if (pnum == test.first || op.constrained)
+					return false;
+				const test_operand &first = test.operand[test.first];
+				if (first.kind == KIND_IMMEDIATE || first.constrained || first.isfloat != op.isfloat)
+					return false;
+				if (first.kind == KIND_MEMORY && (op.typemask & (1 << parameter::PTYPE_MEMORY)) == 0)
+					return false;
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  choose_values - pick a random initial state
+//  and operand values for a test
+//-------------------------------------------------
+
+void drcbe_validator::choose_values(test_case &test)
+{
+	// random registers and memory; V and U can't both be set by real code
+	for (auto &reg : test.state.r)
+		reg.d = random();
+	for (auto &reg : test.state.f)
+		*(UINT64 *)&reg.d = random();
+	for (auto &value : test.memory)
+		value = random();
+	for (auto &value : test.buffer)
+		value = random();
+	for (auto &value : test.window)
+		value = random();
+	test.state.exp = 0;
+	test.state.fmod = ROUND_ROUND;
+	test.state.flags = random() & (FLAG_U | FLAG_S | FLAG_Z | FLAG_V | FLAG_C);
+	if ((test.state.flags & (FLAG_U | FLAG_V)) == (FLAG_U | FLAG_V))
+		test.state.flags &= ~FLAG_U;
+
+	// random operand values
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+	{
+		test_operand &op = test.operand[pnum];
+		if (!op.used)
+			continue;
+		op.value = op.isfloat ? random_float(op.size) : random_int(op.size);
+
+		if (op.constrained)
+			switch (test.opcode)
+			{
+				// keep within the buffer
+				case OP_LOAD:
+				case OP_LOADS:
+				case OP_STORE:
+				case OP_FLOAD:
+				case OP_FSTORE:
+					op.value = random() & 3;
+					break;
+
+				// an aligned address within the RAM window
+				case OP_READ:
+				case OP_READM:
+				case OP_WRITE:
+				case OP_WRITEM:
+				case OP_FREAD:
+				case OP_FWRITE:
+				{
+					UINT32 bytes = 1 << test.fixed[test.numparams - 1].size();
+					op.value = m_window + ((random() % WINDOW_BYTES) & ~(bytes - 1));
+					break;
+				}
+
+				// no division by zero, and no overflowing signed division
+				case OP_DIVU:
+				case OP_DIVS:
+					if (op.value == 0 || (test.opcode == OP_DIVS && op.value == size_mask(op.size)))
+						op.value = 3;
+					break;
+
+				// shift and rotate counts of zero must leave the flags alone,
+				// so try one often, with the bits above the count left random
+				default:
+					if ((random() & 3) == 0)
+						op.value &= ~(UINT64)(test.size * 8 - 1);
+					break;
+			}
+	}
+
+	// write them into their locations
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+		if (test.operand[pnum].used)
+			store_value(test, pnum);
+}
+
+
+//-------------------------------------------------
+//  store_value - write an operand's initial value
+//  into the register or memory that holds it
+//-------------------------------------------------
+
+void drcbe_validator::store_value(test_case &test, int pnum) const
+{
+	const test_operand &op = test.operand[pnum];
+	if (op.kind == KIND_IMMEDIATE || op.kind == KIND_SAME_AS_FIRST)
+		return;
+
+	UINT64 *dest = location(test, pnum);
+	if (op.kind == KIND_MEMORY)
+	{
+		switch (op.size)
+		{
+			case 1:     *(UINT8 *)dest = op.value;     break;
+			case 2:     *(UINT16 *)dest = op.value;    break;
+			case 4:     *(UINT32 *)dest = op.value;    break;
+			default:    *dest = op.value;               break;
+		}
+	}
+	else
+	{
+		UINT64 mask = size_mask(op.size);
+		*dest = (*dest & ~mask) | (op.value & mask);
+	}
+}
+
+
+//-------------------------------------------------
+//  location - return the register or memory slot
+//  in a test's initial state that holds an
+//  operand
+//-------------------------------------------------
+
+UINT64 *drcbe_validator::location(test_case &test, int pnum) const
+{
+	int slot = pnum;
+	int kind = test.operand[pnum].kind;
+	if (kind == KIND_SAME_AS_FIRST)
+	{
+		slot = test.first;
+		kind = test.operand[slot].kind;
+	}
+
+	bool isfloat = test.operand[pnum].isfloat;
+	switch (kind)
+	{
+		case KIND_REGISTER:         return isfloat ? (UINT64 *)&test.state.f[1 + slot].d : &test.state.r[1 + slot].d;
+		case KIND_REGISTER_HIGH:    return isfloat ? (UINT64 *)&test.state.f[9 - slot].d : &test.state.r[9 - slot].d;
+		case KIND_MEMORY:           return &test.memory[slot];
+		default:                    return nullptr;
+	}
+}
+
+
+//-------------------------------------------------
+//  random_int - return a random integer of the
+//  given size, favoring edge cases
+//-------------------------------------------------
+
+UINT64 drcbe_validator::random_int(UINT8 size)
+{
+	static const UINT64 edges[] =
+	{
+		0, 1, 2, 0x7f, 0x80, 0xff, 0x7fff, 0x8000, 0xffff, 0x7fffffff, 0x80000000, 0xffffffff,
+		U64(0x100000000), U64(0x7fffffffffffffff), U64(0x8000000000000000), ~U64(1), ~U64(0)
+	};
+
+	UINT64 value = random();
+	if ((value & 3) == 0)
+		value = edges[(value >> 8) % ARRAY_LENGTH(edges)];
+	return value & size_mask(size);
+}
+
+
+//-------------------------------------------------
+//  random_float - return the bits of a random
+//  finite float of the given size; values are
+//  exact in single precision and never halfway
+//  between integers, so rounding can't differ
+//-------------------------------------------------
+
+UINT64 drcbe_validator::random_float(UINT8 size)
+{
+	static const int eighths[] = { 0, 1, 2, 3, 5, 6, 7 };
+
+	UINT64 bits = random();
+	double value = double(INT32(bits % 2000001) - 1000000) + double(eighths[(bits >> 32) % ARRAY_LENGTH(eighths)]) / 8.0;
+	if (((bits >> 40) & 7) == 0)
+		value = 0.0;
+	else if (((bits >> 40) & 7) == 1)
+		value = ((bits >> 43) & 1) ? 1.0 : -1.0;
+
+	if (size == 4)
+	{
+		float single = float(value);
+		return *(UINT32 *)&single;
+	}
+	return *(UINT64 *)&value;
+}
+
+
+//-------------------------------------------------
+//  random - return the next 64-bit random number
+//-------------------------------------------------
+
+UINT64 drcbe_validator::random()
+{
+	// xorshift64*
+	m_seed ^= m_seed >> 12;
+	m_seed ^= m_seed << 25;
+	m_seed ^= m_seed >> 27;
+	return m_seed * U64(0x2545f4914f6cdd1d);
+}
+
+
+//-------------------------------------------------
+//  operand_parameter - return the UML parameter
+//  for an operand on the given back-end, or a
+//  placeholder register if there is none
+//-------------------------------------------------
+
+parameter drcbe_validator::operand_parameter(backend *be, const test_case &test, int pnum) const
+{
+	const test_operand &op = test.operand[pnum];
+	if (be == nullptr)
+		return op.isfloat ? freg(1) : ireg(1);
+
+	int slot = pnum;
+	int kind = op.kind;
+	if (kind == KIND_SAME_AS_FIRST)
+	{
+		slot = test.first;
+		kind = test.operand[slot].kind;
+	}
+
+	switch (kind)
+	{
+		case KIND_IMMEDIATE:        return parameter(op.value);
+		case KIND_REGISTER:         return op.isfloat ? freg(1 + slot) : ireg(1 + slot);
+		case KIND_REGISTER_HIGH:    return op.isfloat ? freg(9 - slot) : ireg(9 - slot);
+		default:                    return mem(&be->memory[slot]);
+	}
+}
+
+
+//-------------------------------------------------
+//  build - configure the instruction under test
+//  for the given back-end
+//-------------------------------------------------
+
+void drcbe_validator::build(backend *be, const test_case &test, instruction &inst) const
+{
+	parameter params[4];
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+	{
+		if (test.operand[pnum].used)
+			params[pnum] = operand_parameter(be, test, pnum);
+		else if (test.fixed[pnum].is_memory())
+			params[pnum] = mem((be != nullptr) ? be->buffer : nullptr);
+		else
+			params[pnum] = test.fixed[pnum];
+	}
+
+	switch (test.numparams)
+	{
+		case 0:     inst.configure(test.opcode, test.size, test.condition);                                                 break;
+		case 1:     inst.configure(test.opcode, test.size, params[0], test.condition);                                      break;
+		case 2:     inst.configure(test.opcode, test.size, params[0], params[1], test.condition);                           break;
+		case 3:     inst.configure(test.opcode, test.size, params[0], params[1], params[2], test.condition);                break;
+		default:    inst.configure(test.opcode, test.size, params[0], params[1], params[2], params[3], test.condition);     break;
+	}
+}
+
+
+//-------------------------------------------------
+//  execute - compile and run a test on one
+//  back-end
+//-------------------------------------------------
+
+void drcbe_validator::execute(backend &be, const test_case &test)
+{
+	// set up the initial state
+	*be.istate = test.state;
+	memcpy(be.memory, test.memory, sizeof(test.memory));
+	memcpy(be.buffer, test.buffer, sizeof(test.buffer));
+	memset(be.fstate, 0, sizeof(*be.fstate));
+	*be.flags = 0;
+	if (m_space != nullptr)
+		fill_window(test.window);
+
+	// the GETFLGS is what makes the optimizer request flags from the test
+	be.drcuml.reset();
+	drcuml_block *block = be.drcuml.begin_block(8);
+	block->append().handle(*be.entry);
+	block->append().restore(be.istate);
+	build(&be, test, block->append());
+	block->append().getflgs(mem(be.flags), test.checkflags);
+	block->append().save(be.fstate);
+	block->append().exit(0);
+	block->end();
+
+	be.drcuml.execute(*be.entry);
+	if (m_space != nullptr)
+		snapshot_window(be.window);
+}
+
+
+//-------------------------------------------------
+//  compare - compare the final state of the two
+//  back-ends after a test; returns 1 on failure
+//-------------------------------------------------
+
+int drcbe_validator::compare(test_case &test)
+{
+	const drcuml_machine_state &cstate = *m_c->fstate;
+	const drcuml_machine_state &nstate = *m_native->fstate;
+	m_tests++;
+
+	// 32-bit results leave the upper half of a register undefined
+	UINT64 imask[REG_I_COUNT], fmask[REG_F_COUNT];
+	UINT8 fnan[REG_F_COUNT] = { 0 }, mnan[MEMORY_SLOTS] = { 0 };
+	for (auto &mask : imask)
+		mask = ~U64(0);
+	for (auto &mask : fmask)
+		mask = ~U64(0);
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+	{
+		const test_operand &op = test.operand[pnum];
+		if (!op.used || !op.output)
+			continue;
+
+		UINT64 *loc = location(test, pnum);
+		if (loc >= &test.memory[0] && loc < &test.memory[MEMORY_SLOTS])
+		{
+			if (op.isfloat)
+				mnan[loc - &test.memory[0]] = op.size;
+		}
+		else if (op.isfloat)
+		{
+			int regnum = (drcuml_freg *)loc - &test.state.f[0];
+			fmask[regnum] = size_mask(op.size);
+			fnan[regnum] = op.size;
+		}
+		else
+			imask[(drcuml_ireg *)loc - &test.state.r[0]] = size_mask(op.size);
+	}
+
+	// compare everything the block could have touched
+	std::string errors;
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		if (((cstate.r[regnum].d ^ nstate.r[regnum].d) & imask[regnum]) != 0)
+			errors.append(string_format("  i%d: C %016X, native %016X\n", regnum, cstate.r[regnum].d, nstate.r[regnum].d));
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+	{
+		UINT64 cbits = *(UINT64 *)&cstate.f[regnum].d & fmask[regnum];
+		UINT64 nbits = *(UINT64 *)&nstate.f[regnum].d & fmask[regnum];
+		if (cbits != nbits && !(is_nan(cbits, fnan[regnum]) && is_nan(nbits, fnan[regnum])))
+			errors.append(string_format("  f%d: C %016X, native %016X\n", regnum, cbits, nbits));
+	}
+	for (int slot = 0; slot < MEMORY_SLOTS; slot++)
+	{
+		UINT64 cbits = m_c->memory[slot];
+		UINT64 nbits = m_native->memory[slot];
+		if (mnan[slot] == 4)
+		{
+			cbits = *(UINT32 *)&m_c->memory[slot];
+			nbits = *(UINT32 *)&m_native->memory[slot];
+		}
+		if (m_c->memory[slot] != m_native->memory[slot] && !(is_nan(cbits, mnan[slot]) && is_nan(nbits, mnan[slot])))
+			errors.append(string_format("  m%d: C %016X, native %016X\n", slot, m_c->memory[slot], m_native->memory[slot]));
+	}
+	for (int entry = 0; entry < BUFFER_ENTRIES; entry++)
+		if (m_c->buffer[entry] != m_native->buffer[entry])
+			errors.append(string_format("  buffer[%d]: C %016X, native %016X\n", entry, m_c->buffer[entry], m_native->buffer[entry]));
+	for (int offset = 0; offset < WINDOW_BYTES; offset += 8)
+		if (memcmp(&m_c->window[offset], &m_native->window[offset], 8) != 0)
+			errors.append(string_format("  window+%02X: C %s, native %s\n", offset, bytes_string(&m_c->window[offset]), bytes_string(&m_native->window[offset])));
+	if (((*m_c->flags ^ *m_native->flags) & test.checkflags) != 0)
+		errors.append(string_format("  flags: C %s, native %s\n", flags_string(*m_c->flags & test.checkflags), flags_string(*m_native->flags & test.checkflags)));
+
+	if (errors.empty())
+		return 0;
+	report_failure(*m_native, test, errors);
+	return 1;
+}
+
+
+//-------------------------------------------------
+//  run_encoding - run one set of operand
+//  encodings under each condition and flag
+//  combination; returns the number of failures
+//-------------------------------------------------
+
+int drcbe_validator::run_encoding(test_case &test, bool allflags)
+{
+	const opcode_info &opinfo = instruction::s_opcode_info_table[test.opcode];
+	int failures = 0;
+
+	// SET has no meaning without a condition
+	int firstcond = (!opinfo.condition) ? COND_ALWAYS : (test.opcode == OP_SET) ? COND_Z : COND_Z - 1;
+	int lastcond = opinfo.condition ? COND_MAX - 1 : COND_ALWAYS;
+	for (int cond = firstcond; cond <= lastcond; cond++)
+	{
+		test.condition = (cond < COND_Z) ? COND_ALWAYS : condition_t(cond);
+
+		// either every combination of the flags, or none and all of them
+		for (int flags = 0; flags <= opinfo.outflags; flags++)
+		{
+			if ((flags & ~opinfo.outflags) != 0 || (!allflags && flags != 0 && flags != opinfo.outflags))
+				continue;
+
+			// flags an instruction doesn't modify must survive it
+			test.flags = flags;
+			test.checkflags = flags | (~opinfo.modflags & (FLAG_U | FLAG_S | FLAG_Z | FLAG_V | FLAG_C));
+
+			for (int iter = 0; iter < VALUES_PER_ENCODING; iter++)
+			{
+				choose_values(test);
+				execute(*m_c, test);
+				execute(*m_native, test);
+				failures += compare(test);
+			}
+		}
+	}
+
+	test.condition = COND_ALWAYS;
+	return failures;
+}
+
+
+//-------------------------------------------------
+//  report_failure - describe a failed test in
+//  the report
+//-------------------------------------------------
+
+void drcbe_validator::report_failure(backend &be, const test_case &test, const std::string &errors)
+{
+	if (m_reported++ >= MAX_REPORTED_FAILURES)
+		return;
+
+	instruction inst;
+	build(&be, test, inst);
+	inst.set_flags(test.flags);
+	m_report.append(string_format("%s back-end: %s\n", be.name, inst.disasm(&be.drcuml)));
+	m_report.append(string_format("  initial flags %s, checking %s\n", flags_string(test.state.flags), flags_string(test.checkflags)));
+	for (int pnum = 0; pnum < test.numparams; pnum++)
+		if (test.operand[pnum].used && test.operand[pnum].kind != KIND_SAME_AS_FIRST)
+			m_report.append(string_format("  p%d = %016X\n", pnum, test.operand[pnum].value));
+	m_report.append(errors);
+}
+
+
+//-------------------------------------------------
+//  benchmark_compile - measure how quickly a
+//  back-end turns UML into host code
+//-------------------------------------------------
+
+void drcbe_validator::benchmark_compile(backend &be)
+{
+	be.drcuml.reset();
+	drcuml_stats before = be.drcuml.stats();
+	osd_ticks_t start = osd_ticks();
+
+	// blocks of typical integer and floating point work
+	for (int blocknum = 0; blocknum < BENCHMARK_BLOCKS; blocknum++)
+	{
+		drcuml_block *block = be.drcuml.begin_block(BENCHMARK_BLOCK_SIZE * 2 + 1);
+		for (int instnum = 0; instnum < BENCHMARK_BLOCK_SIZE; instnum++)
+		{
+			UINT64 bits = random();
+			parameter dst = ireg(bits & 7);
+			parameter src1 = ireg((bits >> 3) & 7);
+			parameter src2 = (bits & 0x40) ? parameter((bits >> 32) & 0xffff) : ireg((bits >> 7) & 7);
+			parameter memory = mem(&be.memory[(bits >> 10) & 3]);
+			parameter fdst = freg(bits & 7);
+			parameter fsrc = freg((bits >> 3) & 7);
+
+			switch ((bits >> 16) % 12)
+			{
+				case 0:     block->append().add(dst, src1, src2);                                   break;
+				case 1:     block->append().sub(dst, src1, src2);                                   break;
+				case 2:     block->append()._and(dst, src1, src2);                                  break;
+				case 3:     block->append()._or(dst, src1, src2);                                   break;
+				case 4:     block->append()._xor(dst, memory, src2);                                break;
+				case 5:     block->append().shl(dst, src1, (bits >> 20) & 31);                      break;
+				case 6:     block->append().dadd(dst, src1, src2);                                  break;
+				case 7:     block->append().mov(memory, src1);                                      break;
+				case 8:     block->append().cmp(src1, src2); block->append().set(COND_L, dst);      break;
+				case 9:     block->append().mulu(dst, dst, src1, src2);                             break;
+				case 10:    block->append().fdadd(fdst, fdst, fsrc);                                break;
+				case 11:    block->append().fdmul(fdst, fsrc, fsrc);                                break;
+			}
+		}
+		block->append().exit(0);
+		block->end();
+	}
+
+	osd_ticks_t ticks = osd_ticks() - start;
+	const drcuml_stats &after = be.drcuml.stats();
+	double instructions = double(after.instructions - before.instructions);
+	double seconds = double(ticks) / double(osd_ticks_per_second());
+	m_report.append(string_format("%s back-end: compiled %.0f UML instructions in %.1f ms (%.0f ns and %.1f host bytes per instruction)\n",
+		be.name, instructions, seconds * 1000.0, seconds * 1.0e9 / instructions, double(after.host_bytes - before.host_bytes) / instructions));
+}
+
+
+//-------------------------------------------------
+//  benchmark_execute - measure how quickly a
+//  back-end's code runs a tight loop
+//-------------------------------------------------
+
+void drcbe_validator::benchmark_execute(backend &be)
+{
+	memset(be.istate, 0, sizeof(*be.istate));
+	for (auto &reg : be.istate->f)
+		reg.d = 1.0;
+	be.istate->fmod = ROUND_ROUND;
+
+	// BENCHMARK_LOOP_SIZE instructions per iteration
+	be.drcuml.reset();
+	drcuml_block *block = be.drcuml.begin_block(32);
+	block->append().handle(*be.entry);
+	block->append().restore(be.istate);
+	block->append().mov(I0, BENCHMARK_ITERATIONS);
+	block->append().label(1);
+	block->append().add(I1, I1, I2);
+	block->append()._xor(I2, I2, I3);
+	block->append().rol(I3, I3, 5);
+	block->append().sub(I4, I4, I1);
+	block->append()._and(I5, I1, 0xff00ff);
+	block->append()._or(I6, I6, I5);
+	block->append().dadd(I7, I7, I6);
+	block->append().mov(mem(&be.memory[0]), I1);
+	block->append().add(I3, I3, mem(&be.memory[0]));
+	block->append().shr(I2, I2, 3);
+	block->append().cmp(I1, I4);
+	block->append().set(COND_A, I5);
+	block->append().mulu(I6, I6, I1, I2);
+	block->append().fdadd(F1, F1, F2);
+	block->append().fdmul(F2, F2, F3);
+	block->append().dsub(I7, I7, I3);
+	block->append().sub(I0, I0, 1);
+	block->append().jmp(COND_NZ, 1);
+	block->append().exit(0);
+	block->end();
+
+	osd_ticks_t start = osd_ticks();
+	be.drcuml.execute(*be.entry);
+	osd_ticks_t ticks = osd_ticks() - start;
+
+	double instructions = double(BENCHMARK_ITERATIONS) * double(BENCHMARK_LOOP_SIZE);
+	double seconds = double(ticks) / double(osd_ticks_per_second());
+	m_report.append(string_format("%s back-end: executed %.0f UML instructions in %.1f ms (%.1f million per second)\n",
+		be.name, instructions, seconds * 1000.0, instructions / seconds / 1.0e6));
+}
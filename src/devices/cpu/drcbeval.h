@@ -0,0 +1,151 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbeval.h
+
+    Conformance tests and benchmarks for the UML back-ends.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCBEVAL_H__
+#define __DRCBEVAL_H__
+
+#include "drcuml.h"
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> drcbe_validator
+
+// runs the same UML on the C and native back-ends and compares the results
+class drcbe_validator
+{
+public:
+	// construction/destruction
+	drcbe_validator(device_t &device);
+	~drcbe_validator();
+
+	// getters
+	const std::string &report() const { return m_report; }
+
+	// testing; each returns the number of failures
+	int check_known_results();
+	int check_conformance();
+
+	// benchmarking
+	void benchmark();
+
+private:
+	// constants
+	static const int MEMORY_SLOTS = 4;
+	static const int BUFFER_ENTRIES = 8;
+	static const int WINDOW_BYTES = 64;
+
+	// how a test operand is encoded
+	enum
+	{
+		KIND_IMMEDIATE,
+		KIND_REGISTER,
+		KIND_REGISTER_HIGH,
+		KIND_MEMORY,
+		KIND_SAME_AS_FIRST,
+		KIND_COUNT
+	};
+
+	// per-back-end state
+	struct backend
+	{
+		backend(device_t &device, drcbe_type type, const char *name);
+
+		const char *                name;               // name for reports
+		drc_cache                   cache;              // private code cache
+		drcuml_state                drcuml;             // UML state using this back-end
+		uml::code_handle *          entry;              // entry point of the current test
+		drcuml_machine_state *      istate;             // state restored before the test instruction
+		drcuml_machine_state *      fstate;             // state saved after the test instruction
+		UINT64 *                    memory;             // memory operands
+		UINT64 *                    buffer;             // LOAD/STORE buffer
+		UINT32 *                    flags;              // flags captured after the test instruction
+		UINT8                       window[WINDOW_BYTES];   // READ/WRITE window after the test instruction
+	};
+
+	// one operand of a test instruction
+	struct test_operand
+	{
+		bool                        used;               // is this parameter an operand?
+		bool                        isfloat;            // floating point?
+		bool                        input;              // read by the instruction?
+		bool                        output;             // written by the instruction?
+		bool                        constrained;        // value must be chosen specially?
+		UINT8                       size;               // size of the value, in bytes
+		UINT16                      typemask;           // encodings allowed by the opcode table
+		UINT8                       kind;               // encoding (KIND_*)
+		UINT64                      value;              // initial value
+	};
+
+	// one test instruction and its initial state
+	struct test_case
+	{
+		uml::opcode_t               opcode;             // opcode to test
+		UINT8                       size;               // instruction size
+		uml::condition_t            condition;          // condition
+		UINT8                       flags;              // flags requested from the instruction
+		UINT8                       checkflags;         // flags compared afterwards
+		int                         numparams;          // number of parameters
+		int                         first;              // first parameter that is an operand
+		uml::parameter              fixed[4];           // parameters that aren't operands
+		test_operand                operand[4];         // operands
+		drcuml_machine_state        state;              // initial machine state
+		UINT64                      memory[MEMORY_SLOTS];   // initial memory operands
+		UINT64                      buffer[BUFFER_ENTRIES]; // initial LOAD/STORE buffer
+		UINT8                       window[WINDOW_BYTES];   // initial READ/WRITE window
+	};
+
+	// memory space window
+	void find_window(device_t &device);
+	void fill_window(const UINT8 *data);
+	void snapshot_window(UINT8 *data);
+
+	// test generation
+	bool testable(uml::opcode_t opcode) const;
+	void setup_operands(test_case &test) const;
+	bool assign_kinds(test_case &test, int combo) const;
+	void choose_values(test_case &test);
+	void store_value(test_case &test, int pnum) const;
+	UINT64 *location(test_case &test, int pnum) const;
+	UINT64 random_int(UINT8 size);
+	UINT64 random_float(UINT8 size);
+	UINT64 random();
+
+	// execution
+	uml::parameter operand_parameter(backend *be, const test_case &test, int pnum) const;
+	void build(backend *be, const test_case &test, uml::instruction &inst) const;
+	void execute(backend &be, const test_case &test);
+	int compare(test_case &test);
+	int run_encoding(test_case &test, bool allflags);
+	void report_failure(backend &be, const test_case &test, const std::string &errors);
+
+	// benchmarking
+	void benchmark_compile(backend &be);
+	void benchmark_execute(backend &be);
+
+	// internal state
+	std::unique_ptr<backend>        m_c;                // C back-end
+	std::unique_ptr<backend>        m_native;           // native back-end
+	address_space *                 m_space;            // program space holding the window, or nullptr
+	offs_t                          m_window;           // byte address of a RAM window in m_space
+	UINT8                           m_saved[WINDOW_BYTES];  // original window contents
+	UINT64                          m_seed;             // random number state
+	UINT32                          m_tests;            // number of tests run
+	UINT32                          m_reported;         // failures reported for the current opcode
+	std::string                     m_report;           // accumulated report text
+};
+
+
+#endif /* __DRCBEVAL_H__ */
@@ -591,8 +591,10 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 		m_labels(cache),
 		m_log(nullptr),
 		m_sse41(false),
-		m_absmask32((UINT32 *)cache.alloc_near(16*2 + 15)),
+		m_absmask32((UINT32 *)cache.alloc_near(16*4 + 15)),
 		m_absmask64(nullptr),
+		m_negmask32(nullptr),
+		m_negmask64(nullptr),
 		m_rbpvalue(cache.near() + 0x80),
 		m_entry(nullptr),
 		m_exit(nullptr),
@@ -613,11 +615,15 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, U
 	m_near.single1 = 1.0f;
 	m_near.double1 = 1.0;
 
-	// create absolute value masks that are aligned to SSE boundaries
+	// create absolute value and negation masks that are aligned to SSE boundaries
 	m_absmask32 = (UINT32 *)(((FPTR)m_absmask32 + 15) & ~15);
 	m_absmask32[0] = m_absmask32[1] = m_absmask32[2] = m_absmask32[3] = 0x7fffffff;
 	m_absmask64 = (UINT64 *)&m_absmask32[4];
 	m_absmask64[0] = m_absmask64[1] = U64(0x7fffffffffffffff);
+	m_negmask32 = &m_absmask32[8];
+	m_negmask32[0] = m_negmask32[1] = m_negmask32[2] = m_negmask32[3] = 0x80000000;
+	m_negmask64 = (UINT64 *)&m_absmask32[12];
+	m_negmask64[0] = m_negmask64[1] = U64(0x8000000000000000);
 
 	// get pointers to C functions we need to call
 	m_near.debug_cpu_instruction_hook = (x86code *)debugger_instruction_hook;
@@ -2030,7 +2036,7 @@ void drcbe_x64::emit_test_m64_p64(x86code *&dst, x86_memref memref, const be_par
 {
 	if (param.is_immediate() && short_immediate(param.immediate()))
 		emit_test_m64_imm(dst, memref, param.immediate());                          // test  [dest],param
-	else if (param.is_memory())
+	else if (param.is_memory() || param.is_immediate())
 	{
 		emit_mov_r64_p64(dst, REG_EAX, param);                                          // mov   reg,param
 		emit_test_m64_r64(dst, memref, REG_EAX);                                        // test  [dest],reg
@@ -2464,6 +2470,60 @@ void drcbe_x64::emit_rcr_m64_p64(x86code *&dst, x86_memref memref, const be_para
 }
 
 
+//-------------------------------------------------
+//  emit_rotate_flags - x86 rotates leave S and Z
+//  alone, so fold them in from the result while
+//  keeping the carry the rotate produced; a zero
+//  count leaves all the flags alone, as it does
+//  on x86
+//-------------------------------------------------
+
+void drcbe_x64::emit_rotate_flags(x86code *&dst, const be_parameter &param, const be_parameter &count, const instruction &inst)
+{
+	if ((inst.flags() & (FLAG_S | FLAG_Z)) == 0)
+		return;
+
+	UINT32 countmask = inst.size() * 8 - 1;
+	if (count.is_immediate() && (count.immediate() & countmask) == 0)
+		return;
+
+	emit_pushf(dst);                                                                    // pushf
+
+	// a count from a register or memory was loaded into ecx for the rotate
+	emit_link skip = { nullptr };
+	if (!count.is_immediate())
+	{
+		emit_test_r32_imm(dst, REG_ECX, countmask);                                     // test  ecx,countmask
+		emit_jcc_short_link(dst, x64emit::COND_Z, skip);                                // jz    skip
+	}
+
+	if (inst.size() == 4)
+	{
+		if (param.is_memory())
+			emit_test_m32_imm(dst, MABS(param.memory()), ~0);                           // test  [param],~0
+		else
+			emit_test_r32_r32(dst, param.ireg(), param.ireg());                         // test  param,param
+	}
+	else
+	{
+		if (param.is_memory())
+			emit_test_m64_imm(dst, MABS(param.memory()), ~0);                           // test  [param],~0
+		else
+			emit_test_r64_r64(dst, param.ireg(), param.ireg());                         // test  param,param
+	}
+
+	// we rely on the fact that CF and OF are cleared by the test above
+	emit_pushf(dst);                                                                    // pushf
+	emit_pop_r64(dst, REG_R11);                                                         // pop   r11
+	emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                                      // and   [rsp],~0xc0
+	emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_R11);                                     // or    [rsp],r11
+
+	if (!count.is_immediate())
+		resolve_link(dst, skip);                                                    // skip:
+	emit_popf(dst);                                                                     // popf
+}
+
+
 
 /***************************************************************************
     EMITTERS FOR FLOATING POINT OPERATIONS WITH PARAMETERS
@@ -3464,7 +3524,7 @@ void drcbe_x64::op_load(x86code *&dst, const instruction &inst)
 	// other index
 	else
 	{
-		int indreg = indp.select_register(REG_ECX);
+		int indreg = REG_ECX;
 		emit_movsx_r64_p32(dst, indreg, indp);
 		if (size == SIZE_BYTE)
 			emit_movzx_r32_m8(dst, dstreg, MBISD(basereg, indreg, scale, baseoffs));    // movzx dstreg,[basep + scale*indp]
@@ -3540,7 +3600,7 @@ void drcbe_x64::op_loads(x86code *&dst, const instruction &inst)
 	// other index
 	else
 	{
-		int indreg = indp.select_register(REG_ECX);
+		int indreg = REG_ECX;
 		emit_movsx_r64_p32(dst, indreg, indp);
 		if (inst.size() == 4)
 		{
@@ -3645,8 +3705,8 @@ void drcbe_x64::op_store(x86code *&dst, const instruction &inst)
 	// normal case: variable index
 	else
 	{
-		int indreg = indp.select_register(REG_ECX);
-		emit_movsx_r64_p32(dst, indreg, indp);                                          // mov   indreg,indp
+		int indreg = REG_ECX;
+		emit_movsx_r64_p32(dst, indreg, indp);                                          // movsxd indreg,indp
 
 		// immediate source
 		if (srcp.is_immediate())
@@ -3905,7 +3965,7 @@ void drcbe_x64::op_carry(x86code *&dst, const instruction &inst)
 	// degenerate case: source is immediate
 	if (srcp.is_immediate() && bitp.is_immediate())
 	{
-		if (srcp.immediate() & ((UINT64)1 << bitp.immediate()))
+		if (srcp.immediate() & ((UINT64)1 << (bitp.immediate() & (inst.size() * 8 - 1))))
 			emit_stc(dst);
 		else
 			emit_clc(dst);
@@ -3934,6 +3994,11 @@ void drcbe_x64::op_carry(x86code *&dst, const instruction &inst)
 				emit_bt_m32_r32(dst, MABS(srcp.memory()), REG_ECX);                     // bt     [srcp],ecx
 			else if (srcp.is_int_register())
 				emit_bt_r32_r32(dst, srcp.ireg(), REG_ECX);                             // bt     srcp,ecx
+			else if (srcp.is_immediate())
+			{
+				emit_mov_r32_imm(dst, REG_EAX, srcp.immediate());                       // mov    eax,srcp
+				emit_bt_r32_r32(dst, REG_EAX, REG_ECX);                                 // bt     eax,ecx
+			}
 		}
 	}
 
@@ -3953,6 +4018,11 @@ void drcbe_x64::op_carry(x86code *&dst, const instruction &inst)
 				emit_bt_m64_r64(dst, MABS(srcp.memory()), REG_ECX);                     // bt     [srcp],ecx
 			else if (srcp.is_int_register())
 				emit_bt_r64_r64(dst, srcp.ireg(), REG_ECX);                             // bt     srcp,ecx
+			else if (srcp.is_immediate())
+			{
+				emit_mov_r64_imm(dst, REG_RAX, srcp.immediate());                       // mov    rax,srcp
+				emit_bt_r64_r64(dst, REG_RAX, REG_ECX);                                 // bt     rax,ecx
+			}
 		}
 	}
 }
@@ -4137,6 +4207,15 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_DWORD)
 				emit_mov_r32_r32(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r32_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,srcp
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r32_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,srcp
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r32_imm(dst, dstreg, (INT32)srcp.immediate());                 // mov   dstreg,srcp
+		}
 		emit_mov_p32_r32(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r32_r32(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4168,6 +4247,17 @@ void drcbe_x64::op_sext(x86code *&dst, const instruction &inst)
 			else if (sizep.size() == SIZE_QWORD)
 				emit_mov_r64_r64(dst, dstreg, srcp.ireg());                             // mov   dstreg,srcp
 		}
+		else if (srcp.is_immediate())
+		{
+			if (sizep.size() == SIZE_BYTE)
+				emit_mov_r64_imm(dst, dstreg, (INT8)srcp.immediate());                  // mov   dstreg,srcp
+			else if (sizep.size() == SIZE_WORD)
+				emit_mov_r64_imm(dst, dstreg, (INT16)srcp.immediate());                 // mov   dstreg,srcp
+			else if (sizep.size() == SIZE_DWORD)
+				emit_mov_r64_imm(dst, dstreg, (INT32)srcp.immediate());                 // mov   dstreg,srcp
+			else if (sizep.size() == SIZE_QWORD)
+				emit_mov_r64_imm(dst, dstreg, srcp.immediate());                        // mov   dstreg,srcp
+		}
 		emit_mov_p64_r64(dst, dstp, dstreg);                                            // mov   dstp,dstreg
 		if (inst.flags() != 0)
 			emit_test_r64_r64(dst, dstreg, dstreg);                                     // test  dstreg,dstreg
@@ -4632,7 +4722,7 @@ void drcbe_x64::op_mulu(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r64(dst, REG_RAX);                                         // pop   rax
-					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0x84);                      // and   [rsp],~0x84
+					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                      // and   [rsp],~0xc0
 					emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_RAX);                     // or    [rsp],rax
 					emit_popf(dst);                                                     // popf
 				}
@@ -4687,7 +4777,7 @@ void drcbe_x64::op_mulu(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r64(dst, REG_RAX);                                         // pop   rax
-					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0x84);                      // and   [rsp],~0x84
+					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                      // and   [rsp],~0xc0
 					emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_RAX);                     // or    [rsp],rax
 					emit_popf(dst);                                                     // popf
 				}
@@ -4740,6 +4830,8 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				emit_imul_r32_m32(dst, REG_EAX, MABS(src2p.memory()));                  // imul  eax,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r32_r32(dst, REG_EAX, src2p.ireg());                          // imul  eax,src2p
+			else if (src2p.is_immediate())
+				emit_imul_r32_r32_imm(dst, REG_EAX, REG_EAX, src2p.immediate());        // imul  eax,eax,src2p
 			emit_mov_p32_r32(dst, dstp, REG_EAX);                                       // mov   dstp,eax
 		}
 
@@ -4789,7 +4881,7 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r64(dst, REG_RAX);                                         // pop   rax
-					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0x84);                      // and   [rsp],~0x84
+					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                      // and   [rsp],~0xc0
 					emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_RAX);                     // or    [rsp],rax
 					emit_popf(dst);                                                     // popf
 				}
@@ -4818,6 +4910,11 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				emit_imul_r64_m64(dst, REG_RAX, MABS(src2p.memory()));                  // imul  rax,[src2p]
 			else if (src2p.is_int_register())
 				emit_imul_r64_r64(dst, REG_RAX, src2p.ireg());                          // imul  rax,src2p
+			else if (src2p.is_immediate())
+			{
+				emit_mov_r64_imm(dst, REG_RDX, src2p.immediate());                      // mov   rdx,src2p
+				emit_imul_r64_r64(dst, REG_RAX, REG_RDX);                               // imul  rax,rdx
+			}
 			emit_mov_p64_r64(dst, dstp, REG_RAX);                                       // mov   dstp,rax
 		}
 
@@ -4867,7 +4964,7 @@ void drcbe_x64::op_muls(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r64(dst, REG_RAX);                                         // pop   rax
-					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0x84);                      // and   [rsp],~0x84
+					emit_and_m64_imm(dst, MBD(REG_RSP, 0), ~0xc0);                      // and   [rsp],~0xc0
 					emit_or_m64_r64(dst, MBD(REG_RSP, 0), REG_RAX);                     // or    [rsp],rax
 					emit_popf(dst);                                                     // popf
 				}
@@ -5385,7 +5482,7 @@ void drcbe_x64::op_shl(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_shl_r32_p32(dst, dstreg, src2p, inst);                                 // shl   dstreg,src2p
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5401,7 +5498,7 @@ void drcbe_x64::op_shl(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_shl_r64_p64(dst, dstreg, src2p, inst);                                 // shl   dstreg,src2p
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5438,7 +5535,7 @@ void drcbe_x64::op_shr(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_shr_r32_p32(dst, dstreg, src2p, inst);                                 // shr   dstreg,src2p
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5454,7 +5551,7 @@ void drcbe_x64::op_shr(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_shr_r64_p64(dst, dstreg, src2p, inst);                                 // shr   dstreg,src2p
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5491,7 +5588,7 @@ void drcbe_x64::op_sar(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_sar_r32_p32(dst, dstreg, src2p, inst);                                 // sar   dstreg,src2p
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5507,7 +5604,7 @@ void drcbe_x64::op_sar(x86code *&dst, const instruction &inst)
 		// general case
 		else
 		{
-			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_sar_r64_p64(dst, dstreg, src2p, inst);                                 // sar   dstreg,src2p
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
@@ -5539,13 +5636,17 @@ void drcbe_x64::op_rol(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rol_m32_p32(dst, MABS(dstp.memory()), src2p, inst);                    // rol   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
-			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rol_r32_p32(dst, dstreg, src2p, inst);                                 // rol   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5555,13 +5656,17 @@ void drcbe_x64::op_rol(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rol_m64_p64(dst, MABS(dstp.memory()), src2p, inst);                    // rol   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
-			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rol_r64_p64(dst, dstreg, src2p, inst);                                 // rol   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5592,13 +5697,17 @@ void drcbe_x64::op_ror(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_ror_m32_p32(dst, MABS(dstp.memory()), src2p, inst);                    // ror   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
-			emit_mov_r32_p32(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_ror_r32_p32(dst, dstreg, src2p, inst);                                 // ror   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5608,13 +5717,17 @@ void drcbe_x64::op_ror(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_ror_m64_p64(dst, MABS(dstp.memory()), src2p, inst);                    // ror   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
-			emit_mov_r64_p64(dst, dstreg, src1p);                                       // mov   dstreg,src1p
+			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_ror_r64_p64(dst, dstreg, src2p, inst);                                 // ror   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5645,13 +5758,17 @@ void drcbe_x64::op_rolc(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rcl_m32_p32(dst, MABS(dstp.memory()), src2p, inst);                    // rcl   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
 			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rcl_r32_p32(dst, dstreg, src2p, inst);                                 // rcl   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5661,13 +5778,17 @@ void drcbe_x64::op_rolc(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rcl_m64_p64(dst, MABS(dstp.memory()), src2p, inst);                    // rcl   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
 			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rcl_r64_p64(dst, dstreg, src2p, inst);                                 // rcl   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5698,13 +5819,17 @@ void drcbe_x64::op_rorc(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rcr_m32_p32(dst, MABS(dstp.memory()), src2p, inst);                    // rcr   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
 			emit_mov_r32_p32_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rcr_r32_p32(dst, dstreg, src2p, inst);                                 // rcr   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p32_r32(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5714,13 +5839,17 @@ void drcbe_x64::op_rorc(x86code *&dst, const instruction &inst)
 	{
 		// dstp == src1p in memory
 		if (dstp.is_memory() && dstp == src1p)
+		{
 			emit_rcr_m64_p64(dst, MABS(dstp.memory()), src2p, inst);                    // rcr   [dstp],src2p
+			emit_rotate_flags(dst, dstp, src2p, inst);
+		}
 
 		// general case
 		else
 		{
 			emit_mov_r64_p64_keepflags(dst, dstreg, src1p);                             // mov   dstreg,src1p
 			emit_rcr_r64_p64(dst, dstreg, src2p, inst);                                 // rcr   dstreg,src2p
+			emit_rotate_flags(dst, be_parameter::make_ireg(dstreg), src2p, inst);
 			emit_mov_p64_r64(dst, dstp, dstreg);                                        // mov   dstp,dstreg
 		}
 	}
@@ -5762,8 +5891,8 @@ void drcbe_x64::op_fload(x86code *&dst, const instruction &inst)
 			emit_movss_r128_m32(dst, dstreg, MBD(basereg, baseoffs + 4*indp.immediate()));  // movss  dstreg,[basep + 4*indp]
 		else
 		{
-			int indreg = indp.select_register(REG_ECX);
-			emit_mov_r32_p32(dst, indreg, indp);                                        // mov    indreg,indp
+			int indreg = REG_ECX;
+			emit_movsx_r64_p32(dst, indreg, indp);                                      // movsxd indreg,indp
 			emit_movss_r128_m32(dst, dstreg, MBISD(basereg, indreg, 4, baseoffs));      // movss  dstreg,[basep + 4*indp]
 		}
 		emit_movss_p32_r128(dst, dstp, dstreg);                                         // movss  dstp,dstreg
@@ -5776,8 +5905,8 @@ void drcbe_x64::op_fload(x86code *&dst, const instruction &inst)
 			emit_movsd_r128_m64(dst, dstreg, MBD(basereg, baseoffs + 8*indp.immediate()));  // movsd  dstreg,[basep + 8*indp]
 		else
 		{
-			int indreg = indp.select_register(REG_ECX);
-			emit_mov_r32_p32(dst, indreg, indp);                                        // mov    indreg,indp
+			int indreg = REG_ECX;
+			emit_movsx_r64_p32(dst, indreg, indp);                                      // movsxd indreg,indp
 			emit_movsd_r128_m64(dst, dstreg, MBISD(basereg, indreg, 8, baseoffs));      // movsd  dstreg,[basep + 8*indp]
 		}
 		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd  dstp,dstreg
@@ -5816,8 +5945,8 @@ void drcbe_x64::op_fstore(x86code *&dst, const instruction &inst)
 			emit_movss_m32_r128(dst, MBD(basereg, baseoffs + 4*indp.immediate()), srcreg);  // movss  [basep + 4*indp],srcreg
 		else
 		{
-			int indreg = indp.select_register(REG_ECX);
-			emit_mov_r32_p32(dst, indreg, indp);                                        // mov    indreg,indp
+			int indreg = REG_ECX;
+			emit_movsx_r64_p32(dst, indreg, indp);                                      // movsxd indreg,indp
 			emit_movss_m32_r128(dst, MBISD(basereg, indreg, 4, baseoffs), srcreg);      // movss  [basep + 4*indp],srcreg
 		}
 	}
@@ -5830,8 +5959,8 @@ void drcbe_x64::op_fstore(x86code *&dst, const instruction &inst)
 			emit_movsd_m64_r128(dst, MBD(basereg, baseoffs + 8*indp.immediate()), srcreg);  // movsd  [basep + 8*indp],srcreg
 		else
 		{
-			int indreg = indp.select_register(REG_ECX);
-			emit_mov_r32_p32(dst, indreg, indp);                                        // mov    indreg,indp
+			int indreg = REG_ECX;
+			emit_movsx_r64_p32(dst, indreg, indp);                                      // movsxd indreg,indp
 			emit_movsd_m64_r128(dst, MBISD(basereg, indreg, 8, baseoffs), srcreg);      // movsd  [basep + 8*indp],srcreg
 		}
 	}
@@ -6497,22 +6626,16 @@ void drcbe_x64::op_fneg(x86code *&dst, const instruction &inst)
 	// 32-bit form
 	if (inst.size() == 4)
 	{
-		emit_xorps_r128_r128(dst, dstreg, dstreg);                                      // xorps dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subss_r128_m32(dst, dstreg, MABS(srcp.memory()));                      // subss dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subss_r128_r128(dst, dstreg, srcp.freg());                             // subss dstreg,srcp
+		emit_movss_r128_p32(dst, dstreg, srcp);                                         // movss dstreg,srcp
+		emit_xorps_r128_m128(dst, dstreg, MABS(m_negmask32));                           // xorps dstreg,[negmask32]
 		emit_movss_p32_r128(dst, dstp, dstreg);                                         // movss dstp,dstreg
 	}
 
 	// 64-bit form
 	else if (inst.size() == 8)
 	{
-		emit_xorpd_r128_r128(dst, dstreg, dstreg);                                      // xorpd dstreg,dstreg
-		if (srcp.is_memory())
-			emit_subsd_r128_m64(dst, dstreg, MABS(srcp.memory()));                      // subsd dstreg,[srcp]
-		else if (srcp.is_float_register())
-			emit_subsd_r128_r128(dst, dstreg, srcp.freg());                             // subsd dstreg,srcp
+		emit_movsd_r128_p64(dst, dstreg, srcp);                                         // movsd dstreg,srcp
+		emit_xorpd_r128_m128(dst, dstreg, MABS(m_negmask64));                           // xorpd dstreg,[negmask64]
 		emit_movsd_p64_r128(dst, dstp, dstreg);                                         // movsd dstp,dstreg
 	}
 }
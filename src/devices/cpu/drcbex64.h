@@ -285,6 +285,7 @@ private:
 	void emit_rcl_m64_p64(x86code *&dst, x86_memref memref, const be_parameter &param, const uml::instruction &inst);
 	void emit_rcr_r64_p64(x86code *&dst, UINT8 reg, const be_parameter &param, const uml::instruction &inst);
 	void emit_rcr_m64_p64(x86code *&dst, x86_memref memref, const be_parameter &param, const uml::instruction &inst);
+	void emit_rotate_flags(x86code *&dst, const be_parameter &param, const be_parameter &count, const uml::instruction &inst);
 
 	// floating-point code emission helpers
 	void emit_movss_r128_p32(x86code *&dst, UINT8 reg, const be_parameter &param);
@@ -301,6 +302,8 @@ private:
 
 	UINT32 *                m_absmask32;            // absolute value mask (32-bit)
 	UINT64 *                m_absmask64;            // absolute value mask (32-bit)
+	UINT32 *                m_negmask32;            // sign flip mask (32-bit)
+	UINT64 *                m_negmask64;            // sign flip mask (64-bit)
 	UINT8 *                 m_rbpvalue;             // value of RBP
 
 	x86_entry_point_func    m_entry;                // entry point
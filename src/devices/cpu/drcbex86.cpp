@@ -4821,7 +4821,7 @@ void drcbe_x86::op_mulu(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r32(dst, REG_EAX);                                     // pop   eax
-					emit_and_m32_imm(dst, MBD(REG_ESP, 0), ~0x84);                      // and   [esp],~0x84
+					emit_and_m32_imm(dst, MBD(REG_ESP, 0), ~0xc0);                      // and   [esp],~0xc0
 					emit_or_m32_r32(dst, MBD(REG_ESP, 0), REG_EAX);                 // or    [esp],eax
 					emit_popf(dst);                                                 // popf
 				}
@@ -4951,7 +4951,7 @@ void drcbe_x86::op_muls(x86code *&dst, const instruction &inst)
 				{
 					emit_pushf(dst);                                                    // pushf
 					emit_pop_r32(dst, REG_EAX);                                     // pop   eax
-					emit_and_m32_imm(dst, MBD(REG_ESP, 0), ~0x84);                      // and   [esp],~0x84
+					emit_and_m32_imm(dst, MBD(REG_ESP, 0), ~0xc0);                      // and   [esp],~0xc0
 					emit_or_m32_r32(dst, MBD(REG_ESP, 0), REG_EAX);                 // or    [esp],eax
 					emit_popf(dst);                                                 // popf
 				}
@@ -38,10 +38,22 @@ drc_cache::drc_cache(size_t bytes)
 		m_top(m_base),
 		m_end(m_near + bytes),
 		m_codegen(nullptr),
-		m_size(bytes)
+		m_size(bytes),
+		m_curregion(0),
+		m_pinregion(-1),
+		m_pintop(nullptr),
+		m_flushes(0),
+		m_evictions(0),
+		m_evicted_bytes(0),
+		m_generated_bytes(0),
+		m_advance_failures(0),
+		m_pinned_regions(0)
 {
 	memset(m_free, 0, sizeof(m_free));
 	memset(m_nearfree, 0, sizeof(m_nearfree));
+
+	// until eviction is asked for, the transient part is one region that gets flushed when full
+	split_regions(1);
 }
 
 
@@ -57,6 +69,27 @@ drc_cache::~drc_cache()
 
 
 
+//-------------------------------------------------
+//  set_eviction - split the transient part of
+//  the cache into regions that are evicted
+//  oldest first, or go back to a single region
+//  that is flushed when full
+//-------------------------------------------------
+
+void drc_cache::set_eviction(bool enable)
+{
+	// only allowed before any transient allocations
+	assert(m_codegen == nullptr);
+	assert(m_top == m_base);
+
+	// split into regions, unless the cache is too small to bother
+	int regions = enable ? REGION_COUNT : 1;
+	while (regions > 1 && (m_end - m_base) / regions < MIN_REGION_SIZE)
+		regions--;
+	split_regions(regions);
+}
+
+
 //-------------------------------------------------
 //  flush - flush the cache contents
 //-------------------------------------------------
@@ -68,6 +101,31 @@ void drc_cache::flush()
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+	m_flushes++;
+
+	// all regions are now empty
+	for (cache_region &region : m_region)
+	{
+		region.top = region.base;
+		region.pinned = false;
+	}
+	m_curregion = 0;
+	m_pinregion = -1;
+	m_pintop = nullptr;
+}
+
+
+//-------------------------------------------------
+//  region_top - return the top of allocations in
+//  the region containing the given pointer
+//-------------------------------------------------
+
+drccodeptr drc_cache::region_top(const void *ptr) const
+{
+	for (int regnum = 0; regnum < m_region.size(); regnum++)
+		if ((const drccodeptr)ptr >= m_region[regnum].base && (const drccodeptr)ptr < region_end(regnum))
+			return (regnum == m_curregion) ? m_top : m_region[regnum].top;
+	return m_top;
 }
 
 
@@ -92,9 +150,10 @@ void *drc_cache::alloc(size_t bytes)
 		}
 	}
 
-	// if no space, we just fail
+	// if no space, we just fail; permanent memory comes off the end of the last region
+	int lastregion = m_region.size() - 1;
 	drccodeptr ptr = (drccodeptr)ALIGN_PTR_DOWN(m_end - bytes);
-	if (m_top > ptr)
+	if (ptr < m_region[lastregion].base || ((lastregion == m_curregion) ? m_top : m_region[lastregion].top) > ptr)
 		return nullptr;
 
 	// otherwise update the end of the cache
@@ -145,17 +204,70 @@ void *drc_cache::alloc_temporary(size_t bytes)
 	// can't allocate in the middle of codegen
 	assert(m_codegen == nullptr);
 
-	// if no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + bytes >= m_end)
+	// if no space, move on to the next region; if that fails too, we just fail
+	if (m_top + bytes >= region_end(m_curregion) && !advance_region(bytes))
 		return nullptr;
 
 	// otherwise, update the cache top
+	drccodeptr ptr = m_top;
 	m_top = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
 	return ptr;
 }
 
 
+//-------------------------------------------------
+//  alloc_pinned - allocate memory that must
+//  survive until the next flush; it is packed
+//  into whole regions claimed for the purpose,
+//  rather than pinning whichever region code
+//  happens to be going into
+//-------------------------------------------------
+
+void *drc_cache::alloc_pinned(size_t bytes)
+{
+	// can't allocate in the middle of codegen
+	assert(m_codegen == nullptr);
+
+	// if the current pinned region is full, claim the oldest region we aren't generating into
+	if (m_pinregion == -1 || m_pintop + bytes > region_end(m_pinregion))
+	{
+		int regnum;
+		for (regnum = 0; regnum < m_region.size(); regnum++)
+			if (!m_region[regnum].pinned && regnum != m_curregion && m_region[regnum].base + bytes <= region_end(regnum))
+				break;
+
+		// with a single region, or nothing left to claim, pin wherever we are
+		if (regnum == m_region.size())
+		{
+			void *ptr = alloc_temporary(bytes);
+			if (ptr != nullptr)
+				m_region[m_curregion].pinned = true;
+			return ptr;
+		}
+
+		// unlink anything living there and pin it for good
+		cache_region &region = m_region[regnum];
+		if (region.top != region.base)
+		{
+			for (drc_evict_delegate &callback : m_evict_callbacks)
+				callback(region.base, region.top);
+			m_evictions++;
+			m_evicted_bytes += region.top - region.base;
+		}
+		region.pinned = true;
+		m_pinned_regions++;
+		m_pinregion = regnum;
+		m_pintop = region.base;
+	}
+
+	// carve off the allocation
+	drccodeptr ptr = m_pintop;
+	m_pintop = (drccodeptr)ALIGN_PTR_UP(ptr + bytes);
+	m_region[m_pinregion].top = m_pintop;
+	return ptr;
+}
+
+
 //-------------------------------------------------
 //  free - release permanent memory allocated from
 //  the cache
@@ -181,18 +293,19 @@ void drc_cache::dealloc(void *memory, size_t bytes)
 
 
 //-------------------------------------------------
-//  begin_codegen - begin code generation
+//  begin_codegen - begin code generation; data
+//  that must follow the previous block directly
+//  can ask to stay in the same region
 //-------------------------------------------------
 
-drccodeptr *drc_cache::begin_codegen(UINT32 reserve_bytes)
+drccodeptr *drc_cache::begin_codegen(UINT32 reserve_bytes, bool same_region)
 {
 	// can't restart in the middle of codegen
 	assert(m_codegen == nullptr);
 	assert(m_ooblist.first() == nullptr);
 
-	// if still no space, we just fail
-	drccodeptr ptr = m_top;
-	if (ptr + reserve_bytes >= m_end)
+	// if no space, move on to the next region; if still no space, we just fail
+	if (m_top + reserve_bytes >= region_end(m_curregion) && (same_region || !advance_region(reserve_bytes)))
 		return nullptr;
 
 	// otherwise, return a pointer to the cache top
@@ -223,6 +336,7 @@ drccodeptr drc_cache::end_codegen()
 
 	// update the cache top
 	m_top = (drccodeptr)ALIGN_PTR_UP(m_top);
+	m_generated_bytes += m_top - m_codegen;
 	m_codegen = nullptr;
 
 	return result;
@@ -250,3 +364,67 @@ void drc_cache::request_oob_codegen(drc_oob_delegate callback, void *param1, voi
 	// add to the tail
 	m_ooblist.append(*oob);
 }
+
+
+//-------------------------------------------------
+//  split_regions - divide the transient part of
+//  the cache into equal, empty regions
+//-------------------------------------------------
+
+void drc_cache::split_regions(int regions)
+{
+	m_region.resize(regions);
+	for (int regnum = 0; regnum < regions; regnum++)
+	{
+		m_region[regnum].base = (drccodeptr)ALIGN_PTR_UP(m_base + (m_end - m_base) * regnum / regions);
+		m_region[regnum].top = m_region[regnum].base;
+		m_region[regnum].pinned = false;
+		if (regnum > 0)
+			m_region[regnum - 1].end = m_region[regnum].base;
+	}
+	m_region[regions - 1].end = m_end;
+	m_curregion = 0;
+	m_pinregion = -1;
+	m_pintop = nullptr;
+}
+
+
+//-------------------------------------------------
+//  advance_region - switch to the oldest region
+//  that isn't pinned, evicting whatever it holds
+//-------------------------------------------------
+
+bool drc_cache::advance_region(size_t bytes)
+{
+	// remember where we got to in the current region
+	m_region[m_curregion].top = m_top;
+
+	// regions are reused in order, so the one after us is always the oldest
+	for (int count = 1; count < m_region.size(); count++)
+	{
+		int regnum = (m_curregion + count) % m_region.size();
+		cache_region &region = m_region[regnum];
+		if (region.pinned || region.base + bytes >= region_end(regnum))
+			continue;
+
+		// let everyone unlink anything pointing into the region
+		if (region.top != region.base)
+		{
+			for (drc_evict_delegate &callback : m_evict_callbacks)
+				callback(region.base, region.top);
+			m_evictions++;
+			m_evicted_bytes += region.top - region.base;
+			region.top = region.base;
+		}
+
+		// and start allocating from it
+		m_curregion = regnum;
+		m_top = region.base;
+		return true;
+	}
+
+	// with a single region, running out is the normal trigger for a flush
+	if (m_region.size() > 1)
+		m_advance_failures++;
+	return false;
+}
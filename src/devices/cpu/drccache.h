@@ -36,6 +36,9 @@ typedef UINT8 *drccodeptr;
 // helper template for oob codegen
 typedef delegate<void (drccodeptr *, void *, void *)> drc_oob_delegate;
 
+// callback to unlink code from a region that is about to be reused
+typedef delegate<void (drccodeptr, drccodeptr)> drc_evict_delegate;
+
 
 // drc_cache
 class drc_cache
@@ -49,6 +52,15 @@ public:
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
 	drccodeptr top() const { return m_top; }
+	drccodeptr region_top(const void *ptr) const;
+
+	// statistics
+	UINT32 flushes() const { return m_flushes; }
+	UINT32 evictions() const { return m_evictions; }
+	UINT64 evicted_bytes() const { return m_evicted_bytes; }
+	UINT64 generated_bytes() const { return m_generated_bytes; }
+	UINT32 advance_failures() const { return m_advance_failures; }
+	UINT32 pinned_regions() const { return m_pinned_regions; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
@@ -60,14 +72,25 @@ public:
 	void *alloc(size_t bytes);
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
+	void *alloc_pinned(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
 
+	// eviction
+	void set_eviction(bool enable);
+	void add_evict_callback(drc_evict_delegate callback) { m_evict_callbacks.push_back(callback); }
+	void pin_current() { m_region[m_curregion].pinned = true; }
+
 	// codegen helpers
-	drccodeptr *begin_codegen(UINT32 reserve_bytes);
+	drccodeptr *begin_codegen(UINT32 reserve_bytes, bool same_region = false);
 	drccodeptr end_codegen();
 	void request_oob_codegen(drc_oob_delegate callback, void *param1 = nullptr, void *param2 = nullptr);
 
 private:
+	// internal helpers
+	drccodeptr region_end(int regnum) const { return (regnum == m_region.size() - 1) ? m_end : m_region[regnum].end; }
+	void split_regions(int regions);
+	bool advance_region(size_t bytes);
+
 	// largest block of code that can be generated at once
 	static const size_t CODEGEN_MAX_BYTES = 65536;
 
@@ -80,6 +103,12 @@ private:
 	// size of "near" area at the base of the cache
 	static const size_t NEAR_CACHE_SIZE = 65536;
 
+	// number of regions the transient part of the cache is split into
+	static const int REGION_COUNT = 8;
+
+	// smallest region we'll split the cache into
+	static const size_t MIN_REGION_SIZE = 1024 * 1024;
+
 	// core parameters
 	drccodeptr          m_near;             // pointer to the near part of the cache
 	drccodeptr          m_neartop;          // top of the near part of the cache
@@ -101,6 +130,28 @@ private:
 	};
 	simple_list<oob_handler> m_ooblist;     // list of oob handlers
 
+	// regions of the transient cache, reused oldest first
+	struct cache_region
+	{
+		drccodeptr      base;               // start of the region
+		drccodeptr      end;                // end of the region
+		drccodeptr      top;                // top of allocations, when not the current region
+		bool            pinned;             // true if the region holds code that must not be evicted
+	};
+	std::vector<cache_region> m_region;     // list of regions
+	int                 m_curregion;        // region we are currently allocating from
+	int                 m_pinregion;        // region pinned allocations come from, or -1
+	drccodeptr          m_pintop;           // top of pinned allocations in that region
+	std::vector<drc_evict_delegate> m_evict_callbacks; // callbacks to unlink evicted code
+
+	// statistics
+	UINT32              m_flushes;          // number of full flushes
+	UINT32              m_evictions;        // number of regions evicted
+	UINT64              m_evicted_bytes;    // bytes of code and data evicted
+	UINT64              m_generated_bytes;  // bytes of code generated
+	UINT32              m_advance_failures; // number of times no region could be reused
+	UINT32              m_pinned_regions;   // number of regions claimed for pinned allocations
+
 	// free lists
 	struct free_link
 	{
@@ -16,6 +16,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "drcfe.h"
 
 
@@ -25,6 +26,11 @@
 
 const UINT32 MAX_STACK_DEPTH = 100;
 
+// persistent cache file parameters
+const char DRC_CACHE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 0 };
+const UINT32 DRC_CACHE_VERSION = 2;
+const UINT32 DRC_CACHE_MAX_BLOCKS = 8192;
+
 
 
 //**************************************************************************
@@ -55,8 +61,18 @@ drc_frontend::drc_frontend(device_t &cpu, UINT32 window_start, UINT32 window_end
 		m_cpudevice(downcast<cpu_device &>(cpu)),
 		m_program(m_cpudevice.space(AS_PROGRAM)),
 		m_pageshift(m_cpudevice.space_config(AS_PROGRAM)->m_page_shift),
-		m_desc_array(window_end + window_start + 2, nullptr)
+		m_desc_array(window_end + window_start + 2, nullptr),
+		m_cache_enabled(cpu.machine().options().drc_cache()),
+		m_cache_dirty(false),
+		m_cache_hits(0),
+		m_cache_invalid(0)
 {
+	// load any persistent cache and arrange to write it back on exit
+	if (m_cache_enabled)
+	{
+		cache_load();
+		cpu.machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(drc_frontend::cache_save), this));
+	}
 }
 
 
@@ -74,14 +90,44 @@ drc_frontend::~drc_frontend()
 //-------------------------------------------------
 //  describe_code - describe a sequence of code
 //  that falls within the configured window
-//  relative to the specified startpc
+//  relative to the specified startpc; the end of
+//  the window can be scaled up for superblocks,
+//  and the mode keeps blocks compiled for
+//  different CPU states apart in the cache
 //-------------------------------------------------
 
-const opcode_desc *drc_frontend::describe_code(offs_t startpc)
+const opcode_desc *drc_frontend::describe_code(offs_t startpc, UINT32 window_scale, UINT8 mode)
 {
 	// release any descriptions we've accumulated
 	release_descriptions();
 
+	// use the persistent cache if we can
+	assert(window_scale < 0x100);
+	UINT64 cachekey = (UINT64(mode) << 40) | (UINT64(window_scale) << 32) | startpc;
+	if (m_cache_enabled)
+	{
+		auto found = m_cache_blocks.find(cachekey);
+		if (found != m_cache_blocks.end())
+		{
+			if (cache_restore(found->second))
+			{
+				m_cache_hits++;
+				return m_desc_live_list.first();
+			}
+
+			// the code changed underneath us; drop the entry and describe it afresh
+			release_descriptions();
+			m_cache_blocks.erase(found);
+			m_cache_invalid++;
+			m_cache_dirty = true;
+		}
+	}
+
+	// grow the description array if we need a bigger window
+	UINT32 window_end = m_window_end * window_scale;
+	if (m_desc_array.size() < window_end + m_window_start + 2)
+		m_desc_array.resize(window_end + m_window_start + 2, nullptr);
+
 	// add the initial PC to the stack
 	pc_stack_entry pcstack[MAX_STACK_DEPTH];
 	pc_stack_entry *pcstackptr = &pcstack[0];
@@ -91,7 +137,7 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 
 	// loop while we still have a stack
 	offs_t minpc = startpc - MIN(m_window_start, startpc);
-	offs_t maxpc = startpc + MIN(m_window_end, 0xffffffff - startpc);
+	offs_t maxpc = startpc + MIN(window_end, 0xffffffff - startpc);
 	while (pcstackptr != &pcstack[0])
 	{
 		// if we've already hit this PC, just mark it a branch target and continue
@@ -146,6 +192,10 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 	// first from startpc -> maxpc, then from minpc -> startpc
 	build_sequence(startpc - minpc, maxpc - minpc, OPFLAG_REDISPATCH);
 	build_sequence(minpc - minpc, startpc - minpc, OPFLAG_RETURN_TO_START);
+
+	// remember the result for later runs
+	if (m_cache_enabled)
+		cache_store(cachekey);
 	return m_desc_live_list.first();
 }
 
@@ -376,3 +426,257 @@ void drc_frontend::release_descriptions()
 	// reclaim all the descriptors
 	m_desc_allocator.reclaim_all(m_desc_live_list);
 }
+
+
+
+//-------------------------------------------------
+//  cache_filename - return the name of the
+//  persistent cache file for this CPU, relative
+//  to the cache directory
+//-------------------------------------------------
+
+std::string drc_frontend::cache_filename() const
+{
+	std::string tag = m_cpudevice.tag() + 1;
+	strreplacechr(tag, ':', '_');
+	return string_format("%s%s%s.drc", m_cpudevice.machine().basename(), PATH_SEPARATOR, tag.c_str());
+}
+
+
+//-------------------------------------------------
+//  cache_load - read the persistent cache for
+//  this CPU, if there is a valid one
+//-------------------------------------------------
+
+void drc_frontend::cache_load()
+{
+	emu_file file(m_cpudevice.machine().options().drc_cache_directory(), OPEN_FLAG_READ);
+	if (file.open(cache_filename().c_str()) != osd_file::error::NONE)
+		return;
+
+	// validate the header; anything else is silently ignored and rebuilt
+	char magic[8];
+	UINT32 header[3];
+	if (file.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, DRC_CACHE_MAGIC, sizeof(magic)) != 0)
+		return;
+	if (file.read(header, sizeof(header)) != sizeof(header) || header[0] != DRC_CACHE_VERSION || header[1] != sizeof(cached_desc))
+		return;
+
+	// read the blocks; a count that doesn't fit what is left of the file, or a block that
+	// couldn't have been built with our window, means the whole file is rejected
+	bool valid = (header[2] <= DRC_CACHE_MAX_BLOCKS);
+	for (UINT32 blocknum = 0; valid && blocknum < header[2]; blocknum++)
+	{
+		UINT32 blockheader[4];
+		if (file.read(blockheader, sizeof(blockheader)) != sizeof(blockheader) || blockheader[3] == 0 || blockheader[3] > (file.size() - file.tell()) / sizeof(cached_desc))
+		{
+			valid = false;
+			break;
+		}
+
+		cached_block &block = m_cache_blocks[(UINT64(blockheader[1]) << 32) | blockheader[0]];
+		block.crc = blockheader[2];
+		block.descs.resize(blockheader[3]);
+		UINT32 bytes = blockheader[3] * sizeof(cached_desc);
+		valid = (file.read(&block.descs[0], bytes) == bytes && cache_block_valid(block));
+	}
+	if (!valid)
+	{
+		osd_printf_verbose("%s: ignoring damaged DRC cache file %s\n", m_cpudevice.tag(), file.fullpath());
+		m_cache_blocks.clear();
+		return;
+	}
+	osd_printf_verbose("%s: loaded %d DRC cache blocks\n", m_cpudevice.tag(), int(m_cache_blocks.size()));
+}
+
+
+//-------------------------------------------------
+//  cache_block_valid - return true if a block
+//  read from the persistent cache has a shape
+//  describe_code could have produced: no more
+//  instructions than the window holds, each
+//  followed by at most its own delay slots
+//-------------------------------------------------
+
+bool drc_frontend::cache_block_valid(const cached_block &block) const
+{
+	size_t heads = 0;
+	for (size_t index = 0; index < block.descs.size(); index += 1 + block.descs[index].numdelay)
+	{
+		const cached_desc &desc = block.descs[index];
+		if (++heads > m_desc_array.size() || desc.numdelay > desc.delayslots || index + desc.numdelay >= block.descs.size())
+			return false;
+		for (int slotnum = 1; slotnum <= desc.numdelay; slotnum++)
+			if (block.descs[index + slotnum].numdelay != 0)
+				return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  cache_save - write the persistent cache back
+//  out if it has changed
+//-------------------------------------------------
+
+void drc_frontend::cache_save()
+{
+	osd_printf_verbose("%s: DRC cache %d blocks, %u hits, %u invalidated\n", m_cpudevice.tag(), int(m_cache_blocks.size()), m_cache_hits, m_cache_invalid);
+	if (!m_cache_dirty)
+		return;
+
+	emu_file file(m_cpudevice.machine().options().drc_cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(cache_filename().c_str()) != osd_file::error::NONE)
+		return;
+
+	// write the header
+	UINT32 header[3] = { DRC_CACHE_VERSION, sizeof(cached_desc), UINT32(m_cache_blocks.size()) };
+	file.write(DRC_CACHE_MAGIC, sizeof(DRC_CACHE_MAGIC));
+	file.write(header, sizeof(header));
+
+	// then each block
+	for (auto &entry : m_cache_blocks)
+	{
+		// the upper half of the key holds the mode and window scale
+		UINT32 blockheader[4] = { UINT32(entry.first), UINT32(entry.first >> 32), entry.second.crc, UINT32(entry.second.descs.size()) };
+		file.write(blockheader, sizeof(blockheader));
+		file.write(&entry.second.descs[0], entry.second.descs.size() * sizeof(cached_desc));
+	}
+	m_cache_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  cache_checksum - accumulate a CRC of the code
+//  behind a description; returns false if the
+//  code is not in directly readable memory or
+//  is no longer mapped at the same place
+//-------------------------------------------------
+
+bool drc_frontend::cache_checksum(const opcode_desc &desc, crc32_creator &crc)
+{
+	// the virtual->physical mapping must be unchanged
+	offs_t physpc = desc.pc;
+	if (!m_cpudevice.translate(AS_PROGRAM, TRANSLATE_FETCH, physpc) || physpc != desc.physpc)
+		return false;
+
+	// sum whole aligned chunks so that any address XOR applied by the bus is covered
+	for (offs_t addr = desc.physpc & ~7; addr < desc.physpc + desc.length; addr += 8)
+	{
+		const void *base = m_program.direct().read_ptr(addr);
+		if (base == nullptr)
+			return false;
+		crc.append(base, 8);
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  cache_restore - rebuild the live description
+//  list from a cached block; returns false if
+//  the code no longer matches
+//-------------------------------------------------
+
+bool drc_frontend::cache_restore(const cached_block &block)
+{
+	opcode_desc *branch = nullptr;
+	int delayleft = 0;
+	for (const cached_desc &cached : block.descs)
+	{
+		opcode_desc *desc = m_desc_allocator.alloc();
+		desc->m_next = nullptr;
+		desc->branch = nullptr;
+		desc->delay.reset();
+		desc->pc = cached.pc;
+		desc->physpc = cached.physpc;
+		desc->targetpc = cached.targetpc;
+		memcpy(&desc->opptr, cached.opptr, sizeof(desc->opptr));
+		desc->length = cached.length;
+		desc->delayslots = cached.delayslots;
+		desc->skipslots = cached.skipslots;
+		desc->flags = cached.flags;
+		desc->cycles = cached.cycles;
+		memcpy(desc->regin, cached.regin, sizeof(desc->regin));
+		memcpy(desc->regout, cached.regout, sizeof(desc->regout));
+		memcpy(desc->regreq, cached.regreq, sizeof(desc->regreq));
+
+		// delay slots hang off the preceding branch
+		if (delayleft > 0)
+		{
+			desc->branch = branch;
+			branch->delay.append(*desc);
+			delayleft--;
+		}
+		else
+		{
+			m_desc_live_list.append(*desc);
+			branch = desc;
+			delayleft = cached.numdelay;
+		}
+	}
+
+	// make sure the code is still what we described
+	crc32_creator crc;
+	for (const opcode_desc *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+	{
+		if (!cache_checksum(*desc, crc))
+			return false;
+		for (const opcode_desc *delay = desc->delay.first(); delay != nullptr; delay = delay->next())
+			if (!cache_checksum(*delay, crc))
+				return false;
+	}
+	return crc.finish() == block.crc;
+}
+
+
+//-------------------------------------------------
+//  cache_store - add the current description
+//  list to the persistent cache
+//-------------------------------------------------
+
+void drc_frontend::cache_store(UINT64 key)
+{
+	if (m_cache_blocks.size() >= DRC_CACHE_MAX_BLOCKS)
+		return;
+
+	cached_block block;
+	crc32_creator crc;
+	for (const opcode_desc *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+	{
+		// flatten the description followed by its delay slots
+		const opcode_desc *cur = desc;
+		const opcode_desc *nextdelay = desc->delay.first();
+		while (cur != nullptr)
+		{
+			// blocks that faulted or live outside of direct memory aren't worth keeping
+			if ((cur->flags & (OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_COMPILER_UNMAPPED)) != 0 || !cache_checksum(*cur, crc))
+				return;
+
+			cached_desc cached;
+			memset(&cached, 0, sizeof(cached));
+			cached.pc = cur->pc;
+			cached.physpc = cur->physpc;
+			cached.targetpc = cur->targetpc;
+			memcpy(cached.opptr, &cur->opptr, sizeof(cached.opptr));
+			cached.flags = cur->flags;
+			cached.cycles = cur->cycles;
+			memcpy(cached.regin, cur->regin, sizeof(cached.regin));
+			memcpy(cached.regout, cur->regout, sizeof(cached.regout));
+			memcpy(cached.regreq, cur->regreq, sizeof(cached.regreq));
+			cached.length = cur->length;
+			cached.delayslots = cur->delayslots;
+			cached.skipslots = cur->skipslots;
+			cached.numdelay = (cur == desc) ? desc->delay.count() : 0;
+			block.descs.push_back(cached);
+
+			cur = nextdelay;
+			if (nextdelay != nullptr)
+				nextdelay = nextdelay->next();
+		}
+	}
+
+	block.crc = crc.finish();
+	m_cache_blocks[key] = std::move(block);
+	m_cache_dirty = true;
+}
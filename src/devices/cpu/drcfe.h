@@ -27,6 +27,15 @@
     walkthrough is finished, these descriptions are assembled together into
     a linked list and returned for further processing by the backend.
 
+    When -drc_cache is enabled, the descriptions for each block are also
+    kept in a per-driver, per-CPU file, so later runs can skip walking
+    the code again. Blocks are keyed by start PC, window scale and the
+    caller's compile mode, so code that decodes differently depending on
+    CPU state (ARM vs. Thumb, for instance) never shares an entry. Each
+    cached block records a CRC of the code it was
+    built from; if the code or its virtual->physical mapping differs,
+    the entry is dropped and the block is described from scratch.
+
 ***************************************************************************/
 
 #pragma once
@@ -131,19 +140,53 @@ public:
 	virtual ~drc_frontend();
 
 	// describe a block
-	const opcode_desc *describe_code(offs_t startpc);
+	const opcode_desc *describe_code(offs_t startpc, UINT32 window_scale = 1, UINT8 mode = 0);
 
 protected:
 	// required overrides
 	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) = 0;
 
 private:
+	// a description as stored in the persistent cache
+	struct cached_desc
+	{
+		offs_t          pc;                     // PC of this opcode
+		offs_t          physpc;                 // physical PC of this opcode
+		offs_t          targetpc;               // target PC if we are a branch
+		UINT32          opptr[4];               // copy of the opcode
+		UINT32          flags;                  // OPFLAG_* opcode flags
+		UINT32          cycles;                 // number of cycles needed to execute
+		UINT32          regin[4];               // input registers
+		UINT32          regout[4];              // output registers
+		UINT32          regreq[4];              // required output registers
+		UINT8           length;                 // length in bytes of this opcode
+		UINT8           delayslots;             // number of delay slots
+		UINT8           skipslots;              // number of skip slots
+		UINT8           numdelay;               // number of delay slot descriptions that follow
+	};
+
+	// a block of descriptions as stored in the persistent cache
+	struct cached_block
+	{
+		UINT32          crc;                    // CRC of the code the block was built from
+		std::vector<cached_desc> descs;         // flattened list of descriptions
+	};
+
 	// internal helpers
 	opcode_desc *describe_one(offs_t curpc, const opcode_desc *prevdesc);
 	void build_sequence(int start, int end, UINT32 endflag);
 	void accumulate_required_backwards(opcode_desc &desc, UINT32 *reqmask);
 	void release_descriptions();
 
+	// persistent cache helpers
+	std::string cache_filename() const;
+	void cache_load();
+	void cache_save();
+	bool cache_block_valid(const cached_block &block) const;
+	bool cache_checksum(const opcode_desc &desc, crc32_creator &crc);
+	bool cache_restore(const cached_block &block);
+	void cache_store(UINT64 key);
+
 	// configuration parameters
 	UINT32              m_window_start;             // code window start offset = startpc - window_start
 	UINT32              m_window_end;               // code window end offset = startpc + window_end
@@ -158,6 +201,13 @@ private:
 	simple_list<opcode_desc> m_desc_live_list;      // list of live descriptions
 	fixed_allocator<opcode_desc> m_desc_allocator;  // fixed allocator for descriptions
 	std::vector<opcode_desc *> m_desc_array;      // array of descriptions in PC order
+
+	// persistent cache
+	bool                m_cache_enabled;            // true if the persistent cache is in use
+	bool                m_cache_dirty;              // true if the cache needs to be written back
+	std::unordered_map<UINT64, cached_block> m_cache_blocks; // cached blocks, by mode/window scale/start PC
+	UINT32              m_cache_hits;               // number of blocks restored from the cache
+	UINT32              m_cache_invalid;            // number of cached blocks that no longer matched
 };
 
 
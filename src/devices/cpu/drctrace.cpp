@@ -0,0 +1,243 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drctrace.cpp
+
+    Execution profiling for dynamic recompiling CPU cores, used to form
+    superblocks out of hot code and chain hot dynamic exits.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drctrace.h"
+#include "drcumlsh.h"
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  DRC TRACE PROFILE
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_trace_profile - constructor
+//-------------------------------------------------
+
+drc_trace_profile::drc_trace_profile(device_t &device, drc_cache &cache, bool enabled)
+	: m_device(device),
+		m_cache(cache),
+		m_enabled(enabled),
+		m_pool(nullptr),
+		m_poolleft(0),
+		m_superblocks(0),
+		m_chained(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~drc_trace_profile - destructor
+//-------------------------------------------------
+
+drc_trace_profile::~drc_trace_profile()
+{
+	// report what we found
+	if (m_enabled && !m_blocks.empty())
+		osd_printf_verbose("%s", report(10).c_str());
+}
+
+
+//-------------------------------------------------
+//  superblock - return true if the block at the
+//  given mode/pc should be compiled as a
+//  superblock
+//-------------------------------------------------
+
+bool drc_trace_profile::superblock(UINT32 mode, offs_t pc)
+{
+	if (!m_enabled)
+		return false;
+
+	// once a block gets hot, it stays a superblock
+	drc_trace_entry &entry = find_or_allocate(m_blocks, mode, pc);
+	if (!entry.superblock && entry.entries != nullptr && *entry.entries >= DRC_TRACE_HOT_ENTRIES)
+	{
+		entry.superblock = true;
+		m_superblocks++;
+	}
+	return entry.superblock;
+}
+
+
+//-------------------------------------------------
+//  generate_block_entry - generate code to count
+//  entries into a block, and to recompile it
+//  via the nocode handler once it is hot
+//-------------------------------------------------
+
+void drc_trace_profile::generate_block_entry(drcuml_block *block, UINT32 mode, offs_t pc, code_handle &nocode, parameter exp)
+{
+	if (!m_enabled)
+		return;
+
+	drc_trace_entry &entry = find_or_allocate(m_blocks, mode, pc);
+	entry.compiles++;
+
+	// blocks we have no room to count are left alone
+	if (entry.entries == nullptr)
+		entry.entries = (UINT32 *)alloc_counters(sizeof(*entry.entries));
+	if (entry.entries == nullptr)
+		return;
+
+	UML_ADD(block, mem(entry.entries), mem(entry.entries), 1);                          // add     [entries],[entries],1
+	if (!entry.superblock)
+	{
+		UML_CMP(block, mem(entry.entries), DRC_TRACE_HOT_ENTRIES);                      // cmp     [entries],DRC_TRACE_HOT_ENTRIES
+		UML_EXHc(block, COND_E, nocode, exp);                                           // exh     nocode,exp,e
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_dynamic_exit - generate a hashjmp to
+//  a dynamic target, either recording where it
+//  goes or, if it is stable, jumping directly to
+//  the predicted target
+//-------------------------------------------------
+
+void drc_trace_profile::generate_dynamic_exit(drcuml_block *block, UINT32 mode, offs_t pc, parameter target, code_handle &nocode, code_label skip)
+{
+	drc_trace_entry *exit = m_enabled ? &find_or_allocate(m_exits, mode, pc) : nullptr;
+	if (exit != nullptr)
+	{
+		exit->compiles++;
+		if (exit->exit == nullptr)
+			exit->exit = (drc_trace_exit_counters *)alloc_counters(sizeof(*exit->exit));
+	}
+
+	// exits we have no room to count are left alone
+	if (exit != nullptr && exit->exit != nullptr)
+	{
+		drc_trace_exit_counters &counters = *exit->exit;
+
+		// chain the exit if it has gone to the same place nearly every time
+		if (!exit->chained && counters.exits >= DRC_TRACE_CHAIN_MIN_EXITS && counters.target_changes * DRC_TRACE_CHAIN_MAX_CHANGES <= counters.exits)
+		{
+			exit->chained = true;
+			exit->chain_target = counters.target;
+			m_chained++;
+		}
+
+		// chained exits go through the predicted target's hash slot when they match
+		if (exit->chained)
+		{
+			UML_CMP(block, target, exit->chain_target);                                 // cmp     target,chain_target
+			UML_JMPc(block, COND_NE, skip);                                             // jmp     skip,ne
+			UML_HASHJMP(block, mode, exit->chain_target, nocode);                       // hashjmp mode,chain_target,nocode
+			UML_LABEL(block, skip);                                                     // skip:
+			UML_ADD(block, mem(&counters.chain_misses), mem(&counters.chain_misses), 1); // add   [chain_misses],[chain_misses],1
+		}
+
+		// others remember where they went
+		else
+		{
+			UML_ADD(block, mem(&counters.exits), mem(&counters.exits), 1);              // add     [exits],[exits],1
+			UML_CMP(block, target, mem(&counters.target));                              // cmp     target,[target]
+			UML_JMPc(block, COND_E, skip);                                              // jmp     skip,e
+			UML_MOV(block, mem(&counters.target), target);                              // mov     [target],target
+			UML_ADD(block, mem(&counters.target_changes), mem(&counters.target_changes), 1); // add [target_changes],[target_changes],1
+			UML_LABEL(block, skip);                                                     // skip:
+		}
+	}
+
+	UML_HASHJMP(block, mode, target, nocode);                                           // hashjmp mode,target,nocode
+}
+
+
+//-------------------------------------------------
+//  report - return a summary of the profile,
+//  listing the hottest blocks
+//-------------------------------------------------
+
+std::string drc_trace_profile::report(int maxentries) const
+{
+	// total up the blocks and exits that got counters
+	UINT32 blocks = 0, exits = 0, chainmisses = 0;
+	for (auto &block : m_blocks)
+		if (block.second.entries != nullptr)
+			blocks++;
+	for (auto &exit : m_exits)
+		if (exit.second.exit != nullptr)
+		{
+			exits++;
+			chainmisses += exit.second.exit->chain_misses;
+		}
+
+	std::string result = string_format("%s: %u blocks profiled, %u superblocks, %u of %u dynamic exits chained (%u misses)\n",
+			m_device.tag(), blocks, m_superblocks, m_chained, exits, chainmisses);
+	if (blocks < m_blocks.size() || exits < m_exits.size())
+		result.append(string_format("  near cache full: %u blocks and %u exits not profiled\n",
+				UINT32(m_blocks.size()) - blocks, UINT32(m_exits.size()) - exits));
+
+	// find the hottest blocks
+	std::vector<const drc_trace_entry *> sorted;
+	for (auto &block : m_blocks)
+		if (block.second.entries != nullptr)
+			sorted.push_back(&block.second);
+	int count = MIN(maxentries, int(sorted.size()));
+	std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(),
+			[](const drc_trace_entry *a, const drc_trace_entry *b) { return *a->entries > *b->entries; });
+
+	for (int index = 0; index < count; index++)
+		result.append(string_format("  %08X mode %u: %10u entries, %u compiles%s\n",
+				sorted[index]->pc, sorted[index]->mode, *sorted[index]->entries, sorted[index]->compiles,
+				sorted[index]->superblock ? " (superblock)" : ""));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  find_or_allocate - find the entry for the
+//  given mode/pc, creating it if needed
+//-------------------------------------------------
+
+drc_trace_entry &drc_trace_profile::find_or_allocate(std::unordered_map<UINT64, drc_trace_entry> &map, UINT32 mode, offs_t pc)
+{
+	auto found = map.find((UINT64(mode) << 32) | pc);
+	if (found != map.end())
+		return found->second;
+
+	drc_trace_entry &entry = map[(UINT64(mode) << 32) | pc];
+	memset(&entry, 0, sizeof(entry));
+	entry.mode = mode;
+	entry.pc = pc;
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  alloc_counters - carve zeroed counters out of
+//  the near part of the cache, returning nullptr
+//  once it is full
+//-------------------------------------------------
+
+void *drc_trace_profile::alloc_counters(size_t bytes)
+{
+	// claim another chunk if this one is used up
+	if (m_poolleft < bytes)
+	{
+		m_pool = (UINT8 *)m_cache.alloc_near(DRC_TRACE_POOL_CHUNK);
+		m_poolleft = (m_pool != nullptr) ? DRC_TRACE_POOL_CHUNK : 0;
+		if (m_pool != nullptr)
+			memset(m_pool, 0, DRC_TRACE_POOL_CHUNK);
+	}
+	if (m_poolleft < bytes)
+		return nullptr;
+
+	void *result = m_pool;
+	m_pool += bytes;
+	m_poolleft -= bytes;
+	return result;
+}
@@ -0,0 +1,139 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drctrace.h
+
+    Execution profiling for dynamic recompiling CPU cores, used to form
+    superblocks out of hot code and chain hot dynamic exits.
+
+****************************************************************************
+
+    Concepts:
+
+    Every block a front-end compiles counts how often it is entered, and
+    every exit through a dynamic target (a jump through a register) keeps
+    track of where it went last and how often that changed. The counters
+    that generated code updates are carved out of the near part of the
+    code cache, so every back-end can address them directly; they are
+    never freed, so they survive cache flushes. Once the near part is
+    full, new blocks and exits are simply not profiled.
+
+    When a block has been entered DRC_TRACE_HOT_ENTRIES times, it exits
+    through the front-end's "no code" handler, which recompiles it as a
+    superblock: the front-end describes it with a wider code window, so
+    more of the surrounding code is pulled in and more branches stay
+    within the block instead of going back through the hash table.
+
+    While recompiling, any dynamic exit that has nearly always gone to
+    the same place is "chained": the front-end compares the target
+    against that PC and, if it matches, jumps straight through the hash
+    slot for the predicted target instead of doing a full lookup.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __DRCTRACE_H__
+#define __DRCTRACE_H__
+
+#include "drcuml.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// number of entries before a block is recompiled as a superblock
+const UINT32 DRC_TRACE_HOT_ENTRIES          = 2000;
+
+// number of observations before a dynamic exit can be chained
+const UINT32 DRC_TRACE_CHAIN_MIN_EXITS      = 64;
+
+// maximum fraction of target changes (1/n) for a dynamic exit to be chained
+const UINT32 DRC_TRACE_CHAIN_MAX_CHANGES    = 16;
+
+// factor by which the code window is grown for superblocks
+const UINT32 DRC_TRACE_SUPERBLOCK_SCALE     = 4;
+
+// bytes of near cache claimed at a time for counters
+const UINT32 DRC_TRACE_POOL_CHUNK           = 1024;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// counters updated by generated code for a dynamic exit; lives in the near cache
+struct drc_trace_exit_counters
+{
+	UINT32          exits;                  // number of times the exit was taken while profiling
+	UINT32          target;                 // most recently observed target
+	UINT32          target_changes;         // number of times the target changed
+	UINT32          chain_misses;           // number of times the prediction failed
+};
+
+
+// profile for a single block entry point or dynamic exit
+struct drc_trace_entry
+{
+	UINT32          mode;                   // mode of the block or exit
+	offs_t          pc;                     // PC of the block or of the exiting instruction
+	UINT32          compiles;               // number of times code was generated for it
+
+	// block entry state
+	UINT32 *        entries;                // number of times the block was entered (near cache, or nullptr)
+	bool            superblock;             // true if compiled as a superblock
+
+	// dynamic exit state
+	drc_trace_exit_counters *exit;          // exit counters (near cache, or nullptr)
+	bool            chained;                // true if a direct jump to chain_target was generated
+	UINT32          chain_target;           // predicted target of the chained jump
+};
+
+
+// ======================> drc_trace_profile
+
+// trace profile for a single CPU
+class drc_trace_profile
+{
+public:
+	// construction/destruction
+	drc_trace_profile(device_t &device, drc_cache &cache, bool enabled);
+	~drc_trace_profile();
+
+	// getters
+	bool enabled() const { return m_enabled; }
+	const std::unordered_map<UINT64, drc_trace_entry> &blocks() const { return m_blocks; }
+	const std::unordered_map<UINT64, drc_trace_entry> &exits() const { return m_exits; }
+
+	// decide how to compile a block
+	bool superblock(UINT32 mode, offs_t pc);
+
+	// code generation helpers
+	void generate_block_entry(drcuml_block *block, UINT32 mode, offs_t pc, uml::code_handle &nocode, uml::parameter exp);
+	void generate_dynamic_exit(drcuml_block *block, UINT32 mode, offs_t pc, uml::parameter target, uml::code_handle &nocode, uml::code_label miss);
+
+	// reporting
+	std::string report(int maxentries) const;
+
+private:
+	// internal helpers
+	drc_trace_entry &find_or_allocate(std::unordered_map<UINT64, drc_trace_entry> &map, UINT32 mode, offs_t pc);
+	void *alloc_counters(size_t bytes);
+
+	// internal state
+	device_t &                  m_device;           // device we are profiling
+	drc_cache &                 m_cache;            // cache holding the counters
+	bool                        m_enabled;          // true if profiling is enabled
+	UINT8 *                     m_pool;             // next free byte of near cache for counters
+	size_t                      m_poolleft;         // bytes left at m_pool
+	UINT32                      m_superblocks;      // number of superblocks compiled
+	UINT32                      m_chained;          // number of dynamic exits chained
+	std::unordered_map<UINT64, drc_trace_entry> m_blocks; // block entry counters, by mode/pc
+	std::unordered_map<UINT64, drc_trace_entry> m_exits;  // dynamic exit counters, by mode/pc
+};
+
+
+#endif /* __DRCTRACE_H__ */
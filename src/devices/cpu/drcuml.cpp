@@ -11,7 +11,8 @@
     Future improvements/changes:
 
     * UML optimizer:
-        - constant folding
+        - propagation across blocks, not just within straight-line runs
+        - register allocation for frequently used guest state
 
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
@@ -37,6 +38,8 @@
 #include "drcbec.h"
 #include "drcbex86.h"
 #include "drcbex64.h"
+#include "drcbearm64.h"
+#include "drcbeval.h"
 
 using namespace uml;
 
@@ -46,27 +49,10 @@ using namespace uml;
 //  DEBUGGING
 //**************************************************************************
 
-#define VALIDATE_BACKEND        (0)
 #define LOG_SIMPLIFICATIONS     (0)
 
 
 
-//**************************************************************************
-//  TYPE DEFINITIONS
-//**************************************************************************
-
-// structure describing back-end validation test
-struct bevalidate_test
-{
-	opcode_t                opcode;
-	UINT8                   size;
-	UINT8                   iflags;
-	UINT8                   flags;
-	UINT64                  param[4];
-};
-
-
-
 //**************************************************************************
 //  DRC BACKEND INTERFACE
 //**************************************************************************
@@ -116,15 +102,22 @@ drcbe_interface::~drcbe_interface()
 //  drcuml_state - constructor
 //-------------------------------------------------
 
-drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits)
+drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits, drcbe_type type)
 	: m_device(device),
 		m_cache(cache),
-		m_drcbe_interface(device.machine().options().drc_use_c() ?
+		m_drcbe_interface((type == DRCBE_C || (type == DRCBE_DEFAULT && device.machine().options().drc_use_c())) ?
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
-		m_umllog(nullptr)
+		m_umllog(nullptr),
+		m_optimize(device.machine().options().drc_optimize()),
+		m_validate(type == DRCBE_DEFAULT && device.machine().options().drc_validate())
 {
+	memset(&m_stats, 0, sizeof(m_stats));
+
+	// evicting old regions is opt-in; by default a full cache is flushed as before
+	m_cache.set_eviction(device.machine().options().drc_evict());
+
 	// if we're to log, create the logfile
 	if (device.machine().options().drc_log_uml())
 	{
@@ -140,6 +133,18 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 
 drcuml_state::~drcuml_state()
 {
+	// report how much code we generated
+	if (m_stats.blocks != 0)
+	{
+		osd_printf_verbose("%s: %u UML blocks, %u instructions optimized to %u (%.1f%%), %u host bytes\n",
+			m_device.tag(), UINT32(m_stats.blocks), UINT32(m_stats.instructions), UINT32(m_stats.optimized),
+			100.0 * double(m_stats.optimized) / double(m_stats.instructions), UINT32(m_stats.host_bytes));
+		osd_printf_verbose("%s: %u cache flushes, %u regions evicted (%u bytes), %u host bytes recompiled\n",
+			m_device.tag(), m_cache.flushes(), m_cache.evictions(), UINT32(m_cache.evicted_bytes()), UINT32(m_stats.recompiled_bytes));
+		osd_printf_verbose("%s: %u regions pinned for hash tables, %u allocations found no reusable region\n",
+			m_device.tag(), m_cache.pinned_regions(), m_cache.advance_failures());
+	}
+
 	// close any files
 	if (m_umllog != nullptr)
 		fclose(m_umllog);
@@ -163,19 +168,19 @@ void drcuml_state::reset()
 		for (code_handle *handle = m_handlelist.first(); handle != nullptr; handle = handle->next())
 			*handle->m_code = nullptr;
 
-		// call the backend to reset
+		// call the backend to reset; the entry points and exit stubs it
+		// generates are called directly, so they can never be evicted
 		m_beintf.reset();
+		m_cache.pin_current();
 
-		// do a one-time validation if requested
-/*      if (VALIDATE_BACKEND)
-        {
-            static bool validated = false;
-            if (!validated)
-            {
-                validated = true;
-                validate_backend(this);
-            }
-        }*/
+		// do a one-time validation if requested; the first recompiler
+		// to get here schedules the exit, so the rest can skip it
+		if (m_validate)
+		{
+			m_validate = false;
+			if (!m_device.machine().exit_pending())
+				validate_backends();
+		}
 	}
 	catch (drcuml_block::abort_compilation &)
 	{
@@ -184,6 +189,41 @@ void drcuml_state::reset()
 }
 
 
+//-------------------------------------------------
+//  validate_backends - compare the C and native
+//  back-ends, benchmark them, and exit
+//-------------------------------------------------
+
+void drcuml_state::validate_backends()
+{
+	drcbe_validator validator(m_device);
+	int failures = validator.check_known_results();
+	failures += validator.check_conformance();
+	validator.benchmark();
+	osd_printf_info("%s", validator.report().c_str());
+
+	if (failures != 0)
+		fatalerror("UML back-end validation failed with %d errors\n", failures);
+	m_device.machine().schedule_exit();
+}
+
+
+//-------------------------------------------------
+//  add_block_stats - account for a block that
+//  was generated
+//-------------------------------------------------
+
+void drcuml_state::add_block_stats(UINT32 instructions, UINT32 optimized, UINT32 host_bytes, bool recompiled)
+{
+	m_stats.blocks++;
+	m_stats.instructions += instructions;
+	m_stats.optimized += optimized;
+	m_stats.host_bytes += host_bytes;
+	if (recompiled)
+		m_stats.recompiled_bytes += host_bytes;
+}
+
+
 //-------------------------------------------------
 //  begin_block - begin a new code block
 //-------------------------------------------------
@@ -329,14 +369,35 @@ void drcuml_block::end()
 	assert(m_inuse);
 
 	// optimize the resulting code first
+	UINT32 numinst = m_nextinst;
 	optimize();
 
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
 		disassemble();
 
+	// note whether we've compiled any of this code before, and whether it defines handles
+	bool recompiled = false;
+	bool handles = false;
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	{
+		if (m_inst[instnum].opcode() == OP_HASH && m_drcuml.mark_compiled(m_inst[instnum].param(0).immediate(), m_inst[instnum].param(1).immediate()))
+			recompiled = true;
+		if (m_inst[instnum].opcode() == OP_HANDLE)
+			handles = true;
+	}
+
 	// generate the code via the back-end
+	UINT64 start = m_drcuml.cache().generated_bytes();
 	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+	UINT32 host_bytes = m_drcuml.cache().generated_bytes() - start;
+	m_drcuml.add_block_stats(numinst, m_nextinst, host_bytes, recompiled);
+
+	// code that handles point to can't be evicted, only flushed
+	if (handles)
+		m_drcuml.cache().pin_current();
+	if (m_drcuml.logging())
+		m_drcuml.log_printf("; %d UML instructions optimized to %d, %d host bytes\n\n", numinst, m_nextinst, host_bytes);
 
 	// block is no longer in use
 	m_inuse = false;
@@ -418,693 +479,472 @@ void drcuml_block::optimize()
 		// now that flags are correct, simplify the instruction
 		inst.simplify();
 	}
+
+	// run the additional passes if enabled
+	if (m_drcuml.optimizing())
+	{
+		propagate_values();
+		eliminate_dead_code();
+		remove_nops();
+	}
 }
 
 
 //-------------------------------------------------
-//  disassemble - disassemble a block of
-//  instructions to the log
+//  is_barrier - return true if an instruction
+//  can transfer control, be a branch target, or
+//  touch state behind the optimizer's back
 //-------------------------------------------------
 
-void drcuml_block::disassemble()
+static bool is_barrier(const instruction &inst)
 {
-	std::string comment;
-
-	// iterate over instructions and output
-	int firstcomment = -1;
-	for (int instnum = 0; instnum < m_nextinst; instnum++)
+	switch (inst.opcode())
 	{
-		const instruction &inst = m_inst[instnum];
-		bool flushcomments = false;
-
-		// remember comments and mapvars for later
-		if (inst.opcode() == OP_COMMENT || inst.opcode() == OP_MAPVAR)
-		{
-			if (firstcomment == -1)
-				firstcomment = instnum;
-		}
-
-		// print labels, handles, and hashes left justified
-		else if (inst.opcode() == OP_LABEL)
-			m_drcuml.log_printf("$%X:\n", UINT32(inst.param(0).label()));
-		else if (inst.opcode() == OP_HANDLE)
-			m_drcuml.log_printf("%s:\n", inst.param(0).handle().string());
-		else if (inst.opcode() == OP_HASH)
-			m_drcuml.log_printf("(%X,%X):\n", UINT32(inst.param(0).immediate()), UINT32(inst.param(1).immediate()));
-
-		// indent everything else with a tab
-		else
-		{
-			std::string dasm = m_inst[instnum].disasm(&m_drcuml);
-
-			// include the first accumulated comment with this line
-			if (firstcomment != -1)
-			{
-				m_drcuml.log_printf("\t%-50.50s; %s\n", dasm.c_str(), get_comment_text(m_inst[firstcomment], comment));
-				firstcomment++;
-				flushcomments = TRUE;
-			}
-			else
-				m_drcuml.log_printf("\t%s\n", dasm.c_str());
-		}
-
-		// flush any comments pending
-		if (firstcomment != -1 && (flushcomments || instnum == m_nextinst - 1))
-		{
-			while (firstcomment <= instnum)
-			{
-				const char *text = get_comment_text(m_inst[firstcomment++], comment);
-				if (text != nullptr)
-					m_drcuml.log_printf("\t%50s; %s\n", "", text);
-			}
-			firstcomment = -1;
-		}
+		case OP_HANDLE:
+		case OP_HASH:
+		case OP_LABEL:
+		case OP_DEBUG:
+		case OP_EXIT:
+		case OP_HASHJMP:
+		case OP_JMP:
+		case OP_EXH:
+		case OP_CALLH:
+		case OP_RET:
+		case OP_CALLC:
+		case OP_RECOVER:
+		case OP_SAVE:
+		case OP_RESTORE:
+		case OP_READ:
+		case OP_READM:
+		case OP_WRITE:
+		case OP_WRITEM:
+		case OP_FREAD:
+		case OP_FWRITE:
+		case OP_STORE:
+		case OP_FSTORE:
+			return true;
+
+		default:
+			return false;
 	}
-	m_drcuml.log_printf("\n\n");
-	m_drcuml.log_flush();
 }
 
 
 //-------------------------------------------------
-//  get_comment_text - determine the text
-//  associated with a comment or mapvar
+//  is_pure - return true if an instruction only
+//  computes its outputs from its inputs and can
+//  be removed if those outputs are unused
 //-------------------------------------------------
 
-const char *drcuml_block::get_comment_text(const instruction &inst, std::string &comment)
+static bool is_pure(const instruction &inst)
 {
-	// comments return their strings
-	if (inst.opcode() == OP_COMMENT)
-		return comment.assign(inst.param(0).string()).c_str();
-
-	// mapvars comment about their values
-	else if (inst.opcode() == OP_MAPVAR) {
-		comment = string_format("m%d = $%X", (int)inst.param(0).mapvar() - MAPVAR_M0, (UINT32)inst.param(1).immediate());
-		return comment.c_str();
+	switch (inst.opcode())
+	{
+		case OP_MOV:
+		case OP_SET:
+		case OP_SEXT:
+		case OP_ROLAND:
+		case OP_ROLINS:
+		case OP_ADD:
+		case OP_ADDC:
+		case OP_SUB:
+		case OP_SUBB:
+		case OP_AND:
+		case OP_OR:
+		case OP_XOR:
+		case OP_LZCNT:
+		case OP_BSWAP:
+		case OP_SHL:
+		case OP_SHR:
+		case OP_SAR:
+		case OP_ROL:
+		case OP_ROLC:
+		case OP_ROR:
+		case OP_RORC:
+		case OP_MULU:
+		case OP_MULS:
+		case OP_LOAD:
+		case OP_LOADS:
+		case OP_GETFLGS:
+		case OP_ICOPYF:
+			return true;
+
+		default:
+			return false;
 	}
-
-	// everything else is NULL
-	return nullptr;
 }
 
 
-
-#if 0
-
-/***************************************************************************
-    BACK-END VALIDATION
-***************************************************************************/
-
 //-------------------------------------------------
-//  effective_test_psize - return the effective
-//  parameter size based on the size and fixed
-//  array of parameter values
+//  propagate_values - forward known register
+//  constants and values stored to memory into
+//  later instructions that read them
 //-------------------------------------------------
 
-inline UINT8 effective_test_psize(const opcode_info &opinfo, int pnum, int instsize, const UINT64 *params)
+void drcuml_block::propagate_values()
 {
-	switch (opinfo.param[pnum].size)
+	// per-register known constants
+	struct known_reg
 	{
-		case PSIZE_4:   return 4;
-		case PSIZE_8:   return 8;
-		case PSIZE_OP:  return instsize;
-		case PSIZE_P1:  return 1 << (params[0] & 3);
-		case PSIZE_P2:  return 1 << (params[1] & 3);
-		case PSIZE_P3:  return 1 << (params[2] & 3);
-		case PSIZE_P4:  return 1 << (params[3] & 3);
-	}
-	return instsize;
-}
-
-#define TEST_ENTRY_2(op, size, p1, p2, flags) { OP_##op, size, 0, flags, { U64(p1), U64(p2) } },
-#define TEST_ENTRY_2F(op, size, p1, p2, iflags, flags) { OP_##op, size, iflags, flags, { U64(p1), U64(p2) } },
-#define TEST_ENTRY_3(op, size, p1, p2, p3, flags) { OP_##op, size, 0, flags, { U64(p1), U64(p2), U64(p3) } },
-#define TEST_ENTRY_3F(op, size, p1, p2, p3, iflags, flags) { OP_##op, size, iflags, flags, { U64(p1), U64(p2), U64(p3) } },
-#define TEST_ENTRY_4(op, size, p1, p2, p3, p4, flags) { OP_##op, size, 0, flags, { U64(p1), U64(p2), U64(p3), U64(p4) } },
-#define TEST_ENTRY_4F(op, size, p1, p2, p3, p4, iflags, flags) { OP_##op, size, iflags, flags, { U64(p1), U64(p2), U64(p3), U64(p4) } },
+		bool        known;
+		UINT8       size;
+		UINT64      value;
+	};
 
-static const bevalidate_test bevalidate_test_list[] =
-{
-	TEST_ENTRY_3(ADD, 4, 0x7fffffff, 0x12345678, 0x6dcba987, 0)
-	TEST_ENTRY_3(ADD, 4, 0x80000000, 0x12345678, 0x6dcba988, FLAG_V | FLAG_S)
-	TEST_ENTRY_3(ADD, 4, 0xffffffff, 0x92345678, 0x6dcba987, FLAG_S)
-	TEST_ENTRY_3(ADD, 4, 0x00000000, 0x92345678, 0x6dcba988, FLAG_C | FLAG_Z)
-
-	TEST_ENTRY_3(ADD, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba9876543210, 0)
-	TEST_ENTRY_3(ADD, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543211, FLAG_V | FLAG_S)
-	TEST_ENTRY_3(ADD, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba9876543210, FLAG_S)
-	TEST_ENTRY_3(ADD, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543211, FLAG_C | FLAG_Z)
-
-	TEST_ENTRY_3F(ADDC, 4, 0x7fffffff, 0x12345678, 0x6dcba987, 0,       0)
-	TEST_ENTRY_3F(ADDC, 4, 0x7fffffff, 0x12345678, 0x6dcba986, FLAG_C, 0)
-	TEST_ENTRY_3F(ADDC, 4, 0x80000000, 0x12345678, 0x6dcba988, 0,             FLAG_V | FLAG_S)
-	TEST_ENTRY_3F(ADDC, 4, 0x80000000, 0x12345678, 0x6dcba987, FLAG_C, FLAG_V | FLAG_S)
-	TEST_ENTRY_3F(ADDC, 4, 0xffffffff, 0x92345678, 0x6dcba987, 0,             FLAG_S)
-	TEST_ENTRY_3F(ADDC, 4, 0xffffffff, 0x92345678, 0x6dcba986, FLAG_C, FLAG_S)
-	TEST_ENTRY_3F(ADDC, 4, 0x00000000, 0x92345678, 0x6dcba988, 0,             FLAG_C | FLAG_Z)
-	TEST_ENTRY_3F(ADDC, 4, 0x00000000, 0x92345678, 0x6dcba987, FLAG_C, FLAG_C | FLAG_Z)
-	TEST_ENTRY_3F(ADDC, 4, 0x12345678, 0x12345678, 0xffffffff, FLAG_C, FLAG_C)
-
-	TEST_ENTRY_3F(ADDC, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba9876543210, 0,             0)
-	TEST_ENTRY_3F(ADDC, 8, 0x7fffffffffffffff, 0x0123456789abcdef, 0x7edcba987654320f, FLAG_C, 0)
-	TEST_ENTRY_3F(ADDC, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543211, 0,             FLAG_V | FLAG_S)
-	TEST_ENTRY_3F(ADDC, 8, 0x8000000000000000, 0x0123456789abcdef, 0x7edcba9876543210, FLAG_C, FLAG_V | FLAG_S)
-	TEST_ENTRY_3F(ADDC, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba9876543210, 0,             FLAG_S)
-	TEST_ENTRY_3F(ADDC, 8, 0xffffffffffffffff, 0x8123456789abcdef, 0x7edcba987654320f, FLAG_C, FLAG_S)
-	TEST_ENTRY_3F(ADDC, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543211, 0,             FLAG_C | FLAG_Z)
-	TEST_ENTRY_3F(ADDC, 8, 0x0000000000000000, 0x8123456789abcdef, 0x7edcba9876543210, FLAG_C, FLAG_C | FLAG_Z)
-	TEST_ENTRY_3F(ADDC, 8, 0x123456789abcdef0, 0x123456789abcdef0, 0xffffffffffffffff, FLAG_C, FLAG_C)
-
-	TEST_ENTRY_3(SUB, 4, 0x12345678, 0x7fffffff, 0x6dcba987, 0)
-	TEST_ENTRY_3(SUB, 4, 0x12345678, 0x80000000, 0x6dcba988, FLAG_V)
-	TEST_ENTRY_3(SUB, 4, 0x92345678, 0xffffffff, 0x6dcba987, FLAG_S)
-	TEST_ENTRY_3(SUB, 4, 0x92345678, 0x00000000, 0x6dcba988, FLAG_C | FLAG_S)
-	TEST_ENTRY_3(SUB, 4, 0x00000000, 0x12345678, 0x12345678, FLAG_Z)
-
-	TEST_ENTRY_3(SUB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba9876543210, 0)
-	TEST_ENTRY_3(SUB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543211, FLAG_V)
-	TEST_ENTRY_3(SUB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba9876543210, FLAG_S)
-	TEST_ENTRY_3(SUB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543211, FLAG_C | FLAG_S)
-	TEST_ENTRY_3(SUB, 8, 0x0000000000000000, 0x0123456789abcdef, 0x0123456789abcdef, FLAG_Z)
-
-	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x7fffffff, 0x6dcba987, 0,             0)
-	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x7fffffff, 0x6dcba986, FLAG_C, 0)
-	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x80000000, 0x6dcba988, 0,             FLAG_V)
-	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x80000000, 0x6dcba987, FLAG_C, FLAG_V)
-	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0xffffffff, 0x6dcba987, 0,             FLAG_S)
-	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0xffffffff, 0x6dcba986, FLAG_C, FLAG_S)
-	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0x00000000, 0x6dcba988, 0,             FLAG_C | FLAG_S)
-	TEST_ENTRY_3F(SUBB, 4, 0x92345678, 0x00000000, 0x6dcba987, FLAG_C, FLAG_C | FLAG_S)
-	TEST_ENTRY_3F(SUBB, 4, 0x12345678, 0x12345678, 0xffffffff, FLAG_C, FLAG_C)
-	TEST_ENTRY_3F(SUBB, 4, 0x00000000, 0x12345678, 0x12345677, FLAG_C, FLAG_Z)
-
-	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba9876543210, 0,             0)
-	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x7fffffffffffffff, 0x7edcba987654320f, FLAG_C, 0)
-	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543211, 0,             FLAG_V)
-	TEST_ENTRY_3F(SUBB, 8, 0x0123456789abcdef, 0x8000000000000000, 0x7edcba9876543210, FLAG_C, FLAG_V)
-	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba9876543210, 0,             FLAG_S)
-	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0xffffffffffffffff, 0x7edcba987654320f, FLAG_C, FLAG_S)
-	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543211, 0,             FLAG_C | FLAG_S)
-	TEST_ENTRY_3F(SUBB, 8, 0x8123456789abcdef, 0x0000000000000000, 0x7edcba9876543210, FLAG_C, FLAG_C | FLAG_S)
-	TEST_ENTRY_3F(SUBB, 8, 0x123456789abcdef0, 0x123456789abcdef0, 0xffffffffffffffff, FLAG_C, FLAG_C)
-	TEST_ENTRY_3F(SUBB, 8, 0x0000000000000000, 0x123456789abcdef0, 0x123456789abcdeef, FLAG_C, FLAG_Z)
-
-	TEST_ENTRY_2(CMP, 4, 0x7fffffff, 0x6dcba987, 0)
-	TEST_ENTRY_2(CMP, 4, 0x80000000, 0x6dcba988, FLAG_V)
-	TEST_ENTRY_2(CMP, 4, 0xffffffff, 0x6dcba987, FLAG_S)
-	TEST_ENTRY_2(CMP, 4, 0x00000000, 0x6dcba988, FLAG_C | FLAG_S)
-	TEST_ENTRY_2(CMP, 4, 0x12345678, 0x12345678, FLAG_Z)
-
-	TEST_ENTRY_2(CMP, 8, 0x7fffffffffffffff, 0x7edcba9876543210, 0)
-	TEST_ENTRY_2(CMP, 8, 0x8000000000000000, 0x7edcba9876543211, FLAG_V)
-	TEST_ENTRY_2(CMP, 8, 0xffffffffffffffff, 0x7edcba9876543210, FLAG_S)
-	TEST_ENTRY_2(CMP, 8, 0x0000000000000000, 0x7edcba9876543211, FLAG_C | FLAG_S)
-	TEST_ENTRY_2(CMP, 8, 0x0123456789abcdef, 0x0123456789abcdef, FLAG_Z)
-
-	TEST_ENTRY_4(MULU, 4, 0x77777777, 0x00000000, 0x11111111, 0x00000007, 0)
-	TEST_ENTRY_4(MULU, 4, 0xffffffff, 0x00000000, 0x11111111, 0x0000000f, 0)
-	TEST_ENTRY_4(MULU, 4, 0x00000000, 0x00000000, 0x11111111, 0x00000000, FLAG_Z)
-	TEST_ENTRY_4(MULU, 4, 0xea61d951, 0x37c048d0, 0x77777777, 0x77777777, FLAG_V)
-	TEST_ENTRY_4(MULU, 4, 0x32323233, 0xcdcdcdcc, 0xcdcdcdcd, 0xffffffff, FLAG_V | FLAG_S)
-
-	TEST_ENTRY_4(MULU, 8, 0x7777777777777777, 0x0000000000000000, 0x1111111111111111, 0x0000000000000007, 0)
-	TEST_ENTRY_4(MULU, 8, 0xffffffffffffffff, 0x0000000000000000, 0x1111111111111111, 0x000000000000000f, 0)
-	TEST_ENTRY_4(MULU, 8, 0x0000000000000000, 0x0000000000000000, 0x1111111111111111, 0x0000000000000000, FLAG_Z)
-	TEST_ENTRY_4(MULU, 8, 0x0c83fb72ea61d951, 0x37c048d159e26af3, 0x7777777777777777, 0x7777777777777777, FLAG_V)
-	TEST_ENTRY_4(MULU, 8, 0x3232323232323233, 0xcdcdcdcdcdcdcdcc, 0xcdcdcdcdcdcdcdcd, 0xffffffffffffffff, FLAG_V | FLAG_S)
-
-	TEST_ENTRY_4(MULS, 4, 0x77777777, 0x00000000, 0x11111111, 0x00000007, 0)
-	TEST_ENTRY_4(MULS, 4, 0xffffffff, 0x00000000, 0x11111111, 0x0000000f, FLAG_V)
-	TEST_ENTRY_4(MULS, 4, 0x00000000, 0x00000000, 0x11111111, 0x00000000, FLAG_Z)
-	TEST_ENTRY_4(MULS, 4, 0x9e26af38, 0xc83fb72e, 0x77777777, 0x88888888, FLAG_V | FLAG_S)
-	TEST_ENTRY_4(MULS, 4, 0x32323233, 0x00000000, 0xcdcdcdcd, 0xffffffff, 0)
-
-	TEST_ENTRY_4(MULS, 8, 0x7777777777777777, 0x0000000000000000, 0x1111111111111111, 0x0000000000000007, 0)
-	TEST_ENTRY_4(MULS, 8, 0xffffffffffffffff, 0x0000000000000000, 0x1111111111111111, 0x000000000000000f, FLAG_V)
-	TEST_ENTRY_4(MULS, 8, 0x0000000000000000, 0x0000000000000000, 0x1111111111111111, 0x0000000000000000, FLAG_Z)
-	TEST_ENTRY_4(MULS, 8, 0x7c048d159e26af38, 0xc83fb72ea61d950c, 0x7777777777777777, 0x8888888888888888, FLAG_V | FLAG_S)
-	TEST_ENTRY_4(MULS, 8, 0x3232323232323233, 0x0000000000000000, 0xcdcdcdcdcdcdcdcd, 0xffffffffffffffff, 0)
-
-	TEST_ENTRY_4(DIVU, 4, 0x02702702, 0x00000003, 0x11111111, 0x00000007, 0)
-	TEST_ENTRY_4(DIVU, 4, 0x00000000, 0x11111111, 0x11111111, 0x11111112, FLAG_Z)
-	TEST_ENTRY_4(DIVU, 4, 0x7fffffff, 0x00000000, 0xfffffffe, 0x00000002, 0)
-	TEST_ENTRY_4(DIVU, 4, 0xfffffffe, 0x00000000, 0xfffffffe, 0x00000001, FLAG_S)
-	TEST_ENTRY_4(DIVU, 4, UNDEFINED,  UNDEFINED,  0xffffffff, 0x00000000, FLAG_V)
-
-	TEST_ENTRY_4(DIVU, 8, 0x0270270270270270, 0x0000000000000001, 0x1111111111111111, 0x0000000000000007, 0)
-	TEST_ENTRY_4(DIVU, 8, 0x0000000000000000, 0x1111111111111111, 0x1111111111111111, 0x1111111111111112, FLAG_Z)
-	TEST_ENTRY_4(DIVU, 8, 0x7fffffffffffffff, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000002, 0)
-	TEST_ENTRY_4(DIVU, 8, 0xfffffffffffffffe, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000001, FLAG_S)
-	TEST_ENTRY_4(DIVU, 8, UNDEFINED,          UNDEFINED,          0xffffffffffffffff, 0x0000000000000000, FLAG_V)
-
-	TEST_ENTRY_4(DIVS, 4, 0x02702702, 0x00000003, 0x11111111, 0x00000007, 0)
-	TEST_ENTRY_4(DIVS, 4, 0x00000000, 0x11111111, 0x11111111, 0x11111112, FLAG_Z)
-	TEST_ENTRY_4(DIVS, 4, 0xffffffff, 0x00000000, 0xfffffffe, 0x00000002, FLAG_S)
-	TEST_ENTRY_4(DIVS, 4, UNDEFINED,  UNDEFINED,  0xffffffff, 0x00000000, FLAG_V)
-
-	TEST_ENTRY_4(DIVS, 8, 0x0270270270270270, 0x0000000000000001, 0x1111111111111111, 0x0000000000000007, 0)
-	TEST_ENTRY_4(DIVS, 8, 0x0000000000000000, 0x1111111111111111, 0x1111111111111111, 0x1111111111111112, FLAG_Z)
-	TEST_ENTRY_4(DIVS, 8, 0xffffffffffffffff, 0x0000000000000000, 0xfffffffffffffffe, 0x0000000000000002, FLAG_S)
-	TEST_ENTRY_4(DIVS, 8, UNDEFINED,          UNDEFINED,          0xffffffffffffffff, 0x0000000000000000, FLAG_V)
-};
-
-
-/*-------------------------------------------------
-    validate_backend - execute a number of
-    generic tests on the backend code generator
--------------------------------------------------*/
-
-static void validate_backend(drcuml_state *drcuml)
-{
-	code_handle *handles[3];
-	int tnum;
+	// memory locations whose contents are held in a register or constant
+	struct known_mem
+	{
+		void *      base;
+		UINT8       size;
+		parameter   value;
+	};
 
-	// allocate handles for the code
-	handles[0] = drcuml->handle_alloc("test_entry");
-	handles[1] = drcuml->handle_alloc("code_start");
-	handles[2] = drcuml->handle_alloc("code_end");
+	known_reg regs[REG_I_COUNT];
+	std::vector<known_mem> mems;
+	memset(regs, 0, sizeof(regs));
 
-	// iterate over test entries
-	printf("Backend validation....\n");
-	for (tnum = 31; tnum < ARRAY_LENGTH(bevalidate_test_list); tnum++)
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
 	{
-		const bevalidate_test *test = &bevalidate_test_list[tnum];
-		parameter param[ARRAY_LENGTH(test->param)];
-		char mnemonic[20], *dst;
-		const char *src;
-
-		// progress
-		dst = mnemonic;
-		for (src = opcode_info_table[test->opcode()]->mnemonic; *src != 0; src++)
+		instruction &inst = m_inst[instnum];
+		opcode_t opcode = inst.opcode();
+		if (opcode == OP_MAPVAR || opcode == OP_COMMENT || opcode == OP_NOP)
+			continue;
+
+		// substitute any pure inputs whose values we know
+		if (opcode != OP_RECOVER && opcode != OP_HASH && opcode != OP_LABEL && opcode != OP_HANDLE)
 		{
-			if (*src == '!')
+			bool changed = false;
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
 			{
-				if (test->size == 8)
-					*dst++ = 'd';
+				if (!inst.param_is_input(pnum) || inst.param_is_output(pnum))
+					continue;
+				int psize = inst.param_size(pnum);
+				if (psize != 4 && psize != 8)
+					continue;
+				UINT64 mask = (psize == 4) ? 0xffffffffU : ~UINT64(0);
+				const parameter &param = inst.param(pnum);
+
+				// registers holding a known constant become immediates
+				if (param.is_int_register())
+				{
+					const known_reg &reg = regs[param.ireg() - REG_I0];
+					if (reg.known && reg.size >= psize && inst.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+					{
+						inst.set_param(pnum, reg.value & mask);
+						changed = true;
+					}
+				}
+
+				// memory we just wrote or read is forwarded from the register or constant
+				else if (param.is_memory() && inst.param_allows(pnum, parameter::PTYPE_MEMORY))
+				{
+					for (auto &mem : mems)
+						if (mem.base == param.memory() && mem.size == psize)
+						{
+							parameter value = mem.value;
+							if (value.is_int_register() && regs[value.ireg() - REG_I0].known && regs[value.ireg() - REG_I0].size >= psize)
+								value = parameter(regs[value.ireg() - REG_I0].value);
+							if (value.is_immediate() && inst.param_allows(pnum, parameter::PTYPE_IMMEDIATE))
+							{
+								inst.set_param(pnum, value.immediate() & mask);
+								changed = true;
+							}
+							else if (mem.value.is_int_register() && inst.param_allows(pnum, parameter::PTYPE_INT_REGISTER))
+							{
+								inst.set_param(pnum, mem.value);
+								changed = true;
+							}
+							break;
+						}
+				}
 			}
-			else if (*src == '#')
-				*dst++ = (test->size == 8) ? 'd' : 's';
-			else
-				*dst++ = *src;
+			if (changed)
+				inst.simplify();
+			opcode = inst.opcode();
 		}
-		*dst = 0;
-		printf("Executing test %d/%d (%s)", tnum + 1, (int)ARRAY_LENGTH(bevalidate_test_list), mnemonic);
 
-		// reset parameter list and iterate
-		memset(param, 0, sizeof(param));
-		bevalidate_iterate_over_params(drcuml, handles, test, param, 0);
-		printf("\n");
-	}
-	fatalerror("All tests passed!\n");
-}
-
-
-/*-------------------------------------------------
-    bevalidate_iterate_over_params - iterate over
-    all supported types and values of a parameter
-    and recursively hand off to the next parameter,
-    or else move on to iterate over the flags
--------------------------------------------------*/
-
-static void bevalidate_iterate_over_params(drcuml_state *drcuml, code_handle **handles, const bevalidate_test *test, parameter *paramlist, int pnum)
-{
-	const opcode_info *opinfo = opcode_info_table[test->opcode()];
-	drcuml_ptype ptype;
-
-	// if no parameters, execute now
-	if (pnum >= ARRAY_LENGTH(opinfo->param) || opinfo->param[pnum].typemask == PTYPES_NONE)
-	{
-		bevalidate_iterate_over_flags(drcuml, handles, test, paramlist);
-		return;
-	}
-
-	// iterate over valid parameter types
-	for (ptype = parameter::PTYPE_IMMEDIATE; ptype < parameter::PTYPE_MAX; ptype++)
-		if (opinfo->param[pnum].typemask & (1 << ptype))
+		// barriers invalidate everything we know
+		if (is_barrier(inst))
 		{
-			int pindex, pcount;
+			memset(regs, 0, sizeof(regs));
+			mems.clear();
+			continue;
+		}
 
-			// mapvars can only do 32-bit tests
-			if (ptype == parameter::PTYPE_MAPVAR && effective_test_psize(opinfo, pnum, test->size, test->param) == 8)
+		// invalidate anything overwritten by this instruction
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			if (!inst.param_is_output(pnum))
 				continue;
-
-			// for some parameter types, we wish to iterate over all possibilities
-			switch (ptype)
+			const parameter &param = inst.param(pnum);
+			if (param.is_int_register())
 			{
-				case parameter::PTYPE_INT_REGISTER:     pcount = REG_I_END - REG_I0;        break;
-				case parameter::PTYPE_FLOAT_REGISTER:   pcount = REG_F_END - REG_F0;        break;
-				default:                            pcount = 1;                                     break;
+				regs[param.ireg() - REG_I0].known = false;
+				for (auto it = mems.begin(); it != mems.end(); )
+					if (it->value.is_int_register() && it->value.ireg() == param.ireg())
+						it = mems.erase(it);
+					else
+						++it;
 			}
-
-			// iterate over possibilities
-			for (pindex = 0; pindex < pcount; pindex++)
+			else if (param.is_memory())
 			{
-				int skip = FALSE;
-				int pscannum;
-
-				// for param 0, print a dot
-				if (pnum == 0)
-					printf(".");
-
-				// can't duplicate multiple source parameters unless they are immediates
-				if (ptype != parameter::PTYPE_IMMEDIATE && (opinfo->param[pnum].output & PIO_IN))
-
-					// loop over all parameters we've done before; if the parameter is a source and matches us, skip this case
-					for (pscannum = 0; pscannum < pnum; pscannum++)
-						if ((opinfo->param[pscannum].output & PIO_IN) && ptype == paramlist[pscannum].type && pindex == paramlist[pscannum].value)
-							skip = TRUE;
-
-				// can't duplicate multiple dest parameters
-				if (opinfo->param[pnum].output & PIO_OUT)
-
-					// loop over all parameters we've done before; if the parameter is a source and matches us, skip this case
-					for (pscannum = 0; pscannum < pnum; pscannum++)
-						if ((opinfo->param[pscannum].output & PIO_OUT) && ptype == paramlist[pscannum].type && pindex == paramlist[pscannum].value)
-							skip = TRUE;
-
-				// iterate over the next parameter in line
-				if (!skip)
+				UINT8 *base = reinterpret_cast<UINT8 *>(param.memory());
+				for (auto it = mems.begin(); it != mems.end(); )
 				{
-					paramlist[pnum].type = ptype;
-					paramlist[pnum].value = pindex;
-					bevalidate_iterate_over_params(drcuml, handles, test, paramlist, pnum + 1);
+					UINT8 *membase = reinterpret_cast<UINT8 *>(it->base);
+					if (membase < base + 8 && base < membase + it->size)
+						it = mems.erase(it);
+					else
+						++it;
 				}
 			}
 		}
-}
 
-
-/*-------------------------------------------------
-    bevalidate_iterate_over_flags - iterate over
-    all supported flag masks
--------------------------------------------------*/
-
-static void bevalidate_iterate_over_flags(drcuml_state *drcuml, code_handle **handles, const bevalidate_test *test, parameter *paramlist)
-{
-	const opcode_info *opinfo = opcode_info_table[test->opcode()];
-	UINT8 flagmask = opinfo->outflags;
-	UINT8 curmask;
-
-	// iterate over all possible flag combinations
-	for (curmask = 0; curmask <= flagmask; curmask++)
-		if ((curmask & flagmask) == curmask)
-			bevalidate_execute(drcuml, handles, test, paramlist, curmask);
+		// unconditional moves give us new facts
+		if (opcode != OP_MOV || inst.condition() != COND_ALWAYS)
+			continue;
+		const parameter &dst = inst.param(0);
+		const parameter &src = inst.param(1);
+		UINT8 size = inst.size();
+		if (dst.is_int_register() && src.is_immediate())
+		{
+			known_reg &reg = regs[dst.ireg() - REG_I0];
+			reg.known = true;
+			reg.size = size;
+			reg.value = (size == 4) ? UINT32(src.immediate()) : src.immediate();
+		}
+		else if (mems.size() < 64)
+		{
+			known_mem mem;
+			mem.size = size;
+			if (dst.is_memory() && src.is_immediate())
+			{
+				mem.base = dst.memory();
+				mem.value = src;
+				mems.push_back(mem);
+			}
+			else if (dst.is_memory() && src.is_int_register())
+			{
+				const known_reg &reg = regs[src.ireg() - REG_I0];
+				mem.base = dst.memory();
+				mem.value = (reg.known && reg.size >= size) ? parameter(reg.value) : src;
+				mems.push_back(mem);
+			}
+			else if (dst.is_int_register() && src.is_memory())
+			{
+				mem.base = src.memory();
+				mem.value = dst;
+				mems.push_back(mem);
+			}
+		}
+	}
 }
 
 
-/*-------------------------------------------------
-    bevalidate_execute - execute a single instance
-    of a test, generating code and verifying the
-    results
--------------------------------------------------*/
+//-------------------------------------------------
+//  eliminate_dead_code - remove instructions
+//  whose results are overwritten before use
+//-------------------------------------------------
 
-static void bevalidate_execute(drcuml_state *drcuml, code_handle **handles, const bevalidate_test *test, const parameter *paramlist, UINT8 flagmask)
+void drcuml_block::eliminate_dead_code()
 {
-	parameter params[ARRAY_LENGTH(test->param)];
-	drcuml_machine_state istate, fstate;
-	instruction testinst;
-	drcuml_block *block;
-	UINT64 *parammem;
-	int numparams;
-
-	// allocate memory for parameters
-	parammem = (UINT64 *)drcuml->cache->alloc_near(sizeof(UINT64) * (ARRAY_LENGTH(test->param) + 1));
-
-	// flush the cache
-	drcuml->reset();
-
-	// start a new block
-	block = drcuml->block_begin(30);
-	UML_HANDLE(block, handles[0]);
+	// live bits for each register: bit 0 = low half, bit 1 = high half
+	UINT8 live[REG_I_COUNT];
+	memset(live, 3, sizeof(live));
 
-	// set up a random initial state
-	bevalidate_initialize_random_state(drcuml, block, &istate);
+	// memory locations overwritten later without being read
+	std::vector<std::pair<void *, int>> stores;
 
-	// then populate the state with the parameters
-	numparams = bevalidate_populate_state(block, &istate, test, paramlist, params, parammem);
-
-	// generate the code
-	UML_RESTORE(block, &istate);
-	UML_HANDLE(block, handles[1]);
-	switch (numparams)
+	for (int instnum = m_nextinst - 1; instnum >= 0; instnum--)
 	{
-		case 0:
-			block->append(test->opcode(), test->size);
-			break;
-
-		case 1:
-			block->append(test->opcode(), test->size, params[0]);
-			break;
-
-		case 2:
-			block->append(test->opcode(), test->size, params[0], params[1]);
-			break;
+		instruction &inst = m_inst[instnum];
+		opcode_t opcode = inst.opcode();
+		if (opcode == OP_COMMENT || opcode == OP_NOP || opcode == OP_MAPVAR)
+			continue;
 
-		case 3:
-			block->append(test->opcode(), test->size, params[0], params[1], params[2]);
-			break;
+		// at barriers, assume everything is needed
+		if (is_barrier(inst))
+		{
+			memset(live, 3, sizeof(live));
+			stores.clear();
+			continue;
+		}
 
-		case 4:
-			block->append(test->opcode(), test->size, params[0], params[1], params[2], params[3]);
-			break;
-	}
-	testinst = block->inst[block->nextinst - 1];
-	UML_HANDLE(block, handles[2]);
-	UML_GETFLGS(block, MEM(&parammem[ARRAY_LENGTH(test->param)]), flagmask);
-	UML_SAVE(block, &fstate);
-	UML_EXIT(block, IMM(0));
+		// raw pointer loads may read anything we've stored
+		if (opcode == OP_LOAD || opcode == OP_LOADS || opcode == OP_FLOAD)
+			stores.clear();
 
-	// end the block
-	block->end();
+		bool removable = (inst.condition() == COND_ALWAYS && inst.flags() == 0);
+		if (removable)
+		{
+			// stores that are overwritten later can go
+			if (opcode == OP_MOV && inst.param(0).is_memory())
+			{
+				bool dead = false;
+				for (auto &store : stores)
+					if (store.first == inst.param(0).memory() && store.second >= inst.size())
+						dead = true;
+				if (dead)
+				{
+					inst.nop();
+					continue;
+				}
+			}
 
-	// execute
-	drcuml->execute(*handles[0]);
+			// pure operations whose register results are all dead can go
+			if (is_pure(inst))
+			{
+				bool dead = true;
+				for (int pnum = 0; pnum < inst.numparams(); pnum++)
+					if (inst.param_is_output(pnum) && (!inst.param(pnum).is_int_register() || live[inst.param(pnum).ireg() - REG_I0] != 0))
+						dead = false;
+				if (dead)
+				{
+					inst.nop();
+					continue;
+				}
+			}
+		}
 
-	// verify the results
-	bevalidate_verify_state(drcuml, &istate, &fstate, test, *(UINT32 *)&parammem[ARRAY_LENGTH(test->param)], params, &testinst, handles[1]->code, handles[2]->code, flagmask);
+		// outputs of unconditional pure operations kill liveness; a 4-byte
+		// write leaves the upper half undefined, so it kills both halves
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			const parameter &param = inst.param(pnum);
+			if (!inst.param_is_output(pnum) || inst.param_is_input(pnum))
+				continue;
+			if (param.is_int_register() && inst.condition() == COND_ALWAYS && is_pure(inst))
+				live[param.ireg() - REG_I0] = 0;
+		}
+		if (opcode == OP_MOV && inst.condition() == COND_ALWAYS && inst.param(0).is_memory())
+			stores.push_back(std::make_pair(inst.param(0).memory(), int(inst.size())));
 
-	// free memory
-	drcuml->cache->dealloc(parammem, sizeof(UINT64) * (ARRAY_LENGTH(test->param) + 1));
+		// inputs make registers live and memory read
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+		{
+			const parameter &param = inst.param(pnum);
+			if (!inst.param_is_input(pnum))
+				continue;
+			int psize = inst.param_size(pnum);
+			if (param.is_int_register())
+				live[param.ireg() - REG_I0] |= (psize == 8) ? 3 : 1;
+			else if (param.is_memory())
+			{
+				UINT8 *base = reinterpret_cast<UINT8 *>(param.memory());
+				for (auto it = stores.begin(); it != stores.end(); )
+				{
+					UINT8 *storebase = reinterpret_cast<UINT8 *>(it->first);
+					if (storebase < base + 8 && base < storebase + it->second)
+						it = stores.erase(it);
+					else
+						++it;
+				}
+			}
+		}
+	}
 }
 
 
-/*-------------------------------------------------
-    bevalidate_initialize_random_state -
-    initialize the machine state to randomness
--------------------------------------------------*/
+//-------------------------------------------------
+//  remove_nops - compact the block, dropping any
+//  instructions that were optimized away
+//-------------------------------------------------
 
-static void bevalidate_initialize_random_state(drcuml_state *drcuml, drcuml_block *block, drcuml_machine_state *state)
+void drcuml_block::remove_nops()
 {
-	running_machine &machine = drcuml->device->machine();
-	int regnum;
-
-	// initialize core state to random values
-	state->fmod = machine.rand() & 0x03;
-	state->flags = machine.rand() & 0x1f;
-	state->exp = machine.rand();
-
-	// initialize integer registers to random values
-	for (regnum = 0; regnum < ARRAY_LENGTH(state->r); regnum++)
-	{
-		state->r[regnum].w.h = machine.rand();
-		state->r[regnum].w.l = machine.rand();
-	}
-
-	// initialize float registers to random values
-	for (regnum = 0; regnum < ARRAY_LENGTH(state->f); regnum++)
-	{
-		*(UINT32 *)&state->f[regnum].s.h = machine.rand();
-		*(UINT32 *)&state->f[regnum].s.l = machine.rand();
-	}
-
-	// initialize map variables to random values
-	for (regnum = 0; regnum < MAPVAR_COUNT; regnum++)
-		UML_MAPVAR(block, MVAR(regnum), machine.rand());
+	UINT32 dest = 0;
+	for (UINT32 instnum = 0; instnum < m_nextinst; instnum++)
+		if (m_inst[instnum].opcode() != OP_NOP)
+		{
+			if (dest != instnum)
+				m_inst[dest] = m_inst[instnum];
+			dest++;
+		}
+	m_nextinst = dest;
 }
 
 
-/*-------------------------------------------------
-    bevalidate_populate_state - populate the
-    machine state with the proper values prior
-    to executing a test
--------------------------------------------------*/
+//-------------------------------------------------
+//  disassemble - disassemble a block of
+//  instructions to the log
+//-------------------------------------------------
 
-static int bevalidate_populate_state(drcuml_block *block, drcuml_machine_state *state, const bevalidate_test *test, const parameter *paramlist, parameter *params, UINT64 *parammem)
+void drcuml_block::disassemble()
 {
-	const opcode_info *opinfo = opcode_info_table[test->opcode()];
-	int numparams = ARRAY_LENGTH(test->param);
-	int pnum;
-
-	// copy flags as-is
-	state->flags = test->iflags;
+	std::string comment;
 
-	// iterate over parameters
-	for (pnum = 0; pnum < ARRAY_LENGTH(test->param); pnum++)
+	// iterate over instructions and output
+	int firstcomment = -1;
+	for (int instnum = 0; instnum < m_nextinst; instnum++)
 	{
-		int psize = effective_test_psize(opinfo, pnum, test->size, test->param);
-		parameter *curparam = &params[pnum];
-
-		// start with a copy of the parameter from the list
-		*curparam = paramlist[pnum];
+		const instruction &inst = m_inst[instnum];
+		bool flushcomments = false;
 
-		// switch off the type
-		switch (curparam->type)
+		// remember comments and mapvars for later
+		if (inst.opcode() == OP_COMMENT || inst.opcode() == OP_MAPVAR)
 		{
-			// immediate parameters: take the value from the test entry
-			case parameter::PTYPE_IMMEDIATE:
-				curparam->value = test->param[pnum];
-				break;
-
-			// register parameters: set the register value in the state and set the parameter value to the register index
-			case parameter::PTYPE_INT_REGISTER:
-				state->r[curparam->value].d = test->param[pnum];
-				curparam->value += REG_I0;
-				break;
-
-			// register parameters: set the register value in the state and set the parameter value to the register index
-			case parameter::PTYPE_FLOAT_REGISTER:
-				state->f[curparam->value].d = test->param[pnum];
-				curparam->value += REG_F0;
-				break;
-
-			// memory parameters: set the memory value in the parameter space and set the parameter value to point to it
-			case parameter::PTYPE_MEMORY:
-				curparam->value = (FPTR)&parammem[pnum];
-				if (psize == 4)
-					*(UINT32 *)(FPTR)curparam->value = test->param[pnum];
-				else
-					*(UINT64 *)(FPTR)curparam->value = test->param[pnum];
-				break;
-
-			// map variables: issue a MAPVAR instruction to set the value and set the parameter value to the mapvar index
-			case parameter::PTYPE_MAPVAR:
-				UML_MAPVAR(block, MVAR(curparam->value), test->param[pnum]);
-				curparam->value += MAPVAR_M0;
-				break;
-
-			// use anything else to count the number of parameters
-			default:
-				numparams = MIN(numparams, pnum);
-				break;
+			if (firstcomment == -1)
+				firstcomment = instnum;
 		}
-	}
-
-	// return the total number of parameters
-	return numparams;
-}
-
-
-/*-------------------------------------------------
-    bevalidate_verify_state - verify the final
-    state after executing a test, and report any
-    discrepancies
--------------------------------------------------*/
 
-static int bevalidate_verify_state(drcuml_state *drcuml, const drcuml_machine_state *istate, drcuml_machine_state *state, const bevalidate_test *test, UINT32 flags, const parameter *params, const instruction *testinst, drccodeptr codestart, drccodeptr codeend, UINT8 flagmask)
-{
-	const opcode_info *opinfo = opcode_info_table[test->opcode()];
-	UINT8 ireg[REG_I_END - REG_I0] = { 0 };
-	UINT8 freg[REG_F_END - REG_F0] = { 0 };
-	char errorbuf[1024];
-	char *errend = errorbuf;
-	int pnum, regnum;
-
-	*errend = 0;
-
-	// check flags
-	if (flags != (test->flags & flagmask))
-	{
-		errend += sprintf(errend, "  Flags ... result:%c%c%c%c%c  expected:%c%c%c%c%c\n",
-			(flagmask & FLAG_U) ? ((flags & FLAG_U) ? 'U' : '.') : '-',
-			(flagmask & FLAG_S) ? ((flags & FLAG_S) ? 'S' : '.') : '-',
-			(flagmask & FLAG_Z) ? ((flags & FLAG_Z) ? 'Z' : '.') : '-',
-			(flagmask & FLAG_V) ? ((flags & FLAG_V) ? 'V' : '.') : '-',
-			(flagmask & FLAG_C) ? ((flags & FLAG_C) ? 'C' : '.') : '-',
-			(flagmask & FLAG_U) ? ((test->flags & FLAG_U) ? 'U' : '.') : '-',
-			(flagmask & FLAG_S) ? ((test->flags & FLAG_S) ? 'S' : '.') : '-',
-			(flagmask & FLAG_Z) ? ((test->flags & FLAG_Z) ? 'Z' : '.') : '-',
-			(flagmask & FLAG_V) ? ((test->flags & FLAG_V) ? 'V' : '.') : '-',
-			(flagmask & FLAG_C) ? ((test->flags & FLAG_C) ? 'C' : '.') : '-');
-	}
+		// print labels, handles, and hashes left justified
+		else if (inst.opcode() == OP_LABEL)
+			m_drcuml.log_printf("$%X:\n", UINT32(inst.param(0).label()));
+		else if (inst.opcode() == OP_HANDLE)
+			m_drcuml.log_printf("%s:\n", inst.param(0).handle().string());
+		else if (inst.opcode() == OP_HASH)
+			m_drcuml.log_printf("(%X,%X):\n", UINT32(inst.param(0).immediate()), UINT32(inst.param(1).immediate()));
 
-	// check destination parameters
-	for (pnum = 0; pnum < ARRAY_LENGTH(test->param); pnum++)
-		if (opinfo->param[pnum].output & PIO_OUT)
+		// indent everything else with a tab
+		else
 		{
-			int psize = effective_test_psize(opinfo, pnum, test->size, test->param);
-			UINT64 mask = U64(0xffffffffffffffff) >> (64 - 8 * psize);
-			UINT64 result = 0;
+			std::string dasm = m_inst[instnum].disasm(&m_drcuml);
 
-			// fetch the result from the parameters
-			switch (params[pnum].type)
+			// include the first accumulated comment with this line
+			if (firstcomment != -1)
 			{
-				// integer registers fetch from the state
-				case parameter::PTYPE_INT_REGISTER:
-					ireg[params[pnum].value - REG_I0] = 1;
-					result = state->r[params[pnum].value - REG_I0].d;
-					break;
-
-				// float registers fetch from the state
-				case parameter::PTYPE_FLOAT_REGISTER:
-					freg[params[pnum].value - REG_I0] = 1;
-					result = state->f[params[pnum].value - REG_F0].d;
-					break;
-
-				// memory registers fetch from the memory address
-				case parameter::PTYPE_MEMORY:
-					if (psize == 4)
-						result = *(UINT32 *)(FPTR)params[pnum].value;
-					else
-						result = *(UINT64 *)(FPTR)params[pnum].value;
-					break;
-
-				default:
-					break;
+				m_drcuml.log_printf("\t%-50.50s; %s\n", dasm.c_str(), get_comment_text(m_inst[firstcomment], comment));
+				firstcomment++;
+				flushcomments = TRUE;
 			}
+			else
+				m_drcuml.log_printf("\t%s\n", dasm.c_str());
+		}
 
-			// check against the mask
-			if (test->param[pnum] != UNDEFINED_U64 && (result & mask) != (test->param[pnum] & mask))
+		// flush any comments pending
+		if (firstcomment != -1 && (flushcomments || instnum == m_nextinst - 1))
+		{
+			while (firstcomment <= instnum)
 			{
-				if ((UINT32)mask == mask)
-					errend += sprintf(errend, "  Parameter %d ... result:%08X  expected:%08X\n", pnum,
-										(UINT32)(result & mask), (UINT32)(test->param[pnum] & mask));
-				else
-					errend += sprintf(errend, "  Parameter %d ... result:%08X%08X  expected:%08X%08X\n", pnum,
-										(UINT32)((result & mask) >> 32), (UINT32)(result & mask),
-										(UINT32)((test->param[pnum] & mask) >> 32), (UINT32)(test->param[pnum] & mask));
+				const char *text = get_comment_text(m_inst[firstcomment++], comment);
+				if (text != nullptr)
+					m_drcuml.log_printf("\t%50s; %s\n", "", text);
 			}
+			firstcomment = -1;
 		}
-
-	// check source integer parameters for unexpected alterations
-	for (regnum = 0; regnum < ARRAY_LENGTH(state->r); regnum++)
-		if (ireg[regnum] == 0 && istate->r[regnum].d != state->r[regnum].d)
-			errend += sprintf(errend, "  Register i%d ... result:%08X%08X  originally:%08X%08X\n", regnum,
-								(UINT32)(state->r[regnum].d >> 32), (UINT32)state->r[regnum].d,
-								(UINT32)(istate->r[regnum].d >> 32), (UINT32)istate->r[regnum].d);
-
-	// check source float parameters for unexpected alterations
-	for (regnum = 0; regnum < ARRAY_LENGTH(state->f); regnum++)
-		if (freg[regnum] == 0 && *(UINT64 *)&istate->f[regnum].d != *(UINT64 *)&state->f[regnum].d)
-			errend += sprintf(errend, "  Register f%d ... result:%08X%08X  originally:%08X%08X\n", regnum,
-								(UINT32)(*(UINT64 *)&state->f[regnum].d >> 32), (UINT32)*(UINT64 *)&state->f[regnum].d,
-								(UINT32)(*(UINT64 *)&istate->f[regnum].d >> 32), (UINT32)*(UINT64 *)&istate->f[regnum].d);
-
-	// output the error if we have one
-	if (errend != errorbuf)
-	{
-		// disassemble the test instruction
-		std::string disasm = testinst->disasm(drcuml);
-
-		// output a description of what went wrong
-		printf("\n");
-		printf("----------------------------------------------\n");
-		printf("Backend validation error:\n");
-		printf("   %s\n", disasm.c_str());
-		printf("\n");
-		printf("Errors:\n");
-		printf("%s\n", errorbuf);
-		fatalerror("Error during validation\n");
 	}
-	return errend != errorbuf;
+	m_drcuml.log_printf("\n\n");
+	m_drcuml.log_flush();
 }
 
-#endif
+
+//-------------------------------------------------
+//  get_comment_text - determine the text
+//  associated with a comment or mapvar
+//-------------------------------------------------
+
+const char *drcuml_block::get_comment_text(const instruction &inst, std::string &comment)
+{
+	// comments return their strings
+	if (inst.opcode() == OP_COMMENT)
+		return comment.assign(inst.param(0).string()).c_str();
+
+	// mapvars comment about their values
+	else if (inst.opcode() == OP_MAPVAR) {
+		comment = string_format("m%d = $%X", (int)inst.param(0).mapvar() - MAPVAR_M0, (UINT32)inst.param(1).immediate());
+		return comment.c_str();
+	}
+
+	// everything else is NULL
+	return nullptr;
+}
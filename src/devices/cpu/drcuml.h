@@ -15,6 +15,7 @@
 
 #include "drccache.h"
 #include "uml.h"
+#include <unordered_set>
 
 
 //**************************************************************************
@@ -86,6 +87,17 @@ struct drcbe_info
 };
 
 
+// counts of code generated, for measuring the optimizer
+struct drcuml_stats
+{
+	UINT64              blocks;             // blocks generated
+	UINT64              instructions;       // UML instructions emitted by the front-end
+	UINT64              optimized;          // UML instructions left after optimization
+	UINT64              host_bytes;         // host code bytes generated by the back-end
+	UINT64              recompiled_bytes;   // host code bytes generated for code compiled before
+};
+
+
 // a drcuml_block describes a basic block of instructions
 class drcuml_block
 {
@@ -120,6 +132,9 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	void propagate_values();
+	void eliminate_dead_code();
+	void remove_nops();
 	void disassemble();
 	const char *get_comment_text(const uml::instruction &inst, std::string &comment);
 
@@ -160,12 +175,21 @@ protected:
 };
 
 
+// which back-end a drcuml_state should use
+enum drcbe_type
+{
+	DRCBE_DEFAULT,                          // as selected by the options
+	DRCBE_C,                                // the portable C back-end
+	DRCBE_NATIVE                            // the native back-end for this host
+};
+
+
 // structure describing UML generation state
 class drcuml_state
 {
 public:
 	// construction/destruction
-	drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits);
+	drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits, drcbe_type type = DRCBE_DEFAULT);
 	~drcuml_state();
 
 	// getters
@@ -174,11 +198,18 @@ public:
 
 	// reset the state
 	void reset();
+	void validate_backends();
 	int execute(uml::code_handle &entry) { return m_beintf.execute(entry); }
 
 	// code generation
 	drcuml_block *begin_block(UINT32 maxinst);
 
+	// optimization
+	bool optimizing() const { return m_optimize; }
+	const drcuml_stats &stats() const { return m_stats; }
+	void add_block_stats(UINT32 instructions, UINT32 optimized, UINT32 host_bytes, bool recompiled);
+	bool mark_compiled(UINT32 mode, UINT32 pc) { return !m_compiled.insert((UINT64(mode) << 32) | pc).second; }
+
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf.get_info(info); }
 	bool hash_exists(UINT32 mode, UINT32 pc) { return m_beintf.hash_exists(mode, pc); }
@@ -229,6 +260,10 @@ private:
 	std::unique_ptr<drcbe_interface> m_drcbe_interface;
 	drcbe_interface &           m_beintf;           // backend interface pointer
 	FILE *                      m_umllog;           // handle to the UML logfile
+	bool                        m_optimize;         // run the block-level optimizations?
+	bool                        m_validate;         // validate the back-ends on the next reset?
+	drcuml_stats                m_stats;            // counts of code generated
+	std::unordered_set<UINT64>  m_compiled;         // mode/pc of every block ever compiled
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
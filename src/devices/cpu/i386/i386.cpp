@@ -18,6 +18,7 @@
 */
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "i386priv.h"
 #include "i386.h"
@@ -51,6 +52,8 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 
 	// 32 unified
 	set_vtlb_dynamic_entries(32);
+
+	m_isdrc = allow_experimental_drc();
 }
 
 
@@ -66,6 +69,8 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 
 	// 32 unified
 	set_vtlb_dynamic_entries(32);
+
+	m_isdrc = allow_experimental_drc();
 }
 
 i386SX_device::i386SX_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
@@ -2885,6 +2890,7 @@ void i386_device::report_invalid_modrm(const char* opcode, UINT8 modrm)
 #include "i486ops.inc"
 #include "pentops.inc"
 #include "x87ops.inc"
+#include "i386drc.inc"
 #include "i386ops.h"
 
 void i386_device::i386_decode_opcode()
@@ -3203,6 +3209,7 @@ void i386_device::i386_postload()
 	for (i = 0; i < 6; i++)
 		i386_load_segment_descriptor(i);
 	CHANGE_PC(m_eip);
+	m_cache_dirty = TRUE;
 }
 
 void i386_device::i386_common_init()
@@ -3316,6 +3323,9 @@ void i386_device::i386_common_init()
 	m_smiact.resolve_safe();
 
 	m_icountptr = &m_cycles;
+
+	if (m_isdrc)
+		i386_drc_init();
 }
 
 void i386_device::device_start()
@@ -3917,10 +3927,61 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic();
+	// compiled code checks code pages against the A20 mask
+	m_cache_dirty = TRUE;
+}
+
+void i386_device::i386_execute_one()
+{
+	i386_check_irq_line();
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
+
+	m_ext = 1;
+	int old_tf = m_TF;
+
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
+
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
+#ifdef DEBUG_MISSING_OPCODE
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
+#endif
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
+		{
+			m_prev_eip = m_eip;
+			m_ext = 1;
+			i386_trap(1,0,0);
+		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+	}
 }
 
 void i386_device::execute_run()
 {
+	// compare the recompiler against the interpreter once, if asked to
+	if (m_isdrc && !m_drc_validated && machine().options().drc_validate())
+		validate_drc();
+
 	int cycles = m_cycles;
 	m_base_cycles = cycles;
 	CHANGE_PC(m_eip);
@@ -3934,47 +3995,12 @@ void i386_device::execute_run()
 
 	while( m_cycles > 0 )
 	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
-
-		m_ext = 1;
-		int old_tf = m_TF;
-
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
-
-		debugger_instruction_hook(this, m_pc);
-
-		if(m_delayed_interrupt_enable != 0)
+		if (m_isdrc && drc_eligible())
 		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
-#ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
-#endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
-		{
-			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			execute_run_drc();
+			continue;
 		}
+		i386_execute_one();
 	}
 	m_tsc += (cycles - m_cycles);
 }
@@ -9,6 +9,9 @@
 #include "softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "divtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
 
 
 #define INPUT_LINE_A20      1
@@ -24,8 +27,12 @@
 
 #define X86_NUM_CPUS        4
 
+class i386_frontend;
+
 class i386_device : public cpu_device, public device_vtlb_interface
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -1415,7 +1422,148 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	// recompiler; blocks are hashed by paging (bit 0) and CPL 3 (bit 1)
+	static const int DRC_MODES = 4;
+
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* hash mode being compiled */
+		uml::code_label labelnum;                   /* index for local labels */
+	};
+
+	/* state the compiled code addresses directly; it comes from the DRC cache's near memory, so it */
+	/* is copied from the interpreter's state on the way in and back on the way out and around helpers */
+	struct drc_state
+	{
+		I386_GPR        reg;                        /* general registers */
+		UINT32          eip;                        /* EIP */
+		UINT32          pc;                         /* linear PC */
+		INT32           cycles;                     /* cycles left in the timeslice */
+		UINT32          a20_mask;                   /* A20 gate mask */
+		UINT32          mode;                       /* hash mode of the code being run */
+		UINT32          leave;                      /* set by helpers when compiled code must leave the block */
+		UINT32          helper_eip;                 /* EIP of the instruction calling a helper */
+		UINT32          addr;                       /* address of a slow memory access */
+		UINT32          data;                       /* data of a slow memory access, or the expected next EIP */
+	};
+
+	bool m_isdrc;
+	drc_state *m_drc;                               /* near copy of the state, only allocated when the DRC is used */
+	std::unique_ptr<drc_cache> m_cache;             /* DRC code cache, only allocated when the DRC is used */
+	std::unique_ptr<drcuml_state> m_drcuml;         /* DRC UML generator state */
+	std::unique_ptr<i386_frontend> m_drcfe;         /* DRC front-end state */
+	UINT8 m_cache_dirty;                            /* true if we need to flush the cache */
+	bool m_drc_validated;                           /* true once -drc_validate has run */
+
+	uml::code_handle *m_entry;                      /* entry point */
+	uml::code_handle *m_nocode;                     /* nocode exception handler */
+	uml::code_handle *m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *m_redispatch;                 /* leave the block after an interpreted instruction */
+	uml::code_handle *m_tlb_mismatch;               /* refresh the TLB entry for a code page */
+	uml::code_handle *m_read[DRC_MODES][3];         /* read byte, word and dword per mode */
+	uml::code_handle *m_write[DRC_MODES][3];        /* write byte, word and dword per mode */
+
+	void i386_drc_init();
+	void execute_run_drc();
+	bool drc_eligible() const;
+	UINT8 drc_mode() const;
+	void code_flush_cache();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_redispatch();
+	void static_generate_tlb_mismatch();
+	void static_generate_memory_accessor(int mode, int size, bool iswrite, const char *name, uml::code_handle **handleptr);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, UINT32 cycles);
+	void generate_flush_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_validate_tlb(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 cycles);
+	void generate_condition(drcuml_block *block, int cc);
+	void generate_ea(drcuml_block *block, const UINT8 *modrm);
+	void generate_read(drcuml_block *block, compiler_state *compiler, int size);
+	void generate_write(drcuml_block *block, compiler_state *compiler, int size);
+	void generate_load_reg(drcuml_block *block, uml::parameter dst, int size, int reg);
+	void generate_store_reg(drcuml_block *block, int size, int reg, uml::parameter src);
+	void generate_store_flags(drcuml_block *block, UINT32 flags, int size, bool logic);
+	bool generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	bool generate_alu(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int alu, int size, int form, const UINT8 *modrm, UINT32 imm);
+	bool generate_shift(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, const UINT8 *modrm, int count);
+	void drc_load_state();
+	void drc_store_state();
+	void validate_setup(int kind, UINT32 &seed);
+	int validate_one(UINT8 *bytes, int kind, UINT8 *scratch, UINT32 &seed, std::string *errors);
+	void validate_drc();
+
+public:
+	void func_interpret();
+	void func_read(int size);
+	void func_write(int size);
+	void func_validate_fetch();
+	void func_debug();
+};
+
+
+/* front end for the recompiler; native code is only described for unprefixed 32-bit instructions */
+class i386_frontend : public drc_frontend
+{
+public:
+	// flags tracked in regin[0]/regout[0]
+	enum
+	{
+		FLAG_CF = 0x01,
+		FLAG_PF = 0x02,
+		FLAG_AF = 0x04,
+		FLAG_ZF = 0x08,
+		FLAG_SF = 0x10,
+		FLAG_OF = 0x20,
+		FLAG_ALL = 0x3f
+	};
+
+	// pseudo-register tracked in regout[1]
+	enum
+	{
+		REGFLAG_INTERPRETED = 0x01      // instruction is run by the interpreter
+	};
+
+	// a 32-bit ModR/M operand
+	struct modrm_info
+	{
+		UINT8   mod;                // mod field; 3 is a register operand
+		UINT8   reg;                // reg field
+		UINT8   rm;                 // r/m field
+		INT8    base;               // base register, or -1
+		INT8    index;              // index register, or -1
+		UINT8   scale;              // index shift
+		UINT32  disp;               // displacement
+		UINT8   length;             // bytes used by ModR/M, SIB and displacement
+	};
+
+	i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	// describe one instruction already in memory, for -drc_validate
+	bool describe_test(opcode_desc &desc, offs_t pc);
+
+	static void decode_modrm(const UINT8 *bytes, modrm_info &info);
+	static UINT32 condition_flags(int cc);
+	static bool crosses_page(const opcode_desc &desc) { return ((desc.pc ^ (desc.pc + desc.length - 1)) & ~0xfff) != 0; }
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool fetch(opcode_desc &desc);
+	bool describe_native(opcode_desc &desc);
+	bool describe_two_byte(opcode_desc &desc);
+	void describe_interpreted(opcode_desc &desc);
 
+	i386_device *m_i386;
 };
 
 
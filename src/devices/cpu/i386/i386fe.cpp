@@ -0,0 +1,586 @@
+// license:BSD-3-Clause
+// copyright-holders:Ville Linde, Barry Rodewald, Carl, Philip Bennett
+/***************************************************************************
+
+    i386fe.cpp
+
+    Front end for the i386 recompiler. Only unprefixed 32-bit
+    instructions are described in detail; everything else is left to the
+    interpreter, with its length taken from the disassembler.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* flags written by each group of ALU operations */
+#define ARITH_FLAGS     (i386_frontend::FLAG_ALL)
+#define LOGIC_FLAGS     (i386_frontend::FLAG_CF | i386_frontend::FLAG_PF | i386_frontend::FLAG_ZF | i386_frontend::FLAG_SF | i386_frontend::FLAG_OF)
+#define INCDEC_FLAGS    (i386_frontend::FLAG_ALL & ~i386_frontend::FLAG_CF)
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    fetch_dword - assemble a little-endian dword
+    from the opcode bytes
+-------------------------------------------------*/
+
+static inline UINT32 fetch_dword(const UINT8 *bytes)
+{
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+}
+
+
+/*-------------------------------------------------
+    alu_flags - set the flags read and written by
+    ALU operation 'alu' (ADD, OR, ADC, SBB, AND,
+    SUB, XOR, CMP)
+-------------------------------------------------*/
+
+static inline void alu_flags(opcode_desc &desc, int alu)
+{
+	desc.regout[0] |= (alu == 1 || alu == 4 || alu == 6) ? LOGIC_FLAGS : ARITH_FLAGS;
+	if (alu == 2 || alu == 3)
+		desc.regin[0] |= i386_frontend::FLAG_CF;
+}
+
+
+/*-------------------------------------------------
+    adc_sbb_byte - return true for the byte forms
+    of ADC and SBB, whose carry-in the recompiler
+    can't fold into a shifted operand
+-------------------------------------------------*/
+
+static inline bool adc_sbb_byte(int alu, int wide)
+{
+	return !wide && (alu == 2 || alu == 3);
+}
+
+
+/*-------------------------------------------------
+    modrm_memory - flag a memory operand, if the
+    ModR/M byte has one
+-------------------------------------------------*/
+
+static inline void modrm_memory(opcode_desc &desc, const i386_frontend::modrm_info &modrm, bool read, bool write)
+{
+	if (modrm.mod == 3)
+		return;
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+	if (read)
+		desc.flags |= OPFLAG_READS_MEMORY;
+	if (write)
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+}
+
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+i386_frontend::i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_i386(device)
+{
+}
+
+
+/*-------------------------------------------------
+    describe_test - describe the instruction at
+    'pc' on its own, the way describe_code would
+    if it were the last one in a sequence
+-------------------------------------------------*/
+
+bool i386_frontend::describe_test(opcode_desc &desc, offs_t pc)
+{
+	desc.m_next = nullptr;
+	desc.branch = nullptr;
+	desc.delay.reset();
+	desc.pc = pc;
+	desc.physpc = pc;
+	desc.targetpc = BRANCH_TARGET_DYNAMIC;
+	memset(&desc.opptr, 0x00, sizeof(desc.opptr));
+	desc.length = 0;
+	desc.delayslots = 0;
+	desc.skipslots = 0;
+	desc.flags = 0;
+	desc.cycles = 0;
+	memset(desc.regin, 0x00, sizeof(desc.regin));
+	memset(desc.regout, 0x00, sizeof(desc.regout));
+	memset(desc.regreq, 0x00, sizeof(desc.regreq));
+	if (!describe(desc, nullptr))
+		return false;
+
+	/* nothing follows, so everything it writes is needed */
+	memcpy(desc.regreq, desc.regout, sizeof(desc.regreq));
+	return true;
+}
+
+
+/*-------------------------------------------------
+    decode_modrm - decode a ModR/M byte and its
+    SIB byte and displacement with 32-bit
+    addressing
+-------------------------------------------------*/
+
+void i386_frontend::decode_modrm(const UINT8 *bytes, modrm_info &info)
+{
+	info.mod = bytes[0] >> 6;
+	info.reg = (bytes[0] >> 3) & 7;
+	info.rm = bytes[0] & 7;
+	info.base = -1;
+	info.index = -1;
+	info.scale = 0;
+	info.disp = 0;
+	info.length = 1;
+	if (info.mod == 3)
+		return;
+
+	/* r/m 4 means a SIB byte follows */
+	int base = info.rm;
+	if (info.rm == 4)
+	{
+		UINT8 sib = bytes[info.length++];
+		info.scale = sib >> 6;
+		if (((sib >> 3) & 7) != 4)
+			info.index = (sib >> 3) & 7;
+		base = sib & 7;
+	}
+
+	/* EBP as a base with mod 0 means a bare 32-bit displacement */
+	if (base == 5 && info.mod == 0)
+	{
+		info.disp = fetch_dword(&bytes[info.length]);
+		info.length += 4;
+	}
+	else
+		info.base = base;
+
+	if (info.mod == 1)
+		info.disp = (INT32)(INT8)bytes[info.length++];
+	else if (info.mod == 2)
+	{
+		info.disp = fetch_dword(&bytes[info.length]);
+		info.length += 4;
+	}
+}
+
+
+/*-------------------------------------------------
+    condition_flags - return the flags read by a
+    Jcc/SETcc condition code
+-------------------------------------------------*/
+
+UINT32 i386_frontend::condition_flags(int cc)
+{
+	static const UINT32 s_flags[8] =
+	{
+		FLAG_OF,                        // O/NO
+		FLAG_CF,                        // B/AE
+		FLAG_ZF,                        // Z/NZ
+		FLAG_CF | FLAG_ZF,              // BE/A
+		FLAG_SF,                        // S/NS
+		FLAG_PF,                        // P/NP
+		FLAG_SF | FLAG_OF,              // L/GE
+		FLAG_SF | FLAG_OF | FLAG_ZF     // LE/G
+	};
+	return s_flags[(cc >> 1) & 7];
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	/* a page fault on the first byte leaves the fetch to the interpreter */
+	if (!fetch(desc))
+	{
+		desc.length = 1;
+		desc.regin[0] = FLAG_ALL;
+		desc.regout[1] = REGFLAG_INTERPRETED;
+		desc.flags |= OPFLAG_VALIDATE_TLB | OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_COMPILER_PAGE_FAULT | OPFLAG_END_SEQUENCE;
+		return true;
+	}
+
+	if (!describe_native(desc))
+		describe_interpreted(desc);
+
+	/* the interpreter fetches instructions that straddle a page itself; the next page is validated by a new sequence */
+	if (crosses_page(desc))
+	{
+		desc.regin[0] = FLAG_ALL;
+		desc.regout[0] = 0;
+		desc.regout[1] = REGFLAG_INTERPRETED;
+		desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+	}
+
+	/* an exception pushes EFLAGS, so every flag must be up to date before anything that can fault */
+	if (desc.flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+		desc.regin[0] = FLAG_ALL;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    fetch - read up to 16 opcode bytes through
+    the current translation; returns false if the
+    first byte is not mapped
+-------------------------------------------------*/
+
+bool i386_frontend::fetch(opcode_desc &desc)
+{
+	offs_t physpc = desc.pc;
+	if (!m_i386->memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, physpc))
+		return false;
+	desc.physpc = physpc;
+
+	/* bytes on a following page that isn't mapped are left as zero */
+	offs_t phys = physpc;
+	for (int bytenum = 0; bytenum < 16; bytenum++)
+	{
+		offs_t pc = desc.pc + bytenum;
+		if (bytenum != 0 && (pc & 0xfff) == 0)
+		{
+			phys = pc;
+			if (!m_i386->memory_translate(AS_PROGRAM, TRANSLATE_FETCH_DEBUG, phys))
+				break;
+		}
+		desc.opptr.b[bytenum] = m_i386->m_direct->read_byte(phys);
+		phys++;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    describe_native - describe the instructions
+    the recompiler generates code for; returns
+    false for anything else
+-------------------------------------------------*/
+
+bool i386_frontend::describe_native(opcode_desc &desc)
+{
+	const UINT8 *op = desc.opptr.b;
+	modrm_info modrm;
+
+	switch (op[0])
+	{
+		/* ALU r/m,reg and reg,r/m */
+		case 0x00: case 0x01: case 0x02: case 0x03:
+		case 0x08: case 0x09: case 0x0a: case 0x0b:
+		case 0x10: case 0x11: case 0x12: case 0x13:
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+		case 0x20: case 0x21: case 0x22: case 0x23:
+		case 0x28: case 0x29: case 0x2a: case 0x2b:
+		case 0x30: case 0x31: case 0x32: case 0x33:
+		case 0x38: case 0x39: case 0x3a: case 0x3b:
+			if (adc_sbb_byte(op[0] >> 3, op[0] & 1))
+				return false;
+			decode_modrm(&op[1], modrm);
+			desc.length = 1 + modrm.length;
+			alu_flags(desc, op[0] >> 3);
+			modrm_memory(desc, modrm, true, (op[0] & 2) == 0 && (op[0] >> 3) != 7);
+			return true;
+
+		/* ALU AL/EAX,imm */
+		case 0x04: case 0x0c: case 0x14: case 0x1c: case 0x24: case 0x2c: case 0x34: case 0x3c:
+			if (adc_sbb_byte(op[0] >> 3, 0))
+				return false;
+			desc.length = 2;
+			alu_flags(desc, op[0] >> 3);
+			return true;
+
+		case 0x05: case 0x0d: case 0x15: case 0x1d: case 0x25: case 0x2d: case 0x35: case 0x3d:
+			desc.length = 5;
+			alu_flags(desc, op[0] >> 3);
+			return true;
+
+		/* INC/DEC reg */
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			desc.length = 1;
+			desc.regout[0] |= INCDEC_FLAGS;
+			return true;
+
+		/* PUSH/POP reg */
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+			desc.length = 1;
+			desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			desc.length = 1;
+			desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		/* PUSH imm */
+		case 0x68:
+		case 0x6a:
+			desc.length = (op[0] == 0x68) ? 5 : 2;
+			desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		/* Jcc rel8 */
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			desc.length = 2;
+			desc.regin[0] |= condition_flags(op[0]);
+			desc.targetpc = desc.pc + 2 + (INT8)op[1];
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		/* group 1 r/m,imm */
+		case 0x80:
+		case 0x81:
+		case 0x83:
+			decode_modrm(&op[1], modrm);
+			if (adc_sbb_byte(modrm.reg, op[0] != 0x80))
+				return false;
+			desc.length = 1 + modrm.length + ((op[0] == 0x81) ? 4 : 1);
+			alu_flags(desc, modrm.reg);
+			modrm_memory(desc, modrm, true, modrm.reg != 7);
+			return true;
+
+		/* TEST r/m,reg */
+		case 0x84:
+		case 0x85:
+			decode_modrm(&op[1], modrm);
+			desc.length = 1 + modrm.length;
+			desc.regout[0] |= LOGIC_FLAGS;
+			modrm_memory(desc, modrm, true, false);
+			return true;
+
+		/* MOV r/m,reg and reg,r/m */
+		case 0x88: case 0x89: case 0x8a: case 0x8b:
+			decode_modrm(&op[1], modrm);
+			desc.length = 1 + modrm.length;
+			modrm_memory(desc, modrm, (op[0] & 2) != 0, (op[0] & 2) == 0);
+			return true;
+
+		/* LEA */
+		case 0x8d:
+			decode_modrm(&op[1], modrm);
+			if (modrm.mod == 3)
+				return false;
+			desc.length = 1 + modrm.length;
+			return true;
+
+		/* NOP, CDQ */
+		case 0x90:
+		case 0x99:
+			desc.length = 1;
+			return true;
+
+		/* MOV AL/EAX,moffs and moffs,AL/EAX */
+		case 0xa0: case 0xa1: case 0xa2: case 0xa3:
+			desc.length = 5;
+			desc.flags |= ((op[0] & 2) ? OPFLAG_WRITES_MEMORY : OPFLAG_READS_MEMORY) | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		/* TEST AL/EAX,imm */
+		case 0xa8:
+		case 0xa9:
+			desc.length = (op[0] == 0xa8) ? 2 : 5;
+			desc.regout[0] |= LOGIC_FLAGS;
+			return true;
+
+		/* MOV reg,imm */
+		case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+			desc.length = 2;
+			return true;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			desc.length = 5;
+			return true;
+
+		/* SHL/SHR/SAR r/m32,imm8 and r/m32,1 */
+		case 0xc1:
+		case 0xd1:
+		{
+			decode_modrm(&op[1], modrm);
+			if (modrm.reg != 4 && modrm.reg != 5 && modrm.reg != 7)
+				return false;
+			int count = (op[0] == 0xd1) ? 1 : (op[1 + modrm.length] & 0x1f);
+			if (count == 0)
+				return false;
+			desc.length = 1 + modrm.length + ((op[0] == 0xc1) ? 1 : 0);
+			desc.regout[0] |= FLAG_CF | FLAG_PF | FLAG_ZF | FLAG_SF | ((count == 1) ? FLAG_OF : 0);
+			modrm_memory(desc, modrm, true, true);
+			return true;
+		}
+
+		/* RET, RET imm16 */
+		case 0xc2:
+		case 0xc3:
+			desc.length = (op[0] == 0xc2) ? 3 : 1;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_READS_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		/* MOV r/m,imm */
+		case 0xc6:
+		case 0xc7:
+			decode_modrm(&op[1], modrm);
+			if (modrm.reg != 0)
+				return false;
+			desc.length = 1 + modrm.length + ((op[0] == 0xc7) ? 4 : 1);
+			modrm_memory(desc, modrm, false, true);
+			return true;
+
+		/* LOOP, JECXZ */
+		case 0xe2:
+		case 0xe3:
+			desc.length = 2;
+			desc.targetpc = desc.pc + 2 + (INT8)op[1];
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		/* CALL rel32 */
+		case 0xe8:
+			desc.length = 5;
+			desc.targetpc = desc.pc + 5 + fetch_dword(&op[1]);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		/* JMP rel32, JMP rel8 */
+		case 0xe9:
+		case 0xeb:
+			desc.length = (op[0] == 0xe9) ? 5 : 2;
+			desc.targetpc = desc.pc + desc.length + ((op[0] == 0xe9) ? fetch_dword(&op[1]) : (INT8)op[1]);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			return true;
+
+		/* CLD, STD */
+		case 0xfc:
+		case 0xfd:
+			desc.length = 1;
+			return true;
+
+		/* CALL r/m32, JMP r/m32 */
+		case 0xff:
+			decode_modrm(&op[1], modrm);
+			if (modrm.reg != 2 && modrm.reg != 4)
+				return false;
+			desc.length = 1 + modrm.length;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			modrm_memory(desc, modrm, true, false);
+			if (modrm.reg == 2)
+				desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_CAN_CAUSE_EXCEPTION;
+			return true;
+
+		case 0x0f:
+			return describe_two_byte(desc);
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    describe_two_byte - describe the native 0x0F
+    instructions
+-------------------------------------------------*/
+
+bool i386_frontend::describe_two_byte(opcode_desc &desc)
+{
+	const UINT8 *op = desc.opptr.b;
+	modrm_info modrm;
+
+	switch (op[1])
+	{
+		/* Jcc rel32 */
+		case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+		case 0x88: case 0x89: case 0x8a: case 0x8b: case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			desc.length = 6;
+			desc.regin[0] |= condition_flags(op[1]);
+			desc.targetpc = desc.pc + 6 + fetch_dword(&op[2]);
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			return true;
+
+		/* SETcc r/m8 */
+		case 0x90: case 0x91: case 0x92: case 0x93: case 0x94: case 0x95: case 0x96: case 0x97:
+		case 0x98: case 0x99: case 0x9a: case 0x9b: case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+			decode_modrm(&op[2], modrm);
+			desc.length = 2 + modrm.length;
+			desc.regin[0] |= condition_flags(op[1]);
+			modrm_memory(desc, modrm, false, true);
+			return true;
+
+		/* MOVZX/MOVSX reg,r/m8 and reg,r/m16 */
+		case 0xb6: case 0xb7: case 0xbe: case 0xbf:
+			decode_modrm(&op[2], modrm);
+			desc.length = 2 + modrm.length;
+			modrm_memory(desc, modrm, true, false);
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    describe_interpreted - describe an instruction
+    left to the interpreter
+-------------------------------------------------*/
+
+void i386_frontend::describe_interpreted(opcode_desc &desc)
+{
+	const UINT8 *op = desc.opptr.b;
+	char buffer[256];
+
+	/* the disassembler knows the length of every instruction, prefixes included */
+	desc.length = m_i386->disasm_disassemble(buffer, desc.pc, op, op, 0) & DASMFLAG_LENGTHMASK;
+	if (desc.length == 0)
+		desc.length = 1;
+
+	/* the interpreter may read and write any flag, and any memory */
+	desc.regin[0] = FLAG_ALL;
+	desc.regout[0] = 0;
+	desc.regout[1] = REGFLAG_INTERPRETED;
+	desc.flags |= OPFLAG_CAN_CAUSE_EXCEPTION;
+
+	switch (op[0])
+	{
+		/* far transfers, interrupts and HLT leave the block for good */
+		case 0x9a: case 0xca: case 0xcb: case 0xcc: case 0xcd: case 0xcf: case 0xea: case 0xf4:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		/* LOOPNZ/LOOPZ have a static target */
+		case 0xe0:
+		case 0xe1:
+			desc.targetpc = desc.pc + 2 + (INT8)op[1];
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		/* CALL/JMP far r/m */
+		case 0xff:
+			if (((op[1] >> 3) & 7) == 3 || ((op[1] >> 3) & 7) == 5)
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		/* system instructions may change the translation of the code that follows */
+		case 0x0f:
+			switch (op[1])
+			{
+				case 0x00: case 0x01: case 0x06: case 0x08: case 0x09:
+				case 0x20: case 0x21: case 0x22: case 0x23:
+				case 0x30: case 0x34: case 0x35: case 0xaa:
+					desc.flags |= OPFLAG_MODIFIES_TRANSLATION | OPFLAG_END_SEQUENCE;
+					break;
+			}
+			break;
+	}
+}
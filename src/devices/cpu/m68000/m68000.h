@@ -252,6 +252,7 @@ public:
 	UINT32 nmi_pending;
 
 	void (**jump_table)(m68000_base_device *m68k);
+	void (**jump_table_000)(m68000_base_device *m68k);  /* 68000 specialized handlers, if this CPU can use them */
 	const UINT8* cyc_instruction;
 	const UINT8* cyc_exception;
 
@@ -395,6 +396,8 @@ public:
 
 	void reset_cpu(void);
 	inline void cpu_execute(void);
+	void benchmark_setup(void);
+	void benchmark_handlers(void);
 
 	// device_state_interface overrides
 	virtual void state_import(const device_state_entry &entry) override;
@@ -39,6 +39,8 @@ must fix:
  *    M68KMAKE_OPCODE_HANDLER_HEADER - header for opcode handler implementation
  *    M68KMAKE_OPCODE_HANDLER_FOOTER - footer for opcode handler implementation
  *    M68KMAKE_OPCODE_HANDLER_BODY   - body section for opcode handler implementation
+ *    M68KMAKE_OPCODE_HANDLER_000_HEADER - header for the 68000 specialized handlers
+ *    M68KMAKE_OPCODE_HANDLER_000_FOOTER - footer for the 68000 specialized handlers
  *
  * NOTE: M68KMAKE_OPCODE_HANDLER_BODY must be last in the file and
  *       M68KMAKE_TABLE_BODY must be second last in the file.
@@ -98,6 +100,10 @@ void m68ki_build_opcode_table(void);
 extern void (*m68ki_instruction_jump_table[][0x10000])(m68000_base_device *m68k); /* opcode handler jump table */
 extern unsigned char m68ki_cycles[][0x10000];
 
+/* Handlers specialized for a plain 68000, and the loop that runs them */
+extern void (*m68ki_instruction_jump_table_000[0x10000])(m68000_base_device *m68k);
+void m68ki_run_000(m68000_base_device *m68k);
+
 
 /* ======================================================================== */
 /* ============================== END OF FILE ============================= */
@@ -119,11 +125,13 @@ M68KMAKE_TABLE_HEADER
 
 void (*m68ki_instruction_jump_table[NUM_CPU_TYPES][0x10000])(m68000_base_device *m68k); /* opcode handler jump table */
 unsigned char m68ki_cycles[NUM_CPU_TYPES][0x10000]; /* Cycles used by CPU type */
+void (*m68ki_instruction_jump_table_000[0x10000])(m68000_base_device *m68k); /* 68000 specialized handlers */
 
 /* This is used to generate the opcode handler jump table */
 struct opcode_handler_struct
 {
 	void (*opcode_handler)(m68000_base_device *m68k);        /* handler function */
+	void (*opcode_handler_000)(m68000_base_device *m68k);    /* 68000 specialized handler, if the 68000 has it */
 	unsigned int  mask;                  /* mask on opcode */
 	unsigned int  match;                 /* what to match after masking */
 	unsigned char cycles[NUM_CPU_TYPES]; /* cycles each cpu type takes */
@@ -133,14 +141,14 @@ struct opcode_handler_struct
 /* Opcode handler table */
 static const opcode_handler_struct m68k_opcode_handler_table[] =
 {
-/*   function                      mask    match    000  010  020  040 */
+/*   function                      68000 function                mask    match    000  010  020  040 */
 
 
 
 XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 M68KMAKE_TABLE_FOOTER
 
-	{nullptr, 0, 0, {0, 0, 0, 0, 0}}
+	{nullptr, nullptr, 0, 0, {0, 0, 0, 0, 0}}
 };
 
 
@@ -153,6 +161,8 @@ static void m68ki_set_one(unsigned short opcode, const opcode_handler_struct *s)
 			m68ki_cycles[i][opcode] = s->cycles[i];
 			m68ki_instruction_jump_table[i][opcode] = s->opcode_handler;
 		}
+	if(s->opcode_handler_000 != nullptr)
+		m68ki_instruction_jump_table_000[opcode] = s->opcode_handler_000;
 }
 
 void m68ki_build_opcode_table(void)
@@ -170,6 +180,7 @@ void m68ki_build_opcode_table(void)
 			m68ki_instruction_jump_table[k][i] = m68000_base_device_ops::m68k_op_illegal;
 			m68ki_cycles[k][i] = 0;
 		}
+		m68ki_instruction_jump_table_000[i] = m68000_base_device_ops::m68k_op_illegal;
 	}
 
 	ostruct = m68k_opcode_handler_table;
@@ -282,6 +293,67 @@ M68KMAKE_OPCODE_HANDLER_FOOTER
 
 
 
+XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+M68KMAKE_OPCODE_HANDLER_000_HEADER
+
+/* Fix the CPU type at compile time so the checks in the handlers and in
+ * m68kcpu.h fold away, and fetch opcodes straight from the direct read
+ * pointer.  Only a plain 68000 may use anything in this file.
+ */
+#define M68K_SPECIALIZE_000
+
+#include "emu.h"
+#include "m68kcpu.h"
+#include "m68kops.h"
+
+/* ======================================================================== */
+/* ================ 68000 SPECIALIZED INSTRUCTION HANDLERS ================ */
+/* ======================================================================== */
+
+
+
+XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+M68KMAKE_OPCODE_HANDLER_000_FOOTER
+
+/* Run the specialized handlers until the timeslice is used up.  This is the
+ * main loop of cpu_execute() without the debugger and instruction hooks or
+ * the PMMU path; the caller makes sure none of them are needed and handles
+ * address errors.
+ *
+ * Cycles are not batched across instructions: each handler still takes its
+ * own count before the next one runs.  Memory handlers, timers and
+ * total_cycles() read remaining_cycles in the middle of a timeslice, and
+ * adjust_icount()/eat_cycles() and the interrupt checks change it, so
+ * settling up once per block would move every one of those by up to a
+ * block's worth of cycles.
+ */
+void m68ki_run_000(m68000_base_device *m68k)
+{
+	while (m68k->remaining_cycles > 0)
+	{
+		/* Set tracing according to T1. (T0 is done inside instruction) */
+		m68ki_trace_t1(m68k);
+
+		/* Record previous program counter */
+		REG_PPC(m68k) = REG_PC(m68k);
+
+		/* Read an instruction and call its handler, which takes its own cycles */
+		m68k->run_mode = RUN_MODE_NORMAL;
+		m68k->ir = m68ki_read_imm_16(m68k);
+		m68ki_instruction_jump_table_000[m68k->ir](m68k);
+
+		/* Trace m68k_exception, if necessary */
+		m68ki_exception_if_trace(m68k);
+	}
+}
+
+
+/* ======================================================================== */
+/* ============================== END OF FILE ============================= */
+/* ======================================================================== */
+
+
+
 XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 M68KMAKE_TABLE_BODY
 /*
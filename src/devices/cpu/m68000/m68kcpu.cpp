@@ -25,6 +25,7 @@ static const char copyright_notice[] =
 /* ======================================================================== */
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "m68kcpu.h"
 #include "m68kops.h"
@@ -826,6 +827,26 @@ inline void m68000_base_device::cpu_execute(void)
 		}
 
 
+		/* A plain 68000 with no debugger or instruction hook runs the
+		   specialized handlers, which use up the whole timeslice */
+		if (jump_table_000 != nullptr && !(machine().debug_flags & DEBUG_FLAG_ENABLED) && instruction_hook.isnull())
+		{
+			try
+			{
+				m68ki_run_000(this);
+			}
+			catch (int error)
+			{
+				if (error==10)
+				{
+					m_address_error = 1;
+					goto check_address_error;
+				}
+				else
+					throw;
+			}
+		}
+
 		/* Main loop.  Keep going until we run out of clock cycles */
 		while (remaining_cycles > 0)
 		{
@@ -1087,6 +1108,162 @@ void m68000_base_device::reset_cpu(void)
 
 
 
+/**************************************************************************
+ * HANDLER BENCHMARK
+ **************************************************************************/
+
+/* 64K of RAM is mapped here for the benchmark; code at the start, source
+   words at +0x1000, destination words at +0x2000 and the stack at the top */
+#define BENCHMARK_BASE      0xff0000
+#define BENCHMARK_CYCLES    100000000
+#define BENCHMARK_RUNS      5
+
+/* A fixed instruction mix: register ALU and shifts, loads and stores with
+   postincrement and displacement, an immediate, taken and untaken branches,
+   a subroutine call that saves registers with MOVEM, and a DBRA loop */
+static const UINT16 m68ki_benchmark_code[] =
+{
+	0x41f9, 0x00ff, 0x1000,     /* start: lea     $ff1000, a0       */
+	0x43f9, 0x00ff, 0x2000,     /*        lea     $ff2000, a1       */
+	0x7e3f,                     /*        moveq   #63, d7           */
+	0x3018,                     /* loop:  move.w  (a0)+, d0         */
+	0xd240,                     /*        add.w   d0, d1            */
+	0x32c1,                     /*        move.w  d1, (a1)+         */
+	0x2401,                     /*        move.l  d1, d2            */
+	0xe58a,                     /*        lsl.l   #2, d2            */
+	0xb583,                     /*        eor.l   d2, d3            */
+	0x0240, 0x00ff,             /*        andi.w  #$ff, d0          */
+	0xb840,                     /*        cmp.w   d0, d4            */
+	0x6602,                     /*        bne.s   1f                */
+	0x5285,                     /*        addq.l  #1, d5            */
+	0x4a40,                     /* 1:     tst.w   d0                */
+	0x6702,                     /*        beq.s   2f                */
+	0x5246,                     /*        addq.w  #1, d6            */
+	0x0803, 0x0000,             /* 2:     btst    #0, d3            */
+	0x2343, 0x0100,             /*        move.l  d3, 256(a1)       */
+	0x4843,                     /*        swap    d3                */
+	0x6106,                     /*        bsr.s   sub               */
+	0x51cf, 0xffd6,             /*        dbra    d7, loop          */
+	0x60c4,                     /*        bra.s   start             */
+	0x48e7, 0xf000,             /* sub:   movem.l d0-d3, -(sp)      */
+	0xdc57,                     /*        add.w   (sp), d6          */
+	0x4cdf, 0x000f,             /*        movem.l (sp)+, d0-d3      */
+	0x4e75                      /*        rts                       */
+};
+
+
+/* Put the benchmark program and its data in place and start it from a
+   clean register state */
+void m68000_base_device::benchmark_setup(void)
+{
+	for (unsigned i = 0; i < ARRAY_LENGTH(m68ki_benchmark_code); i++)
+		m_space->write_word(BENCHMARK_BASE + i * 2, m68ki_benchmark_code[i]);
+	for (int i = 0; i < 64; i++)
+		m_space->write_word(BENCHMARK_BASE + 0x1000 + i * 2, (i * 0x9e37) ^ (i << 3));
+	for (int i = 0; i < 0x100; i++)
+		m_space->write_word(BENCHMARK_BASE + 0x2000 + i * 2, 0);
+
+	memset(dar, 0, sizeof(dar));
+	m68ki_set_sr(this, 0x2700);
+	REG_SP(this) = BENCHMARK_BASE + 0xfff0;
+	m68ki_jump(this, BENCHMARK_BASE);
+	REG_PPC(this) = REG_PC(this);
+	pref_addr = ~0;
+
+	stopped = 0;
+	reset_cycles = 0;
+	m_address_error = 0;
+	t1_flag = t0_flag = 0;
+	m68ki_clear_trace(this);
+}
+
+
+/* Run a fixed 68000 instruction mix through the general and the specialized
+   handlers, check that both end up in the same state, and report how many
+   emulated instructions per second each manages */
+void m68000_base_device::benchmark_handlers(void)
+{
+	struct result
+	{
+		UINT32 dar[16];
+		UINT32 pc, sr, checksum;
+		int remaining_cycles;
+		double seconds;
+	} results[2];
+
+	void (**specialized)(m68000_base_device *m68k) = jump_table_000;
+	std::vector<UINT16> ram(0x8000);
+
+	m_space->install_ram(BENCHMARK_BASE, BENCHMARK_BASE + 0xffff, &ram[0]);
+	if (m_ospace != m_space)
+		m_ospace->install_ram(BENCHMARK_BASE, BENCHMARK_BASE + 0xffff, &ram[0]);
+
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) || !instruction_hook.isnull())
+		osd_printf_warning("%s: the debugger or an instruction hook is active, so both runs use the general handlers\n", tag());
+
+	/* count the instructions by running them one at a time */
+	UINT64 instructions = 0;
+	INT64 cycles = 0;
+	jump_table_000 = nullptr;
+	benchmark_setup();
+	while (cycles < BENCHMARK_CYCLES)
+	{
+		remaining_cycles = 1;
+		cpu_execute();
+		cycles += 1 - remaining_cycles;
+		instructions++;
+	}
+
+	/* then time the whole run with each set of handlers, taking turns so */
+	/* neither gets all the cold caches, and keep the best of each */
+	for (int run = 0; run < BENCHMARK_RUNS * 2; run++)
+	{
+		int pass = run & 1;
+		result &res = results[pass];
+
+		jump_table_000 = (pass == 0) ? nullptr : specialized;
+		benchmark_setup();
+		remaining_cycles = BENCHMARK_CYCLES;
+
+		osd_ticks_t start = osd_ticks();
+		cpu_execute();
+		double seconds = double(osd_ticks() - start) / double(osd_ticks_per_second());
+		if (run < 2 || seconds < res.seconds)
+			res.seconds = seconds;
+
+		memcpy(res.dar, dar, sizeof(res.dar));
+		res.pc = REG_PC(this);
+		res.sr = m68ki_get_sr(this);
+		res.remaining_cycles = remaining_cycles;
+		res.checksum = 0;
+		for (int i = 0; i < 0x100; i++)
+			res.checksum = (res.checksum << 1 | res.checksum >> 31) ^ m_space->read_word(BENCHMARK_BASE + 0x2000 + i * 2);
+	}
+
+	/* put the CPU back the way it was */
+	jump_table_000 = specialized;
+	m_space->unmap_readwrite(BENCHMARK_BASE, BENCHMARK_BASE + 0xffff);
+	if (m_ospace != m_space)
+		m_ospace->unmap_readwrite(BENCHMARK_BASE, BENCHMARK_BASE + 0xffff);
+	reset_cpu();
+
+	osd_printf_info("%s: %u instructions in %u cycles (%.2f cycles per instruction)\n",
+		tag(), UINT32(instructions), UINT32(cycles), double(cycles) / double(instructions));
+	static const char *const names[2] = { "general", "specialized" };
+	for (int pass = 0; pass < 2; pass++)
+		osd_printf_info("%s: %-11s handlers %7.1f ms, %6.1f emulated MIPS, %5.1fx real time at %u Hz\n",
+			tag(), names[pass], results[pass].seconds * 1000.0,
+			double(instructions) / results[pass].seconds / 1000000.0,
+			double(cycles) / results[pass].seconds / double(clock()), clock());
+
+	if (memcmp(results[0].dar, results[1].dar, sizeof(results[0].dar)) != 0 || results[0].pc != results[1].pc || results[0].sr != results[1].sr ||
+		results[0].checksum != results[1].checksum || results[0].remaining_cycles != results[1].remaining_cycles)
+		fatalerror("%s: the specialized handlers finished in a different state (PC %06X/%06X, SR %04X/%04X, cycles %d/%d)\n",
+			tag(), results[0].pc, results[1].pc, results[0].sr, results[1].sr, results[0].remaining_cycles, results[1].remaining_cycles);
+}
+
+
+
 /**************************************************************************
  * STATE IMPORT/EXPORT
  **************************************************************************/
@@ -2394,6 +2571,7 @@ void m68000_base_device::clear_all()
 	virq_state = 0;
 	nmi_pending = 0;
 
+	jump_table_000 = nullptr;
 	cyc_instruction = nullptr;
 	cyc_exception = nullptr;
 
@@ -2465,6 +2643,21 @@ void m68000_base_device::device_start()
 void m68000_base_device::device_reset()
 {
 	reset_cpu();
+
+	/* the specialized handlers fetch opcodes the way simple_read_immediate_16 does */
+	if (cpu_type == CPU_TYPE_000 && readimm16 == m68k_readimm16_delegate(FUNC(m68000_base_device::simple_read_immediate_16), this))
+		jump_table_000 = m68ki_instruction_jump_table_000;
+	else
+		jump_table_000 = nullptr;
+
+	/* benchmark the handlers once per session if requested */
+	static bool benchmarked = false;
+	if (jump_table_000 != nullptr && !benchmarked && machine().options().m68k_benchmark())
+	{
+		benchmarked = true;
+		benchmark_handlers();
+		machine().schedule_exit();
+	}
 }
 
 void m68000_base_device::device_stop()
@@ -226,28 +226,36 @@ class m68000_base_device;
 
 /* These defines are dependant on the configuration defines in m68kconf.h */
 
+/* The 68000 specialized handlers (m68kops000.cpp) are compiled with the
+   CPU type fixed, so these comparisons become constants there */
+#ifdef M68K_SPECIALIZE_000
+#define CPU_TYPE_FIXED(A)          CPU_TYPE_000
+#else
+#define CPU_TYPE_FIXED(A)          (A)
+#endif
+
 /* Disable certain comparisons if we're not using all CPU types */
-#define CPU_TYPE_IS_COLDFIRE(A)    ((A) & (CPU_TYPE_COLDFIRE))
+#define CPU_TYPE_IS_COLDFIRE(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_COLDFIRE))
 
-#define CPU_TYPE_IS_040_PLUS(A)    ((A) & (CPU_TYPE_040 | CPU_TYPE_EC040))
+#define CPU_TYPE_IS_040_PLUS(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_040 | CPU_TYPE_EC040))
 #define CPU_TYPE_IS_040_LESS(A)    1
 
-#define CPU_TYPE_IS_030_PLUS(A)    ((A) & (CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040))
+#define CPU_TYPE_IS_030_PLUS(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040))
 #define CPU_TYPE_IS_030_LESS(A)    1
 
-#define CPU_TYPE_IS_020_PLUS(A)    ((A) & (CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
+#define CPU_TYPE_IS_020_PLUS(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
 #define CPU_TYPE_IS_020_LESS(A)    1
 
-#define CPU_TYPE_IS_020_VARIANT(A) ((A) & (CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_FSCPU32))
+#define CPU_TYPE_IS_020_VARIANT(A) (CPU_TYPE_FIXED(A) & (CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_FSCPU32))
 
-#define CPU_TYPE_IS_EC020_PLUS(A)  ((A) & (CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
-#define CPU_TYPE_IS_EC020_LESS(A)  ((A) & (CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010 | CPU_TYPE_EC020))
+#define CPU_TYPE_IS_EC020_PLUS(A)  (CPU_TYPE_FIXED(A) & (CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_030 | CPU_TYPE_EC030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
+#define CPU_TYPE_IS_EC020_LESS(A)  (CPU_TYPE_FIXED(A) & (CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010 | CPU_TYPE_EC020))
 
-#define CPU_TYPE_IS_010(A)         ((A) == CPU_TYPE_010)
-#define CPU_TYPE_IS_010_PLUS(A)    ((A) & (CPU_TYPE_010 | CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_EC030 | CPU_TYPE_030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
-#define CPU_TYPE_IS_010_LESS(A)    ((A) & (CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010))
+#define CPU_TYPE_IS_010(A)         (CPU_TYPE_FIXED(A) == CPU_TYPE_010)
+#define CPU_TYPE_IS_010_PLUS(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_010 | CPU_TYPE_EC020 | CPU_TYPE_020 | CPU_TYPE_EC030 | CPU_TYPE_030 | CPU_TYPE_040 | CPU_TYPE_EC040 | CPU_TYPE_FSCPU32 | CPU_TYPE_COLDFIRE))
+#define CPU_TYPE_IS_010_LESS(A)    (CPU_TYPE_FIXED(A) & (CPU_TYPE_000 | CPU_TYPE_008 | CPU_TYPE_010))
 
-#define CPU_TYPE_IS_000(A)         ((A) == CPU_TYPE_000 || (A) == CPU_TYPE_008)
+#define CPU_TYPE_IS_000(A)         (CPU_TYPE_FIXED(A) == CPU_TYPE_000 || CPU_TYPE_FIXED(A) == CPU_TYPE_008)
 
 
 /* Initiates trace checking before each instruction (t1) */
@@ -487,6 +495,16 @@ public:
 	#undef OPCODE_PROTOTYPES
 };
 
+/* The same handlers specialized for a plain 68000 (m68kops000.cpp); only
+   the ones the 68000 supports are defined */
+class m68000_base_device_ops_000
+{
+public:
+	#define OPCODE_PROTOTYPES
+	#include "m68kops.h"
+	#undef OPCODE_PROTOTYPES
+};
+
 
 
 extern const UINT8    m68ki_shift_8_table[];
@@ -678,6 +696,10 @@ static inline void m68ki_ic_clear(m68000_base_device *m68k)
 
 static inline UINT32 m68ki_ic_readimm16(m68000_base_device *m68k, UINT32 address)
 {
+#ifdef M68K_SPECIALIZE_000
+	// a plain 68000 has no cache and reads opcodes through simple_read_immediate_16
+	return m68k->m_odirect->read_word(address);
+#else
 	if (m68k->cacr & M68K_CACR_EI)
 	{
 		// 68020 series I-cache (MC68020 User's Manual, Section 4 - On-Chip Cache Memory)
@@ -720,6 +742,7 @@ static inline UINT32 m68ki_ic_readimm16(m68000_base_device *m68k, UINT32 address
 	}
 
 	return m68k->readimm16(address);
+#endif
 }
 
 /* Handles all immediate reads, does address error check, function code setting,
@@ -35,6 +35,12 @@
  * where output path is the path where the output files should be placed, and
  * input file is the file to use for input.
  *
+ * Besides the general opcode handlers and their table, it writes a second
+ * copy of every handler the 68000 supports to m68kops000.cpp.  That file is
+ * compiled with the CPU type fixed to a plain 68000, and each handler there
+ * subtracts its own 68000 cycle count, so the fast dispatch loop does not
+ * need to look it up.
+ *
  * If you modify the input file greatly from its released form, you may have
  * to tweak the configuration section a bit since I'm using static allocation
  * to keep things simple.
@@ -95,6 +101,7 @@ static const char g_version[] = "4.90";
 #define FILENAME_INPUT      "m68k_in.cpp"
 #define FILENAME_PROTOTYPE  "m68kops.h"
 #define FILENAME_TABLE      "m68kops.cpp"
+#define FILENAME_TABLE_000  "m68kops000.cpp"
 
 
 /* Identifier sequences recognized by this program */
@@ -111,6 +118,8 @@ static const char g_version[] = "4.90";
 #define ID_OPHANDLER_HEADER     ID_BASE "_OPCODE_HANDLER_HEADER"
 #define ID_OPHANDLER_FOOTER     ID_BASE "_OPCODE_HANDLER_FOOTER"
 #define ID_OPHANDLER_BODY       ID_BASE "_OPCODE_HANDLER_BODY"
+#define ID_OPHANDLER_000_HEADER ID_BASE "_OPCODE_HANDLER_000_HEADER"
+#define ID_OPHANDLER_000_FOOTER ID_BASE "_OPCODE_HANDLER_000_FOOTER"
 #define ID_END                  ID_BASE "_END"
 
 #define ID_OPHANDLER_NAME       ID_BASE "_OP"
@@ -239,6 +248,7 @@ static void add_replace_string(replace_struct* replace, const char* search_str,
 static void write_body(FILE* filep, body_struct* body, replace_struct* replace);
 static void get_base_name(char* base_name, opcode_struct* op);
 static void write_function_name(FILE* filep, char* base_name);
+static void write_function_000(FILE* filep, char* base_name, body_struct* body, replace_struct* replace, int cycles);
 static void add_opcode_output_table_entry(opcode_struct* op, char* name);
 static int DECL_SPEC compare_nof_true_bits(const void* aptr, const void* bptr);
 static void print_opcode_output_table(FILE* filep);
@@ -264,6 +274,7 @@ static char g_input_filename[M68K_MAX_PATH];
 static FILE* g_input_file = nullptr;
 static FILE* g_prototype_file = nullptr;
 static FILE* g_table_file = nullptr;
+static FILE* g_table_000_file = nullptr;
 
 static int g_num_functions = 0;  /* Number of functions processed */
 static int g_num_primitives = 0; /* Number of function primitives read */
@@ -485,6 +496,7 @@ static void error_exit(const char* fmt, ...)
 
 	if(g_prototype_file) fclose(g_prototype_file);
 	if(g_table_file) fclose(g_table_file);
+	if(g_table_000_file) fclose(g_table_000_file);
 	if(g_input_file) fclose(g_input_file);
 
 	exit(EXIT_FAILURE);
@@ -501,6 +513,7 @@ static void perror_exit(const char* fmt, ...)
 
 	if(g_prototype_file) fclose(g_prototype_file);
 	if(g_table_file) fclose(g_table_file);
+	if(g_table_000_file) fclose(g_table_000_file);
 	if(g_input_file) fclose(g_input_file);
 
 	exit(EXIT_FAILURE);
@@ -799,6 +812,22 @@ static void write_function_name(FILE* filep, char* base_name)
 	fprintf(g_prototype_file, "static void %s(m68000_base_device* mc68kcpu);\n", base_name);
 }
 
+/* Write the 68000 specialization of an opcode handler.  The body goes in a
+ * static inline function so that early returns still reach the cycle count.
+ */
+static void write_function_000(FILE* filep, char* base_name, body_struct* body, replace_struct* replace, int cycles)
+{
+	fprintf(filep, "static inline void %s_body(m68000_base_device* mc68kcpu)\n", base_name);
+	write_body(filep, body, replace);
+
+	fprintf(filep, "void m68000_base_device_ops_000::%s(m68000_base_device* mc68kcpu)\n", base_name);
+	fprintf(filep, "{\n");
+	fprintf(filep, "\t%s_body(mc68kcpu);\n", base_name);
+	if(cycles != 0)
+		fprintf(filep, "\tmc68kcpu->remaining_cycles -= %d;\n", cycles);
+	fprintf(filep, "}\n\n\n");
+}
+
 static void add_opcode_output_table_entry(opcode_struct* op, char* name)
 {
 	opcode_struct* ptr;
@@ -809,7 +838,7 @@ static void add_opcode_output_table_entry(opcode_struct* op, char* name)
 
 	*ptr = *op;
 
-	sprintf( ptr->name, "m68000_base_device_ops::%s", name);
+	strcpy(ptr->name, name);
 	ptr->bits = num_bits(ptr->op_mask);
 }
 
@@ -842,8 +871,12 @@ static void write_table_entry(FILE* filep, opcode_struct* op)
 {
 	int i;
 
-	fprintf(filep, "\t{%-28s, 0x%04x, 0x%04x, {",
-		op->name, op->op_mask, op->op_match);
+	fprintf(filep, "\t{m68000_base_device_ops::%s, ", op->name);
+	if(op->cycles[CPU_TYPE_000] != 0xff)
+		fprintf(filep, "m68000_base_device_ops_000::%s, ", op->name);
+	else
+		fprintf(filep, "nullptr, ");
+	fprintf(filep, "0x%04x, 0x%04x, {", op->op_mask, op->op_match);
 
 	for(i=0;i<NUM_CPUS;i++)
 	{
@@ -874,14 +907,15 @@ static void set_opcode_struct(opcode_struct* src, opcode_struct* dst, int ea_mod
 /* Generate a final opcode handler from the provided data */
 static void generate_opcode_handler(FILE* filep, body_struct* body, replace_struct* replace, opcode_struct* opinfo, int ea_mode)
 {
+	char base_name[MAX_LINE_LENGTH+1];
 	char str[MAX_LINE_LENGTH+1];
 	opcode_struct* op = (opcode_struct *)malloc(sizeof(opcode_struct));
 
 	/* Set the opcode structure and write the tables, prototypes, etc */
 	set_opcode_struct(opinfo, op, ea_mode);
-	get_base_name(str, op);
-	add_opcode_output_table_entry(op, str);
-	write_function_name(filep, str);
+	get_base_name(base_name, op);
+	add_opcode_output_table_entry(op, base_name);
+	write_function_name(filep, base_name);
 
 	/* Add any replace strings needed */
 	if(ea_mode != EA_MODE_NONE)
@@ -903,6 +937,10 @@ static void generate_opcode_handler(FILE* filep, body_struct* body, replace_stru
 	/* Now write the function body with the selected replace strings */
 	write_body(filep, body, replace);
 	g_num_functions++;
+
+	/* Anything a 68000 can run also gets its specialized copy */
+	if(op->cycles[CPU_TYPE_000] != 0xff)
+		write_function_000(g_table_000_file, base_name, body, replace, op->cycles[CPU_TYPE_000]);
 	free(op);
 }
 
@@ -1242,6 +1280,8 @@ int main(int argc, char *argv[])
 	char table_footer_insert[MAX_INSERT_LENGTH+1];
 	char ophandler_header_insert[MAX_INSERT_LENGTH+1];
 	char ophandler_footer_insert[MAX_INSERT_LENGTH+1];
+	char ophandler_000_header_insert[MAX_INSERT_LENGTH+1];
+	char ophandler_000_footer_insert[MAX_INSERT_LENGTH+1];
 	/* Flags if we've processed certain parts already */
 	int prototype_header_read = 0;
 	int prototype_footer_read = 0;
@@ -1249,6 +1289,8 @@ int main(int argc, char *argv[])
 	int table_footer_read = 0;
 	int ophandler_header_read = 0;
 	int ophandler_footer_read = 0;
+	int ophandler_000_header_read = 0;
+	int ophandler_000_footer_read = 0;
 	int table_body_read = 0;
 	int ophandler_body_read = 0;
 
@@ -1276,6 +1318,10 @@ int main(int argc, char *argv[])
 	if((g_table_file = fopen(filename, "wt")) == nullptr)
 		perror_exit("Unable to create table file (%s)\n", filename);
 
+	sprintf(filename, "%s/%s", output_path, FILENAME_TABLE_000);
+	if((g_table_000_file = fopen(filename, "wt")) == nullptr)
+		perror_exit("Unable to create 68000 table file (%s)\n", filename);
+
 	if((g_input_file=fopen(g_input_filename, "rt")) == nullptr)
 		perror_exit("can't open %s for input", g_input_filename);
 
@@ -1334,6 +1380,20 @@ int main(int argc, char *argv[])
 			read_insert(ophandler_footer_insert);
 			ophandler_footer_read = 1;
 		}
+		else if(strcmp(section_id, ID_OPHANDLER_000_HEADER) == 0)
+		{
+			if(ophandler_000_header_read)
+				error_exit("Duplicate 68000 opcode handler header");
+			read_insert(ophandler_000_header_insert);
+			ophandler_000_header_read = 1;
+		}
+		else if(strcmp(section_id, ID_OPHANDLER_000_FOOTER) == 0)
+		{
+			if(ophandler_000_footer_read)
+				error_exit("Duplicate 68000 opcode handler footer");
+			read_insert(ophandler_000_footer_insert);
+			ophandler_000_footer_read = 1;
+		}
 		else if(strcmp(section_id, ID_TABLE_BODY) == 0)
 		{
 			if(!prototype_header_read)
@@ -1357,6 +1417,10 @@ int main(int argc, char *argv[])
 				error_exit("Opcode handlers encountered before table header");
 			if(!ophandler_header_read)
 				error_exit("Opcode handlers encountered before opcode handler header");
+			if(!ophandler_000_header_read)
+				error_exit("Opcode handlers encountered before 68000 opcode handler header");
+			if(!ophandler_000_footer_read)
+				error_exit("Opcode handlers encountered before 68000 opcode handler footer");
 			if(!table_body_read)
 				error_exit("Opcode handlers encountered before table body");
 
@@ -1364,10 +1428,12 @@ int main(int argc, char *argv[])
 				error_exit("Duplicate opcode handler section");
 
 			fprintf(g_table_file, "%s\n\n", ophandler_header_insert);
+			fprintf(g_table_000_file, "%s\n\n", ophandler_000_header_insert);
 			fprintf(g_prototype_file, "#ifdef OPCODE_PROTOTYPES\n\n");
 			process_opcode_handlers(g_table_file);
 			fprintf(g_prototype_file, "#else\n");
 			fprintf(g_table_file, "%s\n\n", ophandler_footer_insert);
+			fprintf(g_table_000_file, "%s\n\n", ophandler_000_footer_insert);
 
 			ophandler_body_read = 1;
 		}
@@ -1409,6 +1475,7 @@ int main(int argc, char *argv[])
 	/* Close all files and exit */
 	fclose(g_prototype_file);
 	fclose(g_table_file);
+	fclose(g_table_000_file);
 	fclose(g_input_file);
 
 	printf("Generated %d opcode handlers from %d primitives\n", g_num_functions, g_num_primitives);
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 #include "mips3.h"
 #include "mips3com.h"
@@ -160,6 +161,7 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_cache(CACHE_SIZE + sizeof(internal_mips3_state))
 	, m_drcuml(nullptr)
 	, m_drcfe(nullptr)
+	, m_drctrace(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
 	, m_entry(nullptr)
@@ -205,6 +207,10 @@ void mips3_device::device_stop()
 	{
 		m_drcfe = nullptr;
 	}
+	if (m_drctrace != nullptr)
+	{
+		m_drctrace = nullptr;
+	}
 	if (m_drcuml != nullptr)
 	{
 		m_drcuml = nullptr;
@@ -386,6 +392,7 @@ void mips3_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	m_drctrace = std::make_unique<drc_trace_profile>(*this, m_cache, machine().options().drc_traces() && !SINGLE_INSTRUCTION_MODE);
 
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
@@ -307,8 +307,9 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	/* get a description of this sequence; hot blocks are described as superblocks */
+	UINT32 window_scale = m_drctrace->superblock(mode, pc) ? DRC_TRACE_SUPERBLOCK_SCALE : 1;
+	desclist = m_drcfe->describe_code(pc, window_scale, mode);
 	if (drcuml->logging() || drcuml->logging_native())
 		log_opcode_desc(drcuml, desclist, 0);
 
@@ -318,8 +319,8 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 	{
 		try
 		{
-			/* start the block */
-			block = drcuml->begin_block(4096);
+			/* start the block; superblocks describe a wider window, so leave room for it */
+			block = drcuml->begin_block(4096 * window_scale);
 
 			/* loop until we get through all instruction sequences */
 			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
@@ -362,6 +363,10 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
 					generate_checksum_block(block, &compiler, seqhead, seqlast);
 
+				/* count entries into the block so we can tell when it gets hot */
+				if (seqhead == desclist)
+					m_drctrace->generate_block_entry(block, mode, seqhead->pc, *m_nocode, epc(seqhead));
+
 				/* label this instruction, if it may be jumped to locally */
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
@@ -1333,8 +1338,8 @@ void mips3_device::generate_delay_slot_and_branch(drcuml_block *block, compiler_
 	{
 		generate_update_cycles(block, &compiler_temp, mem(&m_core->jmpdest), TRUE);
 																					// <subtract cycles>
-		UML_HASHJMP(block, m_core->mode, mem(&m_core->jmpdest), *m_nocode);
-																					// hashjmp <mode>,<rsreg>,nocode
+		m_drctrace->generate_dynamic_exit(block, m_core->mode, desc->pc, mem(&m_core->jmpdest), *m_nocode, compiler_temp.labelnum++);
+																					// <hashjmp <mode>,<rsreg>,nocode>
 	}
 
 	/* update the label */
@@ -16,6 +16,7 @@
 
 #include "divtlb.h"
 #include "cpu/drcfe.h"
+#include "cpu/drctrace.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
@@ -536,6 +537,7 @@ protected:
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
 	std::unique_ptr<ppc_frontend>      m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<drc_trace_profile> m_drctrace;                   /* DRC block and exit profile */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* parameters for subroutines */
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "ppccom.h"
 #include "ppcfe.h"
 
@@ -220,6 +221,7 @@ ppc_device::ppc_device(const machine_config &mconfig, device_type type, const ch
 	, m_cache(CACHE_SIZE + sizeof(internal_ppc_state))
 	, m_drcuml(nullptr)
 	, m_drcfe(nullptr)
+	, m_drctrace(nullptr)
 	, m_drcoptions(0)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -931,6 +933,7 @@ void ppc_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<ppc_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	m_drctrace = std::make_unique<drc_trace_profile>(*this, m_cache, machine().options().drc_traces() && !SINGLE_INSTRUCTION_MODE);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
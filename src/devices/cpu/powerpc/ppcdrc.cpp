@@ -388,8 +388,9 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
-	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	/* get a description of this sequence; hot blocks are described as superblocks */
+	UINT32 window_scale = m_drctrace->superblock(mode, pc) ? DRC_TRACE_SUPERBLOCK_SCALE : 1;
+	desclist = m_drcfe->describe_code(pc, window_scale, mode);
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(m_drcuml.get(), desclist, 0);
 
@@ -398,8 +399,8 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 	{
 		try
 		{
-			/* start the block */
-			block = m_drcuml->begin_block(4096);
+			/* start the block; superblocks describe a wider window, so leave room for it */
+			block = m_drcuml->begin_block(4096 * window_scale);
 
 			/* loop until we get through all instruction sequences */
 			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
@@ -442,6 +443,10 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
 					generate_checksum_block(block, &compiler, seqhead, seqlast);               // <checksum>
 
+				/* count entries into the block so we can tell when it gets hot */
+				if (seqhead == desclist)
+					m_drctrace->generate_block_entry(block, mode, seqhead->pc, *m_nocode, seqhead->pc);
+
 				/* label this instruction, if it may be jumped to locally */
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                                     // label   seqhead->pc | 0x80000000
@@ -1925,7 +1930,8 @@ void ppc_device::generate_branch(drcuml_block *block, compiler_state *compiler,
 	else
 	{
 		generate_update_cycles(block, &compiler_temp, mem(srcptr), TRUE);              // <subtract cycles>
-		UML_HASHJMP(block, m_core->mode, mem(srcptr), *m_nocode);   // hashjmp <mode>,<rsreg>,nocode
+		m_drctrace->generate_dynamic_exit(block, m_core->mode, desc->pc, mem(srcptr), *m_nocode, compiler_temp.labelnum++);
+																							// <hashjmp <mode>,<rsreg>,nocode>
 	}
 
 	/* update the label */
@@ -534,13 +534,18 @@ public:
 	sh2_frontend(sh2_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
 
 protected:
+	// for derived front ends (SH-4) that share the SH-2 decoding
+	sh2_frontend(device_t &device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
 	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+	virtual UINT16 read_opcode(const opcode_desc &desc);
+	virtual bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	virtual bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
+	virtual bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 
 private:
-	bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 	bool describe_group_2(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 	bool describe_group_3(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
-	bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 	bool describe_group_6(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 	bool describe_group_8(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
 	bool describe_group_12(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode);
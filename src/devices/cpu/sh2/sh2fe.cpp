@@ -24,6 +24,22 @@ sh2_frontend::sh2_frontend(sh2_device *device, UINT32 window_start, UINT32 windo
 {
 }
 
+sh2_frontend::sh2_frontend(device_t &device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(device, window_start, window_end, max_sequence)
+	, m_sh2(nullptr)
+{
+}
+
+/*-------------------------------------------------
+    read_opcode - fetch the opcode described by
+    desc
+-------------------------------------------------*/
+
+UINT16 sh2_frontend::read_opcode(const opcode_desc &desc)
+{
+	return m_sh2->m_direct->read_word(desc.physpc, SH2_CODE_XOR(0));
+}
+
 /*-------------------------------------------------
     describe_instruction - build a description
     of a single instruction
@@ -34,7 +50,7 @@ bool sh2_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 	UINT16 opcode;
 
 	/* fetch the opcode */
-	opcode = desc.opptr.w[0] = m_sh2->m_direct->read_word(desc.physpc, SH2_CODE_XOR(0));
+	opcode = desc.opptr.w[0] = read_opcode(desc);
 
 	/* all instructions are 2 bytes and most are a single cycle */
 	desc.length = 2;
@@ -107,8 +123,8 @@ bool sh2_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
 			desc.regout[0] |= REGFLAG_R(Rn);
 			return true;
 
-		case 15:    // NOP
-			return true;
+		case 15:
+			return describe_group_15(desc, prev, opcode);
 	}
 
 	return false;
@@ -760,3 +776,9 @@ bool sh2_frontend::describe_group_12(opcode_desc &desc, const opcode_desc *prev,
 
 	return false;
 }
+
+bool sh2_frontend::describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	// NOP on the SH-2
+	return true;
+}
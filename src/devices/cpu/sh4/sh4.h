@@ -13,6 +13,9 @@
 #ifndef __SH4_H__
 #define __SH4_H__
 
+#include "cpu/sh2/sh2.h"
+#include "cpu/drcumlsh.h"
+
 // doesn't actually seem to improve performance at all
 #define SH4_USE_FASTRAM_OPTIMIZATION 0
 #define SH4_MAX_FASTRAM       3
@@ -170,8 +173,12 @@ typedef void (*sh4_ftcsr_callback)(UINT32);
 	sh34_base_device::set_sh4_clock(*device, _clock);
 
 
+class sh4_frontend;
+
 class sh34_base_device : public cpu_device
 {
+	friend class sh4_frontend;
+
 public:
 	// construction/destruction
 	sh34_base_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, endianness_t endianness, address_map_constructor internal);
@@ -202,6 +209,9 @@ public:
 	int sh4_dma_data(struct sh4_device_dma *s);
 	void sh4_dma_ddt(struct sh4_ddt_dma *s);
 
+	void sh4drc_set_options(UINT32 options);
+	void sh4drc_add_pcflush(offs_t address);
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -216,6 +226,7 @@ protected:
 
 	// device_memory_interface overrides
 	virtual const address_space_config *memory_space_config(address_spacenum spacenum = AS_0) const override { return (spacenum == AS_PROGRAM) ? &m_program_config : ((spacenum == AS_IO) ? &m_io_config : nullptr); }
+	virtual bool memory_translate(address_spacenum spacenum, int intention, offs_t &address) override;
 
 	// device_state_interface overrides
 	virtual void state_import(const device_state_entry &entry) override;
@@ -242,29 +253,42 @@ protected:
 	int c_md8;
 	int c_clock;
 
-	UINT32  m_ppc;
-	UINT32  m_pc;
-	UINT32  m_spc;
-	UINT32  m_pr;
-	UINT32  m_sr;
-	UINT32  m_ssr;
-	UINT32  m_gbr;
-	UINT32  m_vbr;
-	UINT32  m_mach;
-	UINT32  m_macl;
-	UINT32  m_r[16];
+	// Data that needs to be stored close to the generated DRC code
+	struct internal_sh4_state
+	{
+		UINT32  fr[16];
+		UINT32  xf[16];
+		UINT64  fzero;              // 0.0 for FTRV sums in the DRC
+		UINT32  ppc;
+		UINT32  pc;
+		UINT32  spc;
+		UINT32  pr;
+		UINT32  sr;
+		UINT32  ssr;
+		UINT32  gbr;
+		UINT32  vbr;
+		UINT32  mach;
+		UINT32  macl;
+		UINT32  r[16];
+		UINT32  sgr;
+		UINT32  ea;
+		UINT32  delay;
+		UINT32  test_irq;
+		UINT32  fpscr;
+		UINT32  fpul;
+		UINT32  dbr;
+		int     icount;
+		int     fpu_sz;
+		int     fpu_pr;
+		UINT32  target;             // target for jmp/jsr/etc so the delay slot can't kill it
+		UINT32  arg0;               // opcode for interpreted instructions in the DRC
+	};
+
+	internal_sh4_state *m_sh4_state;
+
 	UINT32  m_rbnk[2][8];
-	UINT32  m_sgr;
-	UINT32  m_fr[16];
-	UINT32  m_xf[16];
-	UINT32  m_ea;
-	UINT32  m_delay;
 	UINT32  m_cpu_off;
 	UINT32  m_pending_irq;
-	UINT32  m_test_irq;
-	UINT32  m_fpscr;
-	UINT32  m_fpul;
-	UINT32  m_dbr;
 
 	UINT32  m_exception_priority[128];
 	int     m_exception_requesting[128];
@@ -343,13 +367,10 @@ protected:
 	int     m_dma_destination_increment[4];
 	int     m_dma_mode[4];
 
-	int     m_sh4_icount;
 	int     m_is_slave;
 	int     m_cpu_clock;
 	int     m_bus_clock;
 	int     m_pm_clock;
-	int     m_fpu_sz;
-	int     m_fpu_pr;
 	int     m_ioport16_pullup;
 	int     m_ioport16_direction;
 	int     m_ioport4_pullup;
@@ -707,6 +728,94 @@ protected:
 		void *              base;                       /* base in memory where the RAM lives */
 	}       m_fastram[SH4_MAX_FASTRAM];
 #endif
+
+	bool m_isdrc;
+
+	int m_pcfsel;                 // last pcflush entry set
+	int m_maxpcfsel;              // highest valid pcflush entry
+	UINT32 m_pcflushes[16];           // pcflush entries
+
+	drc_cache           m_cache;                  /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
+	std::unique_ptr<sh4_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
+	UINT32              m_drcoptions;         /* configurable DRC options */
+
+	/* internal stuff */
+	UINT8               m_cache_dirty;                /* true if we need to flush the cache */
+	bool                m_drc_validated;              /* true once -drc_validate has run */
+	UINT32              m_code_xor;                   /* XOR applied to opcode fetches */
+	UINT32              m_sq_byte_xor;                /* XORs applied to store queue accesses */
+	UINT32              m_sq_word_xor;
+	UINT32              m_sq_dword_xor;
+	void *              m_sq_base;                    /* base of the store queue RAM, or nullptr */
+
+	/* register mappings */
+	uml::parameter      m_regmap[16];                 /* parameter to register mappings for all 16 integer registers */
+
+	uml::code_handle *  m_entry;                      /* entry point */
+	uml::code_handle *  m_read8;                  /* read byte */
+	uml::code_handle *  m_write8;                 /* write byte */
+	uml::code_handle *  m_read16;                 /* read half */
+	uml::code_handle *  m_write16;                    /* write half */
+	uml::code_handle *  m_read32;                 /* read word */
+	uml::code_handle *  m_write32;                    /* write word */
+
+	uml::code_handle *  m_interrupt;              /* interrupt */
+	uml::code_handle *  m_nocode;                 /* nocode */
+	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32          cycles;                     /* accumulated cycles */
+		UINT8           mode;                       /* FPU mode (PR | SZ << 1) the code was compiled for */
+		uml::code_label  labelnum;                   /* index for local labels */
+	};
+
+	inline UINT32 epc(const opcode_desc *desc);
+	inline void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	inline void load_fast_iregs(drcuml_block *block);
+	inline void save_fast_iregs(drcuml_block *block);
+
+	void code_flush_cache();
+	void execute_run_drc();
+	void code_compile_block(UINT8 mode, offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_interrupt_handler();
+	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
+	const char *log_desc_flags_to_string(UINT32 flags);
+	void log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist);
+	void log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op);
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	void generate_hashjmp(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter pc);
+	void generate_pcrel_base(drcuml_block *block, const opcode_desc *desc, UINT32 ovrpc, UINT32 offset);
+	void generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	void generate_interpret_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode);
+	int generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc);
+	int generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc);
+	int generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	int generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc);
+	void fmov_transfer_regs(UINT8 mode, UINT16 opcode, int reg, UINT32 **first, UINT32 **second);
+
+	void validate_drc();
+	void validate_setup(int kind, UINT8 mode, UINT32 &seed);
+	int validate_one(UINT16 opcode, UINT16 slotop, UINT8 mode, UINT8 *scratch, UINT32 &seed, std::string *errors);
+
+public:
+	void func_printf_probe();
+	void func_interpret();
+	void func_check_irq();
 };
 
 
@@ -797,7 +906,26 @@ extern const device_type SH4BE;
 #define SH4DRC_COMPATIBLE_OPTIONS   (SH4DRC_STRICT_VERIFY | SH4DRC_FLUSH_PC | SH4DRC_STRICT_PCREL)
 #define SH4DRC_FASTEST_OPTIONS  (0)
 
-void sh4drc_set_options(device_t *device, UINT32 options);
-void sh4drc_add_pcflush(device_t *device, offs_t address);
+
+class sh4_frontend : public sh2_frontend
+{
+public:
+	sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	// describe an opcode that isn't in memory, for -drc_validate
+	bool describe_test(opcode_desc &desc, offs_t pc, UINT16 opcode);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+	virtual UINT16 read_opcode(const opcode_desc &desc) override;
+	virtual bool describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode) override;
+	virtual bool describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode) override;
+	virtual bool describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode) override;
+
+private:
+	sh34_base_device *m_sh4;
+	bool m_testing;
+	UINT16 m_test_opcode;
+};
 
 #endif /* __SH4_H__ */
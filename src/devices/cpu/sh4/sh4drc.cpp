@@ -0,0 +1,3369 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4drc.c
+    Universal machine language-based SH-4 emulator.
+
+    The integer instruction set is described by the SH-2 front-end;
+    blocks are hashed by FPU mode (FPSCR.PR | FPSCR.SZ << 1) so the
+    FPU opcodes can be compiled for a single register layout.  Anything
+    not generated natively is handed to the interpreter one opcode at a
+    time.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "debugger.h"
+#include "sh4.h"
+#include "sh4comn.h"
+
+extern unsigned DasmSH4(char *buffer, unsigned pc, UINT16 opcode);
+
+using namespace uml;
+
+/***************************************************************************
+    DEBUGGING
+***************************************************************************/
+
+#define SET_EA                      (0) // makes slower but "shows work" in the EA fake register like the interpreter
+
+#if SET_EA
+#define SETEA(x) UML_MOV(block, mem(&m_sh4_state->ea), ireg(x))
+#else
+#define SETEA(x)
+#endif
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* map variables */
+#define MAPVAR_PC                   M0
+#define MAPVAR_CYCLES                   M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_UNMAPPED_CODE           2
+#define EXECUTE_RESET_CACHE         3
+
+#define PROBE_ADDRESS                   ~0
+
+/* FPU modes blocks are compiled for */
+#define MODE_PR                     0x01
+#define MODE_SZ                     0x02
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)        m_regmap[reg]
+#define FR32(reg)       mem(&m_sh4_state->fr[reg])
+#define XF32(reg)       mem(&m_sh4_state->xf[reg])
+#define FR64(reg)       mem(&m_sh4_state->fr[(reg) & 14])
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    epc - compute the exception PC from a
+    descriptor
+-------------------------------------------------*/
+
+UINT32 sh34_base_device::epc(const opcode_desc *desc)
+{
+	return (desc->flags & OPFLAG_IN_DELAY_SLOT) ? (desc->pc - 1) : desc->pc;
+}
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void sh34_base_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+/*-------------------------------------------------
+    load_fast_iregs - load any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::load_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, uml::parameter::make_ireg(m_regmap[regnum].ireg()), mem(&m_sh4_state->r[regnum]));
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    save_fast_iregs - save any fast integer
+    registers
+-------------------------------------------------*/
+
+void sh34_base_device::save_fast_iregs(drcuml_block *block)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+	{
+		if (m_regmap[regnum].is_int_register())
+		{
+			UML_MOV(block, mem(&m_sh4_state->r[regnum]), uml::parameter::make_ireg(m_regmap[regnum].ireg()));
+		}
+	}
+}
+
+/*-------------------------------------------------
+    cfunc_printf_probe - print the current CPU
+    state and return
+-------------------------------------------------*/
+
+static void cfunc_printf_probe(void *param)
+{
+	((sh34_base_device *)param)->func_printf_probe();
+}
+
+void sh34_base_device::func_printf_probe()
+{
+	UINT32 pc = m_sh4_state->pc;
+
+	printf(" PC=%08X          r0=%08X  r1=%08X  r2=%08X\n",
+		pc,
+		(UINT32)m_sh4_state->r[0],
+		(UINT32)m_sh4_state->r[1],
+		(UINT32)m_sh4_state->r[2]);
+	printf(" r3=%08X  r4=%08X  r5=%08X  r6=%08X\n",
+		(UINT32)m_sh4_state->r[3],
+		(UINT32)m_sh4_state->r[4],
+		(UINT32)m_sh4_state->r[5],
+		(UINT32)m_sh4_state->r[6]);
+	printf(" r7=%08X  r8=%08X  r9=%08X  r10=%08X\n",
+		(UINT32)m_sh4_state->r[7],
+		(UINT32)m_sh4_state->r[8],
+		(UINT32)m_sh4_state->r[9],
+		(UINT32)m_sh4_state->r[10]);
+	printf(" r11=%08X  r12=%08X  r13=%08X  r14=%08X\n",
+		(UINT32)m_sh4_state->r[11],
+		(UINT32)m_sh4_state->r[12],
+		(UINT32)m_sh4_state->r[13],
+		(UINT32)m_sh4_state->r[14]);
+	printf(" r15=%08X  macl=%08X  mach=%08X  gbr=%08X\n",
+		(UINT32)m_sh4_state->r[15],
+		(UINT32)m_sh4_state->macl,
+		(UINT32)m_sh4_state->mach,
+		(UINT32)m_sh4_state->gbr);
+	printf(" sr=%08X  pr=%08X  fpscr=%08X  fpul=%08X\n",
+		(UINT32)m_sh4_state->sr,
+		(UINT32)m_sh4_state->pr,
+		(UINT32)m_sh4_state->fpscr,
+		(UINT32)m_sh4_state->fpul);
+}
+
+/*-------------------------------------------------
+    cfunc_interpret - run one opcode through the
+    interpreter
+-------------------------------------------------*/
+
+static void cfunc_interpret(void *param)
+{
+	((sh34_base_device *)param)->func_interpret();
+}
+
+void sh34_base_device::func_interpret()
+{
+	m_sh4_state->ppc = m_sh4_state->pc;
+	execute_one(m_sh4_state->arg0);
+}
+
+/*-------------------------------------------------
+    cfunc_check_irq - take a pending interrupt
+    the same way the interpreter does
+-------------------------------------------------*/
+
+static void cfunc_check_irq(void *param)
+{
+	((sh34_base_device *)param)->func_check_irq();
+}
+
+void sh34_base_device::func_check_irq()
+{
+	if (m_sh4_state->test_irq && !m_sh4_state->delay)
+		sh4_check_pending_irq("sh4drc");
+}
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void sh34_base_device::code_flush_cache()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+
+	/* empty the transient cache contents */
+	drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_interrupt_handler();
+		static_generate_entry_point();
+
+		/* add subroutines for memory accesses */
+		static_generate_memory_accessor(1, FALSE, "read8", &m_read8);
+		static_generate_memory_accessor(1, TRUE,  "write8", &m_write8);
+		static_generate_memory_accessor(2, FALSE, "read16", &m_read16);
+		static_generate_memory_accessor(2, TRUE,  "write16", &m_write16);
+		static_generate_memory_accessor(4, FALSE, "read32", &m_read32);
+		static_generate_memory_accessor(4, TRUE,  "write32", &m_write32);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate SH4 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+/* Execute cycles - returns number of cycles actually run */
+void sh34_base_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	int execute_result;
+
+	if (m_cpu_off)
+	{
+		m_sh4_state->icount = 0;
+		return;
+	}
+
+	/* reset the cache if dirty */
+	if (m_cache_dirty)
+	{
+		code_flush_cache();
+
+		/* compare the recompiler against the interpreter once, if asked to */
+		if (machine().options().drc_validate() && !m_drc_validated)
+			validate_drc();
+	}
+
+	/* execute */
+	do
+	{
+		/* run as much as we can */
+		execute_result = drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			code_compile_block(m_sh4_state->fpu_pr | (m_sh4_state->fpu_sz << 1), m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+		{
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_sh4_state->pc);
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+		{
+			code_flush_cache();
+		}
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void sh34_base_device::code_compile_block(UINT8 mode, offs_t pc)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc, 1, mode);
+	if (drcuml->logging() || drcuml->logging_native())
+		log_opcode_desc(drcuml, desclist, 0);
+
+	/* the FPU opcodes are generated for this mode only */
+	compiler.mode = mode;
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(4096);
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, &compiler, curdesc, 0xffffffff);
+				}
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+				{
+					nextpc = pc;
+				}
+				/* otherwise we just go to the next instruction */
+				else
+				{
+					nextpc = seqlast->pc + (seqlast->skipslots + 1) * 2;
+				}
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                // <subtract cycles>
+
+				/* a mode change has to look up the new mode; otherwise fall through if we can */
+				if (seqlast->flags & OPFLAG_CAN_CHANGE_MODES)
+					generate_hashjmp(block, &compiler, nullptr, nextpc);                    // hashjmp <newmode>,nextpc,nocode
+				else if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	code_label skip = 1;
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(200);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                         // handle  entry
+
+	/* take any interrupt that became pending while we were out */
+	UML_CMP(block, mem(&m_sh4_state->test_irq), 0);             // cmp     test_irq,0
+	UML_JMPc(block, COND_Z, skip);                              // jz      skip
+	UML_CALLC(block, cfunc_check_irq, this);                     // callc   cfunc_check_irq
+	UML_LABEL(block, skip);                                     // skip:
+
+	/* load fast integer registers */
+	load_fast_iregs(block);
+
+	/* generate a hash jump via the current mode and PC */
+	generate_hashjmp(block, nullptr, nullptr, mem(&m_sh4_state->pc));  // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                    // handle  nocode
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                          // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                             // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     <pc>,i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    static_generate_interrupt_handler - generate
+    an exception handler that takes a pending
+    interrupt at an instruction boundary
+-------------------------------------------------*/
+
+void sh34_base_device::static_generate_interrupt_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(100);
+
+	/* the exception parameter is the PC of the next instruction */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	alloc_handle(drcuml, &m_interrupt, "interrupt");
+	UML_HANDLE(block, *m_interrupt);                                 // handle  interrupt
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh4_state->pc), I0);                              // mov     <pc>,i0
+	save_fast_iregs(block);
+	UML_CALLC(block, cfunc_check_irq, this);                         // callc   cfunc_check_irq
+	load_fast_iregs(block);
+
+	/* the interrupt may have switched banks and PC; look the code up again */
+	generate_hashjmp(block, nullptr, nullptr, mem(&m_sh4_state->pc));  // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor
+------------------------------------------------------------------*/
+
+void sh34_base_device::static_generate_memory_accessor(int size, int iswrite, const char *name, code_handle **handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0 and I1 */
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+	int label = 1;
+
+	/* begin generating */
+	block = drcuml->begin_block(1024);
+
+	/* add a global entry for this */
+	alloc_handle(drcuml, handleptr, name);
+	UML_HANDLE(block, **handleptr);                         // handle  *handleptr
+
+	// addresses in the P4 area go out unmasked, like RB/WB and friends
+	UML_CMP(block, I0, 0xe0000000);                         // cmp     i0,0xe0000000
+	UML_JMPc(block, COND_AE, label);                        // jae     label
+	UML_AND(block, I0, I0, AM);                             // and     i0,i0,AM
+	UML_JMP(block, label + 1);                              // jmp     label+1
+
+	UML_LABEL(block, label++);                              // label:
+
+	// store queue writes are plain RAM; skip the memory system for them
+	if (iswrite && m_sq_base != nullptr)
+	{
+		UML_CMP(block, I0, 0xe4000000);                     // cmp     i0,0xe4000000
+		UML_JMPc(block, COND_AE, label);                    // jae     label+1
+		UML_AND(block, I0, I0, 0x3f);                       // and     i0,i0,0x3f
+		switch (size)
+		{
+			case 1:
+				UML_XOR(block, I0, I0, m_sq_byte_xor);      // xor     i0,i0,sq_byte_xor
+				UML_STORE(block, m_sq_base, I0, I1, SIZE_BYTE, SCALE_x1);   // store   sq,i0,i1,byte
+				break;
+
+			case 2:
+				UML_XOR(block, I0, I0, m_sq_word_xor);      // xor     i0,i0,sq_word_xor
+				UML_STORE(block, m_sq_base, I0, I1, SIZE_WORD, SCALE_x1);   // store   sq,i0,i1,word_x1
+				break;
+
+			case 4:
+				UML_XOR(block, I0, I0, m_sq_dword_xor);     // xor     i0,i0,sq_dword_xor
+				UML_STORE(block, m_sq_base, I0, I1, SIZE_DWORD, SCALE_x1);  // store   sq,i0,i1,dword_x1
+				break;
+		}
+		UML_RET(block);                                     // ret
+	}
+
+	UML_LABEL(block, label++);                              // label+1:
+
+	if (iswrite)
+	{
+		switch (size)
+		{
+			case 1:
+				UML_WRITE(block, I0, I1, SIZE_BYTE, SPACE_PROGRAM); // write r0, r1, program_byte
+				break;
+
+			case 2:
+				UML_WRITE(block, I0, I1, SIZE_WORD, SPACE_PROGRAM); // write r0, r1, program_word
+				break;
+
+			case 4:
+				UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);    // write r0, r1, program_dword
+				break;
+		}
+	}
+	else
+	{
+		switch (size)
+		{
+			case 1:
+				UML_READ(block, I0, I0, SIZE_BYTE, SPACE_PROGRAM);  // read r0, program_byte
+				break;
+
+			case 2:
+				UML_READ(block, I0, I0, SIZE_WORD, SPACE_PROGRAM);  // read r0, program_word
+				break;
+
+			case 4:
+				UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM); // read r0, program_dword
+				break;
+		}
+	}
+
+	UML_RET(block);                         // ret
+
+	block->end();
+}
+
+/*-------------------------------------------------
+    log_desc_flags_to_string - generate a string
+    representing the instruction description
+    flags
+-------------------------------------------------*/
+
+const char *sh34_base_device::log_desc_flags_to_string(UINT32 flags)
+{
+	static char tempbuf[30];
+	char *dest = tempbuf;
+
+	/* branches */
+	if (flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+		*dest++ = 'U';
+	else if (flags & OPFLAG_IS_CONDITIONAL_BRANCH)
+		*dest++ = 'C';
+	else
+		*dest++ = '.';
+
+	/* intrablock branches */
+	*dest++ = (flags & OPFLAG_INTRABLOCK_BRANCH) ? 'i' : '.';
+
+	/* branch targets */
+	*dest++ = (flags & OPFLAG_IS_BRANCH_TARGET) ? 'B' : '.';
+
+	/* delay slots */
+	*dest++ = (flags & OPFLAG_IN_DELAY_SLOT) ? 'D' : '.';
+
+	/* exceptions */
+	if (flags & OPFLAG_WILL_CAUSE_EXCEPTION)
+		*dest++ = 'E';
+	else if (flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+		*dest++ = 'e';
+	else
+		*dest++ = '.';
+
+	/* read/write */
+	if (flags & OPFLAG_READS_MEMORY)
+		*dest++ = 'R';
+	else if (flags & OPFLAG_WRITES_MEMORY)
+		*dest++ = 'W';
+	else
+		*dest++ = '.';
+
+	/* TLB validation */
+	*dest++ = (flags & OPFLAG_VALIDATE_TLB) ? 'V' : '.';
+
+	/* TLB modification */
+	*dest++ = (flags & OPFLAG_MODIFIES_TRANSLATION) ? 'T' : '.';
+
+	/* redispatch */
+	*dest++ = (flags & OPFLAG_REDISPATCH) ? 'R' : '.';
+	return tempbuf;
+}
+
+
+/*-------------------------------------------------
+    log_register_list - log a list of GPR registers
+-------------------------------------------------*/
+
+void sh34_base_device::log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist)
+{
+	int count = 0;
+	int regnum;
+
+	/* skip if nothing */
+	if (reglist[0] == 0 && reglist[1] == 0 && reglist[2] == 0)
+		return;
+
+	drcuml->log_printf("[%s:", string);
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		if (reglist[0] & REGFLAG_R(regnum))
+		{
+			drcuml->log_printf("%sr%d", (count++ == 0) ? "" : ",", regnum);
+			if (regnostarlist != nullptr && !(regnostarlist[0] & REGFLAG_R(regnum)))
+				drcuml->log_printf("*");
+		}
+	}
+
+	if (reglist[1] & REGFLAG_PR)
+	{
+		drcuml->log_printf("%spr", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_PR))
+			drcuml->log_printf("*");
+	}
+
+	if (reglist[1] & REGFLAG_SR)
+	{
+		drcuml->log_printf("%ssr", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_SR))
+			drcuml->log_printf("*");
+	}
+
+	if (reglist[1] & REGFLAG_MACL)
+	{
+		drcuml->log_printf("%smacl", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_MACL))
+			drcuml->log_printf("*");
+	}
+
+	if (reglist[1] & REGFLAG_MACH)
+	{
+		drcuml->log_printf("%smach", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_MACH))
+			drcuml->log_printf("*");
+	}
+
+	if (reglist[1] & REGFLAG_GBR)
+	{
+		drcuml->log_printf("%sgbr", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_GBR))
+			drcuml->log_printf("*");
+	}
+
+	if (reglist[1] & REGFLAG_VBR)
+	{
+		drcuml->log_printf("%svbr", (count++ == 0) ? "" : ",");
+		if (regnostarlist != nullptr && !(regnostarlist[1] & REGFLAG_VBR))
+			drcuml->log_printf("*");
+	}
+
+	drcuml->log_printf("] ");
+}
+
+/*-------------------------------------------------
+    log_opcode_desc - log a list of descriptions
+-------------------------------------------------*/
+
+void sh34_base_device::log_opcode_desc(drcuml_state *drcuml, const opcode_desc *desclist, int indent)
+{
+	/* open the file, creating it if necessary */
+	if (indent == 0)
+		drcuml->log_printf("\nDescriptor list @ %08X\n", desclist->pc);
+
+	/* output each descriptor */
+	for ( ; desclist != nullptr; desclist = desclist->next())
+	{
+		char buffer[100];
+
+		/* disassemle the current instruction and output it to the log */
+		if (drcuml->logging() || drcuml->logging_native())
+		{
+			if (desclist->flags & OPFLAG_VIRTUAL_NOOP)
+				strcpy(buffer, "<virtual nop>");
+			else
+				DasmSH4(buffer, desclist->pc, desclist->opptr.w[0]);
+		}
+		else
+			strcpy(buffer, "???");
+		drcuml->log_printf("%08X [%08X] t:%08X f:%s: %-30s", desclist->pc, desclist->physpc, desclist->targetpc, log_desc_flags_to_string(desclist->flags), buffer);
+
+		/* output register states */
+		log_register_list(drcuml, "use", desclist->regin, nullptr);
+		log_register_list(drcuml, "mod", desclist->regout, desclist->regreq);
+		drcuml->log_printf("\n");
+
+		/* if we have a delay slot, output it recursively */
+		if (desclist->delay.first() != nullptr)
+			log_opcode_desc(drcuml, desclist->delay.first(), indent + 1);
+
+		/* at the end of a sequence add a dividing line */
+		if (desclist->flags & OPFLAG_END_SEQUENCE)
+			drcuml->log_printf("-----\n");
+	}
+}
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an SH4 instruction
+-------------------------------------------------*/
+
+void sh34_base_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, UINT32 op)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+		DasmSH4(buffer, pc, op);
+		block->append_comment("%08X: %s", pc, buffer);                  // comment
+	}
+}
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out, or if an interrupt is
+    waiting to be taken
+-------------------------------------------------*/
+void sh34_base_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_sh4_state->icount), mem(&m_sh4_state->icount), MAPVAR_CYCLES);    // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+		{
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);                   // exh     out_of_cycles,nextpc
+			UML_CMP(block, mem(&m_sh4_state->test_irq), 0);                     // cmp     test_irq,0
+			UML_EXHc(block, COND_NE, *m_interrupt, param);                      // exhne   interrupt,nextpc
+		}
+	}
+	compiler->cycles = 0;
+}
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void sh34_base_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* loose verify or single instruction: just compare and fail */
+	if (!(m_drcoptions & SH4DRC_STRICT_VERIFY) || seqhead->next() == nullptr)
+	{
+		if (!(seqhead->flags & OPFLAG_VIRTUAL_NOOP))
+		{
+			void *base = m_direct->read_ptr(seqhead->physpc, m_code_xor);
+			UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                          // load    i0,base,word
+			UML_CMP(block, I0, seqhead->opptr.w[0]);                        // cmp     i0,*opptr
+			UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));       // exne    nocode,seqhead->pc
+		}
+	}
+
+	/* full verification; sum up everything */
+	else
+	{
+		UINT32 sum = 0;
+		void *base = m_direct->read_ptr(seqhead->physpc, m_code_xor);
+		UML_LOAD(block, I0, base, 0, SIZE_WORD, SCALE_x2);                              // load    i0,base,word
+		sum += seqhead->opptr.w[0];
+		for (curdesc = seqhead->next(); curdesc != seqlast->next(); curdesc = curdesc->next())
+			if (!(curdesc->flags & OPFLAG_VIRTUAL_NOOP))
+			{
+				base = m_direct->read_ptr(curdesc->physpc, m_code_xor);
+				UML_LOAD(block, I1, base, 0, SIZE_WORD, SCALE_x2);                      // load    i1,*opptr,word
+				UML_ADD(block, I0, I0, I1);                         // add     i0,i0,i1
+				sum += curdesc->opptr.w[0];
+			}
+		UML_CMP(block, I0, sum);                                            // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, epc(seqhead));           // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void sh34_base_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	offs_t expc;
+
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.w[0]);
+
+	/* set the PC map variable */
+	expc = (desc->flags & OPFLAG_IN_DELAY_SLOT) ? desc->pc - 1 : desc->pc;
+	UML_MAPVAR(block, MAPVAR_PC, expc);                                             // mapvar  PC,expc
+
+	/* accumulate total cycles */
+	compiler->cycles += desc->cycles;
+
+	/* update the icount map variable */
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                             // mapvar  CYCLES,compiler->cycles
+
+	/* if we want a probe, add it here */
+	if (desc->pc == PROBE_ADDRESS)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		UML_CALLC(block, cfunc_printf_probe, this);                                  // callc   cfunc_printf_probe,sh4
+	}
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_DEBUG(block, desc->pc);                                         // debug   desc->pc
+	}
+	else    // not debug, see what other reasons there are for flushing the PC
+	{
+		if (m_drcoptions & SH4DRC_FLUSH_PC)  // always flush?
+		{
+			UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+		}
+		else    // check for driver-selected flushes
+		{
+			int pcflush;
+
+			for (pcflush = 0; pcflush < m_pcfsel; pcflush++)
+			{
+				if (desc->pc == m_pcflushes[pcflush])
+				{
+					UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);        // mov m_sh4_state->pc, desc->pc
+				}
+			}
+		}
+	}
+
+
+	/* if we hit an unmapped address, fatal error */
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc);                                // mov     [pc],desc->pc
+		save_fast_iregs(block);
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                             // exit    EXECUTE_UNMAPPED_CODE
+	}
+
+	/* if this is an invalid opcode, die */
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		fatalerror("SH4DRC: invalid opcode!\n");
+	}
+
+	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
+	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		/* compile the instruction; anything not handled natively goes to the interpreter */
+		if (!generate_opcode(block, compiler, desc, ovrpc))
+			generate_interpret(block, compiler, desc, desc->opptr.w[0], (desc->flags & OPFLAG_IN_DELAY_SLOT) != 0, ovrpc);
+	}
+}
+
+/*------------------------------------------------------------------
+    generate_delay_slot
+------------------------------------------------------------------*/
+
+void sh34_base_device::generate_delay_slot(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	compiler_state compiler_temp = *compiler;
+
+	/* compile the delay slot using temporary compiler state */
+	assert(desc->delay.first() != nullptr);
+	generate_sequence_instruction(block, &compiler_temp, desc->delay.first(), ovrpc);              // <next instruction>
+
+	/* the slot's cycles are counted with the branch; update the label */
+	compiler->cycles = compiler_temp.cycles;
+	compiler->labelnum = compiler_temp.labelnum;
+}
+
+/*-------------------------------------------------
+    generate_hashjmp - jump to the code for a PC,
+    looking the FPU mode up at runtime if this
+    branch may have changed it
+-------------------------------------------------*/
+
+void sh34_base_device::generate_hashjmp(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, uml::parameter pc)
+{
+	const opcode_desc *slot = (desc != nullptr) ? desc->delay.first() : nullptr;
+
+	if (desc != nullptr && !(desc->flags & OPFLAG_CAN_CHANGE_MODES) && (slot == nullptr || !(slot->flags & OPFLAG_CAN_CHANGE_MODES)))
+	{
+		UML_HASHJMP(block, compiler->mode, pc, *m_nocode);                         // hashjmp <mode>,pc,nocode
+	}
+	else
+	{
+		UML_SHL(block, I1, mem(&m_sh4_state->fpu_sz), 1);                         // shl     i1,fpu_sz,1
+		UML_OR(block, I1, I1, mem(&m_sh4_state->fpu_pr));                          // or      i1,i1,fpu_pr
+		UML_HASHJMP(block, I1, pc, *m_nocode);                                      // hashjmp i1,pc,nocode
+	}
+}
+
+/*-------------------------------------------------
+    generate_pcrel_base - load I0 with the PC an
+    opcode sees plus an offset
+-------------------------------------------------*/
+
+void sh34_base_device::generate_pcrel_base(drcuml_block *block, const opcode_desc *desc, UINT32 ovrpc, UINT32 offset)
+{
+	/* in the delay slot of a computed branch, the PC is already the branch target */
+	if ((desc->flags & OPFLAG_IN_DELAY_SLOT) && ovrpc == 0xffffffff)
+		UML_ADD(block, I0, mem(&m_sh4_state->target), offset);                    // add     i0,target,offset
+	else
+		UML_MOV(block, I0, ((ovrpc == 0xffffffff) ? desc->pc : ovrpc) + 2 + offset);  // mov     i0,pc+2+offset
+}
+
+/*-------------------------------------------------
+    generate_interpret - call the interpreter for
+    an opcode the recompiler doesn't handle
+-------------------------------------------------*/
+
+void sh34_base_device::generate_interpret(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	/* the interpreter takes its own extra cycles */
+	if (desc->cycles > 1)
+	{
+		compiler->cycles -= desc->cycles - 1;
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                         // mapvar  CYCLES,compiler->cycles
+	}
+
+	/* set up PC the way the interpreter expects it */
+	if (!in_delay_slot)
+		UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                        // mov     [pc],desc->pc+2
+	else if (ovrpc != 0xffffffff)
+		UML_MOV(block, mem(&m_sh4_state->pc), ovrpc + 2);                           // mov     [pc],ovrpc+2
+	else
+		UML_MOV(block, mem(&m_sh4_state->pc), mem(&m_sh4_state->target));           // mov     [pc],target
+
+	UML_MOV(block, mem(&m_sh4_state->arg0), opcode);                                // mov     [arg0],opcode
+	save_fast_iregs(block);
+	UML_CALLC(block, cfunc_interpret, this);                                         // callc   cfunc_interpret
+	load_fast_iregs(block);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+}
+
+/*-------------------------------------------------
+    generate_interpret_branch - call the
+    interpreter for an opcode that changes PC
+    (RTE, SLEEP, TRAPA) and follow it
+-------------------------------------------------*/
+
+void sh34_base_device::generate_interpret_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode)
+{
+	if (desc->cycles > 1)
+	{
+		compiler->cycles -= desc->cycles - 1;
+		UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);                         // mapvar  CYCLES,compiler->cycles
+	}
+
+	UML_MOV(block, mem(&m_sh4_state->pc), desc->pc + 2);                            // mov     [pc],desc->pc+2
+	UML_MOV(block, mem(&m_sh4_state->arg0), opcode);                                // mov     [arg0],opcode
+	save_fast_iregs(block);
+	UML_CALLC(block, cfunc_interpret, this);                                         // callc   cfunc_interpret
+	load_fast_iregs(block);
+
+	/* RTE has a delay slot, which runs at the return address */
+	if (desc->delay.first() != nullptr)
+	{
+		UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pc));           // mov     target,[pc]
+		UML_MOV(block, mem(&m_sh4_state->delay), 0);                                // mov     delay,0
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));
+	}
+	else
+	{
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->pc), TRUE);      // <subtract cycles>
+		generate_hashjmp(block, compiler, nullptr, mem(&m_sh4_state->pc));
+	}
+}
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode
+-------------------------------------------------*/
+
+int sh34_base_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT32 ovrpc)
+{
+	UINT32 scratch, scratch2;
+	INT32 disp;
+	UINT16 opcode = desc->opptr.w[0];
+	UINT8 opswitch = opcode >> 12;
+	int in_delay_slot = ((desc->flags & OPFLAG_IN_DELAY_SLOT) != 0);
+	int pcrel_dynamic = (in_delay_slot && ovrpc == 0xffffffff);
+
+	switch (opswitch)
+	{
+		case  0:
+			return generate_group_0(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  1:    // MOVLS4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rn), scratch);   // add r0, Rn, scratch
+			UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_write32);
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  2:
+			return generate_group_2(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+		case  3:
+			return generate_group_3(block, compiler, desc, opcode, ovrpc);
+		case  4:
+			return generate_group_4(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  5:    // MOVLL4
+			scratch = (opcode & 0x0f) * 4;
+			UML_ADD(block, I0, R32(Rm), scratch);       // add r0, Rm, scratch
+			SETEA(0);                       // set ea for debug
+			UML_CALLH(block, *m_read32);             // call read32
+			UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case  6:
+			return generate_group_6(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  7:    // ADDI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_ADD(block, R32(Rn), R32(Rn), scratch2); // add Rn, Rn, scratch2
+			return TRUE;
+
+		case  8:
+			return generate_group_8(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case  9:    // MOVWI
+			scratch = ((ovrpc == 0xffffffff) ? desc->pc : ovrpc) + 2 + ((opcode & 0xff) * 2) + 2;
+
+			// only fold loads from ROM; literal pools in RAM can change under us
+			if (!(m_drcoptions & SH4DRC_STRICT_PCREL) && !pcrel_dynamic &&
+				m_program->get_read_ptr(scratch & AM) != nullptr && m_program->get_write_ptr(scratch & AM) == nullptr)
+			{
+				scratch2 = (UINT32)(INT32)(INT16) RW(scratch);
+				UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+			}
+			else
+			{
+				generate_pcrel_base(block, desc, ovrpc, ((opcode & 0xff) * 2) + 2);
+				SETEA(0);                       // set ea for debug
+				UML_CALLH(block, *m_read16);             // read16(r0, r1)
+				UML_SEXT(block, R32(Rn), I0, SIZE_WORD);            // sext Rn, r0, WORD
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 10:    // BRA
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // target = pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, scratch);           // hashjmp <mode>,target
+			return TRUE;
+
+		case 11:    // BSR
+			// panicstr @ 403da22 relies on the delay slot clobbering the PR set by a BSR, so
+			// do this before running the delay slot
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+			disp = ((INT32)opcode << 20) >> 20;
+			scratch = (desc->pc + 2) + disp * 2 + 2;            // target = pc+4 + disp*2
+
+			generate_delay_slot(block, compiler, desc, scratch - 2);
+
+			generate_update_cycles(block, compiler, scratch, TRUE);    // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, scratch);           // hashjmp <mode>,target
+			return TRUE;
+
+		case 12:
+			return generate_group_12(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+
+		case 13:    // MOVLI
+			scratch = ((((ovrpc == 0xffffffff) ? desc->pc : ovrpc) + 4) & ~3) + ((opcode & 0xff) * 4);
+
+			if (!(m_drcoptions & SH4DRC_STRICT_PCREL) && !pcrel_dynamic &&
+				m_program->get_read_ptr(scratch & AM) != nullptr && m_program->get_write_ptr(scratch & AM) == nullptr)
+			{
+				scratch2 = RL(scratch);
+				UML_MOV(block, R32(Rn), scratch2);          // mov Rn, scratch2
+			}
+			else
+			{
+				generate_pcrel_base(block, desc, ovrpc, 2);
+				UML_AND(block, I0, I0, ~3);             // and r0, r0, ~3
+				UML_ADD(block, I0, I0, (opcode & 0xff) * 4);    // add r0, r0, disp*4
+				SETEA(0);                       // set ea for debug
+				UML_CALLH(block, *m_read32);             // read32(r0, r1)
+				UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+			}
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 14:    // MOVI
+			scratch = opcode & 0xff;
+			scratch2 = (UINT32)(INT32)(INT16)(INT8)scratch;
+			UML_MOV(block, R32(Rn), scratch2);
+			return TRUE;
+
+		case 15:
+			return generate_group_15(block, compiler, desc, opcode, in_delay_slot, ovrpc);
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_0(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00:  // NOP
+	case 0x01:
+		return TRUE;
+
+	case 0x02:
+		switch (opcode & 0xf0)
+		{
+		case 0x00: // STCSR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->sr));
+			return TRUE;
+
+		case 0x10: // STCGBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->gbr));        // mov Rn, gbr
+			return TRUE;
+
+		case 0x20: // STCVBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->vbr));        // mov Rn, vbr
+			return TRUE;
+
+		case 0x30: // STCSSR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->ssr));        // mov Rn, ssr
+			return TRUE;
+
+		case 0x40: // STCSPC(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->spc));        // mov Rn, spc
+			return TRUE;
+
+		case 0x50: // NOP
+		case 0x60:
+		case 0x70:
+			return TRUE;
+		}
+		return FALSE;   // STCRBANK
+
+	case 0x03:
+		switch (opcode & 0xf0)
+		{
+		case 0x00: // BSRF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4);  // add target, Rn, pc+4
+
+			// 32x Cosmic Carnage @ 6002cb0 relies on the delay slot
+			// clobbering the calculated PR, so do it first
+			UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+			generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));    // jmp target
+			return TRUE;
+
+		case 0x20: // BRAF(Rn);
+			UML_ADD(block, mem(&m_sh4_state->target), R32(Rn), desc->pc + 4); // add target, Rn, pc+4
+
+			generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));    // jmp target
+			return TRUE;
+
+		case 0x80: // PREFM(Rn);
+			// prefetches are no-ops here; only store queue flushes need the interpreter
+			UML_AND(block, I0, R32(Rn), 0xfc000000);                    // and r0, Rn, 0xfc000000
+			UML_CMP(block, I0, 0xe0000000);                             // cmp r0, 0xe0000000
+			UML_JMPc(block, COND_NE, compiler->labelnum);               // jne labelnum
+
+			UML_MOV(block, mem(&m_sh4_state->arg0), opcode);            // mov [arg0], opcode
+			save_fast_iregs(block);
+			UML_CALLC(block, cfunc_interpret, this);                     // callc cfunc_interpret
+			load_fast_iregs(block);
+
+			UML_LABEL(block, compiler->labelnum++);                     // labelnum:
+			return TRUE;
+
+		case 0xc0: // MOVCAL(Rn);
+			UML_MOV(block, I0, R32(Rn));                // mov r0, Rn
+			UML_MOV(block, I1, R32(0));                 // mov r1, R0
+			SETEA(0);
+			UML_CALLH(block, *m_write32);                // call write32
+
+			if (!in_delay_slot)
+				generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+			return TRUE;
+
+		case 0x90: // TODO
+		case 0xa0:
+		case 0xb0:
+			return FALSE;
+		}
+		return TRUE;    // NOP
+
+	case 0x04: // MOVBS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x05: // MOVWS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_AND(block, I1, R32(Rm), 0x0000ffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x06: // MOVLS0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rn));        // add r0, R0, Rn
+		UML_MOV(block, I1, R32(Rm));            // mov r1, Rm
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x07: // MULL(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), R32(Rn), R32(Rm));  // mulu macl, ea, Rn, Rm
+		return TRUE;
+
+	case 0x08:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // CLRT();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and r0, sr, ~T (clear the T bit)
+			return TRUE;
+
+		case 0x10: // SETT();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+			return TRUE;
+
+		case 0x20: // CLRMAC();
+			UML_MOV(block, mem(&m_sh4_state->macl), 0);     // mov macl, #0
+			UML_MOV(block, mem(&m_sh4_state->mach), 0);     // mov mach, #0
+			return TRUE;
+
+		case 0x40: // CLRS();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~S);   // and sr, sr, ~S
+			return TRUE;
+
+		case 0x50: // SETS();
+			UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), S); // or sr, sr, S
+			return TRUE;
+
+		case 0x30: // TODO (LDTLB)
+			return FALSE;
+		}
+		return TRUE;    // NOP
+
+	case 0x09:
+		switch (opcode & 0x30)
+		{
+		case 0x10: // DIV0U();
+			UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~(M|Q|T)); // and sr, sr, ~(M|Q|T)
+			return TRUE;
+
+		case 0x20: // MOVT(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->sr), T);      // and Rn, sr, T
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x0a:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // STSMACH(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->mach));       // mov Rn, mach
+			return TRUE;
+
+		case 0x10: // STSMACL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->macl));       // mov Rn, macl
+			return TRUE;
+
+		case 0x20: // STSPR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->pr));         // mov Rn, pr
+			return TRUE;
+
+		case 0x30: // STCSGR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->sgr));        // mov Rn, sgr
+			return TRUE;
+
+		case 0x50: // STSFPUL(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->fpul));       // mov Rn, fpul
+			return TRUE;
+
+		case 0x60: // STSFPSCR(Rn);
+			UML_AND(block, R32(Rn), mem(&m_sh4_state->fpscr), 0x003fffff);  // and Rn, fpscr, 0x003fffff
+			return TRUE;
+
+		case 0x70: // STCDBR(Rn);
+			UML_MOV(block, R32(Rn), mem(&m_sh4_state->dbr));        // mov Rn, dbr
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x0b:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // RTS();
+			UML_MOV(block, mem(&m_sh4_state->target), mem(&m_sh4_state->pr));   // mov target, pr (in case of d-slot shenanigans)
+
+			generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+			generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));
+			return TRUE;
+
+		case 0x10: // SLEEP();
+		case 0x20: // RTE();
+			generate_interpret_branch(block, compiler, desc, opcode);
+			return TRUE;
+		}
+		return TRUE;    // NOP
+
+	case 0x0c: // MOVBL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0d: // MOVWL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0e: // MOVLL0(Rm, Rn);
+		UML_ADD(block, I0, R32(0), R32(Rm));        // add r0, R0, Rm
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(Rn), I0);            // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0f: // MAC_L(Rm, Rn);
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_2(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xff);  // and r1, Rm, 0xff
+		UML_CALLH(block, *m_write8);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, R32(Rm), 0xffff);    // and r1, Rm, 0xffff
+		UML_CALLH(block, *m_write16);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLS(Rm, Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_CALLH(block, *m_write32);
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3:
+		return FALSE;
+
+	case  4: // MOVBM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write8);         // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 2);    // sub Rn, Rn, 2
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write16);            // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLM(Rm, Rn);
+		UML_MOV(block, I1, R32(Rm));        // mov r1, Rm
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, 4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 13: // XTRCT(Rm, Rn);
+		UML_SHL(block, I0, R32(Rm), 16);        // shl r0, Rm, #16
+		UML_AND(block, I0, I0, 0xffff0000); // and r0, r0, #0xffff0000
+
+		UML_SHR(block, I1, R32(Rn), 16);        // shr, r1, Rn, #16
+		UML_AND(block, I1, I1, 0xffff);     // and r1, r1, #0x0000ffff
+
+		UML_OR(block, R32(Rn), I0, I1);     // or Rn, r0, r1
+		return TRUE;
+
+	case  7: // DIV0S(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));              // move r0, sr
+		UML_AND(block, I0, I0, ~(Q|M|T));       // and r0, r0, ~(Q|M|T) (clear the Q,M, and T bits)
+
+		UML_TEST(block, R32(Rn), 0x80000000);           // test Rn, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, Q);               // or r0, r0, Q
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_TEST(block, R32(Rm), 0x80000000);           // test Rm, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, M);               // or r0, r0, M
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+
+		UML_XOR(block, I1, R32(Rn), R32(Rm));           // xor r1, Rn, Rm
+		UML_TEST(block, I1, 0x80000000);            // test r1, #0x80000000
+		UML_JMPc(block, COND_Z, compiler->labelnum);            // jz labelnum
+
+		UML_OR(block, I0, I0, T);               // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);             // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);              // mov sr, r0
+		return TRUE;
+
+	case  8: // TST(Rm, Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+		UML_TEST(block, R32(Rm), R32(Rn));      // test Rm, Rn
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 12: // CMPSTR(Rm, Rn);
+		UML_XOR(block, I0, R32(Rn), R32(Rm));   // xor r0, Rn, Rm       (temp)
+
+		UML_SHR(block, I1, I0, 24); // shr r1, r0, #24  (HH)
+		UML_AND(block, I1, I1, 0xff);   // and r1, r1, #0xff
+
+		UML_SHR(block, I2, I0, 16); // shr r2, r0, #16  (HL)
+		UML_AND(block, I2, I2, 0xff);   // and r2, r2, #0xff
+
+		UML_SHR(block, I3, I0, 8);  // shr r3, r0, #8   (LH)
+		UML_AND(block, I3, I3, 0xff);   // and r3, r3, #0xff
+
+		UML_AND(block, I7, I0, 0xff);   // and r7, r0, #0xff    (LL)
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+
+		UML_CMP(block, I1, 0);      // cmp r1, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I2, 0);      // cmp r2, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I3, 0);      // cmp r3, #0
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jnz labelnum
+		UML_CMP(block, I7, 0);      // cmp r7, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum+1); // jnz labelnum
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum+1:
+		return TRUE;
+
+	case  9: // AND(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rn), R32(Rm));  // and Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // XOR(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rn), R32(Rm));  // xor Rn, Rn, Rm
+		return TRUE;
+
+	case 11: // OR(Rm, Rn);
+		UML_OR(block, R32(Rn), R32(Rn), R32(Rm));   // or Rn, Rn, Rm
+		return TRUE;
+
+	case 14: // MULU(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff);                // and r0, Rm, 0xffff
+		UML_AND(block, I1, R32(Rn), 0xffff);                // and r1, Rn, 0xffff
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // mulu macl, ea, r0, r1
+		return TRUE;
+
+	case 15: // MULS(Rm, Rn);
+		UML_SEXT(block, I0, R32(Rm), SIZE_WORD);                // sext r0, Rm
+		UML_SEXT(block, I1, R32(Rn), SIZE_WORD);                // sext r1, Rn
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->ea), I0, I1);    // muls macl, ea, r0, r1
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_3(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // CMPEQ(Rm, Rn); (equality)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_E, I0);            // set E, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  2: // CMPHS(Rm, Rn); (unsigned greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_AE, I0);       // set AE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  3: // CMPGE(Rm, Rn); (signed greater than or equal)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_GE, I0);       // set GE, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  6: // CMPHI(Rm, Rn); (unsigned greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_A, I0);            // set A, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  7: // CMPGT(Rm, Rn); (signed greater than)
+		UML_CMP(block, R32(Rn), R32(Rm));       // cmp Rn, Rm
+		UML_SETc(block, COND_G, I0);            // set G, r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, 1); // rolins sr, r0, 0, 1
+		return TRUE;
+
+	case  1:
+	case  9:
+		return FALSE;
+
+	case  4: // DIV1(Rm, Rn);
+		return FALSE;
+
+	case  5: // DMULU(Rm, Rn);
+		UML_MULU(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case 13: // DMULS(Rm, Rn);
+		UML_MULS(block, mem(&m_sh4_state->macl), mem(&m_sh4_state->mach), R32(Rn), R32(Rm));
+		return TRUE;
+
+	case  8: // SUB(Rm, Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), R32(Rm));  // sub Rn, Rn, Rm
+		return TRUE;
+
+	case 12: // ADD(Rm, Rn);
+		UML_ADD(block, R32(Rn), R32(Rn), R32(Rm));  // add Rn, Rn, Rm
+		return TRUE;
+
+	case 10: // SUBC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 11: // SUBV(Rm, Rn);
+		return FALSE;
+
+	case 14: // ADDC(Rm, Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0); // carry = T (T is bit 0 of SR)
+		UML_ADDC(block, R32(Rn), R32(Rn), R32(Rm)); // addc Rn, Rn, Rm
+		UML_SETc(block, COND_C, I0);                // setc    i0, C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 15: // ADDV(Rm, Rn);
+		return FALSE;
+	}
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_4(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	/* the SH-4 decodes all eight bits of the system register transfers */
+	switch (opcode & 0xff)
+	{
+	case 0x32: // STCMSGR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->sgr));     // mov r1, sgr
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x33: // STCMSSR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->ssr));     // mov r1, ssr
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x43: // STCMSPC(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->spc));     // mov r1, spc
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x52: // STSMFPUL(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->fpul));    // mov r1, fpul
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x62: // STSMFPSCR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_AND(block, I1, mem(&m_sh4_state->fpscr), 0x003fffff);   // and r1, fpscr, 0x003fffff
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0xf2: // STCMDBR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->dbr));     // mov r1, dbr
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x37: // LDCMSSR(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->ssr), I0);     // mov ssr, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x47: // LDCMSPC(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->spc), I0);     // mov spc, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x56: // LDSMFPUL(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->fpul), I0);    // mov fpul, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0xf6: // LDCMDBR(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->dbr), I0);     // mov dbr, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x3e: // LDCSSR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->ssr), R32(Rn));    // mov ssr, Rn
+		return TRUE;
+
+	case 0x4e: // LDCSPC(Rn);
+		UML_MOV(block, mem(&m_sh4_state->spc), R32(Rn));    // mov spc, Rn
+		return TRUE;
+
+	case 0x5a: // LDSFPUL(Rn);
+		UML_MOV(block, mem(&m_sh4_state->fpul), R32(Rn));   // mov fpul, Rn
+		return TRUE;
+
+	case 0xfa: // LDCDBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->dbr), R32(Rn));    // mov dbr, Rn
+		return TRUE;
+
+	case 0x07: // LDCMSR(Rn);
+	case 0x0e: // LDCSR(Rn);
+	case 0x66: // LDSMFPSCR(Rn);
+	case 0x6a: // LDSFPSCR(Rn);
+		// these can switch register banks or FPU modes; leave them to the interpreter
+		return FALSE;
+	}
+
+	switch (opcode & 0x0f)
+	{
+	case 0x03: // STCMRBANK(Rm_BANK, Rn);
+	case 0x07: // LDCMRBANK(Rn, Rm_BANK);
+	case 0x0e: // LDCRBANK(Rn, Rm_BANK);
+		if (opcode & 0x80)
+			return FALSE;
+		// fall through
+
+	case 0x02:
+	case 0x06:
+	case 0x0a:
+		// the rest of the upper rows are no-ops
+		if (opcode & 0xc0)
+			return TRUE;
+		break;
+
+	case 0x0c: // SHAD(Rm, Rn);
+	case 0x0d: // SHLD(Rm, Rn);
+		UML_TEST(block, R32(Rm), 0x80000000);           // test Rm, #0x80000000
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz labelnum
+
+		UML_AND(block, I0, R32(Rm), 0x1f);              // and r0, Rm, 0x1f
+		UML_SHL(block, R32(Rn), R32(Rn), I0);           // shl Rn, Rn, r0
+		UML_JMP(block, compiler->labelnum + 1);         // jmp labelnum+1
+
+		// a right shift by 32 has to be done in two steps
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		UML_XOR(block, I0, R32(Rm), ~0);                // xor r0, Rm, ~0
+		UML_AND(block, I0, I0, 0x1f);                   // and r0, r0, 0x1f
+		if ((opcode & 0x0f) == 0x0c)
+		{
+			UML_SAR(block, R32(Rn), R32(Rn), I0);       // sar Rn, Rn, r0
+			UML_SAR(block, R32(Rn), R32(Rn), 1);        // sar Rn, Rn, 1
+		}
+		else
+		{
+			UML_SHR(block, R32(Rn), R32(Rn), I0);       // shr Rn, Rn, r0
+			UML_SHR(block, R32(Rn), R32(Rn), 1);        // shr Rn, Rn, 1
+		}
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum+1:
+		return TRUE;
+
+	case 0x0f: // MAC_W(Rm, Rn);
+		return FALSE;
+	}
+
+	switch (opcode & 0x3F)
+	{
+	case 0x00: // SHLL(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x01: // SHLR(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 1);        // shr Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x04: // ROTL(Rn);
+		UML_ROL(block, R32(Rn), R32(Rn), 1);        // rol Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x05: // ROTR(Rn);
+		UML_ROR(block, R32(Rn), R32(Rn), 1);        // ror Rn, Rn, 1
+		UML_SETc(block, COND_C, I0);                    // set i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins [sr],i0,0,T
+		return TRUE;
+
+	case 0x02: // STSMMACH(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->mach));    // mov r1, mach
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x03: // STCMSR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->sr));      // mov r1, sr
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x06: // LDSMMACH(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->mach), I0);    // mov mach, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+
+	case 0x08: // SHLL2(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 2);
+		return TRUE;
+
+	case 0x09: // SHLR2(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 2);
+		return TRUE;
+
+	case 0x18: // SHLL8(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 8);
+		return TRUE;
+
+	case 0x19: // SHLR8(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 8);
+		return TRUE;
+
+	case 0x28: // SHLL16(Rn);
+		UML_SHL(block, R32(Rn), R32(Rn), 16);
+		return TRUE;
+
+	case 0x29: // SHLR16(Rn);
+		UML_SHR(block, R32(Rn), R32(Rn), 16);
+		return TRUE;
+
+	case 0x0a: // LDSMACH(Rn);
+		UML_MOV(block, mem(&m_sh4_state->mach), R32(Rn));       // mov mach, Rn
+		return TRUE;
+
+	case 0x0b: // JSR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+		UML_MOV(block, mem(&m_sh4_state->pr), desc->pc + 4); // mov m_pr, desc->pc + 4 (skip the current insn & delay slot)
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));    // and do the jump
+		return TRUE;
+
+	case 0x10: // DT(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+		UML_SUB(block, R32(Rn), R32(Rn), 1);    // sub Rn, Rn, 1
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jz compiler->labelnum
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x11: // CMPPZ(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+		UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x15: // CMPPL(Rn);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_CMP(block, R32(Rn), 0);     // cmp Rn, 0
+
+		UML_JMPc(block, COND_S, compiler->labelnum);    // js compiler->labelnum    (if negative)
+		UML_JMPc(block, COND_Z, compiler->labelnum);    // jz compiler->labelnum    (if zero)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+		UML_LABEL(block, compiler->labelnum++);         // desc->pc:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case 0x12: // STSMMACL(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->macl));    // mov r1, macl
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x13: // STCMGBR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);    // sub Rn, Rn, #4
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_MOV(block, I1, mem(&m_sh4_state->gbr)); // mov r1, gbr
+		SETEA(0);                   // set ea for debug
+		UML_CALLH(block, *m_write32);            // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x16: // LDSMMACL(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->macl), I0);    // mov macl, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x17: // LDCMGBR(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_ADD(block, R32(Rn), R32(Rn), 4);    // add Rn, #4
+		UML_MOV(block, mem(&m_sh4_state->gbr), I0); // mov gbr, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x1a: // LDSMACL(Rn);
+		UML_MOV(block, mem(&m_sh4_state->macl), R32(Rn));       // mov macl, Rn
+		return TRUE;
+
+	case 0x1b: // TAS(Rn);
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read8);          // call read8
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+
+		UML_CMP(block, I0, 0);      // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+		UML_OR(block, I1, I0, 0x80);    // or r1, r0, #0x80
+
+		UML_MOV(block, I0, R32(Rn));        // mov r0, Rn
+		UML_CALLH(block, *m_write8);         // write the value back
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x1e: // LDCGBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->gbr), R32(Rn));    // mov gbr, Rn
+		return TRUE;
+
+	case 0x20: // SHAL(Rn);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+		UML_SHR(block, I0, R32(Rn), 31);        // shr r0, Rn, 31
+		UML_AND(block, I0, I0, T);      // and r0, r0, T
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+		UML_SHL(block, R32(Rn), R32(Rn), 1);        // shl Rn, Rn, 1
+		return TRUE;
+
+	case 0x21: // SHAR(Rn);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T
+		UML_AND(block, I0, R32(Rn), T);     // and r0, Rn, T
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), I0);    // or sr, sr, r0
+		UML_SAR(block, R32(Rn), R32(Rn), 1);        // sar Rn, Rn, 1
+		return TRUE;
+
+	case 0x22: // STSMPR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);        // sub Rn, Rn, 4
+		UML_MOV(block, I0, R32(Rn));            // mov r0, Rn
+		SETEA(0);
+		UML_MOV(block, I1, mem(&m_sh4_state->pr));          // mov r1, pr
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x23: // STCMVBR(Rn);
+		UML_SUB(block, R32(Rn), R32(Rn), 4);        // sub Rn, Rn, 4
+		UML_MOV(block, I0, R32(Rn));            // mov r0, Rn
+		SETEA(0);
+		UML_MOV(block, I1, mem(&m_sh4_state->vbr));     // mov r1, vbr
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x24: // ROTCL(Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+		UML_ROLC(block, R32(Rn), R32(Rn), 1);           // rolc  Rn,Rn,1
+		UML_SETc(block, COND_C, I0);                        // set   i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 0x25: // ROTCR(Rn);
+		UML_CARRY(block, mem(&m_sh4_state->sr), 0);         // carry sr,0
+		UML_RORC(block, R32(Rn), R32(Rn), 1);           // rorc  Rn,Rn,1
+		UML_SETc(block, COND_C, I0);                        // set   i0,C
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T); // rolins sr,i0,0,T
+		return TRUE;
+
+	case 0x26: // LDSMPR(Rn);
+		UML_MOV(block, I0, R32(Rn));            // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, mem(&m_sh4_state->pr), I0);          // mov m_pr, r0
+		UML_ADD(block, R32(Rn), R32(Rn), 4);        // add Rn, Rn, #4
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x27: // LDCMVBR(Rn);
+		UML_MOV(block, I0, R32(Rn));            // mov r0, Rn
+		SETEA(0);
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, mem(&m_sh4_state->vbr), I0);     // mov m_sh4_state->vbr, r0
+		UML_ADD(block, R32(Rn), R32(Rn), 4);        // add Rn, Rn, #4
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x2a: // LDSPR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->pr), R32(Rn));         // mov m_pr, Rn
+		return TRUE;
+
+	case 0x2b: // JMP(Rn);
+		UML_MOV(block, mem(&m_sh4_state->target), R32(Rn));     // mov target, Rn
+
+		generate_delay_slot(block, compiler, desc, 0xffffffff);
+
+		generate_update_cycles(block, compiler, mem(&m_sh4_state->target), TRUE);  // <subtract cycles>
+		generate_hashjmp(block, compiler, desc, mem(&m_sh4_state->target));    // jmp (target)
+		return TRUE;
+
+	case 0x2e: // LDCVBR(Rn);
+		UML_MOV(block, mem(&m_sh4_state->vbr), R32(Rn));        //  mov vbr, Rn
+		return TRUE;
+
+	case 0x14: // NOP
+	case 0x30:
+	case 0x31:
+	case 0x34:
+	case 0x35:
+	case 0x36:
+	case 0x38:
+	case 0x39:
+	case 0x3a:
+	case 0x3b:
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_6(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	switch (opcode & 15)
+	{
+	case  0: // MOVBL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);    // sext Rn, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1: // MOVWL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);    // sext Rn, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2: // MOVLL(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		SETEA(0);                   // debug: ea = r0
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3: // MOV(Rm, Rn);
+		UML_MOV(block, R32(Rn), R32(Rm));       // mov Rn, Rm
+		return TRUE;
+
+	case  7: // NOT(Rm, Rn);
+		UML_XOR(block, R32(Rn), R32(Rm), 0xffffffff);   // xor Rn, Rm, 0xffffffff
+		return TRUE;
+
+	case  9: // SWAPW(Rm, Rn);
+		UML_ROL(block, R32(Rn), R32(Rm), 16);   // rol Rn, Rm, 16
+		return TRUE;
+
+	case 11: // NEG(Rm, Rn);
+		UML_SUB(block, R32(Rn), 0, R32(Rm));    // sub Rn, 0, Rm
+		return TRUE;
+
+	case 12: // EXTUB(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x000000ff);   // and Rn, Rm, 0xff
+		return TRUE;
+
+	case 13: // EXTUW(Rm, Rn);
+		UML_AND(block, R32(Rn), R32(Rm), 0x0000ffff);   // and Rn, Rm, 0xffff
+		return TRUE;
+
+	case 14: // EXTSB(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_BYTE);       // sext Rn, Rm, BYTE
+		return TRUE;
+
+	case 15: // EXTSW(Rm, Rn);
+		UML_SEXT(block, R32(Rn), R32(Rm), SIZE_WORD);       // sext Rn, Rm, WORD
+		return TRUE;
+
+	case  4: // MOVBP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read8);          // call read8
+		UML_SEXT(block, R32(Rn), I0, SIZE_BYTE);        // sext Rn, r0, BYTE
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 1);    // add Rm, Rm, #1
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5: // MOVWP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read16);         // call read16
+		UML_SEXT(block, R32(Rn), I0, SIZE_WORD);        // sext Rn, r0, WORD
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 2);    // add Rm, Rm, #2
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6: // MOVLP(Rm, Rn);
+		UML_MOV(block, I0, R32(Rm));        // mov r0, Rm
+		UML_CALLH(block, *m_read32);         // call read32
+		UML_MOV(block, R32(Rn), I0);        // mov Rn, r0
+
+		if (Rm != Rn)
+			UML_ADD(block, R32(Rm), R32(Rm), 4);    // add Rm, Rm, #4
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8: // SWAPB(Rm, Rn);
+		UML_AND(block, I0, R32(Rm), 0xffff0000);    // and r0, Rm, #0xffff0000
+		UML_AND(block, I1, R32(Rm), 0x000000ff);    // and r0, Rm, #0x000000ff
+		UML_AND(block, I2, R32(Rm), 0x0000ff00);    // and r0, Rm, #0x0000ff00
+		UML_SHL(block, I1, I1, 8);      // shl r1, r1, #8
+		UML_SHR(block, I2, I2, 8);      // shr r2, r2, #8
+		UML_OR(block, I0, I0, I1);      // or r0, r0, r1
+		UML_OR(block, R32(Rn), I0, I2);     // or Rn, r0, r2
+		return TRUE;
+
+	case 10: // NEGC(Rm, Rn);
+		UML_MOV(block, I0, mem(&m_sh4_state->sr));      // mov r0, sr (save SR)
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_CARRY(block, I0, 0);    // carry = T (T is bit 0 of SR)
+		UML_SUBB(block, R32(Rn), 0, R32(Rm));   // subb Rn, #0, Rm
+
+		UML_JMPc(block, COND_NC, compiler->labelnum);   // jnc labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);     // labelnum:
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_8(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	INT32 disp;
+	UINT32 udisp;
+	code_label templabel;
+
+	switch ( opcode  & (15<<8) )
+	{
+	case  0 << 8: // MOVBS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f);
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1 << 8: // MOVWS4(opcode & 0x0f, Rm);
+		udisp = (opcode & 0x0f) * 2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2<< 8:
+	case  3<< 8:
+	case  6<< 8:
+	case  7<< 8:
+	case 10<< 8:
+	case 12<< 8:
+	case 14<< 8:
+		return FALSE;
+
+	case  4<< 8: // MOVBL4(Rm, opcode & 0x0f);
+		udisp = opcode & 0x0f;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read8);              // call read8
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<< 8: // MOVWL4(Rm, opcode & 0x0f);
+		udisp = (opcode & 0x0f)*2;
+		UML_ADD(block, I0, R32(Rm), udisp);     // add r0, Rm, udisp
+		SETEA(0);
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  8<< 8: // CMPIM(opcode & 0xff);
+		UML_AND(block, I0, mem(&m_sh4_state->sr), ~T);  // and r0, sr, ~T (clear the T bit)
+
+		UML_SEXT(block, I1, opcode&0xff, SIZE_BYTE);    // sext r1, opcode&0xff, BYTE
+		UML_CMP(block, I1, R32(0));         // cmp r1, R0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);   // jnz compiler->labelnum   (if negative)
+
+		UML_OR(block, I0, I0, T);   // or r0, r0, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		UML_MOV(block, mem(&m_sh4_state->sr), I0);      // mov m_sh4_state->sr, r0
+		return TRUE;
+
+	case  9<< 8: // BT(opcode & 0xff);
+	case 11<< 8: // BF(opcode & 0xff);
+	case 13<< 8: // BTS(opcode & 0xff);
+	case 15<< 8: // BFS(opcode & 0xff);
+		{
+			compiler_state compiler_temp;
+			UINT32 target;
+
+			UML_TEST(block, mem(&m_sh4_state->sr), T);      // test m_sh4_state->sr, T
+			UML_JMPc(block, (opcode & (2 << 8)) ? COND_NZ : COND_Z, compiler->labelnum);   // j(n)z compiler->labelnum
+
+			disp = ((INT32)opcode << 24) >> 24;
+			target = (desc->pc + 2) + disp * 2 + 2;     // target = destination
+
+			templabel = compiler->labelnum;         // save our label
+			compiler->labelnum++;               // make sure the delay slot doesn't use it
+
+			// taken branches cost 2 more cycles, or 1 more with a delay slot
+			compiler_temp = *compiler;
+			compiler_temp.cycles += (opcode & (4 << 8)) ? 1 : 2;
+			UML_MAPVAR(block, MAPVAR_CYCLES, compiler_temp.cycles);   // mapvar  CYCLES,compiler_temp.cycles
+
+			if (opcode & (4 << 8))
+				generate_delay_slot(block, &compiler_temp, desc, target - 2);   // delay slot only if the branch is taken
+
+			generate_update_cycles(block, &compiler_temp, target, TRUE);  // <subtract cycles>
+			generate_hashjmp(block, compiler, desc, target);               // jmp target
+
+			UML_LABEL(block, templabel);            // labelnum:
+			UML_MAPVAR(block, MAPVAR_CYCLES, compiler->cycles);   // mapvar  CYCLES,compiler->cycles
+			compiler->labelnum = compiler_temp.labelnum;
+		}
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+int sh34_base_device::generate_group_12(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	UINT32 scratch;
+
+	switch (opcode & (15<<8))
+	{
+	case  0<<8: // MOVBSG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xff);       // and r1, R0, 0xff
+		UML_CALLH(block, *m_write8);             // call write8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  1<<8: // MOVWSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_AND(block, I1, R32(0), 0xffff);     // and r1, R0, 0xffff
+		UML_CALLH(block, *m_write16);                // call write16
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  2<<8: // MOVLSG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_MOV(block, I1, R32(0));         // mov r1, R0
+		UML_CALLH(block, *m_write32);                // call write32
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  3<<8: // TRAPA(opcode & 0xff);
+		generate_interpret_branch(block, compiler, desc, opcode);
+		return TRUE;
+
+	case  4<<8: // MOVBLG(opcode & 0xff);
+		scratch = (opcode & 0xff);
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read8);              // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_BYTE);         // sext R0, r0, BYTE
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  5<<8: // MOVWLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 2;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read16);             // call read16
+		UML_SEXT(block, R32(0), I0, SIZE_WORD);         // sext R0, r0, WORD
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  6<<8: // MOVLLG(opcode & 0xff);
+		scratch = (opcode & 0xff) * 4;
+		UML_ADD(block, I0, mem(&m_sh4_state->gbr), scratch);    // add r0, gbr, scratch
+		UML_CALLH(block, *m_read32);             // call read32
+		UML_MOV(block, R32(0), I0);         // mov R0, r0
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case  7<<8: // MOVA(opcode & 0xff);
+		if (in_delay_slot && ovrpc == 0xffffffff)
+		{
+			generate_pcrel_base(block, desc, ovrpc, 2);
+			UML_AND(block, I0, I0, ~3);                     // and r0, r0, ~3
+			UML_ADD(block, R32(0), I0, (opcode & 0xff) * 4);    // add R0, r0, disp*4
+		}
+		else
+		{
+			scratch = (opcode & 0xff) * 4;
+			scratch += ((((ovrpc == 0xffffffff) ? desc->pc : ovrpc) + 4) & ~3);
+
+			UML_MOV(block, R32(0), scratch);            // mov R0, scratch
+		}
+		return TRUE;
+
+	case  8<<8: // TSTI(opcode & 0xff);
+		scratch = opcode & 0xff;
+
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_AND(block, I0, R32(0), scratch);        // and r0, R0, scratch
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case  9<<8: // ANDI(opcode & 0xff);
+		UML_AND(block, R32(0), R32(0), opcode & 0xff);  // and r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 10<<8: // XORI(opcode & 0xff);
+		UML_XOR(block, R32(0), R32(0), opcode & 0xff);  // xor r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 11<<8: // ORI(opcode & 0xff);
+		UML_OR(block, R32(0), R32(0), opcode & 0xff);   // or r0, r0, opcode & 0xff
+		return TRUE;
+
+	case 12<<8: // TSTM(opcode & 0xff);
+		UML_AND(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), ~T);   // and sr, sr, ~T (clear the T bit)
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I0, I0, opcode & 0xff);
+		UML_CMP(block, I0, 0);          // cmp r0, #0
+		UML_JMPc(block, COND_NZ, compiler->labelnum);       // jnz labelnum
+
+		UML_OR(block, mem(&m_sh4_state->sr), mem(&m_sh4_state->sr), T); // or sr, sr, T
+
+		UML_LABEL(block, compiler->labelnum++);         // labelnum:
+		return TRUE;
+
+	case 13<<8: // ANDM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_AND(block, I1, I0, opcode&0xff);    // and r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+		return TRUE;
+
+	case 14<<8: // XORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_XOR(block, I1, I0, opcode&0xff);    // xor r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+		return TRUE;
+
+	case 15<<8: // ORM(opcode & 0xff);
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		UML_CALLH(block, *m_read8);              // read8
+
+		UML_OR(block, I1, I0, opcode&0xff); // or r1, r0, #opcode&0xff
+		UML_ADD(block, I0, R32(0), mem(&m_sh4_state->gbr)); // add r0, R0, gbr
+		SETEA(0);
+		UML_CALLH(block, *m_write8);             // write8
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*-------------------------------------------------
+    fmov_transfer_regs - pick the FPU registers
+    moved by an FMOV to or from memory in the
+    given mode; second is nullptr for single moves
+-------------------------------------------------*/
+
+void sh34_base_device::fmov_transfer_regs(UINT8 mode, UINT16 opcode, int reg, UINT32 **first, UINT32 **second)
+{
+	if (mode & MODE_PR)
+	{
+		/* everything but FMOV @Rm,DRn goes to the extended bank */
+		UINT32 *bank = ((opcode & 0x0f) != 0x08 || (reg & 1)) ? m_sh4_state->xf : m_sh4_state->fr;
+		*first = &bank[(reg & 14) + NATIVE_ENDIAN_VALUE_LE_BE(1,0)];
+		*second = &bank[(reg & 14) + NATIVE_ENDIAN_VALUE_LE_BE(0,1)];
+	}
+	else if (mode & MODE_SZ)
+	{
+		UINT32 *bank = (reg & 1) ? m_sh4_state->xf : m_sh4_state->fr;
+		*first = &bank[reg & 14];
+		*second = &bank[(reg & 14) + 1];
+	}
+	else
+	{
+		*first = &m_sh4_state->fr[reg];
+		*second = nullptr;
+	}
+}
+
+int sh34_base_device::generate_group_15(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, UINT16 opcode, int in_delay_slot, UINT32 ovrpc)
+{
+	int pr = (compiler->mode & MODE_PR) != 0;
+	UINT32 *first, *second;
+	int i, j;
+
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // FADD(Rm, Rn);
+		if (pr)
+			UML_FDADD(block, FR64(Rn), FR64(Rn), FR64(Rm));         // fdadd DRn, DRn, DRm
+		else
+			UML_FSADD(block, FR32(Rn), FR32(Rn), FR32(Rm));         // fsadd FRn, FRn, FRm
+		return TRUE;
+
+	case 0x01: // FSUB(Rm, Rn);
+		if (pr)
+			UML_FDSUB(block, FR64(Rn), FR64(Rn), FR64(Rm));         // fdsub DRn, DRn, DRm
+		else
+			UML_FSSUB(block, FR32(Rn), FR32(Rn), FR32(Rm));         // fssub FRn, FRn, FRm
+		return TRUE;
+
+	case 0x02: // FMUL(Rm, Rn);
+		if (pr)
+			UML_FDMUL(block, FR64(Rn), FR64(Rn), FR64(Rm));         // fdmul DRn, DRn, DRm
+		else
+			UML_FSMUL(block, FR32(Rn), FR32(Rn), FR32(Rm));         // fsmul FRn, FRn, FRm
+		return TRUE;
+
+	case 0x03: // FDIV(Rm, Rn);
+		// division by zero leaves the destination alone
+		if (pr)
+			UML_FDCMP(block, FR64(Rm), mem(&m_sh4_state->fzero));   // fdcmp DRm, 0.0
+		else
+			UML_FSCMP(block, FR32(Rm), mem(&m_sh4_state->fzero));   // fscmp FRm, 0.0
+		UML_GETFLGS(block, I0, FLAG_Z | FLAG_U);                    // getflgs r0, Z|U
+		UML_CMP(block, I0, FLAG_Z);                                 // cmp r0, Z
+		UML_JMPc(block, COND_E, compiler->labelnum);                // je labelnum
+
+		if (pr)
+			UML_FDDIV(block, FR64(Rn), FR64(Rn), FR64(Rm));         // fddiv DRn, DRn, DRm
+		else
+			UML_FSDIV(block, FR32(Rn), FR32(Rn), FR32(Rm));         // fsdiv FRn, FRn, FRm
+
+		UML_LABEL(block, compiler->labelnum++);                     // labelnum:
+		return TRUE;
+
+	case 0x04: // FCMP_EQ(Rm, Rn);
+		if (pr)
+			UML_FDCMP(block, FR64(Rn), FR64(Rm));                   // fdcmp DRn, DRm
+		else
+			UML_FSCMP(block, FR32(Rn), FR32(Rm));                   // fscmp FRn, FRm
+		UML_GETFLGS(block, I0, FLAG_Z | FLAG_U);                    // getflgs r0, Z|U
+		UML_CMP(block, I0, FLAG_Z);                                 // cmp r0, Z
+		UML_SETc(block, COND_E, I0);                                // sete r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);         // rolins sr, r0, 0, T
+		return TRUE;
+
+	case 0x05: // FCMP_GT(Rm, Rn);
+		// Rn > Rm is tested as an ordered Rm < Rn
+		if (pr)
+			UML_FDCMP(block, FR64(Rm), FR64(Rn));                   // fdcmp DRm, DRn
+		else
+			UML_FSCMP(block, FR32(Rm), FR32(Rn));                   // fscmp FRm, FRn
+		UML_GETFLGS(block, I0, FLAG_C | FLAG_U);                    // getflgs r0, C|U
+		UML_CMP(block, I0, FLAG_C);                                 // cmp r0, C
+		UML_SETc(block, COND_E, I0);                                // sete r0
+		UML_ROLINS(block, mem(&m_sh4_state->sr), I0, 0, T);         // rolins sr, r0, 0, T
+		return TRUE;
+
+	case 0x06: // FMOVS0FR(Rm, Rn);
+	case 0x08: // FMOVMRFR(Rm, Rn);
+	case 0x09: // FMOVMRIFR(Rm, Rn);
+		fmov_transfer_regs(compiler->mode, opcode, Rn, &first, &second);
+		if ((opcode & 0x0f) == 0x06)
+			UML_ADD(block, I2, R32(0), R32(Rm));                    // add r2, R0, Rm
+		else
+			UML_MOV(block, I2, R32(Rm));                            // mov r2, Rm
+		UML_MOV(block, I0, I2);                                     // mov r0, r2
+		SETEA(0);
+		UML_CALLH(block, *m_read32);                                // call read32
+		UML_MOV(block, mem(first), I0);                             // mov <first>, r0
+		if (second != nullptr)
+		{
+			UML_ADD(block, I0, I2, 4);                              // add r0, r2, 4
+			UML_CALLH(block, *m_read32);                            // call read32
+			UML_MOV(block, mem(second), I0);                        // mov <second>, r0
+		}
+		if ((opcode & 0x0f) == 0x09)
+			UML_ADD(block, R32(Rm), R32(Rm), (second != nullptr) ? 8 : 4);   // add Rm, Rm, 4/8
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x07: // FMOVFRS0(Rm, Rn);
+	case 0x0a: // FMOVFRMR(Rm, Rn);
+	case 0x0b: // FMOVFRMDR(Rm, Rn);
+		fmov_transfer_regs(compiler->mode, opcode, Rm, &first, &second);
+		if ((opcode & 0x0f) == 0x0b)
+			UML_SUB(block, R32(Rn), R32(Rn), (second != nullptr) ? 8 : 4);   // sub Rn, Rn, 4/8
+		if ((opcode & 0x0f) == 0x07)
+			UML_ADD(block, I2, R32(0), R32(Rn));                    // add r2, R0, Rn
+		else
+			UML_MOV(block, I2, R32(Rn));                            // mov r2, Rn
+		UML_MOV(block, I0, I2);                                     // mov r0, r2
+		UML_MOV(block, I1, mem(first));                             // mov r1, <first>
+		SETEA(0);
+		UML_CALLH(block, *m_write32);                               // call write32
+		if (second != nullptr)
+		{
+			UML_ADD(block, I0, I2, 4);                              // add r0, r2, 4
+			UML_MOV(block, I1, mem(second));                        // mov r1, <second>
+			UML_CALLH(block, *m_write32);                           // call write32
+		}
+
+		if (!in_delay_slot)
+			generate_update_cycles(block, compiler, desc->pc + 2, TRUE);
+		return TRUE;
+
+	case 0x0c: // FMOVFR(Rm, Rn);
+		if ((compiler->mode & (MODE_PR | MODE_SZ)) == 0)
+			UML_MOV(block, FR32(Rn), FR32(Rm));                     // mov FRn, FRm
+		else
+		{
+			UINT32 *src = (Rm & 1) ? m_sh4_state->xf : m_sh4_state->fr;
+			UINT32 *dst = (Rn & 1) ? m_sh4_state->xf : m_sh4_state->fr;
+			UML_DMOV(block, mem(&dst[Rn & 14]), mem(&src[Rm & 14]));    // dmov <dst>, <src>
+		}
+		return TRUE;
+
+	case 0x0d:
+		break;
+
+	case 0x0e: // FMAC(Rm, Rn);
+		if (!pr)
+		{
+			UML_FSMUL(block, F0, FR32(0), FR32(Rm));                // fsmul f0, FR0, FRm
+			UML_FSADD(block, FR32(Rn), F0, FR32(Rn));               // fsadd FRn, f0, FRn
+		}
+		return TRUE;
+
+	default:
+		return FALSE;
+	}
+
+	switch ((opcode >> 4) & 0x0f)
+	{
+	case 0x00: // FSTS(Rn);
+		UML_MOV(block, FR32(Rn), mem(&m_sh4_state->fpul));          // mov FRn, fpul
+		return TRUE;
+
+	case 0x01: // FLDS(Rn);
+		UML_MOV(block, mem(&m_sh4_state->fpul), FR32(Rn));          // mov fpul, FRn
+		return TRUE;
+
+	case 0x02: // FLOAT(Rn);
+		if (!pr)
+			UML_FSFRINT(block, FR32(Rn), mem(&m_sh4_state->fpul), SIZE_DWORD);  // fsfrint FRn, fpul, dword
+		else if (Rn & 1)
+			return FALSE;
+		else
+			UML_FDFRINT(block, FR64(Rn), mem(&m_sh4_state->fpul), SIZE_DWORD);  // fdfrint DRn, fpul, dword
+		return TRUE;
+
+	case 0x03: // FTRC(Rn);
+		if (!pr)
+			UML_FSTOINT(block, mem(&m_sh4_state->fpul), FR32(Rn), SIZE_DWORD, ROUND_TRUNC);    // fstoint fpul, FRn, dword, trunc
+		else if (Rn & 1)
+			return FALSE;
+		else
+			UML_FDTOINT(block, mem(&m_sh4_state->fpul), FR64(Rn), SIZE_DWORD, ROUND_TRUNC);    // fdtoint fpul, DRn, dword, trunc
+		return TRUE;
+
+	case 0x04: // FNEG(Rn);
+		if (!pr)
+			UML_FSNEG(block, FR32(Rn), FR32(Rn));                   // fsneg FRn, FRn
+		else if (Rn & 1)
+			return FALSE;
+		else
+			UML_FDNEG(block, FR64(Rn), FR64(Rn));                   // fdneg DRn, DRn
+		return TRUE;
+
+	case 0x05: // FABS(Rn);
+		if (!pr)
+			UML_AND(block, FR32(Rn), FR32(Rn), 0x7fffffff);         // and FRn, FRn, 0x7fffffff
+		else
+			UML_AND(block, FR32(NATIVE_ENDIAN_VALUE_LE_BE(Rn | 1, Rn & 14)), FR32(NATIVE_ENDIAN_VALUE_LE_BE(Rn | 1, Rn & 14)), 0x7fffffff);
+		return TRUE;
+
+	case 0x06: // FSQRT(Rn);
+		// the interpreter takes the double square root at single precision
+		if (pr)
+			return FALSE;
+		// fall through
+
+	case 0x07: // FSRRA(Rn);
+		// negative inputs leave the register alone
+		UML_FSCMP(block, FR32(Rn), mem(&m_sh4_state->fzero));       // fscmp FRn, 0.0
+		UML_GETFLGS(block, I0, FLAG_C | FLAG_U);                    // getflgs r0, C|U
+		UML_CMP(block, I0, FLAG_C);                                 // cmp r0, C
+		UML_JMPc(block, COND_E, compiler->labelnum);                // je labelnum
+
+		if (((opcode >> 4) & 0x0f) == 0x06)
+			UML_FSSQRT(block, FR32(Rn), FR32(Rn));                  // fssqrt FRn, FRn
+		else
+		{
+			// FSRSQRT may be an estimate on some back-ends, so do it the long way
+			UML_FSSQRT(block, F1, FR32(Rn));                        // fssqrt f1, FRn
+			UML_FSFRINT(block, F0, 1, SIZE_DWORD);                  // fsfrint f0, 1, dword
+			UML_FSDIV(block, FR32(Rn), F0, F1);                     // fsdiv FRn, f0, f1
+		}
+
+		UML_LABEL(block, compiler->labelnum++);                     // labelnum:
+		return TRUE;
+
+	case 0x08: // FLDI0(Rn);
+		UML_MOV(block, FR32(Rn), 0);                                // mov FRn, 0.0f
+		return TRUE;
+
+	case 0x09: // FLDI1(Rn);
+		UML_MOV(block, FR32(Rn), 0x3f800000);                       // mov FRn, 1.0f
+		return TRUE;
+
+	case 0x0a: // FCNVSD(Rn);
+		if (pr)
+			UML_FDFRFLT(block, FR64(Rn), mem(&m_sh4_state->fpul), SIZE_DWORD);  // fdfrflt DRn, fpul, dword
+		return TRUE;
+
+	case 0x0b: // FCNVDS(Rn);
+		// the rounding mode is only known at run time
+		return !pr;
+
+	case 0x0e: // FIPR(Rn);
+		{
+			int n = Rn & 12;
+			int m = (Rn & 3) << 2;
+
+			UML_FSMUL(block, F0, FR32(n), FR32(m));                 // fsmul f0, FRn, FRm
+			for (i = 1; i < 4; i++)
+			{
+				UML_FSMUL(block, F1, FR32(n + i), FR32(m + i));     // fsmul f1, FRn+i, FRm+i
+				UML_FSADD(block, F0, F0, F1);                       // fsadd f0, f0, f1
+			}
+			UML_FSMOV(block, FR32(n + 3), F0);                      // fsmov FRn+3, f0
+		}
+		return TRUE;
+
+	case 0x0f:
+		if ((opcode & 0x300) == 0x100) // FTRV(Rn);
+		{
+			int n = Rn & 12;
+
+			// accumulate all four sums before touching FVn
+			for (i = 0; i < 4; i++)
+			{
+				UML_FSMOV(block, freg(i), mem(&m_sh4_state->fzero));   // fsmov f<i>, 0.0
+				for (j = 0; j < 4; j++)
+				{
+					UML_FSMUL(block, F4, XF32((j << 2) + i), FR32(n + j));     // fsmul f4, XF<j*4+i>, FRn+j
+					UML_FSADD(block, freg(i), freg(i), F4);                   // fsadd f<i>, f<i>, f4
+				}
+			}
+			for (i = 0; i < 4; i++)
+				UML_FSMOV(block, FR32(n + i), freg(i));             // fsmov FRn+i, f<i>
+			return TRUE;
+		}
+		if ((opcode & 0xf00) == 0x300) // FSCHG();
+		{
+			UML_XOR(block, mem(&m_sh4_state->fpscr), mem(&m_sh4_state->fpscr), SZ);    // xor fpscr, fpscr, SZ
+			UML_TEST(block, mem(&m_sh4_state->fpscr), SZ);                             // test fpscr, SZ
+			UML_SETc(block, COND_NZ, mem(&m_sh4_state->fpu_sz));                       // setnz fpu_sz
+			return TRUE;
+		}
+		// FSSCA, FRCHG
+		return FALSE;
+	}
+
+	return FALSE;
+}
+
+/***************************************************************************
+    INTERPRETER CROSS-CHECK
+***************************************************************************/
+
+/* the tests run out of the 4k of on-chip RAM */
+#define VALIDATE_BASE       0x1c000000
+#define VALIDATE_SIZE       0x1000
+#define VALIDATE_PC         (VALIDATE_BASE + 0x200)
+#define VALIDATE_MAX_REPORT 20
+
+/* delay slot instructions tried after every delayed branch */
+static const UINT16 validate_slots[] =
+{
+	0x0009,     // NOP
+	0x7301,     // ADD     #1,R3
+	0x6233,     // MOV     R3,R2
+	0x2122,     // MOV.L   R2,@R1
+	0xf36c,     // FMOV    FR6,FR3
+	0x9001      // MOV.W   @(2,PC),R0 (keep last; skipped after BRA/BSR)
+};
+
+static inline UINT32 validate_rand(UINT32 &seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+
+/*-------------------------------------------------
+    validate_skip - true for opcodes that can't be
+    compared: ones that swap register banks, wait
+    for interrupts, or stop the interpreter
+-------------------------------------------------*/
+
+static bool validate_skip(UINT16 opcode, UINT8 mode)
+{
+	switch (opcode & 0xf0ff)
+	{
+	case 0x001b:    // SLEEP
+	case 0x002b:    // RTE
+	case 0x0038:    // LDTLB
+	case 0x4007:    // LDC.L   @Rm+,SR
+	case 0x400e:    // LDC     Rm,SR
+	case 0x4066:    // LDS.L   @Rm+,FPSCR
+	case 0x406a:    // LDS     Rm,FPSCR
+		return true;
+
+	case 0xf02d:    // FLOAT   FPUL,DRn
+	case 0xf03d:    // FTRC    DRm,FPUL
+		// odd registers are a fatal error in double precision
+		return (mode & MODE_PR) && (opcode & 0x0100);
+	}
+
+	return (opcode & 0xff00) == 0xc300 ||   // TRAPA
+			opcode == 0xaffe ||                 // BRA to self is a busy loop
+			opcode == 0xfbfd;                   // FRCHG
+}
+
+
+/*-------------------------------------------------
+    validate_register_only - true for opcodes that
+    never touch memory, so can be run with fully
+    random register values
+-------------------------------------------------*/
+
+static bool validate_register_only(UINT16 opcode)
+{
+	switch (opcode >> 12)
+	{
+	case 0x0:
+		switch (opcode & 0x0f)
+		{
+		case 0x02: case 0x07: case 0x08: case 0x09: case 0x0a:
+			return true;
+		}
+		return false;
+
+	case 0x2:
+		return (opcode & 0x0f) >= 0x07;
+
+	case 0x3:
+	case 0x7:
+	case 0xe:
+		return true;
+
+	case 0x4:
+		switch (opcode & 0xff)
+		{
+		case 0x00: case 0x01: case 0x04: case 0x05: case 0x08: case 0x09:
+		case 0x10: case 0x11: case 0x15: case 0x18: case 0x19:
+		case 0x20: case 0x21: case 0x24: case 0x25: case 0x28: case 0x29:
+			return true;
+		}
+		return (opcode & 0x0e) == 0x0c;     // SHAD, SHLD
+
+	case 0x6:
+		return (opcode & 0x0f) == 0x03 || (opcode & 0x0f) >= 0x07;
+
+	case 0x8:
+		return (opcode & 0x0f00) == 0x0800;     // CMP/EQ  #imm,R0
+
+	case 0xc:
+		return (opcode & 0x0c00) == 0x0800;     // TST, AND, XOR, OR  #imm,R0
+
+	case 0xf:
+		return (opcode & 0x0f) <= 0x05 || (opcode & 0x0f) >= 0x0c;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    validate_setup - fill the CPU state with
+    random values; the integer registers point
+    into the on-chip RAM (kind 0), the store
+    queues (kind 1), or anywhere at all (kind 2)
+-------------------------------------------------*/
+
+void sh34_base_device::validate_setup(int kind, UINT8 mode, UINT32 &seed)
+{
+	int regnum;
+
+	for (regnum = 0; regnum < 16; regnum++)
+	{
+		UINT32 value = validate_rand(seed);
+
+		// small floats, with the odd zero for FDIV and FCMP
+		m_sh4_state->fr[regnum] = ((value & 7) == 0) ? 0 : ((value & 0x87ffffff) | 0x38000000);
+		value = validate_rand(seed);
+		m_sh4_state->xf[regnum] = ((value & 7) == 0) ? 0 : ((value & 0x87ffffff) | 0x38000000);
+
+		if (kind == 2)
+			m_sh4_state->r[regnum] = validate_rand(seed);
+		else if (regnum == 0)
+			m_sh4_state->r[regnum] = validate_rand(seed) & ((kind == 0) ? 0xfc : 0x3c);
+		else
+			m_sh4_state->r[regnum] = ((kind == 0) ? (VALIDATE_BASE + 0x600) : 0xe0000040) + regnum * ((kind == 0) ? 0x20 : 4);
+	}
+
+	m_sh4_state->gbr = (kind == 0) ? (VALIDATE_BASE + 0x900) : (kind == 1) ? 0xe0000000 : validate_rand(seed);
+	m_sh4_state->pr = (kind == 0) ? (VALIDATE_BASE + 0x100) : (kind == 1) ? 0xe0000000 : validate_rand(seed);
+	m_sh4_state->mach = validate_rand(seed);
+	m_sh4_state->macl = validate_rand(seed);
+	m_sh4_state->ssr = validate_rand(seed);
+	m_sh4_state->spc = validate_rand(seed);
+	m_sh4_state->sgr = validate_rand(seed);
+	m_sh4_state->dbr = validate_rand(seed);
+	m_sh4_state->fpul = validate_rand(seed);
+
+	// privileged, interrupts blocked, register bank untouched
+	m_sh4_state->sr = (m_sh4_state->sr & sRB) | MD | BL | I | (validate_rand(seed) & (M | Q | S | T));
+	m_sh4_state->fpscr = (validate_rand(seed) & 0x0003fffc) | ((mode & MODE_PR) ? PR : 0) | ((mode & MODE_SZ) ? SZ : 0);
+	m_sh4_state->fpu_pr = (mode & MODE_PR) ? 1 : 0;
+	m_sh4_state->fpu_sz = (mode & MODE_SZ) ? 1 : 0;
+	m_sh4_state->pc = VALIDATE_PC;
+	m_sh4_state->delay = 0;
+	m_sh4_state->test_irq = 0;
+}
+
+
+/*-------------------------------------------------
+    validate_one - compile one instruction (and
+    its delay slot) on its own, then run it on the
+    recompiler and the interpreter from the same
+    random states and compare the results
+-------------------------------------------------*/
+
+int sh34_base_device::validate_one(UINT16 opcode, UINT16 slotop, UINT8 mode, UINT8 *scratch, UINT32 &seed, std::string *errors)
+{
+	UINT8 ram_before[VALIDATE_SIZE], ram_after[VALIDATE_SIZE];
+	UINT8 sq_before[64], sq_after[64];
+	UINT8 low_before[8], low_after[8];
+	compiler_state compiler = { 0 };
+	opcode_desc desc, slot;
+	int failures = 0;
+	int kind, regnum;
+
+	/* describe the instruction and its slot */
+	m_drcfe->describe_test(desc, VALIDATE_PC, opcode);
+	if (desc.delayslots != 0)
+	{
+		m_drcfe->describe_test(slot, VALIDATE_PC + 2, slotop);
+		slot.flags |= OPFLAG_IN_DELAY_SLOT;
+		slot.branch = &desc;
+		desc.delay.append(slot);
+	}
+
+	/* compile it as the only code for this mode and pc; every path out */
+	/* subtracts cycles first, so the exact cycle count stops it */
+	compiler.mode = mode;
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			drcuml_block *block = m_drcuml->begin_block(256);
+			UML_HASH(block, mode, VALIDATE_PC);                                     // hash    mode,VALIDATE_PC
+			generate_sequence_instruction(block, &compiler, &desc, 0xffffffff);
+			generate_update_cycles(block, &compiler, VALIDATE_PC + 2, TRUE);        // <subtract cycles>
+			UML_HASHJMP(block, mode, VALIDATE_PC + 2, *m_nocode);                   // hashjmp <mode>,VALIDATE_PC+2,nocode
+			block->end();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+	desc.delay.detach_all();
+
+	for (kind = 0; kind < 3; kind++)
+	{
+		if (kind == 1 && (m_sq_base == nullptr || (opcode & 0xf0ff) == 0x0083))    // PREF would write the queue out
+			continue;
+		if (kind == 2 && !validate_register_only(opcode))
+			continue;
+
+		validate_setup(kind, mode, seed);
+		internal_sh4_state before = *m_sh4_state;
+		for (regnum = 0; regnum < VALIDATE_SIZE; regnum++)
+			scratch[regnum] = validate_rand(seed);
+
+		/* what follows the instruction is its slot, or a NOP so DT sees no busy loop */
+		m_program->write_word(VALIDATE_PC, opcode);
+		m_program->write_word(VALIDATE_PC + 2, (desc.delayslots != 0) ? slotop : 0x0009);
+		memcpy(ram_before, scratch, VALIDATE_SIZE);
+		if (m_sq_base != nullptr)
+		{
+			for (regnum = 0; regnum < 64; regnum++)
+				((UINT8 *)m_sq_base)[regnum] = validate_rand(seed);
+			memcpy(sq_before, m_sq_base, 64);
+		}
+
+		/* @R0 on its own reaches outside the scratch RAM, and TAS changes what it finds there */
+		if (kind != 2)
+			for (regnum = 0; regnum < 8; regnum++)
+				low_before[regnum] = m_program->read_byte(before.r[0] + regnum);
+
+		/* run the interpreter the way execute_run does */
+		m_sh4_state->icount = 0;
+		m_sh4_state->pc = VALIDATE_PC + 2;
+		m_sh4_state->ppc = m_sh4_state->pc;
+		execute_one(opcode);
+		m_sh4_state->icount--;
+		if (m_sh4_state->delay)
+		{
+			m_sh4_state->delay = 0;
+			m_sh4_state->ppc = m_sh4_state->pc;
+			execute_one(slotop);
+			m_sh4_state->icount--;
+		}
+		internal_sh4_state expected = *m_sh4_state;
+		memcpy(ram_after, scratch, VALIDATE_SIZE);
+		if (m_sq_base != nullptr)
+			memcpy(sq_after, m_sq_base, 64);
+		for (regnum = 0; regnum < 8 && kind != 2; regnum++)
+		{
+			low_after[regnum] = m_program->read_byte(before.r[0] + regnum);
+			m_program->write_byte(before.r[0] + regnum, low_before[regnum]);
+		}
+
+		/* then the recompiler, with exactly enough cycles to run it once */
+		*m_sh4_state = before;
+		memcpy(scratch, ram_before, VALIDATE_SIZE);
+		if (m_sq_base != nullptr)
+			memcpy(m_sq_base, sq_before, 64);
+		m_sh4_state->icount = -expected.icount - 1;
+		m_drcuml->execute(*m_entry);
+		expected.icount = -1;
+
+		/* compare */
+		std::string diffs;
+		for (regnum = 0; regnum < 16; regnum++)
+		{
+			if (m_sh4_state->r[regnum] != expected.r[regnum])
+				diffs.append(string_format(" R%d=%08X/%08X", regnum, m_sh4_state->r[regnum], expected.r[regnum]));
+			if (m_sh4_state->fr[regnum] != expected.fr[regnum])
+				diffs.append(string_format(" FR%d=%08X/%08X", regnum, m_sh4_state->fr[regnum], expected.fr[regnum]));
+			if (m_sh4_state->xf[regnum] != expected.xf[regnum])
+				diffs.append(string_format(" XF%d=%08X/%08X", regnum, m_sh4_state->xf[regnum], expected.xf[regnum]));
+		}
+
+#define VALIDATE_FIELD(field, name) \
+		if ((UINT32)m_sh4_state->field != (UINT32)expected.field) \
+			diffs.append(string_format(" " name "=%08X/%08X", (UINT32)m_sh4_state->field, (UINT32)expected.field));
+
+		VALIDATE_FIELD(pc, "PC");
+		VALIDATE_FIELD(pr, "PR");
+		VALIDATE_FIELD(sr, "SR");
+		VALIDATE_FIELD(ssr, "SSR");
+		VALIDATE_FIELD(spc, "SPC");
+		VALIDATE_FIELD(sgr, "SGR");
+		VALIDATE_FIELD(gbr, "GBR");
+		VALIDATE_FIELD(vbr, "VBR");
+		VALIDATE_FIELD(dbr, "DBR");
+		VALIDATE_FIELD(mach, "MACH");
+		VALIDATE_FIELD(macl, "MACL");
+		VALIDATE_FIELD(fpscr, "FPSCR");
+		VALIDATE_FIELD(fpul, "FPUL");
+		VALIDATE_FIELD(fpu_pr, "fpu_pr");
+		VALIDATE_FIELD(fpu_sz, "fpu_sz");
+		VALIDATE_FIELD(test_irq, "test_irq");
+		VALIDATE_FIELD(icount, "icount");
+#undef VALIDATE_FIELD
+
+		if (memcmp(scratch, ram_after, VALIDATE_SIZE) != 0)
+			diffs.append(" RAM");
+		if (m_sq_base != nullptr && memcmp(m_sq_base, sq_after, 64) != 0)
+			diffs.append(" SQ");
+		for (regnum = 0; regnum < 8 && kind != 2; regnum++)
+		{
+			if (m_program->read_byte(before.r[0] + regnum) != low_after[regnum])
+			{
+				diffs.append(" @R0");
+				break;
+			}
+		}
+
+		if (!diffs.empty())
+		{
+			if (failures++ == 0 && errors != nullptr)
+			{
+				char buffer[256];
+				DasmSH4(buffer, VALIDATE_PC, opcode);
+				errors->append(string_format("  %04X %-24s", opcode, buffer));
+				if (desc.delayslots != 0)
+				{
+					DasmSH4(buffer, VALIDATE_PC + 2, slotop);
+					errors->append(string_format(" slot %04X %-20s", slotop, buffer));
+				}
+				errors->append(string_format(" PR=%d SZ=%d kind %d, drc/interp:%s\n", mode & MODE_PR, (mode & MODE_SZ) >> 1, kind, diffs.c_str()));
+			}
+		}
+	}
+
+	return failures;
+}
+
+
+/*-------------------------------------------------
+    validate_drc - run every opcode in every FPU
+    mode on both the recompiler and the
+    interpreter, report any difference and exit
+-------------------------------------------------*/
+
+void sh34_base_device::validate_drc()
+{
+	int tests = 0, failures = 0;
+	std::string errors;
+	UINT32 seed = 0x5eed1234;
+
+	m_drc_validated = true;
+
+	UINT8 *scratch = (UINT8 *)m_program->get_write_ptr(VALIDATE_BASE);
+	if (scratch == nullptr)
+	{
+		osd_printf_info("%s: no on-chip RAM to check the recompiler against the interpreter in\n", tag());
+		return;
+	}
+
+	/* keep everything the tests will trample */
+	internal_sh4_state saved = *m_sh4_state;
+	std::vector<UINT8> saved_ram(scratch, scratch + VALIDATE_SIZE);
+	UINT8 saved_sq[64];
+	if (m_sq_base != nullptr)
+		memcpy(saved_sq, m_sq_base, 64);
+	UINT32 saved_rbnk[2][8];
+	memcpy(saved_rbnk, m_rbnk, sizeof(m_rbnk));
+
+	osd_ticks_t start = osd_ticks();
+	for (UINT8 mode = 0; mode < 4; mode++)
+	{
+		for (UINT32 opcode = 0; opcode < 0x10000; opcode++)
+		{
+			if (validate_skip(opcode, mode))
+				continue;
+
+			// sample the unconditional displacements
+			bool longbranch = ((opcode & 0xe000) == 0xa000);
+			if (longbranch && (opcode & 0x0fff) % 0x111 != 0)
+				continue;
+
+			opcode_desc desc;
+			m_drcfe->describe_test(desc, VALIDATE_PC, opcode);
+			int slots = (desc.delayslots != 0) ? ARRAY_LENGTH(validate_slots) - (longbranch ? 1 : 0) : 1;
+			for (int slotnum = 0; slotnum < slots; slotnum++)
+			{
+				int result = validate_one(opcode, validate_slots[slotnum], mode, scratch, seed, (failures < VALIDATE_MAX_REPORT) ? &errors : nullptr);
+				tests++;
+				if (result != 0)
+					failures++;
+			}
+		}
+	}
+	osd_ticks_t elapsed = osd_ticks() - start;
+
+	/* put everything back and drop the test blocks */
+	memcpy(m_rbnk, saved_rbnk, sizeof(m_rbnk));
+	if (m_sq_base != nullptr)
+		memcpy(m_sq_base, saved_sq, 64);
+	memcpy(scratch, &saved_ram[0], VALIDATE_SIZE);
+	*m_sh4_state = saved;
+	code_flush_cache();
+
+	osd_printf_info("%s: checked %d instructions against the interpreter in %.2f seconds, %d differed\n",
+		tag(), tests, double(elapsed) / double(osd_ticks_per_second()), failures);
+	if (failures != 0)
+	{
+		osd_printf_info("%s", errors.c_str());
+		fatalerror("SH-4 recompiler validation failed with %d errors\n", failures);
+	}
+	machine().schedule_exit();
+}
+
+/***************************************************************************
+    CORE CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    sh4drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_set_options(UINT32 options)
+{
+	if (!allow_drc()) return;
+	m_drcoptions = options;
+}
+
+
+/*-------------------------------------------------
+    sh4drc_add_pcflush - add a new address where
+    the PC must be flushed for speedups to work
+-------------------------------------------------*/
+
+void sh34_base_device::sh4drc_add_pcflush(offs_t address)
+{
+	if (!allow_drc()) return;
+
+	if (m_pcfsel < ARRAY_LENGTH(m_pcflushes))
+		m_pcflushes[m_pcfsel++] = address;
+}
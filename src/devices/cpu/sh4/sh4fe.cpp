@@ -0,0 +1,480 @@
+// license:BSD-3-Clause
+// copyright-holders:R. Belmont
+/***************************************************************************
+
+    sh4fe.c
+
+    Front end for SH-3/SH-4 recompiler
+
+    Most of the instruction set is shared with the SH-2, so only the
+    groups the SH-4 decodes differently are described here.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sh4.h"
+#include "sh4comn.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+sh4_frontend::sh4_frontend(sh34_base_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: sh2_frontend(*device, window_start, window_end, max_sequence)
+	, m_sh4(device)
+	, m_testing(false)
+	, m_test_opcode(0)
+{
+}
+
+/*-------------------------------------------------
+    read_opcode - fetch the opcode described by
+    desc, or the test opcode when validating
+-------------------------------------------------*/
+
+UINT16 sh4_frontend::read_opcode(const opcode_desc &desc)
+{
+	if (m_testing)
+		return m_test_opcode;
+	return m_sh4->m_direct->read_word(desc.physpc, m_sh4->m_code_xor);
+}
+
+/*-------------------------------------------------
+    describe_test - describe an opcode that isn't
+    in memory, the same way describe_code would
+-------------------------------------------------*/
+
+bool sh4_frontend::describe_test(opcode_desc &desc, offs_t pc, UINT16 opcode)
+{
+	desc.m_next = nullptr;
+	desc.branch = nullptr;
+	desc.delay.reset();
+	desc.pc = pc;
+	desc.physpc = pc;
+	desc.targetpc = BRANCH_TARGET_DYNAMIC;
+	memset(&desc.opptr, 0x00, sizeof(desc.opptr));
+	desc.length = 0;
+	desc.delayslots = 0;
+	desc.skipslots = 0;
+	desc.flags = 0;
+	desc.cycles = 0;
+	memset(desc.regin, 0x00, sizeof(desc.regin));
+	memset(desc.regout, 0x00, sizeof(desc.regout));
+	memset(desc.regreq, 0x00, sizeof(desc.regreq));
+
+	m_testing = true;
+	m_test_opcode = opcode;
+	bool result = describe(desc, nullptr);
+	m_testing = false;
+	return result;
+}
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction, with the SH-4's cycle counts
+-------------------------------------------------*/
+
+bool sh4_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	/* the privileged areas mirror the physical space below the P4 area */
+	if (desc.pc < 0xe0000000)
+		desc.physpc = desc.pc & AM;
+
+	if (!sh2_frontend::describe(desc, prev))
+		return false;
+
+	/* patch up the handful of timings that differ from the SH-2 */
+	UINT16 opcode = desc.opptr.w[0];
+	switch (opcode >> 12)
+	{
+		case 2:
+			if ((opcode & 14) == 14)    // MULU, MULS
+				desc.cycles = 1;
+			break;
+
+		case 8:
+			if (opcode & (1 << 8))      // BT, BF, BTS, BFS
+				desc.cycles = 1;
+			break;
+
+		case 12:
+			switch (opcode & (15 << 8))
+			{
+			case 11 << 8: // ORI
+			case 12 << 8: // TSTM
+			case 13 << 8: // ANDM
+			case 14 << 8: // XORM
+				desc.cycles = 3;
+				break;
+			}
+			break;
+	}
+
+	return true;
+}
+
+bool sh4_frontend::describe_group_0(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x00: // NOP();
+	case 0x01: // NOP();
+		return true;
+
+	case 0x02:
+		switch (opcode & 0xf0)
+		{
+		case 0x00: // STCSR(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x10: // STCGBR(Rn);
+			desc.regin[1] |= REGFLAG_GBR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x20: // STCVBR(Rn);
+			desc.regin[1] |= REGFLAG_VBR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x50: // NOP();
+		case 0x60: // NOP();
+		case 0x70: // NOP();
+			return true;
+		}
+
+		// STCSSR, STCSPC, STCRBANK
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x03:
+		switch (opcode & 0xf0)
+		{
+		case 0x00: // BSRF(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x20: // BRAF(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x80: // PREFM(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+
+		case 0xc0: // MOVCAL(Rn);
+			desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			return true;
+		}
+		return true;    // NOP, TODO
+
+	case 0x04: // MOVBS0(Rm, Rn);
+	case 0x05: // MOVWS0(Rm, Rn);
+	case 0x06: // MOVLS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x07: // MULL(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(Rm);
+		desc.regout[1] |= REGFLAG_MACL;
+		desc.cycles = 2;
+		return true;
+
+	case 0x08:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // CLRT();
+		case 0x10: // SETT();
+		case 0x40: // CLRS();
+		case 0x50: // SETS();
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x20: // CLRMAC();
+			desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+			return true;
+		}
+		return true;    // NOP, LDTLB
+
+	case 0x09:
+		switch (opcode & 0x30)
+		{
+		case 0x10: // DIV0U();
+			desc.regout[1] |= REGFLAG_SR;
+			return true;
+
+		case 0x20: // MOVT(Rn);
+			desc.regin[1] |= REGFLAG_SR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+		return true;    // NOP
+
+	case 0x0a:
+		switch (opcode & 0x70)
+		{
+		case 0x00: // STSMACH(Rn);
+			desc.regin[1] |= REGFLAG_MACH;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x10: // STSMACL(Rn);
+			desc.regin[1] |= REGFLAG_MACL;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x20: // STSPR(Rn);
+			desc.regin[1] |= REGFLAG_PR;
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0x40: // NOP();
+			return true;
+		}
+
+		// STCSGR, STSFPUL, STSFPSCR, STCDBR
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x0b:
+		switch (opcode & 0x30)
+		{
+		case 0x00: // RTS();
+			desc.regin[1] |= REGFLAG_PR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+
+		case 0x10: // SLEEP();
+			// the interpreter loops on SLEEP until an exception, so treat it as a branch
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.cycles = 3;
+			return true;
+
+		case 0x20: // RTE();
+			desc.regout[1] |= REGFLAG_SR;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_EXPOSE_EXTERNAL_INT;
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.delayslots = 1;
+			desc.cycles = 2;
+			return true;
+		}
+		return true;    // NOP
+
+	case 0x0c: // MOVBL0(Rm, Rn);
+	case 0x0d: // MOVWL0(Rm, Rn);
+	case 0x0e: // MOVLL0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x0f: // MAC_L(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[1] |= REGFLAG_MACL | REGFLAG_MACH;
+		desc.flags |= OPFLAG_READS_MEMORY;
+		desc.cycles = 3;
+		return true;
+	}
+
+	return false;
+}
+
+bool sh4_frontend::describe_group_4(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	/* the SH-4 decodes all eight bits of the system register transfers */
+	switch (opcode & 0xff)
+	{
+	case 0x32: // STCMSGR(Rn);
+	case 0x33: // STCMSSR(Rn);
+	case 0x43: // STCMSPC(Rn);
+	case 0x52: // STSMFPUL(Rn);
+	case 0x62: // STSMFPSCR(Rn);
+	case 0xf2: // STCMDBR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x37: // LDCMSSR(Rn);
+	case 0x47: // LDCMSPC(Rn);
+	case 0x56: // LDSMFPUL(Rn);
+	case 0xf6: // LDCMDBR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x3e: // LDCSSR(Rn);
+	case 0x4e: // LDCSPC(Rn);
+	case 0x5a: // LDSFPUL(Rn);
+	case 0xfa: // LDCDBR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		return true;
+
+	case 0x66: // LDSMFPSCR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_READS_MEMORY | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+		return true;
+
+	case 0x6a: // LDSFPSCR(Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+		return true;
+	}
+
+	switch (opcode & 0x0f)
+	{
+	case 0x03: // STCMRBANK(Rm_BANK, Rn);
+		if (opcode & 0x80)
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_WRITES_MEMORY;
+			desc.cycles = 2;
+			return true;
+		}
+		break;
+
+	case 0x07: // LDCMRBANK(Rn, Rm_BANK);
+		if (opcode & 0x80)
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			desc.flags |= OPFLAG_READS_MEMORY;
+			return true;
+		}
+		break;
+
+	case 0x0e: // LDCRBANK(Rn, Rm_BANK);
+		if (opcode & 0x80)
+		{
+			desc.regin[0] |= REGFLAG_R(Rn);
+			return true;
+		}
+		break;
+
+	case 0x0c: // SHAD(Rm, Rn);
+	case 0x0d: // SHLD(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		return true;
+	}
+
+	/* the rest of the upper rows of these columns are no-ops */
+	switch (opcode & 0x0f)
+	{
+	case 0x02:
+	case 0x03:
+	case 0x06:
+	case 0x07:
+	case 0x0a:
+	case 0x0e:
+		if (opcode & 0xc0)
+			return true;
+		break;
+	}
+
+	/* everything else decodes like the SH-2 */
+	if (!sh2_frontend::describe_group_4(desc, prev, opcode))
+		return false;
+
+	switch (opcode & 0x3f)
+	{
+	case 0x0b: // JSR(Rn);
+	case 0x13: // STCMGBR(Rn);
+	case 0x23: // STCMVBR(Rn);
+		desc.cycles = 2;
+		break;
+
+	case 0x17: // LDCMGBR(Rn);
+	case 0x27: // LDCMVBR(Rn);
+		desc.cycles = 3;
+		break;
+	}
+	return true;
+}
+
+bool sh4_frontend::describe_group_15(opcode_desc &desc, const opcode_desc *prev, UINT16 opcode)
+{
+	switch (opcode & 0x0f)
+	{
+	case 0x06: // FMOVS0FR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x08: // FMOVMRFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x09: // FMOVMRIFR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rm);
+		desc.regout[0] |= REGFLAG_R(Rm);
+		desc.flags |= OPFLAG_READS_MEMORY;
+		return true;
+
+	case 0x07: // FMOVFRS0(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn) | REGFLAG_R(0);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x0a: // FMOVFRMR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x0b: // FMOVFRMDR(Rm, Rn);
+		desc.regin[0] |= REGFLAG_R(Rn);
+		desc.regout[0] |= REGFLAG_R(Rn);
+		desc.flags |= OPFLAG_WRITES_MEMORY;
+		return true;
+
+	case 0x04: // FCMP_EQ(Rm, Rn);
+	case 0x05: // FCMP_GT(Rm, Rn);
+		desc.regout[1] |= REGFLAG_SR;
+		return true;
+
+	case 0x0d:
+		switch (opcode & 0xf0)
+		{
+		case 0x00: // FSTS(Rn);
+			desc.regout[0] |= REGFLAG_R(Rn);
+			return true;
+
+		case 0xf0:
+			if (opcode == 0xf3fd) // FSCHG();
+			{
+				desc.flags |= OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES;
+				return true;
+			}
+			break;
+		}
+		return true;
+	}
+
+	// FADD, FSUB, FMUL, FDIV, FMOVFR, FMAC
+	return true;
+}
@@ -428,7 +428,7 @@ void uml::instruction::simplify()
 				if (m_param[2].is_immediate_value(paramsizemask[m_param[3].size()]))
 				{
 					m_opcode = OP_READ;
-					m_numparams = 2;
+					m_numparams = 3;
 					m_param[2] = m_param[3];
 				}
 				break;
@@ -438,7 +438,7 @@ void uml::instruction::simplify()
 				if (m_param[2].is_immediate_value(paramsizemask[m_param[3].size()]))
 				{
 					m_opcode = OP_WRITE;
-					m_numparams = 2;
+					m_numparams = 3;
 					m_param[2] = m_param[3];
 				}
 				break;
@@ -543,9 +543,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() * (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() * (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() * (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() * (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -558,10 +558,11 @@ void uml::instruction::simplify()
 						convert_to_mov_immediate(0);
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
+						// the low half of a product is the same signed or unsigned
 						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() * (INT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() * (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() * (INT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() * (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -575,9 +576,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() / (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() / (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() / (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() / (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -591,9 +592,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() / (INT32)m_param[2].immediate()));
+							convert_to_mov_immediate((INT32)((INT32)m_param[2].immediate() / (INT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() / (INT64)m_param[2].immediate()));
+							convert_to_mov_immediate((INT64)((INT64)m_param[2].immediate() / (INT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -731,6 +732,12 @@ void uml::instruction::simplify()
 					nop();
 				break;
 
+			// FCMP: no-op if no flags needed
+			case OP_FCMP:
+				if (m_flags == 0)
+					nop();
+				break;
+
 			default:
 				break;
 		}
@@ -847,6 +854,69 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if a parameter
+//  is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_IN) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if a parameter
+//  is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	return (s_opcode_info_table[m_opcode].param[paramnum].output & PIO_OUT) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_allows - return true if a parameter may
+//  be encoded with the given type; raw pointers
+//  (LOAD/STORE bases, CALLC and SAVE arguments)
+//  are not memory operands
+//-------------------------------------------------
+
+bool uml::instruction::param_allows(int paramnum, parameter::parameter_type type) const
+{
+	assert(paramnum < m_numparams);
+	UINT16 typemask = s_opcode_info_table[m_opcode].param[paramnum].typemask;
+	if (type == parameter::PTYPE_MEMORY && (typemask & (PTYPES_PTR | PTYPES_STATE) & ~PTYPES_MEM) != 0)
+		return false;
+	return (typemask & (1 << type)) != 0;
+}
+
+
+//-------------------------------------------------
+//  param_size - return the size in bytes of a
+//  parameter's value
+//-------------------------------------------------
+
+int uml::instruction::param_size(int paramnum) const
+{
+	assert(paramnum < m_numparams);
+	switch (s_opcode_info_table[m_opcode].param[paramnum].size)
+	{
+		case PSIZE_4:   return 4;
+		case PSIZE_8:   return 8;
+		case PSIZE_P1:  return 1 << m_param[0].size();
+		case PSIZE_P2:  return 1 << m_param[1].size();
+		case PSIZE_P3:  return 1 << m_param[2].size();
+		case PSIZE_P4:  return 1 << m_param[3].size();
+		default:
+		case PSIZE_OP:  return m_size;
+	}
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
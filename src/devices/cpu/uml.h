@@ -22,6 +22,7 @@
 
 // opaque structure describing UML generation state
 class drcuml_state;
+class drcbe_validator;
 
 struct drcuml_machine_state;
 
@@ -190,13 +191,15 @@ namespace uml
 		OP_XOR,                     // XOR     dst,src1,src2[,f]
 		OP_LZCNT,                   // LZCNT   dst,src
 		OP_BSWAP,                   // BSWAP   dst,src
+		// shifts and rotates take the count modulo the size in bits, then set S and Z from
+		// the result and C from the last bit shifted out; a count of zero changes no flags
 		OP_SHL,                     // SHL     dst,src,count[,f]
 		OP_SHR,                     // SHR     dst,src,count[,f]
 		OP_SAR,                     // SAR     dst,src,count[,f]
 		OP_ROL,                     // ROL     dst,src,count[,f]
 		OP_ROLC,                    // ROLC    dst,src,count[,f]
-		OP_ROR,                     // ROL     dst,src,count[,f]
-		OP_RORC,                    // ROLC    dst,src,count[,f]
+		OP_ROR,                     // ROR     dst,src,count[,f]
+		OP_RORC,                    // RORC    dst,src,count[,f]
 
 		// floating point operations
 		OP_FLOAD,                   // FLOAD   dst,base,index
@@ -394,6 +397,8 @@ namespace uml
 	// a single UML instructon is encoded like this
 	class instruction
 	{
+		friend class ::drcbe_validator;
+
 	public:
 		// construction/destruction
 		instruction();
@@ -409,6 +414,7 @@ namespace uml
 		// setters
 		void set_flags(UINT8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, UINT32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, const parameter &param) { assert(paramnum < m_numparams); m_param[paramnum] = param; }
 
 		// misc
 		std::string disasm(drcuml_state *drcuml = nullptr) const;
@@ -417,6 +423,12 @@ namespace uml
 		UINT8 modified_flags() const;
 		void simplify();
 
+		// parameter encoding rules, for the optimizer
+		bool param_is_input(int paramnum) const;
+		bool param_is_output(int paramnum) const;
+		bool param_allows(int paramnum, parameter::parameter_type type) const;
+		int param_size(int paramnum) const;
+
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
 		void hash(UINT32 mode, UINT32 pc) { configure(OP_HASH, 4, mode, pc); }
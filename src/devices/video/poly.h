@@ -133,6 +133,7 @@ public:
 
 	// synchronization
 	void wait(const char *debug_reason = "general");
+	bool work_is_inline() const { return m_queue != nullptr && osd_work_queue_threads(m_queue) == 0; }
 
 	// object data allocators
 	_ObjectData &object_data_alloc();
@@ -143,10 +143,12 @@ bits(7:4) and bit(24)), X, and Y:
 
 
 #include "emu.h"
+#include "emuopts.h"
 
 #include "video/rgbutil.h"
 #include "voodoo.h"
 #include "vooddefs.h"
+#include "voodoo_jit.h"
 
 
 /*************************************
@@ -162,7 +164,6 @@ bits(7:4) and bit(24)), X, and Y:
 #define LOG_FIFO            (0)
 #define LOG_FIFO_VERBOSE    (0)
 #define LOG_REGISTERS       (0)
-#define LOG_WAITS           (0)
 #define LOG_LFB             (0)
 #define LOG_TEXTURE_RAM     (0)
 #define LOG_RASTERIZERS     (0)
@@ -2407,21 +2408,21 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* mask off invalid bits for different cards */
 		case fbzColorPath:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x0fffffff;
 			if (chips & 1) vd->reg[fbzColorPath].u = data;
 			break;
 
 		case fbzMode:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x001fffff;
 			if (chips & 1) vd->reg[fbzMode].u = data;
 			break;
 
 		case fogMode:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x0000003f;
 			if (chips & 1) vd->reg[fogMode].u = data;
@@ -2450,7 +2451,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* other commands */
 		case nopCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (data & 1)
 				reset_counters(vd);
 			if (data & 2)
@@ -2462,12 +2463,12 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 			break;
 
 		case swapbufferCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			cycles = swapbuffer(vd, data);
 			break;
 
 		case userIntrCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			//fatalerror("userIntrCMD\n");
 
 			vd->reg[intrCtrl].u |= 0x1800;
@@ -2482,7 +2483,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case clutData:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				if (!FBIINIT1_VIDEO_TIMING_RESET(vd->reg[fbiInit1].u))
 				{
 					int index = data >> 24;
@@ -2501,7 +2502,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case dacData:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				if (!(data & 0x800))
 					dacdata_w(&vd->dac, (data >> 8) & 7, data & 0xff);
 				else
@@ -2516,7 +2517,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case videoDimensions:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				if (vd->reg[hSync].u != 0 && vd->reg[vSync].u != 0 && vd->reg[videoDimensions].u != 0)
 				{
@@ -2605,7 +2606,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* fbiInit0 can only be written if initEnable says we can -- Voodoo/Voodoo2 only */
 		case fbiInit0:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[fbiInit0].u = data;
@@ -2629,7 +2630,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case fbiInit1:
 		case fbiInit2:
 		case fbiInit4:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[regnum].u = data;
@@ -2639,7 +2640,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 			break;
 
 		case fbiInit3:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[regnum].u = data;
@@ -2653,7 +2654,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 /*      case swapPending: -- Banshee */
 			if (vd->vd_type == TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				vd->fbi.cmdfifo[0].enable = FBIINIT7_CMDFIFO_ENABLE(data);
 				vd->fbi.cmdfifo[0].count_holes = !FBIINIT7_DISABLE_CMDFIFO_HOLES(data);
@@ -2666,7 +2667,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case cmdFifoBaseAddr:
 			if (vd->vd_type == TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				vd->fbi.cmdfifo[0].base = (data & 0x3ff) << 12;
 				vd->fbi.cmdfifo[0].end = (((data >> 16) & 0x3ff) + 1) << 12;
@@ -2742,7 +2743,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case nccTable+9:
 		case nccTable+10:
 		case nccTable+11:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&vd->tmu[0].ncc[0], regnum - nccTable, data);
 			if (chips & 4) ncc_table_write(&vd->tmu[1].ncc[0], regnum - nccTable, data);
 			break;
@@ -2759,7 +2760,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case nccTable+21:
 		case nccTable+22:
 		case nccTable+23:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&vd->tmu[0].ncc[1], regnum - (nccTable+12), data);
 			if (chips & 4) ncc_table_write(&vd->tmu[1].ncc[1], regnum - (nccTable+12), data);
 			break;
@@ -2797,7 +2798,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case fogTable+29:
 		case fogTable+30:
 		case fogTable+31:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 1)
 			{
 				int base = 2 * (regnum - fogTable);
@@ -2816,7 +2817,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case texBaseAddr_1:
 		case texBaseAddr_2:
 		case texBaseAddr_3_8:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2)
 			{
 				vd->tmu[0].reg[regnum].u = data;
@@ -2845,7 +2846,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case color0:
 		case clipLowYHighY:
 		case clipLeftRight:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			/* fall through to default implementation */
 
 		/* by default, just feed the data to the chips */
@@ -3173,7 +3174,7 @@ INT32 voodoo_device::lfb_w(voodoo_device* vd, offs_t offset, UINT32 data, UINT32
 		COMPUTE_DITHER_POINTERS_NO_DITHER_VAR(vd->reg[fbzMode].u, y);
 
 		/* wait for any outstanding work to finish */
-		poly_wait(vd->poly, "LFB Write");
+		vd->poly->wait("LFB Write");
 
 		/* loop over up to two pixels */
 		for (pix = 0; mask; pix++)
@@ -3328,7 +3329,7 @@ INT32 voodoo_device::lfb_w(voodoo_device* vd, offs_t offset, UINT32 data, UINT32
 
 
 				/* wait for any outstanding work to finish */
-				poly_wait(vd->poly, "LFB Write");
+				vd->poly->wait("LFB Write");
 
 				/* pixel pipeline part 2 handles color combine, fog, alpha, and final output */
 				PIXEL_PIPELINE_END(vd, stats, dither, dither4, dither_lookup, x, dest, depth,
@@ -3369,7 +3370,7 @@ INT32 voodoo_device::texture_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		fatalerror("Texture direct write!\n");
 
 	/* wait for any outstanding work to finish */
-	poly_wait(vd->poly, "Texture write");
+	vd->poly->wait("Texture write");
 
 	/* update texture info if dirty */
 	if (t->regdirty)
@@ -4023,7 +4024,7 @@ static UINT32 lfb_r(voodoo_device *vd, offs_t offset, bool lfb_3d)
 	}
 
 	/* wait for any outstanding work to finish */
-	poly_wait(vd->poly, "LFB read");
+	vd->poly->wait("LFB read");
 
 	/* compute the data */
 	data = buffer[bufoffs + 0] | (buffer[bufoffs + 1] << 16);
@@ -4939,7 +4940,7 @@ void voodoo_device::common_start_voodoo(UINT8 type)
 	device->m_stall.resolve();
 
 	/* create a multiprocessor work queue */
-	poly = poly_alloc(machine(), 64, sizeof(poly_extra_data), 0);
+	poly = std::make_unique<voodoo_renderer>(machine());
 	thread_stats = auto_alloc_array(machine(), stats_block, WORK_MAX_THREADS);
 
 	/* create a table of precomputed 1/n and log2(n) values */
@@ -4971,6 +4972,11 @@ void voodoo_device::common_start_voodoo(UINT8 type)
 		}
 	}
 
+	/* create the rasterizer compilers, one per work queue thread */
+	if (machine().options().voodoo_jit() != 0)
+		for (int threadid = 0; threadid < WORK_MAX_THREADS; threadid++)
+			jit.push_back(std::make_unique<voodoo_jit>(*this, threadid, dither4_lookup, dither2_lookup, machine().options().voodoo_jit() == 2));
+
 	tmu_config = 0x11;   // revision 1
 
 	/* configure type-specific values */
@@ -5120,7 +5126,7 @@ INT32 voodoo_device::fastfill(voodoo_device *vd)
 	int ex = (vd->reg[clipLeftRight].u >> 0) & 0x3ff;
 	int sy = (vd->reg[clipLowYHighY].u >> 16) & 0x3ff;
 	int ey = (vd->reg[clipLowYHighY].u >> 0) & 0x3ff;
-	poly_extent extents[64];
+	voodoo_renderer::extent_t extents[64];
 	UINT16 dithermatrix[16];
 	UINT16 *drawbuf = nullptr;
 	UINT32 pixels = 0;
@@ -5167,6 +5173,7 @@ INT32 voodoo_device::fastfill(voodoo_device *vd)
 	}
 
 	/* fill in a block of extents */
+	memset(&extents[0], 0, sizeof(extents[0]));
 	extents[0].startx = sx;
 	extents[0].stopx = ex;
 	for (extnum = 1; extnum < ARRAY_LENGTH(extents); extnum++)
@@ -5175,13 +5182,13 @@ INT32 voodoo_device::fastfill(voodoo_device *vd)
 	/* iterate over blocks of extents */
 	for (y = sy; y < ey; y += ARRAY_LENGTH(extents))
 	{
-		poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(vd->poly);
+		poly_extra_data &extra = vd->poly->object_data_alloc();
 		int count = MIN(ey - y, ARRAY_LENGTH(extents));
 
-		extra->device= vd;
-		memcpy(extra->dither, dithermatrix, sizeof(extra->dither));
+		extra.destbase = drawbuf;
+		memcpy(extra.dither, dithermatrix, sizeof(extra.dither));
 
-		pixels += poly_render_triangle_custom(vd->poly, drawbuf, global_cliprect, raster_fastfill, y, count, extents);
+		pixels += vd->poly->render_triangle_custom(global_cliprect, voodoo_renderer::render_delegate(raster_fastfill, "raster_fastfill", vd), y, count, extents);
 	}
 
 	/* 2 pixels per clock */
@@ -5269,7 +5276,7 @@ INT32 voodoo_device::triangle(voodoo_device *vd)
 	}
 
 	/* wait for any outstanding work to finish */
-//  poly_wait(vd->poly, "triangle");
+//  vd->poly->wait("triangle");
 
 	/* determine the draw buffer */
 	destbuf = (vd->vd_type >= TYPE_VOODOO_BANSHEE) ? 1 : FBZMODE_DRAW_BUFFER(vd->reg[fbzMode].u);
@@ -5516,10 +5523,10 @@ INT32 voodoo_device::setup_and_draw_triangle(voodoo_device *vd)
 
 INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbuf, int texcount)
 {
-	poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(vd->poly);
+	poly_extra_data *extra = &vd->poly->object_data_alloc();
 
 	raster_info *info = find_rasterizer(vd, texcount);
-	poly_vertex vert[3];
+	voodoo_renderer::vertex_t vert[3];
 
 	/* fill in the vertex data */
 	vert[0].x = (float)vd->fbi.ax * (1.0f / 16.0f);
@@ -5530,8 +5537,8 @@ INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbu
 	vert[2].y = (float)vd->fbi.cy * (1.0f / 16.0f);
 
 	/* fill in the extra data */
-	extra->device = vd;
 	extra->info = info;
+	extra->destbase = drawbuf;
 
 	/* fill in triangle parameters */
 	extra->ax = vd->fbi.ax;
@@ -5589,7 +5596,7 @@ INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbu
 
 	/* farm the rasterization out to other threads */
 	info->polys++;
-	return poly_render_triangle(vd->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+	return vd->poly->render_triangle(global_cliprect, voodoo_renderer::render_delegate(info->callback, "voodoo_raster", vd), 0, vert[0], vert[1], vert[2]);
 }
 
 
@@ -5676,8 +5683,11 @@ raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, int texcount)
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* generate a new one using the generic entry, or compile one */
+	if (!vd->jit.empty())
+		curinfo.callback = raster_jit;
+	else
+		curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5726,7 +5736,7 @@ void voodoo_device::dump_rasterizer_stats(voodoo_device *vd)
 			best->eff_fbz_mode,
 			best->eff_tex_mode_0,
 			best->eff_tex_mode_1,
-			best->is_generic ? '*' : ' ',
+			best->is_generic ? (vd->jit.empty() ? '*' : 'J') : ' ',
 			best->hash,
 			best->polys,
 			best->hits);
@@ -5779,7 +5789,26 @@ void voodoo_device::device_stop()
 {
 	/* release the work queue, ensuring all work is finished */
 	if (poly != nullptr)
-		poly_free(poly);
+	{
+		poly->wait("device_stop");
+		poly = nullptr;
+	}
+
+	/* report how the compiled rasterizers did */
+	if (!jit.empty())
+	{
+		UINT32 hits = 0, misses = 0, fallbacks = 0, mismatches = 0, flushes = 0;
+		for (auto &compiler : jit)
+		{
+			hits += compiler->hits();
+			misses += compiler->misses();
+			fallbacks += compiler->fallbacks();
+			mismatches += compiler->mismatches();
+			flushes += compiler->flushes();
+		}
+		osd_printf_verbose("%s: compiled rasterizers drew %d spans, compiled %d times, fell back %d times, mismatched %d times, flushed the cache %d times\n", tag(), hits + misses, misses, fallbacks, mismatches, flushes);
+		jit.clear();
+	}
 }
 
 
@@ -5866,13 +5895,11 @@ void voodoo_3_device::device_start()
     implementation of the 'fastfill' command
 -------------------------------------------------*/
 
-void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid)
+void voodoo_device::raster_fastfill(voodoo_device *vd, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
-	voodoo_device* vd = extra->device;
 	stats_block *stats = &vd->thread_stats[threadid];
-	INT32 startx = extent->startx;
-	INT32 stopx = extent->stopx;
+	INT32 startx = extent.startx;
+	INT32 stopx = extent.stopx;
 	int scry, x;
 
 	/* determine the screen Y */
@@ -5883,9 +5910,9 @@ void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *
 	/* fill this RGB row */
 	if (FBZMODE_RGB_BUFFER_MASK(vd->reg[fbzMode].u))
 	{
-		const UINT16 *ditherow = &extra->dither[(y & 3) * 4];
+		const UINT16 *ditherow = &extra.dither[(y & 3) * 4];
 		UINT64 expanded = *(UINT64 *)ditherow;
-		UINT16 *dest = (UINT16 *)destbase + scry * vd->fbi.rowpixels;
+		UINT16 *dest = extra.destbase + scry * vd->fbi.rowpixels;
 
 		for (x = startx; x < stopx && (x & 3) != 0; x++)
 			dest[x] = ditherow[x & 3];
@@ -5935,3 +5962,18 @@ RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg
 
 RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
 			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+
+/*-------------------------------------------------
+    raster_jit - hand a span whose mode
+    combination isn't precompiled to this thread's
+    rasterizer compiler
+-------------------------------------------------*/
+
+void voodoo_device::raster_jit(voodoo_device *vd, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra, int threadid)
+{
+	raster_info &info = *extra.info;
+	voodoo_raster_func generic = (info.eff_tex_mode_0 == 0xffffffff) ? raster_generic_0tmu : (info.eff_tex_mode_1 == 0xffffffff) ? raster_generic_1tmu : raster_generic_2tmu;
+
+	vd->jit[threadid]->rasterize(info, generic, y, extent, extra);
+}
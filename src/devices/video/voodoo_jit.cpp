@@ -0,0 +1,1941 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    voodoo_jit.cpp
+
+    UML-compiled scanline rasterizers for the 3dfx Voodoo family.
+
+****************************************************************************
+
+    The precompiled rasterizers in voodoo_rast.inc only cover the mode
+    combinations that were common in the games tested when the table was
+    built; everything else goes through the generic rasterizers, which
+    re-examine every mode bit for every pixel. When -voodoo_jit is on,
+    those combinations are compiled instead: the first time a raster_info
+    from the generic path is drawn on a thread, a scanline function is
+    generated with all of its mode bits resolved, using the same UML
+    back-ends as the CPU recompilers. It is keyed on the raster_info's
+    slot in the rasterizer hash, so the compiled code lives exactly as
+    long as the entry it was built for.
+
+    Each work queue thread owns a compiler, a code cache and the span
+    state the generated code works on, so nothing is shared between
+    threads. Per span, the C++ side does the same clipping and iterator
+    setup as the RASTERIZER macro and snapshots the handful of registers
+    the pipeline reads; the generated code then walks the span with
+    everything else resolved.
+
+    Register usage in the generated code:
+        I4 = X coordinate
+        I0-I3, I5-I7 = temporaries
+        F0-F1 = W reciprocal
+
+***************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "cpu/drcumlsh.h"
+#include "voodoo_jit.h"
+
+using namespace uml;
+
+
+/*************************************
+ *
+ *  Constants
+ *
+ *************************************/
+
+#define CACHE_SIZE              (2 * 1024 * 1024)
+#define MAX_INSTRUCTIONS        8192
+#define MAX_REPORTED_MISMATCHES 10
+
+/* the same table new_log2() uses */
+static const INT32 log2_table[16] = { 0, 22, 44, 63, 82, 100, 118, 134, 150, 165, 179, 193, 207, 220, 232, 244 };
+
+
+
+/*************************************
+ *
+ *  Construction/destruction
+ *
+ *************************************/
+
+voodoo_jit::voodoo_jit(voodoo_device &vd, int threadid, const UINT8 *dither4_lookup, const UINT8 *dither2_lookup, bool verify)
+	: m_vd(vd),
+		m_threadid(threadid),
+		m_dither4_lookup(dither4_lookup),
+		m_dither2_lookup(dither2_lookup),
+		m_verify(verify),
+		m_cache(CACHE_SIZE),
+		m_drcuml(std::make_unique<drcuml_state>(vd, m_cache, 0, 1, 32, 0, vd.machine().options().drc_use_c() ? DRCBE_C : DRCBE_NATIVE)),
+		m_state(*(jit_state *)m_cache.alloc_near(sizeof(jit_state))),
+		m_labelnum(1),
+		m_hits(0),
+		m_misses(0),
+		m_fallbacks(0),
+		m_mismatches(0),
+		m_flushes(0)
+{
+	memset(&m_state, 0, sizeof(m_state));
+	m_state.recipnum = double(1ULL << (47-39));
+	memset(m_handle, 0, sizeof(m_handle));
+
+	/* generate the back-end's own entry and exit code */
+	m_drcuml->reset();
+}
+
+
+voodoo_jit::~voodoo_jit()
+{
+}
+
+
+
+/*************************************
+ *
+ *  Span drawing
+ *
+ *************************************/
+
+void voodoo_jit::rasterize(raster_info &info, voodoo_raster_func generic, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra)
+{
+	int index = &info - &m_vd.rasterizer[0];
+	int texcount = (info.eff_tex_mode_0 == 0xffffffff) ? 0 : (info.eff_tex_mode_1 == 0xffffffff) ? 1 : 2;
+
+	/* the generic rasterizers always index the aux buffer, even when they */
+	/* don't use it; leave the odd cases where it's missing to them */
+	bool eligible = (m_vd.fbi.auxoffs != ~0 && (m_vd.fbi.auxoffs & 1) == 0);
+	for (int tmu = 0; tmu < texcount; tmu++)
+		if (m_vd.tmu[tmu].lookup == nullptr)
+			eligible = false;
+	if (!eligible)
+	{
+		m_fallbacks++;
+		(*generic)(&m_vd, y, extent, extra, m_threadid);
+		return;
+	}
+
+	/* compile on first use */
+	uml::code_handle *handle = m_handle[index];
+	if (handle == nullptr || handle->codeptr() == nullptr)
+	{
+		handle = compile(info, index);
+		m_misses++;
+	}
+	else
+		m_hits++;
+
+	if (m_verify)
+		verify(info, generic, *handle, y, extent, extra);
+	else if (prepare(info, y, extent, extra))
+	{
+		m_drcuml->execute(*handle);
+		finish(m_vd.thread_stats[m_threadid]);
+	}
+}
+
+
+/*-------------------------------------------------
+    prepare - clip the span and fill in the span
+    state; returns false if nothing is left to
+    draw
+-------------------------------------------------*/
+
+bool voodoo_jit::prepare(raster_info &info, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra)
+{
+	voodoo_device &vd = m_vd;
+	stats_block *stats = &vd.thread_stats[m_threadid];
+	jit_state &s = m_state;
+	UINT32 fbzmode = info.eff_fbz_mode;
+	INT32 startx = extent.startx;
+	INT32 stopx = extent.stopx;
+	INT32 scry, dx, dy;
+
+	/* determine the screen Y */
+	scry = y;
+	if (FBZMODE_Y_ORIGIN(fbzmode))
+		scry = (vd.fbi.yorigin - y) & 0x3ff;
+
+	/* apply clipping */
+	if (FBZMODE_ENABLE_CLIPPING(fbzmode))
+	{
+		INT32 tempclip;
+
+		/* Y clipping buys us the whole scanline */
+		if (scry < ((vd.reg[clipLowYHighY].u >> 16) & 0x3ff) ||
+			scry >= (vd.reg[clipLowYHighY].u & 0x3ff))
+		{
+			stats->pixels_in += stopx - startx;
+			stats->clip_fail += stopx - startx;
+			return false;
+		}
+
+		/* X clipping */
+		tempclip = (vd.reg[clipLeftRight].u >> 16) & 0x3ff;
+		if (startx < tempclip)
+		{
+			stats->pixels_in += tempclip - startx;
+			vd.stats.total_clipped += tempclip - startx;
+			startx = tempclip;
+		}
+		tempclip = vd.reg[clipLeftRight].u & 0x3ff;
+		if (stopx >= tempclip)
+		{
+			stats->pixels_in += stopx - tempclip;
+			vd.stats.total_clipped += stopx - tempclip;
+			stopx = tempclip - 1;
+		}
+	}
+	s.startx = startx;
+	s.stopx = stopx;
+
+	/* the target and depth rows, as UINT16 indexes into frame buffer RAM */
+	s.destidx = (extra.destbase + scry * vd.fbi.rowpixels) - (UINT16 *)vd.fbi.ram;
+	s.depthidx = vd.fbi.auxoffs / 2 + scry * vd.fbi.rowpixels;
+	s.ditherrow = (y & 3) << 11;
+	s.dithermatrix = (y & 3) * 4;
+	s.stipplerow = (y & 3) << 3;
+
+	/* compute the starting parameters */
+	dx = startx - (extra.ax >> 4);
+	dy = y - (extra.ay >> 4);
+	s.iterargb[0] = extra.starta + dy * extra.dady + dx * extra.dadx;
+	s.iterargb[1] = extra.startr + dy * extra.drdy + dx * extra.drdx;
+	s.iterargb[2] = extra.startg + dy * extra.dgdy + dx * extra.dgdx;
+	s.iterargb[3] = extra.startb + dy * extra.dbdy + dx * extra.dbdx;
+	s.dargb[0] = extra.dadx;
+	s.dargb[1] = extra.drdx;
+	s.dargb[2] = extra.dgdx;
+	s.dargb[3] = extra.dbdx;
+	s.iterz = extra.startz + dy * extra.dzdy + dx * extra.dzdx;
+	s.dzdx = extra.dzdx;
+	s.iterw = extra.startw + dy * extra.dwdy + dx * extra.dwdx;
+	s.dwdx = extra.dwdx;
+
+	/* snapshot the TMUs */
+	for (int which = 0; which < 2; which++)
+	{
+		const tmu_state &t = vd.tmu[which];
+		tmu_params &p = s.tmu[which];
+
+		if (which == 0 ? (info.eff_tex_mode_0 == 0xffffffff) : (info.eff_tex_mode_1 == 0xffffffff))
+			break;
+
+		p.lodmin = t.lodmin;
+		p.lodmax = t.lodmax;
+		p.lodbias = t.lodbias;
+		p.lodmask = t.lodmask;
+		memcpy(p.lodoffset, t.lodoffset, sizeof(p.lodoffset));
+		p.detailmax = t.detailmax;
+		p.detailbias = t.detailbias;
+		p.detailscale = t.detailscale;
+		p.wmask = t.wmask;
+		p.hmask = t.hmask;
+		p.bilinear_mask = t.bilinear_mask;
+		p.mask = t.mask;
+
+		/* every lookup table lives inside the device */
+		p.lookup = ((UINT8 *)t.lookup - (UINT8 *)&vd) / sizeof(rgb_t);
+
+		if (which == 0)
+		{
+			p.lodbase = extra.lodbase0;
+			p.iters = extra.starts0 + dy * extra.ds0dy + dx * extra.ds0dx;
+			p.itert = extra.startt0 + dy * extra.dt0dy + dx * extra.dt0dx;
+			p.iterw = extra.startw0 + dy * extra.dw0dy + dx * extra.dw0dx;
+			p.dsdx = extra.ds0dx;
+			p.dtdx = extra.dt0dx;
+			p.dwdx = extra.dw0dx;
+		}
+		else
+		{
+			p.lodbase = extra.lodbase1;
+			p.iters = extra.starts1 + dy * extra.ds1dy + dx * extra.ds1dx;
+			p.itert = extra.startt1 + dy * extra.dt1dy + dx * extra.dt1dx;
+			p.iterw = extra.startw1 + dy * extra.dw1dy + dx * extra.dw1dx;
+			p.dsdx = extra.ds1dx;
+			p.dtdx = extra.dt1dx;
+			p.dwdx = extra.dw1dx;
+		}
+	}
+
+	/* snapshot the registers the pipeline reads */
+	s.stipplebits = vd.reg[stipple].u;
+	s.zabias = (INT16)vd.reg[zaColor].u;
+	s.zaconst = (UINT16)vd.reg[zaColor].u;
+	s.chromakey = vd.reg[chromaKey].u;
+	s.chromarange = vd.reg[chromaRange].u;
+	s.alpharef = vd.reg[alphaMode].rgb.a;
+	s.const0[0] = vd.reg[color0].rgb.a;
+	s.const0[1] = vd.reg[color0].rgb.r;
+	s.const0[2] = vd.reg[color0].rgb.g;
+	s.const0[3] = vd.reg[color0].rgb.b;
+	s.const1[0] = vd.reg[color1].rgb.a;
+	s.const1[1] = vd.reg[color1].rgb.r;
+	s.const1[2] = vd.reg[color1].rgb.g;
+	s.const1[3] = vd.reg[color1].rgb.b;
+	s.fogcolor[0] = vd.reg[fogColor].rgb.a;
+	s.fogcolor[1] = vd.reg[fogColor].rgb.r;
+	s.fogcolor[2] = vd.reg[fogColor].rgb.g;
+	s.fogcolor[3] = vd.reg[fogColor].rgb.b;
+	s.fogdelta_mask = vd.fbi.fogdelta_mask;
+	s.send_config = vd.send_config;
+	s.tmu_config[0] = (vd.tmu_config >> 24) & 0xff;
+	s.tmu_config[1] = (vd.tmu_config >> 16) & 0xff;
+	s.tmu_config[2] = (vd.tmu_config >> 8) & 0xff;
+	s.tmu_config[3] = vd.tmu_config & 0xff;
+
+	/* reset the span statistics */
+	s.pixels_in = s.pixels_out = 0;
+	s.chroma_fail = s.zfunc_fail = s.afunc_fail = 0;
+	s.stippled = 0;
+
+	info.hits++;
+	return true;
+}
+
+
+/*-------------------------------------------------
+    finish - fold the span results back into the
+    device
+-------------------------------------------------*/
+
+void voodoo_jit::finish(stats_block &stats)
+{
+	jit_state &s = m_state;
+
+	m_vd.reg[stipple].u = s.stipplebits;
+	m_vd.stats.total_stippled += s.stippled;
+	stats.pixels_in += s.pixels_in;
+	stats.pixels_out += s.pixels_out;
+	stats.chroma_fail += s.chroma_fail;
+	stats.zfunc_fail += s.zfunc_fail;
+	stats.afunc_fail += s.afunc_fail;
+}
+
+
+/*-------------------------------------------------
+    verify - draw the span with the generic
+    rasterizer and the compiled one from the same
+    starting state and compare what they leave
+    behind; the generic result is kept
+-------------------------------------------------*/
+
+void voodoo_jit::verify(raster_info &info, voodoo_raster_func generic, uml::code_handle &handle, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra)
+{
+	voodoo_device &vd = m_vd;
+	stats_block &stats = vd.thread_stats[m_threadid];
+	INT32 count = extent.stopx - extent.startx;
+	INT32 scry = y;
+
+	if (count <= 0)
+	{
+		(*generic)(&vd, y, extent, extra, m_threadid);
+		return;
+	}
+
+	/* find the rows the span can touch */
+	if (FBZMODE_Y_ORIGIN(info.eff_fbz_mode))
+		scry = (vd.fbi.yorigin - y) & 0x3ff;
+	UINT16 *dest = extra.destbase + scry * vd.fbi.rowpixels + extent.startx;
+	UINT16 *depth = (UINT16 *)(vd.fbi.ram + vd.fbi.auxoffs) + scry * vd.fbi.rowpixels + extent.startx;
+
+	/* snapshot everything */
+	m_saved.resize(count * 2);
+	m_expected.resize(count * 2);
+	memcpy(&m_saved[0], dest, count * sizeof(UINT16));
+	memcpy(&m_saved[count], depth, count * sizeof(UINT16));
+	stats_block savedstats = stats;
+	UINT32 savedstipple = vd.reg[stipple].u;
+	INT32 savedclipped = vd.stats.total_clipped;
+	INT32 savedstippled = vd.stats.total_stippled;
+	UINT32 savedhits = info.hits;
+
+	/* draw with the generic rasterizer and remember the result */
+	(*generic)(&vd, y, extent, extra, m_threadid);
+	memcpy(&m_expected[0], dest, count * sizeof(UINT16));
+	memcpy(&m_expected[count], depth, count * sizeof(UINT16));
+	stats_block expectedstats = stats;
+	UINT32 expectedstipple = vd.reg[stipple].u;
+	INT32 expectedclipped = vd.stats.total_clipped;
+	INT32 expectedstippled = vd.stats.total_stippled;
+
+	/* put everything back and draw with the compiled code */
+	memcpy(dest, &m_saved[0], count * sizeof(UINT16));
+	memcpy(depth, &m_saved[count], count * sizeof(UINT16));
+	stats = savedstats;
+	vd.reg[stipple].u = savedstipple;
+	vd.stats.total_clipped = savedclipped;
+	vd.stats.total_stippled = savedstippled;
+	if (prepare(info, y, extent, extra))
+	{
+		m_drcuml->execute(handle);
+		finish(stats);
+	}
+	info.hits = savedhits + 1;
+
+	/* compare */
+	int badx = -1;
+	for (int x = 0; x < count && badx == -1; x++)
+		if (dest[x] != m_expected[x] || depth[x] != m_expected[count + x])
+			badx = extent.startx + x;
+	if (badx == -1 && (memcmp(&stats, &expectedstats, sizeof(stats)) != 0 || vd.reg[stipple].u != expectedstipple ||
+			vd.stats.total_clipped != expectedclipped || vd.stats.total_stippled != expectedstippled))
+		badx = extent.startx;
+	if (badx == -1)
+		return;
+
+	/* report the first few, and keep the generic result */
+	if (m_mismatches++ < MAX_REPORTED_MISMATCHES)
+		osd_printf_warning("%s: compiled rasterizer %08X %08X %08X %08X %08X %08X differs from the generic one at %d,%d\n",
+				vd.tag(), info.eff_color_path, info.eff_alpha_mode, info.eff_fog_mode, info.eff_fbz_mode,
+				info.eff_tex_mode_0, info.eff_tex_mode_1, badx, y);
+	memcpy(dest, &m_expected[0], count * sizeof(UINT16));
+	memcpy(depth, &m_expected[count], count * sizeof(UINT16));
+	stats = expectedstats;
+	vd.reg[stipple].u = expectedstipple;
+	vd.stats.total_clipped = expectedclipped;
+	vd.stats.total_stippled = expectedstippled;
+}
+
+
+/*-------------------------------------------------
+    chroma_range_test - the range form of the
+    chroma key test, called from generated code
+-------------------------------------------------*/
+
+void voodoo_jit::chroma_range_test(void *param)
+{
+	jit_state &s = *(jit_state *)param;
+	int results;
+
+	/* check blue */
+	results = (s.other[3] >= (s.chromakey & 0xff) && s.other[3] <= (s.chromarange & 0xff));
+	results ^= CHROMARANGE_BLUE_EXCLUSIVE(s.chromarange);
+	results <<= 1;
+
+	/* check green */
+	results |= (s.other[2] >= ((s.chromakey >> 8) & 0xff) && s.other[2] <= ((s.chromarange >> 8) & 0xff));
+	results ^= CHROMARANGE_GREEN_EXCLUSIVE(s.chromarange);
+	results <<= 1;
+
+	/* check red */
+	results |= (s.other[1] >= ((s.chromakey >> 16) & 0xff) && s.other[1] <= ((s.chromarange >> 16) & 0xff));
+	results ^= CHROMARANGE_RED_EXCLUSIVE(s.chromarange);
+
+	/* final result */
+	if (CHROMARANGE_UNION_MODE(s.chromarange))
+		s.chroma_result = (results != 0);
+	else
+		s.chroma_result = (results == 7);
+}
+
+
+
+/*************************************
+ *
+ *  Code generation
+ *
+ *************************************/
+
+/*-------------------------------------------------
+    compile - generate the code for a rasterizer,
+    flushing the cache if it has filled up
+-------------------------------------------------*/
+
+uml::code_handle *voodoo_jit::compile(raster_info &info, int index)
+{
+	if (m_handle[index] == nullptr)
+		m_handle[index] = m_drcuml->handle_alloc(string_format("raster%d", index).c_str());
+
+	for (int attempt = 0; attempt < 2; attempt++)
+	{
+		try
+		{
+			drcuml_block *block = m_drcuml->begin_block(MAX_INSTRUCTIONS);
+			generate(block, info, *m_handle[index]);
+			block->end();
+			return m_handle[index];
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			/* everything else goes too; it will be rebuilt as it's drawn */
+			m_drcuml->reset();
+			m_flushes++;
+		}
+	}
+	fatalerror("%s: unable to compile rasterizer %d\n", m_vd.tag(), index);
+}
+
+
+/*-------------------------------------------------
+    generate - generate the scanline loop for one
+    raster_info
+-------------------------------------------------*/
+
+void voodoo_jit::generate(drcuml_block *block, raster_info &info, uml::code_handle &handle)
+{
+	jit_state &s = m_state;
+	UINT32 fbzcp = info.eff_color_path;
+	UINT32 fbzmode = info.eff_fbz_mode;
+	UINT32 alphamode = info.eff_alpha_mode;
+	UINT32 fogmode = info.eff_fog_mode;
+	int texcount = (info.eff_tex_mode_0 == 0xffffffff) ? 0 : (info.eff_tex_mode_1 == 0xffffffff) ? 1 : 2;
+
+	/* work out which intermediate values anything downstream reads */
+	bool fogtable = FOGMODE_ENABLE_FOG(fogmode) && !FOGMODE_FOG_CONSTANT(fogmode) && FOGMODE_FOG_ZALPHA(fogmode) == 0;
+	bool need_wfloat = fogtable || (FBZMODE_WBUFFER_SELECT(fbzmode) && !FBZMODE_DEPTH_FLOAT_SELECT(fbzmode));
+	bool need_depth = (FBZMODE_ENABLE_DEPTHBUF(fbzmode) && FBZMODE_DEPTH_SOURCE_COMPARE(fbzmode) == 0) ||
+						(FBZMODE_AUX_BUFFER_MASK(fbzmode) && !FBZMODE_ENABLE_ALPHA_PLANES(fbzmode));
+	bool need_prefog = ALPHAMODE_ALPHABLEND(alphamode) && ALPHAMODE_DSTRGBBLEND(alphamode) == 15;
+
+	m_labelnum = 1;
+	code_label loop = newlabel();
+	code_label done = newlabel();
+	code_label stippled = newlabel();
+	m_skip = newlabel();
+	m_zfail = newlabel();
+	m_afail = newlabel();
+	m_chromafail = newlabel();
+
+	UML_HANDLE(block, handle);
+	UML_MOV(block, I4, mem(&s.startx));
+	UML_CMP(block, I4, mem(&s.stopx));
+	UML_JMPc(block, COND_GE, done);
+	UML_LABEL(block, loop);
+
+	/* pixel pipeline part 1: stippling, W and depth */
+	UML_ADD(block, mem(&s.pixels_in), mem(&s.pixels_in), 1);
+	for (int c = 0; c < 4; c++)
+		UML_MOV(block, mem(&s.texel[c]), 0);
+
+	if (FBZMODE_ENABLE_STIPPLE(fbzmode))
+	{
+		if (FBZMODE_STIPPLE_PATTERN(fbzmode) == 0)
+		{
+			/* rotate mode */
+			UML_ROL(block, mem(&s.stipplebits), mem(&s.stipplebits), 1);
+			UML_TEST(block, mem(&s.stipplebits), 0x80000000);
+			UML_JMPc(block, COND_Z, stippled);
+		}
+		else
+		{
+			/* pattern mode: bit ((y & 3) << 3) | (~x & 7) */
+			UML_AND(block, I0, I4, 7);
+			UML_XOR(block, I0, I0, 7);
+			UML_OR(block, I0, I0, mem(&s.stipplerow));
+			UML_SHR(block, I1, mem(&s.stipplebits), I0);
+			UML_TEST(block, I1, 1);
+			UML_JMPc(block, COND_Z, stippled);
+		}
+	}
+
+	if (need_wfloat)
+	{
+		generate_float_depth(block, true);
+		UML_MOV(block, mem(&s.wfloat), I0);
+		if (fogtable)
+		{
+			if (FBZMODE_ENABLE_DEPTH_BIAS(fbzmode))
+			{
+				UML_ADD(block, I0, I0, mem(&s.zabias));
+				UML_CMP(block, I0, 0);
+				UML_MOVc(block, COND_L, I0, 0);
+				UML_CMP(block, I0, 0xffff);
+				UML_MOVc(block, COND_G, I0, 0xffff);
+			}
+			UML_MOV(block, mem(&s.fogdepth), I0);
+		}
+	}
+
+	if (need_depth)
+	{
+		if (FBZMODE_WBUFFER_SELECT(fbzmode) == 0)
+			generate_clamped_z(block, I0, fbzcp);
+		else if (FBZMODE_DEPTH_FLOAT_SELECT(fbzmode) == 0)
+			UML_MOV(block, I0, mem(&s.wfloat));
+		else
+			generate_float_depth(block, false);
+		if (FBZMODE_ENABLE_DEPTH_BIAS(fbzmode))
+		{
+			UML_ADD(block, I0, I0, mem(&s.zabias));
+			UML_CMP(block, I0, 0);
+			UML_MOVc(block, COND_L, I0, 0);
+			UML_CMP(block, I0, 0xffff);
+			UML_MOVc(block, COND_G, I0, 0xffff);
+		}
+		UML_MOV(block, mem(&s.biasdepth), I0);
+	}
+
+	/* depth testing */
+	if (FBZMODE_ENABLE_DEPTHBUF(fbzmode))
+	{
+		UML_MOV(block, I0, mem(FBZMODE_DEPTH_SOURCE_COMPARE(fbzmode) == 0 ? &s.biasdepth : &s.zaconst));
+		UML_ADD(block, I1, I4, mem(&s.depthidx));
+		UML_LOAD(block, I1, m_vd.fbi.ram, I1, SIZE_WORD, SCALE_x2);
+		UML_CMP(block, I0, I1);
+		switch (FBZMODE_DEPTH_FUNCTION(fbzmode))
+		{
+			case 0:     /* depthOP = never */
+				UML_JMP(block, m_zfail);
+				break;
+			case 1:     /* depthOP = less than */
+				UML_JMPc(block, COND_GE, m_zfail);
+				break;
+			case 2:     /* depthOP = equal */
+				UML_JMPc(block, COND_NE, m_zfail);
+				break;
+			case 3:     /* depthOP = less than or equal */
+				UML_JMPc(block, COND_G, m_zfail);
+				break;
+			case 4:     /* depthOP = greater than */
+				UML_JMPc(block, COND_LE, m_zfail);
+				break;
+			case 5:     /* depthOP = not equal */
+				UML_JMPc(block, COND_E, m_zfail);
+				break;
+			case 6:     /* depthOP = greater than or equal */
+				UML_JMPc(block, COND_L, m_zfail);
+				break;
+			case 7:     /* depthOP = always */
+				break;
+		}
+	}
+
+	/* run the texture pipeline on TMU1; a LOD min of 8 disables a TMU */
+	if (texcount >= 2)
+	{
+		code_label skip = newlabel();
+
+		UML_CMP(block, mem(&s.tmu[1].lodmin), 8 << 8);
+		UML_JMPc(block, COND_GE, skip);
+		generate_texture(block, 1, info.eff_tex_mode_1);
+		for (int c = 0; c < 4; c++)
+			UML_MOV(block, mem(&s.other[c]), 0);
+		generate_combine_texture(block, 1, info.eff_tex_mode_1);
+		UML_LABEL(block, skip);
+	}
+
+	/* and on TMU0, combining with the result of TMU1 */
+	if (texcount >= 1)
+	{
+		code_label skip = newlabel();
+		code_label config = newlabel();
+
+		UML_CMP(block, mem(&s.tmu[0].lodmin), 8 << 8);
+		UML_JMPc(block, COND_GE, skip);
+		UML_TEST(block, mem(&s.send_config), ~0);
+		UML_JMPc(block, COND_NZ, config);
+		generate_texture(block, 0, info.eff_tex_mode_0);
+		for (int c = 0; c < 4; c++)
+			UML_MOV(block, mem(&s.other[c]), mem(&s.texel[c]));
+		generate_combine_texture(block, 0, info.eff_tex_mode_0);
+		UML_JMP(block, skip);
+
+		UML_LABEL(block, config);
+		for (int c = 0; c < 4; c++)
+			UML_MOV(block, mem(&s.texel[c]), mem(&s.tmu_config[c]));
+		UML_LABEL(block, skip);
+	}
+
+	/* colorpath pipeline: clamp the iterated color, then combine */
+	for (int c = 0; c < 4; c++)
+	{
+		UML_SHR(block, I0, mem(&s.iterargb[c]), 12);
+		if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+		{
+			UML_AND(block, I0, I0, 0xfff);
+			UML_CMP(block, I0, 0xfff);
+			UML_MOVc(block, COND_E, I0, 0);
+		}
+		UML_CMP(block, I0, 0xff);
+		UML_MOVc(block, COND_A, I0, 0xff);
+		UML_MOV(block, mem(&s.color[c]), I0);
+	}
+	generate_combine_color(block, fbzcp, fbzmode, alphamode);
+
+	/* pixel pipeline part 2: fog, alpha blending and output */
+	if (need_prefog)
+		for (int c = 0; c < 4; c++)
+			UML_MOV(block, mem(&s.prefog[c]), mem(&s.color[c]));
+	generate_fog(block, fogmode, fbzcp, fbzmode);
+	generate_alpha_blend(block, alphamode, fbzmode);
+	generate_write(block, fbzmode);
+	UML_ADD(block, mem(&s.pixels_out), mem(&s.pixels_out), 1);
+
+	/* update the iterated parameters */
+	UML_LABEL(block, m_skip);
+	for (int c = 0; c < 4; c++)
+		UML_ADD(block, mem(&s.iterargb[c]), mem(&s.iterargb[c]), mem(&s.dargb[c]));
+	UML_ADD(block, mem(&s.iterz), mem(&s.iterz), mem(&s.dzdx));
+	UML_DADD(block, mem(&s.iterw), mem(&s.iterw), mem(&s.dwdx));
+	for (int which = 0; which < texcount; which++)
+	{
+		tmu_params &t = s.tmu[which];
+		UML_DADD(block, mem(&t.iterw), mem(&t.iterw), mem(&t.dwdx));
+		UML_DADD(block, mem(&t.iters), mem(&t.iters), mem(&t.dsdx));
+		UML_DADD(block, mem(&t.itert), mem(&t.itert), mem(&t.dtdx));
+	}
+	UML_ADD(block, I4, I4, 1);
+	UML_CMP(block, I4, mem(&s.stopx));
+	UML_JMPc(block, COND_L, loop);
+	UML_LABEL(block, done);
+	UML_EXIT(block, 0);
+
+	/* out of line: count the rejected pixels */
+	UML_LABEL(block, stippled);
+	UML_ADD(block, mem(&s.stippled), mem(&s.stippled), 1);
+	UML_JMP(block, m_skip);
+	UML_LABEL(block, m_zfail);
+	UML_ADD(block, mem(&s.zfunc_fail), mem(&s.zfunc_fail), 1);
+	UML_JMP(block, m_skip);
+	UML_LABEL(block, m_afail);
+	UML_ADD(block, mem(&s.afunc_fail), mem(&s.afunc_fail), 1);
+	UML_JMP(block, m_skip);
+	UML_LABEL(block, m_chromafail);
+	UML_ADD(block, mem(&s.chroma_fail), mem(&s.chroma_fail), 1);
+	UML_JMP(block, m_skip);
+}
+
+
+/*-------------------------------------------------
+    generate_clamped_z - CLAMPED_Z into a register
+-------------------------------------------------*/
+
+void voodoo_jit::generate_clamped_z(drcuml_block *block, uml::parameter dst, UINT32 fbzcp)
+{
+	UML_MOV(block, dst, mem(&m_state.iterz));
+	UML_SAR(block, dst, dst, 12);
+	if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+	{
+		UML_AND(block, dst, dst, 0xfffff);
+		UML_CMP(block, dst, 0xfffff);
+		UML_MOVc(block, COND_E, dst, 0);
+		UML_CMP(block, dst, 0x10000);
+		UML_MOVc(block, COND_E, dst, 0xffff);
+		UML_AND(block, dst, dst, 0xffff);
+	}
+	else
+	{
+		UML_CMP(block, dst, 0);
+		UML_MOVc(block, COND_L, dst, 0);
+		UML_CMP(block, dst, 0xffff);
+		UML_MOVc(block, COND_G, dst, 0xffff);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_clamped_w - CLAMPED_W into a register
+-------------------------------------------------*/
+
+void voodoo_jit::generate_clamped_w(drcuml_block *block, uml::parameter dst, UINT32 fbzcp)
+{
+	UML_DSAR(block, dst, mem(&m_state.iterw), 32);
+	UML_SEXT(block, dst, dst, SIZE_WORD);
+	if (FBZCP_RGBZW_CLAMP(fbzcp) == 0)
+	{
+		UML_AND(block, dst, dst, 0xffff);
+		UML_CMP(block, dst, 0xffff);
+		UML_MOVc(block, COND_E, dst, 0);
+		UML_CMP(block, dst, 0x100);
+		UML_MOVc(block, COND_E, dst, 0xff);
+		UML_AND(block, dst, dst, 0xff);
+	}
+	else
+	{
+		UML_CMP(block, dst, 0);
+		UML_MOVc(block, COND_L, dst, 0);
+		UML_CMP(block, dst, 0xff);
+		UML_MOVc(block, COND_G, dst, 0xff);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_float_depth - the 4.12 "floating
+    point" form of W, or of Z when wsource is
+    false, into I0
+-------------------------------------------------*/
+
+void voodoo_jit::generate_float_depth(drcuml_block *block, bool wsource)
+{
+	code_label zero = newlabel();
+	code_label allones = newlabel();
+	code_label done = newlabel();
+
+	if (wsource)
+	{
+		/* anything in bits 32-47 of W gives 0 */
+		UML_DSHR(block, I0, mem(&m_state.iterw), 32);
+		UML_TEST(block, I0, 0xffff);
+		UML_JMPc(block, COND_NZ, zero);
+		UML_DMOV(block, I1, mem(&m_state.iterw));
+	}
+	else
+	{
+		/* anything in the top 4 bits of Z gives 0 */
+		UML_MOV(block, I1, mem(&m_state.iterz));
+		UML_TEST(block, I1, 0xf0000000);
+		UML_JMPc(block, COND_NZ, zero);
+		UML_SHL(block, I1, I1, 4);
+	}
+
+	/* ((exp << 12) | ((~temp >> (19 - exp)) & 0xfff)) + 1 */
+	UML_TEST(block, I1, 0xffff0000);
+	UML_JMPc(block, COND_Z, allones);
+	UML_LZCNT(block, I2, I1);
+	UML_XOR(block, I3, I1, 0xffffffff);
+	UML_MOV(block, I0, 19);
+	UML_SUB(block, I0, I0, I2);
+	UML_SHR(block, I3, I3, I0);
+	UML_AND(block, I3, I3, 0xfff);
+	UML_SHL(block, I2, I2, 12);
+	UML_OR(block, I0, I2, I3);
+	UML_ADD(block, I0, I0, 1);
+	UML_JMP(block, done);
+
+	UML_LABEL(block, allones);
+	UML_MOV(block, I0, 0xffff);
+	UML_JMP(block, done);
+
+	UML_LABEL(block, zero);
+	UML_MOV(block, I0, 0);
+	UML_LABEL(block, done);
+}
+
+
+/*-------------------------------------------------
+    generate_texture - genTexture for one TMU,
+    leaving the texel in local and the LOD in lod
+-------------------------------------------------*/
+
+void voodoo_jit::generate_texture(drcuml_block *block, int which, UINT32 texmode)
+{
+	jit_state &s = m_state;
+	tmu_params &t = s.tmu[which];
+	bool fmt8 = (TEXMODE_FORMAT(texmode) < 8);
+
+	/* determine the S/T/LOD values for this texture */
+	UML_MOV(block, mem(&s.lod), mem(&t.lodbase));
+	if (TEXMODE_ENABLE_PERSPECTIVE(texmode))
+	{
+		/* multi_reciplog: recip = 2^8 / W; s = S * recip; t = T * recip */
+		UML_FDFRINT(block, F0, mem(&t.iterw), SIZE_QWORD);
+		UML_FDDIV(block, F0, mem(&s.recipnum), F0);
+		UML_FDFRINT(block, F1, mem(&t.iters), SIZE_QWORD);
+		UML_FDMUL(block, F1, F1, F0);
+		UML_FDTOINT(block, I0, F1, SIZE_DWORD, ROUND_TRUNC);
+		UML_MOV(block, mem(&s.s), I0);
+		UML_FDFRINT(block, F1, mem(&t.itert), SIZE_QWORD);
+		UML_FDMUL(block, F1, F1, F0);
+		UML_FDTOINT(block, I0, F1, SIZE_DWORD, ROUND_TRUNC);
+		UML_MOV(block, mem(&s.t), I0);
+
+		/* new_log2 of the reciprocal, straight from its exponent and mantissa */
+		UML_ICOPYFD(block, I0, F0);
+		UML_DSHR(block, I1, I0, 52);
+		UML_SUB(block, I1, I1, 1023+32);
+		UML_SHL(block, I1, I1, 8);
+		UML_DSHR(block, I2, I0, 48);
+		UML_AND(block, I2, I2, 0xf);
+		UML_LOAD(block, I2, log2_table, I2, SIZE_DWORD, SCALE_x4);
+		UML_ADD(block, I1, I1, I2);
+		UML_DCMP(block, I0, 0);
+		UML_MOVc(block, COND_L, I1, 0);
+		UML_ADD(block, I1, I1, 56 << 8);
+		UML_ADD(block, mem(&s.lod), mem(&s.lod), I1);
+	}
+	else
+	{
+		UML_DSAR(block, I0, mem(&t.iters), 14+10);
+		UML_MOV(block, mem(&s.s), I0);
+		UML_DSAR(block, I0, mem(&t.itert), 14+10);
+		UML_MOV(block, mem(&s.t), I0);
+	}
+
+	/* clamp W */
+	if (TEXMODE_CLAMP_NEG_W(texmode))
+	{
+		code_label positive = newlabel();
+
+		UML_DCMP(block, mem(&t.iterw), 0);
+		UML_JMPc(block, COND_GE, positive);
+		UML_MOV(block, mem(&s.s), 0);
+		UML_MOV(block, mem(&s.t), 0);
+		UML_LABEL(block, positive);
+	}
+
+	/* clamp the LOD */
+	{
+		code_label setmin = newlabel();
+		code_label clamped = newlabel();
+
+		UML_ADD(block, I0, mem(&s.lod), mem(&t.lodbias));
+		if (TEXMODE_ENABLE_LOD_DITHER(texmode))
+		{
+			UML_AND(block, I1, I4, 3);
+			UML_ADD(block, I1, I1, mem(&s.dithermatrix));
+			UML_LOAD(block, I1, dither_matrix_4x4, I1, SIZE_BYTE, SCALE_x1);
+			UML_SHL(block, I1, I1, 4);
+			UML_ADD(block, I0, I0, I1);
+		}
+		UML_CMP(block, I0, mem(&t.lodmin));
+		UML_JMPc(block, COND_L, setmin);
+		UML_CMP(block, I0, mem(&t.lodmax));
+		UML_MOVc(block, COND_G, I0, mem(&t.lodmax));
+		UML_JMP(block, clamped);
+		UML_LABEL(block, setmin);
+		UML_MOV(block, I0, mem(&t.lodmin));
+		UML_LABEL(block, clamped);
+		UML_MOV(block, mem(&s.lod), I0);
+	}
+
+	/* if we don't own this LOD, take the next one */
+	UML_SAR(block, I1, I0, 8);
+	UML_SHR(block, I2, mem(&t.lodmask), I1);
+	UML_AND(block, I2, I2, 1);
+	UML_XOR(block, I2, I2, 1);
+	UML_ADD(block, I1, I1, I2);
+
+	/* texture base in I3, maximum s and t at this LOD in I5 and I6 */
+	UML_LOAD(block, I3, t.lodoffset, I1, SIZE_DWORD, SCALE_x4);
+	UML_SHR(block, I5, mem(&t.wmask), I1);
+	UML_SHR(block, I6, mem(&t.hmask), I1);
+
+	/* determine whether we are point-sampled or bilinear */
+	code_label bilinear = newlabel();
+	code_label done = newlabel();
+	bool magfilter = TEXMODE_MAGNIFICATION_FILTER(texmode);
+	bool minfilter = TEXMODE_MINIFICATION_FILTER(texmode);
+	if (magfilter != minfilter)
+	{
+		UML_CMP(block, I0, mem(&t.lodmin));
+		UML_JMPc(block, magfilter ? COND_E : COND_NE, bilinear);
+	}
+
+	if (!magfilter || !minfilter)
+	{
+		/* point sampled: adjust S/T for the LOD and strip off the fractions */
+		UML_ADD(block, I7, I1, 18-10);
+		UML_SAR(block, I0, mem(&s.s), I7);
+		UML_SAR(block, I2, mem(&s.t), I7);
+
+		/* clamp/wrap S/T if necessary */
+		if (TEXMODE_CLAMP_S(texmode))
+		{
+			UML_CMP(block, I0, 0);
+			UML_MOVc(block, COND_L, I0, 0);
+			UML_CMP(block, I0, I5);
+			UML_MOVc(block, COND_G, I0, I5);
+		}
+		if (TEXMODE_CLAMP_T(texmode))
+		{
+			UML_CMP(block, I2, 0);
+			UML_MOVc(block, COND_L, I2, 0);
+			UML_CMP(block, I2, I6);
+			UML_MOVc(block, COND_G, I2, I6);
+		}
+		UML_AND(block, I0, I0, I5);
+		UML_AND(block, I2, I2, I6);
+		UML_ADD(block, I7, I5, 1);
+		UML_MULU(block, I2, I2, I2, I7);
+
+		/* fetch texel data */
+		UML_ADD(block, I0, I0, I2);
+		if (!fmt8)
+			UML_SHL(block, I0, I0, 1);
+		UML_ADD(block, I0, I0, I3);
+		UML_AND(block, I0, I0, mem(&t.mask));
+		generate_texel_fetch(block, which, texmode, I0, I6);
+		split_argb(block, s.local, I6);
+
+		if (magfilter || minfilter)
+			UML_JMP(block, done);
+	}
+
+	if (magfilter || minfilter)
+	{
+		/* bilinear filtered: adjust S/T for the LOD, less half a texel */
+		UML_LABEL(block, bilinear);
+		UML_SAR(block, I0, mem(&s.s), I1);
+		UML_SAR(block, I2, mem(&s.t), I1);
+		UML_SUB(block, I0, I0, 0x80);
+		UML_SUB(block, I2, I2, 0x80);
+
+		/* extract the fractions, then toss them */
+		UML_AND(block, mem(&s.sfrac), I0, mem(&t.bilinear_mask));
+		UML_AND(block, mem(&s.tfrac), I2, mem(&t.bilinear_mask));
+		UML_SAR(block, I0, I0, 8);
+		UML_SAR(block, I2, I2, 8);
+		UML_ADD(block, I7, I0, 1);
+		UML_ADD(block, I1, I2, 1);
+
+		/* clamp/wrap S/T if necessary; s,s1 in I0,I7 and t,t1 in I2,I1 */
+		if (TEXMODE_CLAMP_S(texmode))
+		{
+			code_label inrange = newlabel();
+			code_label sdone = newlabel();
+
+			UML_CMP(block, I0, 0);
+			UML_JMPc(block, COND_GE, inrange);
+			UML_MOV(block, I0, 0);
+			UML_MOV(block, I7, 0);
+			UML_JMP(block, sdone);
+			UML_LABEL(block, inrange);
+			UML_CMP(block, I0, I5);
+			UML_JMPc(block, COND_L, sdone);
+			UML_MOV(block, I0, I5);
+			UML_MOV(block, I7, I5);
+			UML_LABEL(block, sdone);
+		}
+		else
+		{
+			UML_AND(block, I0, I0, I5);
+			UML_AND(block, I7, I7, I5);
+		}
+		if (TEXMODE_CLAMP_T(texmode))
+		{
+			code_label inrange = newlabel();
+			code_label tdone = newlabel();
+
+			UML_CMP(block, I2, 0);
+			UML_JMPc(block, COND_GE, inrange);
+			UML_MOV(block, I2, 0);
+			UML_MOV(block, I1, 0);
+			UML_JMP(block, tdone);
+			UML_LABEL(block, inrange);
+			UML_CMP(block, I2, I6);
+			UML_JMPc(block, COND_L, tdone);
+			UML_MOV(block, I2, I6);
+			UML_MOV(block, I1, I6);
+			UML_LABEL(block, tdone);
+		}
+		else
+		{
+			UML_AND(block, I2, I2, I6);
+			UML_AND(block, I1, I1, I6);
+		}
+		UML_ADD(block, I5, I5, 1);
+		UML_MULU(block, I2, I2, I2, I5);
+		UML_MULU(block, I1, I1, I1, I5);
+
+		/* fetch the four texels; note these aren't masked */
+		for (int index = 0; index < 4; index++)
+		{
+			UML_ADD(block, I5, (index & 2) ? I1 : I2, (index & 1) ? I7 : I0);
+			if (!fmt8)
+				UML_SHL(block, I5, I5, 1);
+			UML_ADD(block, I5, I5, I3);
+			generate_texel_fetch(block, which, texmode, I5, I6);
+			UML_MOV(block, mem(&s.fetch[index]), I6);
+		}
+
+		/* weigh in each texel, per channel:                    */
+		/*   v0 = c00 * (256 - sfrac) + c01 * sfrac               */
+		/*   v1 = c10 * (256 - sfrac) + c11 * sfrac               */
+		/*   result = ((v0 >> 1) * (256 - tfrac) + (v1 >> 1) * tfrac) >> 15 */
+		UML_MOV(block, I5, 256);
+		UML_SUB(block, I5, I5, mem(&s.sfrac));
+		UML_MOV(block, I6, 256);
+		UML_SUB(block, I6, I6, mem(&s.tfrac));
+		for (int c = 0; c < 4; c++)
+		{
+			int rotate = (8 + c * 8) & 31;
+
+			UML_ROLAND(block, I0, mem(&s.fetch[0]), rotate, 0xff);
+			UML_MULU(block, I0, I0, I0, I5);
+			UML_ROLAND(block, I1, mem(&s.fetch[1]), rotate, 0xff);
+			UML_MULU(block, I1, I1, I1, mem(&s.sfrac));
+			UML_ADD(block, I0, I0, I1);
+			UML_ROLAND(block, I1, mem(&s.fetch[2]), rotate, 0xff);
+			UML_MULU(block, I1, I1, I1, I5);
+			UML_ROLAND(block, I2, mem(&s.fetch[3]), rotate, 0xff);
+			UML_MULU(block, I2, I2, I2, mem(&s.sfrac));
+			UML_ADD(block, I1, I1, I2);
+			UML_SHR(block, I0, I0, 1);
+			UML_MULU(block, I0, I0, I0, I6);
+			UML_SHR(block, I1, I1, 1);
+			UML_MULU(block, I1, I1, I1, mem(&s.tfrac));
+			UML_ADD(block, I0, I0, I1);
+			UML_SHR(block, mem(&s.local[c]), I0, 15);
+		}
+	}
+	UML_LABEL(block, done);
+}
+
+
+/*-------------------------------------------------
+    generate_texel_fetch - read the texel at byte
+    offset index of texture RAM and convert it to
+    ARGB in dst; clobbers index
+-------------------------------------------------*/
+
+void voodoo_jit::generate_texel_fetch(drcuml_block *block, int which, UINT32 texmode, uml::parameter index, uml::parameter dst)
+{
+	const tmu_state &tmu = m_vd.tmu[which];
+	tmu_params &t = m_state.tmu[which];
+	UINT32 format = TEXMODE_FORMAT(texmode);
+
+	if (format < 8)
+	{
+		/* 8-bit texels go straight through the lookup */
+		UML_LOAD(block, dst, tmu.ram, index, SIZE_BYTE, SCALE_x1);
+		UML_ADD(block, dst, dst, mem(&t.lookup));
+		UML_LOAD(block, dst, &m_vd, dst, SIZE_DWORD, SCALE_x4);
+	}
+	else if (format >= 10 && format <= 12)
+	{
+		/* so do 16-bit direct color texels */
+		UML_LOAD(block, dst, tmu.ram, index, SIZE_WORD, SCALE_x1);
+		UML_ADD(block, dst, dst, mem(&t.lookup));
+		UML_LOAD(block, dst, &m_vd, dst, SIZE_DWORD, SCALE_x4);
+	}
+	else
+	{
+		/* 8-bit color with 8-bit alpha */
+		UML_LOAD(block, dst, tmu.ram, index, SIZE_WORD, SCALE_x1);
+		UML_AND(block, index, dst, 0xff00);
+		UML_SHL(block, index, index, 16);
+		UML_AND(block, dst, dst, 0xff);
+		UML_ADD(block, dst, dst, mem(&t.lookup));
+		UML_LOAD(block, dst, &m_vd, dst, SIZE_DWORD, SCALE_x4);
+		UML_AND(block, dst, dst, 0xffffff);
+		UML_OR(block, dst, dst, index);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_combine_texture - combineTexture for
+    one TMU, from local and other into texel
+-------------------------------------------------*/
+
+void voodoo_jit::generate_combine_texture(drcuml_block *block, int which, UINT32 texmode)
+{
+	jit_state &s = m_state;
+	tmu_params &t = s.tmu[which];
+	int mselect = TEXMODE_TC_MSELECT(texmode);
+	int aselect = TEXMODE_TCA_MSELECT(texmode);
+
+	UML_MOV(block, mem(&s.aother), mem(&s.other[0]));
+	UML_MOV(block, mem(&s.alocal), mem(&s.local[0]));
+	for (int c = 0; c < 4; c++)
+		UML_MOV(block, mem(&s.addval[c]), mem(&s.local[c]));
+
+	/* select zero/other for RGB and alpha */
+	if (TEXMODE_TC_ZERO_OTHER(texmode))
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.other[c]), 0);
+	if (TEXMODE_TCA_ZERO_OTHER(texmode))
+		UML_MOV(block, mem(&s.other[0]), 0);
+
+	/* potentially subtract c_local */
+	if (TEXMODE_TC_SUB_CLOCAL(texmode))
+		for (int c = 1; c < 4; c++)
+			UML_SUB(block, mem(&s.other[c]), mem(&s.other[c]), mem(&s.local[c]));
+	if (TEXMODE_TCA_SUB_CLOCAL(texmode))
+		UML_SUB(block, mem(&s.other[0]), mem(&s.other[0]), mem(&s.local[0]));
+
+	/* the detail factor, if either blend wants it */
+	if (mselect == 4 || aselect == 4)
+	{
+		code_label zero = newlabel();
+		code_label done = newlabel();
+
+		/* tmp = (((detailbias - lod) << detailscale) >> 8), clamped to detailmax */
+		UML_MOV(block, I0, mem(&t.detailbias));
+		UML_CMP(block, I0, mem(&s.lod));
+		UML_JMPc(block, COND_LE, zero);
+		UML_SUB(block, I0, I0, mem(&s.lod));
+		UML_SHL(block, I0, I0, mem(&t.detailscale));
+		UML_SAR(block, I0, I0, 8);
+		UML_AND(block, I0, I0, 0xff);
+		UML_CMP(block, I0, mem(&t.detailmax));
+		UML_MOVc(block, COND_G, I0, mem(&t.detailmax));
+		UML_AND(block, I0, I0, 0xff);
+		UML_JMP(block, done);
+		UML_LABEL(block, zero);
+		UML_MOV(block, I0, 0);
+		UML_LABEL(block, done);
+	}
+
+	/* blend RGB */
+	switch (mselect)
+	{
+		default:    /* reserved */
+		case 0:     /* zero */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), 0);
+			break;
+
+		case 1:     /* c_local */
+			break;
+
+		case 2:     /* a_other */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.aother));
+			break;
+
+		case 3:     /* a_local */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.alocal));
+			break;
+
+		case 4:     /* LOD (detail factor) */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), I0);
+			break;
+
+		case 5:     /* LOD fraction */
+			UML_AND(block, I1, mem(&s.lod), 0xff);
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), I1);
+			break;
+	}
+
+	/* blend alpha */
+	switch (aselect)
+	{
+		default:    /* reserved */
+		case 0:     /* zero */
+			UML_MOV(block, mem(&s.local[0]), 0);
+			break;
+
+		case 1:     /* c_local */
+		case 3:     /* a_local */
+			break;
+
+		case 2:     /* a_other */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.aother));
+			break;
+
+		case 4:     /* LOD (detail factor) */
+			UML_MOV(block, mem(&s.local[0]), I0);
+			break;
+
+		case 5:     /* LOD fraction */
+			UML_AND(block, mem(&s.local[0]), mem(&s.lod), 0xff);
+			break;
+	}
+
+	/* reverse the RGB and alpha blends */
+	if (!TEXMODE_TC_REVERSE_BLEND(texmode))
+		for (int c = 1; c < 4; c++)
+			UML_XOR(block, mem(&s.local[c]), mem(&s.local[c]), 0xff);
+	if (!TEXMODE_TCA_REVERSE_BLEND(texmode))
+		UML_XOR(block, mem(&s.local[0]), mem(&s.local[0]), 0xff);
+
+	/* add clocal or alocal to RGB, and alocal to alpha */
+	switch (TEXMODE_TC_ADD_ACLOCAL(texmode))
+	{
+		case 3:     /* reserved */
+		case 0:     /* nothing */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.addval[c]), 0);
+			break;
+
+		case 1:     /* add c_local */
+			break;
+
+		case 2:     /* add_alocal */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.addval[c]), mem(&s.alocal));
+			break;
+	}
+	if (!TEXMODE_TCA_ADD_ACLOCAL(texmode))
+		UML_MOV(block, mem(&s.addval[0]), 0);
+
+	/* do the blend and clamp */
+	for (int c = 0; c < 4; c++)
+		UML_ADD(block, mem(&s.local[c]), mem(&s.local[c]), 1);
+	scale_add_clamp(block, s.texel, s.other, s.local, s.addval);
+
+	/* invert */
+	if (TEXMODE_TC_INVERT_OUTPUT(texmode))
+		for (int c = 1; c < 4; c++)
+			UML_XOR(block, mem(&s.texel[c]), mem(&s.texel[c]), 0xff);
+	if (TEXMODE_TCA_INVERT_OUTPUT(texmode))
+		UML_XOR(block, mem(&s.texel[0]), mem(&s.texel[0]), 0xff);
+}
+
+
+/*-------------------------------------------------
+    generate_combine_color - combineColor, from
+    the iterated color in color and the texel in
+    texel, back into color
+-------------------------------------------------*/
+
+void voodoo_jit::generate_combine_color(drcuml_block *block, UINT32 fbzcp, UINT32 fbzmode, UINT32 alphamode)
+{
+	jit_state &s = m_state;
+
+	/* compute c_other */
+	switch (FBZCP_CC_RGBSELECT(fbzcp))
+	{
+		case 0:     /* iterated RGB */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.other[c]), mem(&s.color[c]));
+			break;
+
+		case 1:     /* texture RGB */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.other[c]), mem(&s.texel[c]));
+			break;
+
+		case 2:     /* color1 RGB */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.other[c]), mem(&s.const1[c]));
+			break;
+
+		default:    /* reserved - voodoo3 framebufferRGB */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.other[c]), 0);
+			break;
+	}
+
+	/* handle chroma key */
+	if (FBZMODE_ENABLE_CHROMAKEY(fbzmode))
+	{
+		code_label range = newlabel();
+		code_label done = newlabel();
+
+		UML_TEST(block, mem(&s.chromarange), 1 << 28);
+		UML_JMPc(block, COND_NZ, range);
+
+		/* non-range version */
+		UML_SHL(block, I0, mem(&s.other[1]), 16);
+		UML_SHL(block, I1, mem(&s.other[2]), 8);
+		UML_OR(block, I0, I0, I1);
+		UML_OR(block, I0, I0, mem(&s.other[3]));
+		UML_XOR(block, I0, I0, mem(&s.chromakey));
+		UML_TEST(block, I0, 0xffffff);
+		UML_JMPc(block, COND_Z, m_chromafail);
+		UML_JMP(block, done);
+
+		/* tricky range version */
+		UML_LABEL(block, range);
+		UML_CALLC(block, chroma_range_test, &s);
+		UML_TEST(block, mem(&s.chroma_result), ~0);
+		UML_JMPc(block, COND_NZ, m_chromafail);
+		UML_LABEL(block, done);
+	}
+
+	/* compute a_other */
+	switch (FBZCP_CC_ASELECT(fbzcp))
+	{
+		case 0:     /* iterated alpha */
+			UML_MOV(block, mem(&s.other[0]), mem(&s.color[0]));
+			break;
+
+		case 1:     /* texture alpha */
+			UML_MOV(block, mem(&s.other[0]), mem(&s.texel[0]));
+			break;
+
+		case 2:     /* color1 alpha */
+			UML_MOV(block, mem(&s.other[0]), mem(&s.const1[0]));
+			break;
+
+		default:    /* reserved */
+			UML_MOV(block, mem(&s.other[0]), 0);
+			break;
+	}
+
+	/* handle alpha mask */
+	if (FBZMODE_ENABLE_ALPHA_MASK(fbzmode))
+	{
+		UML_TEST(block, mem(&s.other[0]), 1);
+		UML_JMPc(block, COND_Z, m_afail);
+	}
+
+	/* compute c_local */
+	if (FBZCP_CC_LOCALSELECT_OVERRIDE(fbzcp) == 0)
+	{
+		const INT32 *src = (FBZCP_CC_LOCALSELECT(fbzcp) == 0) ? s.color : s.const0;
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.local[c]), mem(&src[c]));
+	}
+	else
+	{
+		code_label usecolor0 = newlabel();
+		code_label done = newlabel();
+
+		UML_TEST(block, mem(&s.texel[0]), 0x80);
+		UML_JMPc(block, COND_NZ, usecolor0);
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.local[c]), mem(&s.color[c]));
+		UML_JMP(block, done);
+		UML_LABEL(block, usecolor0);
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.local[c]), mem(&s.const0[c]));
+		UML_LABEL(block, done);
+	}
+
+	/* compute a_local */
+	switch (FBZCP_CCA_LOCALSELECT(fbzcp))
+	{
+		default:
+		case 0:     /* iterated alpha */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.color[0]));
+			break;
+
+		case 1:     /* color0 alpha */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.const0[0]));
+			break;
+
+		case 2:     /* clamped iterated Z[27:20] */
+			generate_clamped_z(block, I0, fbzcp);
+			UML_AND(block, mem(&s.local[0]), I0, 0xff);
+			break;
+
+		case 3:     /* clamped iterated W[39:32] */
+			generate_clamped_w(block, I0, fbzcp);
+			UML_AND(block, mem(&s.local[0]), I0, 0xff);
+			break;
+	}
+
+	UML_MOV(block, mem(&s.aother), mem(&s.other[0]));
+	UML_MOV(block, mem(&s.alocal), mem(&s.local[0]));
+	for (int c = 0; c < 4; c++)
+		UML_MOV(block, mem(&s.addval[c]), mem(&s.local[c]));
+
+	/* select zero or c_other, zero or a_other */
+	if (FBZCP_CC_ZERO_OTHER(fbzcp))
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.other[c]), 0);
+	if (FBZCP_CCA_ZERO_OTHER(fbzcp))
+		UML_MOV(block, mem(&s.other[0]), 0);
+
+	/* subtract a/c_local */
+	if (FBZCP_CC_SUB_CLOCAL(fbzcp))
+		for (int c = 1; c < 4; c++)
+			UML_SUB(block, mem(&s.other[c]), mem(&s.other[c]), mem(&s.local[c]));
+	if (FBZCP_CCA_SUB_CLOCAL(fbzcp))
+		UML_SUB(block, mem(&s.other[0]), mem(&s.other[0]), mem(&s.local[0]));
+
+	/* blend RGB */
+	switch (FBZCP_CC_MSELECT(fbzcp))
+	{
+		default:    /* reserved */
+		case 0:     /* 0 */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), 0);
+			break;
+
+		case 1:     /* c_local */
+			break;
+
+		case 2:     /* a_other */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.aother));
+			break;
+
+		case 3:     /* a_local */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.alocal));
+			break;
+
+		case 4:     /* texture alpha */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.texel[0]));
+			break;
+
+		case 5:     /* texture RGB (Voodoo 2 only) */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.local[c]), mem(&s.texel[c]));
+			break;
+	}
+
+	/* blend alpha */
+	switch (FBZCP_CCA_MSELECT(fbzcp))
+	{
+		default:    /* reserved */
+		case 0:     /* 0 */
+			UML_MOV(block, mem(&s.local[0]), 0);
+			break;
+
+		case 1:     /* a_local */
+		case 3:     /* a_local */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.alocal));
+			break;
+
+		case 2:     /* a_other */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.aother));
+			break;
+
+		case 4:     /* texture alpha */
+			UML_MOV(block, mem(&s.local[0]), mem(&s.texel[0]));
+			break;
+	}
+
+	/* reverse the RGB and alpha blends */
+	if (!FBZCP_CC_REVERSE_BLEND(fbzcp))
+		for (int c = 1; c < 4; c++)
+			UML_XOR(block, mem(&s.local[c]), mem(&s.local[c]), 0xff);
+	if (!FBZCP_CCA_REVERSE_BLEND(fbzcp))
+		UML_XOR(block, mem(&s.local[0]), mem(&s.local[0]), 0xff);
+
+	/* add clocal or alocal to RGB, and alocal to alpha */
+	switch (FBZCP_CC_ADD_ACLOCAL(fbzcp))
+	{
+		case 3:     /* reserved */
+		case 0:     /* nothing */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.addval[c]), 0);
+			break;
+
+		case 1:     /* add c_local */
+			break;
+
+		case 2:     /* add_alocal */
+			for (int c = 1; c < 4; c++)
+				UML_MOV(block, mem(&s.addval[c]), mem(&s.alocal));
+			break;
+	}
+	if (!FBZCP_CCA_ADD_ACLOCAL(fbzcp))
+		UML_MOV(block, mem(&s.addval[0]), 0);
+
+	/* do the blend and clamp */
+	for (int c = 0; c < 4; c++)
+		UML_ADD(block, mem(&s.local[c]), mem(&s.local[c]), 1);
+	scale_add_clamp(block, s.color, s.other, s.local, s.addval);
+
+	/* invert */
+	if (FBZCP_CCA_INVERT_OUTPUT(fbzcp))
+		UML_XOR(block, mem(&s.color[0]), mem(&s.color[0]), 0xff);
+	if (FBZCP_CC_INVERT_OUTPUT(fbzcp))
+		for (int c = 1; c < 4; c++)
+			UML_XOR(block, mem(&s.color[c]), mem(&s.color[c]), 0xff);
+
+	/* handle alpha test */
+	if (ALPHAMODE_ALPHATEST(alphamode))
+	{
+		UML_MOV(block, I0, mem(&s.color[0]));
+		UML_CMP(block, I0, mem(&s.alpharef));
+		switch (ALPHAMODE_ALPHAFUNCTION(alphamode))
+		{
+			case 0:     /* alphaOP = never */
+				UML_JMP(block, m_afail);
+				break;
+			case 1:     /* alphaOP = less than */
+				UML_JMPc(block, COND_GE, m_afail);
+				break;
+			case 2:     /* alphaOP = equal */
+				UML_JMPc(block, COND_NE, m_afail);
+				break;
+			case 3:     /* alphaOP = less than or equal */
+				UML_JMPc(block, COND_G, m_afail);
+				break;
+			case 4:     /* alphaOP = greater than */
+				UML_JMPc(block, COND_LE, m_afail);
+				break;
+			case 5:     /* alphaOP = not equal */
+				UML_JMPc(block, COND_E, m_afail);
+				break;
+			case 6:     /* alphaOP = greater than or equal */
+				UML_JMPc(block, COND_L, m_afail);
+				break;
+			case 7:     /* alphaOP = always */
+				break;
+		}
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_fog - applyFogging on color
+-------------------------------------------------*/
+
+void voodoo_jit::generate_fog(drcuml_block *block, UINT32 fogmode, UINT32 fbzcp, UINT32 fbzmode)
+{
+	jit_state &s = m_state;
+
+	if (!FOGMODE_ENABLE_FOG(fogmode))
+		return;
+
+	/* alpha passes through untouched, so only RGB is worked on below */
+
+	/* constant fog bypasses everything else */
+	if (FOGMODE_FOG_CONSTANT(fogmode))
+	{
+		for (int c = 1; c < 4; c++)
+		{
+			if (FOGMODE_FOG_MULT(fogmode) == 0)
+			{
+				/* if fog_mult is 0, we add this to the original color */
+				UML_ADD(block, I0, mem(&s.fogcolor[c]), mem(&s.color[c]));
+				clamp_to_uint8(block, I0);
+				UML_MOV(block, mem(&s.color[c]), I0);
+			}
+			else
+			{
+				/* otherwise this just becomes the new color */
+				UML_MOV(block, mem(&s.color[c]), mem(&s.fogcolor[c]));
+			}
+		}
+		return;
+	}
+
+	/* fog blending mode, into I0 */
+	switch (FOGMODE_FOG_ZALPHA(fogmode))
+	{
+		case 0:     /* fog table */
+		{
+			/* delta = fogdelta[fogdepth >> 10], weighed against the lower 8 bits of wfloat */
+			UML_MOV(block, I1, mem(&s.fogdepth));
+			UML_SHR(block, I2, I1, 10);
+			UML_LOAD(block, I3, m_vd.fbi.fogdelta, I2, SIZE_BYTE, SCALE_x1);
+			UML_LOAD(block, I0, m_vd.fbi.fogblend, I2, SIZE_BYTE, SCALE_x1);
+			UML_AND(block, I5, I3, mem(&s.fogdelta_mask));
+			UML_SAR(block, I1, I1, 2);
+			UML_AND(block, I1, I1, 0xff);
+			UML_MULU(block, I5, I5, I5, I1);
+
+			/* fog zones allow for negating this value */
+			if (FOGMODE_FOG_ZONES(fogmode))
+			{
+				code_label positive = newlabel();
+
+				UML_TEST(block, I3, 2);
+				UML_JMPc(block, COND_Z, positive);
+				UML_MOV(block, I1, 0);
+				UML_SUB(block, I5, I1, I5);
+				UML_LABEL(block, positive);
+			}
+			UML_SAR(block, I5, I5, 6);
+
+			/* apply dither */
+			if (FOGMODE_FOG_DITHER(fogmode))
+			{
+				UML_AND(block, I1, I4, 3);
+				UML_ADD(block, I1, I1, mem(&s.dithermatrix));
+				UML_LOAD(block, I1, dither_matrix_4x4, I1, SIZE_BYTE, SCALE_x1);
+				UML_ADD(block, I5, I5, I1);
+			}
+			UML_SAR(block, I5, I5, 4);
+
+			/* add to the blending factor */
+			UML_ADD(block, I0, I0, I5);
+			break;
+		}
+
+		case 1:     /* iterated A */
+			UML_AND(block, I0, mem(&s.iterargb[0]), 0xff);
+			break;
+
+		case 2:     /* iterated Z */
+			generate_clamped_z(block, I0, fbzcp);
+			UML_SAR(block, I0, I0, 8);
+			break;
+
+		case 3:     /* iterated W - Voodoo 2 only */
+			generate_clamped_w(block, I0, fbzcp);
+			break;
+	}
+	UML_ADD(block, I0, I0, 1);
+
+	for (int c = 1; c < 4; c++)
+	{
+		/* if fog_add is zero, we start with the fog color */
+		if (FOGMODE_FOG_ADD(fogmode))
+			UML_MOV(block, I1, 0);
+		else
+			UML_MOV(block, I1, mem(&s.fogcolor[c]));
+
+		/* if fog_mult is zero, we subtract the incoming color, then add it back after the blend */
+		if (!FOGMODE_FOG_MULT(fogmode))
+			UML_SUB(block, I1, I1, mem(&s.color[c]));
+		UML_MULU(block, I1, I1, I1, I0);
+		UML_SAR(block, I1, I1, 8);
+		if (!FOGMODE_FOG_MULT(fogmode))
+			UML_ADD(block, I1, I1, mem(&s.color[c]));
+		clamp_to_uint8(block, I1);
+		UML_MOV(block, mem(&s.color[c]), I1);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_alpha_blend - alphaBlend on color
+-------------------------------------------------*/
+
+void voodoo_jit::generate_alpha_blend(drcuml_block *block, UINT32 alphamode, UINT32 fbzmode)
+{
+	jit_state &s = m_state;
+
+	if (!ALPHAMODE_ALPHABLEND(alphamode))
+		return;
+
+	/* expand the destination pixel into dest */
+	UML_ADD(block, I0, I4, mem(&s.destidx));
+	UML_LOAD(block, I0, m_vd.fbi.ram, I0, SIZE_WORD, SCALE_x2);
+	UML_SHR(block, I1, I0, 8);
+	UML_AND(block, I1, I1, 0xf8);
+	UML_SHR(block, I2, I0, 13);
+	UML_AND(block, I2, I2, 0x07);
+	UML_OR(block, mem(&s.dest[1]), I1, I2);
+	UML_SHR(block, I1, I0, 3);
+	UML_AND(block, I1, I1, 0xfc);
+	UML_SHR(block, I2, I0, 9);
+	UML_AND(block, I2, I2, 0x03);
+	UML_OR(block, mem(&s.dest[2]), I1, I2);
+	UML_SHL(block, I1, I0, 3);
+	UML_AND(block, I1, I1, 0xf8);
+	UML_SHR(block, I2, I0, 2);
+	UML_AND(block, I2, I2, 0x07);
+	UML_OR(block, mem(&s.dest[3]), I1, I2);
+	if (FBZMODE_ENABLE_ALPHA_PLANES(fbzmode))
+	{
+		UML_ADD(block, I1, I4, mem(&s.depthidx));
+		UML_LOAD(block, mem(&s.dest[0]), m_vd.fbi.ram, I1, SIZE_WORD, SCALE_x2);
+	}
+	else
+		UML_MOV(block, mem(&s.dest[0]), 0xff);
+
+	/* apply dither subtraction */
+	if (FBZMODE_ALPHA_DITHER_SUBTRACT(fbzmode))
+	{
+		const UINT8 *matrix = (FBZMODE_ENABLE_DITHERING(fbzmode) && FBZMODE_DITHER_TYPE(fbzmode) != 0) ? dither_matrix_2x2 : dither_matrix_4x4;
+
+		UML_AND(block, I1, I4, 3);
+		UML_ADD(block, I1, I1, mem(&s.dithermatrix));
+		UML_LOAD(block, I1, matrix, I1, SIZE_BYTE, SCALE_x1);
+		UML_MOV(block, I2, 15);
+		UML_SUB(block, I2, I2, I1);
+		UML_SHR(block, I1, I2, 1);
+		UML_ADD(block, mem(&s.dest[1]), mem(&s.dest[1]), I1);
+		UML_ADD(block, mem(&s.dest[3]), mem(&s.dest[3]), I1);
+		UML_SHR(block, I1, I2, 2);
+		UML_ADD(block, mem(&s.dest[2]), mem(&s.dest[2]), I1);
+	}
+
+	/* compute the source factors */
+	UML_MOV(block, mem(&s.scale[0]), (ALPHAMODE_SRCALPHABLEND(alphamode) == 4) ? 256 : 0);
+	switch (ALPHAMODE_SRCRGBBLEND(alphamode))
+	{
+		default:    /* reserved */
+		case 0:     /* AZERO */
+			UML_MOV(block, I1, 0);
+			break;
+
+		case 1:     /* ASRC_ALPHA */
+			UML_ADD(block, I1, mem(&s.color[0]), 1);
+			break;
+
+		case 2:     /* A_COLOR */
+			for (int c = 1; c < 4; c++)
+				UML_ADD(block, mem(&s.scale[c]), mem(&s.dest[c]), 1);
+			break;
+
+		case 3:     /* ADST_ALPHA */
+			UML_ADD(block, I1, mem(&s.dest[0]), 1);
+			break;
+
+		case 4:     /* AONE */
+			UML_MOV(block, I1, 256);
+			break;
+
+		case 5:     /* AOMSRC_ALPHA */
+			UML_MOV(block, I1, 0x100);
+			UML_SUB(block, I1, I1, mem(&s.color[0]));
+			break;
+
+		case 6:     /* AOM_COLOR */
+			for (int c = 1; c < 4; c++)
+			{
+				UML_MOV(block, I1, 0x100);
+				UML_SUB(block, mem(&s.scale[c]), I1, mem(&s.dest[c]));
+			}
+			break;
+
+		case 7:     /* AOMDST_ALPHA */
+			UML_MOV(block, I1, 0x100);
+			UML_SUB(block, I1, I1, mem(&s.dest[0]));
+			break;
+
+		case 15:    /* ASATURATE */
+			UML_MOV(block, I1, 0x100);
+			UML_SUB(block, I1, I1, mem(&s.dest[0]));
+			UML_CMP(block, mem(&s.color[0]), I1);
+			UML_MOVc(block, COND_L, I1, mem(&s.color[0]));
+			UML_ADD(block, I1, I1, 1);
+			break;
+	}
+	if (ALPHAMODE_SRCRGBBLEND(alphamode) != 2 && ALPHAMODE_SRCRGBBLEND(alphamode) != 6)
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.scale[c]), I1);
+
+	/* compute the destination factors */
+	UML_MOV(block, mem(&s.dscale[0]), (ALPHAMODE_DSTALPHABLEND(alphamode) == 4) ? 256 : 0);
+	switch (ALPHAMODE_DSTRGBBLEND(alphamode))
+	{
+		default:    /* reserved */
+		case 0:     /* AZERO */
+			UML_MOV(block, I1, 0);
+			break;
+
+		case 1:     /* ASRC_ALPHA */
+			UML_ADD(block, I1, mem(&s.color[0]), 1);
+			break;
+
+		case 2:     /* A_COLOR */
+			for (int c = 1; c < 4; c++)
+				UML_ADD(block, mem(&s.dscale[c]), mem(&s.color[c]), 1);
+			break;
+
+		case 3:     /* ADST_ALPHA */
+			UML_ADD(block, I1, mem(&s.dest[0]), 1);
+			break;
+
+		case 4:     /* AONE */
+			UML_MOV(block, I1, 256);
+			break;
+
+		case 5:     /* AOMSRC_ALPHA */
+			UML_MOV(block, I1, 0x100);
+			UML_SUB(block, I1, I1, mem(&s.color[0]));
+			break;
+
+		case 6:     /* AOM_COLOR */
+			for (int c = 1; c < 4; c++)
+			{
+				UML_MOV(block, I1, 0x100);
+				UML_SUB(block, mem(&s.dscale[c]), I1, mem(&s.color[c]));
+			}
+			break;
+
+		case 7:     /* AOMDST_ALPHA */
+			UML_MOV(block, I1, 0x100);
+			UML_SUB(block, I1, I1, mem(&s.dest[0]));
+			break;
+
+		case 15:    /* A_COLORBEFOREFOG */
+			for (int c = 1; c < 4; c++)
+				UML_ADD(block, mem(&s.dscale[c]), mem(&s.prefog[c]), 1);
+			break;
+	}
+	if (ALPHAMODE_DSTRGBBLEND(alphamode) != 2 && ALPHAMODE_DSTRGBBLEND(alphamode) != 6 && ALPHAMODE_DSTRGBBLEND(alphamode) != 15)
+		for (int c = 1; c < 4; c++)
+			UML_MOV(block, mem(&s.dscale[c]), I1);
+
+	/* main blend: (src * scale + dest * dscale) >> 8, clamped */
+	for (int c = 0; c < 4; c++)
+	{
+		UML_MOV(block, I0, mem(&s.color[c]));
+		UML_MULU(block, I0, I0, I0, mem(&s.scale[c]));
+		UML_MOV(block, I1, mem(&s.dest[c]));
+		UML_MULU(block, I1, I1, I1, mem(&s.dscale[c]));
+		UML_ADD(block, I0, I0, I1);
+		UML_SAR(block, I0, I0, 8);
+		clamp_to_uint8(block, I0);
+		UML_MOV(block, mem(&s.color[c]), I0);
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_write - dither and write the pixel
+    and the aux value
+-------------------------------------------------*/
+
+void voodoo_jit::generate_write(drcuml_block *block, UINT32 fbzmode)
+{
+	jit_state &s = m_state;
+
+	if (FBZMODE_RGB_BUFFER_MASK(fbzmode))
+	{
+		if (FBZMODE_ENABLE_DITHERING(fbzmode))
+		{
+			const UINT8 *lookup = (FBZMODE_DITHER_TYPE(fbzmode) == 0) ? m_dither4_lookup : m_dither2_lookup;
+
+			/* lookup[((y & 3) << 11) + ((x & 3) << 1) + (value << 3) + is_green] */
+			UML_AND(block, I0, I4, 3);
+			UML_SHL(block, I0, I0, 1);
+			UML_ADD(block, I0, I0, mem(&s.ditherrow));
+			UML_SHL(block, I1, mem(&s.color[1]), 3);
+			UML_ADD(block, I1, I1, I0);
+			UML_LOAD(block, I1, lookup, I1, SIZE_BYTE, SCALE_x1);
+			UML_SHL(block, I2, mem(&s.color[2]), 3);
+			UML_ADD(block, I2, I2, I0);
+			UML_LOAD(block, I2, lookup + 1, I2, SIZE_BYTE, SCALE_x1);
+			UML_SHL(block, I3, mem(&s.color[3]), 3);
+			UML_ADD(block, I3, I3, I0);
+			UML_LOAD(block, I3, lookup, I3, SIZE_BYTE, SCALE_x1);
+		}
+		else
+		{
+			UML_SHR(block, I1, mem(&s.color[1]), 3);
+			UML_SHR(block, I2, mem(&s.color[2]), 2);
+			UML_SHR(block, I3, mem(&s.color[3]), 3);
+		}
+		UML_SHL(block, I1, I1, 11);
+		UML_SHL(block, I2, I2, 5);
+		UML_OR(block, I1, I1, I2);
+		UML_OR(block, I1, I1, I3);
+		UML_ADD(block, I0, I4, mem(&s.destidx));
+		UML_STORE(block, m_vd.fbi.ram, I0, I1, SIZE_WORD, SCALE_x2);
+	}
+
+	if (FBZMODE_AUX_BUFFER_MASK(fbzmode))
+	{
+		UML_MOV(block, I1, mem(FBZMODE_ENABLE_ALPHA_PLANES(fbzmode) ? &s.color[0] : &s.biasdepth));
+		UML_ADD(block, I0, I4, mem(&s.depthidx));
+		UML_STORE(block, m_vd.fbi.ram, I0, I1, SIZE_WORD, SCALE_x2);
+	}
+}
+
+
+
+/*************************************
+ *
+ *  Helpers
+ *
+ *************************************/
+
+/*-------------------------------------------------
+    split_argb - split a 32-bit ARGB value into
+    four channels
+-------------------------------------------------*/
+
+void voodoo_jit::split_argb(drcuml_block *block, INT32 *dst, uml::parameter src)
+{
+	UML_ROLAND(block, mem(&dst[0]), src, 8, 0xff);
+	UML_ROLAND(block, mem(&dst[1]), src, 16, 0xff);
+	UML_ROLAND(block, mem(&dst[2]), src, 24, 0xff);
+	UML_AND(block, mem(&dst[3]), src, 0xff);
+}
+
+
+/*-------------------------------------------------
+    scale_add_clamp - dst = clamp(((src * scale)
+    >> 8) + add) on all four channels
+-------------------------------------------------*/
+
+void voodoo_jit::scale_add_clamp(drcuml_block *block, INT32 *dst, const INT32 *src, const INT32 *scale, const INT32 *add)
+{
+	for (int c = 0; c < 4; c++)
+	{
+		UML_MOV(block, I0, mem(&src[c]));
+		UML_MULU(block, I0, I0, I0, mem(&scale[c]));
+		UML_SAR(block, I0, I0, 8);
+		UML_ADD(block, I0, I0, mem(&add[c]));
+		clamp_to_uint8(block, I0);
+		UML_MOV(block, mem(&dst[c]), I0);
+	}
+}
+
+
+/*-------------------------------------------------
+    clamp_to_uint8 - clamp a signed register to
+    0-255
+-------------------------------------------------*/
+
+void voodoo_jit::clamp_to_uint8(drcuml_block *block, uml::parameter reg)
+{
+	UML_CMP(block, reg, 0);
+	UML_MOVc(block, COND_L, reg, 0);
+	UML_CMP(block, reg, 0xff);
+	UML_MOVc(block, COND_G, reg, 0xff);
+}
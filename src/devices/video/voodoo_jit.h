@@ -0,0 +1,173 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    voodoo_jit.h
+
+    UML-compiled scanline rasterizers for the 3dfx Voodoo family.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __VOODOO_JIT_H__
+#define __VOODOO_JIT_H__
+
+#include "cpu/drcuml.h"
+#include "voodoo.h"
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> voodoo_jit
+
+// one compiler per work queue thread; the generated code addresses its own
+// span state directly, so it can't be shared between threads
+class voodoo_jit
+{
+public:
+	// construction/destruction
+	voodoo_jit(voodoo_device &vd, int threadid, const UINT8 *dither4_lookup, const UINT8 *dither2_lookup, bool verify);
+	~voodoo_jit();
+
+	// draw one span, compiling the rasterizer first if we haven't seen it
+	void rasterize(raster_info &info, voodoo_raster_func generic, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra);
+
+	// statistics
+	UINT32 hits() const { return m_hits; }
+	UINT32 misses() const { return m_misses; }
+	UINT32 fallbacks() const { return m_fallbacks; }
+	UINT32 mismatches() const { return m_mismatches; }
+	UINT32 flushes() const { return m_flushes; }
+
+private:
+	// TMU parameters copied in for each span
+	struct tmu_params
+	{
+		INT32               lodmin, lodmax;         // min, max LOD values
+		INT32               lodbias;                // LOD bias
+		UINT32              lodmask;                // mask of available LODs
+		UINT32              lodoffset[9];           // offset of texture base for each LOD
+		INT32               detailmax;              // detail clamp
+		INT32               detailbias;             // detail bias
+		INT32               detailscale;            // detail scale
+		UINT32              wmask;                  // mask for the current texture width
+		UINT32              hmask;                  // mask for the current texture height
+		UINT32              bilinear_mask;          // mask for bilinear resolution
+		UINT32              mask;                   // mask to apply to texture addresses
+		UINT32              lookup;                 // texel lookup table, in rgb_t units from the device
+		INT32               lodbase;                // per-polygon LOD base
+		INT64               iters, itert, iterw;    // iterated S,T,W
+		INT64               dsdx, dtdx, dwdx;       // delta S,T,W per X
+	};
+
+	// everything the generated code reads or writes, kept in the near cache
+	struct jit_state
+	{
+		// span setup
+		INT32               startx, stopx;          // span extents, after clipping
+		INT32               destidx;                // UINT16 index of the row in frame buffer RAM
+		INT32               depthidx;               // UINT16 index of the aux row in frame buffer RAM
+		INT32               ditherrow;              // (y & 3) << 11, row in the dither lookups
+		INT32               dithermatrix;           // (y & 3) * 4, row in the dither matrices
+		INT32               stipplerow;             // (y & 3) << 3, row in the stipple pattern
+		INT32               iterargb[4], dargb[4];  // iterated A,R,G,B and deltas
+		INT32               iterz, dzdx;            // iterated Z and delta
+		INT64               iterw, dwdx;            // iterated W and delta
+
+		// register snapshot
+		UINT32              stipplebits;            // stipple register, written back after the span
+		INT32               zabias;                 // signed depth bias from zaColor
+		INT32               zaconst;                // unsigned constant depth from zaColor
+		UINT32              chromakey;              // chromaKey register
+		UINT32              chromarange;            // chromaRange register
+		INT32               alpharef;               // alpha test reference
+		INT32               const0[4], const1[4];   // color0 and color1, split into A,R,G,B
+		INT32               fogcolor[4];            // fog color, split into A,R,G,B
+		INT32               fogdelta_mask;          // mask for the fog delta
+		UINT32              send_config;            // TMU 0 returns its configuration
+		INT32               tmu_config[4];          // TMU configuration, split into A,R,G,B
+
+		// statistics gathered over the span
+		INT32               pixels_in, pixels_out;
+		INT32               chroma_fail, zfunc_fail, afunc_fail;
+		INT32               stippled;
+
+		// per-pixel working values
+		INT32               color[4];               // source color
+		INT32               prefog[4];              // source color before fogging
+		INT32               texel[4];               // combined texel
+		INT32               other[4], local[4];     // combiner inputs
+		INT32               addval[4];              // combiner addend
+		INT32               dest[4];                // destination A,R,G,B for blending
+		INT32               scale[4], dscale[4];    // source and destination blend factors
+		INT32               fetch[4];               // raw texels for bilinear filtering
+		INT32               s, t, lod;              // texture coordinates
+		INT32               sfrac, tfrac;           // bilinear fractions
+		INT32               alocal, aother;         // combiner alphas
+		INT32               wfloat, fogdepth;       // floating point W and fog depth
+		INT32               biasdepth;              // biased depth value
+		INT32               chroma_result;          // result of the chroma range test
+		double              recipnum;               // numerator for the W reciprocal
+
+		tmu_params          tmu[2];
+	};
+
+	// code generation
+	uml::code_handle *compile(raster_info &info, int index);
+	void generate(drcuml_block *block, raster_info &info, uml::code_handle &handle);
+	void generate_clamped_z(drcuml_block *block, uml::parameter dst, UINT32 fbzcp);
+	void generate_clamped_w(drcuml_block *block, uml::parameter dst, UINT32 fbzcp);
+	void generate_float_depth(drcuml_block *block, bool wsource);
+	void generate_texture(drcuml_block *block, int which, UINT32 texmode);
+	void generate_texel_fetch(drcuml_block *block, int which, UINT32 texmode, uml::parameter index, uml::parameter dst);
+	void generate_combine_texture(drcuml_block *block, int which, UINT32 texmode);
+	void generate_combine_color(drcuml_block *block, UINT32 fbzcp, UINT32 fbzmode, UINT32 alphamode);
+	void generate_fog(drcuml_block *block, UINT32 fogmode, UINT32 fbzcp, UINT32 fbzmode);
+	void generate_alpha_blend(drcuml_block *block, UINT32 alphamode, UINT32 fbzmode);
+	void generate_write(drcuml_block *block, UINT32 fbzmode);
+
+	// helpers
+	uml::code_label newlabel() { return uml::code_label(m_labelnum++); }
+	void split_argb(drcuml_block *block, INT32 *dst, uml::parameter src);
+	void scale_add_clamp(drcuml_block *block, INT32 *dst, const INT32 *src, const INT32 *scale, const INT32 *add);
+	void clamp_to_uint8(drcuml_block *block, uml::parameter reg);
+	bool prepare(raster_info &info, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra);
+	void finish(stats_block &stats);
+	void verify(raster_info &info, voodoo_raster_func generic, uml::code_handle &handle, INT32 y, const voodoo_renderer::extent_t &extent, const poly_extra_data &extra);
+	static void chroma_range_test(void *param);
+
+	// internal state
+	voodoo_device &     m_vd;                   // the device we draw for
+	int                 m_threadid;             // work queue thread we belong to
+	const UINT8 *       m_dither4_lookup;       // 4x4 ordered dither lookup
+	const UINT8 *       m_dither2_lookup;       // 2x2 ordered dither lookup
+	bool                m_verify;               // check each span against the generic rasterizer
+	drc_cache           m_cache;                // code cache
+	std::unique_ptr<drcuml_state> m_drcuml;     // UML generator state
+	jit_state &         m_state;                // span state in the near cache
+	uml::code_handle *  m_handle[MAX_RASTERIZERS]; // compiled rasterizers, by raster_info index
+	UINT32              m_labelnum;             // next label in the block being generated
+
+	// fail labels for the block being generated
+	uml::code_label     m_skip;
+	uml::code_label     m_zfail;
+	uml::code_label     m_afail;
+	uml::code_label     m_chromafail;
+
+	// verification buffers
+	std::vector<UINT16> m_saved;
+	std::vector<UINT16> m_expected;
+
+	// statistics
+	UINT32              m_hits;                 // spans drawn by code that was already compiled
+	UINT32              m_misses;               // spans that had to compile their rasterizer first
+	UINT32              m_fallbacks;            // spans handed back to the generic rasterizer
+	UINT32              m_mismatches;           // spans that disagreed with the generic rasterizer
+	UINT32              m_flushes;              // times the code cache filled up
+};
+
+
+#endif  /* __VOODOO_JIT_H__ */
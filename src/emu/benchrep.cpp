@@ -0,0 +1,235 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    benchrep.cpp
+
+    Collection of benchmark results across machine runs, written out as
+    a JSON report.
+
+****************************************************************************
+
+    The report has one object per machine run:
+
+    {
+        "build": "0.176 (...)",
+        "seconds": 60,
+        "profiler": true,
+        "machines": [
+            {
+                "name": "pacman", "description": "...", "source": "pacman.cpp",
+                "result": 0,
+                "emulated_seconds": 60.0, "real_seconds": 1.8,
+                "speed_percent": 3410.2, "frames": 3636,
+                "peak_rss": 123456789,
+                "profile": { "Video Update": 0.21, ... },
+                "devices": [ { "tag": ":maincpu", "name": "Z80",
+                               "cycles": 184320000, "execute_seconds": 1.1 } ]
+            }
+        ]
+    }
+
+    The profile breakdown comes from the profiler, so it is only filled
+    in for builds with MAME_PROFILER defined; per-device execute times
+    come from the scheduler's host time accounting and are always
+    present. peak_rss is the peak for the whole process so far.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "benchrep.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+
+
+//**************************************************************************
+//  BENCHMARK REPORT
+//**************************************************************************
+
+//-------------------------------------------------
+//  benchmark_report - constructor
+//-------------------------------------------------
+
+benchmark_report::benchmark_report(int seconds)
+	: m_seconds(seconds),
+		m_failures(0),
+		m_machine(nullptr),
+		m_start_ticks(0)
+{
+}
+
+
+//-------------------------------------------------
+//  machine_start - start measuring a machine;
+//  called once its subsystems are running
+//-------------------------------------------------
+
+void benchmark_report::machine_start(running_machine &machine)
+{
+	m_machine = &machine;
+	m_start_ticks = osd_ticks();
+
+	// restart the profiler so the breakdown covers this machine only
+	g_profiler.enable(false);
+	g_profiler.enable(true);
+
+	// collect results before the devices are stopped
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(benchmark_report::machine_exit), this), true);
+}
+
+
+//-------------------------------------------------
+//  machine_exit - collect the results for the
+//  machine that is shutting down
+//-------------------------------------------------
+
+void benchmark_report::machine_exit()
+{
+	running_machine &machine = *m_machine;
+	osd_ticks_t tps = osd_ticks_per_second();
+
+	machine_result result;
+	result.m_name = machine.system().name;
+	result.m_description = machine.system().description;
+	result.m_source = core_filename_extract_base(machine.system().source_file);
+	result.m_error = MAMERR_NONE;
+	result.m_emulated_seconds = machine.time().as_double();
+	result.m_real_seconds = double(osd_ticks() - m_start_ticks) / double(tps);
+	result.m_speed_percent = machine.video().overall_speed_percent();
+	result.m_frames = (machine.first_screen() != nullptr) ? machine.first_screen()->frame_number() : 0;
+	result.m_peak_memory = osd_get_peak_memory();
+
+	// profiler breakdown for everything but the devices
+	if (g_profiler.enabled())
+		for (profile_type type = PROFILER_DRC_COMPILE; type < PROFILER_TOTAL; ++type)
+			if (g_profiler.data(type) != 0 && *profile_type_name(type) != 0)
+				result.m_profile.emplace_back(profile_type_name(type), double(g_profiler.data(type)) / double(tps));
+
+	// executing devices
+	execute_interface_iterator iter(machine.root_device());
+	for (device_execute_interface *exec = iter.first(); exec != nullptr; exec = iter.next())
+	{
+		device_result devresult;
+		devresult.m_tag = exec->device().tag();
+		devresult.m_name = exec->device().name();
+		devresult.m_cycles = exec->total_cycles();
+		devresult.m_execute_seconds = exec->host_seconds();
+		result.m_devices.push_back(std::move(devresult));
+	}
+
+	g_profiler.enable(false);
+	m_results.push_back(std::move(result));
+	m_machine = nullptr;
+}
+
+
+//-------------------------------------------------
+//  add_failure - record a machine that did not
+//  run to completion
+//-------------------------------------------------
+
+void benchmark_report::add_failure(const game_driver &driver, int error)
+{
+	m_failures++;
+
+	// if the machine got far enough to report, just mark its result
+	if (!m_results.empty() && m_results.back().m_name == driver.name && m_results.back().m_error == MAMERR_NONE)
+	{
+		m_results.back().m_error = error;
+		return;
+	}
+
+	machine_result result;
+	result.m_name = driver.name;
+	result.m_description = driver.description;
+	result.m_source = core_filename_extract_base(driver.source_file);
+	result.m_error = error;
+	result.m_emulated_seconds = 0;
+	result.m_real_seconds = 0;
+	result.m_speed_percent = 0;
+	result.m_frames = 0;
+	result.m_peak_memory = osd_get_peak_memory();
+	m_results.push_back(std::move(result));
+}
+
+
+//-------------------------------------------------
+//  json - return the report as JSON text
+//-------------------------------------------------
+
+std::string benchmark_report::json() const
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+	writer.StartObject();
+	writer.Key("build");
+	writer.String(build_version);
+	writer.Key("seconds");
+	writer.Int(m_seconds);
+	writer.Key("profiler");
+#ifdef MAME_PROFILER
+	writer.Bool(true);
+#else
+	writer.Bool(false);
+#endif
+
+	writer.Key("machines");
+	writer.StartArray();
+	for (const machine_result &result : m_results)
+	{
+		writer.StartObject();
+		writer.Key("name");
+		writer.String(result.m_name.c_str());
+		writer.Key("description");
+		writer.String(result.m_description.c_str());
+		writer.Key("source");
+		writer.String(result.m_source.c_str());
+		writer.Key("result");
+		writer.Int(result.m_error);
+		writer.Key("emulated_seconds");
+		writer.Double(result.m_emulated_seconds);
+		writer.Key("real_seconds");
+		writer.Double(result.m_real_seconds);
+		writer.Key("speed_percent");
+		writer.Double(result.m_speed_percent);
+		writer.Key("frames");
+		writer.Uint64(result.m_frames);
+		writer.Key("peak_rss");
+		writer.Uint64(result.m_peak_memory);
+
+		writer.Key("profile");
+		writer.StartObject();
+		for (auto &entry : result.m_profile)
+		{
+			writer.Key(entry.first.c_str());
+			writer.Double(entry.second);
+		}
+		writer.EndObject();
+
+		writer.Key("devices");
+		writer.StartArray();
+		for (const device_result &device : result.m_devices)
+		{
+			writer.StartObject();
+			writer.Key("tag");
+			writer.String(device.m_tag.c_str());
+			writer.Key("name");
+			writer.String(device.m_name.c_str());
+			writer.Key("cycles");
+			writer.Uint64(device.m_cycles);
+			writer.Key("execute_seconds");
+			writer.Double(device.m_execute_seconds);
+			writer.EndObject();
+		}
+		writer.EndArray();
+
+		writer.EndObject();
+	}
+	writer.EndArray();
+	writer.EndObject();
+
+	return std::string(buffer.GetString()).append("\n");
+}
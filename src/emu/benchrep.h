@@ -0,0 +1,80 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    benchrep.h
+
+    Collection of benchmark results across machine runs, written out as
+    a JSON report.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __BENCHREP_H__
+#define __BENCHREP_H__
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> benchmark_report
+
+class benchmark_report
+{
+public:
+	// construction/destruction
+	benchmark_report(int seconds);
+
+	// getters
+	int seconds() const { return m_seconds; }
+	int failures() const { return m_failures; }
+
+	// machine tracking
+	void machine_start(running_machine &machine);
+	void add_failure(const game_driver &driver, int error);
+
+	// output
+	std::string json() const;
+
+private:
+	// results for one executing device
+	struct device_result
+	{
+		std::string         m_tag;                  // device tag
+		std::string         m_name;                 // device name
+		UINT64              m_cycles;               // total cycles executed
+		double              m_execute_seconds;      // host time spent executing
+	};
+
+	// results for one machine
+	struct machine_result
+	{
+		std::string         m_name;                 // short driver name
+		std::string         m_description;          // full driver description
+		std::string         m_source;               // driver source file
+		int                 m_error;                // exit code from the run
+		double              m_emulated_seconds;     // emulated time reached
+		double              m_real_seconds;         // host time from start to exit
+		double              m_speed_percent;        // steady-state speed, as shown by -bench
+		UINT64              m_frames;               // frames completed by the first screen
+		UINT64              m_peak_memory;          // process peak RSS at exit
+		std::vector<std::pair<std::string, double>> m_profile; // seconds per profiler type
+		std::vector<device_result> m_devices;       // executing devices
+	};
+
+	// internal helpers
+	void machine_exit();
+
+	// internal state
+	int                     m_seconds;              // emulated seconds per machine
+	int                     m_failures;             // number of machines that failed to run
+	running_machine *       m_machine;              // machine currently being measured
+	osd_ticks_t             m_start_ticks;          // host time at machine start
+	std::vector<machine_result> m_results;          // all results so far
+};
+
+
+#endif  /* __BENCHREP_H__ */
@@ -22,6 +22,7 @@
 #include "xmlfile.h"
 
 #include "drivenum.h"
+#include "benchrep.h"
 
 #include "osdepend.h"
 #include "softlist.h"
@@ -1550,6 +1551,79 @@ void cli_frontend::verifysoftlist(const char *gamename)
 	}
 }
 
+//-------------------------------------------------
+//  benchmark - run each of a comma-separated
+//  list of systems headless for a fixed emulated
+//  time and write a JSON report
+//-------------------------------------------------
+
+void cli_frontend::benchmark(const char *gamename)
+{
+	// gather the systems, in the order given and without duplicates
+	std::vector<const game_driver *> systems;
+	std::string names(gamename);
+	for (size_t start = 0; start < names.length(); )
+	{
+		size_t end = names.find(',', start);
+		if (end == std::string::npos)
+			end = names.length();
+		std::string pattern = names.substr(start, end - start);
+		start = end + 1;
+
+		driver_enumerator drivlist(m_options, strtrimspace(pattern).c_str());
+		while (drivlist.next())
+			if (std::find(systems.begin(), systems.end(), &drivlist.driver()) == systems.end())
+				systems.push_back(&drivlist.driver());
+	}
+	if (systems.empty())
+		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching systems found for '%s'", gamename);
+
+	// run headless and unthrottled; the OSD's -bench option turns off video, sound and throttling
+	int seconds = m_options.seconds_to_run();
+	if (seconds == 0)
+		seconds = 60;
+	std::string error;
+	m_options.set_value("bench", seconds, OPTION_PRIORITY_MAXIMUM, error);
+	m_options.set_value(OPTION_SECONDS_TO_RUN, seconds, OPTION_PRIORITY_MAXIMUM, error);
+	m_options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM, error);
+	m_options.set_value(OPTION_SKIP_GAMEINFO, true, OPTION_PRIORITY_MAXIMUM, error);
+
+	// run each system in turn
+	benchmark_report report(seconds);
+	machine_manager *manager = machine_manager::instance();
+	manager->set_benchmark(&report);
+	for (const game_driver *system : systems)
+	{
+		osd_printf_info("Benchmarking %s for %d seconds\n", system->name, seconds);
+		m_options.set_system_name(system->name);
+
+		int result;
+		try
+		{
+			result = manager->execute();
+		}
+		catch (emu_fatalerror &fatal)
+		{
+			osd_printf_error("%s\n", fatal.string());
+			result = (fatal.exitcode() != 0) ? fatal.exitcode() : MAMERR_FATALERROR;
+		}
+		if (result != MAMERR_NONE)
+			report.add_failure(*system, result);
+	}
+	manager->set_benchmark(nullptr);
+
+	// write the report
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(m_options.benchmark_report()) != osd_file::error::NONE)
+		throw emu_fatalerror("Unable to create file %s\n", m_options.benchmark_report());
+	file.puts(report.json().c_str());
+
+	if (report.failures() != 0)
+		throw emu_fatalerror(MAMERR_FATALERROR, "%d of %d systems failed to run\n", report.failures(), int(systems.size()));
+	osd_printf_info("Benchmark report written to %s\n", m_options.benchmark_report());
+}
+
+
 //-------------------------------------------------
 //  romident - identify ROMs by looking for
 //  matches in our internal database
@@ -1684,6 +1758,7 @@ void cli_frontend::execute_commands(const char *exename)
 		{ CLICOMMAND_ROMIDENT,      &cli_frontend::romident },
 		{ CLICOMMAND_GETSOFTLIST,   &cli_frontend::getsoftlist },
 		{ CLICOMMAND_VERIFYSOFTLIST,&cli_frontend::verifysoftlist },
+		{ CLICOMMAND_BENCHMARK,     &cli_frontend::benchmark },
 	};
 
 	// find the command
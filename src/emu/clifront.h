@@ -55,6 +55,7 @@ public:
 	void romident(const char *filename);
 	void getsoftlist(const char *gamename = "*");
 	void verifysoftlist(const char *gamename = "*");
+	void benchmark(const char *gamename = "*");
 
 private:
 	// internal helpers
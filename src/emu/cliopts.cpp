@@ -45,6 +45,7 @@ const options_entry cli_options::s_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTWARE ";vsoft", "0",     OPTION_COMMAND,    "verify known software for the system" },
 	{ CLICOMMAND_GETSOFTLIST ";glist",  "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist", "0",     OPTION_COMMAND,    "verify software list by name" },
+	{ CLICOMMAND_BENCHMARK,             "0",       OPTION_COMMAND,    "run each listed system headless for -str seconds and write a JSON report" },
 	{ nullptr }
 };
 
@@ -47,6 +47,7 @@
 #define CLICOMMAND_VERIFYSOFTWARE       "verifysoftware"
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
+#define CLICOMMAND_BENCHMARK            "benchmark"
 
 
 //**************************************************************************
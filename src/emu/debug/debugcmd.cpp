@@ -150,6 +150,8 @@ static void execute_snap(running_machine &machine, int ref, int params, const ch
 static void execute_source(running_machine &machine, int ref, int params, const char **param);
 static void execute_map(running_machine &machine, int ref, int params, const char **param);
 static void execute_memdump(running_machine &machine, int ref, int params, const char **param);
+static void execute_memstats(running_machine &machine, int ref, int params, const char **param);
+static void execute_execstats(running_machine &machine, int ref, int params, const char **param);
 static void execute_symlist(running_machine &machine, int ref, int params, const char **param);
 static void execute_softreset(running_machine &machine, int ref, int params, const char **param);
 static void execute_hardreset(running_machine &machine, int ref, int params, const char **param);
@@ -390,6 +392,8 @@ void debug_command_init(running_machine &machine)
 	debug_console_register_command(machine, "mapd",      CMDFLAG_NONE, AS_DATA, 1, 1, execute_map);
 	debug_console_register_command(machine, "mapi",      CMDFLAG_NONE, AS_IO, 1, 1, execute_map);
 	debug_console_register_command(machine, "memdump",   CMDFLAG_NONE, 0, 0, 1, execute_memdump);
+	debug_console_register_command(machine, "memstats",  CMDFLAG_NONE, 0, 0, 1, execute_memstats);
+	debug_console_register_command(machine, "execstats", CMDFLAG_NONE, 0, 0, 1, execute_execstats);
 
 	debug_console_register_command(machine, "symlist",   CMDFLAG_NONE, 0, 0, 1, execute_symlist);
 
@@ -2944,6 +2948,72 @@ static void execute_memdump(running_machine &machine, int ref, int params, const
 }
 
 
+/*-------------------------------------------------
+    execute_memstats - execute the memstats
+    command
+-------------------------------------------------*/
+
+static void execute_memstats(running_machine &machine, int ref, int params, const char **param)
+{
+	FILE *file;
+	const char *filename;
+
+	/* start counting if nobody asked for it on the command line */
+	if (!machine.memory().access_stats_enabled())
+	{
+		machine.memory().enable_access_stats();
+		debug_console_printf(machine, "Memory access statistics enabled\n");
+		return;
+	}
+
+	filename = (params == 0) ? "memstats.log" : param[0];
+
+	debug_console_printf(machine, "Dumping memory access statistics to %s\n", filename);
+
+	file = fopen(filename, "w");
+	if (file)
+	{
+		machine.memory().dump_access_stats(file);
+		fclose(file);
+	}
+}
+
+
+/*-------------------------------------------------
+    execute_execstats - execute the execstats
+    command
+-------------------------------------------------*/
+
+static void execute_execstats(running_machine &machine, int ref, int params, const char **param)
+{
+	FILE *file;
+
+	/* no parameters: show the table */
+	if (params == 0)
+	{
+		debug_console_printf(machine, "%s", machine.scheduler().execute_stats().c_str());
+		return;
+	}
+
+	/* "reset" restarts the counters */
+	if (core_stricmp(param[0], "reset") == 0)
+	{
+		machine.scheduler().reset_execute_stats();
+		debug_console_printf(machine, "Execution statistics reset\n");
+		return;
+	}
+
+	debug_console_printf(machine, "Dumping execution statistics to %s\n", param[0]);
+
+	file = fopen(param[0], "w");
+	if (file)
+	{
+		fprintf(file, "%s", machine.scheduler().execute_stats().c_str());
+		fclose(file);
+	}
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
@@ -122,6 +122,8 @@ static const help_item static_help_list[] =
 		"  mapd <address> -- map logical data address to physical address and bank\n"
 		"  mapi <address> -- map logical I/O address to physical address and bank\n"
 		"  memdump [<filename>] -- dump the current memory map to <filename>\n"
+		"  memstats [<filename>] -- dump per-handler memory access counts to <filename>\n"
+		"  execstats [<filename>|reset] -- show or dump the host time spent in each executing device\n"
 	},
 	{
 		"execution",
@@ -1222,6 +1224,41 @@ static const help_item static_help_list[] =
 		"memdump\n"
 		"  Dumps memory to memdump.log.\n"
 	},
+	{
+		"memstats",
+		"\n"
+		"  memstats [<filename>]\n"
+		"\n"
+		"Dumps the number of reads and writes that went to each memory handler and bank, busiest first, "
+		"to <filename>. If <filename> is omitted, then dumps to memstats.log. If counting is not already "
+		"enabled with -memstats, the first memstats command turns it on instead of dumping."
+		"\n"
+		"Examples:\n"
+		"\n"
+		"memstats\n"
+		"  Starts counting accesses, or dumps the counts so far to memstats.log.\n"
+		"\n"
+		"memstats hot.log\n"
+		"  Dumps the counts so far to hot.log.\n"
+	},
+	{
+		"execstats",
+		"\n"
+		"  execstats [<filename>|reset]\n"
+		"\n"
+		"Shows the host time spent executing each CPU and other executing device since the counters were "
+		"last reset, together with the cycles executed, the cycles per host second, and how fast the device "
+		"would run on its own relative to real time. If <filename> is given, the table is written there "
+		"instead. 'execstats reset' restarts the counters."
+		"\n"
+		"Examples:\n"
+		"\n"
+		"execstats\n"
+		"  Shows the statistics so far.\n"
+		"\n"
+		"execstats reset\n"
+		"  Restarts counting, for example before reproducing a slowdown.\n"
+	},
 	{
 		"comadd",
 		"\n"
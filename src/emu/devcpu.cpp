@@ -60,3 +60,15 @@ bool cpu_device::allow_drc() const
 {
 	return mconfig().options().drc() && !m_force_no_drc;
 }
+
+
+//-------------------------------------------------
+//  allow_experimental_drc - return true if a DRC
+//  that is still being validated against its
+//  interpreter is allowed
+//-------------------------------------------------
+
+bool cpu_device::allow_experimental_drc() const
+{
+	return allow_drc() && (mconfig().options().drc_experimental() || mconfig().options().drc_validate());
+}
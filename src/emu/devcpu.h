@@ -74,6 +74,7 @@ public:
 	// configuration helpers
 	static void static_set_force_no_drc(device_t &device, bool value);
 	bool allow_drc() const;
+	bool allow_experimental_drc() const;
 
 protected:
 	// construction/destruction
@@ -44,6 +44,7 @@ const int TRIGGER_SUSPENDTIME   = -4000;
 device_execute_interface::device_execute_interface(const machine_config &mconfig, device_t &device)
 	: device_interface(device, "execute"),
 		m_disabled(false),
+		m_parallel_group(0),
 		m_vblank_interrupt_screen(nullptr),
 		m_timed_interrupt_period(attotime::zero),
 		m_nextexec(nullptr),
@@ -62,7 +63,10 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 		m_divisor(0),
 		m_divshift(0),
 		m_cycles_per_second(0),
-		m_attoseconds_per_cycle(0)
+		m_attoseconds_per_cycle(0),
+		m_host_ticks(0),
+		m_host_cycles(0),
+		m_timeslices(0)
 {
 	memset(&m_localtime, 0, sizeof(m_localtime));
 
@@ -94,6 +98,21 @@ void device_execute_interface::static_set_disable(device_t &device)
 }
 
 
+//-------------------------------------------------
+//  static_set_parallel_group - configuration
+//  helper to assign the device to a group that
+//  may execute concurrently with other groups
+//-------------------------------------------------
+
+void device_execute_interface::static_set_parallel_group(device_t &device, int group)
+{
+	device_execute_interface *exec;
+	if (!device.interface(exec))
+		throw emu_fatalerror("MCFG_DEVICE_PARALLEL_GROUP called on device '%s' with no execute interface", device.tag());
+	exec->m_parallel_group = group;
+}
+
+
 //-------------------------------------------------
 //  static_set_vblank_int - configuration helper
 //  to set up VBLANK interrupts on the device
@@ -458,6 +477,10 @@ void device_execute_interface::interface_validity_check(validity_checker &valid)
 		osd_printf_error("Timed interrupt handler specified with 0 period\n");
 	else if (m_timed_interrupt.isnull() && m_timed_interrupt_period != attotime::zero)
 		osd_printf_error("No timer interrupt handler specified, but has a non-0 period given\n");
+
+	// validate the parallel group
+	if (m_parallel_group < 0)
+		osd_printf_error("Invalid parallel execution group %d\n", m_parallel_group);
 }
 
 
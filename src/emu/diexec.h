@@ -88,6 +88,8 @@ enum
 
 #define MCFG_DEVICE_DISABLE() \
 	device_execute_interface::static_set_disable(*device);
+#define MCFG_DEVICE_PARALLEL_GROUP(_group) \
+	device_execute_interface::static_set_parallel_group(*device, _group);
 #define MCFG_DEVICE_VBLANK_INT_DRIVER(_tag, _class, _func) \
 	device_execute_interface::static_set_vblank_int(*device, device_interrupt_delegate(&_class::_func, #_class "::" #_func, DEVICE_SELF, (_class *)0), _tag);
 #define MCFG_DEVICE_VBLANK_INT_DEVICE(_tag, _devtag, _class, _func) \
@@ -139,6 +141,7 @@ public:
 
 	// configuration access
 	bool disabled() const { return m_disabled; }
+	int parallel_group() const { return m_parallel_group; }
 	UINT64 clocks_to_cycles(UINT64 clocks) const { return execute_clocks_to_cycles(clocks); }
 	UINT64 cycles_to_clocks(UINT64 cycles) const { return execute_cycles_to_clocks(cycles); }
 	UINT32 min_cycles() const { return execute_min_cycles(); }
@@ -150,6 +153,7 @@ public:
 
 	// static inline configuration helpers
 	static void static_set_disable(device_t &device);
+	static void static_set_parallel_group(device_t &device, int group);
 	static void static_set_vblank_int(device_t &device, device_interrupt_delegate function, const char *tag, int rate = 0);
 	static void static_set_periodic_int(device_t &device, device_interrupt_delegate function, const attotime &rate);
 	static void static_set_irq_acknowledge_callback(device_t &device, device_irq_acknowledge_delegate callback);
@@ -187,6 +191,14 @@ public:
 	attotime local_time() const;
 	UINT64 total_cycles() const;
 
+	// host execution accounting; counted across resets until reset_host_stats() is called
+	osd_ticks_t host_ticks() const { return m_host_ticks; }
+	double host_seconds() const { return double(m_host_ticks) / double(osd_ticks_per_second()); }
+	UINT64 host_cycles() const { return m_host_cycles; }
+	UINT64 timeslices() const { return m_timeslices; }
+	double host_cycles_per_second() const { return (m_host_ticks != 0) ? double(m_host_cycles) / host_seconds() : 0.0; }
+	void reset_host_stats() { m_host_ticks = 0; m_host_cycles = 0; m_timeslices = 0; }
+
 	// required operation overrides
 	void run() { execute_run(); }
 
@@ -255,6 +267,7 @@ protected:
 
 	// configuration
 	bool                    m_disabled;                 // disabled from executing?
+	int                     m_parallel_group;           // group this device may execute in parallel with (0 = scheduler thread)
 	device_interrupt_delegate m_vblank_interrupt;       // for interrupts tied to VBLANK
 	const char *            m_vblank_interrupt_screen;  // the screen that causes the VBLANK interrupt
 	device_interrupt_delegate m_timed_interrupt;        // for interrupts not tied to VBLANK
@@ -290,6 +303,11 @@ protected:
 	UINT32                  m_cycles_per_second;        // cycles per second, adjusted for multipliers
 	attoseconds_t           m_attoseconds_per_cycle;    // attoseconds per adjusted clock cycle
 
+	// host execution accounting
+	osd_ticks_t             m_host_ticks;               // host time spent in execute_run
+	UINT64                  m_host_cycles;              // cycles executed while being timed
+	UINT64                  m_timeslices;               // number of calls to execute_run
+
 private:
 	// callbacks
 	TIMER_CALLBACK_MEMBER(timed_trigger_callback);
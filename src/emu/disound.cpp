@@ -82,6 +82,18 @@ sound_stream *device_sound_interface::stream_alloc(int inputs, int outputs, int
 }
 
 
+//-------------------------------------------------
+//  stream_alloc_float - allocate a stream with a
+//  floating-point callback implicitly associated
+//  with this device
+//-------------------------------------------------
+
+sound_stream *device_sound_interface::stream_alloc_float(int inputs, int outputs, int sample_rate, stream_update_float_delegate callback)
+{
+	return device().machine().sound().stream_alloc_float(*this, inputs, outputs, sample_rate, callback);
+}
+
+
 //-------------------------------------------------
 //  inputs - return the total number of inputs
 //  for the given device
@@ -431,7 +443,10 @@ void device_mixer_interface::interface_pre_start()
 		}
 
 	// allocate the mixer stream
-	m_mixer_stream = stream_alloc(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate());
+	if (device().machine().sound().float_mixing())
+		m_mixer_stream = stream_alloc_float(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate(), stream_update_float_delegate(FUNC(device_mixer_interface::sound_stream_update_float), this));
+	else
+		m_mixer_stream = stream_alloc(m_auto_allocated_inputs, m_outputs, device().machine().sample_rate());
 }
 
 
@@ -472,3 +487,26 @@ void device_mixer_interface::sound_stream_update(sound_stream &stream, stream_sa
 			outputs[outmap[inp]][pos] += inputs[inp][pos];
 	}
 }
+
+
+//-------------------------------------------------
+//  sound_stream_update_float - mix all inputs to
+//  one output in floating point
+//-------------------------------------------------
+
+void device_mixer_interface::sound_stream_update_float(sound_stream &stream, stream_float_t **inputs, stream_float_t **outputs, int samples)
+{
+	// clear output buffers
+	for (int output = 0; output < m_outputs; output++)
+		std::fill_n(outputs[output], samples, 0.0f);
+
+	// for each input, add it to the appropriate output
+	const UINT8 *outmap = &m_outputmap[0];
+	for (int inp = 0; inp < m_auto_allocated_inputs; inp++)
+	{
+		const stream_float_t *source = inputs[inp];
+		stream_float_t *dest = outputs[outmap[inp]];
+		for (int pos = 0; pos < samples; pos++)
+			dest[pos] += source[pos];
+	}
+}
@@ -59,6 +59,8 @@ const int AUTO_ALLOC_INPUT  = 65535;
 
 class sound_stream;
 
+typedef delegate<void (sound_stream &, stream_float_t **inputs, stream_float_t **outputs, int samples)> stream_update_float_delegate;
+
 
 // ======================> device_sound_interface
 
@@ -96,6 +98,7 @@ public:
 
 	// stream creation
 	sound_stream *stream_alloc(int inputs, int outputs, int sample_rate);
+	sound_stream *stream_alloc_float(int inputs, int outputs, int sample_rate, stream_update_float_delegate callback);
 
 	// helpers
 	int inputs() const;
@@ -140,6 +143,7 @@ protected:
 
 	// sound interface overrides
 	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
+	void sound_stream_update_float(sound_stream &stream, stream_float_t **inputs, stream_float_t **outputs, int samples);
 
 	// internal state
 	UINT8               m_outputs;              // number of outputs
@@ -23,6 +23,8 @@
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <atomic>
+#include <mutex>
 
 // core emulator headers -- must be first
 #include "emucore.h"
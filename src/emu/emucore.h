@@ -64,6 +64,9 @@ typedef UINT32 pen_t;
 // stream_sample_t is used to represent a single sample in a sound stream
 typedef INT32 stream_sample_t;
 
+// stream_float_t is the same, for streams that opt into floating point; the scale matches stream_sample_t
+typedef float stream_float_t;
+
 // running_machine is core to pretty much everything
 class running_machine;
 
@@ -277,6 +277,7 @@ public:
 
 	// return a pointer to the backing RAM at the given offset
 	UINT8 *ramptr(offs_t offset = 0) const { return *m_rambaseptr + offset; }
+	UINT8 **rambaseptr() const { return m_rambaseptr; }
 
 	// see if we are an exact match to the given parameters
 	bool matches_exactly(offs_t bytestart, offs_t byteend, offs_t bytemask) const
@@ -568,6 +569,7 @@ public:
 
 	UINT32 lookup_live_nowp(offs_t byteaddress) const { return m_large ? lookup_live_large_nowp(byteaddress) : lookup_live_small_nowp(byteaddress); }
 	UINT32 lookup_live_small_nowp(offs_t byteaddress) const { return m_table[byteaddress]; }
+	UINT16 uniform_entry(offs_t bytestart, offs_t byteend, offs_t step) const;
 
 	UINT32 lookup_live_large_nowp(offs_t byteaddress) const
 	{
@@ -1028,8 +1030,8 @@ public:
 	virtual address_table_setoffset &setoffset() override { return m_setoffset; }
 
 	// watchpoint control
-	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); }
-	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); }
+	virtual void enable_read_watchpoints(bool enable = true) override { m_read.enable_watchpoints(enable); invalidate_fastpath(); }
+	virtual void enable_write_watchpoints(bool enable = true) override { m_write.enable_watchpoints(enable); invalidate_fastpath(); }
 
 	// generate accessor table
 	virtual void accessors(data_accessors &accessors) const override
@@ -1078,17 +1080,74 @@ public:
 		return handler.ramptr(handler.byteoffset(byteaddress));
 	}
 
+	// find the fast path entry for an address, filling it on a miss
+	fastpath_entry &fastpath_lookup(fastpath_entry *cache, const address_table &table, offs_t byteaddress)
+	{
+		offs_t page = byteaddress >> FASTPATH_PAGE_BITS;
+		fastpath_entry &slot = cache[page & (FASTPATH_ENTRIES - 1)];
+		if (UNEXPECTED(slot.m_page != page))
+			fastpath_fill(slot, table, page);
+		return slot;
+	}
+
+	// return a pointer to the native value at an address within a fast path page
+	_NativeType *fastpath_ptr(const fastpath_entry &slot, offs_t byteaddress) const
+	{
+		return reinterpret_cast<_NativeType *>(*slot.m_baseptr + slot.m_offset + (byteaddress & FASTPATH_PAGE_MASK));
+	}
+
+	// fill a fast path entry; the page is only directly accessible if every
+	// native word in it maps to the same RAM/bank entry at linear offsets
+	void fastpath_fill(fastpath_entry &slot, const address_table &table, offs_t page)
+	{
+		slot.m_page = page;
+		slot.m_baseptr = nullptr;
+
+		// watchpoints and access statistics must always see the access
+		if (table.watchpoints_enabled() || m_access_stats)
+			return;
+
+		// reject handlers cheaply before examining the whole page
+		offs_t pagestart = page << FASTPATH_PAGE_BITS;
+		offs_t pageend = std::min(pagestart | FASTPATH_PAGE_MASK, m_bytemask);
+		UINT16 entry = table.lookup_live_nowp(pagestart);
+		if (entry > STATIC_BANKMAX || table.uniform_entry(pagestart, pageend, NATIVE_BYTES) != entry)
+			return;
+
+		// the handler's mask must not fold any address bit that changes within the page
+		const handler_entry &handler = table.handler(entry);
+		offs_t delta = pagestart - handler.bytestart();
+		offs_t changed = delta ^ (delta + (pageend - pagestart));
+		changed |= changed >> 1;
+		changed |= changed >> 2;
+		changed |= changed >> 4;
+		changed |= changed >> 8;
+		changed |= changed >> 16;
+		if ((changed & ~handler.bytemask()) != 0)
+			return;
+
+		slot.m_baseptr = handler.rambaseptr();
+		slot.m_offset = handler.byteoffset(pagestart);
+	}
+
 	// native read
 	_NativeType read_native(offs_t offset, _NativeType mask)
 	{
+		// RAM/ROM fast path
+		offs_t byteaddress = offset & m_bytemask;
+		const fastpath_entry &fast = fastpath_lookup(m_read_fastpath, m_read, byteaddress);
+		if (EXPECTED(fast.m_baseptr != nullptr))
+			return *fastpath_ptr(fast, byteaddress);
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X,%s]", offset, core_i64_hex_format(mask, sizeof(_NativeType) * 2));
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (UNEXPECTED(m_access_stats))
+			m_read_stats[entry]++;
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1106,14 +1165,21 @@ public:
 	// mask-less native read
 	_NativeType read_native(offs_t offset)
 	{
+		// RAM/ROM fast path
+		offs_t byteaddress = offset & m_bytemask;
+		const fastpath_entry &fast = fastpath_lookup(m_read_fastpath, m_read, byteaddress);
+		if (EXPECTED(fast.m_baseptr != nullptr))
+			return *fastpath_ptr(fast, byteaddress);
+
 		g_profiler.start(PROFILER_MEMREAD);
 
 		if (TEST_HANDLER) printf("[r%X]", offset);
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = read_lookup(byteaddress);
 		const handler_entry_read &handler = m_read.handler_read(entry);
+		if (UNEXPECTED(m_access_stats))
+			m_read_stats[entry]++;
 
 		// either read directly from RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1131,12 +1197,23 @@ public:
 	// native write
 	void write_native(offs_t offset, _NativeType data, _NativeType mask)
 	{
+		// RAM fast path
+		offs_t byteaddress = offset & m_bytemask;
+		const fastpath_entry &fast = fastpath_lookup(m_write_fastpath, m_write, byteaddress);
+		if (EXPECTED(fast.m_baseptr != nullptr))
+		{
+			_NativeType *dest = fastpath_ptr(fast, byteaddress);
+			*dest = (*dest & ~mask) | (data & mask);
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (UNEXPECTED(m_access_stats))
+			m_write_stats[entry]++;
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1156,12 +1233,22 @@ public:
 	// mask-less native write
 	void write_native(offs_t offset, _NativeType data)
 	{
+		// RAM fast path
+		offs_t byteaddress = offset & m_bytemask;
+		const fastpath_entry &fast = fastpath_lookup(m_write_fastpath, m_write, byteaddress);
+		if (EXPECTED(fast.m_baseptr != nullptr))
+		{
+			*fastpath_ptr(fast, byteaddress) = data;
+			return;
+		}
+
 		g_profiler.start(PROFILER_MEMWRITE);
 
 		// look up the handler
-		offs_t byteaddress = offset & m_bytemask;
 		UINT32 entry = write_lookup(byteaddress);
 		const handler_entry_write &handler = m_write.handler_write(entry);
+		if (UNEXPECTED(m_access_stats))
+			m_write_stats[entry]++;
 
 		// either write directly to RAM, or call the delegate
 		offset = handler.byteoffset(byteaddress);
@@ -1535,6 +1622,7 @@ static void generate_memdump(running_machine &machine);
 memory_manager::memory_manager(running_machine &machine)
 	: m_machine(machine),
 		m_initialized(false),
+		m_access_stats(false),
 		m_banknext(STATIC_BANK1)
 {
 	memset(m_bank_ptr, 0, sizeof(m_bank_ptr));
@@ -1584,6 +1672,13 @@ void memory_manager::initialize()
 	// register a callback to reset banks when reloading state
 	machine().save().register_postload(save_prepost_delegate(FUNC(memory_manager::bank_reattach), this));
 
+	// count accesses per handler if requested, and report them on the way out
+	if (machine().options().mem_stats())
+	{
+		enable_access_stats();
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(memory_manager::access_stats_exit), this));
+	}
+
 	// dump the final memory configuration
 	generate_memdump(machine());
 
@@ -1621,6 +1716,60 @@ void memory_manager::dump(FILE *file)
 }
 
 
+//-------------------------------------------------
+//  enable_access_stats - start or stop counting
+//  accesses in every address space
+//-------------------------------------------------
+
+void memory_manager::enable_access_stats(bool enable)
+{
+	m_access_stats = enable;
+	for (address_space &space : m_spacelist)
+		space.enable_access_stats(enable);
+}
+
+
+//-------------------------------------------------
+//  dump_access_stats - dump the access counts of
+//  every address space to the given file
+//-------------------------------------------------
+
+void memory_manager::dump_access_stats(FILE *file)
+{
+	// skip if we can't open the file
+	if (file == nullptr)
+		return;
+
+	// loop over address spaces
+	for (address_space &space : m_spacelist)
+		if (space.access_stats_enabled())
+		{
+			fprintf(file, "\n\n"
+							"====================================================\n"
+							"Device '%s' %s address space access statistics\n"
+							"====================================================\n", space.device().tag(), space.name());
+			space.dump_access_stats(file);
+		}
+}
+
+
+//-------------------------------------------------
+//  access_stats_exit - write the access counts
+//  to memstats.log when the machine exits
+//-------------------------------------------------
+
+void memory_manager::access_stats_exit()
+{
+	FILE *file = fopen("memstats.log", "w");
+	if (file != nullptr)
+	{
+		dump_access_stats(file);
+		fclose(file);
+		osd_printf_info("Memory access statistics written to memstats.log\n");
+	}
+}
+
+
 //-------------------------------------------------
 //  region_alloc - allocates memory for a region
 //-------------------------------------------------
@@ -1723,9 +1872,13 @@ address_space::address_space(memory_manager &manager, device_memory_interface &m
 		m_name(memory.space_config(spacenum)->name()),
 		m_addrchars((m_config.m_addrbus_width + 3) / 4),
 		m_logaddrchars((m_config.m_logaddr_width + 3) / 4),
+		m_access_stats(false),
 		m_manager(manager),
 		m_machine(memory.device().machine())
 {
+	// start with an empty fast path cache
+	invalidate_fastpath();
+
 	// notify the device
 	memory.set_address_space(spacenum, *this);
 }
@@ -1740,6 +1893,23 @@ address_space::~address_space()
 }
 
 
+//-------------------------------------------------
+//  invalidate_fastpath - forget all cached pages;
+//  called whenever the lookup tables change
+//-------------------------------------------------
+
+void address_space::invalidate_fastpath()
+{
+	for (int entrynum = 0; entrynum < FASTPATH_ENTRIES; entrynum++)
+	{
+		m_read_fastpath[entrynum].m_page = ~0;
+		m_read_fastpath[entrynum].m_baseptr = nullptr;
+		m_write_fastpath[entrynum].m_page = ~0;
+		m_write_fastpath[entrynum].m_baseptr = nullptr;
+	}
+}
+
+
 //-------------------------------------------------
 //  allocate - static smart allocator of subtypes
 //-------------------------------------------------
@@ -2243,6 +2413,95 @@ void address_space::dump_map(FILE *file, read_or_write readorwrite)
 }
 
 
+//-------------------------------------------------
+//  enable_access_stats - start or stop counting
+//  accesses per handler entry
+//-------------------------------------------------
+
+void address_space::enable_access_stats(bool enable)
+{
+	m_access_stats = enable;
+	if (enable)
+	{
+		m_read_stats.resize(TOTAL_MEMORY_BANKS, 0);
+		m_write_stats.resize(TOTAL_MEMORY_BANKS, 0);
+	}
+
+	// cached pages would bypass the counters
+	invalidate_fastpath();
+}
+
+
+//-------------------------------------------------
+//  access_stats_key - describe the handler behind
+//  an entry; entries are recycled as the map
+//  changes, so counts are accumulated by this
+//-------------------------------------------------
+
+std::string address_space::access_stats_key(read_or_write readorwrite, UINT16 entry)
+{
+	const address_table &table = (readorwrite == ROW_READ) ? static_cast<address_table &>(read()) : static_cast<address_table &>(write());
+	const handler_entry &handler = table.handler(entry);
+	std::string range = handler.populated() ? string_format("%08X-%08X", handler.bytestart(), handler.byteend()) : std::string("-");
+	return string_format("%-17s = %s", range.c_str(), table.handler_name(entry));
+}
+
+
+//-------------------------------------------------
+//  retire_access_stats - move the per-entry counts
+//  into the per-handler totals before the entries
+//  are remapped
+//-------------------------------------------------
+
+void address_space::retire_access_stats()
+{
+	for (read_or_write readorwrite = ROW_READ; readorwrite <= ROW_WRITE; readorwrite = read_or_write(readorwrite + 1))
+	{
+		std::vector<UINT64> &stats = (readorwrite == ROW_READ) ? m_read_stats : m_write_stats;
+		std::unordered_map<std::string, UINT64> &retired = (readorwrite == ROW_READ) ? m_read_retired : m_write_retired;
+		for (UINT16 entry = 0; entry < stats.size(); entry++)
+			if (stats[entry] != 0)
+			{
+				retired[access_stats_key(readorwrite, entry)] += stats[entry];
+				stats[entry] = 0;
+			}
+	}
+}
+
+
+//-------------------------------------------------
+//  dump_access_stats - dump the access counts of
+//  each handler entry, busiest first
+//-------------------------------------------------
+
+void address_space::dump_access_stats(FILE *file)
+{
+	for (read_or_write readorwrite = ROW_READ; readorwrite <= ROW_WRITE; readorwrite = read_or_write(readorwrite + 1))
+	{
+		const std::vector<UINT64> &stats = (readorwrite == ROW_READ) ? m_read_stats : m_write_stats;
+
+		// combine the live counts with those of handlers since remapped
+		std::unordered_map<std::string, UINT64> totals = (readorwrite == ROW_READ) ? m_read_retired : m_write_retired;
+		for (UINT16 entry = 0; entry < stats.size(); entry++)
+			if (stats[entry] != 0)
+				totals[access_stats_key(readorwrite, entry)] += stats[entry];
+
+		// gather the handlers that were hit, busiest first
+		std::vector<std::pair<std::string, UINT64>> handlers(totals.begin(), totals.end());
+		UINT64 total = 0;
+		for (auto &handler : handlers)
+			total += handler.second;
+		std::stable_sort(handlers.begin(), handlers.end(), [](const std::pair<std::string, UINT64> &a, const std::pair<std::string, UINT64> &b) { return (a.second != b.second) ? (a.second > b.second) : (a.first < b.first); });
+
+		fprintf(file, "\n%s: %s total\n", (readorwrite == ROW_READ) ? "Reads" : "Writes", string_format("%u", total).c_str());
+		for (auto &handler : handlers)
+			fprintf(file, "%s %6.2f%%  %s\n",
+							string_format("%20u", handler.second).c_str(), 100.0 * double(handler.second) / double(total),
+							handler.first.c_str());
+	}
+}
+
+
 //**************************************************************************
 //  DYNAMIC ADDRESS SPACE MAPPING
 //**************************************************************************
@@ -2781,6 +3040,9 @@ address_table::~address_table()
 
 void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, UINT16 entry)
 {
+	// entries are about to change hands; credit their counts to the current handlers
+	m_space.retire_access_stats();
+
 	// convert addresses to bytes
 	offs_t bytestart = addrstart;
 	offs_t byteend = addrend;
@@ -2803,6 +3065,7 @@ void address_table::map_range(offs_t addrstart, offs_t addrend, offs_t addrmask,
 
 	// recompute any direct access on this space if it is a read modification
 	m_space.m_direct->force_update(entry);
+	m_space.invalidate_fastpath();
 
 	//  verify_reference_counts();
 }
@@ -2826,6 +3089,9 @@ UINT16 address_table::get_free_handler()
 
 void address_table::setup_range(offs_t addrstart, offs_t addrend, offs_t addrmask, offs_t addrmirror, UINT64 mask, std::list<UINT32> &entries)
 {
+	// entries are about to change hands; credit their counts to the current handlers
+	m_space.retire_access_stats();
+
 	// Careful, you can't shift by 64 or more
 	UINT64 testmask = (1ULL << (m_space.data_width()-1) << 1) - 1;
 
@@ -2929,6 +3195,7 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 		// recompute any direct access on this space if it is a read modification
 		m_space.m_direct->force_update(entry);
+		m_space.invalidate_fastpath();
 	}
 
 	// Ranges in range_partial must duplicated then partially changed
@@ -2972,6 +3239,7 @@ void address_table::setup_range_masked(offs_t addrstart, offs_t addrend, offs_t
 
 			// recompute any direct access on this space if it is a read modification
 			m_space.m_direct->force_update(entry);
+			m_space.invalidate_fastpath();
 		}
 	}
 
@@ -3025,6 +3293,31 @@ void address_table::verify_reference_counts()
 }
 
 
+//-------------------------------------------------
+//  uniform_entry - return the handler entry that
+//  covers every step-aligned address in a range,
+//  or STATIC_INVALID if there is more than one
+//-------------------------------------------------
+
+UINT16 address_table::uniform_entry(offs_t bytestart, offs_t byteend, offs_t step) const
+{
+	// in the large model, a range inside a level 1 entry with no subtable is uniform
+	if (m_large && level1_index_large(bytestart) == level1_index_large(byteend))
+	{
+		UINT16 l1entry = m_table[level1_index_large(bytestart)];
+		if (l1entry < SUBTABLE_BASE)
+			return l1entry;
+	}
+
+	// otherwise check each address in turn
+	UINT16 entry = lookup_live_nowp(bytestart);
+	for (offs_t offset = step; offset <= byteend - bytestart; offset += step)
+		if (lookup_live_nowp(bytestart + offset) != entry)
+			return STATIC_INVALID;
+	return entry;
+}
+
+
 //-------------------------------------------------
 //  populate_range - assign a memory handler to a
 //  range of addresses
@@ -3306,6 +3599,7 @@ void address_table::mask_all_handlers(offs_t mask)
 	// we don't loop over map entries because the mask applies to static handlers as well
 	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
 		handler(entrynum).apply_mask(mask);
+	m_space.invalidate_fastpath();
 }
 
 
@@ -294,6 +294,13 @@ public:
 	offs_t logbytemask() const { return m_logbytemask; }
 	UINT8 logaddrchars() const { return m_logaddrchars; }
 
+	// access statistics
+	bool access_stats_enabled() const { return m_access_stats; }
+	void enable_access_stats(bool enable = true);
+	void retire_access_stats();
+	void dump_access_stats(FILE *file);
+	std::string access_stats_key(read_or_write readorwrite, UINT16 entry);
+
 	// debug helpers
 	const char *get_handler_string(read_or_write readorwrite, offs_t byteaddress);
 	bool debugger_access() const { return m_debugger_access; }
@@ -463,6 +470,21 @@ private:
 	address_map_entry *block_assign_intersecting(offs_t bytestart, offs_t byteend, UINT8 *base);
 
 protected:
+	// fast path page cache: pages that map linearly onto RAM, ROM or a bank are
+	// accessed through the bank base pointer without going through the tables
+	static const int FASTPATH_PAGE_BITS = 10;                                // log2 of the bytes covered by a page
+	static const offs_t FASTPATH_PAGE_MASK = (1 << FASTPATH_PAGE_BITS) - 1;  // mask of the offset within a page
+	static const int FASTPATH_ENTRIES = 256;                                 // number of cached pages per direction
+
+	struct fastpath_entry
+	{
+		offs_t                  m_page;             // page number, or ~0 if the entry is empty
+		UINT8 **                m_baseptr;          // pointer to the bank base, or nullptr if not directly accessible
+		offs_t                  m_offset;           // offset of the start of the page within the bank
+	};
+
+	void invalidate_fastpath();
+
 	// private state
 	address_space *         m_next;             // next address space in the global list
 	const address_space_config &m_config;       // configuration of this space
@@ -480,6 +502,13 @@ protected:
 	const char *            m_name;             // friendly name of the address space
 	UINT8                   m_addrchars;        // number of characters to use for physical addresses
 	UINT8                   m_logaddrchars;     // number of characters to use for logical addresses
+	fastpath_entry          m_read_fastpath[FASTPATH_ENTRIES];  // cached read pages
+	fastpath_entry          m_write_fastpath[FASTPATH_ENTRIES]; // cached write pages
+	bool                    m_access_stats;     // count accesses per handler entry?
+	std::vector<UINT64>     m_read_stats;       // read counts for each handler entry
+	std::vector<UINT64>     m_write_stats;      // write counts for each handler entry
+	std::unordered_map<std::string, UINT64> m_read_retired;  // read counts of handlers since remapped
+	std::unordered_map<std::string, UINT64> m_write_retired; // write counts of handlers since remapped
 
 private:
 	memory_manager &        m_manager;          // reference to the owning manager
@@ -734,6 +763,11 @@ public:
 	// dump the internal memory tables to the given file
 	void dump(FILE *file);
 
+	// per-handler access statistics
+	bool access_stats_enabled() const { return m_access_stats; }
+	void enable_access_stats(bool enable = true);
+	void dump_access_stats(FILE *file);
+
 	// pointers to a bank pointer (internal usage only)
 	UINT8 **bank_pointer_addr(UINT8 index) { return &m_bank_ptr[index]; }
 
@@ -745,10 +779,12 @@ public:
 private:
 	// internal helpers
 	void bank_reattach();
+	void access_stats_exit();
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
 	bool                        m_initialized;          // have we completed initialization?
+	bool                        m_access_stats;         // are access statistics being collected?
 
 	UINT8 *                     m_bank_ptr[TOTAL_MEMORY_BANKS];  // array of bank pointers
 
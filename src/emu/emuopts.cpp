@@ -55,11 +55,13 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSHOT_DIRECTORY,                         "snap",      OPTION_STRING,     "directory to save/load screenshots" },
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
+	{ OPTION_DRC_CACHE_DIRECTORY,                        "drccache",  OPTION_STRING,     "directory to save DRC front-end analysis caches" },
 
 	// state/playback options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
 	{ OPTION_STATE,                                      nullptr,        OPTION_STRING,     "saved state to load" },
 	{ OPTION_AUTOSAVE,                                   "0",         OPTION_BOOLEAN,    "enable automatic restore at startup, and automatic save at exit time" },
+	{ OPTION_REWIND,                                     "0",         OPTION_INTEGER,    "number of frames of in-memory save states to keep for rewinding; 0 disables" },
 	{ OPTION_PLAYBACK ";pb",                             nullptr,        OPTION_STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",            OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
@@ -87,6 +89,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SLEEP,                                      "1",         OPTION_BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       OPTION_FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         OPTION_BOOLEAN,    "automatically adjusts the speed of gameplay to keep the refresh rate lower than the screen" },
+	{ OPTION_PARALLEL_EXEC,                              "0",         OPTION_BOOLEAN,    "allow drivers that support it to execute independent devices in parallel (experimental)" },
+	{ OPTION_BENCHMARK_REPORT,                           "benchmark.json", OPTION_STRING, "file to write the JSON report from -benchmark to" },
 
 	// render options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE RENDER OPTIONS" },
@@ -137,6 +141,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SAMPLERATE ";sr(1000-1000000)",             "48000",     OPTION_INTEGER,    "set sound output sample rate" },
 	{ OPTION_SAMPLES,                                    "1",         OPTION_BOOLEAN,    "enable the use of external samples if available" },
 	{ OPTION_VOLUME ";vol",                              "0",         OPTION_INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
+	{ OPTION_FLOAT_MIXING,                               "0",         OPTION_BOOLEAN,    "mix sound through floating-point mixers and speakers" },
+	{ OPTION_SOUND_COMPARE,                              "0",         OPTION_BOOLEAN,    "check each stream input's floating-point resampling and gain against the integer pipeline and report differences" },
 
 	// input options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE INPUT OPTIONS" },
@@ -175,6 +181,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_OSLOG,                                      "0",         OPTION_BOOLEAN,    "output error.log data to the system debugger" },
 	{ OPTION_DEBUG ";d",                                 "0",         OPTION_BOOLEAN,    "enable/disable debugger" },
 	{ OPTION_UPDATEINPAUSE,                              "0",         OPTION_BOOLEAN,    "keep calling video updates while in pause" },
+	{ OPTION_MEMSTATS,                                   "0",         OPTION_BOOLEAN,    "count memory accesses per handler and write them to memstats.log on exit" },
+	{ OPTION_EXECSTATS,                                  "0",         OPTION_INTEGER,    "write per-device host time statistics to execstats.log every <n> emulated seconds (0 = off)" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,        OPTION_STRING,     "script for debugger" },
 
 	// comm options
@@ -187,9 +195,18 @@ const options_entry emu_options::s_option_entries[] =
 	// misc options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE MISC OPTIONS" },
 	{ OPTION_DRC,                                        "1",         OPTION_BOOLEAN,    "enable DRC cpu core if available" },
+	{ OPTION_DRC_EXPERIMENTAL,                           "0",         OPTION_BOOLEAN,    "enable DRC cpu cores still being validated against their interpreters" },
 	{ OPTION_DRC_USE_C,                                  "0",         OPTION_BOOLEAN,    "force DRC use C backend" },
+	{ OPTION_DRC_OPTIMIZE,                               "0",         OPTION_BOOLEAN,    "optimize DRC UML code before generating it" },
+	{ OPTION_DRC_TRACES,                                 "0",         OPTION_BOOLEAN,    "profile DRC blocks to form superblocks and chain hot exits (experimental)" },
+	{ OPTION_DRC_CACHE,                                  "0",         OPTION_BOOLEAN,    "keep DRC front-end analysis between runs" },
+	{ OPTION_DRC_EVICT,                                  "0",         OPTION_BOOLEAN,    "evict the oldest DRC code when the cache fills instead of flushing all of it" },
 	{ OPTION_DRC_LOG_UML,                                "0",         OPTION_BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         OPTION_BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_VALIDATE,                               "0",         OPTION_BOOLEAN,    "compare and benchmark the DRC C and native backends, then exit" },
+	{ OPTION_M68K_BENCHMARK,                             "0",         OPTION_BOOLEAN,    "benchmark the general and specialized 68000 opcode handlers, then exit" },
+	{ OPTION_RENDER_BENCHMARK,                           "0",         OPTION_BOOLEAN,    "benchmark the software renderer on the last frame at exit" },
+	{ OPTION_VOODOO_JIT,                                 "0",         OPTION_INTEGER,    "compile Voodoo rasterizers that aren't precompiled (1), and check them against the generic ones (2)" },
 	{ OPTION_BIOS,                                       nullptr,        OPTION_STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         OPTION_BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         OPTION_BOOLEAN,    "skip displaying the information screen at startup" },
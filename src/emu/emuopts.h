@@ -68,10 +68,12 @@ enum
 #define OPTION_SNAPSHOT_DIRECTORY   "snapshot_directory"
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
+#define OPTION_DRC_CACHE_DIRECTORY  "drc_cache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
+#define OPTION_REWIND               "rewind"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
@@ -97,6 +99,8 @@ enum
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
+#define OPTION_PARALLEL_EXEC        "parallelexec"
+#define OPTION_BENCHMARK_REPORT     "benchmark_report"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -141,6 +145,8 @@ enum
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
 #define OPTION_VOLUME               "volume"
+#define OPTION_FLOAT_MIXING         "floatmix"
+#define OPTION_SOUND_COMPARE        "soundcompare"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -176,13 +182,24 @@ enum
 #define OPTION_VERBOSE              "verbose"
 #define OPTION_OSLOG                "oslog"
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
+#define OPTION_MEMSTATS             "memstats"
+#define OPTION_EXECSTATS            "execstats"
 #define OPTION_DEBUGSCRIPT          "debugscript"
 
 // core misc options
 #define OPTION_DRC                  "drc"
+#define OPTION_DRC_EXPERIMENTAL     "drc_experimental"
 #define OPTION_DRC_USE_C            "drc_use_c"
+#define OPTION_DRC_OPTIMIZE         "drc_optimize"
+#define OPTION_DRC_TRACES           "drc_traces"
+#define OPTION_DRC_CACHE            "drc_cache"
+#define OPTION_DRC_EVICT            "drc_evict"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_VALIDATE         "drc_validate"
+#define OPTION_M68K_BENCHMARK       "m68k_benchmark"
+#define OPTION_RENDER_BENCHMARK     "render_benchmark"
+#define OPTION_VOODOO_JIT           "voodoo_jit"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -263,10 +280,12 @@ public:
 	const char *snapshot_directory() const { return value(OPTION_SNAPSHOT_DIRECTORY); }
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
+	const char *drc_cache_directory() const { return value(OPTION_DRC_CACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	int rewind() const { return int_value(OPTION_REWIND); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
@@ -292,6 +311,8 @@ public:
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
+	bool parallel_exec() const { return bool_value(OPTION_PARALLEL_EXEC); }
+	const char *benchmark_report() const { return value(OPTION_BENCHMARK_REPORT); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -336,6 +357,8 @@ public:
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
 	int volume() const { return int_value(OPTION_VOLUME); }
+	bool float_mixing() const { return bool_value(OPTION_FLOAT_MIXING); }
+	bool sound_compare() const { return bool_value(OPTION_SOUND_COMPARE); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -370,12 +393,23 @@ public:
 	bool oslog() const { return bool_value(OPTION_OSLOG); }
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
+	bool mem_stats() const { return bool_value(OPTION_MEMSTATS); }
+	int exec_stats() const { return int_value(OPTION_EXECSTATS); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
+	bool drc_experimental() const { return bool_value(OPTION_DRC_EXPERIMENTAL); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
+	bool drc_optimize() const { return bool_value(OPTION_DRC_OPTIMIZE); }
+	bool drc_traces() const { return bool_value(OPTION_DRC_TRACES); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
+	bool drc_evict() const { return bool_value(OPTION_DRC_EVICT); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_validate() const { return bool_value(OPTION_DRC_VALIDATE); }
+	bool m68k_benchmark() const { return bool_value(OPTION_M68K_BENCHMARK); }
+	bool render_benchmark() const { return bool_value(OPTION_RENDER_BENCHMARK); }
+	int voodoo_jit() const { return int_value(OPTION_VOODOO_JIT); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -779,6 +779,27 @@ luabridge::LuaRef lua_engine::l_dev_get_items(const device_t *d)
 	return table;
 }
 
+//-------------------------------------------------
+//  device_get_exec_stats - return table of host time accounting for executing devices
+//  -> manager:machine().devices[":maincpu"].exec_stats
+//-------------------------------------------------
+
+luabridge::LuaRef lua_engine::l_dev_get_exec_stats(const device_t *d)
+{
+	lua_State *L = luaThis->m_lua_state;
+	luabridge::LuaRef table = luabridge::LuaRef::newTable(L);
+
+	device_execute_interface *exec;
+	if (!d->interface(exec))
+		return table;
+
+	table["cycles"] = exec->host_cycles();
+	table["timeslices"] = exec->timeslices();
+	table["host_seconds"] = exec->host_seconds();
+	table["cycles_per_second"] = exec->host_cycles_per_second();
+	return table;
+}
+
 lua_engine::lua_item::lua_item(int index)
 {
 	std::string name;
@@ -2179,6 +2200,7 @@ void lua_engine::initialize()
 				.addFunction ("soft_reset", &running_machine::schedule_soft_reset)
 				.addFunction ("save", &running_machine::schedule_save)
 				.addFunction ("load", &running_machine::schedule_load)
+				.addFunction ("rewind", &running_machine::schedule_rewind)
 				.addFunction ("system", &running_machine::system)
 				.addFunction ("video", &running_machine::video)
 				.addFunction ("ui", &running_machine::ui)
@@ -2211,6 +2233,7 @@ void lua_engine::initialize()
 				.addProperty <luabridge::LuaRef, void> ("spaces", &lua_engine::l_dev_get_memspaces)
 				.addProperty <luabridge::LuaRef, void> ("state", &lua_engine::l_dev_get_states)
 				.addProperty <luabridge::LuaRef, void> ("items", &lua_engine::l_dev_get_items)
+				.addProperty <luabridge::LuaRef, void> ("exec_stats", &lua_engine::l_dev_get_exec_stats)
 			.endClass()
 			.beginClass <cheat_manager> ("cheat")
 				.addProperty <bool, bool> ("enabled", &cheat_manager::enabled, &cheat_manager::set_enable)
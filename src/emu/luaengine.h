@@ -184,6 +184,7 @@ private:
 		int l_draw_text(lua_State *L);
 	};
 	static luabridge::LuaRef l_dev_get_items(const device_t *d);
+	static luabridge::LuaRef l_dev_get_exec_stats(const device_t *d);
 
 	struct lua_video {
 		int l_begin_recording(lua_State *L);
@@ -84,6 +84,7 @@
 #include "image.h"
 #include "luaengine.h"
 #include "network.h"
+#include "benchrep.h"
 #include <time.h>
 
 #if defined(EMSCRIPTEN)
@@ -127,6 +128,8 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_saveload_schedule(SLS_NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
+		m_rewind_pending(false),
+		m_rewind_frames(-1),
 
 		m_save(*this),
 		m_memory(*this),
@@ -243,6 +246,10 @@ void running_machine::start()
 	if (newbase != 0)
 		m_base_time = newbase;
 
+	// benchmark runs start from a fixed date so RTCs behave the same every time
+	else if (manager().benchmark() != nullptr)
+		m_base_time = 946684800; // 2000-01-01 00:00:00 UTC
+
 	// initialize the streams engine before the sound devices start
 	m_sound = std::make_unique<sound_manager>(*this);
 
@@ -290,6 +297,15 @@ void running_machine::start()
 	start_all_devices();
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
 
+	// count per-device host time from here, and log it periodically if requested
+	m_scheduler.reset_execute_stats();
+	if (options().exec_stats() > 0)
+		m_scheduler.start_execute_stats_log(attotime::from_seconds(options().exec_stats()));
+
+	// start measuring if we're part of a benchmark run
+	if (manager().benchmark() != nullptr)
+		manager().benchmark()->machine_start(*this);
+
 	// if we're coming in with a savegame request, process it now
 	const char *savegame = options().state();
 	if (savegame[0] != 0)
@@ -349,6 +365,13 @@ int running_machine::run(bool firstrun)
 		// devices with timers.
 		m_save.allow_registration(false);
 
+		// set up the rewind buffer now that the state layout is fixed
+		if (options().rewind() > 0)
+		{
+			m_save.rewind_init(options().rewind());
+			add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(running_machine::rewind_frame), this));
+		}
+
 		nvram_load();
 		sound().ui_mute(false);
 
@@ -390,6 +413,10 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// capture or restore rewind frames
+			if (m_rewind_pending)
+				handle_rewind();
+
 			g_profiler.stop();
 		}
 
@@ -901,6 +928,57 @@ void running_machine::handle_saveload()
 }
 
 
+//-------------------------------------------------
+//  schedule_rewind - schedule a step back of the
+//  given number of frames through the rewind
+//  buffer
+//-------------------------------------------------
+
+void running_machine::schedule_rewind(int frames)
+{
+	m_rewind_frames = std::max(frames, 0);
+	m_rewind_pending = true;
+}
+
+
+//-------------------------------------------------
+//  rewind_frame - request a rewind capture at
+//  the end of each emulated frame
+//-------------------------------------------------
+
+void running_machine::rewind_frame()
+{
+	if (!m_paused)
+		m_rewind_pending = true;
+}
+
+
+//-------------------------------------------------
+//  handle_rewind - capture the current frame into
+//  the rewind buffer, or step back through it
+//-------------------------------------------------
+
+void running_machine::handle_rewind()
+{
+	// anonymous timers can't be captured; try again after the next timeslice
+	if (!m_scheduler.can_save())
+		return;
+
+	if (m_rewind_frames >= 0)
+	{
+		if (!m_save.rewind_enabled())
+			popmessage("Error: Rewind is not enabled (see -rewind).");
+		else if (m_save.rewind_restore(m_rewind_frames) != STATERR_NONE)
+			popmessage("Error: Unable to rewind %d frames; %d available.", m_rewind_frames, int(m_save.rewind_count()) - 1);
+		m_rewind_frames = -1;
+	}
+	else
+		m_save.rewind_capture();
+
+	m_rewind_pending = false;
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -230,6 +230,7 @@ public:
 	void schedule_soft_reset();
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_rewind(int frames);
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -269,6 +270,8 @@ private:
 	void set_saveload_filename(const char *filename);
 	std::string get_statename(const char *statename_opt) const;
 	void handle_saveload();
+	void handle_rewind();
+	void rewind_frame();
 	void soft_reset(void *ptr = nullptr, INT32 param = 0);
 	void watchdog_fired(void *ptr = nullptr, INT32 param = 0);
 	void watchdog_vblank(screen_device &screen, bool vblank_state);
@@ -346,6 +349,10 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	// rewind management
+	bool                    m_rewind_pending;       // capture or restore at the next safe point
+	int                     m_rewind_frames;        // frames to step back, or -1 to capture
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
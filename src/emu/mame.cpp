@@ -113,7 +113,8 @@ machine_manager::machine_manager(emu_options &options,osd_interface &osd)
 		m_plugins(std::make_unique<plugin_options>()),
 		m_lua(global_alloc(lua_engine)),
 		m_new_driver_pending(nullptr),
-		m_machine(nullptr)
+		m_machine(nullptr),
+		m_benchmark(nullptr)
 {
 }
 
@@ -61,6 +61,7 @@ public:
 };
 
 class lua_engine;
+class benchmark_report;
 
 // ======================> machine_manager
 
@@ -84,6 +85,9 @@ public:
 
 	void set_machine(running_machine *machine) { m_machine = machine; }
 
+	benchmark_report *benchmark() const { return m_benchmark; }
+	void set_benchmark(benchmark_report *report) { m_benchmark = report; }
+
 	void update_machine();
 
 	/* execute as configured by the OPTION_SYSTEMNAME option on the specified options */
@@ -99,6 +103,7 @@ private:
 	const game_driver *     m_new_driver_pending;   // pointer to the next pending driver
 
 	running_machine *m_machine;
+	benchmark_report *      m_benchmark;            // report collecting results from -benchmark, if any
 	static machine_manager* m_manager;
 };
 
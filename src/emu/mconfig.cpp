@@ -23,6 +23,7 @@
 
 machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 	: m_minimum_quantum(attotime::zero),
+		m_parallel_execution(false),
 		m_watchdog_vblank_count(0),
 		m_watchdog_time(attotime::zero),
 		m_default_layout(nullptr),
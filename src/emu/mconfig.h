@@ -68,6 +68,7 @@ public:
 	// public state
 	attotime                m_minimum_quantum;          // minimum scheduling quantum
 	std::string             m_perfect_cpu_quantum;      // tag of CPU to use for "perfect" scheduling
+	bool                    m_parallel_execution;       // allow device parallel groups to execute concurrently
 	INT32                   m_watchdog_vblank_count;    // number of VBLANKs until the watchdog kills us
 	attotime                m_watchdog_time;            // length of time until the watchdog kills us
 
@@ -198,6 +199,8 @@ References an external machine config.
 	config.m_minimum_quantum = _time;
 #define MCFG_QUANTUM_PERFECT_CPU(_cputag) \
 	config.m_perfect_cpu_quantum = owner->subtag(_cputag);
+#define MCFG_QUANTUM_PARALLEL_EXECUTION() \
+	config.m_parallel_execution = true;
 
 // watchdog configuration
 #define MCFG_WATCHDOG_VBLANK_INIT(_count) \
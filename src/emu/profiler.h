@@ -94,6 +94,7 @@ public:
 		return m_filoptr != nullptr;
 	}
 	const char *text(running_machine &machine);
+	osd_ticks_t data(profile_type type) const { return m_data[type]; }
 
 	// enable/disable
 	void enable(bool state = true)
@@ -185,6 +186,7 @@ public:
 	// getters
 	bool enabled() const { return false; }
 	const char *text(running_machine &machine) { return ""; }
+	osd_ticks_t data(profile_type type) const { return 0; }
 
 	// enable/disable
 	void enable(bool state = true) { }
@@ -212,4 +214,12 @@ typedef dummy_profiler_state profiler_state;
 extern profiler_state g_profiler;
 
 
+
+//**************************************************************************
+//  FUNCTION PROTOTYPES
+//**************************************************************************
+
+const char *profile_type_name(profile_type type);
+
+
 #endif  /* __PROFILER_H__ */
@@ -316,6 +316,44 @@ void render_primitive_list::append_or_return(render_primitive &prim, bool clippe
 
 
 
+//**************************************************************************
+//  RENDER TEXINFO
+//**************************************************************************
+
+//-------------------------------------------------
+//  refresh - bring an OSD copy of a texture up
+//  to date with src; returns false if the copy
+//  is already current, otherwise the range of
+//  rows that need to be re-uploaded
+//-------------------------------------------------
+
+bool render_texinfo::refresh(const render_texinfo &src, INT32 &miny, INT32 &maxy)
+{
+	if (seqid == src.seqid)
+		return false;
+
+	// row tracking only holds if we saw the previous version through the same palette
+	bool tracked = (content_seqid != 0 && src.content_seqid != 0 && palette == src.palette && palette_serial == src.palette_serial);
+
+	miny = 0;
+	maxy = src.height - 1;
+	if (tracked && src.content_seqid == content_seqid)
+		maxy = -1;
+	else if (tracked && src.content_seqid == content_seqid + 1)
+	{
+		miny = MAX(src.dirty_min_y, 0);
+		maxy = MIN(src.dirty_max_y, INT32(src.height) - 1);
+	}
+
+	seqid = src.seqid;
+	palette = src.palette;
+	palette_serial = src.palette_serial;
+	content_seqid = src.content_seqid;
+	return (miny <= maxy);
+}
+
+
+
 //**************************************************************************
 //  RENDER TEXTURE
 //**************************************************************************
@@ -330,11 +368,14 @@ render_texture::render_texture()
 		m_bitmap(nullptr),
 		m_format(TEXFORMAT_ARGB32),
 		m_osddata(~0L),
+		m_content_seq(0),
+		m_track_dirty(false),
 		m_scaler(nullptr),
 		m_param(nullptr),
 		m_curseq(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
+	m_dirty.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
 }
 
@@ -388,6 +429,7 @@ void render_texture::release()
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
 	m_curseq = 0;
+	m_track_dirty = false;
 }
 
 
@@ -395,7 +437,7 @@ void render_texture::release()
 //  set_bitmap - set a new source bitmap
 //-------------------------------------------------
 
-void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format)
+void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle *dirty)
 {
 	assert(bitmap.cliprect().contains(sbounds));
 
@@ -407,11 +449,21 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (&bitmap != m_bitmap && m_bitmap != nullptr)
 		m_manager->invalidate_all(m_bitmap);
 
+	// a dirty region only means something relative to the same source
+	m_track_dirty = (dirty != nullptr && &bitmap == m_bitmap && sbounds == m_sbounds && format == m_format);
+	m_dirty = m_track_dirty ? *dirty : sbounds;
+	m_dirty &= sbounds;
+	m_content_seq++;
+
 	// set the new bitmap/palette
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
 	m_format = format;
 
+	// scaled versions are still good if nothing changed
+	if (m_track_dirty && m_dirty.empty())
+		return;
+
 	// invalidate all scaled versions
 	for (auto & elem : m_scaled)
 	{
@@ -466,6 +518,11 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.height = sheight;
 		// palette will be set later
 		texinfo.seqid = ++m_curseq;
+
+		// let the OSD limit its upload to what changed since the previous version
+		texinfo.content_seqid = m_track_dirty ? m_content_seq : 0;
+		texinfo.dirty_min_y = m_dirty.min_y - m_sbounds.min_y;
+		texinfo.dirty_max_y = m_dirty.max_y - m_sbounds.min_y;
 	}
 	else
 	{
@@ -520,7 +577,11 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		texinfo.height = dheight;
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
+		texinfo.content_seqid = 0;
+		texinfo.dirty_min_y = 0;
+		texinfo.dirty_max_y = dheight - 1;
 	}
+	texinfo.palette_serial = 0;
 }
 
 
@@ -573,7 +634,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 		m_manager(manager),
 		m_screen(screen),
 		m_overlaybitmap(nullptr),
-		m_overlaytexture(nullptr)
+		m_overlaytexture(nullptr),
+		m_lookup_serial(0)
 {
 	// make sure it is empty
 	empty();
@@ -799,6 +861,8 @@ render_container::item &render_container::add_generic(UINT8 type, float x0, floa
 
 void render_container::recompute_lookups()
 {
+	m_lookup_serial++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -851,6 +915,8 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_lookup_serial++;
+
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -1863,6 +1929,7 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 
 					// set the palette
 					prim->texture.palette = curitem.texture()->get_adjusted_palette(container);
+					prim->texture.palette_serial = container.lookup_serial();
 
 					// determine UV coordinates
 					prim->texcoords = oriented_texcoords[finalorient];
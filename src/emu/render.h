@@ -221,6 +221,13 @@ struct render_texinfo
 	UINT32              seqid;              // sequence ID
 	UINT64              osddata;            // aux data to pass to osd
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
+	UINT32              palette_serial;     // bumped whenever the palette/lookup table contents change
+	UINT32              content_seqid;      // version of the source pixels (0 if not tracked)
+	INT32               dirty_min_y;        // first row changed since version content_seqid - 1
+	INT32               dirty_max_y;        // last row changed since version content_seqid - 1
+
+	// record that a copy of this texture is being brought up to date with another
+	bool refresh(const render_texinfo &src, INT32 &miny, INT32 &maxy);
 };
 
 
@@ -441,8 +448,8 @@ public:
 	int format() const { return m_format; }
 	render_manager *manager() const { return m_manager; }
 
-	// configure the texture bitmap
-	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format);
+	// configure the texture bitmap; dirty, if given, bounds what changed since the previous call
+	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle *dirty = nullptr);
 
 	// set any necessary aux data
 	void set_osd_data(UINT64 data) { m_osddata = data; }
@@ -471,6 +478,9 @@ private:
 	rectangle           m_sbounds;                  // source bounds within the bitmap
 	texture_format      m_format;                   // format of the texture data
 	UINT64              m_osddata;                  // aux data to pass to osd
+	UINT32              m_content_seq;              // version of the bitmap contents
+	bool                m_track_dirty;              // true if m_dirty is known for the current version
+	rectangle           m_dirty;                    // region changed since the previous version
 
 	// scaling state (ARGB32 only)
 	texture_scaler_func m_scaler;                   // scaling callback
@@ -541,6 +551,7 @@ public:
 
 	// brightness/contrast/gamma helpers
 	bool has_brightness_contrast_gamma_changes() const { return (m_user.m_brightness != 1.0f || m_user.m_contrast != 1.0f || m_user.m_gamma != 1.0f); }
+	UINT32 lookup_serial() const { return m_lookup_serial; }
 	UINT8 apply_brightness_contrast_gamma(UINT8 value);
 	float apply_brightness_contrast_gamma_fp(float value);
 	const rgb_t *bcg_lookup_table(int texformat, palette_t *palette = nullptr);
@@ -598,6 +609,7 @@ private:
 	std::unique_ptr<palette_client> m_palclient;       // client to the screen palette
 	std::vector<rgb_t>           m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	UINT32                  m_lookup_serial;        // bumped whenever the lookup tables change
 };
 
 
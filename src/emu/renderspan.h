@@ -0,0 +1,219 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    renderspan.h
+
+    Span kernels used by the software renderer for its two hottest cases
+    when drawing to a standard xRGB 32bpp target: an unfiltered scaled
+    copy of a 32bpp texture, and an unfiltered scaled ARGB32 alpha blend.
+    Each kernel produces exactly the same pixels as the per-pixel loops
+    in rendersw.inc.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RENDERSPAN_H__
+#define __RENDERSPAN_H__
+
+#include <string.h>
+
+/* use SSE on 64-bit implementations, where it can be assumed; AVX2 only when the build asks for it */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define RENDERSPAN_SSE2     1
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define RENDERSPAN_AVX2     1
+#include <immintrin.h>
+#endif
+#endif
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> render_span
+
+class render_span
+{
+public:
+	// copy count texels stepping by 16.16 dudx/dvdx; dest is xRGB, the source
+	// pixels are stored unchanged
+	static void copy_scaled(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		// horizontal spans keep to a single source row
+		if (dvdx == 0)
+		{
+			const UINT32 *texrow = texbase + (curv >> 16) * rowpixels;
+
+			// unscaled spans are a straight copy
+			if (dudx == 0x10000)
+			{
+				if (count > 0)
+					memcpy(dest, texrow + (curu >> 16), count * sizeof(*dest));
+				return;
+			}
+
+#if defined(RENDERSPAN_AVX2)
+			const __m256i vdudx = _mm256_set1_epi32(dudx * 8);
+			__m256i vu = _mm256_add_epi32(_mm256_set1_epi32(curu), _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(dudx)));
+			for ( ; count >= 8; count -= 8, dest += 8, curu += dudx * 8)
+			{
+				__m256i pix = _mm256_i32gather_epi32(reinterpret_cast<const int *>(texrow), _mm256_srai_epi32(vu, 16), 4);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), pix);
+				vu = _mm256_add_epi32(vu, vdudx);
+			}
+#endif
+
+			for ( ; count > 0; count--, curu += dudx)
+				*dest++ = texrow[curu >> 16];
+			return;
+		}
+
+#if defined(RENDERSPAN_AVX2)
+		const __m256i vrowpixels = _mm256_set1_epi32(rowpixels);
+		const __m256i vdudx = _mm256_set1_epi32(dudx * 8);
+		const __m256i vdvdx = _mm256_set1_epi32(dvdx * 8);
+		const __m256i vstep = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		__m256i vu = _mm256_add_epi32(_mm256_set1_epi32(curu), _mm256_mullo_epi32(vstep, _mm256_set1_epi32(dudx)));
+		__m256i vv = _mm256_add_epi32(_mm256_set1_epi32(curv), _mm256_mullo_epi32(vstep, _mm256_set1_epi32(dvdx)));
+		for ( ; count >= 8; count -= 8, dest += 8, curu += dudx * 8, curv += dvdx * 8)
+		{
+			__m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(vv, 16), vrowpixels), _mm256_srai_epi32(vu, 16));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), _mm256_i32gather_epi32(reinterpret_cast<const int *>(texbase), index, 4));
+			vu = _mm256_add_epi32(vu, vdudx);
+			vv = _mm256_add_epi32(vv, vdvdx);
+		}
+#endif
+
+		copy_scaled_scalar(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+
+	// portable version of copy_scaled, also used for the tail of each span
+	static void copy_scaled_scalar(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		for ( ; count > 0; count--, curu += dudx, curv += dvdx)
+			*dest++ = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+	}
+
+	// blend count ARGB32 texels over dest by their own alpha; dest pixels under
+	// a zero alpha are left alone, and blended ones come out with a zero top byte
+	static void blend_scaled(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+#if defined(RENDERSPAN_AVX2)
+		const __m256i vrowpixels = _mm256_set1_epi32(rowpixels);
+		const __m256i vdudx = _mm256_set1_epi32(dudx * 8);
+		const __m256i vdvdx = _mm256_set1_epi32(dvdx * 8);
+		const __m256i vstep = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		__m256i vu = _mm256_add_epi32(_mm256_set1_epi32(curu), _mm256_mullo_epi32(vstep, _mm256_set1_epi32(dudx)));
+		__m256i vv = _mm256_add_epi32(_mm256_set1_epi32(curv), _mm256_mullo_epi32(vstep, _mm256_set1_epi32(dvdx)));
+		for ( ; count >= 8; count -= 8, dest += 8, curu += dudx * 8, curv += dvdx * 8)
+		{
+			__m256i index = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(vv, 16), vrowpixels), _mm256_srai_epi32(vu, 16));
+			__m256i src = _mm256_i32gather_epi32(reinterpret_cast<const int *>(texbase), index, 4);
+			vu = _mm256_add_epi32(vu, vdudx);
+			vv = _mm256_add_epi32(vv, vdvdx);
+
+			// artwork is mostly clear, so skip groups that leave the destination alone
+			if (_mm256_testz_si256(src, _mm256_set1_epi32(0xff000000)))
+				continue;
+			__m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dest));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), blend8(src, dst));
+		}
+#elif defined(RENDERSPAN_SSE2)
+		// SSE2 has no gather, so fetch four texels by hand and blend them together
+		for ( ; count >= 4; count -= 4, dest += 4)
+		{
+			UINT32 pix0 = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+			curu += dudx, curv += dvdx;
+			UINT32 pix1 = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+			curu += dudx, curv += dvdx;
+			UINT32 pix2 = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+			curu += dudx, curv += dvdx;
+			UINT32 pix3 = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+			curu += dudx, curv += dvdx;
+
+			// artwork is mostly clear, so skip groups that leave the destination alone
+			if (((pix0 | pix1 | pix2 | pix3) >> 24) == 0)
+				continue;
+			__m128i src = _mm_setr_epi32(pix0, pix1, pix2, pix3);
+			__m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), blend4(src, dst));
+		}
+#endif
+
+		blend_scaled_scalar(dest, texbase, rowpixels, curu, curv, dudx, dvdx, count);
+	}
+
+	// portable version of blend_scaled, also used for the tail of each span
+	static void blend_scaled_scalar(UINT32 *dest, const UINT32 *texbase, UINT32 rowpixels, INT32 curu, INT32 curv, INT32 dudx, INT32 dvdx, INT32 count)
+	{
+		for ( ; count > 0; count--, dest++, curu += dudx, curv += dvdx)
+		{
+			UINT32 pix = texbase[(curv >> 16) * rowpixels + (curu >> 16)];
+			UINT32 ta = pix >> 24;
+			if (ta != 0)
+			{
+				UINT32 dpix = *dest;
+				UINT32 invta = 0x100 - ta;
+				UINT32 r = (((pix >> 16) & 0xff) * ta + ((dpix >> 16) & 0xff) * invta) >> 8;
+				UINT32 g = (((pix >> 8) & 0xff) * ta + ((dpix >> 8) & 0xff) * invta) >> 8;
+				UINT32 b = ((pix & 0xff) * ta + (dpix & 0xff) * invta) >> 8;
+				*dest = (r << 16) | (g << 8) | b;
+			}
+		}
+	}
+
+private:
+#if defined(RENDERSPAN_SSE2)
+	// blend four pixels in 16-bit lanes; s*ta + d*(0x100-ta) tops out at 0xff00, so
+	// the unsigned sums never wrap
+	static inline __m128i blend4(__m128i src, __m128i dst)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i ta = _mm_srli_epi32(src, 24);
+		__m128i skip = _mm_cmpeq_epi32(ta, zero);
+		ta = _mm_or_si128(ta, _mm_slli_epi32(ta, 16));
+		__m128i invta = _mm_sub_epi16(_mm_set1_epi16(0x100), ta);
+
+		__m128i talo = _mm_unpacklo_epi32(ta, ta);
+		__m128i tahi = _mm_unpackhi_epi32(ta, ta);
+		__m128i invtalo = _mm_unpacklo_epi32(invta, invta);
+		__m128i invtahi = _mm_unpackhi_epi32(invta, invta);
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(src, zero), talo), _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), invtalo));
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(src, zero), tahi), _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), invtahi));
+		__m128i result = _mm_and_si128(_mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)), _mm_set1_epi32(0x00ffffff));
+
+		// keep the destination wherever the texel was fully transparent
+		return _mm_or_si128(_mm_and_si128(skip, dst), _mm_andnot_si128(skip, result));
+	}
+#endif
+
+#if defined(RENDERSPAN_AVX2)
+	// eight-pixel version of blend4; the unpacks and packs stay within each
+	// 128-bit half, so the pixel order comes back out unchanged
+	static inline __m256i blend8(__m256i src, __m256i dst)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i ta = _mm256_srli_epi32(src, 24);
+		__m256i skip = _mm256_cmpeq_epi32(ta, zero);
+		ta = _mm256_or_si256(ta, _mm256_slli_epi32(ta, 16));
+		__m256i invta = _mm256_sub_epi16(_mm256_set1_epi16(0x100), ta);
+
+		__m256i talo = _mm256_unpacklo_epi32(ta, ta);
+		__m256i tahi = _mm256_unpackhi_epi32(ta, ta);
+		__m256i invtalo = _mm256_unpacklo_epi32(invta, invta);
+		__m256i invtahi = _mm256_unpackhi_epi32(invta, invta);
+		__m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(src, zero), talo), _mm256_mullo_epi16(_mm256_unpacklo_epi8(dst, zero), invtalo));
+		__m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(src, zero), tahi), _mm256_mullo_epi16(_mm256_unpackhi_epi8(dst, zero), invtahi));
+		__m256i result = _mm256_and_si256(_mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8)), _mm256_set1_epi32(0x00ffffff));
+
+		return _mm256_blendv_epi8(result, dst, skip);
+	}
+#endif
+};
+
+
+#endif  /* __RENDERSPAN_H__ */
@@ -0,0 +1,251 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    resampler.h
+
+    Block kernels used by sound_stream to convert an input stream to the
+    sample rate of the stream consuming it. The equal-rate kernel is a
+    block gain pass done with SIMD where available (and a plain copy at
+    unity gain); the undersampled kernel scales each input sample once
+    rather than once per output sample.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RESAMPLER_H__
+#define __RESAMPLER_H__
+
+#include <algorithm>
+#include <string.h>
+
+/* use SSE on 64-bit implementations, where it can be assumed */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define RESAMPLER_SSE2      1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RESAMPLER_NEON      1
+#include <arm_neon.h>
+#endif
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> stream_resampler
+
+class stream_resampler
+{
+public:
+	// constants
+	static const UINT32 FRAC_BITS               = 22;
+	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
+	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
+
+	// apply an 8.8 fixed-point gain: dest[i] = (source[i] * gain) >> 8; dest may equal source
+	static void apply_gain(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, INT64 gain)
+	{
+		// unity gain is the common case
+		if (gain == 0x100)
+		{
+			if (dest != source)
+				memcpy(dest, source, numsamples * sizeof(*dest));
+			return;
+		}
+
+#if defined(RESAMPLER_SSE2)
+		// SSE2 has no signed 32x32->64 multiply, so multiply unsigned and subtract
+		// gain << 32 from the product of each negative sample; only bits 8-39 are kept
+		if (gain >= 0 && gain <= 0xffffffff)
+		{
+			const __m128i vgain = _mm_set1_epi32(UINT32(gain));
+			const __m128i lomask = _mm_set_epi32(0, -1, 0, -1);
+			for ( ; numsamples >= 4; numsamples -= 4, source += 4, dest += 4)
+			{
+				__m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+				__m128i corr = _mm_and_si128(_mm_srai_epi32(in, 31), vgain);
+				__m128i even = _mm_sub_epi64(_mm_mul_epu32(in, vgain), _mm_slli_epi64(corr, 32));
+				__m128i odd = _mm_sub_epi64(_mm_mul_epu32(_mm_srli_epi64(in, 32), vgain), _mm_andnot_si128(lomask, corr));
+				even = _mm_and_si128(_mm_srli_epi64(even, 8), lomask);
+				odd = _mm_slli_epi64(_mm_srli_epi64(odd, 8), 32);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_or_si128(even, odd));
+			}
+		}
+#elif defined(RESAMPLER_NEON)
+		// NEON multiplies signed 32x32->64 and narrows with a shift directly
+		if (gain >= -0x80000000LL && gain <= 0x7fffffff)
+		{
+			const int32x2_t vgain = vdup_n_s32(INT32(gain));
+			for ( ; numsamples >= 4; numsamples -= 4, source += 4, dest += 4)
+			{
+				int32x4_t in = vld1q_s32(source);
+				int32x2_t lo = vshrn_n_s64(vmull_s32(vget_low_s32(in), vgain), 8);
+				int32x2_t hi = vshrn_n_s64(vmull_s32(vget_high_s32(in), vgain), 8);
+				vst1q_s32(dest, vcombine_s32(lo, hi));
+			}
+		}
+#endif
+
+		apply_gain_scalar(dest, source, numsamples, gain);
+	}
+
+	// portable version of apply_gain, also used for the tail of each block
+	static void apply_gain_scalar(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, INT64 gain)
+	{
+		while (numsamples--)
+			*dest++ = (*source++ * gain) >> 8;
+	}
+
+	// equal sample rates: just copy with gain
+	static void resample_equal(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, INT64 gain)
+	{
+		apply_gain(dest, source, numsamples, gain);
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	static void resample_up(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+	{
+		while (numsamples != 0)
+		{
+			// fill in with point samples until we hit a boundary; they all share one scaled value
+			stream_sample_t point = (source[0] * gain) >> 8;
+			UINT32 nextfrac;
+			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples != 0)
+			{
+				*dest++ = point;
+				numsamples--;
+				basefrac = nextfrac;
+			}
+
+			// if we're done, we're done
+			if (numsamples == 0)
+				break;
+
+			// compute starting and ending fractional positions
+			int startfrac = basefrac >> (FRAC_BITS - 12);
+			int endfrac = nextfrac >> (FRAC_BITS - 12);
+
+			// blend between the two samples accordingly
+			INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+			numsamples--;
+
+			// advance
+			basefrac = nextfrac & FRAC_MASK;
+			source++;
+		}
+	}
+
+	// floating-point version of the kernels, for streams that opt into it; the
+	// source may be either format, and the gain is a plain multiplier
+	template<typename _SourceType>
+	static void resample_float(stream_float_t *dest, const _SourceType *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, float gain)
+	{
+		// equal sample rates: just copy with gain
+		if (step == FRAC_ONE)
+		{
+			for (UINT32 index = 0; index < numsamples; index++)
+				dest[index] = float(source[index]) * gain;
+		}
+
+		// input is undersampled: point sample except where our sample period covers a boundary
+		else if (step < FRAC_ONE)
+		{
+			while (numsamples != 0)
+			{
+				stream_float_t point = float(source[0]) * gain;
+				UINT32 nextfrac;
+				while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples != 0)
+				{
+					*dest++ = point;
+					numsamples--;
+					basefrac = nextfrac;
+				}
+				if (numsamples == 0)
+					break;
+
+				// blend with the same 12-bit weights as the integer kernel
+				int startfrac = basefrac >> (FRAC_BITS - 12);
+				int endfrac = nextfrac >> (FRAC_BITS - 12);
+				*dest++ = (float(source[0]) * float(0x1000 - startfrac) + float(source[1]) * float(endfrac - 0x1000)) * gain / float(endfrac - startfrac);
+				numsamples--;
+
+				basefrac = nextfrac & FRAC_MASK;
+				source++;
+			}
+		}
+
+		// input is oversampled: sum the energy
+		else
+		{
+			int smallstep = step >> (FRAC_BITS - 8);
+			float scalegain = gain / float(smallstep);
+			while (numsamples--)
+			{
+				int scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+				float sample = float(source[0]) * float(scale);
+				int remainder = smallstep - scale;
+
+				const _SourceType *tail = source + 1;
+				float middle = 0;
+				for ( ; remainder > 0x100; remainder -= 0x100)
+					middle += float(*tail++);
+				sample += middle * 256.0f + float(*tail) * float(remainder);
+				*dest++ = sample * scalegain;
+
+				basefrac += step;
+				source += basefrac >> FRAC_BITS;
+				basefrac &= FRAC_MASK;
+			}
+		}
+	}
+
+	// convert floating-point samples for an integer consumer, saturating at the limits of stream_sample_t
+	static void float_to_int(stream_sample_t *dest, const stream_float_t *source, UINT32 numsamples)
+	{
+		while (numsamples--)
+		{
+			stream_float_t sample = *source++;
+			if (sample >= 2147483648.0f)
+				*dest++ = 0x7fffffff;
+			else if (sample < -2147483648.0f)
+				*dest++ = -0x7fffffff - 1;
+			else
+				*dest++ = stream_sample_t(sample);
+		}
+	}
+
+	// input is oversampled: sum the energy
+	static void resample_down(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+	{
+		// use 8 bits to allow some extra headroom
+		int smallstep = step >> (FRAC_BITS - 8);
+		while (numsamples--)
+		{
+			// weight the partial first sample
+			int scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+			INT64 sample = (INT64) source[0] * scale;
+			int remainder = smallstep - scale;
+
+			// whole samples in the middle all have the same weight, so sum them first
+			const stream_sample_t *tail = source + 1;
+			INT64 middle = 0;
+			for ( ; remainder > 0x100; remainder -= 0x100)
+				middle += *tail++;
+			sample += middle * 0x100;
+
+			// weight the partial last sample
+			sample += (INT64) *tail * remainder;
+			*dest++ = ((sample / smallstep) * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+};
+
+#endif  /* __RESAMPLER_H__ */
@@ -11,11 +11,22 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Number of chunks
+    24..    Chunk index: uncompressed and stored size of each chunk
+    ..end   Chunk data
+
+    The registered entries are laid end to end and split into chunks of
+    CHUNK_SIZE bytes, each of which is zlib-compressed on its own so that
+    chunks can be compressed and decompressed in parallel. A chunk whose
+    stored size equals its uncompressed size is stored raw. Sizes in the
+    index are little-endian.
+
+    Format 2 files, in which everything after the header is a single
+    zlib stream, can still be loaded.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
@@ -25,6 +36,8 @@
 #include "emu.h"
 #include "coreutil.h"
 
+#include <zlib.h>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -40,9 +53,17 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int SAVE_VERSION_STREAM = 2;
 const int HEADER_SIZE       = 32;
 
+// size of each independently compressed chunk
+const UINT32 CHUNK_SIZE     = 1 << 20;
+
+// granularity of rewind deltas; small enough that a few changed bytes in
+// a large RAM don't cost much, large enough to keep the block list short
+const UINT32 REWIND_BLOCK_SIZE = 256;
+
 // Available flags
 enum
 {
@@ -62,11 +83,30 @@ enum
 save_manager::save_manager(running_machine &machine)
 	: m_machine(machine),
 		m_reg_allowed(true),
-		m_illegal_regs(0)
+		m_illegal_regs(0),
+		m_work_queue(nullptr),
+		m_rewind_first(0),
+		m_rewind_count(0),
+		m_rewind_captures(0),
+		m_rewind_last_ticks(0),
+		m_rewind_max_ticks(0),
+		m_rewind_total_ticks(0),
+		m_rewind_total_bytes(0)
 {
 }
 
 
+//-------------------------------------------------
+//  ~save_manager - destructor
+//-------------------------------------------------
+
+save_manager::~save_manager()
+{
+	if (m_work_queue != nullptr)
+		osd_work_queue_free(m_work_queue);
+}
+
+
 //-------------------------------------------------
 //  allow_registration - allow/disallow
 //  registrations to happen
@@ -235,13 +275,12 @@ save_error save_manager::read_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
-	// read the header and turn on compression for the rest of the file
+	// read the header
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	UINT8 header[HEADER_SIZE];
 	if (file.read(header, sizeof(header)) != sizeof(header))
 		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// verify the header and report an error if it doesn't match
 	UINT32 sig = signature();
@@ -251,6 +290,28 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// read all the data in whichever container the file uses
+	save_error result = (header[8] == SAVE_VERSION_STREAM) ? read_stream(file, flip) : read_chunks(file, flip);
+	if (result != STATERR_NONE)
+		return result;
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_stream - read the data from a format 2
+//  file as a single compressed stream
+//-------------------------------------------------
+
+save_error save_manager::read_stream(emu_file &file, bool flip)
+{
+	// turn on compression for the rest of the file
+	file.compress(FCOMPRESS_MEDIUM);
+
 	// read all the data, flipping if necessary
 	for (state_entry &entry : m_entry_list)
 	{
@@ -262,10 +323,60 @@ save_error save_manager::read_file(emu_file &file)
 		if (flip)
 			entry.flip_data();
 	}
+	return STATERR_NONE;
+}
 
-	// call the post-load functions
-	dispatch_postload();
 
+//-------------------------------------------------
+//  read_chunks - read the data from a chunked
+//  file, decompressing the chunks in parallel
+//-------------------------------------------------
+
+save_error save_manager::read_chunks(emu_file &file, bool flip)
+{
+	// read the chunk count
+	UINT32 count;
+	if (file.read(&count, sizeof(count)) != sizeof(count))
+		return STATERR_READ_ERROR;
+	count = LITTLE_ENDIANIZE_INT32(count);
+
+	// size the flat state
+	UINT32 flatsize = 0;
+	for (state_entry &entry : m_entry_list)
+		flatsize += entry.m_typesize * entry.m_typecount;
+	std::vector<UINT8> flat(flatsize);
+	if (count > flatsize / CHUNK_SIZE + 1)
+		return STATERR_READ_ERROR;
+
+	// read the index; the chunks must exactly cover the registered entries
+	std::vector<UINT32> index(count * 2);
+	if (count != 0 && file.read(&index[0], count * 2 * sizeof(UINT32)) != count * 2 * sizeof(UINT32))
+		return STATERR_READ_ERROR;
+	UINT64 total = 0;
+	for (UINT32 chunknum = 0; chunknum < count; chunknum++)
+		total += LITTLE_ENDIANIZE_INT32(index[chunknum * 2]);
+	if (total != flat.size())
+		return STATERR_READ_ERROR;
+
+	// read the compressed data of every chunk
+	std::vector<state_chunk> chunks(count);
+	UINT8 *data = flat.empty() ? nullptr : &flat[0];
+	for (UINT32 chunknum = 0; chunknum < count; chunknum++)
+	{
+		state_chunk &chunk = chunks[chunknum];
+		chunk.m_data = data;
+		chunk.m_length = LITTLE_ENDIANIZE_INT32(index[chunknum * 2]);
+		UINT32 stored = LITTLE_ENDIANIZE_INT32(index[chunknum * 2 + 1]);
+		chunk.m_compressed.resize(stored);
+		if (stored != 0 && file.read(&chunk.m_compressed[0], stored) != stored)
+			return STATERR_READ_ERROR;
+		data += chunk.m_length;
+	}
+
+	// decompress them and copy the result back out to the entries
+	if (!process_chunks(chunks, decompress_chunk))
+		return STATERR_READ_ERROR;
+	unflatten_state(flat, flip);
 	return STATERR_NONE;
 }
 
@@ -300,27 +411,326 @@ save_error save_manager::write_file(emu_file &file)
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
 
-	// write the header and turn on compression for the rest of the file
+	// call the pre-save functions
+	dispatch_presave();
+
+	// gather all the data and split it into chunks
+	std::vector<UINT8> flat;
+	flatten_state(flat);
+	UINT32 count = (flat.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	std::vector<state_chunk> chunks(count);
+	for (UINT32 chunknum = 0; chunknum < count; chunknum++)
+	{
+		state_chunk &chunk = chunks[chunknum];
+		chunk.m_data = &flat[chunknum * CHUNK_SIZE];
+		chunk.m_length = std::min<UINT32>(CHUNK_SIZE, flat.size() - chunknum * CHUNK_SIZE);
+	}
+
+	// compress them all in parallel
+	if (!process_chunks(chunks, compress_chunk))
+		return STATERR_WRITE_ERROR;
+
+	// build the chunk index
+	std::vector<UINT32> index(1 + count * 2);
+	index[0] = LITTLE_ENDIANIZE_INT32(count);
+	for (UINT32 chunknum = 0; chunknum < count; chunknum++)
+	{
+		index[1 + chunknum * 2] = LITTLE_ENDIANIZE_INT32(chunks[chunknum].m_length);
+		index[2 + chunknum * 2] = LITTLE_ENDIANIZE_INT32(UINT32(chunks[chunknum].m_compressed.size()));
+	}
+
+	// write the header, the index, and then the chunks
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	if (file.write(header, sizeof(header)) != sizeof(header))
 		return STATERR_WRITE_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
+	if (file.write(&index[0], index.size() * sizeof(UINT32)) != index.size() * sizeof(UINT32))
+		return STATERR_WRITE_ERROR;
+	for (state_chunk &chunk : chunks)
+		if (file.write(&chunk.m_compressed[0], chunk.m_compressed.size()) != chunk.m_compressed.size())
+			return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
+}
 
-	// call the pre-save functions
-	dispatch_presave();
 
-	// then write all the data
+//-------------------------------------------------
+//  flatten_state - size the flat state buffer
+//  and copy all the entries into it
+//-------------------------------------------------
+
+void save_manager::flatten_state(std::vector<UINT8> &flat)
+{
+	UINT32 total = 0;
+	for (state_entry &entry : m_entry_list)
+		total += entry.m_typesize * entry.m_typecount;
+	flat.resize(total);
+
+	UINT8 *dest = flat.empty() ? nullptr : &flat[0];
 	for (state_entry &entry : m_entry_list)
 	{
 		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
-		if (file.write(entry.m_data, totalsize) != totalsize)
-			return STATERR_WRITE_ERROR;
+		memcpy(dest, entry.m_data, totalsize);
+		dest += totalsize;
+	}
+}
+
+
+//-------------------------------------------------
+//  unflatten_state - copy the flat state buffer
+//  back out to the entries, flipping if
+//  necessary
+//-------------------------------------------------
+
+void save_manager::unflatten_state(const std::vector<UINT8> &flat, bool flip)
+{
+	const UINT8 *source = flat.empty() ? nullptr : &flat[0];
+	for (state_entry &entry : m_entry_list)
+	{
+		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
+		memcpy(entry.m_data, source, totalsize);
+		source += totalsize;
+
+		// handle flipping
+		if (flip)
+			entry.flip_data();
 	}
+}
+
+
+//-------------------------------------------------
+//  process_chunks - run a callback over all the
+//  chunks on the work queue, returning false if
+//  any of them failed
+//-------------------------------------------------
+
+bool save_manager::process_chunks(std::vector<state_chunk> &chunks, osd_work_callback callback)
+{
+	for (state_chunk &chunk : chunks)
+		chunk.m_error = false;
+
+	// a single chunk isn't worth a trip through the queue
+	if (chunks.size() == 1)
+		(*callback)(&chunks[0], 0);
+	else if (!chunks.empty())
+	{
+		if (m_work_queue == nullptr)
+			m_work_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		osd_work_item_queue_multiple(m_work_queue, callback, chunks.size(), &chunks[0], sizeof(chunks[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(m_work_queue, osd_ticks_per_second() * 100);
+	}
+
+	for (state_chunk &chunk : chunks)
+		if (chunk.m_error)
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  compress_chunk - compress one chunk; runs on
+//  a worker thread
+//-------------------------------------------------
+
+void *save_manager::compress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+
+	// store the chunk raw if it doesn't shrink
+	uLongf length = compressBound(chunk.m_length);
+	chunk.m_compressed.resize(length);
+	if (compress2(&chunk.m_compressed[0], &length, chunk.m_data, chunk.m_length, Z_DEFAULT_COMPRESSION) != Z_OK || length >= chunk.m_length)
+	{
+		chunk.m_compressed.assign(chunk.m_data, chunk.m_data + chunk.m_length);
+		return nullptr;
+	}
+	chunk.m_compressed.resize(length);
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  decompress_chunk - decompress one chunk; runs
+//  on a worker thread
+//-------------------------------------------------
+
+void *save_manager::decompress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+
+	// raw chunks are just copied
+	if (chunk.m_compressed.size() == chunk.m_length)
+	{
+		if (chunk.m_length != 0)
+			memcpy(chunk.m_data, &chunk.m_compressed[0], chunk.m_length);
+		return nullptr;
+	}
+
+	uLongf length = chunk.m_length;
+	if (chunk.m_compressed.empty() || uncompress(chunk.m_data, &length, &chunk.m_compressed[0], chunk.m_compressed.size()) != Z_OK || length != chunk.m_length)
+		chunk.m_error = true;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  rewind_init - set up the in-memory rewind
+//  buffer to hold the given number of frames;
+//  must be called once registration is closed
+//-------------------------------------------------
+
+void save_manager::rewind_init(UINT32 depth)
+{
+	assert(!m_reg_allowed);
+
+	// lay the entries out in a flat image, each aligned for word-sized XORs
+	UINT32 offset = 0;
+	for (state_entry &entry : m_entry_list)
+	{
+		entry.m_offset = offset;
+		offset += (entry.m_typesize * entry.m_typecount + 7) & ~7;
+	}
+	m_rewind_image.assign(offset, 0);
+
+	// allocate the ring; delta storage grows to its working size on the first few frames
+	m_rewind_slots.clear();
+	m_rewind_slots.resize(depth);
+	m_rewind_first = 0;
+	m_rewind_count = 0;
+
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(save_manager::rewind_exit), this));
+}
+
+
+//-------------------------------------------------
+//  rewind_capture - add the current state as the
+//  newest frame of the rewind buffer, dropping
+//  the oldest if it is full
+//-------------------------------------------------
+
+save_error save_manager::rewind_capture()
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (!rewind_enabled())
+		return STATERR_WRITE_ERROR;
+
+	osd_ticks_t start = osd_ticks();
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// if the ring is full, drop the oldest frame; the next one becomes the base and needs no delta
+	UINT32 depth = m_rewind_slots.size();
+	if (m_rewind_count == depth)
+	{
+		m_rewind_first = (m_rewind_first + 1) % depth;
+		m_rewind_slots[m_rewind_first].clear();
+		m_rewind_count--;
+	}
+
+	// the first frame is a plain copy
+	rewind_delta &delta = m_rewind_slots[(m_rewind_first + m_rewind_count) % depth];
+	delta.clear();
+	UINT8 *image = &m_rewind_image[0];
+	if (m_rewind_count == 0)
+	{
+		for (state_entry &entry : m_entry_list)
+			memcpy(&image[entry.m_offset], entry.m_data, entry.m_typesize * entry.m_typecount);
+	}
+
+	// otherwise, record each changed block as the XOR of old and new, and bring the image up to date
+	else
+	{
+		for (state_entry &entry : m_entry_list)
+		{
+			const UINT8 *data = reinterpret_cast<const UINT8 *>(entry.m_data);
+			UINT32 totalsize = entry.m_typesize * entry.m_typecount;
+			for (UINT32 blockoffs = 0; blockoffs < totalsize; blockoffs += REWIND_BLOCK_SIZE)
+			{
+				UINT32 length = std::min(REWIND_BLOCK_SIZE, totalsize - blockoffs);
+				UINT8 *dest = &image[entry.m_offset + blockoffs];
+				const UINT8 *src = &data[blockoffs];
+				if (memcmp(dest, src, length) == 0)
+					continue;
+
+				delta.m_blocks.push_back(entry.m_offset + blockoffs);
+				delta.m_blocks.push_back(length);
+				size_t dataoffs = delta.m_data.size();
+				delta.m_data.resize(dataoffs + length);
+				UINT8 *xordata = &delta.m_data[dataoffs];
+				for (UINT32 index = 0; index < length; index++)
+					xordata[index] = dest[index] ^ src[index];
+				memcpy(dest, src, length);
+			}
+		}
+	}
+	m_rewind_count++;
+
+	// account for the cost
+	osd_ticks_t elapsed = osd_ticks() - start;
+	m_rewind_captures++;
+	m_rewind_last_ticks = elapsed;
+	m_rewind_max_ticks = std::max(m_rewind_max_ticks, elapsed);
+	m_rewind_total_ticks += elapsed;
+	m_rewind_total_bytes += delta.m_data.size();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  rewind_restore - restore the state from the
+//  given number of frames before the newest one,
+//  discarding all newer frames
+//-------------------------------------------------
+
+save_error save_manager::rewind_restore(UINT32 frames)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (frames >= m_rewind_count)
+		return STATERR_READ_ERROR;
+
+	// walk the image back one frame at a time
+	UINT32 depth = m_rewind_slots.size();
+	UINT8 *image = &m_rewind_image[0];
+	for ( ; frames > 0; frames--)
+	{
+		m_rewind_count--;
+		rewind_delta &delta = m_rewind_slots[(m_rewind_first + m_rewind_count) % depth];
+		delta.apply(image);
+		delta.clear();
+	}
+
+	// copy the image back into the live state
+	for (state_entry &entry : m_entry_list)
+		memcpy(entry.m_data, &image[entry.m_offset], entry.m_typesize * entry.m_typecount);
+
+	// call the post-load functions
+	dispatch_postload();
+
 	return STATERR_NONE;
 }
 
 
+//-------------------------------------------------
+//  rewind_exit - report capture costs
+//-------------------------------------------------
+
+void save_manager::rewind_exit()
+{
+	if (m_rewind_captures == 0)
+		return;
+
+	double usec = 1000000.0 / double(osd_ticks_per_second());
+	osd_printf_info("Rewind: %s captures of %s bytes, %.1f us average, %.1f us max, %s bytes average delta\n",
+			string_format("%u", m_rewind_captures).c_str(), string_format("%u", UINT32(m_rewind_image.size())).c_str(),
+			double(m_rewind_total_ticks) * usec / double(m_rewind_captures), double(m_rewind_max_ticks) * usec,
+			string_format("%u", m_rewind_total_bytes / m_rewind_captures).c_str());
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -374,7 +784,7 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if (header[8] != SAVE_VERSION && header[8] != SAVE_VERSION_STREAM)
 	{
 		if (errormsg != nullptr)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
@@ -415,6 +825,25 @@ save_manager::state_callback::state_callback(save_prepost_delegate callback)
 }
 
 
+//-------------------------------------------------
+//  rewind_delta::apply - XOR the recorded blocks
+//  into an image, stepping it back one frame
+//-------------------------------------------------
+
+void save_manager::rewind_delta::apply(UINT8 *image) const
+{
+	const UINT8 *xordata = m_data.empty() ? nullptr : &m_data[0];
+	for (size_t index = 0; index < m_blocks.size(); index += 2)
+	{
+		UINT8 *dest = &image[m_blocks[index]];
+		UINT32 length = m_blocks[index + 1];
+		for (UINT32 byte = 0; byte < length; byte++)
+			dest[byte] ^= xordata[byte];
+		xordata += length;
+	}
+}
+
+
 //-------------------------------------------------
 //  state_entry - constructor
 //-------------------------------------------------
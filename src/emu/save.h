@@ -92,6 +92,7 @@ class save_manager
 public:
 	// construction/destruction
 	save_manager(running_machine &machine);
+	~save_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -157,10 +158,35 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory rewind buffer
+	void rewind_init(UINT32 depth);
+	bool rewind_enabled() const { return !m_rewind_slots.empty(); }
+	UINT32 rewind_count() const { return m_rewind_count; }
+	save_error rewind_capture();
+	save_error rewind_restore(UINT32 frames);
+
+	// rewind statistics
+	UINT32 rewind_state_size() const { return m_rewind_image.size(); }
+	UINT64 rewind_captures() const { return m_rewind_captures; }
+	osd_ticks_t rewind_last_ticks() const { return m_rewind_last_ticks; }
+	osd_ticks_t rewind_max_ticks() const { return m_rewind_max_ticks; }
+	osd_ticks_t rewind_total_ticks() const { return m_rewind_total_ticks; }
+	UINT64 rewind_total_bytes() const { return m_rewind_total_bytes; }
+
 private:
+	class state_chunk;
+
 	// internal helpers
 	UINT32 signature() const;
 	void dump_registry() const;
+	void rewind_exit();
+	save_error read_stream(emu_file &file, bool flip);
+	save_error read_chunks(emu_file &file, bool flip);
+	void flatten_state(std::vector<UINT8> &flat);
+	void unflatten_state(const std::vector<UINT8> &flat, bool flip);
+	bool process_chunks(std::vector<state_chunk> &chunks, osd_work_callback callback);
+	static void *compress_chunk(void *param, int threadid);
+	static void *decompress_chunk(void *param, int threadid);
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
 
 	// state callback item
@@ -178,6 +204,28 @@ private:
 		save_prepost_delegate m_func;               // delegate
 	};
 
+	// one independently compressed piece of a save state file
+	class state_chunk
+	{
+	public:
+		UINT8 *                 m_data;             // uncompressed data within the flat state
+		UINT32                  m_length;           // uncompressed length
+		std::vector<UINT8>      m_compressed;       // compressed data
+		bool                    m_error;            // did (de)compression fail?
+	};
+
+	// one rewind frame, stored as the changed blocks XORed with the previous frame;
+	// applying it to the newer frame's image yields the older one
+	class rewind_delta
+	{
+	public:
+		void clear() { m_blocks.clear(); m_data.clear(); }
+		void apply(UINT8 *image) const;
+
+		std::vector<UINT32>     m_blocks;           // offset/length pairs within the image
+		std::vector<UINT8>      m_data;             // XOR data for each block, concatenated
+	};
+
 	// internal state
 	running_machine &       m_machine;              // reference to our machine
 	bool                    m_reg_allowed;          // are registrations allowed?
@@ -186,6 +234,20 @@ private:
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
+
+	// chunked file state
+	osd_work_queue *        m_work_queue;           // queue for compressing chunks in parallel
+
+	// rewind state
+	std::vector<UINT8>      m_rewind_image;         // flat copy of the newest captured frame
+	std::vector<rewind_delta> m_rewind_slots;       // ring of frames, one delta each
+	UINT32                  m_rewind_first;         // slot holding the oldest frame
+	UINT32                  m_rewind_count;         // number of frames held
+	UINT64                  m_rewind_captures;      // total captures
+	osd_ticks_t             m_rewind_last_ticks;    // cost of the most recent capture
+	osd_ticks_t             m_rewind_max_ticks;     // most expensive capture
+	osd_ticks_t             m_rewind_total_ticks;   // total cost of all captures
+	UINT64                  m_rewind_total_bytes;   // total delta bytes stored
 };
 
 
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "debugger.h"
 
 //**************************************************************************
@@ -36,6 +37,15 @@ enum
 
 
 
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// device executing on the current thread while parallel groups are running
+thread_local device_execute_interface *device_scheduler::s_parallel_executing_device = nullptr;
+
+
+
 //**************************************************************************
 //  EMU TIMER
 //**************************************************************************
@@ -47,7 +57,8 @@ enum
 emu_timer::emu_timer()
 	: m_machine(nullptr),
 		m_next(nullptr),
-		m_prev(nullptr),
+		m_heapindex(-1),
+		m_sequence(0),
 		m_param(0),
 		m_ptr(nullptr),
 		m_enabled(false),
@@ -80,7 +91,6 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	// ensure the entire timer state is clean
 	m_machine = &machine;
 	m_next = nullptr;
-	m_prev = nullptr;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -97,7 +107,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 		register_save();
 
 	// insert into the list
-	machine.scheduler().timer_list_insert(*this);
+	machine.scheduler().timer_heap_insert(*this);
 	return *this;
 }
 
@@ -112,7 +122,6 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	// ensure the entire timer state is clean
 	m_machine = &device.machine();
 	m_next = nullptr;
-	m_prev = nullptr;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -129,7 +138,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 		register_save();
 
 	// insert into the list
-	machine().scheduler().timer_list_insert(*this);
+	machine().scheduler().timer_heap_insert(*this);
 	return *this;
 }
 
@@ -142,7 +151,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 emu_timer &emu_timer::release()
 {
 	// unhook us from the global list
-	machine().scheduler().timer_list_remove(*this);
+	machine().scheduler().timer_heap_remove(*this);
 	return *this;
 }
 
@@ -157,12 +166,14 @@ bool emu_timer::enable(bool enable)
 	bool old = m_enabled;
 	if (old != enable)
 	{
+		auto guard = machine().scheduler().parallel_guard();
+
 		// set the enable flag
 		m_enabled = enable;
 
 		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		machine().scheduler().timer_heap_remove(*this);
+		machine().scheduler().timer_heap_insert(*this);
 	}
 	return old;
 }
@@ -178,6 +189,7 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 {
 	// if this is the callback timer, mark it modified
 	device_scheduler &scheduler = machine().scheduler();
+	auto guard = scheduler.parallel_guard();
 	if (scheduler.m_callback_timer == this)
 		scheduler.m_callback_timer_modified = true;
 
@@ -195,8 +207,8 @@ void emu_timer::adjust(attotime start_delay, INT32 param, const attotime &period
 	m_period = period;
 
 	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	scheduler.timer_heap_remove(*this);
+	scheduler.timer_heap_insert(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
 	if (this == scheduler.first_timer())
@@ -244,18 +256,26 @@ void emu_timer::register_save()
 	if (m_device == nullptr)
 	{
 		name = m_callback.name();
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		const indexed_heap<emu_timer> &timers = machine().scheduler().m_timer_heap;
+		for (int timernum = 0; timernum < timers.count(); timernum++)
+		{
+			emu_timer *curtimer = timers[timernum];
 			if (!curtimer->m_temporary && curtimer->m_device == nullptr && strcmp(curtimer->m_callback.name(), m_callback.name()) == 0)
 				index++;
+		}
 	}
 
 	// for device timers, it is an index based on the device and timer ID
 	else
 	{
 		name = string_format("%s/%d", m_device->tag(), m_id);
-		for (emu_timer *curtimer = machine().scheduler().first_timer(); curtimer != nullptr; curtimer = curtimer->next())
+		const indexed_heap<emu_timer> &timers = machine().scheduler().m_timer_heap;
+		for (int timernum = 0; timernum < timers.count(); timernum++)
+		{
+			emu_timer *curtimer = timers[timernum];
 			if (!curtimer->m_temporary && curtimer->m_device != nullptr && curtimer->m_device == m_device && curtimer->m_id == m_id)
 				index++;
+		}
 	}
 
 	// save the bits
@@ -280,8 +300,8 @@ inline void emu_timer::schedule_next_period()
 
 	// remove and re-insert us
 	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	scheduler.timer_heap_remove(*this);
+	scheduler.timer_heap_insert(*this);
 }
 
 
@@ -314,16 +334,23 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(nullptr),
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
-	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
-	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
+	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000),
+	m_parallel_queue(nullptr),
+	m_parallel_enabled(false),
+	m_parallel_active(false),
+	m_parallel_sync(false),
+	m_stats_start_ticks(osd_ticks()),
+	m_stats_log(nullptr),
+	m_stats_log_period(attotime::zero),
+	m_stats_log_next(attotime::zero)
 {
 	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true);
-	m_timer_list->adjust(attotime::never);
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), nullptr, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -338,9 +365,17 @@ device_scheduler::device_scheduler(running_machine &machine) :
 
 device_scheduler::~device_scheduler()
 {
+	// close the statistics log if the exit notifier never ran
+	if (m_stats_log != nullptr)
+		fclose(m_stats_log);
+
+	// release the parallel execution queue
+	if (m_parallel_queue != nullptr)
+		osd_work_queue_free(m_parallel_queue);
+
 	// remove all timers
-	while (m_timer_list != nullptr)
-		m_timer_allocator.reclaim(m_timer_list->release());
+	while (!m_timer_heap.empty())
+		m_timer_allocator.reclaim(m_timer_heap.first()->release());
 }
 
 
@@ -356,7 +391,8 @@ attotime device_scheduler::time() const
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *exec = currently_executing();
+	return (exec != nullptr) ? exec->local_time() : m_basetime;
 }
 
 
@@ -368,8 +404,8 @@ attotime device_scheduler::time() const
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer != nullptr; timer = timer->next())
-		if (timer->m_temporary && !timer->expire().is_never())
+	for (int timernum = 0; timernum < m_timer_heap.count(); timernum++)
+		if (m_timer_heap[timernum]->m_temporary && !m_timer_heap[timernum]->expire().is_never())
 		{
 			machine().logerror("Failed save state attempt due to anonymous timers:\n");
 			dump_timers();
@@ -423,14 +459,14 @@ void device_scheduler::timeslice()
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < m_timer_heap.first()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (m_timer_heap.first()->m_expire < target)
+			target = m_timer_heap.first()->m_expire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string(PRECISION)));
@@ -439,79 +475,251 @@ void device_scheduler::timeslice()
 		if (m_suspend_changes_pending)
 			apply_suspend_changes();
 
-		// loop over all CPUs
-		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		// run the devices, either in parallel groups or one after another in list order
+		if (m_parallel_enabled)
+			target = execute_parallel(target);
+		else
+			for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+				execute_device(*exec, target, call_debugger, true);
+		m_executing_device = nullptr;
+
+		// update the base time
+		m_basetime = target;
+	}
+
+	// execute timers
+	execute_timers();
+}
+
+
+//-------------------------------------------------
+//  execute_device - run a single device up to
+//  the target time, pulling the target back if
+//  the device stopped early; returns true if the
+//  device actually ran
+//-------------------------------------------------
+
+inline bool device_scheduler::execute_device(device_execute_interface &exec, attotime &target, bool call_debugger, bool profile)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec.m_suspend == 0 || exec.m_eatcycles) && target.seconds() >= exec.m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec.m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec.m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec.m_localtime).as_attoseconds());
+
+		// if we have enough for at least 1 cycle, do the math
+		if (delta >= exec.m_attoseconds_per_cycle)
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
+			// compute how many cycles we want to execute
+			int ran = exec.m_cycles_running = divu_64x32((UINT64)delta >> exec.m_divshift, exec.m_divisor);
+			LOG(("  cpu '%s': %d (%d cycles)\n", exec.device().tag(), delta, exec.m_cycles_running));
+
+			// if we're not suspended, actually execute
+			if (exec.m_suspend == 0)
 			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
-
-				// if we have enough for at least 1 cycle, do the math
-				if (delta >= exec->m_attoseconds_per_cycle)
+				if (profile)
+					g_profiler.start(exec.m_profiler);
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec.m_cycles_stolen = 0;
+				set_executing_device(&exec);
+				*exec.m_icountptr = exec.m_cycles_running;
+				osd_ticks_t start = osd_ticks();
+				if (!call_debugger)
+					exec.run();
+				else
 				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32((UINT64)delta >> exec->m_divshift, exec->m_divisor);
-					LOG(("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running));
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							debugger_start_cpu_hook(&exec->device(), target);
-							exec->run();
-							debugger_stop_cpu_hook(&exec->device());
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime(0, exec->m_attoseconds_per_cycle * ran);
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec->m_totalcycles, exec->m_localtime.as_string(PRECISION)));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = max(exec->m_localtime, m_basetime);
-						LOG(("         (new target)\n"));
-					}
+					debugger_start_cpu_hook(&exec.device(), target);
+					exec.run();
+					debugger_stop_cpu_hook(&exec.device());
 				}
+				exec.m_host_ticks += osd_ticks() - start;
+				exec.m_timeslices++;
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec.m_icountptr);
+				ran -= *exec.m_icountptr;
+				assert(ran >= exec.m_cycles_stolen);
+				ran -= exec.m_cycles_stolen;
+				exec.m_host_cycles += ran;
+				if (profile)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec.m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime(0, exec.m_attoseconds_per_cycle * ran);
+			assert(deltatime >= attotime::zero);
+			exec.m_localtime += deltatime;
+			LOG(("         %d ran, %d total, time = %s\n", ran, (INT32)exec.m_totalcycles, exec.m_localtime.as_string(PRECISION)));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec.m_localtime < target)
+			{
+				target = max(exec.m_localtime, m_basetime);
+				LOG(("         (new target)\n"));
 			}
+			return true;
 		}
-		m_executing_device = nullptr;
+	}
+	return false;
+}
 
-		// update the base time
-		m_basetime = target;
+
+//-------------------------------------------------
+//  set_executing_device - note which device is
+//  running on the current thread
+//-------------------------------------------------
+
+inline void device_scheduler::set_executing_device(device_execute_interface *exec)
+{
+	if (m_parallel_active)
+		s_parallel_executing_device = exec;
+	else
+		m_executing_device = exec;
+}
+
+
+//-------------------------------------------------
+//  execute_parallel - run all parallel groups
+//  concurrently up to the target time, returning
+//  the earliest time reached by any group
+//-------------------------------------------------
+
+attotime device_scheduler::execute_parallel(const attotime &target)
+{
+	// every group starts out aiming for the common target
+	for (parallel_group &group : m_parallel_groups)
+		group.m_target = target;
+	m_parallel_sync = false;
+
+	// hand all but the first group to the workers; the first one runs here
+	m_parallel_active = true;
+	osd_work_item_queue_multiple(m_parallel_queue, execute_parallel_group_static, m_parallel_groups.size() - 1, &m_parallel_groups[1], sizeof(m_parallel_groups[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	execute_parallel_group(m_parallel_groups[0]);
+
+	// the workers are still running devices until the queue drains, however long that takes
+	while (!osd_work_queue_wait(m_parallel_queue, osd_ticks_per_second() * 10)) { }
+	m_parallel_active = false;
+
+	// the new target is the earliest time any group reached
+	attotime result = target;
+	for (parallel_group &group : m_parallel_groups)
+		result = min(result, group.m_target);
+
+	// now that everyone is synchronized, deliver any triggers raised along the way
+	std::vector<int> triggers;
+	triggers.swap(m_parallel_triggers);
+	for (int trigid : triggers)
+		trigger(trigid);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  execute_parallel_group - run the devices of a
+//  single group in list order
+//-------------------------------------------------
+
+void *device_scheduler::execute_parallel_group_static(void *param, int threadid)
+{
+	parallel_group &group = *reinterpret_cast<parallel_group *>(param);
+	group.m_scheduler->execute_parallel_group(group);
+	return nullptr;
+}
+
+void device_scheduler::execute_parallel_group(parallel_group &group)
+{
+	// only the group on our own thread can safely talk to the profiler
+	bool profile = (&group == &m_parallel_groups[0]);
+	bool ran_any = false;
+
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		if (exec->m_parallel_group == group.m_group)
+		{
+			// once another device has asked for a resync, leave the rest of the group for the next pass
+			if (ran_any && m_parallel_sync)
+			{
+				if (exec->m_localtime < group.m_target)
+					group.m_target = max(exec->m_localtime, m_basetime);
+				continue;
+			}
+			ran_any |= execute_device(*exec, group.m_target, false, profile);
+		}
+	s_parallel_executing_device = nullptr;
+}
+
+
+//-------------------------------------------------
+//  configure_parallel_execution - decide whether
+//  this machine's devices may run in parallel
+//  and set up the groups if so
+//-------------------------------------------------
+
+void device_scheduler::configure_parallel_execution()
+{
+	// only drivers that explicitly opt in are eligible
+	if (!machine().config().m_parallel_execution)
+		return;
+
+	// fall back to deterministic sequential execution when debugging, recording or playing back inputs
+	emu_options &options = machine().options();
+	if (!options.parallel_exec() || (machine().debug_flags & DEBUG_FLAG_ENABLED) != 0 || options.record()[0] != 0 || options.playback()[0] != 0)
+	{
+		machine().logerror("Parallel execution disabled; executing devices sequentially\n");
+		return;
 	}
 
-	// execute timers
-	execute_timers();
+	// gather the distinct groups; group 0 is always first and always present
+	parallel_group group;
+	group.m_scheduler = this;
+	group.m_group = 0;
+	group.m_target = attotime::zero;
+	m_parallel_groups.push_back(group);
+
+	execute_interface_iterator iter(machine().root_device());
+	for (device_execute_interface *exec = iter.first(); exec != nullptr; exec = iter.next())
+	{
+		auto it = std::find_if(m_parallel_groups.begin(), m_parallel_groups.end(), [exec](const parallel_group &cur) { return cur.m_group == exec->m_parallel_group; });
+		if (it == m_parallel_groups.end())
+		{
+			group.m_group = exec->m_parallel_group;
+			m_parallel_groups.push_back(group);
+		}
+	}
+
+	// with only a single group there is nothing to gain
+	if (m_parallel_groups.size() < 2)
+	{
+		m_parallel_groups.clear();
+		return;
+	}
+
+	// allocate the work queue for the other groups
+	m_parallel_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	m_parallel_enabled = (m_parallel_queue != nullptr);
+	if (m_parallel_enabled)
+		machine().logerror("Parallel execution enabled with %d groups\n", int(m_parallel_groups.size()));
+}
+
+
+//-------------------------------------------------
+//  parallel_guard - lock out other groups from
+//  scheduler state while running in parallel
+//-------------------------------------------------
+
+std::unique_lock<std::recursive_mutex> device_scheduler::parallel_guard()
+{
+	if (m_parallel_active)
+		return std::unique_lock<std::recursive_mutex>(m_parallel_lock);
+	return std::unique_lock<std::recursive_mutex>();
 }
 
 
@@ -522,8 +730,13 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice()
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	// while running in parallel, make the other groups stop at their next device as well
+	if (m_parallel_active)
+		m_parallel_sync = true;
+
+	device_execute_interface *exec = currently_executing();
+	if (exec != nullptr)
+		exec->abort_timeslice();
 }
 
 
@@ -537,6 +750,15 @@ void device_scheduler::trigger(int trigid, const attotime &after)
 	if (m_execute_list == nullptr)
 		rebuild_execute_list();
 
+	// while running in parallel, defer immediate triggers until all groups have synchronized
+	if (m_parallel_active && after == attotime::zero)
+	{
+		auto guard = parallel_guard();
+		m_parallel_triggers.push_back(trigid);
+		abort_timeslice();
+		return;
+	}
+
 	// if we have a non-zero time, schedule a timer
 	if (after != attotime::zero)
 		timer_set(after, timer_expired_delegate(FUNC(device_scheduler::timed_trigger), this), trigid);
@@ -569,6 +791,7 @@ void device_scheduler::boost_interleave(const attotime &timeslice_time, const at
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *ptr)
 {
+	auto guard = parallel_guard();
 	return &m_timer_allocator.alloc()->init(machine(), callback, ptr, false);
 }
 
@@ -581,6 +804,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback, void *
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param, void *ptr)
 {
+	auto guard = parallel_guard();
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, true).adjust(duration, param);
 }
 
@@ -593,6 +817,7 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegate callback, int param, void *ptr)
 {
+	auto guard = parallel_guard();
 	m_timer_allocator.alloc()->init(machine(), callback, ptr, false).adjust(period, param, period);
 }
 
@@ -604,6 +829,7 @@ void device_scheduler::timer_pulse(const attotime &period, timer_expired_delegat
 
 emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, void *ptr)
 {
+	auto guard = parallel_guard();
 	return &m_timer_allocator.alloc()->init(device, id, ptr, false);
 }
 
@@ -616,6 +842,7 @@ emu_timer *device_scheduler::timer_alloc(device_t &device, device_timer_id id, v
 
 void device_scheduler::timer_set(const attotime &duration, device_t &device, device_timer_id id, int param, void *ptr)
 {
+	auto guard = parallel_guard();
 	m_timer_allocator.alloc()->init(device, id, ptr, true).adjust(duration, param);
 }
 
@@ -661,26 +888,25 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
-	simple_list<emu_timer> private_list;
-	while (m_timer_list != nullptr)
+	// the loaded expiration times invalidate the heap ordering, so pull out every timer
+	std::vector<emu_timer *> timers;
+	for (int timernum = 0; timernum < m_timer_heap.count(); timernum++)
+		timers.push_back(m_timer_heap[timernum]);
+	m_timer_heap.reset();
+
+	// keep simultaneous timers in the order they were originally scheduled
+	std::sort(timers.begin(), timers.end(), [](const emu_timer *a, const emu_timer *b) { return a->m_sequence < b->m_sequence; });
+	for (emu_timer *timer : timers)
 	{
-		emu_timer &timer = *m_timer_list;
-
 		// temporary timers go away entirely (except our special never-expiring one)
-		if (timer.m_temporary && !timer.expire().is_never())
-			m_timer_allocator.reclaim(timer.release());
+		if (timer->m_temporary && !timer->expire().is_never())
+			m_timer_allocator.reclaim(timer);
 
-		// permanent ones get added to our private list
+		// permanent ones get re-inserted; this effectively re-sorts them by time
 		else
-			private_list.append(timer_list_remove(timer));
+			timer_heap_insert(*timer);
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
-	emu_timer *timer;
-	while ((timer = private_list.detach_head()) != nullptr)
-		timer_list_insert(*timer);
-
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
 
@@ -770,6 +996,9 @@ void device_scheduler::rebuild_execute_list()
 
 		// inform the timer system of our decision
 		add_scheduling_quantum(min_quantum, attotime::never);
+
+		// this is also the time to decide whether we can run devices in parallel
+		configure_parallel_execution();
 	}
 
 	// start with an empty list
@@ -804,65 +1033,26 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_heap_insert - insert a new timer into
+//  the heap at the appropriate location
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+emu_timer &device_scheduler::timer_heap_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	const attotime &expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = nullptr;
-	for (emu_timer *curtimer = m_timer_list; curtimer != nullptr; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != nullptr)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != nullptr)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = nullptr;
-	return timer;
+	// stamp the timer so it fires after any already-scheduled timers with the same expiration
+	timer.m_sequence = m_timer_sequence++;
+	return m_timer_heap.insert(timer);
 }
 
 
 //-------------------------------------------------
-//  timer_list_remove - remove a timer from the
-//  linked list
+//  timer_heap_remove - remove a timer from the
+//  heap
 //-------------------------------------------------
 
-emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
+emu_timer &device_scheduler::timer_heap_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev != nullptr)
-		timer.m_prev->m_next = timer.m_next;
-	else
-		m_timer_list = timer.m_next;
-
-	if (timer.m_next != nullptr)
-		timer.m_next->m_prev = timer.m_prev;
-
-	return timer;
+	return m_timer_heap.remove(timer);
 }
 
 
@@ -872,13 +1062,16 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 
 inline void device_scheduler::execute_timers()
 {
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION)));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_heap.first()->m_expire.as_string(PRECISION)));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (m_timer_heap.first()->m_expire <= m_basetime)
 	{
+		// pull the timer out of the heap while we work on it; the callback or
+		// the rescheduling below puts it back
+		emu_timer &timer = *m_timer_heap.detach_head();
+
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -978,7 +1171,139 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = first_timer(); timer != nullptr; timer = timer->next())
+
+	// dump in the order the timers will fire
+	std::vector<emu_timer *> timers;
+	for (int timernum = 0; timernum < m_timer_heap.count(); timernum++)
+		timers.push_back(m_timer_heap[timernum]);
+	std::sort(timers.begin(), timers.end(), [](const emu_timer *a, const emu_timer *b) { return a->heap_before(*b); });
+	for (emu_timer *timer : timers)
 		timer->dump();
 	machine().logerror("=============================================\n");
 }
+
+
+//-------------------------------------------------
+//  reset_execute_stats - restart the host time
+//  accounting for all executing devices
+//-------------------------------------------------
+
+void device_scheduler::reset_execute_stats()
+{
+	execute_interface_iterator iter(machine().root_device());
+	for (device_execute_interface *exec = iter.first(); exec != nullptr; exec = iter.next())
+		exec->reset_host_stats();
+	m_stats_start_ticks = osd_ticks();
+}
+
+
+//-------------------------------------------------
+//  execute_stats - return a table of the host
+//  time spent in each executing device since the
+//  counters were last reset
+//-------------------------------------------------
+
+std::string device_scheduler::execute_stats() const
+{
+	double tps = double(osd_ticks_per_second());
+	double elapsed = double(osd_ticks() - m_stats_start_ticks) / tps;
+
+	std::string result = string_format("Execution statistics at %.6f emulated seconds, %.3f host seconds\n", time().as_double(), elapsed);
+	result.append(string_format("%-32s %12s %14s %10s %9s %6s %9s %7s\n", "Device", "Clock", "Cycles", "Slices", "Host sec", "Host%", "Mcycles/s", "Speed%"));
+
+	osd_ticks_t totalticks = 0;
+	execute_interface_iterator iter(machine().root_device());
+	for (device_execute_interface *exec = iter.first(); exec != nullptr; exec = iter.next())
+	{
+		// speed is how fast the device would run on its own, relative to real time
+		double rate = exec->host_cycles_per_second();
+		double speed = (exec->m_cycles_per_second != 0) ? rate * 100.0 / double(exec->m_cycles_per_second) : 0.0;
+		result.append(string_format("%-32s %12u %14s %10s %9.3f %6.2f %9.3f %7.1f\n",
+				string_format("%s (%s)", exec->device().tag(), exec->device().shortname()),
+				exec->device().clock(),
+				string_format("%u", exec->host_cycles()),
+				string_format("%u", exec->timeslices()),
+				exec->host_seconds(),
+				(elapsed > 0) ? exec->host_seconds() * 100.0 / elapsed : 0.0,
+				rate / 1000000.0,
+				speed));
+		totalticks += exec->host_ticks();
+	}
+
+	// whatever is left is timers, video, sound and the OSD
+	double total = double(totalticks) / tps;
+	result.append(string_format("%-32s %12s %14s %10s %9.3f %6.2f\n", "(all devices)", "", "", "", total, (elapsed > 0) ? total * 100.0 / elapsed : 0.0));
+	return result;
+}
+
+
+//-------------------------------------------------
+//  start_execute_stats_log - append the execution
+//  statistics to execstats.log every period of
+//  emulated time, and once more on exit; this is
+//  driven from the frame notifier rather than a
+//  timer so that it leaves save states untouched
+//-------------------------------------------------
+
+void device_scheduler::start_execute_stats_log(const attotime &period)
+{
+	m_stats_log = fopen("execstats.log", "w");
+	if (m_stats_log == nullptr)
+	{
+		osd_printf_error("Unable to open execstats.log for writing\n");
+		return;
+	}
+
+	m_stats_log_period = period;
+	m_stats_log_next = time() + period;
+	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(FUNC(device_scheduler::execute_stats_log_frame), this));
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(device_scheduler::execute_stats_log_exit), this), true);
+}
+
+
+//-------------------------------------------------
+//  execute_stats_log_frame - append the current
+//  statistics once each period has elapsed
+//-------------------------------------------------
+
+void device_scheduler::execute_stats_log_frame()
+{
+	if (time() < m_stats_log_next)
+		return;
+
+	execute_stats_log_update();
+	while (m_stats_log_next <= time())
+		m_stats_log_next += m_stats_log_period;
+}
+
+
+//-------------------------------------------------
+//  execute_stats_log_update - append the current
+//  statistics to the log
+//-------------------------------------------------
+
+void device_scheduler::execute_stats_log_update()
+{
+	if (m_stats_log == nullptr)
+		return;
+
+	fprintf(m_stats_log, "%s\n", execute_stats().c_str());
+	fflush(m_stats_log);
+}
+
+
+//-------------------------------------------------
+//  execute_stats_log_exit - write the final
+//  statistics and close the log
+//-------------------------------------------------
+
+void device_scheduler::execute_stats_log_exit()
+{
+	if (m_stats_log == nullptr)
+		return;
+
+	execute_stats_log_update();
+	fclose(m_stats_log);
+	m_stats_log = nullptr;
+	osd_printf_info("Execution statistics written to execstats.log\n");
+}
@@ -51,6 +51,7 @@ class emu_timer
 {
 	friend class device_scheduler;
 	friend class simple_list<emu_timer>;
+	friend class indexed_heap<emu_timer>;
 	friend class fixed_allocator<emu_timer>;
 	friend class resource_pool_object<emu_timer>;
 
@@ -65,7 +66,6 @@ class emu_timer
 
 public:
 	// getters
-	emu_timer *next() const { return m_next; }
 	running_machine &machine() const { assert(m_machine != nullptr); return *m_machine; }
 	bool enabled() const { return m_enabled; }
 	int param() const { return m_param; }
@@ -91,11 +91,13 @@ private:
 	void register_save();
 	void schedule_next_period();
 	void dump() const;
+	bool heap_before(const emu_timer &other) const;
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the allocator's free list
+	int                 m_heapindex;    // index within the scheduler's timer heap (-1 if not present)
+	UINT64              m_sequence;     // insertion order, to keep simultaneous timers in order
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -109,6 +111,26 @@ private:
 };
 
 
+//-------------------------------------------------
+//  heap_before - return true if this timer must
+//  fire before the other one
+//-------------------------------------------------
+
+inline bool emu_timer::heap_before(const emu_timer &other) const
+{
+	// disabled timers sort as if they never expire, after enabled timers that never expire
+	const attotime &expire = m_enabled ? m_expire : attotime::never;
+	const attotime &other_expire = other.m_enabled ? other.m_expire : attotime::never;
+	if (expire != other_expire)
+		return expire < other_expire;
+	if (m_enabled != other.m_enabled)
+		return m_enabled;
+
+	// timers expiring at the same time fire in the order they were scheduled
+	return m_sequence < other.m_sequence;
+}
+
+
 // ======================> device_scheduler
 
 class device_scheduler
@@ -124,9 +146,10 @@ public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	attotime time() const;
-	emu_timer *first_timer() const { return m_timer_list; }
-	device_execute_interface *currently_executing() const { return m_executing_device; }
+	emu_timer *first_timer() const { return m_timer_heap.first(); }
+	device_execute_interface *currently_executing() const { return m_parallel_active ? s_parallel_executing_device : m_executing_device; }
 	bool can_save() const;
+	bool parallel_enabled() const { return m_parallel_enabled; }
 
 	// execution
 	void timeslice();
@@ -156,6 +179,11 @@ public:
 	// debugging
 	void dump_timers() const;
 
+	// per-device host time accounting
+	void reset_execute_stats();
+	std::string execute_stats() const;
+	void start_execute_stats_log(const attotime &period);
+
 	// for emergencies only!
 	void eat_all_cycles();
 
@@ -164,16 +192,29 @@ private:
 	void timed_trigger(void *ptr, INT32 param);
 	void presave();
 	void postload();
+	void execute_stats_log_frame();
+	void execute_stats_log_update();
+	void execute_stats_log_exit();
 
 	// scheduling helpers
 	void compute_perfect_interleave();
 	void rebuild_execute_list();
 	void apply_suspend_changes();
 	void add_scheduling_quantum(const attotime &quantum, const attotime &duration);
+	bool execute_device(device_execute_interface &exec, attotime &target, bool call_debugger, bool profile);
+
+	// parallel execution helpers
+	class parallel_group;
+	void configure_parallel_execution();
+	attotime execute_parallel(const attotime &target);
+	void execute_parallel_group(parallel_group &group);
+	static void *execute_parallel_group_static(void *param, int threadid);
+	void set_executing_device(device_execute_interface *exec);
+	std::unique_lock<std::recursive_mutex> parallel_guard();
 
 	// timer helpers
-	emu_timer &timer_list_insert(emu_timer &timer);
-	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &timer_heap_insert(emu_timer &timer);
+	emu_timer &timer_heap_remove(emu_timer &timer);
 	void execute_timers();
 
 	// internal state
@@ -182,8 +223,9 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// heap of active timers, ordered by expiration
+	indexed_heap<emu_timer>     m_timer_heap;               // heap of all live timers
+	UINT64                      m_timer_sequence;           // sequence number for the next insertion
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -208,6 +250,29 @@ private:
 	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
 	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
 	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+
+	// parallel execution groups
+	class parallel_group
+	{
+	public:
+		device_scheduler *      m_scheduler;                // owning scheduler
+		int                     m_group;                    // group number, as configured on the devices
+		attotime                m_target;                   // target time reached by this group
+	};
+	std::vector<parallel_group> m_parallel_groups;          // list of groups; the first always runs on our thread
+	osd_work_queue *            m_parallel_queue;           // work queue for running groups concurrently
+	bool                        m_parallel_enabled;         // true if the machine runs its groups in parallel
+	bool                        m_parallel_active;          // true while groups are executing concurrently
+	std::atomic<bool>           m_parallel_sync;            // a device has requested a resync of all groups
+	std::recursive_mutex        m_parallel_lock;            // serializes timer and trigger access from groups
+	std::vector<int>            m_parallel_triggers;        // triggers raised while groups were executing
+	static thread_local device_execute_interface *s_parallel_executing_device; // device executing on this thread
+
+	// execution statistics
+	osd_ticks_t                 m_stats_start_ticks;        // host time when the statistics were last reset
+	FILE *                      m_stats_log;                // execstats.log, if logging periodically
+	attotime                    m_stats_log_period;         // emulated time between log entries
+	attotime                    m_stats_log_next;           // emulated time of the next log entry
 };
 
 
@@ -712,6 +712,34 @@ void screen_device::realloc_screen_bitmaps()
 	}
 	m_texture[0]->set_bitmap(m_bitmap[0], m_visarea, m_bitmap[0].texformat());
 	m_texture[1]->set_bitmap(m_bitmap[1], m_visarea, m_bitmap[1].texformat());
+	m_texture_dirty[0] = m_texture_dirty[1] = m_visarea;
+}
+
+
+//-------------------------------------------------
+//  changed_rows - return the band of rows in the
+//  bitmap being drawn that differ from the one
+//  currently on display
+//-------------------------------------------------
+
+rectangle screen_device::changed_rows()
+{
+	if (m_curbitmap == m_curtexture)
+		return m_visarea;
+
+	const bitmap_t &curbitmap = m_bitmap[m_curbitmap];
+	const bitmap_t &prevbitmap = m_bitmap[m_curtexture];
+	const size_t rowbytes = m_visarea.width() * curbitmap.bpp() / 8;
+
+	// trim identical rows from the top and bottom
+	INT32 miny = m_visarea.min_y;
+	INT32 maxy = m_visarea.max_y;
+	while (miny <= maxy && memcmp(curbitmap.raw_pixptr(miny, m_visarea.min_x), prevbitmap.raw_pixptr(miny, m_visarea.min_x), rowbytes) == 0)
+		miny++;
+	while (maxy > miny && memcmp(curbitmap.raw_pixptr(maxy, m_visarea.min_x), prevbitmap.raw_pixptr(maxy, m_visarea.min_x), rowbytes) == 0)
+		maxy--;
+
+	return rectangle(m_visarea.min_x, m_visarea.max_x, miny, maxy);
 }
 
 
@@ -1149,7 +1177,20 @@ bool screen_device::update_quads()
 			// if we're not skipping the frame and if the screen actually changed, then update the texture
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
-				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+				// each texture needs the rows changed since it was last set, which spans
+				// this frame and any frames handed to the other texture in between
+				rectangle changed = changed_rows();
+				if (!changed.empty())
+					for (rectangle &dirty : m_texture_dirty)
+					{
+						if (dirty.empty())
+							dirty = changed;
+						else
+							dirty |= changed;
+					}
+
+				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat(), &m_texture_dirty[m_curbitmap]);
+				m_texture_dirty[m_curbitmap].set(0, -1, 0, -1);
 				m_curtexture = m_curbitmap;
 				m_curbitmap = 1 - m_curbitmap;
 			}
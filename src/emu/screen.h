@@ -266,6 +266,7 @@ private:
 	// internal helpers
 	void set_container(render_container &container) { m_container = &container; }
 	void realloc_screen_bitmaps();
+	rectangle changed_rows();
 	void vblank_begin();
 	void vblank_end();
 	void finalize_burnin();
@@ -301,6 +302,7 @@ private:
 	bitmap_ind64        m_burnin;                   // burn-in bitmap
 	UINT8               m_curbitmap;                // current bitmap index
 	UINT8               m_curtexture;               // current texture index
+	rectangle           m_texture_dirty[2];         // rows changed since each texture was last set
 	bool                m_changed;                  // has this bitmap changed?
 	INT32               m_last_partial_scan;        // scanline of last partial update
 	INT32               m_partial_scan_hpos;        // horizontal pixel last rendered on this partial scanline
@@ -13,6 +13,7 @@
 #include "osdepend.h"
 #include "config.h"
 #include "sound/wavwrite.h"
+#include "resampler.h"
 
 
 
@@ -48,30 +49,34 @@ const attotime sound_manager::STREAMS_UPDATE_ATTOTIME = attotime::from_hz(STREAM
 //  sound_stream - constructor
 //-------------------------------------------------
 
-sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample_rate,  stream_update_delegate callback)
+sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample_rate,  stream_update_delegate callback, stream_update_float_delegate float_callback)
 	: m_device(device),
 		m_next(nullptr),
 		m_sample_rate(sample_rate),
 		m_new_sample_rate(0),
+		m_float(!float_callback.isnull()),
 		m_attoseconds_per_sample(0),
 		m_max_samples_per_update(0),
 		m_input(inputs),
 		m_input_array(inputs),
+		m_finput_array(inputs),
 		m_resample_bufalloc(0),
 		m_output(outputs),
 		m_output_array(outputs),
+		m_foutput_array(outputs),
 		m_output_bufalloc(0),
 		m_output_sampindex(0),
 		m_output_update_sampindex(0),
 		m_output_base_sampindex(0),
-		m_callback(std::move(callback))
+		m_callback(std::move(callback)),
+		m_float_callback(std::move(float_callback))
 {
 	// get the device's sound interface
 	device_sound_interface *sound;
 	if (!device.interface(sound))
 		throw emu_fatalerror("Attempted to create a sound_stream with a non-sound device");
 
-	if(m_callback.isnull())
+	if(m_callback.isnull() && !m_float)
 		m_callback = stream_update_delegate(FUNC(device_sound_interface::sound_stream_update),(device_sound_interface *)sound);
 
 	// create a unique tag for saving
@@ -316,7 +321,36 @@ const stream_sample_t *sound_stream::output_since_last_update(int outputnum, int
 
 	// compute the number of samples and a pointer to the output buffer
 	numsamples = m_output_sampindex - m_output_update_sampindex;
-	return &m_output[outputnum].m_buffer[m_output_update_sampindex - m_output_base_sampindex];
+	if (numsamples == 0)
+		return nullptr;
+
+	// floating-point streams only have float buffers; hand out a converted copy
+	if (m_float)
+	{
+		if (m_output_convert.size() < numsamples)
+			m_output_convert.resize(numsamples);
+		stream_resampler::float_to_int(m_output_convert.data(), m_output[outputnum].m_fbuffer.data() + (m_output_update_sampindex - m_output_base_sampindex), numsamples);
+		return m_output_convert.data();
+	}
+	return m_output[outputnum].m_buffer.data() + (m_output_update_sampindex - m_output_base_sampindex);
+}
+
+
+//-------------------------------------------------
+//  output_since_last_update_float - same as
+//  above, for floating-point streams
+//-------------------------------------------------
+
+const stream_float_t *sound_stream::output_since_last_update_float(int outputnum, int &numsamples)
+{
+	// force an update on the stream
+	update();
+
+	// compute the number of samples and a pointer to the output buffer
+	numsamples = m_output_sampindex - m_output_update_sampindex;
+	if (numsamples == 0)
+		return nullptr;
+	return m_output[outputnum].m_fbuffer.data() + (m_output_update_sampindex - m_output_base_sampindex);
 }
 
 
@@ -405,7 +439,10 @@ void sound_stream::update_with_accounting(bool second_tick)
 			if (output_bufindex > 0)
 				for (auto & output : m_output)
 				{
-					memmove(&output.m_buffer[0], &output.m_buffer[samples_to_lose], sizeof(output.m_buffer[0]) * (output_bufindex - samples_to_lose));
+					if (m_float)
+						memmove(&output.m_fbuffer[0], &output.m_fbuffer[samples_to_lose], sizeof(output.m_fbuffer[0]) * (output_bufindex - samples_to_lose));
+					else
+						memmove(&output.m_buffer[0], &output.m_buffer[samples_to_lose], sizeof(output.m_buffer[0]) * (output_bufindex - samples_to_lose));
 				}
 
 			// update the base position
@@ -441,7 +478,12 @@ void sound_stream::apply_sample_rate_changes()
 
 	// clear out the buffer
 	for (auto & elem : m_output)
-		memset(&elem.m_buffer[0], 0, m_max_samples_per_update * sizeof(elem.m_buffer[0]));
+	{
+		if (m_float)
+			std::fill_n(&elem.m_fbuffer[0], m_max_samples_per_update, 0.0f);
+		else
+			memset(&elem.m_buffer[0], 0, m_max_samples_per_update * sizeof(elem.m_buffer[0]));
+	}
 }
 
 
@@ -536,10 +578,12 @@ void sound_stream::allocate_resample_buffers()
 		m_resample_bufalloc = bufsize;
 
 		// iterate over outputs and realloc their buffers
+		// (both formats are needed whenever floating-point streams are connected to integer ones)
 		for (auto & elem : m_input) {
 			unsigned int old_size = elem.m_resample.size();
 			elem.m_resample.resize(m_resample_bufalloc);
 			memset(&elem.m_resample[old_size], 0, (m_resample_bufalloc - old_size)*sizeof(elem.m_resample[0]));
+			elem.m_fresample.resize(m_resample_bufalloc, 0.0f);
 		}
 	}
 }
@@ -561,6 +605,11 @@ void sound_stream::allocate_output_buffers()
 
 		// iterate over outputs and realloc their buffers
 		for (auto & elem : m_output) {
+			if (m_float)
+			{
+				elem.m_fbuffer.resize(m_output_bufalloc, 0.0f);
+				continue;
+			}
 			unsigned int old_size = elem.m_buffer.size();
 			elem.m_buffer.resize(m_output_bufalloc);
 			memset(&elem.m_buffer[old_size], 0, (m_output_bufalloc - old_size)*sizeof(elem.m_buffer[0]));
@@ -580,7 +629,12 @@ void sound_stream::postload()
 
 	// make sure our output buffers are fully cleared
 	for (auto & elem : m_output)
-		memset(&elem.m_buffer[0], 0, m_output_bufalloc * sizeof(elem.m_buffer[0]));
+	{
+		if (m_float)
+			std::fill(elem.m_fbuffer.begin(), elem.m_fbuffer.end(), 0.0f);
+		else
+			memset(&elem.m_buffer[0], 0, m_output_bufalloc * sizeof(elem.m_buffer[0]));
+	}
 
 	// recompute the sample indexes to make sense
 	m_output_sampindex = m_device.machine().sound().last_update().attoseconds() / m_attoseconds_per_sample;
@@ -606,6 +660,25 @@ void sound_stream::generate_samples(int samples)
 
 	VPRINTF(("generate_samples(%p, %d)\n", (void *) this, samples));
 
+	// floating-point streams have their own buffers and callback
+	if (m_float)
+	{
+		for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
+		{
+			stream_input &input = m_input[inputnum];
+			if (input.m_source != nullptr)
+				input.m_source->m_stream->update();
+			m_finput_array[inputnum] = generate_resampled_data_float(input, samples);
+		}
+		for (unsigned int outputnum = 0; outputnum < m_output.size(); outputnum++)
+			m_foutput_array[outputnum] = &m_output[outputnum].m_fbuffer[m_output_sampindex - m_output_base_sampindex];
+
+		VPRINTF(("  float callback(%p, %d)\n", (void *)this, samples));
+		m_float_callback(*this, m_finput_array.empty() ? nullptr : &m_finput_array[0], m_foutput_array.empty() ? nullptr : &m_foutput_array[0], samples);
+		VPRINTF(("  float callback done\n"));
+		return;
+	}
+
 	// ensure all inputs are up to date and generate resampled data
 	for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
 	{
@@ -643,24 +716,16 @@ void sound_stream::generate_samples(int samples)
 
 
 //-------------------------------------------------
-//  generate_resampled_data - generate the
-//  resample buffer for a given input
+//  resample_position - compute where in the
+//  source buffer a given input's data starts,
+//  returning false if the input is not connected
 //-------------------------------------------------
 
-stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT32 numsamples)
+bool sound_stream::resample_position(stream_input &input, UINT32 &basefrac, UINT32 &step, INT32 &baseindex) const
 {
-	// if we don't have an output to pull data from, generate silence
-	stream_sample_t *dest = &input.m_resample[0];
 	if (input.m_source == nullptr)
-	{
-		memset(dest, 0, numsamples * sizeof(*dest));
-		return &input.m_resample[0];
-	}
-
-	// grab data from the output
-	stream_output &output = *input.m_source;
-	sound_stream &input_stream = *output.m_stream;
-	INT64 gain = (input.m_gain * input.m_user_gain * output.m_gain) >> 16;
+		return false;
+	sound_stream &input_stream = *input.m_source->m_stream;
 
 	// determine the time at which the current sample begins, accounting for the
 	// latency we calculated between the input and output streams
@@ -673,92 +738,118 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	else
 		basesample = -(-basetime / input_stream.m_attoseconds_per_sample) - 1;
 
-	// compute a source pointer to the first sample
+	// compute the index of the first sample
 	assert(basesample >= input_stream.m_output_base_sampindex);
-	stream_sample_t *source = &output.m_buffer[basesample - input_stream.m_output_base_sampindex];
+	baseindex = basesample - input_stream.m_output_base_sampindex;
 
 	// determine the current fraction of a sample, expressed as a fraction of FRAC_ONE
 	// (Note: this formula is valid as long as input_stream.m_attoseconds_per_sample signficantly exceeds FRAC_ONE > attoseconds = 4.2E-12 s)
-	UINT32 basefrac = (basetime - basesample * input_stream.m_attoseconds_per_sample) / ((input_stream.m_attoseconds_per_sample + FRAC_ONE - 1) >> FRAC_BITS);
+	basefrac = (basetime - basesample * input_stream.m_attoseconds_per_sample) / ((input_stream.m_attoseconds_per_sample + FRAC_ONE - 1) >> FRAC_BITS);
 	assert(basefrac < FRAC_ONE);
 
 	// compute the stepping fraction
-	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
+	step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
+	return true;
+}
+
 
+//-------------------------------------------------
+//  resample_integer - run the integer resampling
+//  kernel appropriate for the stepping fraction
+//-------------------------------------------------
+
+static void resample_integer(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+{
 	// if we have equal sample rates, we just need to copy
-	if (step == FRAC_ONE)
-	{
-		while (numsamples--)
-		{
-			// compute the sample
-			INT64 sample = *source++;
-			*dest++ = (sample * gain) >> 8;
-		}
-	}
+	if (step == stream_resampler::FRAC_ONE)
+		stream_resampler::resample_equal(dest, source, numsamples, gain);
 
 	// input is undersampled: point sample except where our sample period covers a boundary
-	else if (step < FRAC_ONE)
-	{
-		while (numsamples != 0)
-		{
-			// fill in with point samples until we hit a boundary
-			int nextfrac;
-			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
-			{
-				*dest++ = (source[0] * gain) >> 8;
-				basefrac = nextfrac;
-			}
+	else if (step < stream_resampler::FRAC_ONE)
+		stream_resampler::resample_up(dest, source, numsamples, basefrac, step, gain);
 
-			// if we're done, we're done
-			if (INT32(numsamples--) < 0)
-				break;
+	// input is oversampled: sum the energy
+	else
+		stream_resampler::resample_down(dest, source, numsamples, basefrac, step, gain);
+}
 
-			// compute starting and ending fractional positions
-			int startfrac = basefrac >> (FRAC_BITS - 12);
-			int endfrac = nextfrac >> (FRAC_BITS - 12);
 
-			// blend between the two samples accordingly
-			INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
-			*dest++ = (sample * gain) >> 8;
+//-------------------------------------------------
+//  generate_resampled_data - generate the
+//  resample buffer for a given input
+//-------------------------------------------------
+
+stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT32 numsamples)
+{
+	static_assert(FRAC_BITS == stream_resampler::FRAC_BITS, "sound_stream and stream_resampler fractions must match");
 
-			// advance
-			basefrac = nextfrac & FRAC_MASK;
-			source++;
-		}
+	// if we don't have an output to pull data from, generate silence
+	stream_sample_t *dest = &input.m_resample[0];
+	UINT32 basefrac, step;
+	INT32 baseindex;
+	if (!resample_position(input, basefrac, step, baseindex))
+	{
+		memset(dest, 0, numsamples * sizeof(*dest));
+		return &input.m_resample[0];
 	}
 
-	// input is oversampled: sum the energy
-	else
+	// grab data from the output
+	stream_output &output = *input.m_source;
+
+	// floating-point sources are resampled in floating point and converted once
+	if (output.m_stream->m_float)
 	{
-		// use 8 bits to allow some extra headroom
-		int smallstep = step >> (FRAC_BITS - 8);
-		while (numsamples--)
-		{
-			INT64 remainder = smallstep;
-			int tpos = 0;
-
-			// compute the sample
-			INT64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
-			INT64 sample = (INT64) source[tpos++] * scale;
-			remainder -= scale;
-			while (remainder > 0x100)
-			{
-				sample += (INT64) source[tpos++] * (INT64) 0x100;
-				remainder -= 0x100;
-			}
-			sample += (INT64) source[tpos] * remainder;
-			sample /= smallstep;
+		float gain = float(input.m_gain) * float(input.m_user_gain) * float(output.m_gain) * (1.0f / float(1 << 24));
+		stream_resampler::resample_float(&input.m_fresample[0], &output.m_fbuffer[baseindex], numsamples, basefrac, step, gain);
+		stream_resampler::float_to_int(dest, &input.m_fresample[0], numsamples);
+		return &input.m_resample[0];
+	}
 
-			*dest++ = (sample * gain) >> 8;
+	INT64 gain = (input.m_gain * input.m_user_gain * output.m_gain) >> 16;
+	resample_integer(dest, &output.m_buffer[baseindex], numsamples, basefrac, step, gain);
+	return &input.m_resample[0];
+}
 
-			// advance
-			basefrac += step;
-			source += basefrac >> FRAC_BITS;
-			basefrac &= FRAC_MASK;
-		}
+
+//-------------------------------------------------
+//  generate_resampled_data_float - generate the
+//  floating-point resample buffer for an input
+//  of a floating-point stream
+//-------------------------------------------------
+
+stream_float_t *sound_stream::generate_resampled_data_float(stream_input &input, UINT32 numsamples)
+{
+	// if we don't have an output to pull data from, generate silence
+	stream_float_t *dest = &input.m_fresample[0];
+	UINT32 basefrac, step;
+	INT32 baseindex;
+	if (!resample_position(input, basefrac, step, baseindex))
+	{
+		std::fill_n(dest, numsamples, 0.0f);
+		return dest;
 	}
 
-	return &input.m_resample[0];
+	// the gain is not truncated to 8.8 as it is in the integer path
+	stream_output &output = *input.m_source;
+	float gain = float(input.m_gain) * float(input.m_user_gain) * float(output.m_gain) * (1.0f / float(1 << 24));
+	if (output.m_stream->m_float)
+	{
+		stream_resampler::resample_float(dest, &output.m_fbuffer[baseindex], numsamples, basefrac, step, gain);
+		return dest;
+	}
+	stream_resampler::resample_float(dest, &output.m_buffer[baseindex], numsamples, basefrac, step, gain);
+
+	// in comparison mode, check against what the integer pipeline would have produced; the
+	// allowance covers the integer truncations plus the difference between the two gains
+	sound_manager &sound = m_device.machine().sound();
+	if (sound.compare_mode())
+	{
+		INT64 igain = (input.m_gain * input.m_user_gain * output.m_gain) >> 16;
+		resample_integer(&input.m_resample[0], &output.m_buffer[baseindex], numsamples, basefrac, step, igain);
+		float gainerror = (gain != 0) ? fabsf(gain - float(igain) / 256.0f) / fabsf(gain) : 0;
+		sound.compare_samples(*this, &input - &m_input[0], &input.m_resample[0], dest, numsamples, gainerror + 1.0e-5f);
+	}
+	return dest;
 }
 
 
@@ -817,6 +908,11 @@ sound_manager::sound_manager(running_machine &machine)
 		m_attenuation(0),
 		m_nosound_mode(machine.osd().no_sound()),
 		m_wavfile(nullptr),
+		m_float_mixing(machine.options().float_mixing() || machine.options().sound_compare()),
+		m_compare(machine.options().sound_compare()),
+		m_compare_samples(0),
+		m_compare_failures(0),
+		m_compare_maxerror(0),
 		m_update_attoseconds(STREAMS_UPDATE_ATTOTIME.attoseconds()),
 		m_last_update(attotime::zero)
 {
@@ -843,6 +939,8 @@ sound_manager::sound_manager(running_machine &machine)
 	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(FUNC(sound_manager::pause), this));
 	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(FUNC(sound_manager::resume), this));
 	machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(FUNC(sound_manager::reset), this));
+	if (m_compare)
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(sound_manager::compare_exit), this));
 
 	// register global states
 	machine.save().save_item(NAME(m_last_update));
@@ -879,6 +977,52 @@ sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outp
 }
 
 
+//-------------------------------------------------
+//  stream_alloc_float - allocate a new stream
+//  whose callback works on floating-point buffers
+//-------------------------------------------------
+
+sound_stream *sound_manager::stream_alloc_float(device_t &device, int inputs, int outputs, int sample_rate, stream_update_float_delegate callback)
+{
+	return &m_stream_list.append(*global_alloc(sound_stream(device, inputs, outputs, sample_rate, stream_update_delegate(), callback)));
+}
+
+
+//-------------------------------------------------
+//  compare_samples - check a block of samples
+//  from the floating-point pipeline against the
+//  integer pipeline's result; the tolerance is
+//  relative, on top of an allowance for the
+//  integer pipeline's truncations
+//-------------------------------------------------
+
+void sound_manager::compare_samples(const sound_stream &stream, int inputnum, const stream_sample_t *expected, const stream_float_t *actual, UINT32 numsamples, float tolerance)
+{
+	for (UINT32 sample = 0; sample < numsamples; sample++)
+	{
+		float error = fabsf(actual[sample] - float(expected[sample]));
+		m_compare_maxerror = std::max(m_compare_maxerror, error);
+		if (error > 2.0f + tolerance * fabsf(actual[sample]))
+		{
+			if (m_compare_failures++ < 20)
+				osd_printf_warning("Sound compare: '%s' input %d sample %d: integer %d, float %f\n", stream.device().tag(), inputnum, sample, expected[sample], double(actual[sample]));
+		}
+	}
+	m_compare_samples += numsamples;
+}
+
+
+//-------------------------------------------------
+//  compare_exit - report the comparison results
+//-------------------------------------------------
+
+void sound_manager::compare_exit()
+{
+	osd_printf_info("Sound compare: %s samples checked, %s outside tolerance, largest difference %f\n",
+			string_format("%u", m_compare_samples).c_str(), string_format("%u", m_compare_failures).c_str(), double(m_compare_maxerror));
+}
+
+
 //-------------------------------------------------
 //  set_attenuation - set the global volume
 //-------------------------------------------------
@@ -68,6 +68,7 @@ class sound_stream
 		// internal state
 		sound_stream *      m_stream;               // owning stream
 		std::vector<stream_sample_t> m_buffer;    // output buffer
+		std::vector<stream_float_t> m_fbuffer;    // output buffer for floating-point streams
 		int                 m_dependents;           // number of dependents
 		INT16               m_gain;                 // gain to apply to the output
 	};
@@ -83,6 +84,7 @@ class sound_stream
 		// internal state
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		std::vector<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
+		std::vector<stream_float_t> m_fresample;  // same, for floating-point streams and sources
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
@@ -95,7 +97,7 @@ class sound_stream
 	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
 
 	// construction/destruction
-	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback);
+	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback, stream_update_float_delegate float_callback = stream_update_float_delegate());
 
 public:
 	// getters
@@ -105,6 +107,7 @@ public:
 	attotime sample_time() const;
 	attotime sample_period() const { return attotime(0, m_attoseconds_per_sample); }
 	int input_count() const { return m_input.size(); }
+	bool is_float() const { return m_float; }
 	int output_count() const { return m_output.size(); }
 	std::string input_name(int inputnum) const;
 	device_t *input_source_device(int inputnum) const;
@@ -117,6 +120,7 @@ public:
 	void set_input(int inputnum, sound_stream *input_stream, int outputnum = 0, float gain = 1.0f);
 	void update();
 	const stream_sample_t *output_since_last_update(int outputnum, int &numsamples);
+	const stream_float_t *output_since_last_update_float(int outputnum, int &numsamples);
 
 	// timing
 	void set_sample_rate(int sample_rate);
@@ -136,6 +140,8 @@ private:
 	void postload();
 	void generate_samples(int samples);
 	stream_sample_t *generate_resampled_data(stream_input &input, UINT32 numsamples);
+	stream_float_t *generate_resampled_data_float(stream_input &input, UINT32 numsamples);
+	bool resample_position(stream_input &input, UINT32 &basefrac, UINT32 &step, INT32 &baseindex) const;
 	void sync_update(void *, INT32);
 
 	// linking information
@@ -146,6 +152,7 @@ private:
 	UINT32              m_sample_rate;                // sample rate of this stream
 	UINT32              m_new_sample_rate;            // newly-set sample rate for the stream
 	bool                m_synchronous;                // synchronous stream that runs at the rate of its input
+	bool                m_float;                      // do our callbacks take floating-point buffers?
 
 	// timing information
 	attoseconds_t       m_attoseconds_per_sample;     // number of attoseconds per sample
@@ -155,6 +162,7 @@ private:
 	// input information
 	std::vector<stream_input> m_input;              // list of streams we directly depend upon
 	std::vector<stream_sample_t *> m_input_array;   // array of inputs for passing to the callback
+	std::vector<stream_float_t *> m_finput_array;   // same, for floating-point callbacks
 
 	// resample buffer information
 	UINT32              m_resample_bufalloc;          // allocated size of each resample buffer
@@ -162,6 +170,8 @@ private:
 	// output information
 	std::vector<stream_output> m_output;            // list of streams which directly depend upon us
 	std::vector<stream_sample_t *> m_output_array;  // array of outputs for passing to the callback
+	std::vector<stream_float_t *> m_foutput_array;  // same, for floating-point callbacks
+	std::vector<stream_sample_t> m_output_convert;  // integer copy of a floating-point output
 
 	// output buffer information
 	UINT32              m_output_bufalloc;            // allocated size of each output buffer
@@ -171,6 +181,7 @@ private:
 
 	// callback information
 	stream_update_delegate  m_callback;                   // callback function
+	stream_update_float_delegate m_float_callback;        // callback function for floating-point streams
 };
 
 
@@ -205,6 +216,12 @@ public:
 
 	// stream creation
 	sound_stream *stream_alloc(device_t &device, int inputs, int outputs, int sample_rate, stream_update_delegate callback = stream_update_delegate());
+	sound_stream *stream_alloc_float(device_t &device, int inputs, int outputs, int sample_rate, stream_update_float_delegate callback);
+
+	// floating-point pipeline
+	bool float_mixing() const { return m_float_mixing; }
+	bool compare_mode() const { return m_compare; }
+	void compare_samples(const sound_stream &stream, int inputnum, const stream_sample_t *expected, const stream_float_t *actual, UINT32 numsamples, float tolerance);
 
 	// global controls
 	void set_attenuation(int attenuation);
@@ -226,6 +243,7 @@ private:
 	void config_save(config_type cfg_type, xml_data_node *parentnode);
 
 	void update(void *ptr = nullptr, INT32 param = 0);
+	void compare_exit();
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -242,6 +260,13 @@ private:
 
 	wav_file *          m_wavfile;
 
+	// floating-point pipeline state
+	bool                m_float_mixing;         // mix through floating-point mixers and speakers?
+	bool                m_compare;              // check the floating-point pipeline against the integer one?
+	UINT64              m_compare_samples;      // number of samples compared
+	UINT64              m_compare_failures;     // number of samples outside the tolerance
+	float               m_compare_maxerror;     // largest difference seen
+
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
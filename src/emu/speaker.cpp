@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "resampler.h"
 
 
 
@@ -95,7 +96,23 @@ void speaker_device::mix(INT32 *leftmix, INT32 *rightmix, int &samples_this_upda
 
 	// update the stream, getting the start/end pointers around the operation
 	int numsamples;
-	const stream_sample_t *stream_buf = m_mixer_stream->output_since_last_update(0, numsamples);
+	const stream_sample_t *stream_buf;
+	if (m_mixer_stream->is_float())
+	{
+		// floating-point mixers are converted to integer exactly once, here
+		const stream_float_t *float_buf = m_mixer_stream->output_since_last_update_float(0, numsamples);
+		if (m_float_convert.size() < numsamples)
+			m_float_convert.resize(numsamples);
+		if (numsamples != 0)
+			stream_resampler::float_to_int(m_float_convert.data(), float_buf, numsamples);
+		stream_buf = m_float_convert.data();
+	}
+	else
+		stream_buf = m_mixer_stream->output_since_last_update(0, numsamples);
+
+	// nothing to mix if no time has passed
+	if (numsamples == 0)
+		return;
 
 	// set or assert that all streams have the same count
 	if (samples_this_update == 0)
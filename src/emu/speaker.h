@@ -76,6 +76,7 @@ protected:
 	double              m_z;
 
 	// internal state
+	std::vector<stream_sample_t> m_float_convert;  // final conversion of a floating-point mixer stream
 #ifdef MAME_DEBUG
 	INT32               m_max_sample;           // largest sample value we've seen
 	INT32               m_clipped_samples;      // total number of clipped samples
@@ -101,6 +101,7 @@ video_manager::video_manager(running_machine &machine)
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
+		m_render_queue(nullptr),
 		m_mng_frame_period(attotime::zero),
 		m_mng_next_frame_time(attotime::zero),
 		m_mng_frame(0),
@@ -148,6 +149,9 @@ video_manager::video_manager(running_machine &machine)
 		m_snap_target->set_screen_overlay_enabled(false);
 	}
 
+	// snapshots and movies draw in bands across this queue
+	m_render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
 	// extract snap resolution if present
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
@@ -584,18 +588,35 @@ void video_manager::exit()
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
 
+	// time the software renderer on whatever the last frame was
+	if (machine().options().render_benchmark())
+		benchmark_renderer();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
+	if (m_render_queue != nullptr)
+		osd_work_queue_free(m_render_queue);
+	m_render_queue = nullptr;
 
 	// print a final result if we have at least 2 seconds' worth of data
 	if (m_overall_emutime.seconds() >= 1)
-	{
-		osd_ticks_t tps = osd_ticks_per_second();
-		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
-		double final_emu_time = m_overall_emutime.as_double();
-		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
-	}
+		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", overall_speed_percent(), (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
+}
+
+
+//-------------------------------------------------
+//  overall_speed_percent - return the average
+//  speed over the periods counted for the overall
+//  speed, or 0 if there are none yet
+//-------------------------------------------------
+
+double video_manager::overall_speed_percent() const
+{
+	osd_ticks_t tps = osd_ticks_per_second();
+	double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
+	double final_emu_time = m_overall_emutime.as_double();
+	return (final_real_time > 0) ? 100 * final_emu_time / final_real_time : 0;
 }
 
 
@@ -1136,13 +1157,79 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
 	if (machine().options().snap_bilinear())
-		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer_bilinear::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_render_queue);
 	else
-		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+		snap_renderer::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), m_render_queue);
 	primlist.release_lock();
 }
 
 
+//-------------------------------------------------
+//  benchmark_renderer - draw the snapshot
+//  target's current frame at several sizes, on
+//  one thread and in bands, and report the times
+//-------------------------------------------------
+
+void video_manager::benchmark_renderer()
+{
+	static const struct { INT32 width, height; } s_sizes[] =
+	{
+		{ 640, 480 },
+		{ 1920, 1080 },
+		{ 3840, 2160 }
+	};
+	const int frames = 20;
+
+	bool bilinear = machine().options().snap_bilinear();
+	osd_printf_info("Software renderer benchmark (%s, %d frames per size):\n", bilinear ? "bilinear" : "unfiltered", frames);
+
+	for (auto &size : s_sizes)
+	{
+		m_snap_target->set_bounds(size.width, size.height);
+		render_primitive_list &primlist = m_snap_target->get_primitives();
+		bitmap_rgb32 serial(size.width, size.height);
+		bitmap_rgb32 banded(size.width, size.height);
+
+		// draw the same list both ways, starting each frame from black
+		primlist.acquire_lock();
+		int primcount = 0;
+		for (const render_primitive *prim = primlist.first(); prim != nullptr; prim = prim->next())
+			primcount++;
+		osd_ticks_t serial_ticks = 0, banded_ticks = 0;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			serial.fill(0);
+			banded.fill(0);
+			osd_ticks_t start = osd_ticks();
+			if (bilinear)
+				snap_renderer_bilinear::draw_primitives(primlist, &serial.pix32(0), size.width, size.height, serial.rowpixels());
+			else
+				snap_renderer::draw_primitives(primlist, &serial.pix32(0), size.width, size.height, serial.rowpixels());
+			osd_ticks_t middle = osd_ticks();
+			if (bilinear)
+				snap_renderer_bilinear::draw_primitives(primlist, &banded.pix32(0), size.width, size.height, banded.rowpixels(), m_render_queue);
+			else
+				snap_renderer::draw_primitives(primlist, &banded.pix32(0), size.width, size.height, banded.rowpixels(), m_render_queue);
+			serial_ticks += middle - start;
+			banded_ticks += osd_ticks() - middle;
+		}
+		primlist.release_lock();
+
+		// the bands must add up to exactly what one thread draws
+		int mismatch = -1;
+		for (INT32 y = 0; y < size.height && mismatch < 0; y++)
+			if (memcmp(&serial.pix32(y), &banded.pix32(y), size.width * sizeof(UINT32)) != 0)
+				mismatch = y;
+
+		double serial_ms = double(serial_ticks) * 1000.0 / double(osd_ticks_per_second()) / frames;
+		double banded_ms = double(banded_ticks) * 1000.0 / double(osd_ticks_per_second()) / frames;
+		osd_printf_info("%5dx%-5d %4d primitives: %8.3f ms serial, %8.3f ms banded (%.2fx)\n", size.width, size.height, primcount, serial_ms, banded_ms, (banded_ms > 0) ? serial_ms / banded_ms : 0.0);
+		if (mismatch >= 0)
+			osd_printf_error("Banded output differs from serial output at %dx%d, row %d\n", size.width, size.height, mismatch);
+	}
+}
+
+
 //-------------------------------------------------
 //  open_next - open the next non-existing file of
 //  type filetype according to our numbering
@@ -86,6 +86,7 @@ public:
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
+	double overall_speed_percent() const;
 
 	// snapshots
 	void save_snapshot(screen_device *screen, emu_file &file);
@@ -130,6 +131,7 @@ private:
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
+	void benchmark_renderer();
 	void record_frame();
 
 	// internal state
@@ -178,6 +180,7 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	INT32               m_snap_width;               // width of snapshots (0 == auto)
 	INT32               m_snap_height;              // height of snapshots (0 == auto)
+	osd_work_queue *    m_render_queue;             // work queue for banded software rendering
 
 	// movie recording - MNG
 	std::unique_ptr<emu_file> m_mng_file;              // handle to the open movie file
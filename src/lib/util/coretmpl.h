@@ -303,6 +303,120 @@ private:
 };
 
 
+// ======================> indexed_heap
+
+// an indexed_heap is a binary min-heap of object pointers; each object
+// records its own position in 'm_heapindex' (-1 when not in the heap) so
+// that arbitrary objects can be removed or re-sorted in logarithmic time,
+// and orders itself against others via a 'heap_before' member function
+template<class _ElementType>
+class indexed_heap final
+{
+	// we don't support deep copying
+	indexed_heap(const indexed_heap &);
+	indexed_heap &operator=(const indexed_heap &);
+
+public:
+	// construction/destruction
+	indexed_heap() { }
+
+	// simple getters
+	_ElementType *first() const { return m_heap.empty() ? nullptr : m_heap[0]; }
+	int count() const { return m_heap.size(); }
+	bool empty() const { return m_heap.empty(); }
+	bool contains(const _ElementType &object) const { return object.m_heapindex >= 0; }
+
+	// unordered access to all objects, for iteration
+	_ElementType *operator[](int index) const { return m_heap[index]; }
+
+	// add an object to the heap
+	_ElementType &insert(_ElementType &object)
+	{
+		object.m_heapindex = m_heap.size();
+		m_heap.push_back(&object);
+		sift_up(object.m_heapindex);
+		return object;
+	}
+
+	// remove an object from the heap; removing an object not in the heap is a no-op
+	_ElementType &remove(_ElementType &object)
+	{
+		int index = object.m_heapindex;
+		if (index < 0)
+			return object;
+		object.m_heapindex = -1;
+
+		// move the last object into the hole and restore the ordering around it
+		_ElementType *last = m_heap.back();
+		m_heap.pop_back();
+		if (last != &object)
+		{
+			m_heap[index] = last;
+			last->m_heapindex = index;
+			if (index > 0 && last->heap_before(*m_heap[(index - 1) / 2]))
+				sift_up(index);
+			else
+				sift_down(index);
+		}
+		return object;
+	}
+
+	// detach the first object
+	_ElementType *detach_head() { return m_heap.empty() ? nullptr : &remove(*m_heap[0]); }
+
+	// detach all objects without reordering
+	void reset()
+	{
+		for (_ElementType *object : m_heap)
+			object->m_heapindex = -1;
+		m_heap.clear();
+	}
+
+private:
+	// move an object towards the root until its parent sorts first
+	void sift_up(int index)
+	{
+		_ElementType *object = m_heap[index];
+		while (index > 0)
+		{
+			int parent = (index - 1) / 2;
+			if (!object->heap_before(*m_heap[parent]))
+				break;
+			m_heap[index] = m_heap[parent];
+			m_heap[index]->m_heapindex = index;
+			index = parent;
+		}
+		m_heap[index] = object;
+		object->m_heapindex = index;
+	}
+
+	// move an object towards the leaves until both children sort after it
+	void sift_down(int index)
+	{
+		_ElementType *object = m_heap[index];
+		int count = m_heap.size();
+		while (true)
+		{
+			int child = index * 2 + 1;
+			if (child >= count)
+				break;
+			if (child + 1 < count && m_heap[child + 1]->heap_before(*m_heap[child]))
+				child++;
+			if (!m_heap[child]->heap_before(*object))
+				break;
+			m_heap[index] = m_heap[child];
+			m_heap[index]->m_heapindex = index;
+			index = child;
+		}
+		m_heap[index] = object;
+		object->m_heapindex = index;
+	}
+
+	// internal state
+	std::vector<_ElementType *> m_heap;     // heap-ordered array of objects
+};
+
+
 // ======================> fixed_allocator
 
 // a fixed_allocator is a simple class that maintains a free pool of objects
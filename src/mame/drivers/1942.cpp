@@ -565,8 +565,12 @@ static MACHINE_CONFIG_START( 1942, _1942_state )
 
 	MCFG_CPU_ADD("audiocpu", Z80, SOUND_CPU_CLOCK)  /* 3 MHz ??? */
 	MCFG_CPU_PROGRAM_MAP(sound_map)
+	MCFG_DEVICE_PARALLEL_GROUP(1)
 	MCFG_CPU_PERIODIC_INT_DRIVER(_1942_state, irq0_line_hold, 4*60)
 
+	/* the sound CPU only talks to the main CPU through the synchronized sound latch */
+	MCFG_QUANTUM_PARALLEL_EXECUTION()
+
 
 	/* video hardware */
 	MCFG_GFXDECODE_ADD("gfxdecode", "palette", 1942)
@@ -632,8 +636,12 @@ static MACHINE_CONFIG_START( 1942p, _1942_state )
 	MCFG_CPU_ADD("audiocpu", Z80, SOUND_CPU_CLOCK_1942P)  /* 4 MHz - verified on PCB */
 	MCFG_CPU_PROGRAM_MAP(c1942p_sound_map)
 	MCFG_CPU_IO_MAP(c1942p_sound_io)
+	MCFG_DEVICE_PARALLEL_GROUP(1)
 	MCFG_CPU_PERIODIC_INT_DRIVER(_1942_state, irq0_line_hold, 4*60)
 
+	/* the sound CPU only talks to the main CPU through the synchronized sound latch */
+	MCFG_QUANTUM_PARALLEL_EXECUTION()
+
 
 	/* video hardware */
 	MCFG_GFXDECODE_ADD("gfxdecode", "palette", 1942p)
@@ -0,0 +1,149 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*************************************************************************
+
+    testdrc.cpp
+
+    Driver for validating and benchmarking the UML back-ends without a
+    CPU core in the way. A stub device with a RAM program space owns
+    the UML state; on reset it compares the C and native back-ends on
+    every opcode (including the memory space accesses), benchmarks
+    them, and exits. Failures end the run with a fatal error.
+
+    Build it on its own with:
+
+        make SUBTARGET=testdrc SOURCES=src/mame/drivers/testdrc.cpp
+
+**************************************************************************/
+
+#include "emu.h"
+#include "cpu/drcuml.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// cache for the stub's own UML state; the validator brings its own
+const size_t STUB_CACHE_SIZE = 1024 * 1024;
+
+
+
+//**************************************************************************
+//  STUB DEVICE
+//**************************************************************************
+
+// ======================> uml_stub_device
+
+class uml_stub_device : public device_t,
+						public device_memory_interface
+{
+public:
+	// construction/destruction
+	uml_stub_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
+
+protected:
+	// device-level overrides
+	virtual void device_start() override;
+	virtual void device_reset() override;
+
+	// device_memory_interface overrides
+	virtual const address_space_config *memory_space_config(address_spacenum spacenum = AS_0) const override { return (spacenum == AS_PROGRAM) ? &m_program_config : nullptr; }
+
+private:
+	address_space_config            m_program_config;
+	std::unique_ptr<drc_cache>      m_cache;
+	std::unique_ptr<drcuml_state>   m_drcuml;
+};
+
+extern const device_type UML_STUB;
+const device_type UML_STUB = &device_creator<uml_stub_device>;
+
+
+//-------------------------------------------------
+//  uml_stub_device - constructor
+//-------------------------------------------------
+
+uml_stub_device::uml_stub_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+	: device_t(mconfig, UML_STUB, "UML back-end stub", tag, owner, clock, "uml_stub", __FILE__),
+		device_memory_interface(mconfig, *this),
+		m_program_config("program", ENDIANNESS_LITTLE, 32, 32)
+{
+}
+
+
+//-------------------------------------------------
+//  device_start - allocate the UML state
+//-------------------------------------------------
+
+void uml_stub_device::device_start()
+{
+	m_cache = std::make_unique<drc_cache>(STUB_CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_cache, 0, 1, 32, 0, DRCBE_C);
+}
+
+
+//-------------------------------------------------
+//  device_reset - run the validator once
+//-------------------------------------------------
+
+void uml_stub_device::device_reset()
+{
+	if (!machine().exit_pending())
+		m_drcuml->validate_backends();
+}
+
+
+
+//**************************************************************************
+//  DRIVER STATE
+//**************************************************************************
+
+class testdrc_state : public driver_device
+{
+public:
+	// constructor
+	testdrc_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag)
+	{
+	}
+};
+
+
+
+//**************************************************************************
+//  ADDRESS MAPS
+//**************************************************************************
+
+static ADDRESS_MAP_START( stub_mem, AS_PROGRAM, 32, testdrc_state )
+	AM_RANGE(0x00000000, 0x0000ffff) AM_RAM
+ADDRESS_MAP_END
+
+
+
+//**************************************************************************
+//  MACHINE DRIVERS
+//**************************************************************************
+
+static MACHINE_CONFIG_START( testdrc, testdrc_state )
+	MCFG_DEVICE_ADD("stub", UML_STUB, 0)
+	MCFG_DEVICE_ADDRESS_MAP(AS_PROGRAM, stub_mem)
+MACHINE_CONFIG_END
+
+
+
+//**************************************************************************
+//  ROM DEFINITIONS
+//**************************************************************************
+
+ROM_START( testdrc )
+	ROM_REGION( 0x10, "user1", ROMREGION_ERASEFF )
+ROM_END
+
+
+
+//**************************************************************************
+//  GAME DRIVERS
+//**************************************************************************
+
+GAME( 2016, testdrc, 0, testdrc, 0, driver_device, 0, ROT0, "MAME", "UML Back-end Tester", MACHINE_NO_SOUND )
@@ -2693,6 +2693,8 @@ void n64_state::n64_machine_stop()
 {
 	n64_periphs *periphs = machine().device<n64_periphs>("rcp");
 
+	m_rdp->dump_flush_stats();
+
 	if( periphs->m_nvram_image == nullptr )
 		return;
 
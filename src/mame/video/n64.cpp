@@ -78,7 +78,7 @@ INT32 n64_rdp::get_alpha_cvg(INT32 comb_alpha, rdp_span_aux* userdata, const rdp
 	}
 	if (object.m_other_modes.alpha_cvg_select)
 	{
-		temp = (m_other_modes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
+		temp = (object.m_other_modes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
 	}
 	if (temp > 0xff)
 	{
@@ -157,6 +157,8 @@ UINT32 n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitmap,
 		return 0;
 	}
 
+	// The VI scans out of RDRAM, so let queued spans land first
+	m_rdp->flush_rendering("screen update");
 	n64->video_update(bitmap);
 
 	return 0;
@@ -2050,6 +2052,13 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 		return;
 	}
 
+	// Spans stay queued until something needs their results, so make sure this triangle's fit behind them
+	const UINT32 span_count = std::min((ylfar - ycur) >> 2, 2047) + 1;
+	if (m_aux_buf_ptr + span_count * sizeof(rdp_span_aux) >= EXTENT_AUX_COUNT)
+	{
+		flush_rendering("span aux buffer full");
+	}
+
 	bool new_object = true;
 	rdp_poly_state* object = nullptr;
 	bool valid = false;
@@ -2105,8 +2114,9 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 			{
 				if(new_object)
 				{
+					UINT8* tmem = tmem_snapshot();
 					object = &object_data_alloc();
-					memcpy(object->m_tmem, m_tmem.get(), 0x1000);
+					object->m_tmem = tmem;
 					new_object = false;
 				}
 
@@ -2132,6 +2142,19 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 				userdata->m_lod_fraction = m_lod_fraction;
 				userdata->m_prim_lod_fraction = m_prim_lod_fraction;
 
+				// The combiner, texture pipeline and memory coverage carry these from one pixel to the next, so the
+				// first pixel of a span reads them before writing. Start every span from zero rather than from whatever
+				// the last span drawn through this aux slot left behind, which depends on queue depth and thread timing.
+				userdata->m_current_mem_cvg = 0;
+				userdata->m_combined_color.set(0, 0, 0, 0);
+				userdata->m_combined_alpha.set(0, 0, 0, 0);
+				userdata->m_texel0_color.set(0, 0, 0, 0);
+				userdata->m_texel0_alpha.set(0, 0, 0, 0);
+				userdata->m_texel1_color.set(0, 0, 0, 0);
+				userdata->m_texel1_alpha.set(0, 0, 0, 0);
+				userdata->m_next_texel_color.set(0, 0, 0, 0);
+				userdata->m_next_texel_alpha.set(0, 0, 0, 0);
+
 				// Setup blender data for this scanline
 				set_blender_input(0, 0, &userdata->m_color_inputs.blender1a_rgb[0], &userdata->m_color_inputs.blender1b_a[0], m_other_modes.blend_m1a_0, m_other_modes.blend_m1b_0, userdata);
 				set_blender_input(0, 1, &userdata->m_color_inputs.blender2a_rgb[0], &userdata->m_color_inputs.blender2b_a[0], m_other_modes.blend_m2a_0, m_other_modes.blend_m2b_0, userdata);
@@ -2199,8 +2222,66 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 	{
 		render_spans(yh >> 2, yl >> 2, tilenum, flip ? true : false, spans, rect, object);
 	}
-	m_aux_buf_ptr = 0;  // Spans can be reused once render completes
-	//wait("draw_triangle");
+
+	// Already drawn, so start the next primitive from the front of the aux buffer while it is still in cache
+	if (m_spans_inline)
+	{
+		flush_rendering("render spans");
+	}
+}
+
+UINT8* n64_rdp::tmem_snapshot()
+{
+	// Spans drawn inline are done before the next load can change TMEM
+	if (m_spans_inline)
+	{
+		return m_tmem.get();
+	}
+
+	// Polygons share one TMEM image until the next load changes it
+	if (m_tmem_dirty)
+	{
+		m_tmem_snapshot++;
+		if (m_tmem_snapshot == TMEM_SNAPSHOT_COUNT)
+		{
+			flush_rendering("TMEM snapshots exhausted");
+			m_tmem_snapshot = 0;
+		}
+		memcpy(&m_tmem_snapshots[m_tmem_snapshot * 0x1000], m_tmem.get(), 0x1000);
+		m_tmem_dirty = false;
+		m_snapshots_taken++;
+	}
+	return &m_tmem_snapshots[m_tmem_snapshot * 0x1000];
+}
+
+void n64_rdp::flush_rendering(const char* reason)
+{
+	wait(reason);
+	m_flushes++;
+
+	m_aux_buf_ptr = 0;
+	m_pending_fb_start = m_pending_fb_end = 0;
+	m_pending_zb_start = m_pending_zb_end = 0;
+}
+
+void n64_rdp::dump_flush_stats()
+{
+	if (m_spans_inline)
+	{
+		osd_printf_verbose("RDP: no worker threads, spans were drawn as each primitive was queued\n");
+		return;
+	}
+	osd_printf_verbose("RDP: drained the span queue %d times (%d for loads from RDRAM it was still writing), took %d TMEM snapshots\n",
+		m_flushes, m_rdram_flushes, m_snapshots_taken);
+}
+
+void n64_rdp::wait_for_rdram(UINT32 start, UINT32 end, const char* reason)
+{
+	if ((start < m_pending_fb_end && end > m_pending_fb_start) || (start < m_pending_zb_end && end > m_pending_zb_start))
+	{
+		m_rdram_flushes++;
+		flush_rendering(reason);
+	}
 }
 
 /*****************************************************************************/
@@ -2212,7 +2293,6 @@ void n64_rdp::draw_triangle(bool shade, bool texture, bool zbuffer, bool rect)
 void n64_rdp::triangle(bool shade, bool texture, bool zbuffer)
 {
 	draw_triangle(shade, texture, zbuffer, false);
-	m_pipe_clean = false;
 }
 
 void n64_rdp::cmd_triangle(UINT32 w1, UINT32 w2)
@@ -2386,7 +2466,7 @@ void n64_rdp::cmd_sync_tile(UINT32 w1, UINT32 w2)
 
 void n64_rdp::cmd_sync_full(UINT32 w1, UINT32 w2)
 {
-	//wait("SyncFull");
+	flush_rendering("SyncFull");
 	dp_full_sync(*m_machine);
 }
 
@@ -2409,7 +2489,7 @@ void n64_rdp::cmd_set_fill_color32(UINT32 w1, UINT32 w2)
 
 void n64_rdp::cmd_set_convert(UINT32 w1, UINT32 w2)
 {
-	if(!m_pipe_clean) { m_pipe_clean = true; wait("SetConvert"); }
+	if(!m_pipe_clean) { m_pipe_clean = true; flush_rendering("SetConvert"); }
 	INT32 k0 = (w1 >> 13) & 0x1ff;
 	INT32 k1 = (w1 >> 4) & 0x1ff;
 	INT32 k2 = ((w1 & 0xf) << 5) | ((w2 >> 27) & 0x1f);
@@ -2514,6 +2594,9 @@ void n64_rdp::cmd_load_tlut(UINT32 w1, UINT32 w2)
 			INT32 dststart = tile[tilenum].tmem << 2;
 			UINT16* dst = get_tmem16();
 
+			wait_for_rdram(srcstart << 1, (srcstart << 1) + (count >> 1), "LoadTLUT");
+			m_tmem_dirty = true;
+
 			for (INT32 i = 0; i < count; i += 4)
 			{
 				if (dststart < 2048)
@@ -2584,6 +2667,9 @@ void n64_rdp::cmd_load_block(UINT32 w1, UINT32 w2)
 
 	const UINT32 src = (m_misc_state.m_ti_address >> 1) + (tl * tiwinwords) + slinwords;
 
+	wait_for_rdram(src << 1, (src << 1) + (width << 3), "LoadBlock");
+	m_tmem_dirty = true;
+
 	if (dxt != 0)
 	{
 		INT32 j = 0;
@@ -2733,6 +2819,11 @@ void n64_rdp::cmd_load_tile(UINT32 w1, UINT32 w2)
 
 	const INT32 width = (sh - sl) + 1;
 	const INT32 height = (th - tl) + 1;
+
+	const UINT32 pitch = (m_misc_state.m_ti_width << m_misc_state.m_ti_size) >> 1;
+	const UINT32 src_start = m_misc_state.m_ti_address + tl * pitch + ((sl << m_misc_state.m_ti_size) >> 1);
+	wait_for_rdram(src_start, src_start + height * pitch + ((width << m_misc_state.m_ti_size) >> 1) + 1, "LoadTile");
+	m_tmem_dirty = true;
 /*
     INT32 topad;
     if (m_misc_state.m_ti_size < 3)
@@ -3136,6 +3227,13 @@ n64_rdp::n64_rdp(n64_state &state, UINT32* rdram, UINT32* dmem) : poly_manager<U
 	m_aux_buf = nullptr;
 	m_pipe_clean = true;
 
+	m_spans_inline = work_is_inline();
+	m_tmem_snapshot = 0;
+	m_tmem_dirty = true;
+	m_pending_fb_start = m_pending_fb_end = 0;
+	m_pending_zb_start = m_pending_zb_end = 0;
+	m_flushes = m_rdram_flushes = m_snapshots_taken = 0;
+
 	m_pending_mode_block = false;
 
 	m_cmd_ptr = 0;
@@ -3243,6 +3341,39 @@ void n64_rdp::render_spans(INT32 start, INT32 end, INT32 tilenum, bool flip, ext
 	object->m_fill_color = m_fill_color;
 	object->rect = rect;
 
+	// The texture pipe reads the YUV factors live, so SetConvert must drain these spans first
+	m_pipe_clean = false;
+
+	// Remember which rows of the color and Z buffers are waiting to be written
+	const UINT32 fb_pitch = std::max((m_misc_state.m_fb_width << m_misc_state.m_fb_size) >> 1, 1);
+	const UINT32 fb_start = m_misc_state.m_fb_address + start * fb_pitch;
+	const UINT32 fb_end = m_misc_state.m_fb_address + (end + 1) * fb_pitch;
+	if (m_pending_fb_start == m_pending_fb_end)
+	{
+		m_pending_fb_start = fb_start;
+		m_pending_fb_end = fb_end;
+	}
+	else
+	{
+		m_pending_fb_start = std::min(m_pending_fb_start, fb_start);
+		m_pending_fb_end = std::max(m_pending_fb_end, fb_end);
+	}
+	if (m_other_modes.z_update_en)
+	{
+		const UINT32 zb_start = m_misc_state.m_zb_address + start * m_misc_state.m_fb_width * 2;
+		const UINT32 zb_end = m_misc_state.m_zb_address + (end + 1) * m_misc_state.m_fb_width * 2;
+		if (m_pending_zb_start == m_pending_zb_end)
+		{
+			m_pending_zb_start = zb_start;
+			m_pending_zb_end = zb_end;
+		}
+		else
+		{
+			m_pending_zb_start = std::min(m_pending_zb_start, zb_start);
+			m_pending_zb_end = std::max(m_pending_zb_end, zb_end);
+		}
+	}
+
 	switch(m_other_modes.cycle_type)
 	{
 		case CYCLE_TYPE_1:
@@ -3261,7 +3392,6 @@ void n64_rdp::render_spans(INT32 start, INT32 end, INT32 tilenum, bool flip, ext
 			render_triangle_custom(clip, render_delegate(FUNC(n64_rdp::span_draw_fill), this), start, (end - start) + 1, spans + offset);
 			break;
 	}
-	wait("render spans");
 }
 
 void n64_rdp::rgbaz_clip(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32* sz, rdp_span_aux* userdata)
@@ -118,6 +118,7 @@
 #define SPAN_Z      (7)
 
 #define EXTENT_AUX_COUNT            (sizeof(rdp_span_aux)*(480*192)) // Screen coverage *192, more or less
+#define TMEM_SNAPSHOT_COUNT         (1024)  // TMEM images kept alive for queued polygons
 
 /*****************************************************************************/
 
@@ -141,6 +142,10 @@ public:
 	{
 		m_tmem = std::make_unique<UINT8[]>(0x1000);
 		memset(m_tmem.get(), 0, 0x1000);
+		if (!m_spans_inline)
+			m_tmem_snapshots = make_unique_clear<UINT8[]>(TMEM_SNAPSHOT_COUNT * 0x1000);
+		m_tmem_snapshot = 0;
+		m_tmem_dirty = true;
 
 		UINT8* normpoint = machine().root_device().memregion("normpoint")->base();
 		UINT8* normslope = machine().root_device().memregion("normslope")->base();
@@ -311,6 +316,9 @@ public:
 	UINT32          m_aux_buf_ptr;
 	UINT32          m_aux_buf_index;
 
+	void            flush_rendering(const char* reason);
+	void            dump_flush_stats();
+
 	bool            rdp_range_check(UINT32 addr);
 
 	n64_tile_t      m_tiles[8];
@@ -357,6 +365,27 @@ private:
 
 	std::unique_ptr<UINT8[]>  m_tmem;
 
+	// With no worker threads, spans are drawn before render_spans returns and nothing stays queued
+	bool    m_spans_inline;
+
+	// TMEM images referenced by polygons that are still queued
+	UINT8*  tmem_snapshot();
+	std::unique_ptr<UINT8[]>  m_tmem_snapshots;
+	INT32   m_tmem_snapshot;
+	bool    m_tmem_dirty;
+
+	// RDRAM written by queued spans; loads overlapping it must wait for them
+	void    wait_for_rdram(UINT32 start, UINT32 end, const char* reason);
+	UINT32  m_pending_fb_start;
+	UINT32  m_pending_fb_end;
+	UINT32  m_pending_zb_start;
+	UINT32  m_pending_zb_end;
+
+	// How often the queue was drained, reported with -verbose
+	UINT32  m_flushes;
+	UINT32  m_rdram_flushes;
+	UINT32  m_snapshots_taken;
+
 	// YUV factors
 	color_t m_k023;
 	color_t m_k1;
@@ -12,6 +12,7 @@
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <signal.h>
 
 #include <mach/mach.h>
@@ -142,6 +143,21 @@ void osd_break_into_debugger(const char *message)
 }
 
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+UINT64 osd_get_peak_memory(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	// OS X reports the maximum resident set size in bytes
+	return UINT64(usage.ru_maxrss);
+}
+
+
 //============================================================
 //  osd_get_clipboard_text
 //============================================================
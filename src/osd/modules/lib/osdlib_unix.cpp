@@ -12,6 +12,7 @@
 #include <unistd.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <signal.h>
 
 // MAME headers
@@ -134,6 +135,20 @@ void osd_break_into_debugger(const char *message)
 	#endif
 }
 
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+UINT64 osd_get_peak_memory(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	// Linux and the BSDs report the maximum resident set size in kilobytes
+	return UINT64(usage.ru_maxrss) * 1024;
+}
+
 #ifdef SDLMAME_ANDROID
 char *osd_get_clipboard_text(void)
 {
@@ -11,6 +11,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <mmsystem.h>
+#include <psapi.h>
 
 #include <stdlib.h>
 #ifndef _MSC_VER
@@ -242,6 +243,19 @@ void osd_break_into_debugger(const char *message)
 #endif
 }
 
+
+//============================================================
+//  osd_get_peak_memory
+//============================================================
+
+UINT64 osd_get_peak_memory(void)
+{
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+}
+
 //============================================================
 //  get_clipboard_text_by_format
 //============================================================
@@ -684,6 +684,7 @@ texture_info::texture_info(renderer_sdl1 *renderer, const render_texinfo &texsou
 	m_flags = flags;
 	m_texinfo = texsource;
 	m_texinfo.seqid = -1; // force set data
+	m_texinfo.content_seqid = 0;
 	m_is_rotated = false;
 	m_setup = setup;
 	m_sdl_blendmode = map_blendmode(PRIMFLAG_GET_BLENDMODE(flags));
@@ -946,12 +947,11 @@ texture_info * renderer_sdl1::texture_update(const render_primitive &prim)
 
 	if (texture != nullptr)
 	{
-		if (prim.texture.base != nullptr && texture->texinfo().seqid != prim.texture.seqid)
-		{
-			texture->texinfo().seqid = prim.texture.seqid;
-			// if we found it, but with a different seqid, copy the data
+		// if we found it, but with a different seqid, copy the data unless the contents are unchanged;
+		// the rotating blitters always work on the whole texture
+		INT32 miny, maxy;
+		if (prim.texture.base != nullptr && texture->texinfo().refresh(prim.texture, miny, maxy))
 			texture->set_data(prim.texture, prim.flags);
-		}
 
 	}
 	return texture;
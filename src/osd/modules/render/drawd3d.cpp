@@ -650,12 +650,10 @@ void d3d_texture_manager::update_textures()
 			}
 			else
 			{
-				// if there is one, but with a different seqid, copy the data
-				if (texture->get_texinfo().seqid != prim.texture.seqid)
-				{
+				// if there is one, but with a different seqid, copy the data unless the contents are unchanged
+				INT32 miny, maxy;
+				if (texture->get_texinfo().refresh(prim.texture, miny, maxy))
 					texture->set_data(&prim.texture, prim.flags);
-					texture->get_texinfo().seqid = prim.texture.seqid;
-				}
 			}
 
 			if (m_renderer->get_shaders()->enabled())
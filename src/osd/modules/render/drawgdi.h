@@ -33,6 +33,7 @@ public:
 		: osd_renderer(window, FLAG_NONE)
 		, m_bmdata(nullptr)
 		, m_bmsize(0)
+		, m_work_queue(nullptr)
 	{
 	}
 	virtual ~renderer_gdi();
@@ -52,6 +53,7 @@ private:
 	BITMAPINFO              m_bminfo;
 	UINT8 *                 m_bmdata;
 	size_t                  m_bmsize;
+	osd_work_queue *        m_work_queue;
 };
 
 #endif // __DRAWGDI__
@@ -268,7 +268,7 @@ static int glsl_shader_feature = GLSL_SHADER_FEAT_PLAIN;
 //  Textures
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags);
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags, int miny, int maxy);
 
 //============================================================
 //  Static Variables
@@ -382,7 +382,7 @@ void renderer_ogl::load_gl_lib(running_machine &machine)
 
 		stemp = downcast<sdl_options &>(machine.options()).gl_lib();
 		if (stemp != nullptr && strcmp(stemp, OSDOPTVAL_AUTO) == 0)
-			stemp = nullptrnullptr;
+			stemp = nullptr;
 
 		if (SDL_GL_LoadLibrary(stemp) != 0) // Load library (default for e==nullptr
 		{
@@ -1871,6 +1871,7 @@ ogl_texture_info *renderer_ogl::texture_create(const render_texinfo *texsource,
 	texture->flags = flags;
 	texture->texinfo = *texsource;
 	texture->texinfo.seqid = -1; // force set data
+	texture->texinfo.content_seqid = 0;
 	if (PRIMFLAG_GET_SCREENTEX(flags))
 	{
 		texture->xprescale = window().prescale();
@@ -2314,13 +2315,17 @@ static inline void copyline_yuy16_to_argb(UINT32 *dst, const UINT16 *src, int wi
 //  texture_set_data
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags)
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, UINT32 flags, int miny, int maxy)
 {
 	if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
 		assert(texture->pbo);
 		assert(!texture->nocopy);
 
+		// the mapped buffer isn't guaranteed to hold the previous contents
+		miny = 0;
+		maxy = texsource->height - 1;
+
 		texture->data = (UINT32 *) pfn_glMapBuffer(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY);
 	}
 
@@ -2345,7 +2350,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 		int y, y2;
 		UINT8 *dst;
 
-		for (y = 0; y < texsource->height; y++)
+		for (y = miny; y <= maxy; y++)
 		{
 			for (y2 = 0; y2 < texture->yprescale; y2++)
 			{
@@ -2390,6 +2395,11 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			(texsource->width * texture->xprescale + 2) * sizeof(UINT32));
 	}
 
+	// only the changed rows (plus the borders next to them) need to go to the card
+	const int uploadmin = (miny == 0) ? 0 : miny * texture->yprescale + texture->borderpix;
+	const int uploadmax = (maxy == INT32(texsource->height) - 1) ? texture->rawheight : (maxy + 1) * texture->yprescale + texture->borderpix;
+	const UINT32 *uploaddata = texture->data + uploadmin * (texture->nocopy ? texture->texinfo.rowpixels : texture->rawwidth);
+
 	if ( texture->type == TEXTURE_TYPE_SHADER )
 	{
 		pfn_glActiveTexture(GL_TEXTURE0);
@@ -2401,8 +2411,8 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		glTexSubImage2D(texture->texTarget, 0, 0, uploadmin, texture->rawwidth, uploadmax - uploadmin,
+				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, uploaddata);
 	}
 	else if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
@@ -2428,8 +2438,8 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		glTexSubImage2D(texture->texTarget, 0, 0, uploadmin, texture->rawwidth, uploadmax - uploadmin,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, uploaddata);
 	}
 }
 
@@ -2690,12 +2700,11 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 
 		if ( shaderIdx==0 ) // redundant for subsequent multipass shader
 		{
-			if (prim->texture.base != nullptr && texture->texinfo.seqid != prim->texture.seqid)
+			// if we found it, but with a different seqid, copy whatever changed
+			INT32 miny, maxy;
+			if (prim->texture.base != nullptr && texture->texinfo.refresh(prim->texture, miny, maxy))
 			{
-				texture->texinfo.seqid = prim->texture.seqid;
-
-				// if we found it, but with a different seqid, copy the data
-				texture_set_data(texture, &prim->texture, prim->flags);
+				texture_set_data(texture, &prim->texture, prim->flags, miny, maxy);
 				texBound=1;
 			}
 		}
@@ -26,6 +26,7 @@ public:
 		, m_texture_id(nullptr)
 		, m_yuv_lookup(nullptr)
 		, m_yuv_bitmap(nullptr)
+		, m_work_queue(nullptr)
 		//, m_hw_scale_width(0)
 		//, m_hw_scale_height(0)
 		, m_last_hofs(0)
@@ -62,6 +63,9 @@ private:
 	UINT32              *m_yuv_lookup;
 	UINT16              *m_yuv_bitmap;
 
+	// large targets are drawn in bands across this queue
+	osd_work_queue      *m_work_queue;
+
 	// if we leave scaling to SDL and the underlying driver, this
 	// is the render_target_width/height to use
 
@@ -528,6 +528,22 @@ osd_work_queue *osd_work_queue_alloc(int flags);
 int osd_work_queue_items(osd_work_queue *queue);
 
 
+/*-----------------------------------------------------------------------------
+    osd_work_queue_threads: return the number of threads servicing the queue
+
+    Parameters:
+
+        queue - pointer to an osd_work_queue that was previously created via
+            osd_work_queue_alloc
+
+    Return value:
+
+        The number of worker threads. If this is 0, queued items are executed
+        on the calling thread before osd_work_item_queue returns.
+-----------------------------------------------------------------------------*/
+int osd_work_queue_threads(osd_work_queue *queue);
+
+
 /*-----------------------------------------------------------------------------
     osd_work_queue_wait: wait for the queue to be empty
 
@@ -774,6 +790,21 @@ void osd_free_executable(void *ptr, size_t size);
 -----------------------------------------------------------------------------*/
 void osd_break_into_debugger(const char *message);
 
+/*-----------------------------------------------------------------------------
+    osd_get_peak_memory: return the largest amount of physical memory the
+    process has used so far
+
+    Parameters:
+
+        None.
+
+    Return value:
+
+        The peak resident set size in bytes, or 0 if it cannot be
+        determined.
+-----------------------------------------------------------------------------*/
+UINT64 osd_get_peak_memory(void);
+
 /*-----------------------------------------------------------------------------
     osd_get_clipboard_text: retrieves text from the clipboard
 
@@ -330,6 +330,17 @@ int osd_work_queue_items(osd_work_queue *queue)
 }
 
 
+//============================================================
+//  osd_work_queue_threads
+//============================================================
+
+int osd_work_queue_threads(osd_work_queue *queue)
+{
+	// return the number of threads servicing the queue
+	return queue->threads;
+}
+
+
 //============================================================
 //  osd_work_queue_wait
 //============================================================
@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "emucore.h"
+#include "renderspan.h"
+
+#include <vector>
+
+namespace {
+
+const UINT32 TEX_WIDTH = 67;
+const UINT32 TEX_HEIGHT = 41;
+const UINT32 TEX_ROWPIXELS = 72;
+
+// a texture covering every alpha value, including the 0 and 0xff extremes
+std::vector<UINT32> make_texture()
+{
+   std::vector<UINT32> texture(TEX_ROWPIXELS * TEX_HEIGHT);
+   UINT32 seed = 0x12345678;
+   for (UINT32 &texel : texture)
+   {
+      seed = seed * 1664525 + 1013904223;
+      texel = seed;
+   }
+   for (UINT32 index = 0; index < 0x200 && index < texture.size(); index++)
+      texture[index] = (texture[index] & 0x00ffffff) | ((index & 0xff) << 24);
+   texture[1] &= 0x00ffffff;
+   texture[2] |= 0xff000000;
+   return texture;
+}
+
+// spans of various lengths and steps, scaled in each direction and sheared
+struct span_case { INT32 curu, curv, dudx, dvdx, count; };
+const span_case span_cases[] =
+{
+   { 0x8000, 0x8000, 0x10000, 0, 67 },
+   { 0x38000, 0x108000, 0x10000, 0, 40 },
+   { 0x8000, 0x48000, 0x4000, 0, 263 },
+   { 0x8000, 0x28000, 0x2aaab, 0, 25 },
+   { 0x8000, 0x8000, 0x8000, 0x3000, 131 },
+   { 0x428000, 0x8000, -0x8000, 0x4000, 129 },
+   { 0x8000, 0x8000, 0x9999, 0x3333, 7 },
+   { 0x8000, 0x8000, 0x9999, 0x3333, 1 },
+   { 0x8000, 0x8000, 0x9999, 0x3333, 0 },
+};
+
+TEST(renderspan,copy_scaled)
+{
+   std::vector<UINT32> texture = make_texture();
+   for (const span_case &span : span_cases)
+   {
+      std::vector<UINT32> expected(span.count + 1, 0xdeadbeef), actual(span.count + 1, 0xdeadbeef);
+      render_span::copy_scaled_scalar(&expected[0], &texture[0], TEX_ROWPIXELS, span.curu, span.curv, span.dudx, span.dvdx, span.count);
+      render_span::copy_scaled(&actual[0], &texture[0], TEX_ROWPIXELS, span.curu, span.curv, span.dudx, span.dvdx, span.count);
+      for (INT32 index = 0; index <= span.count; index++)
+         ASSERT_EQ(expected[index], actual[index]) << "step " << span.dudx << "," << span.dvdx << " pixel " << index;
+   }
+}
+
+TEST(renderspan,blend_scaled)
+{
+   std::vector<UINT32> texture = make_texture();
+   for (const span_case &span : span_cases)
+   {
+      // start from a destination with its own top byte set, so skipped pixels show
+      std::vector<UINT32> expected(span.count + 1), actual;
+      for (INT32 index = 0; index <= span.count; index++)
+         expected[index] = 0x80000000 | (index * 0x010305);
+      actual = expected;
+
+      render_span::blend_scaled_scalar(&expected[0], &texture[0], TEX_ROWPIXELS, span.curu, span.curv, span.dudx, span.dvdx, span.count);
+      render_span::blend_scaled(&actual[0], &texture[0], TEX_ROWPIXELS, span.curu, span.curv, span.dudx, span.dvdx, span.count);
+      for (INT32 index = 0; index <= span.count; index++)
+         ASSERT_EQ(expected[index], actual[index]) << "step " << span.dudx << "," << span.dvdx << " pixel " << index;
+   }
+}
+
+// the scalar kernels must match the per-pixel loops in rendersw.inc
+TEST(renderspan,blend_matches_renderer)
+{
+   for (UINT32 alpha = 0; alpha <= 0xff; alpha++)
+      for (UINT32 value = 0; value <= 0xff; value += 0x33)
+      {
+         UINT32 texel = (alpha << 24) | (value << 16) | ((0xff - value) << 8) | (value ^ 0x5a);
+         UINT32 dest = 0x7f102030;
+         render_span::blend_scaled_scalar(&dest, &texel, 1, 0, 0, 0, 0, 1);
+
+         UINT32 expected = 0x7f102030;
+         if (alpha != 0)
+         {
+            UINT32 invta = 0x100 - alpha;
+            UINT32 r = (value * alpha + 0x10 * invta) >> 8;
+            UINT32 g = ((0xff - value) * alpha + 0x20 * invta) >> 8;
+            UINT32 b = ((value ^ 0x5a) * alpha + 0x30 * invta) >> 8;
+            expected = (r << 16) | (g << 8) | b;
+         }
+         ASSERT_EQ(expected, dest) << "alpha " << alpha << " value " << value;
+      }
+}
+
+}
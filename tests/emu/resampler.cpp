@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "emucore.h"
+#include "resampler.h"
+
+#include <vector>
+
+namespace {
+
+const UINT32 FRAC_BITS = stream_resampler::FRAC_BITS;
+const UINT32 FRAC_ONE = stream_resampler::FRAC_ONE;
+const UINT32 FRAC_MASK = stream_resampler::FRAC_MASK;
+
+// the per-sample loops sound_stream used before the block kernels; the
+// undersampled loop can run past numsamples, so callers pad the buffer
+void reference_resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+{
+   if (step == FRAC_ONE)
+   {
+      while (numsamples--)
+      {
+         INT64 sample = *source++;
+         *dest++ = (sample * gain) >> 8;
+      }
+   }
+   else if (step < FRAC_ONE)
+   {
+      while (numsamples != 0)
+      {
+         UINT32 nextfrac;
+         while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+         {
+            *dest++ = (source[0] * gain) >> 8;
+            basefrac = nextfrac;
+         }
+         if (INT32(numsamples--) < 0)
+            break;
+         int startfrac = basefrac >> (FRAC_BITS - 12);
+         int endfrac = nextfrac >> (FRAC_BITS - 12);
+         INT64 sample = ((INT64) source[0] * (0x1000 - startfrac) + (INT64) source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+         *dest++ = (sample * gain) >> 8;
+         basefrac = nextfrac & FRAC_MASK;
+         source++;
+      }
+   }
+   else
+   {
+      int smallstep = step >> (FRAC_BITS - 8);
+      while (numsamples--)
+      {
+         INT64 remainder = smallstep;
+         int tpos = 0;
+         INT64 scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+         INT64 sample = (INT64) source[tpos++] * scale;
+         remainder -= scale;
+         while (remainder > 0x100)
+         {
+            sample += (INT64) source[tpos++] * (INT64) 0x100;
+            remainder -= 0x100;
+         }
+         sample += (INT64) source[tpos] * remainder;
+         sample /= smallstep;
+         *dest++ = (sample * gain) >> 8;
+         basefrac += step;
+         source += basefrac >> FRAC_BITS;
+         basefrac &= FRAC_MASK;
+      }
+   }
+}
+
+void block_resample(stream_sample_t *dest, const stream_sample_t *source, UINT32 numsamples, UINT32 basefrac, UINT32 step, INT64 gain)
+{
+   if (step == FRAC_ONE)
+      stream_resampler::resample_equal(dest, source, numsamples, gain);
+   else if (step < FRAC_ONE)
+      stream_resampler::resample_up(dest, source, numsamples, basefrac, step, gain);
+   else
+      stream_resampler::resample_down(dest, source, numsamples, basefrac, step, gain);
+}
+
+std::vector<stream_sample_t> make_source(UINT32 count, UINT32 seed)
+{
+   std::vector<stream_sample_t> result(count);
+   for (auto &sample : result)
+   {
+      seed = seed * 1664525 + 1013904223;
+      sample = INT32(seed) >> 7;
+   }
+   return result;
+}
+
+}
+
+TEST(resampler,matches_reference)
+{
+   static const UINT32 rates[][2] = { { 48000, 48000 }, { 22050, 48000 }, { 8000, 44100 }, { 44100, 48000 }, { 96000, 48000 }, { 3579545, 48000 }, { 48001, 48000 } };
+   static const INT64 gains[] = { 0x100, 0x80, 0x1234, 0, -0x100, 0x12345678 };
+   const std::vector<stream_sample_t> source = make_source(0x20000, 12345);
+
+   for (auto &rate : rates)
+      for (INT64 gain : gains)
+         for (UINT32 numsamples : { 1U, 3U, 17U, 800U })
+            for (UINT32 basefrac : { 0U, FRAC_ONE / 3, FRAC_MASK })
+            {
+               UINT32 step = (UINT64(rate[0]) << FRAC_BITS) / rate[1];
+               std::vector<stream_sample_t> expected(numsamples + 64), actual(numsamples + 64);
+               reference_resample(&expected[0], &source[0], numsamples, basefrac, step, gain);
+               block_resample(&actual[0], &source[0], numsamples, basefrac, step, gain);
+               for (UINT32 index = 0; index < numsamples; index++)
+                  ASSERT_EQ(expected[index], actual[index]) << rate[0] << "->" << rate[1] << " gain " << gain << " sample " << index;
+            }
+}
+
+TEST(resampler,apply_gain_in_place)
+{
+   std::vector<stream_sample_t> buffer = make_source(1003, 99);
+   std::vector<stream_sample_t> expected(buffer.size());
+   stream_resampler::apply_gain_scalar(&expected[0], &buffer[0], buffer.size(), 0x1c0);
+   stream_resampler::apply_gain(&buffer[0], &buffer[0], buffer.size(), 0x1c0);
+   EXPECT_EQ(expected, buffer);
+}
+
+TEST(resampler,float_matches_integer)
+{
+   static const UINT32 rates[][2] = { { 48000, 48000 }, { 22050, 48000 }, { 96000, 48000 }, { 3579545, 48000 } };
+   const std::vector<stream_sample_t> source = make_source(0x20000, 54321);
+
+   for (auto &rate : rates)
+   {
+      UINT32 step = (UINT64(rate[0]) << FRAC_BITS) / rate[1];
+      std::vector<stream_sample_t> expected(800 + 64), actual(800);
+      std::vector<stream_float_t> floatbuf(800);
+      block_resample(&expected[0], &source[0], 800, FRAC_ONE / 3, step, 0xc0);
+      stream_resampler::resample_float(&floatbuf[0], &source[0], 800, FRAC_ONE / 3, step, 0.75f);
+      stream_resampler::float_to_int(&actual[0], &floatbuf[0], 800);
+      for (UINT32 index = 0; index < 800; index++)
+         ASSERT_NEAR(expected[index], actual[index], 2 + abs(expected[index]) * 1e-5) << rate[0] << "->" << rate[1] << " sample " << index;
+   }
+}
+
+TEST(resampler,float_to_int_saturates)
+{
+   const stream_float_t source[] = { 3e9f, -3e9f, 2147483648.0f, -2147483648.0f, 1234.75f, -1234.75f };
+   stream_sample_t dest[ARRAY_LENGTH(source)];
+   stream_resampler::float_to_int(dest, source, ARRAY_LENGTH(source));
+   EXPECT_EQ(0x7fffffff, dest[0]);
+   EXPECT_EQ(-0x7fffffff - 1, dest[1]);
+   EXPECT_EQ(0x7fffffff, dest[2]);
+   EXPECT_EQ(-0x7fffffff - 1, dest[3]);
+   EXPECT_EQ(1234, dest[4]);
+   EXPECT_EQ(-1234, dest[5]);
+}
@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "coretmpl.h"
+
+namespace {
+
+class heap_item
+{
+public:
+   heap_item(int key = 0, int order = 0) : m_heapindex(-1), m_key(key), m_order(order) { }
+   bool heap_before(const heap_item &other) const { return (m_key != other.m_key) ? (m_key < other.m_key) : (m_order < other.m_order); }
+
+   int m_heapindex;
+   int m_key;
+   int m_order;
+};
+
+}
+
+TEST(coretmpl,indexed_heap_order) 
+{
+   std::vector<heap_item> items;
+   for (int i = 0; i < 100; i++)
+      items.push_back(heap_item((i * 37) % 17, i));
+
+   indexed_heap<heap_item> heap;
+   for (heap_item &item : items)
+      heap.insert(item);
+   EXPECT_EQ(100, heap.count());
+
+   heap_item *prev = heap.detach_head();
+   EXPECT_EQ(-1, prev->m_heapindex);
+   while (!heap.empty())
+   {
+      heap_item *cur = heap.detach_head();
+      EXPECT_TRUE(prev->heap_before(*cur));
+      prev = cur;
+   }
+}
+
+TEST(coretmpl,indexed_heap_remove) 
+{
+   std::vector<heap_item> items;
+   for (int i = 0; i < 50; i++)
+      items.push_back(heap_item(50 - i, i));
+
+   indexed_heap<heap_item> heap;
+   for (heap_item &item : items)
+      heap.insert(item);
+
+   // remove every third item, then re-key a few of the rest
+   for (int i = 0; i < 50; i += 3)
+      heap.remove(items[i]);
+   EXPECT_FALSE(heap.contains(items[0]));
+   EXPECT_TRUE(heap.contains(items[1]));
+   heap.remove(items[0]);
+   for (int i = 1; i < 50; i += 6)
+   {
+      heap.remove(items[i]);
+      items[i].m_key = i;
+      heap.insert(items[i]);
+   }
+
+   heap_item *prev = heap.detach_head();
+   int count = 1;
+   while (!heap.empty())
+   {
+      heap_item *cur = heap.detach_head();
+      EXPECT_TRUE(prev->heap_before(*cur));
+      prev = cur;
+      count++;
+   }
+   EXPECT_EQ(33, count);
+}